@@ -411,6 +411,10 @@
 /// @ingroup pw_json
 /// @brief Serialize JSON into fixed-size buffers.
 
+/// @defgroup pw_json_stream_builder_api Stream builder API
+/// @ingroup pw_json
+/// @brief Serialize JSON incrementally to a `pw::stream::Writer`.
+
 /// @defgroup pw_kvs pw_kvs
 /// @brief Lightweight, persistent key-value store.
 /// @maindocs
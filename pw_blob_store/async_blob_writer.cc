@@ -0,0 +1,44 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_blob_store/async_blob_writer.h"
+
+namespace pw::blob_store {
+
+async2::Poll<Status> AsyncBlobWriter::PendWrite(async2::Context& cx,
+                                                ConstByteSpan data) {
+  const StatusWithSize erased = writer_.EraseForWrite(data.size_bytes());
+  if (!erased.ok()) {
+    return async2::Ready(erased.status());
+  }
+  if (erased.size() != 0) {
+    cx.ReEnqueue();
+    return async2::Pending();
+  }
+  return async2::Ready(writer_.Write(data));
+}
+
+async2::Poll<Status> AsyncBlobWriter::PendEraseAhead(async2::Context& cx) {
+  const StatusWithSize erased = writer_.EraseAhead();
+  if (!erased.ok()) {
+    return async2::Ready(erased.status());
+  }
+  if (erased.size() != 0) {
+    cx.ReEnqueue();
+    return async2::Pending();
+  }
+  return async2::Ready(OkStatus());
+}
+
+}  // namespace pw::blob_store
@@ -0,0 +1,170 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_blob_store/async_blob_writer.h"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include "pw_async2/dispatcher_for_test.h"
+#include "pw_async2/func_task.h"
+#include "pw_blob_store/blob_store.h"
+#include "pw_kvs/crc16_checksum.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/test_key_value_store.h"
+#include "pw_random/xor_shift.h"
+#include "pw_span/span.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::blob_store {
+namespace {
+
+using async2::Context;
+using async2::DispatcherForTest;
+using async2::FuncTask;
+using async2::Poll;
+
+class AsyncBlobWriterTest : public ::testing::Test {
+ protected:
+  AsyncBlobWriterTest()
+      : flash_(kFlashAlignment),
+        partition_(&flash_),
+        blob_("AsyncBlob", partition_, &checksum_, kvs::TestKvs(), kWriteSize) {
+  }
+
+  void SetUp() override {
+    random::XorShiftStarRng64 rng(0x5eed);
+    rng.Get(source_);
+    rng.Get(flash_.buffer());
+    ASSERT_EQ(OkStatus(), blob_.Init());
+  }
+
+  static constexpr size_t kFlashAlignment = 16;
+  static constexpr size_t kSectorSize = 1024;
+  static constexpr size_t kSectorCount = 4;
+  static constexpr size_t kWriteSize = 64;
+  static constexpr size_t kBufferSize = 256;
+
+  kvs::FakeFlashMemoryBuffer<kSectorSize, kSectorCount> flash_;
+  kvs::FlashPartition partition_;
+  kvs::ChecksumCrc16 checksum_;
+  BlobStoreBuffer<kBufferSize> blob_;
+  std::array<std::byte, kSectorCount * kSectorSize> source_;
+};
+
+TEST_F(AsyncBlobWriterTest, PendWrite_YieldsAfterEachErase) {
+  ASSERT_EQ(OkStatus(), blob_.SetPipelinedWrites(1));
+
+  BlobStore::BlobWriterWithBuffer<> writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  AsyncBlobWriter async_writer(writer);
+
+  DispatcherForTest dispatcher;
+  ConstByteSpan data = source_;
+  int polls = 0;
+  Status result = Status::Unknown();
+  FuncTask task([&](Context& cx) -> Poll<> {
+    ++polls;
+    while (!data.empty()) {
+      ConstByteSpan chunk = data.first(kBufferSize);
+      Poll<Status> poll = async_writer.PendWrite(cx, chunk);
+      if (poll.IsPending()) {
+        return async2::Pending();
+      }
+      if (!poll->ok()) {
+        result = *poll;
+        return async2::Ready();
+      }
+      data = data.subspan(chunk.size_bytes());
+    }
+    result = OkStatus();
+    return async2::Ready();
+  });
+  dispatcher.Post(task);
+  dispatcher.RunToCompletion();
+
+  ASSERT_EQ(OkStatus(), result);
+
+  // Each sector was erased in its own poll.
+  EXPECT_EQ(polls, static_cast<int>(kSectorCount + 1));
+
+  ASSERT_EQ(OkStatus(), writer.Close());
+
+  BlobStore::BlobReader reader(blob_);
+  ASSERT_EQ(OkStatus(), reader.Open());
+  Result<ConstByteSpan> blob = reader.GetMemoryMappedBlob();
+  ASSERT_EQ(OkStatus(), blob.status());
+  ASSERT_EQ(blob->size_bytes(), source_.size());
+  EXPECT_EQ(std::memcmp(blob->data(), source_.data(), source_.size()), 0);
+  EXPECT_EQ(OkStatus(), reader.Close());
+}
+
+TEST_F(AsyncBlobWriterTest, PendEraseAhead_ErasesWindow) {
+  ASSERT_EQ(OkStatus(), blob_.SetPipelinedWrites(kSectorCount));
+
+  BlobStore::BlobWriterWithBuffer<> writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  AsyncBlobWriter async_writer(writer);
+
+  DispatcherForTest dispatcher;
+  int polls = 0;
+  FuncTask task([&](Context& cx) -> Poll<> {
+    ++polls;
+    Poll<Status> poll = async_writer.PendEraseAhead(cx);
+    if (poll.IsPending()) {
+      return async2::Pending();
+    }
+    EXPECT_EQ(OkStatus(), *poll);
+    return async2::Ready();
+  });
+  dispatcher.Post(task);
+  dispatcher.RunToCompletion();
+  EXPECT_EQ(polls, static_cast<int>(kSectorCount + 1));
+
+  // The partition is erased, so the write does not yield.
+  FuncTask write_task([&](Context& cx) -> Poll<> {
+    Poll<Status> poll = async_writer.PendWrite(cx, source_);
+    EXPECT_TRUE(poll.IsReady());
+    if (poll.IsReady()) {
+      EXPECT_EQ(OkStatus(), *poll);
+    }
+    return async2::Ready();
+  });
+  dispatcher.Post(write_task);
+  dispatcher.RunToCompletion();
+
+  ASSERT_EQ(OkStatus(), writer.Close());
+}
+
+TEST_F(AsyncBlobWriterTest, PendWrite_NotOpen) {
+  BlobStore::BlobWriterWithBuffer<> writer(blob_);
+  AsyncBlobWriter async_writer(writer);
+
+  DispatcherForTest dispatcher;
+  FuncTask task([&](Context& cx) -> Poll<> {
+    Poll<Status> poll = async_writer.PendWrite(cx, source_);
+    EXPECT_TRUE(poll.IsReady());
+    if (poll.IsReady()) {
+      EXPECT_EQ(Status::FailedPrecondition(), *poll);
+    }
+    return async2::Ready();
+  });
+  dispatcher.Post(task);
+  dispatcher.RunToCompletion();
+}
+
+}  // namespace
+}  // namespace pw::blob_store
@@ -109,6 +109,14 @@ Status BlobStore::LoadMetadata() {
 
 size_t BlobStore::MaxDataSizeBytes() const { return partition_.size_bytes(); }
 
+Status BlobStore::SetPipelinedWrites(size_t erase_ahead_sectors) {
+  if (writer_open_) {
+    return Status::FailedPrecondition();
+  }
+  erase_ahead_sectors_ = erase_ahead_sectors;
+  return OkStatus();
+}
+
 Status BlobStore::OpenWrite() {
   if (!initialized_) {
     return Status::FailedPrecondition();
@@ -150,7 +158,13 @@ StatusWithSize BlobStore::ResumeWrite() {
   // Invalidate return status can be safely be ignored, only KVS::Delete can
   // result in an error and that KVS entry will overwriten on write Close.
   Invalidate().IgnoreError();
-  StatusWithSize written_sws = partition_.EndOfWrittenData();
+
+  // Pipelined writes only erase up to a sector past the written data, so any
+  // data after that may be left over from a previous blob. Search forward for
+  // the first erased sector rather than backward from the end of the
+  // partition.
+  StatusWithSize written_sws = pipelined() ? FindEndOfWrittenData()
+                                           : partition_.EndOfWrittenData();
   PW_TRY_WITH_SIZE(StatusWithSize(written_sws.status(), 0));
 
   // Round down to the number of fully written sectors.
@@ -173,6 +187,9 @@ StatusWithSize BlobStore::ResumeWrite() {
 
   flash_address_ = written_bytes_on_resume;
   write_address_ = written_bytes_on_resume;
+  erased_address_ = static_cast<kvs::FlashPartition::Address>(
+      written_bytes_on_resume +
+      sectors_to_erase * partition_.sector_size_bytes());
   valid_data_ = true;
   writer_open_ = true;
 
@@ -258,6 +275,10 @@ Status BlobStore::Write(ConstByteSpan data) {
     return Status::DataLoss();
   }
 
+  if (pipelined()) {
+    return WriteCombined(data);
+  }
+
   // Write in (up to) 3 steps:
   // 1) Finish filling write buffer and if full write it to flash.
   // 2) Write as many whole block-sized chunks as the data has remaining
@@ -336,6 +357,39 @@ Status BlobStore::Write(ConstByteSpan data) {
   return OkStatus();
 }
 
+Status BlobStore::WriteCombined(ConstByteSpan data) {
+  while (data.size_bytes() > 0) {
+    // Data that would fill the whole write buffer is written directly from the
+    // caller's buffer, rounded down to the flash write size.
+    if (WriteBufferEmpty() && data.size_bytes() >= write_buffer_.size_bytes()) {
+      const size_t write_size_bytes =
+          data.size_bytes() - (data.size_bytes() % flash_write_size_bytes_);
+      write_address_ += write_size_bytes;
+      if (!CommitToFlash(data.first(write_size_bytes)).ok()) {
+        return Status::DataLoss();
+      }
+      data = data.subspan(write_size_bytes);
+      continue;
+    }
+
+    // Otherwise, combine the data with any buffered bytes, and commit the
+    // buffer once it is full.
+    const size_t add_bytes =
+        std::min(WriteBufferBytesFree(), data.size_bytes());
+    std::memcpy(write_buffer_.data() + WriteBufferBytesUsed(),
+                data.data(),
+                add_bytes);
+    write_address_ += add_bytes;
+    data = data.subspan(add_bytes);
+
+    if (WriteBufferBytesFree() == 0 && !Flush().ok()) {
+      return Status::DataLoss();
+    }
+  }
+
+  return OkStatus();
+}
+
 Status BlobStore::AddToWriteBuffer(ConstByteSpan data) {
   if (!ValidToWrite()) {
     return Status::DataLoss();
@@ -428,6 +482,16 @@ Status BlobStore::CommitToFlash(ConstByteSpan source, size_t data_bytes) {
     data_bytes = source.size_bytes();
   }
 
+  if (pipelined()) {
+    // Keep the sector after the end of the data erased as well, so that
+    // resuming an interrupted write finds the end of the written data.
+    Status erase_status =
+        EraseThrough(EraseEndAddress(flash_address_ + source.size_bytes(), 1));
+    if (!erase_status.ok()) {
+      return erase_status;
+    }
+  }
+
   flash_erased_ = false;
   StatusWithSize result = partition_.Write(flash_address_, source);
   flash_address_ += data_bytes;
@@ -457,12 +521,114 @@ size_t BlobStore::WriteBufferBytesFree() const {
 
 Status BlobStore::EraseIfNeeded() {
   if (flash_address_ == 0) {
+    if (pipelined()) {
+      // Sectors are erased as they are written to. As with an erase of the
+      // whole partition, the blob is valid as soon as it is started.
+      valid_data_ = true;
+      return OkStatus();
+    }
+
     // Always just erase. Erase is smart enough to only erase if needed.
     return Erase();
   }
   return OkStatus();
 }
 
+kvs::FlashPartition::Address BlobStore::EraseEndAddress(
+    size_t data_end_address, size_t sectors_ahead) const {
+  const size_t sector_size = partition_.sector_size_bytes();
+  const size_t data_end_sector =
+      (data_end_address + sector_size - 1) / sector_size;
+  return static_cast<kvs::FlashPartition::Address>(std::min(
+      (data_end_sector + sectors_ahead) * sector_size, MaxDataSizeBytes()));
+}
+
+StatusWithSize BlobStore::EraseNextSector(
+    kvs::FlashPartition::Address end_address) {
+  if (erased_address_ >= end_address) {
+    return StatusWithSize(0);
+  }
+
+  PW_DCHECK_UINT_GE(erased_address_, flash_address_);
+  if (!partition_.Erase(erased_address_, 1).ok()) {
+    valid_data_ = false;
+    return StatusWithSize::DataLoss();
+  }
+  erased_address_ +=
+      static_cast<kvs::FlashPartition::Address>(partition_.sector_size_bytes());
+  return StatusWithSize(1);
+}
+
+Status BlobStore::EraseThrough(kvs::FlashPartition::Address end_address) {
+  while (erased_address_ < end_address) {
+    PW_TRY(EraseNextSector(end_address).status());
+  }
+  return OkStatus();
+}
+
+StatusWithSize BlobStore::EraseAhead() {
+  if (!pipelined()) {
+    return StatusWithSize(0);
+  }
+  if (!ValidToWrite()) {
+    return StatusWithSize::DataLoss();
+  }
+  return EraseNextSector(
+      EraseEndAddress(write_address_, erase_ahead_sectors_));
+}
+
+StatusWithSize BlobStore::EraseForWrite(size_t size_bytes) {
+  if (!pipelined()) {
+    return StatusWithSize(0);
+  }
+  if (!ValidToWrite()) {
+    return StatusWithSize::DataLoss();
+  }
+  const size_t data_end_address =
+      std::min(write_address_ + size_bytes, MaxDataSizeBytes());
+  return EraseNextSector(EraseEndAddress(data_end_address, 1));
+}
+
+StatusWithSize BlobStore::FindEndOfWrittenData() {
+  // Pipelined writes keep the sector after the written data erased, so the
+  // data ends before the first erased sector.
+  const size_t sector_size = partition_.sector_size_bytes();
+  size_t sector_end = 0;
+  bool erased = false;
+  while (sector_end < partition_.size_bytes() && !erased) {
+    PW_TRY_WITH_SIZE(partition_.IsRegionErased(
+        static_cast<kvs::FlashPartition::Address>(sector_end),
+        sector_size,
+        &erased));
+    if (!erased) {
+      sector_end += sector_size;
+    }
+  }
+  if (sector_end == 0) {
+    return StatusWithSize(0);
+  }
+
+  // Find the end of the data within the last written sector.
+  constexpr size_t kReadBufferSizeBytes = 32;
+  std::array<std::byte, kReadBufferSizeBytes> buffer;
+  const std::byte erased_byte = partition_.erased_memory_content();
+  size_t end = sector_end;
+  while (end > sector_end - sector_size) {
+    const size_t read_size =
+        std::min(buffer.size(), end - (sector_end - sector_size));
+    end -= read_size;
+    PW_TRY_WITH_SIZE(
+        partition_.Read(static_cast<kvs::FlashPartition::Address>(end),
+                        span(buffer).first(read_size)));
+    for (size_t i = read_size; i > 0; --i) {
+      if (buffer[i - 1] != erased_byte) {
+        return StatusWithSize(end + i);
+      }
+    }
+  }
+  return StatusWithSize(end);
+}
+
 StatusWithSize BlobStore::Read(size_t offset, ByteSpan dest) const {
   if (!HasData()) {
     return StatusWithSize::FailedPrecondition();
@@ -518,6 +684,8 @@ Status BlobStore::Erase() {
   PW_TRY(partition_.Erase());
 
   flash_erased_ = true;
+  erased_address_ =
+      static_cast<kvs::FlashPartition::Address>(MaxDataSizeBytes());
 
   // Blob data is considered valid as soon as the flash is erased. Even though
   // there are 0 bytes written, they are valid.
@@ -529,6 +697,16 @@ Status BlobStore::Invalidate() {
   // Blob data is considered valid if the flash is erased. Even though
   // there are 0 bytes written, they are valid.
   valid_data_ = flash_erased_;
+
+  // Flash past the committed data is still erased, unless the partition has
+  // been written to since it was erased.
+  if (flash_erased_) {
+    erased_address_ =
+        static_cast<kvs::FlashPartition::Address>(MaxDataSizeBytes());
+  } else if (flash_address_ != 0) {
+    erased_address_ = 0;
+  }
+
   ResetChecksum();
   write_address_ = 0;
   flash_address_ = 0;
@@ -580,10 +758,18 @@ Status BlobStore::CalculateChecksumFromFlash(size_t bytes_to_check,
       static_cast<kvs::FlashPartition::Address>(bytes_to_check);
 
   constexpr size_t kReadBufferSizeBytes = 32;
-  std::array<std::byte, kReadBufferSizeBytes> buffer;
+  std::array<std::byte, kReadBufferSizeBytes> stack_buffer;
+
+  // The checksum is calculated when no data is buffered, so read in larger
+  // blocks through the write buffer when it is available.
+  ByteSpan buffer = stack_buffer;
+  if (WriteBufferEmpty() && write_buffer_.size_bytes() > buffer.size_bytes()) {
+    buffer = write_buffer_;
+  }
+
   while (address < end) {
     const size_t read_size = std::min(size_t(end - address), buffer.size());
-    PW_TRY(partition_.Read(address, span(buffer).first(read_size)));
+    PW_TRY(partition_.Read(address, buffer.first(read_size)));
 
     checksum_algo_->Update(buffer.data(), read_size);
     address += read_size;
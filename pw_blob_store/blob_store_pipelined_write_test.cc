@@ -0,0 +1,241 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include "pw_blob_store/blob_store.h"
+#include "pw_kvs/crc16_checksum.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/test_key_value_store.h"
+#include "pw_random/xor_shift.h"
+#include "pw_span/span.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::blob_store {
+namespace {
+
+// Counts the sectors erased through the partition.
+class EraseCountingPartition final : public kvs::FlashPartition {
+ public:
+  explicit EraseCountingPartition(kvs::FlashMemory* flash)
+      : kvs::FlashPartition(flash) {}
+
+  using kvs::FlashPartition::Erase;
+
+  Status Erase(Address address, size_t num_sectors) override {
+    sectors_erased += num_sectors;
+    erase_calls += 1;
+    return kvs::FlashPartition::Erase(address, num_sectors);
+  }
+
+  size_t sectors_erased = 0;
+  size_t erase_calls = 0;
+};
+
+class PipelinedWriteTest : public ::testing::Test {
+ protected:
+  PipelinedWriteTest()
+      : flash_(kFlashAlignment),
+        partition_(&flash_),
+        blob_("Blob", partition_, &checksum_, kvs::TestKvs(), kWriteSize) {}
+
+  void SetUp() override {
+    random::XorShiftStarRng64 rng(0x5eed);
+    rng.Get(source_);
+
+    // Start from flash holding stale data, so that writing to any sector
+    // which was not erased first fails.
+    InitFlashToRandom(0x9223);
+    ASSERT_EQ(OkStatus(), blob_.Init());
+    ASSERT_EQ(OkStatus(), blob_.SetPipelinedWrites(kEraseAheadSectors));
+  }
+
+  void InitFlashToRandom(uint64_t seed) {
+    random::XorShiftStarRng64 rng(seed);
+    rng.Get(flash_.buffer());
+  }
+
+  void WriteInChunks(BlobStore::BlobWriter& writer,
+                     ConstByteSpan data,
+                     size_t chunk_size) {
+    while (!data.empty()) {
+      const size_t write_size = std::min(data.size_bytes(), chunk_size);
+      ASSERT_EQ(OkStatus(), writer.Write(data.first(write_size)));
+      data = data.subspan(write_size);
+    }
+  }
+
+  void VerifyBlob(size_t size_bytes) {
+    BlobStore::BlobReader reader(blob_);
+    ASSERT_EQ(OkStatus(), reader.Open());
+    Result<ConstByteSpan> result = reader.GetMemoryMappedBlob();
+    ASSERT_EQ(OkStatus(), result.status());
+    ASSERT_EQ(result->size_bytes(), size_bytes);
+    EXPECT_EQ(std::memcmp(result->data(), source_.data(), size_bytes), 0);
+    EXPECT_EQ(OkStatus(), reader.Close());
+  }
+
+  void WriteAndVerify(size_t chunk_size) {
+    BlobStore::BlobWriterWithBuffer<> writer(blob_);
+    ASSERT_EQ(OkStatus(), writer.Open());
+    WriteInChunks(writer, source_, chunk_size);
+    ASSERT_EQ(OkStatus(), writer.Close());
+    VerifyBlob(source_.size());
+  }
+
+  static constexpr size_t kFlashAlignment = 16;
+  static constexpr size_t kSectorSize = 512;
+  static constexpr size_t kSectorCount = 8;
+  static constexpr size_t kWriteSize = 64;
+  static constexpr size_t kBufferSize = 256;
+  static constexpr size_t kEraseAheadSectors = 2;
+
+  kvs::FakeFlashMemoryBuffer<kSectorSize, kSectorCount> flash_;
+  EraseCountingPartition partition_;
+  kvs::ChecksumCrc16 checksum_;
+  BlobStoreBuffer<kBufferSize> blob_;
+  std::array<std::byte, kSectorCount * kSectorSize> source_;
+};
+
+TEST_F(PipelinedWriteTest, SmallChunks) { WriteAndVerify(3); }
+
+TEST_F(PipelinedWriteTest, WriteSizeChunks) { WriteAndVerify(kWriteSize); }
+
+TEST_F(PipelinedWriteTest, UnalignedChunks) { WriteAndVerify(kBufferSize + 7); }
+
+TEST_F(PipelinedWriteTest, WholeBlobInOneWrite) {
+  WriteAndVerify(source_.size());
+}
+
+TEST_F(PipelinedWriteTest, PartialBlob) {
+  BlobStore::BlobWriterWithBuffer<> writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  WriteInChunks(writer, span(source_).first(kSectorSize + 100), 10);
+  ASSERT_EQ(OkStatus(), writer.Close());
+  VerifyBlob(kSectorSize + 100);
+}
+
+TEST_F(PipelinedWriteTest, ErasesSectorsAsTheyAreReached) {
+  BlobStore::BlobWriterWithBuffer<> writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+
+  // Nothing is erased until data is committed to flash.
+  ASSERT_EQ(OkStatus(), writer.Write(span(source_).first(16)));
+  EXPECT_EQ(partition_.sectors_erased, 0u);
+
+  // Committing data erases its sector and the next one.
+  ASSERT_EQ(OkStatus(), writer.Write(span(source_).subspan(16, kBufferSize)));
+  EXPECT_EQ(partition_.sectors_erased, 2u);
+
+  WriteInChunks(
+      writer, span(source_).subspan(16 + kBufferSize, 2 * kSectorSize), 100);
+  EXPECT_LE(partition_.sectors_erased, 4u);
+
+  ASSERT_EQ(OkStatus(), writer.Close());
+  EXPECT_LE(partition_.sectors_erased, 4u);
+  EXPECT_EQ(partition_.erase_calls, partition_.sectors_erased);
+}
+
+TEST_F(PipelinedWriteTest, EraseAhead_ErasesWindowOneSectorAtATime) {
+  BlobStore::BlobWriterWithBuffer<> writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+
+  StatusWithSize result = writer.EraseAhead();
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(result.size(), 1u);
+  result = writer.EraseAhead();
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(result.size(), 1u);
+
+  // The window is erased.
+  result = writer.EraseAhead();
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(result.size(), 0u);
+  EXPECT_EQ(partition_.sectors_erased, kEraseAheadSectors);
+
+  // Writing into the erased window does not erase anything else.
+  WriteInChunks(writer, span(source_).first(kSectorSize / 2), kWriteSize);
+  EXPECT_EQ(partition_.sectors_erased, kEraseAheadSectors);
+
+  // The window moves with the write position.
+  WriteInChunks(writer, span(source_).subspan(kSectorSize / 2, kSectorSize), 1);
+  EXPECT_EQ(partition_.sectors_erased, 3u);
+  result = writer.EraseAhead();
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(result.size(), 1u);
+  EXPECT_EQ(partition_.sectors_erased, 4u);
+
+  ASSERT_EQ(OkStatus(), writer.Close());
+  VerifyBlob(kSectorSize + kSectorSize / 2);
+}
+
+TEST_F(PipelinedWriteTest, EraseAhead_Disabled) {
+  ASSERT_EQ(OkStatus(), blob_.SetPipelinedWrites(0));
+
+  BlobStore::BlobWriterWithBuffer<> writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  StatusWithSize result = writer.EraseAhead();
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(result.size(), 0u);
+
+  // The first write erases the whole partition.
+  ASSERT_EQ(OkStatus(), writer.Write(span(source_).first(kWriteSize)));
+  EXPECT_EQ(partition_.sectors_erased, kSectorCount);
+  ASSERT_EQ(OkStatus(), writer.Close());
+}
+
+TEST_F(PipelinedWriteTest, SetPipelinedWrites_FailsWithWriterOpen) {
+  BlobStore::BlobWriterWithBuffer<> writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  EXPECT_EQ(Status::FailedPrecondition(), blob_.SetPipelinedWrites(0));
+  ASSERT_EQ(OkStatus(), writer.Close());
+  EXPECT_EQ(OkStatus(), blob_.SetPipelinedWrites(0));
+}
+
+TEST_F(PipelinedWriteTest, RewriteAfterClose) {
+  WriteAndVerify(kWriteSize);
+
+  // The previous blob is erased again as the new blob is written.
+  random::XorShiftStarRng64 rng(0xbeef);
+  rng.Get(source_);
+  WriteAndVerify(kBufferSize);
+}
+
+TEST_F(PipelinedWriteTest, Resume_IgnoresStaleDataPastErasedSector) {
+  constexpr size_t kWrittenBytes = 2 * kSectorSize + kSectorSize / 2;
+  {
+    BlobStore::BlobWriterWithBuffer<> writer(blob_);
+    ASSERT_EQ(OkStatus(), writer.Open());
+    WriteInChunks(writer, span(source_).first(kWrittenBytes), kBufferSize);
+    ASSERT_EQ(OkStatus(), writer.Abandon());
+  }
+
+  // Sectors past the one after the written data still hold stale data, which
+  // must not be mistaken for part of the blob. As for other writes, resuming
+  // drops the partially written sector and the full sector before it.
+  BlobStore::BlobWriterWithBuffer<> writer(blob_);
+  StatusWithSize resume = writer.Resume();
+  ASSERT_EQ(OkStatus(), resume.status());
+  EXPECT_EQ(resume.size(), kSectorSize);
+
+  WriteInChunks(writer, span(source_).subspan(resume.size()), kWriteSize);
+  ASSERT_EQ(OkStatus(), writer.Close());
+  VerifyBlob(source_.size());
+}
+
+}  // namespace
+}  // namespace pw::blob_store
@@ -0,0 +1,63 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include "pw_async2/context.h"
+#include "pw_async2/poll.h"
+#include "pw_blob_store/blob_store.h"
+#include "pw_bytes/span.h"
+#include "pw_status/status.h"
+
+namespace pw::blob_store {
+
+// Writes to a BlobStore from a pw_async2 task.
+//
+// Erasing a flash sector can take tens to hundreds of milliseconds. In
+// pipelined mode (see BlobStore::SetPipelinedWrites()), AsyncBlobWriter erases
+// at most one sector each time it is polled and then yields to the dispatcher,
+// so that other tasks continue to run while a blob is written. Without
+// pipelining, the first write erases the whole partition before returning.
+//
+// The AsyncBlobWriter does not open or close the underlying BlobWriter.
+class AsyncBlobWriter {
+ public:
+  constexpr explicit AsyncBlobWriter(BlobStore::BlobWriter& writer)
+      : writer_(writer) {}
+
+  AsyncBlobWriter(const AsyncBlobWriter&) = delete;
+  AsyncBlobWriter& operator=(const AsyncBlobWriter&) = delete;
+
+  // Writes data to the blob once the flash it needs is erased. The same data
+  // must be passed to each call until the write completes. Returns:
+  //
+  // Ready(OK) - The data was written.
+  // Ready(error) - The write failed; see BlobWriter::Write().
+  // Pending - A sector was erased. The task is re-enqueued to continue the
+  //     write.
+  async2::Poll<Status> PendWrite(async2::Context& cx, ConstByteSpan data);
+
+  // Erases the sectors of the erase-ahead window one at a time. Intended to be
+  // polled while the writer waits for data. Returns:
+  //
+  // Ready(OK) - The erase-ahead window is erased, or pipelined writes are
+  //     disabled.
+  // Ready(error) - See BlobWriter::EraseAhead().
+  // Pending - A sector was erased. The task is re-enqueued to continue.
+  async2::Poll<Status> PendEraseAhead(async2::Context& cx);
+
+ private:
+  BlobStore::BlobWriter& writer_;
+};
+
+}  // namespace pw::blob_store
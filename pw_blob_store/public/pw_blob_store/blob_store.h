@@ -32,6 +32,8 @@
 /// Blob data library
 namespace pw::blob_store {
 
+class AsyncBlobWriter;
+
 // BlobStore is a storage container for a single blob of data. BlobStore is
 // a FlashPartition-backed persistent storage system with integrated data
 // integrity checking that serves as a lightweight alternative to a file
@@ -180,6 +182,22 @@ class BlobStore {
       return open_ ? store_.Invalidate() : Status::FailedPrecondition();
     }
 
+    // In pipelined mode, erases the next sector of the erase-ahead window if it
+    // is not already erased. Writes erase the sectors they need on demand, so
+    // calling this is optional; calling it while the writer is otherwise idle,
+    // such as while waiting for more data to arrive, moves the erases off the
+    // write path. Returns:
+    //
+    // OK, size - Number of sectors erased. 0 if the erase-ahead window is
+    //     already erased or pipelined writes are disabled.
+    // FAILED_PRECONDITION - not open.
+    // DATA_LOSS - Erase failed or a previous write failed. No more will be
+    //     written for the current blob.
+    StatusWithSize EraseAhead() {
+      return open_ ? store_.EraseAhead()
+                   : StatusWithSize::FailedPrecondition();
+    }
+
     // Sets file name to be associated with the data written by this
     // ``BlobWriter``. This may be changed any time before Close() is called.
     //
@@ -248,6 +266,15 @@ class BlobStore {
     bool open_;
 
    private:
+    friend class ::pw::blob_store::AsyncBlobWriter;
+
+    // Erases the next sector, if any, that must be erased before size_bytes
+    // more bytes can be written. Returns the number of sectors erased.
+    StatusWithSize EraseForWrite(size_t size_bytes) {
+      return open_ ? store_.EraseForWrite(size_bytes)
+                   : StatusWithSize::FailedPrecondition();
+    }
+
     // Probable (not guaranteed) minimum number of bytes at this time that can
     // be written. This is not necessarily the full number of bytes remaining in
     // the blob. Returns zero if, in the current state, Write would return
@@ -446,7 +473,9 @@ class BlobStore {
         readers_open_(0),
         write_address_(0),
         flash_address_(0),
-        file_name_length_(0) {}
+        file_name_length_(0),
+        erase_ahead_sectors_(0),
+        erased_address_(0) {}
 
   BlobStore(const BlobStore&) = delete;
   BlobStore& operator=(const BlobStore&) = delete;
@@ -471,6 +500,30 @@ class BlobStore {
   // false -  Blob is either invalid or does not have any data bytes
   bool HasData() const { return (valid_data_ && ReadableDataBytes() > 0); }
 
+  // Enables pipelined writes when erase_ahead_sectors is non-zero, or disables
+  // them when it is zero. Pipelined writes are disabled by default.
+  //
+  // Without pipelining, the whole partition is erased when the first data of
+  // a blob is written, and written data is committed to flash in
+  // flash_write_size_bytes chunks.
+  //
+  // With pipelining:
+  // - Sectors are erased one at a time as the write position reaches them, so
+  //   the cost of erasing is spread across the write instead of stalling the
+  //   first write. BlobWriter::EraseAhead() erases up to erase_ahead_sectors
+  //   sectors past the write position ahead of time.
+  // - Small writes are combined in the write buffer and committed to flash
+  //   once the whole buffer is full, in as few flash writes as possible.
+  // - Resume() finds the end of the written data by scanning forward for the
+  //   first erased sector, since sectors past the written data may still hold
+  //   data from a previous blob.
+  //
+  // Returns:
+  //
+  // OK - success.
+  // FAILED_PRECONDITION - A writer is open.
+  Status SetPipelinedWrites(size_t erase_ahead_sectors);
+
  private:
   Status LoadMetadata();
 
@@ -576,6 +629,32 @@ class BlobStore {
 
   Status EraseIfNeeded();
 
+  bool pipelined() const { return erase_ahead_sectors_ != 0; }
+
+  // Pipelined version of Write(), called after the data is validated.
+  Status WriteCombined(ConstByteSpan data);
+
+  // Returns the address up to which flash must be erased to write data up to
+  // data_end_address, with sectors_ahead additional erased sectors after the
+  // sector holding the end of the data.
+  kvs::FlashPartition::Address EraseEndAddress(size_t data_end_address,
+                                               size_t sectors_ahead) const;
+
+  // Erases the sector at erased_address_ if it is before end_address. Returns
+  // the number of sectors erased.
+  StatusWithSize EraseNextSector(kvs::FlashPartition::Address end_address);
+
+  // Erases sectors until flash is erased up to end_address.
+  Status EraseThrough(kvs::FlashPartition::Address end_address);
+
+  StatusWithSize EraseAhead();
+
+  StatusWithSize EraseForWrite(size_t size_bytes);
+
+  // Finds the end of the data written in pipelined mode, which may be followed
+  // by data left over from a previous blob.
+  StatusWithSize FindEndOfWrittenData();
+
   // Read valid data. Attempts to read the lesser of output.size_bytes() or
   // available bytes worth of data. Returns:
   //
@@ -675,6 +754,13 @@ class BlobStore {
 
   // Length of the stored blob's filename.
   size_t file_name_length_;
+
+  // Number of sectors to erase ahead of the write position in pipelined mode,
+  // or 0 if pipelined writes are disabled.
+  size_t erase_ahead_sectors_;
+
+  // End of the erased flash past flash_address_, used in pipelined mode.
+  kvs::FlashPartition::Address erased_address_;
 };
 
 // Creates a BlobStore with the buffer of kBufferSizeBytes.
@@ -0,0 +1,227 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_channel/epoll_socket_channel.h"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#include "pw_assert/check.h"
+#include "pw_log/log.h"
+
+namespace pw::channel {
+
+using ::pw::async2::Context;
+using ::pw::async2::EpollDispatcher;
+using ::pw::async2::Pending;
+using ::pw::async2::Poll;
+using ::pw::async2::PollOptional;
+using ::pw::async2::PollResult;
+using ::pw::async2::Ready;
+using ::pw::multibuf::MultiBuf;
+using ::pw::multibuf::MultiBufAllocator;
+
+namespace {
+
+// Smallest buffer that a byte channel will read into when memory is scarce.
+constexpr size_t kMinimumByteReadSize = 64;
+
+bool WouldBlock(int error) { return error == EAGAIN || error == EWOULDBLOCK; }
+
+}  // namespace
+
+template <DataType kType>
+EpollSocketChannel<kType>::EpollSocketChannel(
+    EpollDispatcher& dispatcher,
+    int fd,
+    MultiBufAllocator& read_allocator,
+    MultiBufAllocator& write_allocator,
+    size_t read_size)
+    : dispatcher_(dispatcher),
+      fd_(fd),
+      read_size_(read_size),
+      read_allocation_future_(read_allocator),
+      write_allocation_future_(write_allocator) {
+  const int flags = fcntl(fd_, F_GETFL);
+  PW_CHECK_INT_NE(flags, -1, "Invalid socket: %s", std::strerror(errno));
+  PW_CHECK_INT_NE(fcntl(fd_, F_SETFL, flags | O_NONBLOCK),
+                  -1,
+                  "Failed to make socket nonblocking: %s",
+                  std::strerror(errno));
+  PW_CHECK_OK(dispatcher_.NativeRegisterFileDescriptor(
+      fd_, EpollDispatcher::FileDescriptorType::kReadWrite));
+}
+
+template <DataType kType>
+PollResult<MultiBuf> EpollSocketChannel<kType>::DoPendRead(Context& cx) {
+  if (!read_buffer_.has_value()) {
+    const size_t min_size = kType == DataType::kByte
+                                ? std::min(kMinimumByteReadSize, read_size_)
+                                : read_size_;
+    read_allocation_future_.SetDesiredSizes(
+        min_size, read_size_, multibuf::v1::kNeedsContiguous);
+    PollOptional<MultiBuf> buffer = read_allocation_future_.Pend(cx);
+    if (buffer.IsPending()) {
+      return Pending();
+    }
+    if (!buffer->has_value()) {
+      PW_LOG_ERROR("Failed to allocate multibuf for reading");
+      return Status::ResourceExhausted();
+    }
+    read_buffer_ = std::move(**buffer);
+  }
+
+  // Receive directly into the buffer. For datagrams, MSG_TRUNC returns the
+  // full length of the datagram, so that truncation can be detected.
+  constexpr int kFlags = kType == DataType::kDatagram ? MSG_TRUNC : 0;
+  const ByteSpan buffer = *read_buffer_->ContiguousSpan();
+  while (true) {
+    const ssize_t result = recv(fd_, buffer.data(), buffer.size(), kFlags);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (WouldBlock(errno)) {
+        // The socket is edge-triggered, and was just drained, so the
+        // dispatcher will wake this task when more data arrives.
+        PW_ASYNC_STORE_WAKER(
+            cx,
+            dispatcher_.NativeAddReadWakerForFileDescriptor(fd_),
+            "EpollSocketChannel is waiting for the socket to be readable");
+        return Pending();
+      }
+      PW_LOG_ERROR("Failed to read from socket: %s", std::strerror(errno));
+      return Status::Unavailable();
+    }
+
+    const auto size = static_cast<size_t>(result);
+    if constexpr (kType == DataType::kByte) {
+      if (size == 0) {
+        return Status::OutOfRange();
+      }
+    } else {
+      if (size > buffer.size()) {
+        PW_LOG_WARN("Dropped %zu byte datagram; the read size is %zu bytes",
+                    size,
+                    buffer.size());
+        continue;
+      }
+    }
+
+    MultiBuf data = std::move(*read_buffer_);
+    read_buffer_.reset();
+    data.Truncate(size);
+    return data;
+  }
+}
+
+template <DataType kType>
+Poll<Status> EpollSocketChannel<kType>::DoPendReadyToWrite(Context& cx) {
+  // Only accept more data once everything staged so far has been handed to
+  // the socket, so that a full socket pushes back on the writer.
+  return FlushWrites(cx);
+}
+
+template <DataType kType>
+Status EpollSocketChannel<kType>::DoStageWrite(MultiBuf&& data) {
+  if constexpr (kType == DataType::kDatagram) {
+    PW_DASSERT(!pending_write_.has_value());
+    if (data.Chunks().size() > kMaxWriteChunks) {
+      return Status::InvalidArgument();
+    }
+  }
+  if (pending_write_.has_value()) {
+    pending_write_->PushSuffix(std::move(data));
+  } else {
+    pending_write_ = std::move(data);
+  }
+  return OkStatus();
+}
+
+template <DataType kType>
+Poll<Status> EpollSocketChannel<kType>::FlushWrites(Context& cx) {
+  while (pending_write_.has_value()) {
+    std::array<iovec, kMaxWriteChunks> iov;
+    size_t num_chunks = 0;
+    for (auto& chunk : pending_write_->Chunks()) {
+      if (num_chunks == iov.size()) {
+        break;
+      }
+      if (!chunk.empty()) {
+        iov[num_chunks++] = {chunk.data(), chunk.size()};
+      }
+    }
+
+    msghdr message = {};
+    message.msg_iov = iov.data();
+    message.msg_iovlen = num_chunks;
+    const ssize_t result = sendmsg(fd_, &message, MSG_NOSIGNAL);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (WouldBlock(errno)) {
+        PW_ASYNC_STORE_WAKER(
+            cx,
+            dispatcher_.NativeAddWriteWakerForFileDescriptor(fd_),
+            "EpollSocketChannel is waiting for the socket to be writable");
+        return Pending();
+      }
+      PW_LOG_ERROR("Failed to write to socket: %s", std::strerror(errno));
+      pending_write_.reset();
+      return Status::Unavailable();
+    }
+
+    const auto size = static_cast<size_t>(result);
+    if (kType == DataType::kDatagram || size == pending_write_->size()) {
+      pending_write_.reset();
+    } else {
+      pending_write_->DiscardPrefix(size);
+    }
+  }
+  return Ready(OkStatus());
+}
+
+template <DataType kType>
+Poll<Status> EpollSocketChannel<kType>::DoPendClose(Context& cx) {
+  Poll<Status> flushed = FlushWrites(cx);
+  if (flushed.IsPending()) {
+    return Pending();
+  }
+  read_buffer_.reset();
+  Close();
+  return flushed;
+}
+
+template <DataType kType>
+void EpollSocketChannel<kType>::Close() {
+  if (fd_ == kInvalidFd) {
+    return;
+  }
+  dispatcher_.NativeUnregisterFileDescriptor(fd_).IgnoreError();
+  close(fd_);
+  fd_ = kInvalidFd;
+}
+
+template class EpollSocketChannel<DataType::kByte>;
+template class EpollSocketChannel<DataType::kDatagram>;
+
+}  // namespace pw::channel
@@ -0,0 +1,158 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <sys/socket.h>
+
+#include <array>
+#include <cstddef>
+
+#include "pw_assert/check.h"
+#include "pw_async2/epoll_dispatcher.h"
+#include "pw_async2/func_task.h"
+#include "pw_channel/epoll_socket_channel.h"
+#include "pw_channel/stream_channel.h"
+#include "pw_memory/no_destructor.h"
+#include "pw_multibuf/simple_allocator_for_test.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_stream/socket_stream.h"
+#include "pw_thread/test_thread_context.h"
+
+namespace pw::channel {
+namespace {
+
+using async2::Context;
+using async2::EpollDispatcher;
+using async2::FuncTask;
+using async2::Pending;
+using async2::Poll;
+using async2::Ready;
+using multibuf::MultiBuf;
+using multibuf::test::SimpleAllocatorForTest;
+
+// Amount of data sent through the channels per iteration.
+constexpr size_t kBlockSize = 4096;
+
+using Allocator = SimpleAllocatorForTest<4 * kBlockSize>;
+
+std::array<int, 2> MakeSocketPair() {
+  std::array<int, 2> fds;
+  PW_CHECK_INT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds.data()), 0);
+  return fds;
+}
+
+// Writes a block to one channel and reads until the whole block has arrived
+// at the other, over a Unix domain socket.
+void SendBlocks(perf_test::State& state,
+                EpollDispatcher& dispatcher,
+                ByteReaderWriter& sender,
+                ByteReaderWriter& receiver,
+                Allocator& allocator) {
+  while (state.KeepRunning()) {
+    std::optional<MultiBuf> block = allocator.Allocate(kBlockSize);
+    PW_CHECK(block.has_value());
+    size_t received = 0;
+
+    FuncTask send_task([&](Context& cx) -> Poll<> {
+      if (block.has_value()) {
+        if (sender.PendReadyToWrite(cx).IsPending()) {
+          return Pending();
+        }
+        PW_CHECK_OK(sender.StageWrite(std::move(*block)));
+        block.reset();
+      }
+      if (sender.PendWrite(cx).IsPending()) {
+        return Pending();
+      }
+      return Ready();
+    });
+    FuncTask receive_task([&](Context& cx) -> Poll<> {
+      while (received < kBlockSize) {
+        auto read = receiver.PendRead(cx);
+        if (read.IsPending()) {
+          return Pending();
+        }
+        PW_CHECK_OK(read->status());
+        received += (*read)->size();
+      }
+      return Ready();
+    });
+    dispatcher.Post(send_task);
+    dispatcher.Post(receive_task);
+    dispatcher.RunToCompletion();
+  }
+}
+
+void EpollSocketChannelThroughput(perf_test::State& state) {
+  EpollDispatcher dispatcher;
+  Allocator read_allocator;
+  Allocator write_allocator;
+  const std::array<int, 2> fds = MakeSocketPair();
+  EpollByteSocketChannel sender(
+      dispatcher, fds[0], read_allocator, write_allocator);
+  EpollByteSocketChannel receiver(
+      dispatcher, fds[1], read_allocator, write_allocator);
+  SendBlocks(state,
+             dispatcher,
+             sender.as<ByteReaderWriter>(),
+             receiver.as<ByteReaderWriter>(),
+             write_allocator);
+}
+
+// StreamChannel's threads never exit, so its channels and everything they
+// use must live forever.
+struct StreamChannelState {
+  StreamChannelState()
+      : fds(MakeSocketPair()),
+        sender_stream(fds[0]),
+        receiver_stream(fds[1]) {}
+
+  Allocator read_allocator;
+  Allocator write_allocator;
+  thread::test::TestThreadContext sender_read_thread;
+  thread::test::TestThreadContext sender_write_thread;
+  thread::test::TestThreadContext receiver_read_thread;
+  thread::test::TestThreadContext receiver_write_thread;
+  std::array<int, 2> fds;
+  stream::SocketStream sender_stream;
+  stream::SocketStream receiver_stream;
+};
+
+void StreamChannelThroughput(perf_test::State& state) {
+  static NoDestructor<StreamChannelState> s;
+  static NoDestructor<StreamChannel> sender(s->sender_stream,
+                                            s->sender_read_thread.options(),
+                                            s->read_allocator,
+                                            s->sender_stream,
+                                            s->sender_write_thread.options(),
+                                            s->write_allocator);
+  static NoDestructor<StreamChannel> receiver(
+      s->receiver_stream,
+      s->receiver_read_thread.options(),
+      s->read_allocator,
+      s->receiver_stream,
+      s->receiver_write_thread.options(),
+      s->write_allocator);
+  EpollDispatcher dispatcher;
+  SendBlocks(state,
+             dispatcher,
+             sender->channel(),
+             receiver->channel(),
+             s->write_allocator);
+}
+
+PW_PERF_TEST(Channel_EpollSocketChannel, EpollSocketChannelThroughput);
+PW_PERF_TEST(Channel_StreamChannel, StreamChannelThroughput);
+
+}  // namespace
+}  // namespace pw::channel
@@ -0,0 +1,250 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_channel/epoll_socket_channel.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstddef>
+
+#include "pw_assert/check.h"
+#include "pw_async2/epoll_dispatcher.h"
+#include "pw_async2/func_task.h"
+#include "pw_bytes/array.h"
+#include "pw_multibuf/simple_allocator_for_test.h"
+#include "pw_status/status.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using ::pw::OkStatus;
+using ::pw::Status;
+using ::pw::async2::Context;
+using ::pw::async2::EpollDispatcher;
+using ::pw::async2::FuncTask;
+using ::pw::async2::Pending;
+using ::pw::async2::Poll;
+using ::pw::async2::Ready;
+using ::pw::channel::EpollByteSocketChannel;
+using ::pw::channel::EpollDatagramSocketChannel;
+using ::pw::multibuf::MultiBuf;
+using ::pw::multibuf::test::SimpleAllocatorForTest;
+
+constexpr auto kData = pw::bytes::Array<1, 2, 3, 4, 5>();
+
+// Creates a connected pair of sockets. The channel under test owns the first,
+// and the test reads from and writes to the second.
+class SocketPair {
+ public:
+  explicit SocketPair(int type) {
+    PW_CHECK_INT_EQ(socketpair(AF_UNIX, type, 0, fds_.data()), 0);
+  }
+
+  ~SocketPair() {
+    if (peer() != -1) {
+      close(peer());
+    }
+  }
+
+  int channel_fd() const { return fds_[0]; }
+  int peer() const { return fds_[1]; }
+
+  void ClosePeer() {
+    close(peer());
+    fds_[1] = -1;
+  }
+
+ private:
+  std::array<int, 2> fds_;
+};
+
+template <typename Channel>
+class EpollSocketChannelTest : public ::testing::Test {
+ protected:
+  EpollSocketChannelTest(int type, size_t read_size)
+      : sockets_(type),
+        channel_(dispatcher_,
+                 sockets_.channel_fd(),
+                 read_allocator_,
+                 write_allocator_,
+                 read_size) {}
+
+  // Reads from the channel until data or an error is returned.
+  pw::Result<MultiBuf> Read() {
+    pw::Result<MultiBuf> result = Status::Unknown();
+    FuncTask task([this, &result](Context& cx) -> Poll<> {
+      auto read = channel_.PendRead(cx);
+      if (read.IsPending()) {
+        return Pending();
+      }
+      result = std::move(*read);
+      return Ready();
+    });
+    dispatcher_.Post(task);
+    dispatcher_.RunToCompletion();
+    return result;
+  }
+
+  Status Write(MultiBuf&& data) {
+    Status status = Status::Unknown();
+    FuncTask task([&](Context& cx) -> Poll<> {
+      if (!data.empty()) {
+        auto ready = channel_.PendReadyToWrite(cx);
+        if (ready.IsPending()) {
+          return Pending();
+        }
+        if (!ready->ok()) {
+          status = *ready;
+          return Ready();
+        }
+        if (status = channel_.StageWrite(std::move(data)); !status.ok()) {
+          return Ready();
+        }
+      }
+      auto written = channel_.PendWrite(cx);
+      if (written.IsPending()) {
+        return Pending();
+      }
+      status = *written;
+      return Ready();
+    });
+    dispatcher_.Post(task);
+    dispatcher_.RunToCompletion();
+    return status;
+  }
+
+  EpollDispatcher dispatcher_;
+  SimpleAllocatorForTest<> read_allocator_;
+  SimpleAllocatorForTest<> write_allocator_;
+  SocketPair sockets_;
+  Channel channel_;
+};
+
+class EpollByteSocketChannelTest
+    : public EpollSocketChannelTest<EpollByteSocketChannel> {
+ protected:
+  EpollByteSocketChannelTest()
+      : EpollSocketChannelTest(SOCK_STREAM,
+                               EpollByteSocketChannel::kDefaultReadSize) {}
+};
+
+class EpollDatagramSocketChannelTest
+    : public EpollSocketChannelTest<EpollDatagramSocketChannel> {
+ protected:
+  static constexpr size_t kMaxDatagramSize = 8;
+
+  EpollDatagramSocketChannelTest()
+      : EpollSocketChannelTest(SOCK_DGRAM, kMaxDatagramSize) {}
+};
+
+TEST_F(EpollByteSocketChannelTest, ReadsAvailableData) {
+  ASSERT_EQ(write(sockets_.peer(), kData.data(), kData.size()),
+            static_cast<ssize_t>(kData.size()));
+
+  auto result = Read();
+  ASSERT_EQ(result.status(), OkStatus());
+  std::array<std::byte, kData.size()> out;
+  ASSERT_EQ(result->size(), out.size());
+  EXPECT_EQ(result->CopyTo(out).status(), OkStatus());
+  EXPECT_EQ(out, kData);
+}
+
+TEST_F(EpollByteSocketChannelTest, WakesReaderWhenDataArrives) {
+  pw::Result<MultiBuf> result = Status::Unknown();
+  FuncTask task([this, &result](Context& cx) -> Poll<> {
+    auto read = channel_.PendRead(cx);
+    if (read.IsPending()) {
+      return Pending();
+    }
+    result = std::move(*read);
+    return Ready();
+  });
+  dispatcher_.Post(task);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled());
+
+  ASSERT_EQ(write(sockets_.peer(), kData.data(), kData.size()),
+            static_cast<ssize_t>(kData.size()));
+  dispatcher_.RunToCompletion();
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result->size(), kData.size());
+}
+
+TEST_F(EpollByteSocketChannelTest, ReadAfterPeerClosesIsOutOfRange) {
+  sockets_.ClosePeer();
+  EXPECT_EQ(Read().status(), Status::OutOfRange());
+}
+
+TEST_F(EpollByteSocketChannelTest, WritesAllChunks) {
+  MultiBuf data = write_allocator_.BufWith({kData[0], kData[1]});
+  data.PushSuffix(write_allocator_.BufWith({kData[2], kData[3], kData[4]}));
+  ASSERT_EQ(Write(std::move(data)), OkStatus());
+
+  std::array<std::byte, kData.size()> out;
+  ASSERT_EQ(read(sockets_.peer(), out.data(), out.size()),
+            static_cast<ssize_t>(out.size()));
+  EXPECT_EQ(out, kData);
+}
+
+TEST_F(EpollByteSocketChannelTest, CloseClosesSocket) {
+  FuncTask task([this](Context& cx) -> Poll<> {
+    if (channel_.PendClose(cx).IsPending()) {
+      return Pending();
+    }
+    return Ready();
+  });
+  dispatcher_.Post(task);
+  dispatcher_.RunToCompletion();
+  EXPECT_FALSE(channel_.is_read_open());
+
+  std::byte b;
+  EXPECT_EQ(read(sockets_.peer(), &b, 1), 0);
+}
+
+TEST_F(EpollDatagramSocketChannelTest, PreservesDatagramBoundaries) {
+  ASSERT_EQ(send(sockets_.peer(), kData.data(), 2, 0), 2);
+  ASSERT_EQ(send(sockets_.peer(), kData.data() + 2, 3, 0), 3);
+
+  auto first = Read();
+  ASSERT_EQ(first.status(), OkStatus());
+  EXPECT_EQ(first->size(), 2u);
+  auto second = Read();
+  ASSERT_EQ(second.status(), OkStatus());
+  EXPECT_EQ(second->size(), 3u);
+}
+
+TEST_F(EpollDatagramSocketChannelTest, DropsOversizedDatagrams) {
+  std::array<std::byte, kMaxDatagramSize + 1> oversized{};
+  ASSERT_EQ(send(sockets_.peer(), oversized.data(), oversized.size(), 0),
+            static_cast<ssize_t>(oversized.size()));
+  ASSERT_EQ(send(sockets_.peer(), kData.data(), kData.size(), 0),
+            static_cast<ssize_t>(kData.size()));
+
+  auto result = Read();
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result->size(), kData.size());
+}
+
+TEST_F(EpollDatagramSocketChannelTest, WritesChunksAsOneDatagram) {
+  MultiBuf data = write_allocator_.BufWith({kData[0], kData[1]});
+  data.PushSuffix(write_allocator_.BufWith({kData[2], kData[3], kData[4]}));
+  ASSERT_EQ(Write(std::move(data)), OkStatus());
+
+  std::array<std::byte, kMaxDatagramSize> out;
+  ASSERT_EQ(recv(sockets_.peer(), out.data(), out.size(), 0),
+            static_cast<ssize_t>(kData.size()));
+}
+
+}  // namespace
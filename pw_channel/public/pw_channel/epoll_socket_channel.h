@@ -0,0 +1,140 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+
+#include "pw_async2/epoll_dispatcher.h"
+#include "pw_async2/poll.h"
+#include "pw_channel/channel.h"
+#include "pw_multibuf/allocator.h"
+#include "pw_multibuf/multibuf.h"
+#include "pw_multibuf/v1/allocator_async.h"
+#include "pw_status/status.h"
+
+namespace pw::channel {
+
+/// @module{pw_channel}
+
+/// @defgroup pw_channel_epoll_socket Epoll socket
+/// @{
+
+/// A channel over a nonblocking socket, driven by an `EpollDispatcher`.
+///
+/// Unlike `StreamChannel`, this channel needs no threads of its own. The
+/// socket is registered with the dispatcher, and reads and writes are
+/// performed directly by the task that polls the channel, which is woken by
+/// the dispatcher when the socket becomes readable or writable.
+///
+/// Reads receive straight into buffers allocated from `read_allocator`, and
+/// writes send the chunks of the staged `MultiBuf` with a single vectored
+/// write, so no data is copied between the socket and the `MultiBuf`s.
+///
+/// The channel takes ownership of the socket, and closes it when the channel
+/// is closed or destroyed. The socket is put into nonblocking mode. The
+/// channel must be used only by tasks run by `dispatcher`.
+template <DataType kType>
+class EpollSocketChannel;
+
+/// Alias for a channel over a byte stream socket, such as a TCP socket or a
+/// `SOCK_STREAM` Unix domain socket.
+using EpollByteSocketChannel = EpollSocketChannel<DataType::kByte>;
+
+/// Alias for a channel over a datagram socket, such as a UDP socket or a
+/// `SOCK_DGRAM` Unix domain socket.
+using EpollDatagramSocketChannel = EpollSocketChannel<DataType::kDatagram>;
+
+/// @}
+
+template <DataType kType>
+class EpollSocketChannel final
+    : public Implement<std::conditional_t<kType == DataType::kByte,
+                                          ReliableByteReaderWriter,
+                                          DatagramReaderWriter>> {
+ public:
+  /// Size of the buffers that bytes are read into, unless specified.
+  static constexpr size_t kDefaultReadSize = 1024;
+
+  /// Maximum number of chunks in a staged `MultiBuf` that are sent by a single
+  /// vectored write. Byte channels send longer `MultiBuf`s in several writes.
+  /// Datagrams with more chunks are rejected.
+  static constexpr size_t kMaxWriteChunks = 16;
+
+  /// Creates a channel over a connected socket.
+  ///
+  /// @param dispatcher       Dispatcher that runs the tasks using the channel.
+  /// @param fd               Socket to read from and write to.
+  /// @param read_allocator   Allocator for the buffers that data is read into.
+  /// @param write_allocator  Allocator for write buffers.
+  /// @param read_size        Size of the buffers that data is read into. For
+  ///                         datagram sockets, this is the largest datagram
+  ///                         that can be received; longer datagrams are
+  ///                         dropped.
+  EpollSocketChannel(async2::EpollDispatcher& dispatcher,
+                     int fd,
+                     multibuf::MultiBufAllocator& read_allocator,
+                     multibuf::MultiBufAllocator& write_allocator,
+                     size_t read_size = kDefaultReadSize);
+
+  EpollSocketChannel(const EpollSocketChannel&) = delete;
+  EpollSocketChannel& operator=(const EpollSocketChannel&) = delete;
+  EpollSocketChannel(EpollSocketChannel&&) = delete;
+  EpollSocketChannel& operator=(EpollSocketChannel&&) = delete;
+
+  ~EpollSocketChannel() override { Close(); }
+
+ private:
+  static constexpr int kInvalidFd = -1;
+
+  async2::PollResult<multibuf::MultiBuf> DoPendRead(
+      async2::Context& cx) override;
+
+  async2::Poll<Status> DoPendReadyToWrite(async2::Context& cx) override;
+
+  async2::PollOptional<multibuf::MultiBuf> DoPendAllocateWriteBuffer(
+      async2::Context& cx, size_t min_bytes) override {
+    write_allocation_future_.SetDesiredSize(min_bytes);
+    return write_allocation_future_.Pend(cx);
+  }
+
+  Status DoStageWrite(multibuf::MultiBuf&& data) override;
+
+  async2::Poll<Status> DoPendWrite(async2::Context& cx) override {
+    return FlushWrites(cx);
+  }
+
+  async2::Poll<Status> DoPendClose(async2::Context& cx) override;
+
+  /// Sends staged data until it has all been sent or the socket is full.
+  async2::Poll<Status> FlushWrites(async2::Context& cx);
+
+  /// Unregisters and closes the socket.
+  void Close();
+
+  async2::EpollDispatcher& dispatcher_;
+  int fd_;
+  const size_t read_size_;
+  multibuf::v1::MultiBufAllocationFuture read_allocation_future_;
+  multibuf::v1::MultiBufAllocationFuture write_allocation_future_;
+
+  // Buffer allocated for the next read, kept while waiting for data.
+  std::optional<multibuf::MultiBuf> read_buffer_;
+
+  // Data staged but not yet sent.
+  std::optional<multibuf::MultiBuf> pending_write_;
+};
+
+}  // namespace pw::channel
@@ -0,0 +1,198 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/internal/per_thread_queues.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::containers::internal {
+namespace {
+
+constexpr size_t kCapacity = 4;
+using Queues = PerThreadQueues<uint32_t, 3, kCapacity>;
+using Queue = Queues::Queue;
+
+bool Push(Queue& queue, uint32_t value) {
+  uint32_t* slot = queue.NextSlot();
+  if (slot == nullptr) {
+    return false;
+  }
+  *slot = value;
+  queue.Push();
+  return true;
+}
+
+constexpr auto kIsLess = [](uint32_t a, uint32_t b) { return a < b; };
+
+// Drains `queues`, returning the values in the order they were passed to the
+// handler.
+template <size_t kMaxItems>
+size_t DrainValues(Queues& queues, std::array<uint32_t, kMaxItems>& values) {
+  size_t count = 0;
+  queues.Drain(kIsLess, [&](uint32_t value) {
+    if (count < values.size()) {
+      values[count] = value;
+    }
+    ++count;
+    return true;
+  });
+  return count;
+}
+
+TEST(PerThreadQueue, PushAndPopInOrder) {
+  Queue queue;
+  ASSERT_TRUE(queue.TryClaim());
+  EXPECT_FALSE(queue.TryClaim());
+
+  // Nothing is visible until the item is pushed.
+  uint32_t* slot = queue.NextSlot();
+  ASSERT_NE(slot, nullptr);
+  *slot = 1;
+  EXPECT_EQ(queue.PeekFront(), nullptr);
+  queue.Push();
+  ASSERT_TRUE(Push(queue, 2));
+  EXPECT_EQ(queue.size(), 2u);
+
+  ASSERT_NE(queue.PeekFront(), nullptr);
+  EXPECT_EQ(*queue.PeekFront(), 1u);
+  queue.PopFront();
+  ASSERT_NE(queue.PeekFront(), nullptr);
+  EXPECT_EQ(*queue.PeekFront(), 2u);
+  queue.PopFront();
+  EXPECT_EQ(queue.PeekFront(), nullptr);
+}
+
+TEST(PerThreadQueue, FullQueueHasNoSlot) {
+  Queue queue;
+  for (uint32_t i = 0; i < kCapacity; ++i) {
+    EXPECT_TRUE(Push(queue, i));
+  }
+  EXPECT_EQ(queue.NextSlot(), nullptr);
+
+  // Space is freed as items are popped, including across the wrap.
+  queue.PopFront();
+  EXPECT_TRUE(Push(queue, 100));
+  EXPECT_EQ(queue.size(), kCapacity);
+}
+
+TEST(PerThreadQueues, DrainsInOrder) {
+  Queues queues;
+  Queue* first = queues.Claim();
+  Queue* second = queues.Claim();
+  Queue* third = queues.Claim();
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  ASSERT_NE(third, nullptr);
+  EXPECT_EQ(queues.Claim(), nullptr);
+
+  ASSERT_TRUE(Push(*first, 1));
+  ASSERT_TRUE(Push(*first, 4));
+  ASSERT_TRUE(Push(*second, 2));
+  ASSERT_TRUE(Push(*second, 5));
+  ASSERT_TRUE(Push(*third, 3));
+  ASSERT_TRUE(Push(*third, 6));
+
+  std::array<uint32_t, 6> values{};
+  ASSERT_EQ(DrainValues(queues, values), 6u);
+  constexpr std::array<uint32_t, 6> kExpected = {1, 2, 3, 4, 5, 6};
+  EXPECT_EQ(values, kExpected);
+  EXPECT_EQ(DrainValues(queues, values), 0u);
+}
+
+TEST(PerThreadQueues, DrainsUpToMaxItems) {
+  Queues queues;
+  Queue* queue = queues.Claim();
+  ASSERT_NE(queue, nullptr);
+  ASSERT_TRUE(Push(*queue, 1));
+  ASSERT_TRUE(Push(*queue, 2));
+  ASSERT_TRUE(Push(*queue, 3));
+
+  EXPECT_EQ(queues.Drain(kIsLess, [](uint32_t) { return true; }, 2), 2u);
+  EXPECT_EQ(queue->size(), 1u);
+}
+
+TEST(PerThreadQueues, HandlerStopsDrain) {
+  Queues queues;
+  Queue* first = queues.Claim();
+  Queue* second = queues.Claim();
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  ASSERT_TRUE(Push(*first, 1));
+  ASSERT_TRUE(Push(*first, 3));
+  ASSERT_TRUE(Push(*second, 4));
+
+  // Stop before 3, which is left in its queue.
+  EXPECT_EQ(queues.Drain(kIsLess, [](uint32_t value) { return value < 3; }),
+            1u);
+  ASSERT_NE(first->PeekFront(), nullptr);
+  EXPECT_EQ(*first->PeekFront(), 3u);
+  EXPECT_EQ(second->size(), 1u);
+}
+
+TEST(PerThreadQueues, ReusesReleasedQueueAfterDrain) {
+  Queues queues;
+  Queue* first = queues.Claim();
+  ASSERT_NE(queues.Claim(), nullptr);
+  ASSERT_NE(queues.Claim(), nullptr);
+  ASSERT_NE(first, nullptr);
+
+  ASSERT_TRUE(Push(*first, 1));
+  first->Release();
+  // The released queue still has an item, so it is not reused yet.
+  EXPECT_EQ(queues.Claim(), nullptr);
+
+  std::array<uint32_t, 1> values{};
+  ASSERT_EQ(DrainValues(queues, values), 1u);
+  EXPECT_EQ(values[0], 1u);
+  EXPECT_EQ(queues.Claim(), first);
+}
+
+TEST(PerThreadQueues, ClearDiscardsItems) {
+  Queues queues;
+  Queue* queue = queues.Claim();
+  ASSERT_NE(queue, nullptr);
+  ASSERT_TRUE(Push(*queue, 1));
+  ASSERT_TRUE(Push(*queue, 2));
+  queues.Clear();
+  EXPECT_EQ(queue->PeekFront(), nullptr);
+}
+
+TEST(PerThreadQueues, CurrentThreadQueueIsClaimedOnce) {
+  {
+    Queues queues;
+    Queue* queue = queues.CurrentThreadQueue();
+    ASSERT_NE(queue, nullptr);
+    EXPECT_EQ(queues.CurrentThreadQueue(), queue);
+    ASSERT_NE(queues.Claim(), nullptr);
+    ASSERT_NE(queues.Claim(), nullptr);
+    EXPECT_EQ(queues.Claim(), nullptr);
+  }
+
+  // The thread claims a queue from a new set, rather than using its queue
+  // from the destroyed set.
+  Queues queues;
+  Queue* queue = queues.CurrentThreadQueue();
+  ASSERT_NE(queue, nullptr);
+  EXPECT_EQ(queues.CurrentThreadQueue(), queue);
+  EXPECT_NE(queues.Claim(), nullptr);
+  EXPECT_NE(queues.Claim(), nullptr);
+  EXPECT_EQ(queues.Claim(), nullptr);
+}
+
+}  // namespace
+}  // namespace pw::containers::internal
@@ -0,0 +1,235 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_assert/assert.h"
+
+namespace pw::containers::internal {
+
+// Lock-free ring buffer of items, which is written by a single producer thread
+// and read by a single consumer. Items are written in place: the producer
+// fills the slot returned by `NextSlot` and then publishes it with `Push`.
+//
+// Queues are owned by a thread through `TryClaim` and `Release`, so that the
+// queue of a thread that exits can be reused once it has been drained.
+template <typename T, size_t kCapacity>
+class PerThreadQueue {
+ public:
+  static_assert(kCapacity > 0);
+
+  constexpr PerThreadQueue() = default;
+
+  PerThreadQueue(const PerThreadQueue&) = delete;
+  PerThreadQueue& operator=(const PerThreadQueue&) = delete;
+
+  // Producer API
+
+  // Takes ownership of an unused queue. Returns false if the queue is owned,
+  // or was released but still has items to drain.
+  bool TryClaim() {
+    State expected = State::kFree;
+    return state_.compare_exchange_strong(
+        expected, State::kOwned, std::memory_order_acquire);
+  }
+
+  // Gives up ownership. The queue is reused after its items are drained.
+  void Release() { state_.store(State::kReleased, std::memory_order_release); }
+
+  // Returns the slot for the next item, or nullptr if the queue is full. The
+  // item is not visible to the consumer until `Push` is called.
+  T* NextSlot() {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == kCapacity) {
+      return nullptr;
+    }
+    return &items_[head % kCapacity];
+  }
+
+  // Publishes the item written to the slot from `NextSlot`.
+  void Push() {
+    head_.store(head_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+  // Number of items in the queue. Exact when called by the producer or
+  // consumer while the other is idle; otherwise a snapshot.
+  size_t size() const {
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_acquire);
+  }
+
+  // Consumer API
+
+  // Returns the oldest item, or nullptr if the queue is empty.
+  const T* PeekFront() const {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (head_.load(std::memory_order_acquire) == tail) {
+      return nullptr;
+    }
+    return &items_[tail % kCapacity];
+  }
+
+  // Removes the oldest item. The queue must not be empty.
+  void PopFront() {
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+  // Makes a released queue available to `TryClaim` if it is empty.
+  void RecycleIfDrained() {
+    if (state_.load(std::memory_order_acquire) == State::kReleased &&
+        PeekFront() == nullptr) {
+      state_.store(State::kFree, std::memory_order_release);
+    }
+  }
+
+ private:
+  enum class State : uint8_t { kFree, kOwned, kReleased };
+
+  std::atomic<State> state_ = State::kFree;
+
+  // Monotonic counts of pushed and popped items; items_[count % kCapacity].
+  std::atomic<size_t> head_ = 0;  // Written only by the producer.
+  std::atomic<size_t> tail_ = 0;  // Written only by the consumer.
+  std::array<T, kCapacity> items_{};
+};
+
+// A fixed set of `PerThreadQueue`s, one per producer thread, and a merging
+// reader which drains them in order.
+//
+// Each thread finds its queue through a `thread_local`, which is shared by
+// every set of the same type. Only one set of each type may exist at a time,
+// which the constructor asserts. Threads must stop using a set before it is
+// destroyed.
+template <typename T, size_t kMaxThreads, size_t kCapacity>
+class PerThreadQueues {
+ public:
+  using Queue = PerThreadQueue<T, kCapacity>;
+
+  PerThreadQueues()
+      : generation_(next_generation_.fetch_add(1, std::memory_order_relaxed) +
+                    1) {
+    uint32_t none = 0;
+    PW_ASSERT(live_generation_.compare_exchange_strong(
+        none, generation_, std::memory_order_acq_rel));
+  }
+
+  ~PerThreadQueues() { live_generation_.store(0, std::memory_order_release); }
+
+  PerThreadQueues(const PerThreadQueues&) = delete;
+  PerThreadQueues& operator=(const PerThreadQueues&) = delete;
+
+  // Returns the calling thread's queue, claiming one on the thread's first
+  // call, or nullptr if every queue is in use. The queue is released when the
+  // thread exits. Lock-free.
+  Queue* CurrentThreadQueue() {
+    ThreadOwner& owner = CurrentThreadOwner();
+    if (owner.generation != generation_ || owner.queue == nullptr) {
+      owner.queue = Claim();
+      owner.generation = generation_;
+    }
+    return owner.queue;
+  }
+
+  // Claims an unused queue, or returns nullptr if every queue is in use. The
+  // caller must release it. Lock-free.
+  Queue* Claim() {
+    for (Queue& queue : queues_) {
+      if (queue.TryClaim()) {
+        return &queue;
+      }
+    }
+    return nullptr;
+  }
+
+  // Removes up to `max_items` items from the queues, passing each to `handler`
+  // in the order given by `is_before(const T&, const T&)`. Each queue must
+  // already be in that order. `handler(const T&)` returns false to leave the
+  // item in its queue and stop draining.
+  //
+  // Items pushed while draining are merged with the rest; `max_items` bounds
+  // the time spent draining threads that keep pushing. Only one thread may
+  // drain at a time. Returns the number of items removed.
+  template <typename IsBefore, typename Handler>
+  size_t Drain(IsBefore&& is_before,
+               Handler&& handler,
+               size_t max_items = kMaxThreads * kCapacity) {
+    size_t count = 0;
+    for (; count < max_items; ++count) {
+      Queue* oldest_queue = nullptr;
+      const T* oldest = nullptr;
+      for (Queue& queue : queues_) {
+        const T* item = queue.PeekFront();
+        if (item != nullptr &&
+            (oldest == nullptr || is_before(*item, *oldest))) {
+          oldest_queue = &queue;
+          oldest = item;
+        }
+      }
+      if (oldest == nullptr || !handler(*oldest)) {
+        break;
+      }
+      oldest_queue->PopFront();
+    }
+    for (Queue& queue : queues_) {
+      queue.RecycleIfDrained();
+    }
+    return count;
+  }
+
+  // Discards all items. Only one thread may drain at a time.
+  void Clear() {
+    for (Queue& queue : queues_) {
+      while (queue.PeekFront() != nullptr) {
+        queue.PopFront();
+      }
+      queue.RecycleIfDrained();
+    }
+  }
+
+ private:
+  // Holds the calling thread's queue, and releases it when the thread exits
+  // unless the set it came from was destroyed.
+  struct ThreadOwner {
+    ~ThreadOwner() {
+      if (queue != nullptr &&
+          generation == live_generation_.load(std::memory_order_acquire)) {
+        queue->Release();
+      }
+    }
+
+    Queue* queue = nullptr;
+    uint32_t generation = 0;
+  };
+
+  static ThreadOwner& CurrentThreadOwner() {
+    thread_local ThreadOwner owner;
+    return owner;
+  }
+
+  // Identifies each set, so a thread does not use a queue from a destroyed
+  // set of the same type. 0 means no set.
+  inline static std::atomic<uint32_t> next_generation_ = 0;
+  inline static std::atomic<uint32_t> live_generation_ = 0;
+
+  const uint32_t generation_;
+  std::array<Queue, kMaxThreads> queues_;
+};
+
+}  // namespace pw::containers::internal
@@ -88,6 +88,29 @@ constexpr std::string_view kExpectedConnectionPrefaceLiteral(
 
 static_assert(kMaxMethodNameSize == kHpackMaxStringSize);
 
+// grpc Response-Headers, which are the same for every response.
+// See: https://github.com/grpc/grpc/blob/v1.60.x/doc/PROTOCOL-HTTP2.md.
+constexpr std::array<HpackField, 2> kResponseHeaders = {{
+    {":status", "200"},
+    {"content-type", "application/grpc"},
+}};
+
+// grpc Trailers, indexed by pw::Status::Code, which happens to be identical to
+// grpc's status code.
+constexpr std::array<std::string_view, 17> kGrpcStatusValues = {
+    "0",  "1",  "2",  "3",  "4",  "5",  "6",  "7",  "8",
+    "9",  "10", "11", "12", "13", "14", "15", "16",
+};
+
+HpackField ResponseTrailer(Status response_code) {
+  PW_CHECK_UINT_LT(response_code.code(), kGrpcStatusValues.size());
+  return {"grpc-status", kGrpcStatusValues[response_code.code()]};
+}
+
+// Largest header block sent by SendHeaders: dynamic table size updates, the
+// Response-Headers and the Trailers.
+constexpr size_t kMaxResponseHeaderBlockSize = 64;
+
 constexpr size_t kLengthPrefixedMessageHdrSize = 5;
 
 enum {
@@ -386,18 +409,32 @@ Status Connection::SharedState::SendData(StreamId stream_id,
 
 // RFC 9113 §6.2
 Status Connection::SharedState::SendHeaders(StreamId stream_id,
-                                            ConstByteSpan payload1,
-                                            ConstByteSpan payload2,
+                                            span<const HpackField> fields,
                                             bool end_stream) {
-  PW_LOG_DEBUG("Conn.Send HEADERS with id=%" PRIu32 " len1=%" PRIu32
-               " len2=%" PRIu32 " end=%d",
+  // Allocate the frame before encoding the block. Encoding updates the
+  // dynamic table, so once a block is encoded it must be sent.
+  UniquePtr<std::byte[]> buffer = send_allocator_.MakeUnique<std::byte[]>(
+      sizeof(WireFrameHeader) + kMaxResponseHeaderBlockSize);
+  if (buffer == nullptr) {
+    return Status::ResourceExhausted();
+  }
+
+  ByteBuilder payload(ByteSpan(buffer.get() + sizeof(WireFrameHeader),
+                               kMaxResponseHeaderBlockSize));
+  if (const auto status = hpack_encoder_.Encode(fields, payload);
+      !status.ok()) {
+    // The client's dynamic table no longer matches ours.
+    PW_LOG_ERROR("Failed to encode HEADERS for id=%" PRIu32, stream_id);
+    Close();
+    return status;
+  }
+
+  PW_LOG_DEBUG("Conn.Send HEADERS with id=%" PRIu32 " len=%" PRIu32 " end=%d",
                stream_id,
-               static_cast<uint32_t>(payload1.size()),
-               static_cast<uint32_t>(payload2.size()),
+               static_cast<uint32_t>(payload.size()),
                end_stream);
   WireFrameHeader frame(FrameHeader{
-      .payload_length =
-          static_cast<uint32_t>(payload1.size() + payload2.size()),
+      .payload_length = static_cast<uint32_t>(payload.size()),
       .type = FrameType::HEADERS,
       .flags = FLAGS_END_HEADERS,
       .stream_id = stream_id,
@@ -408,28 +445,12 @@ Status Connection::SharedState::SendHeaders(StreamId stream_id,
   }
 
   ConstByteSpan frame_span = ObjectAsBytes(frame);
-
-  UniquePtr<std::byte[]> buffer = send_allocator_.MakeUnique<std::byte[]>(
-      frame_span.size() + payload1.size() + payload2.size());
-
-  if (buffer == nullptr) {
-    return Status::ResourceExhausted();
-  }
-
-  size_t offset = 0;
   std::memcpy(buffer.get(), frame_span.data(), frame_span.size());
-  offset += frame_span.size();
-
-  if (!payload1.empty()) {
-    std::memcpy(buffer.get() + offset, payload1.data(), payload1.size());
-    offset += payload1.size();
-  }
-  if (!payload2.empty()) {
-    std::memcpy(buffer.get() + offset, payload2.data(), payload2.size());
-    offset += payload2.size();
-  }
 
-  send_queue_.QueueSend(std::move(buffer));
+  // Send only the encoded part of the buffer.
+  const size_t frame_size = frame_span.size() + payload.size();
+  send_queue_.QueueSend(
+      UniquePtr<std::byte[]>(buffer.Release(), frame_size, send_allocator_));
   return OkStatus();
 }
 
@@ -543,8 +564,10 @@ Status Connection::Writer::SendResponseMessage(StreamId stream_id,
 
     const size_t message_size = message.size();
     if (static_cast<int32_t>(message_size) <= stream->send_window &&
-        static_cast<int32_t>(message_size) <= state->connection_send_window()) {
+        static_cast<int32_t>(message_size) <= state->connection_send_window() &&
+        state->IsNextForConnectionWindow(*stream)) {
       // Enough window!
+      state->FinishWaitForWindow(*stream);
       PW_TRY_ASSIGN(DataFrame data_frame,
                     DataFrame::Create(state->send_allocator(), message.size()));
 
@@ -578,7 +601,7 @@ Status Connection::Writer::SendResponseMessage(StreamId stream_id,
                  stream_id,
                  stream->send_window,
                  state->connection_send_window());
-    stream->is_waiting_for_window = true;
+    state->WaitForWindow(*stream, message_size);
 
     connection_.UnlockState(std::move(state));
     stream->window_notification.acquire();
@@ -590,11 +613,60 @@ Status Connection::Writer::SendResponseMessage(StreamId stream_id,
     }
     stream = state->LookupStream(stream_id);
     if (!stream) {
+      // The reset stream may have been next for the connection window.
+      state->SignalWindowWaiters();
       return Status::Unavailable();
     }
   }
 }
 
+bool Connection::SharedState::IsNextForConnectionWindow(
+    const Stream& stream) const {
+  for (const Stream& other : streams_) {
+    if (&other == &stream || other.id == 0 ||
+        !other.window_ticket.has_value()) {
+      continue;
+    }
+    // A stream that is waiting for its own window does not hold up others.
+    if (static_cast<int32_t>(other.waiting_message_size) > other.send_window) {
+      continue;
+    }
+    // Tickets wrap, so compare their distance.
+    if (!stream.window_ticket.has_value() ||
+        static_cast<int32_t>(*other.window_ticket - *stream.window_ticket) <
+            0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Connection::SharedState::WaitForWindow(Stream& stream,
+                                            size_t message_size) {
+  if (!stream.window_ticket.has_value()) {
+    stream.window_ticket = next_window_ticket_++;
+  }
+  stream.waiting_message_size = static_cast<uint32_t>(message_size);
+  stream.is_waiting_for_window = true;
+}
+
+void Connection::SharedState::FinishWaitForWindow(Stream& stream) {
+  if (!stream.window_ticket.has_value()) {
+    return;
+  }
+  stream.window_ticket.reset();
+  stream.waiting_message_size = 0;
+  SignalWindowWaiters();
+}
+
+void Connection::SharedState::SignalWindowWaiters() {
+  for (Stream& stream : streams_) {
+    if (stream.id != 0 && stream.window_ticket.has_value()) {
+      stream.SignalWindowAvailable();
+    }
+  }
+}
+
 Status Connection::SharedState::QueueStreamResponse(StreamId id,
                                                     DataFrame&& data_frame) {
   auto stream = LookupStream(id);
@@ -614,11 +686,8 @@ Status Connection::SharedState::SendQueuedDataFrame(Connection::Stream& stream,
 
   auto status = OkStatus();
   if (!stream.started_response) {
-    stream.started_response = true;
-    status = SendHeaders(stream.id,
-                         ResponseHeadersPayload(),
-                         ConstByteSpan(),
-                         /*end_stream=*/false);
+    status = SendHeaders(stream.id, kResponseHeaders, /*end_stream=*/false);
+    stream.started_response = status.ok();
   }
 
   if (status.ok()) {
@@ -656,25 +725,27 @@ Status Connection::Writer::SendResponseComplete(StreamId stream_id,
     PW_LOG_DEBUG("Conn.SendResponseWithTrailers id=%" PRIu32 " code=%d",
                  stream_id,
                  response_code.code());
-    status = state->SendHeaders(stream_id,
-                                ResponseHeadersPayload(),
-                                ResponseTrailersPayload(response_code),
-                                /*end_stream=*/true);
+    const std::array<HpackField, 3> fields = {
+        kResponseHeaders[0],
+        kResponseHeaders[1],
+        ResponseTrailer(response_code),
+    };
+    status = state->SendHeaders(stream_id, fields, /*end_stream=*/true);
   } else {
     PW_LOG_DEBUG("Conn.SendTrailers id=%" PRIu32 " code=%d",
                  stream_id,
                  response_code.code());
-    status = state->SendHeaders(stream_id,
-                                ConstByteSpan(),
-                                ResponseTrailersPayload(response_code),
-                                /*end_stream=*/true);
+    const HpackField trailer = ResponseTrailer(response_code);
+    status = state->SendHeaders(
+        stream_id, span(&trailer, 1), /*end_stream=*/true);
   }
 
   if (!status.ok()) {
     PW_LOG_WARN("Failed sending response complete on id=%" PRIu32 " error=%d",
                 stream_id,
                 status.code());
-    return Status::Unavailable();
+    // The stream stays open if no send buffer was available.
+    return status.IsResourceExhausted() ? status : Status::Unavailable();
   }
 
   PW_LOG_DEBUG("Conn.CloseStream id=%" PRIu32, stream_id);
@@ -746,7 +817,7 @@ Status Connection::Reader::ProcessConnectionPreface() {
           {
               {
                   .id = ToNetworkOrder(SETTINGS_HEADER_TABLE_SIZE),
-                  .value = ToNetworkOrder(kHpackDynamicHeaderTableSize),
+                  .value = ToNetworkOrder(internal::kHpackDecoderTableSize),
               },
               {
                   .id = ToNetworkOrder(SETTINGS_MAX_CONCURRENT_STREAMS),
@@ -1064,43 +1135,78 @@ Status Connection::Reader::ProcessHeadersFrame(const FrameHeader& frame) {
 
   last_stream_id_ = frame.stream_id;
 
+  if ((frame.flags & FLAGS_END_HEADERS) == 0) {
+    PW_LOG_ERROR("Client sent HEADERS frame without END_HEADERS: unsupported");
+    SendGoAway(Http2Error::INTERNAL_ERROR);
+    return Status::Internal();
+  }
+
+  // The header block is decoded even if the frame is rejected, since it may
+  // update the dynamic table.
+  Result<InlineString<kMaxMethodNameSize>> method_name = Status::NotFound();
+  PW_TRY(ReadHeaderBlock(frame, method_name));
+
   {
     auto state = connection_.LockState();
     if (Stream* stream = state->LookupStream(frame.stream_id);
         stream != nullptr) {
       PW_LOG_DEBUG("Client sent HEADERS after the first stream message");
-      // Unlock since ProcessIgnoredFrame will try and read all the ignored
-      // data, and also may try and take the lock in the error case.
-      connection_.UnlockState(std::move(state));
-      PW_TRY(ProcessIgnoredFrame(frame));
-      state = connection_.LockState();
-      stream = state->LookupStream(frame.stream_id);
-      if (stream) {
-        // grpc requests cannot contain trailers.
-        // See:
-        // https://github.com/grpc/grpc/blob/v1.60.x/doc/PROTOCOL-HTTP2.md.
-        PW_TRY(
-            SendRstStreamAndClose(state, stream, Http2Error::PROTOCOL_ERROR));
-      }
+      // grpc requests cannot contain trailers.
+      // See:
+      // https://github.com/grpc/grpc/blob/v1.60.x/doc/PROTOCOL-HTTP2.md.
+      PW_TRY(SendRstStreamAndClose(state, stream, Http2Error::PROTOCOL_ERROR));
       return OkStatus();
     }
   }
 
   if ((frame.flags & FLAGS_END_STREAM) != 0) {
     PW_LOG_DEBUG("Client sent HEADERS with END_STREAM");
-    PW_TRY(ProcessIgnoredFrame(frame));
     // grpc requests must send END_STREAM in an empty DATA frame.
     // See: https://github.com/grpc/grpc/blob/v1.60.x/doc/PROTOCOL-HTTP2.md.
     auto state = connection_.LockState();
     PW_TRY(state->SendRstStream(frame.stream_id, Http2Error::PROTOCOL_ERROR));
     return OkStatus();
   }
-  if ((frame.flags & FLAGS_END_HEADERS) == 0) {
-    PW_LOG_ERROR("Client sent HEADERS frame without END_HEADERS: unsupported");
-    SendGoAway(Http2Error::INTERNAL_ERROR);
-    return Status::Internal();
+
+  if (!method_name.ok()) {
+    // RFC 9113 §8.1.1: "Malformed requests or responses that are detected MUST
+    // be treated as a stream error of type PROTOCOL_ERROR."
+    PW_LOG_WARN("Client sent HEADERS without a valid :path on id=%" PRIu32
+                " error=%d",
+                frame.stream_id,
+                method_name.status().code());
+    auto state = connection_.LockState();
+    return state->SendRstStream(frame.stream_id, Http2Error::PROTOCOL_ERROR);
   }
 
+  {
+    auto state = connection_.LockState();
+    if (!state->CreateStream(frame.stream_id, initial_send_window_).ok()) {
+      PW_LOG_WARN("Too many streams, rejecting id=%" PRIu32, frame.stream_id);
+      return state->SendRstStream(frame.stream_id, Http2Error::REFUSED_STREAM);
+    }
+  }
+
+  if (const auto status = callbacks_.OnNew(frame.stream_id, *method_name);
+      !status.ok()) {
+    if (status.IsNotFound()) {
+      return connection_.writer_.SendResponseComplete(
+          frame.stream_id, pw::Status::Unimplemented());
+    }
+    auto state = connection_.LockState();
+    if (Stream* stream = state->LookupStream(frame.stream_id);
+        stream != nullptr) {
+      return SendRstStreamAndClose(state, stream, Http2Error::INTERNAL_ERROR);
+    }
+  }
+
+  return OkStatus();
+}
+
+// RFC 9113 §4.3 and §6.2
+Status Connection::Reader::ReadHeaderBlock(
+    const FrameHeader& frame,
+    Result<InlineString<kMaxMethodNameSize>>& method_name) {
   PW_TRY_ASSIGN(auto payload, ReadFramePayload(frame));
 
   // Drop padding.
@@ -1135,28 +1241,13 @@ Status Connection::Reader::ProcessHeadersFrame(const FrameHeader& frame) {
     payload = payload.subspan(5);
   }
 
-  PW_TRY_ASSIGN(auto method_name, HpackParseRequestHeaders(payload));
-  {
-    auto state = connection_.LockState();
-    if (!state->CreateStream(frame.stream_id, initial_send_window_).ok()) {
-      PW_LOG_WARN("Too many streams, rejecting id=%" PRIu32, frame.stream_id);
-      return state->SendRstStream(frame.stream_id, Http2Error::REFUSED_STREAM);
-    }
-  }
-
-  if (const auto status = callbacks_.OnNew(frame.stream_id, method_name);
-      !status.ok()) {
-    if (status.IsNotFound()) {
-      return connection_.writer_.SendResponseComplete(
-          frame.stream_id, pw::Status::Unimplemented());
-    }
-    auto state = connection_.LockState();
-    if (Stream* stream = state->LookupStream(frame.stream_id);
-        stream != nullptr) {
-      return SendRstStreamAndClose(state, stream, Http2Error::INTERNAL_ERROR);
-    }
+  method_name = hpack_decoder_.ParseRequestHeaders(payload);
+  if (method_name.status().IsInvalidArgument()) {
+    // RFC 9113 §4.3: "A decoding error in a field block MUST be treated as a
+    // connection error of type COMPRESSION_ERROR."
+    SendGoAway(Http2Error::COMPRESSION_ERROR);
+    return Status::Internal();
   }
-
   return OkStatus();
 }
 
@@ -1367,8 +1458,14 @@ Status Connection::Reader::ProcessSettingsFrame(const FrameHeader& frame,
         // We never send frame payloads larger than 16384, so we don't need to
         // track the client's preference.
         break;
+      case SETTINGS_HEADER_TABLE_SIZE: {
+        // RFC 7541 §4.2: The encoder's dynamic table must not exceed this
+        // size. The change is signaled at the start of the next HEADERS.
+        auto state = connection_.LockState();
+        state->SetHeaderTableSize(value);
+        break;
+      }
       // Ignore these.
-      // SETTINGS_HEADER_TABLE_SIZE: our responses don't use the dynamic table
       // SETTINGS_ENABLE_PUSH: we don't support push
       // SETTINGS_MAX_CONCURRENT_STREAMS: we don't support push
       // SETTINGS_MAX_HEADER_LIST_SIZE: we send very tiny response HEADERS
@@ -0,0 +1,240 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_grpc/connection.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "pw_allocator/testing.h"
+#include "pw_bytes/byte_builder.h"
+#include "pw_grpc/internal/hpack.h"
+#include "pw_status/try.h"
+#include "pw_stream/stream.h"
+#include "pw_sync/mutex.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::grpc {
+namespace {
+
+using internal::HpackDecoder;
+
+constexpr size_t kFrameHeaderSize = 9;
+constexpr uint8_t kHeadersType = 0x01;
+constexpr uint8_t kSettingsType = 0x04;
+constexpr uint8_t kEndHeaders = 0x04;
+
+// Forwards to another allocator, but can be made to fail the next allocation.
+class FailingAllocator : public Allocator {
+ public:
+  explicit FailingAllocator(Allocator& allocator) : allocator_(allocator) {}
+
+  void FailNextAllocation() { fail_next_ = true; }
+
+ private:
+  void* DoAllocate(Layout layout) override {
+    if (fail_next_) {
+      fail_next_ = false;
+      return nullptr;
+    }
+    return allocator_.Allocate(layout);
+  }
+
+  void DoDeallocate(void* ptr) override { allocator_.Deallocate(ptr); }
+
+  Allocator& allocator_;
+  bool fail_next_ = false;
+};
+
+// Holds the queued frames, which are checked rather than written.
+class FakeSendQueue : public SendQueue {
+ public:
+  bool QueueSend(UniquePtr<std::byte[]>&& buffer) override {
+    if (num_buffers_ == buffers_.size()) {
+      return false;
+    }
+    buffers_[num_buffers_++] = std::move(buffer);
+    return true;
+  }
+
+  void set_on_error(ErrorHandler&&) override {}
+  void Run() override {}
+  void RequestStop() override {}
+
+  span<const UniquePtr<std::byte[]>> buffers() const {
+    return span(buffers_.data(), num_buffers_);
+  }
+
+ private:
+  std::array<UniquePtr<std::byte[]>, 16> buffers_;
+  size_t num_buffers_ = 0;
+};
+
+// Reads the frames sent by the client.
+class FakeClient : public stream::NonSeekableReader {
+ public:
+  ByteBuilder& frames() { return frames_; }
+  bool done() const { return position_ == frames_.size(); }
+
+ private:
+  StatusWithSize DoRead(ByteSpan destination) override {
+    if (done()) {
+      return StatusWithSize::OutOfRange();
+    }
+    const size_t size =
+        std::min(destination.size(), frames_.size() - position_);
+    std::memcpy(destination.data(), frames_.data() + position_, size);
+    position_ += size;
+    return StatusWithSize(size);
+  }
+
+  ByteBuffer<256> frames_;
+  size_t position_ = 0;
+};
+
+class AcceptAllCallbacks : public Connection::RequestCallbacks {
+ public:
+  void OnNewConnection() override {}
+  Status OnNew(StreamId, InlineString<kMaxMethodNameSize>) override {
+    return OkStatus();
+  }
+  Status OnMessage(StreamId, ByteSpan) override { return OkStatus(); }
+  void OnHalfClose(StreamId) override {}
+  void OnCancel(StreamId) override {}
+};
+
+void AppendFrame(ByteBuilder& out,
+                 uint8_t type,
+                 uint8_t flags,
+                 uint32_t stream_id,
+                 ConstByteSpan payload) {
+  const auto length = static_cast<uint32_t>(payload.size());
+  out.PutUint8(static_cast<uint8_t>(length >> 16));
+  out.PutUint16(static_cast<uint16_t>(length), endian::big);
+  out.PutUint8(type);
+  out.PutUint8(flags);
+  out.PutUint32(stream_id, endian::big);
+  out.append(payload);
+}
+
+// Appends a HEADERS frame that starts an RPC. The :path is a literal field
+// without indexing (RFC 7541 §6.2.2).
+void AppendRequestHeaders(ByteBuilder& out, uint32_t stream_id) {
+  constexpr std::string_view kName = ":path";
+  constexpr std::string_view kPath = "/pw.test.Service/Method";
+  ByteBuffer<64> block;
+  block.PutUint8(0x00);
+  block.PutUint8(static_cast<uint8_t>(kName.size()));
+  block.append(kName.data(), kName.size());
+  block.PutUint8(static_cast<uint8_t>(kPath.size()));
+  block.append(kPath.data(), kPath.size());
+  AppendFrame(out, kHeadersType, kEndHeaders, stream_id, block);
+}
+
+// Connects a client to a connection whose send buffers come from an allocator
+// that can be made to fail. Connection is too large for a test fixture, so
+// tests create this on the stack.
+class ConnectionHarness {
+ public:
+  ConnectionHarness()
+      : failing_allocator_(allocator_),
+        send_allocator_(failing_allocator_),
+        connection_(client_,
+                    send_queue_,
+                    callbacks_,
+                    nullptr,
+                    send_allocator_) {}
+
+  // Sends the connection preface followed by `frames` from the client.
+  Status Receive(ConstByteSpan frames) {
+    constexpr std::string_view kPreface = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+    client_.frames().append(kPreface.data(), kPreface.size());
+    AppendFrame(client_.frames(), kSettingsType, 0, 0, {});
+    client_.frames().append(frames);
+
+    PW_TRY(connection_.ProcessConnectionPreface());
+    while (!client_.done()) {
+      PW_TRY(connection_.ProcessFrame());
+    }
+    return OkStatus();
+  }
+
+  // Decodes each queued HEADERS frame, in order, with one decoder. Returns
+  // the number of frames decoded, or -1 if a frame is malformed.
+  int DecodeResponseHeaders() {
+    HpackDecoder decoder;
+    int count = 0;
+    for (const UniquePtr<std::byte[]>& buffer : send_queue_.buffers()) {
+      ConstByteSpan frame(buffer.get(), buffer.size());
+      if (frame.size() < kFrameHeaderSize ||
+          static_cast<uint8_t>(frame[3]) != kHeadersType) {
+        continue;
+      }
+      const uint32_t length = static_cast<uint32_t>(frame[0]) << 16 |
+                              static_cast<uint32_t>(frame[1]) << 8 |
+                              static_cast<uint32_t>(frame[2]);
+      if (length != frame.size() - kFrameHeaderSize) {
+        return -1;
+      }
+      // Responses have no :path, so a well-formed block is NOT_FOUND.
+      if (!decoder.ParseRequestHeaders(frame.subspan(kFrameHeaderSize))
+               .status()
+               .IsNotFound()) {
+        return -1;
+      }
+      ++count;
+    }
+    return count;
+  }
+
+  FailingAllocator& failing_allocator() { return failing_allocator_; }
+  Connection& connection() { return connection_; }
+
+ private:
+  allocator::test::AllocatorForTest<2048> allocator_;
+  FailingAllocator failing_allocator_;
+  allocator::SynchronizedAllocator<sync::Mutex> send_allocator_;
+  FakeClient client_;
+  FakeSendQueue send_queue_;
+  AcceptAllCallbacks callbacks_;
+  Connection connection_;
+};
+
+TEST(Connection, HeadersAllocationFailureKeepsConnectionOpen) {
+  ConnectionHarness harness;
+  ByteBuffer<128> frames;
+  AppendRequestHeaders(frames, 1);
+  AppendRequestHeaders(frames, 3);
+  ASSERT_EQ(harness.Receive(frames), OkStatus());
+
+  harness.failing_allocator().FailNextAllocation();
+  EXPECT_EQ(harness.connection().SendResponseComplete(1, OkStatus()),
+            Status::ResourceExhausted());
+  EXPECT_EQ(harness.DecodeResponseHeaders(), 0);
+
+  // Both streams are still open, and the blocks sent after the failure decode
+  // with the client's dynamic table.
+  EXPECT_EQ(harness.connection().SendResponseComplete(1, OkStatus()),
+            OkStatus());
+  EXPECT_EQ(harness.connection().SendResponseComplete(3, OkStatus()),
+            OkStatus());
+  EXPECT_EQ(harness.DecodeResponseHeaders(), 2);
+}
+
+}  // namespace
+}  // namespace pw::grpc
@@ -14,9 +14,12 @@
 
 #include "pw_grpc/default_send_queue.h"
 
+#include <array>
 #include <mutex>
 
+#include "pw_bytes/span.h"
 #include "pw_log/log.h"
+#include "pw_status/try.h"
 
 namespace pw::grpc {
 
@@ -30,6 +33,16 @@ UniquePtr<std::byte[]> DefaultSendQueue::PopNext() {
   return buffer;
 }
 
+size_t DefaultSendQueue::PopBatch(span<UniquePtr<std::byte[]>> batch) {
+  std::lock_guard lock(send_mutex_);
+  size_t count = 0;
+  while (count < batch.size() && !queue_.empty()) {
+    batch[count++] = std::move(queue_.front());
+    queue_.pop_front();
+  }
+  return count;
+}
+
 void DefaultSendQueue::NotifyOnError(Status status) {
   std::lock_guard lock(send_mutex_);
   if (on_error_) {
@@ -42,21 +55,41 @@ void DefaultSendQueue::set_on_error(ErrorHandler&& error_handler) {
   on_error_ = std::move(error_handler);
 }
 
+Status DefaultSendQueue::SendEach() {
+  for (UniquePtr<std::byte[]> buffer = PopNext(); buffer != nullptr;
+       buffer = PopNext()) {
+    PW_TRY(socket_.Write(pw::span(buffer.get(), buffer.size())));
+  }
+  return OkStatus();
+}
+
+Status DefaultSendQueue::SendBatches() {
+  std::array<UniquePtr<std::byte[]>, kMaxBatchSize> batch;
+  std::array<ConstByteSpan, kMaxBatchSize> buffers;
+  for (size_t count = PopBatch(batch); count > 0; count = PopBatch(batch)) {
+    for (size_t i = 0; i < count; ++i) {
+      buffers[i] = ConstByteSpan(batch[i].get(), batch[i].size());
+    }
+    const Status status = socket_.WriteV(span(buffers).first(count));
+    for (UniquePtr<std::byte[]>& buffer : span(batch).first(count)) {
+      buffer = nullptr;
+    }
+    PW_TRY(status);
+  }
+  return OkStatus();
+}
+
 void DefaultSendQueue::ProcessSendQueue(async::Context&, Status task_status) {
   if (!task_status.ok()) {
     return;
   }
 
-  UniquePtr<std::byte[]> buffer = PopNext();
-  while (buffer != nullptr) {
-    if (Status status = socket_.Write(pw::span(buffer.get(), buffer.size()));
-        !status.ok()) {
-      PW_LOG_ERROR("Failed to write to socket in DefaultSendQueue: %s",
-                   status.str());
-      NotifyOnError(status);
-      return;
-    }
-    buffer = PopNext();
+  const Status status =
+      write_mode_ == WriteMode::kBatched ? SendBatches() : SendEach();
+  if (!status.ok()) {
+    PW_LOG_ERROR("Failed to write to socket in DefaultSendQueue: %s",
+                 status.str());
+    NotifyOnError(status);
   }
 }
 
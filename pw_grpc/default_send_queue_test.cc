@@ -0,0 +1,231 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_grpc/default_send_queue.h"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+
+#include "pw_allocator/testing.h"
+#include "pw_bytes/byte_builder.h"
+#include "pw_sync/mutex.h"
+#include "pw_sync/thread_notification.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::grpc {
+namespace {
+
+// Records the writes to a socket, and signals when an expected number of
+// bytes has been written.
+class FakeSocket : public stream::NonSeekableReaderWriter {
+ public:
+  void ExpectBytes(size_t size) { expected_size_ = size; }
+  void set_write_status(Status status) { write_status_ = status; }
+
+  void WaitForExpectedBytes() { done_.acquire(); }
+
+  size_t num_writes() const {
+    std::lock_guard lock(mutex_);
+    return num_writes_;
+  }
+
+  // Number of buffers passed to the most recent write.
+  size_t last_write_buffers() const {
+    std::lock_guard lock(mutex_);
+    return last_write_buffers_;
+  }
+
+  ConstByteSpan written() const {
+    std::lock_guard lock(mutex_);
+    return written_;
+  }
+
+ private:
+  StatusWithSize DoRead(ByteSpan) override {
+    return StatusWithSize::Unimplemented();
+  }
+
+  Status DoWrite(ConstByteSpan data) override {
+    return DoWriteV(span(&data, 1));
+  }
+
+  Status DoWriteV(span<const ConstByteSpan> data) override {
+    std::lock_guard lock(mutex_);
+    ++num_writes_;
+    last_write_buffers_ = data.size();
+    if (!write_status_.ok()) {
+      return write_status_;
+    }
+    for (ConstByteSpan buffer : data) {
+      written_.append(buffer);
+    }
+    if (written_.size() == expected_size_) {
+      done_.release();
+    }
+    return OkStatus();
+  }
+
+  mutable sync::Mutex mutex_;
+  size_t num_writes_ = 0;
+  size_t last_write_buffers_ = 0;
+  size_t expected_size_ = 0;
+  Status write_status_;
+  ByteBuffer<256> written_;
+  sync::ThreadNotification done_;
+};
+
+class DefaultSendQueueTest : public ::testing::Test {
+ protected:
+  explicit DefaultSendQueueTest(DefaultSendQueue::WriteMode write_mode)
+      : allocator_(raw_allocator_),
+        send_queue_(socket_, allocator_, write_mode) {}
+
+  void QueueSend(size_t size, std::byte value) {
+    UniquePtr<std::byte[]> buffer = allocator_.MakeUnique<std::byte[]>(size);
+    ASSERT_NE(buffer, nullptr);
+    std::memset(buffer.get(), static_cast<int>(value), size);
+    ASSERT_TRUE(send_queue_.QueueSend(std::move(buffer)));
+  }
+
+  // Runs the send queue on a thread until `size` bytes have been written.
+  void SendBytes(size_t size) {
+    socket_.ExpectBytes(size);
+    thread::test::TestThreadContext context;
+    Thread thread(context.options(), [this] { send_queue_.Run(); });
+    socket_.WaitForExpectedBytes();
+    send_queue_.RequestStop();
+    thread.join();
+  }
+
+  allocator::test::AllocatorForTest<4096> raw_allocator_;
+  allocator::SynchronizedAllocator<sync::Mutex> allocator_;
+  FakeSocket socket_;
+  DefaultSendQueue send_queue_;
+};
+
+class DefaultSendQueueEachTest : public DefaultSendQueueTest {
+ protected:
+  DefaultSendQueueEachTest()
+      : DefaultSendQueueTest(DefaultSendQueue::WriteMode::kEach) {}
+};
+
+class DefaultSendQueueBatchedTest : public DefaultSendQueueTest {
+ protected:
+  DefaultSendQueueBatchedTest()
+      : DefaultSendQueueTest(DefaultSendQueue::WriteMode::kBatched) {}
+};
+
+TEST_F(DefaultSendQueueEachTest, WritesEachBuffer) {
+  QueueSend(3, std::byte{1});
+  QueueSend(4, std::byte{2});
+  SendBytes(7);
+
+  EXPECT_EQ(socket_.num_writes(), 2u);
+  EXPECT_EQ(socket_.last_write_buffers(), 1u);
+  ConstByteSpan written = socket_.written();
+  ASSERT_EQ(written.size(), 7u);
+  EXPECT_EQ(written[2], std::byte{1});
+  EXPECT_EQ(written[3], std::byte{2});
+}
+
+TEST_F(DefaultSendQueueBatchedTest, CoalescesQueuedBuffers) {
+  QueueSend(3, std::byte{1});
+  QueueSend(4, std::byte{2});
+  QueueSend(5, std::byte{3});
+  SendBytes(12);
+
+  EXPECT_EQ(socket_.num_writes(), 1u);
+  EXPECT_EQ(socket_.last_write_buffers(), 3u);
+  constexpr std::array<std::byte, 12> kExpected = {
+      std::byte{1},
+      std::byte{1},
+      std::byte{1},
+      std::byte{2},
+      std::byte{2},
+      std::byte{2},
+      std::byte{2},
+      std::byte{3},
+      std::byte{3},
+      std::byte{3},
+      std::byte{3},
+      std::byte{3},
+  };
+  ConstByteSpan written = socket_.written();
+  ASSERT_EQ(written.size(), kExpected.size());
+  EXPECT_EQ(std::memcmp(written.data(), kExpected.data(), kExpected.size()),
+            0);
+}
+
+TEST_F(DefaultSendQueueBatchedTest, WritesLargeBuffersInTheSameBatch) {
+  constexpr size_t kLargeSize = 200;
+  QueueSend(2, std::byte{1});
+  QueueSend(kLargeSize, std::byte{2});
+  QueueSend(2, std::byte{3});
+  SendBytes(kLargeSize + 4);
+
+  EXPECT_EQ(socket_.num_writes(), 1u);
+  EXPECT_EQ(socket_.last_write_buffers(), 3u);
+  ConstByteSpan written = socket_.written();
+  ASSERT_EQ(written.size(), kLargeSize + 4);
+  EXPECT_EQ(written[1], std::byte{1});
+  EXPECT_EQ(written[2], std::byte{2});
+  EXPECT_EQ(written[kLargeSize + 1], std::byte{2});
+  EXPECT_EQ(written[kLargeSize + 2], std::byte{3});
+}
+
+TEST_F(DefaultSendQueueBatchedTest, WritesMoreThanOneBatch) {
+  constexpr size_t kNumBuffers = 2 * DefaultSendQueue::kMaxBatchSize + 1;
+  for (size_t i = 0; i < kNumBuffers; ++i) {
+    QueueSend(1, static_cast<std::byte>(i));
+  }
+  SendBytes(kNumBuffers);
+
+  // Each batch is one write.
+  EXPECT_EQ(socket_.num_writes(), 3u);
+  EXPECT_EQ(socket_.last_write_buffers(), 1u);
+  ConstByteSpan written = socket_.written();
+  ASSERT_EQ(written.size(), kNumBuffers);
+  for (size_t i = 0; i < kNumBuffers; ++i) {
+    EXPECT_EQ(written[i], static_cast<std::byte>(i));
+  }
+}
+
+TEST_F(DefaultSendQueueBatchedTest, ReportsWriteErrors) {
+  struct {
+    Status status;
+    sync::ThreadNotification reported;
+  } error;
+  send_queue_.set_on_error([&error](Status status) {
+    error.status = status;
+    error.reported.release();
+  });
+  socket_.set_write_status(Status::Unavailable());
+  QueueSend(2, std::byte{1});
+
+  thread::test::TestThreadContext context;
+  Thread thread(context.options(), [this] { send_queue_.Run(); });
+  error.reported.acquire();
+  send_queue_.RequestStop();
+  thread.join();
+
+  EXPECT_EQ(error.status, Status::Unavailable());
+  EXPECT_EQ(socket_.num_writes(), 1u);
+}
+
+}  // namespace
+}  // namespace pw::grpc
@@ -58,8 +58,7 @@ func main() {
 	fmt.Printf("// Decoder table stats:\n")
 	fmt.Printf("//   before optimization = %+v\n", statsBefore)
 	fmt.Printf("//   after  optimization = %+v\n", statsAfter)
-	fmt.Println()
-	printStaticResponses()
+	printEncoderTable()
 }
 
 type NodeType int
@@ -199,157 +198,138 @@ func assignTableIndices(node *Node, idx int) int {
 	return idx
 }
 
+// Number of input bits consumed by each step of the decoder.
+const decoderStepBits = 4
+
 const decoderTablePrefix = `
-// Huffman decoder table. Decoding starts at index=0. For each bit, we inspect
-// kHuffmanDecoderTable[index][bit] and take an action based on that value:
+// Huffman decoder table, which decodes 4 bits at a time. Each state of the
+// decoder is a position in the Huffman code tree, and decoding starts at
+// state=0. For each 4-bit nibble of input, most significant first, we inspect
+// entry=kHuffmanDecoderTable[state][nibble] and take an action based on it:
+//
+//   * If entry.next matches 0b1111_1111, fail: unprintable character, or the
+//     decoder entered an invalid state
+//   * Otherwise, set state = entry.next & 0b0111_1111
+//   * If entry.symbol matches 0b1xxx_xxxx, output byte 32 + xxx_xxxx
 //
-//   * If the value matches 0b0..._...., set index=value
-//   * If the value matches 0b1xxx_xxxx, output byte 32 + xx_xxxx, set index=0
-//   * If the value matches 0b1111_1110, fail: unprintable character
-//   * If the value matches 0b1111_1111, fail: decoder entered an invalid state
+// The input may only end after a nibble whose entry.next matches 0b1xxx_xxxx,
+// which means the bits since the last symbol are valid padding: 7 or fewer
+// 1s. A nibble contains at most one complete symbol, since every printable
+// character has a code of at least 5 bits.
 //
-static constexpr std::array<uint8_t[2], %d> kHuffmanDecoderTable = {{
+struct HuffmanDecoderEntry {
+  uint8_t next;
+  uint8_t symbol;
+};
+static constexpr std::array<std::array<HuffmanDecoderEntry, 16>, %d> kHuffmanDecoderTable = {{
 `
 const decoderTableSuffix = `
 }};
 `
 
+var decoderStates []*Node
+
 func printDecoderTable(stats *Stats) {
+	decoderStates = make([]*Node, stats.numBranchNodes)
+	collectDecoderStates(&rootNode)
+	padding := paddingStates()
+
 	fmt.Printf(decoderTablePrefix, stats.numBranchNodes)
-	printDecoderTableEntries(&rootNode)
+	for _, node := range decoderStates {
+		fmt.Printf("  /*%v=*/ {{", node.tableIndex)
+		for nibble := 0; nibble < 1<<decoderStepBits; nibble++ {
+			if nibble > 0 {
+				fmt.Print(", ")
+			}
+			next, symbol := decoderStep(node, nibble, padding)
+			fmt.Printf("{0x%02x, 0x%02x}", next, symbol)
+		}
+		fmt.Println("}},")
+	}
 	fmt.Print(decoderTableSuffix)
 }
 
-func printDecoderTableEntries(node *Node) {
+func collectDecoderStates(node *Node) {
 	if node.t != BranchNode {
 		return
 	}
-
-	// Print nodes in preorder, which is the same order the indices were created.
-	fmt.Printf("  /*%v=*/ {%v, %v},\n",
-		node.tableIndex,
-		toDecoderTableEntry(node.child[0]),
-		toDecoderTableEntry(node.child[1]))
-
-	printDecoderTableEntries(node.child[0])
-	printDecoderTableEntries(node.child[1])
+	decoderStates[node.tableIndex] = node
+	collectDecoderStates(node.child[0])
+	collectDecoderStates(node.child[1])
 }
 
-func toDecoderTableEntry(node *Node) uint8 {
-	switch node.t {
-	case BranchNode:
-		if node.tableIndex > 127 {
-			panic(fmt.Sprintf("BranchNode index %d > 127", node.tableIndex))
+// Returns the states in which the input may end: the root, and the states
+// reached by 7 or fewer 1s, which are a prefix of the EOS code.
+// See RFC 7541 §5.2.
+func paddingStates() map[*Node]bool {
+	states := map[*Node]bool{&rootNode: true}
+	node := &rootNode
+	for i := 0; i < 7; i++ {
+		node = node.child[1]
+		if node.t != BranchNode {
+			panic("EOS prefix reached a leaf node")
 		}
-		return uint8(node.tableIndex)
-	case OutputNode:
-		return uint8(node.output-32) | 0b1000_0000
-	case UnprintableNode:
-		return 0b1111_1110
-	case EOSNode:
-		// RFC 7541 §5.2: "A Huffman-encoded string literal containing the EOS
-		// symbol MUST be treated as a decoding error."
-		return 0b1111_1111
+		states[node] = true
 	}
-	panic(fmt.Sprintf("unexpected node type %v", node.t))
+	return states
 }
 
-const responseHeaderFieldsPrefix = `
-// HPACK-encoded header fields which form grpc Response-Headers.
-// These are the same for every response.
-static constexpr std::array<uint8_t, %d> kResponseHeaderFields = {
-`
-
-const responseHeaderFieldsSuffix = `
-};
-`
+// Walks the tree from `node` over the bits of `nibble`, and returns the entry
+// for the decoder table.
+func decoderStep(node *Node, nibble int, padding map[*Node]bool) (uint8, uint8) {
+	symbol := uint8(0)
+	for k := decoderStepBits - 1; k >= 0; k-- {
+		child := node.child[(nibble>>k)&1]
+		switch child.t {
+		case BranchNode:
+			node = child
+		case OutputNode:
+			if symbol != 0 {
+				panic("decoder step output more than one symbol")
+			}
+			symbol = uint8(child.output-32) | 0b1000_0000
+			node = &rootNode
+		case UnprintableNode, EOSNode:
+			// RFC 7541 §5.2: "A Huffman-encoded string literal containing the EOS
+			// symbol MUST be treated as a decoding error."
+			return 0b1111_1111, 0
+		}
+	}
+	if node.tableIndex > 127 {
+		panic(fmt.Sprintf("BranchNode index %d > 127", node.tableIndex))
+	}
+	next := uint8(node.tableIndex)
+	if padding[node] {
+		next |= 0b1000_0000
+	}
+	return next, symbol
+}
 
-const maxStatusCode = 16
-const responseTrailerFieldsPrefix = `
-// HPACK-encoded header fields which form grpc Trailers. All response Trailers
-// are identical except for the status code.
-//
-// This is indexed by pw::Status::Code, which happens to be identical to grpc's
-// status code.
-struct ResponseTrailerPayload {
-  uint32_t size;
-  std::array<uint8_t, %d> bytes;
+const encoderTablePrefix = `
+// Huffman encoder table, indexed by byte - 32 for each printable character.
+// Each code is stored in the least significant bits of code.
+struct HuffmanCode {
+  uint32_t code;
+  uint8_t bits;
 };
-static constexpr std::array<ResponseTrailerPayload, %d> kResponseTrailerFields = {{
+static constexpr std::array<HuffmanCode, %d> kHuffmanEncoderTable = {{
 `
-
-const responseTrailerFieldsSuffix = `
+const encoderTableSuffix = `
 }};
 `
 
-func printStaticResponses() {
-	respHeaderFields := buildResponseHeaderFields()
-	fmt.Printf(responseHeaderFieldsPrefix, len(respHeaderFields))
-	fmt.Printf("  %s", fmtBytes(respHeaderFields))
-	fmt.Printf("%s", responseHeaderFieldsSuffix)
-
-	maxLen := len(buildResponseTrailerFields(maxStatusCode))
-	fmt.Printf(responseTrailerFieldsPrefix, maxLen, maxStatusCode+1)
-	for code := 0; code <= maxStatusCode; code++ {
-		payload := buildResponseTrailerFields(code)
-		fmt.Printf("  {.size=%d, .bytes={%s}},\n", len(payload), fmtBytes(payload))
-	}
-	fmt.Printf("%s", responseTrailerFieldsSuffix)
-}
-
-func fmtBytes(bytes []byte) string {
-	var out string
-	for i, b := range bytes {
-		if i < len(bytes)-1 {
-			out += fmt.Sprintf("0x%x, ", b)
-		} else {
-			out += fmt.Sprintf("0x%x", b)
+func printEncoderTable() {
+	const first, last = 32, 127
+	fmt.Printf(encoderTablePrefix, last-first+1)
+	for out := first; out <= last; out++ {
+		code := huffmanTable[out]
+		var value uint64
+		for i := 0; i < len(code); i++ {
+			value = value<<1 | uint64(code[i]-'0')
 		}
+		fmt.Printf("  /*%q*/ {0x%x, %d},\n", rune(out), value, len(code))
 	}
-	return out
-}
-
-// Response-Headers → ":status 200" "content-type application/grpc"
-func buildResponseHeaderFields() []byte {
-	var out []byte
-	out = append(out, 0b1000_1000) // RFC 7541 §6.1: index 8 is ":status" "200"
-	out = append(out, 0b0101_1111) // RFC 7541 §6.2.1: index 31 is "content-type"
-	out = append(out, literalEncodeWithLength("application/grpc")...)
-	return out
-}
-
-// Trailers → "grpc-status <DIGITS>"
-func buildResponseTrailerFields(statusCode int) []byte {
-	var out []byte
-	out = append(out, 0b0100_0000) // RFC 7541 §6.2.1: literal name and value
-	out = append(out, literalEncodeWithLength("grpc-status")...)
-	if statusCode >= 10 {
-		out = append(out, 0b0000_0010)             // RFC 7541 §6.2.1: length of value w/out huffman
-		out = append(out, byte(statusCode/10)+'0') // RFC 7541 §6.2.1: value
-		out = append(out, byte(statusCode%10)+'0')
-	} else {
-		out = append(out, 0b0000_0001)          // RFC 7541 §6.2.1: length of value w/out huffman
-		out = append(out, byte(statusCode)+'0') // RFC 7541 §6.2.1: value
-	}
-	return out
-}
-
-func literalEncodeWithLength(str string) []byte {
-	// RFC 7541 §6.2.1: we are generating this structure with H=0. Since the
-	// strings are short, there is minimal benefit to using a Huffman encoding,
-	// at most 2-3 bytes per string.
-	// +---+---+-----------------------+
-	// | H |     Value Length (7+)     |
-	// +---+---------------------------+
-	// | Value String (Length octets)  |
-	// +-------------------------------+
-	//
-	// The length must be encoded across multiple bytes if 128 or larger. See RFC
-	// 7541 §5.2. We don't write any strings that large.
-	if len(str) >= 128 {
-		panic(fmt.Sprintf("cannot encode string of length %v: %#v", len(str), str))
-	}
-	return append([]byte{byte(len(str))}, str...)
+	fmt.Print(encoderTableSuffix)
 }
 
 // Special symbol for Huffman EOS.
@@ -14,22 +14,96 @@
 
 #include "pw_grpc_private/hpack.h"
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <limits>
 
 #include "pw_assert/check.h"
 #include "pw_bytes/byte_builder.h"
-#include "pw_log/log.h"
 #include "pw_status/status.h"
 #include "pw_status/try.h"
-#include "pw_string/string_builder.h"
-#include "pw_string/util.h"
 
 namespace pw::grpc {
 
 namespace {
 #include "hpack.autogen.inc"
-}
+
+// See the definition of kHuffmanDecoderTable in hpack.autogen.inc.
+constexpr uint8_t kHuffmanDecoderFail = 0b1111'1111;
+constexpr uint8_t kHuffmanDecoderCanEnd = 0b1000'0000;
+constexpr uint8_t kHuffmanDecoderState = 0b0111'1111;
+constexpr uint8_t kHuffmanDecoderOutput = 0b1000'0000;
+
+// RFC 7541 Appendix A
+constexpr std::array<HpackField, 61> kStaticTable = {{
+    {":authority", ""},
+    {":method", "GET"},
+    {":method", "POST"},
+    {":path", "/"},
+    {":path", "/index.html"},
+    {":scheme", "http"},
+    {":scheme", "https"},
+    {":status", "200"},
+    {":status", "204"},
+    {":status", "206"},
+    {":status", "304"},
+    {":status", "400"},
+    {":status", "404"},
+    {":status", "500"},
+    {"accept-charset", ""},
+    {"accept-encoding", "gzip, deflate"},
+    {"accept-language", ""},
+    {"accept-ranges", ""},
+    {"accept", ""},
+    {"access-control-allow-origin", ""},
+    {"age", ""},
+    {"allow", ""},
+    {"authorization", ""},
+    {"cache-control", ""},
+    {"content-disposition", ""},
+    {"content-encoding", ""},
+    {"content-language", ""},
+    {"content-length", ""},
+    {"content-location", ""},
+    {"content-range", ""},
+    {"content-type", ""},
+    {"cookie", ""},
+    {"date", ""},
+    {"etag", ""},
+    {"expect", ""},
+    {"expires", ""},
+    {"from", ""},
+    {"host", ""},
+    {"if-match", ""},
+    {"if-modified-since", ""},
+    {"if-none-match", ""},
+    {"if-range", ""},
+    {"if-unmodified-since", ""},
+    {"last-modified", ""},
+    {"link", ""},
+    {"location", ""},
+    {"max-forwards", ""},
+    {"proxy-authenticate", ""},
+    {"proxy-authorization", ""},
+    {"range", ""},
+    {"referer", ""},
+    {"refresh", ""},
+    {"retry-after", ""},
+    {"server", ""},
+    {"set-cookie", ""},
+    {"strict-transport-security", ""},
+    {"transfer-encoding", ""},
+    {"user-agent", ""},
+    {"vary", ""},
+    {"via", ""},
+    {"www-authenticate", ""},
+}};
+
+// RFC 7541 §2.3.3: Indices of the dynamic table follow the static table.
+constexpr uint32_t kFirstDynamicIndex = kStaticTable.size() + 1;
+
+}  // namespace
 
 // RFC 7541 §5.1
 Result<uint32_t> HpackIntegerDecode(ConstByteSpan& input,
@@ -68,9 +142,29 @@ Result<uint32_t> HpackIntegerDecode(ConstByteSpan& input,
   }
 }
 
+// RFC 7541 §5.1
+void HpackIntegerEncode(uint32_t value,
+                        uint8_t bits_in_first_byte,
+                        uint8_t first_byte,
+                        ByteBuilder& out) {
+  const uint32_t max_prefix = (1U << bits_in_first_byte) - 1U;
+  if (value < max_prefix) {
+    out.push_back(static_cast<std::byte>(first_byte | value));
+    return;
+  }
+
+  out.push_back(static_cast<std::byte>(first_byte | max_prefix));
+  value -= max_prefix;
+  while (value >= 128) {
+    out.push_back(static_cast<std::byte>((value & 127) | 128));
+    value >>= 7;
+  }
+  out.push_back(static_cast<std::byte>(value));
+}
+
 // RFC 7541 §5.2
-Result<InlineString<kHpackMaxStringSize>> HpackStringDecode(
-    ConstByteSpan& input) {
+Result<std::string_view> HpackStringDecode(ConstByteSpan& input,
+                                           span<char> buffer) {
   if (input.empty()) {
     return Status::InvalidArgument();
   }
@@ -82,111 +176,393 @@ Result<InlineString<kHpackMaxStringSize>> HpackStringDecode(
   if (length > input.size()) {
     return Status::InvalidArgument();
   }
-  if (length > kHpackMaxStringSize) {
-    return Status::OutOfRange();
-  }
 
   auto value = input.subspan(0, length);
   input = input.subspan(length);
   if (is_huffman) {
-    return HpackHuffmanDecode(value);
+    return HpackHuffmanDecode(value, buffer);
   }
-  return InlineString<kHpackMaxStringSize>(
-      reinterpret_cast<const char*>(value.data()), value.size());
+  if (length > buffer.size()) {
+    return Status::OutOfRange();
+  }
+  std::memcpy(buffer.data(), value.data(), value.size());
+  return std::string_view(buffer.data(), value.size());
 }
 
-Result<InlineString<kHpackMaxStringSize>> HpackHuffmanDecode(
-    ConstByteSpan input) {
-  StringBuffer<kHpackMaxStringSize> buffer;
-  uint32_t table_index = 0;
+Result<InlineString<kHpackMaxStringSize>> HpackStringDecode(
+    ConstByteSpan& input) {
+  std::array<char, kHpackMaxStringSize> buffer;
+  PW_TRY_ASSIGN(std::string_view value, HpackStringDecode(input, buffer));
+  return InlineString<kHpackMaxStringSize>(value);
+}
 
-  // See definition of kHuffmanDecoderTable in hpack.autogen.h.
+// RFC 7541 §5.2
+void HpackStringEncode(std::string_view value, ByteBuilder& out) {
+  const std::optional<size_t> huffman_size = HpackHuffmanEncodedSize(value);
+  if (huffman_size.has_value() && *huffman_size < value.size()) {
+    HpackIntegerEncode(
+        static_cast<uint32_t>(*huffman_size), 7, 0b1000'0000, out);
+    HpackHuffmanEncode(value, out);
+    return;
+  }
+  HpackIntegerEncode(static_cast<uint32_t>(value.size()), 7, 0, out);
+  out.append(value.data(), value.size());
+}
+
+Result<std::string_view> HpackHuffmanDecode(ConstByteSpan input,
+                                            span<char> buffer) {
+  size_t size = 0;
+  uint8_t next = 0;
+
+  // See definition of kHuffmanDecoderTable in hpack.autogen.inc.
   for (std::byte byte : input) {
-    for (int k = 7; k >= 0; k--) {
-      auto bit = int(byte >> k) & 0x1;
-      auto cmd = kHuffmanDecoderTable[table_index][bit];
-      if ((cmd & 0b1000'0000) == 0) {
-        table_index = cmd;
-      } else if (cmd == 0b1111'1110 || cmd == 0b1111'1111) {
+    for (int shift : {4, 0}) {
+      const auto nibble = static_cast<uint8_t>(byte >> shift) & 0xf;
+      const auto& entry =
+          kHuffmanDecoderTable[next & kHuffmanDecoderState][nibble];
+      if (entry.next == kHuffmanDecoderFail) {
         // Error: unprintable character or the decoder entered an invalid state.
         return Status::InvalidArgument();
-      } else {
-        if (buffer.size() == buffer.max_size()) {
+      }
+      if ((entry.symbol & kHuffmanDecoderOutput) != 0) {
+        if (size == buffer.size()) {
           return Status::OutOfRange();
         }
-        buffer.push_back(32 + (cmd & 0b0111'1111));
-        table_index = 0;
+        buffer[size++] = static_cast<char>(32 + (entry.symbol & 0b0111'1111));
       }
+      next = entry.next;
     }
   }
 
-  return InlineString<kHpackMaxStringSize>(buffer.view());
+  // RFC 7541 §5.2: "A padding strictly longer than 7 bits MUST be treated as a
+  // decoding error. A padding not corresponding to the most significant bits
+  // of the code for the EOS symbol MUST be treated as a decoding error."
+  if (!input.empty() && (next & kHuffmanDecoderCanEnd) == 0) {
+    return Status::InvalidArgument();
+  }
+  return std::string_view(buffer.data(), size);
 }
 
-// RFC 7541 §6
-Result<InlineString<kHpackMaxStringSize>> HpackParseRequestHeaders(
+Result<InlineString<kHpackMaxStringSize>> HpackHuffmanDecode(
     ConstByteSpan input) {
-  while (!input.empty()) {
-    int first = static_cast<int>(input[0]);
+  std::array<char, kHpackMaxStringSize> buffer;
+  PW_TRY_ASSIGN(std::string_view value, HpackHuffmanDecode(input, buffer));
+  return InlineString<kHpackMaxStringSize>(value);
+}
 
-    // RFC 7541 §6.1
-    if ((first & 0b1000'0000) != 0) {
-      PW_TRY_ASSIGN(uint32_t index, HpackIntegerDecode(input, 7));
-      // RFC 7541 Appendix A: these are the only static table entries for :path.
-      if (index == 4) {
-        return "/";
-      }
-      if (index == 5) {
-        return "/index.html";
-      }
-      continue;
+std::optional<size_t> HpackHuffmanEncodedSize(std::string_view value) {
+  size_t bits = 0;
+  for (char c : value) {
+    const size_t byte = static_cast<uint8_t>(c);
+    if (byte < 32 || byte - 32 >= kHuffmanEncoderTable.size()) {
+      return std::nullopt;
+    }
+    bits += kHuffmanEncoderTable[byte - 32].bits;
+  }
+  return (bits + 7) / 8;
+}
+
+// RFC 7541 §5.2
+void HpackHuffmanEncode(std::string_view value, ByteBuilder& out) {
+  // Codes are at most 28 bits, and fewer than 8 bits are left over from the
+  // previous code.
+  uint64_t bits = 0;
+  uint32_t num_bits = 0;
+  for (char c : value) {
+    const HuffmanCode& code =
+        kHuffmanEncoderTable[static_cast<uint8_t>(c) - 32];
+    bits = (bits << code.bits) | code.code;
+    num_bits += code.bits;
+    while (num_bits >= 8) {
+      num_bits -= 8;
+      out.push_back(
+          static_cast<std::byte>(static_cast<uint8_t>(bits >> num_bits)));
+    }
+  }
+
+  // "As the Huffman-encoded data doesn't always end at an octet boundary,
+  // some padding is inserted after it, up to the next octet boundary. To
+  // prevent this padding from being misinterpreted as part of the string
+  // literal, the most significant bits of the code corresponding to the EOS
+  // (end-of-string) symbol are used."
+  if (num_bits > 0) {
+    const auto last = static_cast<uint8_t>(bits << (8 - num_bits));
+    out.push_back(static_cast<std::byte>(last | (0xff >> num_bits)));
+  }
+}
+
+namespace internal {
+
+HpackField HpackDynamicTable::operator[](size_t index) const {
+  PW_DASSERT(index < num_fields_);
+  const Entry& entry =
+      entries_[(first_ + num_fields_ - 1 - index) % entries_.size()];
+  const char* data = buffer_.data() + entry.offset;
+  return {std::string_view(data, entry.name_size),
+          std::string_view(data + entry.name_size, entry.value_size)};
+}
+
+void HpackDynamicTable::SetMaxSize(size_t max_size) {
+  PW_DASSERT(max_size <= capacity());
+  max_size_ = max_size;
+  while (size_ > max_size_) {
+    EvictOldest();
+  }
+}
+
+void HpackDynamicTable::Add(std::string_view name, std::string_view value) {
+  const size_t data_size = name.size() + value.size();
+  const size_t entry_size = data_size + kHpackEntryOverhead;
+
+  // RFC 7541 §4.4: "an attempt to add an entry larger than the maximum size
+  // causes the table to be emptied of all existing entries and results in an
+  // empty table."
+  if (entry_size > max_size_) {
+    Clear();
+    return;
+  }
+  while (size_ + entry_size > max_size_) {
+    EvictOldest();
+  }
+
+  // The fields now take at most max_size_ - entry_size bytes, so the new field
+  // fits in the buffer once the fields are moved to its start.
+  if (end_ + data_size > buffer_.size()) {
+    std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+    for (size_t i = 0; i < num_fields_; ++i) {
+      entries_[(first_ + i) % entries_.size()].offset -= begin_;
     }
+    end_ -= begin_;
+    begin_ = 0;
+  }
+
+  entries_[(first_ + num_fields_) % entries_.size()] = {
+      .offset = static_cast<uint16_t>(end_),
+      .name_size = static_cast<uint16_t>(name.size()),
+      .value_size = static_cast<uint16_t>(value.size()),
+  };
+  std::memcpy(buffer_.data() + end_, name.data(), name.size());
+  std::memcpy(buffer_.data() + end_ + name.size(), value.data(), value.size());
+  end_ += data_size;
+  num_fields_ += 1;
+  size_ += entry_size;
+}
+
+void HpackDynamicTable::Clear() {
+  first_ = 0;
+  num_fields_ = 0;
+  begin_ = 0;
+  end_ = 0;
+  size_ = 0;
+}
+
+// RFC 7541 §4.4: Entries are evicted from the end of the table, which holds
+// the oldest entries.
+void HpackDynamicTable::EvictOldest() {
+  const Entry& entry = entries_[first_];
+  begin_ = entry.offset + entry.name_size + entry.value_size;
+  size_ -= entry.name_size + entry.value_size + kHpackEntryOverhead;
+  first_ = (first_ + 1) % entries_.size();
+  num_fields_ -= 1;
+  if (num_fields_ == 0) {
+    Clear();
+  }
+}
+
+// RFC 7541 §2.3.3
+Result<HpackField> HpackDecoder::Lookup(uint32_t index) const {
+  if (index == 0) {
+    // RFC 7541 §6.1: "The index value of 0 is not used. It MUST be treated as
+    // a decoding error if found in an indexed header field representation."
+    return Status::InvalidArgument();
+  }
+  if (index < kFirstDynamicIndex) {
+    return kStaticTable[index - 1];
+  }
+  // RFC 7541 §2.3.3: "Indices strictly greater than the sum of the lengths of
+  // both tables MUST be treated as a decoding error."
+  if (index - kFirstDynamicIndex >= table_.num_fields()) {
+    return Status::InvalidArgument();
+  }
+  return table_[index - kFirstDynamicIndex];
+}
+
+// RFC 7541 §3 and §6
+Result<InlineString<kHpackMaxStringSize>> HpackDecoder::ParseRequestHeaders(
+    ConstByteSpan input) {
+  Result<InlineString<kHpackMaxStringSize>> method_name = Status::NotFound();
+  bool at_block_start = true;
+
+  while (!input.empty()) {
+    const int first = static_cast<int>(input[0]);
 
     // RFC 7541 §6.3: dynamic table size update
     if ((first & 0b1110'0000) == 0b0010'0000) {
-      // Ignore: we don't use the dynamic table.
-      PW_TRY(HpackIntegerDecode(input, 5));
+      PW_TRY_ASSIGN(uint32_t max_size, HpackIntegerDecode(input, 5));
+      // RFC 7541 §4.2: "This dynamic table size update MUST occur at the
+      // beginning of the first header block following the change to the
+      // dynamic table size." RFC 7541 §6.3: "The new maximum size MUST be
+      // lower than or equal to the limit determined by the protocol".
+      if (!at_block_start || max_size > table_.capacity()) {
+        return Status::InvalidArgument();
+      }
+      table_.SetMaxSize(max_size);
       continue;
     }
+    at_block_start = false;
 
-    // RFC 7541 §6.2
-    uint32_t index;
-    if ((first & 0b1100'0000) == 0b0100'0000) {
-      PW_TRY_ASSIGN(index, HpackIntegerDecode(input, 6));
+    HpackField field;
+    if ((first & 0b1000'0000) != 0) {
+      // RFC 7541 §6.1
+      PW_TRY_ASSIGN(uint32_t index, HpackIntegerDecode(input, 7));
+      PW_TRY_ASSIGN(field, Lookup(index));
     } else {
-      PW_CHECK((first & 0b1111'0000) == 0b0000'0000 ||
-               (first & 0b1111'0000) == 0b0001'0000);
-      PW_TRY_ASSIGN(index, HpackIntegerDecode(input, 4));
-    }
+      // RFC 7541 §6.2
+      const bool add_to_table = (first & 0b1100'0000) == 0b0100'0000;
+      PW_TRY_ASSIGN(uint32_t index,
+                    HpackIntegerDecode(input, add_to_table ? 6 : 4));
 
-    // Check if the name is ":path".
-    bool is_path;
-    if (index == 0) {
-      PW_TRY_ASSIGN(auto name, HpackStringDecode(input));
-      is_path = (name == ":path");
-    } else {
-      // RFC 7541 Appendix A: these are the only static table entries for :path.
-      is_path = (index == 4 || index == 5);
+      // Decode the name and value into the scratch buffer. A dynamic table
+      // name is copied, since adding the field may evict it.
+      span<char> buffer = scratch_;
+      bool too_large = false;
+      if (index == 0) {
+        Result<std::string_view> name = HpackStringDecode(input, buffer);
+        if (name.status().IsOutOfRange()) {
+          too_large = true;
+        } else {
+          PW_TRY(name.status());
+          field.name = *name;
+        }
+      } else {
+        PW_TRY_ASSIGN(HpackField indexed, Lookup(index));
+        field.name = indexed.name;
+        if (add_to_table && index >= kFirstDynamicIndex) {
+          std::copy(indexed.name.begin(), indexed.name.end(), buffer.begin());
+          field.name = std::string_view(buffer.data(), indexed.name.size());
+        }
+      }
+      buffer = too_large ? span<char>() : buffer.subspan(field.name.size());
+
+      Result<std::string_view> value = HpackStringDecode(input, buffer);
+      if (value.status().IsOutOfRange()) {
+        too_large = true;
+      } else {
+        PW_TRY(value.status());
+        field.value = *value;
+      }
+
+      if (too_large) {
+        // The field is larger than the table, so adding it empties the table.
+        if (add_to_table) {
+          table_.Clear();
+        }
+        if (field.name == ":path") {
+          method_name = Status::OutOfRange();
+        }
+        continue;
+      }
+      if (add_to_table) {
+        table_.Add(field.name, field.value);
+      }
     }
 
-    // Always extract the value to advance the `input` span.
-    PW_TRY_ASSIGN(auto value, HpackStringDecode(input));
-    if (is_path) {
-      return value;
+    if (field.name == ":path") {
+      if (field.value.size() > kHpackMaxStringSize) {
+        method_name = Status::OutOfRange();
+      } else {
+        method_name = InlineString<kHpackMaxStringSize>(field.value);
+      }
     }
   }
 
-  return Status::NotFound();
+  return method_name;
 }
 
-ConstByteSpan ResponseHeadersPayload() {
-  return as_bytes(span{kResponseHeaderFields});
+HpackEncoder::HpackEncoder() : min_max_size_(kHpackEncoderTableSize) {
+  // The client's table starts with the protocol default size, so the first
+  // block signals the size of our table.
+  table_.SetMaxSize(kHpackEncoderTableSize);
+}
+
+void HpackEncoder::SetPeerMaxTableSize(uint32_t max_size) {
+  const size_t new_max_size = std::min<size_t>(max_size, table_.capacity());
+  table_.SetMaxSize(new_max_size);
+  min_max_size_ = std::min(min_max_size_, new_max_size);
+  max_size_changed_ = true;
+}
+
+// RFC 7541 §3 and §6
+Status HpackEncoder::Encode(span<const HpackField> fields, ByteBuilder& out) {
+  // RFC 7541 §4.2: "If the maximum size is reduced and then increased between
+  // two header blocks, the smallest maximum table size that occurs in that
+  // interval MUST be signaled in a dynamic table size update. The final
+  // maximum size is signaled in a second dynamic table size update."
+  if (max_size_changed_) {
+    if (min_max_size_ < table_.max_size()) {
+      HpackIntegerEncode(
+          static_cast<uint32_t>(min_max_size_), 5, 0b0010'0000, out);
+    }
+    HpackIntegerEncode(
+        static_cast<uint32_t>(table_.max_size()), 5, 0b0010'0000, out);
+    min_max_size_ = table_.max_size();
+    max_size_changed_ = false;
+  }
+
+  for (const HpackField& field : fields) {
+    EncodeField(field, out);
+  }
+  return out.status();
 }
 
-ConstByteSpan ResponseTrailersPayload(Status response_code) {
-  PW_CHECK_UINT_LT(response_code.code(), kResponseTrailerFields.size());
-  auto* payload = &kResponseTrailerFields[response_code.code()];
-  return as_bytes(span{payload->bytes}.subspan(0, payload->size));
+void HpackEncoder::EncodeField(const HpackField& field, ByteBuilder& out) {
+  // Find the field, or at least its name, in the static and dynamic tables.
+  uint32_t name_index = 0;
+  for (uint32_t i = 0; i < kStaticTable.size(); ++i) {
+    if (kStaticTable[i].name != field.name) {
+      continue;
+    }
+    if (kStaticTable[i].value == field.value) {
+      // RFC 7541 §6.1
+      HpackIntegerEncode(i + 1, 7, 0b1000'0000, out);
+      return;
+    }
+    if (name_index == 0) {
+      name_index = i + 1;
+    }
+  }
+  for (uint32_t i = 0; i < table_.num_fields(); ++i) {
+    const HpackField entry = table_[i];
+    if (entry.name != field.name) {
+      continue;
+    }
+    if (entry.value == field.value) {
+      // RFC 7541 §6.1
+      HpackIntegerEncode(kFirstDynamicIndex + i, 7, 0b1000'0000, out);
+      return;
+    }
+    if (name_index == 0) {
+      name_index = kFirstDynamicIndex + i;
+    }
+  }
+
+  const size_t entry_size =
+      field.name.size() + field.value.size() + kHpackEntryOverhead;
+  if (entry_size <= table_.max_size()) {
+    // RFC 7541 §6.2.1: literal header field with incremental indexing
+    HpackIntegerEncode(name_index, 6, 0b0100'0000, out);
+  } else {
+    // RFC 7541 §6.2.2: literal header field without indexing
+    HpackIntegerEncode(name_index, 4, 0b0000'0000, out);
+  }
+  if (name_index == 0) {
+    HpackStringEncode(field.name, out);
+  }
+  HpackStringEncode(field.value, out);
+  if (entry_size <= table_.max_size()) {
+    table_.Add(field.name, field.value);
+  }
 }
 
+}  // namespace internal
 }  // namespace pw::grpc
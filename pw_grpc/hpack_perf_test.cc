@@ -0,0 +1,123 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_assert/check.h"
+#include "pw_bytes/array.h"
+#include "pw_grpc_private/hpack.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::grpc {
+namespace {
+
+// Request header blocks of a unary call from typical gRPC clients, as encoded
+// by an HPACK encoder with the default table size. The first request of a
+// connection adds its fields to the dynamic table, and the following requests
+// refer to them.
+//
+// clang-format off
+constexpr auto kGrpcGoFirstRequest = bytes::Array<
+    0x83, 0x86, 0x45, 0x9b, 0x62, 0xbf, 0x0b, 0xcd, 0x65, 0x64, 0x5c, 0xbe,
+    0x47, 0x4d, 0x74, 0x15, 0x0b, 0x94, 0x93, 0x9d, 0x7c, 0x04, 0x9c, 0xec,
+    0x70, 0xa8, 0x76, 0x7a, 0xc0, 0x49, 0xcf, 0x41, 0x8a, 0xa0, 0xe4, 0x1d,
+    0x13, 0x9d, 0x09, 0xb8, 0xcb, 0x40, 0x07, 0x5f, 0x8b, 0x1d, 0x75, 0xd0,
+    0x62, 0x0d, 0x26, 0x3d, 0x4c, 0x4d, 0x65, 0x64, 0x7a, 0x8a, 0x9a, 0xca,
+    0xc8, 0xb4, 0xc7, 0x60, 0x2b, 0xb8, 0x05, 0xc3, 0x40, 0x02, 0x74, 0x65,
+    0x86, 0x4d, 0x83, 0x35, 0x05, 0xb1, 0x1f, 0x40, 0x89, 0x9a, 0xca, 0xc8,
+    0xb2, 0x4d, 0x49, 0x4f, 0x6a, 0x7f, 0x84, 0x7d, 0xf7, 0xdf, 0xa7>();
+constexpr auto kGrpcGoNextRequest = bytes::Array<
+    0x83, 0x86, 0xc3, 0xc2, 0xc1, 0xc0, 0xbf, 0xbe>();
+constexpr auto kGrpcJavaFirstRequest = bytes::Array<
+    0x41, 0x8a, 0xa0, 0xe4, 0x1d, 0x13, 0x9d, 0x09, 0xb8, 0xcb, 0x40, 0x07,
+    0x45, 0x9b, 0x62, 0xbf, 0x0b, 0xcd, 0x65, 0x64, 0x5c, 0xbe, 0x47, 0x4d,
+    0x74, 0x15, 0x0b, 0x94, 0x93, 0x9d, 0x7c, 0x04, 0x9c, 0xec, 0x70, 0xa8,
+    0x76, 0x7a, 0xc0, 0x49, 0xcf, 0x83, 0x86, 0x5f, 0x8b, 0x1d, 0x75, 0xd0,
+    0x62, 0x0d, 0x26, 0x3d, 0x4c, 0x4d, 0x65, 0x64, 0x40, 0x02, 0x74, 0x65,
+    0x86, 0x4d, 0x83, 0x35, 0x05, 0xb1, 0x1f, 0x7a, 0x90, 0x9a, 0xca, 0xc8,
+    0xb7, 0x41, 0xf7, 0x1a, 0xd5, 0x15, 0x29, 0xf4, 0xc0, 0x57, 0x70, 0x0b,
+    0x83, 0x40, 0x8e, 0x9a, 0xca, 0xc8, 0xb0, 0xc8, 0x42, 0xd6, 0x95, 0x8b,
+    0x51, 0x0f, 0x21, 0xaa, 0x9b, 0x83, 0x9b, 0xd9, 0xab>();
+constexpr auto kGrpcJavaNextRequest = bytes::Array<
+    0xc3, 0xc2, 0x83, 0x86, 0xc1, 0xc0, 0xbf, 0xbe>();
+constexpr auto kGrpcCoreFirstRequest = bytes::Array<
+    0x86, 0x83, 0x45, 0x9b, 0x62, 0xbf, 0x0b, 0xcd, 0x65, 0x64, 0x5c, 0xbe,
+    0x47, 0x4d, 0x74, 0x15, 0x0b, 0x94, 0x93, 0x9d, 0x7c, 0x04, 0x9c, 0xec,
+    0x70, 0xa8, 0x76, 0x7a, 0xc0, 0x49, 0xcf, 0x41, 0x8a, 0xa0, 0xe4, 0x1d,
+    0x13, 0x9d, 0x09, 0xb8, 0xcb, 0x40, 0x07, 0x40, 0x02, 0x74, 0x65, 0x86,
+    0x4d, 0x83, 0x35, 0x05, 0xb1, 0x1f, 0x5f, 0x8b, 0x1d, 0x75, 0xd0, 0x62,
+    0x0d, 0x26, 0x3d, 0x4c, 0x4d, 0x65, 0x64, 0x7a, 0xa4, 0x9a, 0xca, 0xc8,
+    0xb5, 0x7e, 0x93, 0x39, 0xea, 0x60, 0x2b, 0xb8, 0x05, 0xc0, 0xa4, 0xd6,
+    0x56, 0x45, 0x88, 0xc3, 0x2e, 0xae, 0x05, 0xc0, 0xa7, 0xf5, 0x41, 0xaa,
+    0xb7, 0xcf, 0xda, 0x84, 0x9d, 0x29, 0xac, 0x5f, 0xdf, 0x40, 0x8e, 0x9a,
+    0xca, 0xc8, 0xb0, 0xc8, 0x42, 0xd6, 0x95, 0x8b, 0x51, 0x0f, 0x21, 0xaa,
+    0x9b, 0x91, 0x34, 0x85, 0xa9, 0x26, 0x4f, 0xaf, 0xa5, 0x24, 0x2c, 0xb4,
+    0x0d, 0x25, 0xfa, 0x52, 0x6f, 0x66, 0xaf>();
+constexpr auto kGrpcCoreNextRequest = bytes::Array<
+    0x86, 0x83, 0xc3, 0xc2, 0xc1, 0xc0, 0xbf, 0xbe>();
+// clang-format on
+
+constexpr std::string_view kMethodName =
+    "/pw.grpc.examples.echo.Echo/UnaryEcho";
+
+// The benchmarks share a decoder, like the requests of a connection.
+HpackDecoder& Decoder() {
+  static HpackDecoder decoder;
+  return decoder;
+}
+
+void ParseRequest(ConstByteSpan block) {
+  auto method_name = Decoder().ParseRequestHeaders(block);
+  PW_CHECK_OK(method_name.status());
+  PW_CHECK(*method_name == kMethodName);
+}
+
+// Parses a request whose fields are not yet in the dynamic table. The fields
+// are added again on each iteration, which eventually evicts older copies.
+void ParseFirstRequest(perf_test::State& state, ConstByteSpan block) {
+  while (state.KeepRunning()) {
+    ParseRequest(block);
+  }
+}
+
+// Parses a request whose fields are all in the dynamic table.
+void ParseNextRequest(perf_test::State& state,
+                      ConstByteSpan first_block,
+                      ConstByteSpan next_block) {
+  ParseRequest(first_block);
+  while (state.KeepRunning()) {
+    ParseRequest(next_block);
+  }
+}
+
+PW_PERF_TEST(Hpack_GrpcGo_FirstRequest, ParseFirstRequest, kGrpcGoFirstRequest);
+PW_PERF_TEST(Hpack_GrpcGo_NextRequest,
+             ParseNextRequest,
+             kGrpcGoFirstRequest,
+             kGrpcGoNextRequest);
+PW_PERF_TEST(Hpack_GrpcJava_FirstRequest,
+             ParseFirstRequest,
+             kGrpcJavaFirstRequest);
+PW_PERF_TEST(Hpack_GrpcJava_NextRequest,
+             ParseNextRequest,
+             kGrpcJavaFirstRequest,
+             kGrpcJavaNextRequest);
+PW_PERF_TEST(Hpack_GrpcCore_FirstRequest,
+             ParseFirstRequest,
+             kGrpcCoreFirstRequest);
+PW_PERF_TEST(Hpack_GrpcCore_NextRequest,
+             ParseNextRequest,
+             kGrpcCoreFirstRequest,
+             kGrpcCoreNextRequest);
+
+}  // namespace
+}  // namespace pw::grpc
@@ -14,7 +14,11 @@
 
 #include "pw_grpc_private/hpack.h"
 
+#include <algorithm>
+#include <string_view>
+
 #include "pw_bytes/array.h"
+#include "pw_bytes/byte_builder.h"
 #include "pw_unit_test/framework.h"
 
 namespace pw::grpc {
@@ -33,11 +37,45 @@ void TestHuffmanDecode(ConstByteSpan input, std::string_view expected) {
   EXPECT_EQ(*result, expected);
 }
 
+void TestHuffmanDecodeInvalid(ConstByteSpan input) {
+  auto result = HpackHuffmanDecode(input);
+  EXPECT_EQ(result.status(), Status::InvalidArgument());
+}
+
 void TestIntegerDecodeInvalid(ConstByteSpan input, uint8_t bits) {
   auto result = HpackIntegerDecode(input, bits);
   EXPECT_EQ(result.status(), Status::InvalidArgument());
 }
 
+void ExpectBytes(ConstByteSpan actual, ConstByteSpan expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  EXPECT_TRUE(std::equal(actual.begin(), actual.end(), expected.begin()));
+}
+
+void TestIntegerEncode(uint32_t value, uint8_t bits, ConstByteSpan expected) {
+  ByteBuffer<8> out;
+  HpackIntegerEncode(value, bits, 0, out);
+  ASSERT_EQ(out.status(), OkStatus());
+  ExpectBytes(out, expected);
+}
+
+void TestHuffmanEncode(std::string_view input, ConstByteSpan expected) {
+  EXPECT_EQ(HpackHuffmanEncodedSize(input), expected.size());
+  ByteBuffer<32> out;
+  HpackHuffmanEncode(input, out);
+  ASSERT_EQ(out.status(), OkStatus());
+  ExpectBytes(out, expected);
+}
+
+void ExpectField(const HpackDynamicTable& table,
+                 size_t index,
+                 std::string_view name,
+                 std::string_view value) {
+  ASSERT_LT(index, table.num_fields());
+  EXPECT_EQ(table[index].name, name);
+  EXPECT_EQ(table[index].value, value);
+}
+
 // Integer test cases from RFC 7541 Appendix C.1.
 TEST(HpackTest, HpackIntegerDecodeC11) {
   const auto kInput = bytes::Array<0b11101010>();
@@ -52,6 +90,21 @@ TEST(HpackTest, HpackIntegerDecodeC13) {
   TestIntegerDecode(kInput, /*bits_in_first_byte=*/8, /*expected=*/42U);
 }
 
+TEST(HpackTest, HpackIntegerEncodeC11) {
+  TestIntegerEncode(10U, /*bits=*/5, bytes::Array<0b01010>());
+}
+TEST(HpackTest, HpackIntegerEncodeC12) {
+  TestIntegerEncode(
+      1337U, /*bits=*/5, bytes::Array<0b11111, 0b10011010, 0b00001010>());
+}
+TEST(HpackTest, HpackIntegerEncodeC13) {
+  TestIntegerEncode(42U, /*bits=*/8, bytes::Array<0b00101010>());
+}
+TEST(HpackTest, HpackIntegerEncodeUint32Max) {
+  const auto kInput = bytes::Array<0x1f, 0xe0, 0xff, 0xff, 0xff, 0x0f>();
+  TestIntegerEncode(4294967295U, /*bits=*/5, kInput);
+}
+
 TEST(HpackTest, HpackIntegerDecodeOverflowWrapTo31) {
   const auto kInput = bytes::Array<0x1f, 0x80, 0x80, 0x80, 0x80, 0x10>();
   TestIntegerDecodeInvalid(kInput, /*bits=*/5);
@@ -100,19 +153,73 @@ TEST(HpackTest, HpackHuffmanDecodeC43a) {
 TEST(HpackTest, HpackHuffmanDecodeC43b) {
   TestHuffmanDecode(kHuffmanC43b, "custom-value");
 }
+TEST(HpackTest, HpackHuffmanDecodeEveryPrintableCharacter) {
+  char input[96];
+  for (size_t i = 0; i < sizeof(input); ++i) {
+    input[i] = static_cast<char>(32 + i);
+  }
+  const std::string_view value(input, sizeof(input));
+  ByteBuffer<256> encoded;
+  HpackHuffmanEncode(value, encoded);
+  ASSERT_EQ(encoded.status(), OkStatus());
+
+  char output[96];
+  auto result = HpackHuffmanDecode(encoded, output);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(*result, value);
+}
+TEST(HpackTest, HpackHuffmanDecodePaddingTooLong) {
+  // "a" is 00011, followed by 8 bits of padding.
+  TestHuffmanDecodeInvalid(bytes::Array<0x1f, 0xff>());
+}
+TEST(HpackTest, HpackHuffmanDecodePaddingNotOnes) {
+  // "a" is 00011, followed by padding of 000.
+  TestHuffmanDecodeInvalid(bytes::Array<0x18>());
+}
+TEST(HpackTest, HpackHuffmanDecodeEos) {
+  // EOS is 30 1s.
+  TestHuffmanDecodeInvalid(bytes::Array<0xff, 0xff, 0xff, 0xfc>());
+}
+TEST(HpackTest, HpackHuffmanDecodeUnprintable) {
+  // 0x00 is 1111111111000.
+  TestHuffmanDecodeInvalid(bytes::Array<0xff, 0xc7>());
+}
+TEST(HpackTest, HpackHuffmanDecodeTooLong) {
+  char output[14];
+  auto result = HpackHuffmanDecode(kHuffmanC41, output);
+  EXPECT_EQ(result.status(), Status::OutOfRange());
+}
+
+TEST(HpackTest, HpackHuffmanEncodeC41) {
+  TestHuffmanEncode("www.example.com", kHuffmanC41);
+}
+TEST(HpackTest, HpackHuffmanEncodeC42) {
+  TestHuffmanEncode("no-cache", kHuffmanC42);
+}
+TEST(HpackTest, HpackHuffmanEncodeC43a) {
+  TestHuffmanEncode("custom-key", kHuffmanC43a);
+}
+TEST(HpackTest, HpackHuffmanEncodeC43b) {
+  TestHuffmanEncode("custom-value", kHuffmanC43b);
+}
+TEST(HpackTest, HpackHuffmanEncodedSizeUnprintable) {
+  EXPECT_EQ(HpackHuffmanEncodedSize(std::string_view("a\nb")), std::nullopt);
+}
 
 // Header field test cases from RFC 7541 Appendix C.
 TEST(HpackTest, HpackParseRequestHeadersFoundIndexedSlash) {
   // Appendix C.3.1.
   const auto kInput = bytes::Array<0x84>();
-  auto result = HpackParseRequestHeaders(kInput);
+  HpackDecoder decoder;
+  auto result = decoder.ParseRequestHeaders(kInput);
   ASSERT_TRUE(result.ok());
   EXPECT_EQ(*result, "/");
 }
 TEST(HpackTest, HpackParseRequestHeadersFoundIndexedHtml) {
   // Appendix C.3.3.
   const auto kInput = bytes::Array<0x85>();
-  auto result = HpackParseRequestHeaders(kInput);
+  HpackDecoder decoder;
+  auto result = decoder.ParseRequestHeaders(kInput);
   ASSERT_TRUE(result.ok());
   EXPECT_EQ(*result, "/index.html");
 }
@@ -129,7 +236,8 @@ TEST(HpackTest, HpackParseRequestHeadersFoundNotIndexed) {
       0x04, 0x0c, 0x2f, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x2f, 0x70, 0x61, 0x74, 0x68
   >();
   // clang-format on
-  auto result = HpackParseRequestHeaders(kInput);
+  HpackDecoder decoder;
+  auto result = decoder.ParseRequestHeaders(kInput);
   ASSERT_TRUE(result.ok());
   EXPECT_EQ(*result, "/sample/path");
 }
@@ -144,10 +252,334 @@ TEST(HpackTest, HpackParseRequestHeadersNotFound) {
       0x72, 0x65, 0x74
   >();
   // clang-format on
-  auto result = HpackParseRequestHeaders(kInput);
+  HpackDecoder decoder;
+  auto result = decoder.ParseRequestHeaders(kInput);
   ASSERT_FALSE(result.ok());
   EXPECT_EQ(result.status().code(), PW_STATUS_NOT_FOUND);
 }
 
+// Request header blocks from RFC 7541 Appendix C.3, which share a dynamic
+// table.
+TEST(HpackTest, HpackDecoderRequestsWithoutHuffmanC3) {
+  // clang-format off
+  const auto kRequest1 = bytes::Array<
+      0x82, 0x86, 0x84, 0x41, 0x0f, 0x77, 0x77, 0x77, 0x2e, 0x65, 0x78, 0x61,
+      0x6d, 0x70, 0x6c, 0x65, 0x2e, 0x63, 0x6f, 0x6d>();
+  const auto kRequest2 = bytes::Array<
+      0x82, 0x86, 0x84, 0xbe, 0x58, 0x08, 0x6e, 0x6f, 0x2d, 0x63, 0x61, 0x63,
+      0x68, 0x65>();
+  const auto kRequest3 = bytes::Array<
+      0x82, 0x87, 0x85, 0xbf, 0x40, 0x0a, 0x63, 0x75, 0x73, 0x74, 0x6f, 0x6d,
+      0x2d, 0x6b, 0x65, 0x79, 0x0c, 0x63, 0x75, 0x73, 0x74, 0x6f, 0x6d, 0x2d,
+      0x76, 0x61, 0x6c, 0x75, 0x65>();
+  // clang-format on
+  HpackDecoder decoder;
+
+  auto result = decoder.ParseRequestHeaders(kRequest1);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(*result, "/");
+  EXPECT_EQ(decoder.table().size(), 57u);
+  ExpectField(decoder.table(), 0, ":authority", "www.example.com");
+
+  result = decoder.ParseRequestHeaders(kRequest2);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(*result, "/");
+  EXPECT_EQ(decoder.table().size(), 110u);
+  ExpectField(decoder.table(), 0, "cache-control", "no-cache");
+  ExpectField(decoder.table(), 1, ":authority", "www.example.com");
+
+  result = decoder.ParseRequestHeaders(kRequest3);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(*result, "/index.html");
+  EXPECT_EQ(decoder.table().size(), 164u);
+  ExpectField(decoder.table(), 0, "custom-key", "custom-value");
+  ExpectField(decoder.table(), 1, "cache-control", "no-cache");
+  ExpectField(decoder.table(), 2, ":authority", "www.example.com");
+}
+
+// Request header blocks from RFC 7541 Appendix C.4, which are the same as C.3
+// with Huffman-encoded strings.
+TEST(HpackTest, HpackDecoderRequestsWithHuffmanC4) {
+  // clang-format off
+  const auto kRequest1 = bytes::Array<
+      0x82, 0x86, 0x84, 0x41, 0x8c, 0xf1, 0xe3, 0xc2, 0xe5, 0xf2, 0x3a, 0x6b,
+      0xa0, 0xab, 0x90, 0xf4, 0xff>();
+  const auto kRequest2 = bytes::Array<
+      0x82, 0x86, 0x84, 0xbe, 0x58, 0x86, 0xa8, 0xeb, 0x10, 0x64, 0x9c, 0xbf>();
+  const auto kRequest3 = bytes::Array<
+      0x82, 0x87, 0x85, 0xbf, 0x40, 0x88, 0x25, 0xa8, 0x49, 0xe9, 0x5b, 0xa9,
+      0x7d, 0x7f, 0x89, 0x25, 0xa8, 0x49, 0xe9, 0x5b, 0xb8, 0xe8, 0xb4, 0xbf>();
+  // clang-format on
+  HpackDecoder decoder;
+
+  ASSERT_EQ(decoder.ParseRequestHeaders(kRequest1).status(), OkStatus());
+  ASSERT_EQ(decoder.ParseRequestHeaders(kRequest2).status(), OkStatus());
+  auto result = decoder.ParseRequestHeaders(kRequest3);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(*result, "/index.html");
+  EXPECT_EQ(decoder.table().size(), 164u);
+  ExpectField(decoder.table(), 0, "custom-key", "custom-value");
+  ExpectField(decoder.table(), 1, "cache-control", "no-cache");
+  ExpectField(decoder.table(), 2, ":authority", "www.example.com");
+}
+
+// Response header blocks from RFC 7541 Appendix C.5, which evict fields from
+// a 256 byte table.
+TEST(HpackTest, HpackDecoderEvictsC5) {
+  // clang-format off
+  const auto kResponse1 = bytes::Array<
+      // Dynamic table size update to 256.
+      0x3f, 0xe1, 0x01,
+      0x48, 0x03, 0x33, 0x30, 0x32, 0x58, 0x07, 0x70, 0x72, 0x69, 0x76, 0x61,
+      0x74, 0x65, 0x61, 0x1d, 0x4d, 0x6f, 0x6e, 0x2c, 0x20, 0x32, 0x31, 0x20,
+      0x4f, 0x63, 0x74, 0x20, 0x32, 0x30, 0x31, 0x33, 0x20, 0x32, 0x30, 0x3a,
+      0x31, 0x33, 0x3a, 0x32, 0x31, 0x20, 0x47, 0x4d, 0x54, 0x6e, 0x17, 0x68,
+      0x74, 0x74, 0x70, 0x73, 0x3a, 0x2f, 0x2f, 0x77, 0x77, 0x77, 0x2e, 0x65,
+      0x78, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x2e, 0x63, 0x6f, 0x6d>();
+  const auto kResponse2 = bytes::Array<
+      0x48, 0x03, 0x33, 0x30, 0x37, 0xc1, 0xc0, 0xbf>();
+  const auto kResponse3 = bytes::Array<
+      0x88, 0xc1, 0x61, 0x1d, 0x4d, 0x6f, 0x6e, 0x2c, 0x20, 0x32, 0x31, 0x20,
+      0x4f, 0x63, 0x74, 0x20, 0x32, 0x30, 0x31, 0x33, 0x20, 0x32, 0x30, 0x3a,
+      0x31, 0x33, 0x3a, 0x32, 0x32, 0x20, 0x47, 0x4d, 0x54, 0xc0, 0x5a, 0x04,
+      0x67, 0x7a, 0x69, 0x70, 0x77, 0x38, 0x66, 0x6f, 0x6f, 0x3d, 0x41, 0x53,
+      0x44, 0x4a, 0x4b, 0x48, 0x51, 0x4b, 0x42, 0x5a, 0x58, 0x4f, 0x51, 0x57,
+      0x45, 0x4f, 0x50, 0x49, 0x55, 0x41, 0x58, 0x51, 0x57, 0x45, 0x4f, 0x49,
+      0x55, 0x3b, 0x20, 0x6d, 0x61, 0x78, 0x2d, 0x61, 0x67, 0x65, 0x3d, 0x33,
+      0x36, 0x30, 0x30, 0x3b, 0x20, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e,
+      0x3d, 0x31>();
+  // clang-format on
+  HpackDecoder decoder;
+
+  // Responses have no :path.
+  EXPECT_EQ(decoder.ParseRequestHeaders(kResponse1).status(),
+            Status::NotFound());
+  EXPECT_EQ(decoder.table().max_size(), 256u);
+  EXPECT_EQ(decoder.table().size(), 222u);
+  ExpectField(decoder.table(), 0, "location", "https://www.example.com");
+  ExpectField(decoder.table(), 3, ":status", "302");
+
+  EXPECT_EQ(decoder.ParseRequestHeaders(kResponse2).status(),
+            Status::NotFound());
+  EXPECT_EQ(decoder.table().size(), 222u);
+  ASSERT_EQ(decoder.table().num_fields(), 4u);
+  ExpectField(decoder.table(), 0, ":status", "307");
+  ExpectField(decoder.table(), 3, "cache-control", "private");
+
+  EXPECT_EQ(decoder.ParseRequestHeaders(kResponse3).status(),
+            Status::NotFound());
+  EXPECT_EQ(decoder.table().size(), 215u);
+  ASSERT_EQ(decoder.table().num_fields(), 3u);
+  ExpectField(decoder.table(),
+              0,
+              "set-cookie",
+              "foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1");
+  ExpectField(decoder.table(), 1, "content-encoding", "gzip");
+  ExpectField(decoder.table(), 2, "date", "Mon, 21 Oct 2013 20:13:22 GMT");
+}
+
+TEST(HpackTest, HpackDecoderGrpcGoRequests) {
+  // clang-format off
+  const auto kFirstRequest = bytes::Array<
+      0x83, 0x86, 0x45, 0x9b, 0x62, 0xbf, 0x0b, 0xcd, 0x65, 0x64, 0x5c, 0xbe,
+      0x47, 0x4d, 0x74, 0x15, 0x0b, 0x94, 0x93, 0x9d, 0x7c, 0x04, 0x9c, 0xec,
+      0x70, 0xa8, 0x76, 0x7a, 0xc0, 0x49, 0xcf, 0x41, 0x8a, 0xa0, 0xe4, 0x1d,
+      0x13, 0x9d, 0x09, 0xb8, 0xcb, 0x40, 0x07, 0x5f, 0x8b, 0x1d, 0x75, 0xd0,
+      0x62, 0x0d, 0x26, 0x3d, 0x4c, 0x4d, 0x65, 0x64, 0x7a, 0x8a, 0x9a, 0xca,
+      0xc8, 0xb4, 0xc7, 0x60, 0x2b, 0xb8, 0x05, 0xc3, 0x40, 0x02, 0x74, 0x65,
+      0x86, 0x4d, 0x83, 0x35, 0x05, 0xb1, 0x1f, 0x40, 0x89, 0x9a, 0xca, 0xc8,
+      0xb2, 0x4d, 0x49, 0x4f, 0x6a, 0x7f, 0x84, 0x7d, 0xf7, 0xdf, 0xa7>();
+  const auto kNextRequest = bytes::Array<
+      0x83, 0x86, 0xc3, 0xc2, 0xc1, 0xc0, 0xbf, 0xbe>();
+  // clang-format on
+  HpackDecoder decoder;
+
+  for (ConstByteSpan request : {ConstByteSpan(kFirstRequest),
+                                ConstByteSpan(kNextRequest),
+                                ConstByteSpan(kNextRequest)}) {
+    auto result = decoder.ParseRequestHeaders(request);
+    ASSERT_EQ(result.status(), OkStatus());
+    EXPECT_EQ(*result, "/pw.grpc.examples.echo.Echo/UnaryEcho");
+  }
+  EXPECT_EQ(decoder.table().num_fields(), 6u);
+}
+
+TEST(HpackTest, HpackDecoderIndexOutOfRange) {
+  HpackDecoder decoder;
+  EXPECT_EQ(decoder.ParseRequestHeaders(bytes::Array<0xbe>()).status(),
+            Status::InvalidArgument());
+  EXPECT_EQ(decoder.ParseRequestHeaders(bytes::Array<0x80>()).status(),
+            Status::InvalidArgument());
+}
+
+TEST(HpackTest, HpackDecoderSizeUpdateAfterField) {
+  HpackDecoder decoder;
+  EXPECT_EQ(decoder.ParseRequestHeaders(bytes::Array<0x84, 0x20>()).status(),
+            Status::InvalidArgument());
+}
+
+TEST(HpackTest, HpackDecoderSizeUpdateTooLarge) {
+  // 4097 = 31 + 4066, which is 0x7e2 in base 128.
+  HpackDecoder decoder;
+  EXPECT_EQ(decoder.ParseRequestHeaders(bytes::Array<0x3f, 0xe2, 0x1f>())
+                .status(),
+            Status::InvalidArgument());
+}
+
+TEST(HpackTest, HpackDecoderPathTooLong) {
+  HpackDecoder decoder;
+  std::array<std::byte, 3 + 128> block;
+  block[0] = std::byte{0x44};  // :path, with incremental indexing
+  block[1] = std::byte{0x7f};  // length 127 + 1
+  block[2] = std::byte{0x01};
+  std::fill(block.begin() + 3, block.end(), std::byte{'a'});
+
+  EXPECT_EQ(decoder.ParseRequestHeaders(block).status(), Status::OutOfRange());
+  EXPECT_EQ(decoder.table().num_fields(), 1u);
+}
+
+TEST(HpackTest, HpackDecoderFieldLargerThanTable) {
+  HpackDecoder decoder;
+  ASSERT_EQ(decoder.ParseRequestHeaders(bytes::Array<0x44, 0x01, '/'>())
+                .status(),
+            OkStatus());
+  ASSERT_EQ(decoder.table().num_fields(), 1u);
+
+  // A literal name and a 5000 byte value, with incremental indexing. 5000 is
+  // 127 + 4873, and 4873 is 0x26 0x09 in base 128.
+  std::array<std::byte, 6 + 5000> input;
+  constexpr auto kPrefix = bytes::Array<0x40, 0x01, 'x', 0x7f, 0x89, 0x26>();
+  std::copy(kPrefix.begin(), kPrefix.end(), input.begin());
+  std::fill(input.begin() + kPrefix.size(), input.end(), std::byte{'a'});
+
+  EXPECT_EQ(decoder.ParseRequestHeaders(input).status(), Status::NotFound());
+  EXPECT_EQ(decoder.table().num_fields(), 0u);
+  EXPECT_EQ(decoder.table().size(), 0u);
+}
+
+TEST(HpackTest, HpackDynamicTableCompactsBuffer) {
+  internal::InlineHpackDynamicTable<128> table;
+  constexpr std::string_view kValues[] = {"0123456789", "abcdefghij", "ABCDE"};
+  for (size_t i = 0; i < 20; ++i) {
+    const std::string_view value = kValues[i % 3];
+    table.Add("name", value);
+    // Only two fields fit in the table.
+    ASSERT_LE(table.num_fields(), 2u);
+    ExpectField(table, 0, "name", value);
+    if (i > 0) {
+      ExpectField(table, 1, "name", kValues[(i - 1) % 3]);
+    }
+  }
+}
+
+TEST(HpackTest, HpackDynamicTableSetMaxSizeEvicts) {
+  internal::InlineHpackDynamicTable<128> table;
+  table.Add("a", "1");
+  table.Add("b", "2");
+  EXPECT_EQ(table.size(), 68u);
+  table.SetMaxSize(40);
+  EXPECT_EQ(table.size(), 34u);
+  ExpectField(table, 0, "b", "2");
+  table.SetMaxSize(0);
+  EXPECT_EQ(table.num_fields(), 0u);
+}
+
+// Encodes a block, checks it against `expected`, and decodes it.
+void TestEncode(HpackEncoder& encoder,
+                HpackDecoder& decoder,
+                span<const HpackField> fields,
+                ConstByteSpan expected) {
+  ByteBuffer<64> block;
+  ASSERT_EQ(encoder.Encode(fields, block), OkStatus());
+  ExpectBytes(block, expected);
+
+  EXPECT_EQ(decoder.ParseRequestHeaders(block).status(), Status::NotFound());
+  ASSERT_EQ(decoder.table().num_fields(), encoder.table().num_fields());
+  for (size_t i = 0; i < encoder.table().num_fields(); ++i) {
+    ExpectField(decoder.table(),
+                i,
+                encoder.table()[i].name,
+                encoder.table()[i].value);
+  }
+}
+
+constexpr HpackField kResponseHeaders[] = {
+    {":status", "200"},
+    {"content-type", "application/grpc"},
+};
+
+TEST(HpackTest, HpackEncoderIndexesRepeatedFields) {
+  HpackEncoder encoder;
+  HpackDecoder decoder;
+  // clang-format off
+  TestEncode(encoder, decoder, kResponseHeaders, bytes::Array<
+      // Dynamic table size update to 256.
+      0x3f, 0xe1, 0x01,
+      // :status: 200, from the static table.
+      0x88,
+      // content-type: application/grpc, with incremental indexing.
+      0x5f, 0x8b, 0x1d, 0x75, 0xd0, 0x62, 0x0d, 0x26, 0x3d, 0x4c, 0x4d, 0x65,
+      0x64>());
+  // clang-format on
+  TestEncode(encoder, decoder, kResponseHeaders, bytes::Array<0x88, 0xbe>());
+
+  const HpackField kTrailers[] = {{"grpc-status", "0"}};
+  // clang-format off
+  TestEncode(encoder, decoder, kTrailers, bytes::Array<
+      // grpc-status: 0, with incremental indexing.
+      0x40, 0x88, 0x9a, 0xca, 0xc8, 0xb2, 0x12, 0x34, 0xda, 0x8f, 0x01,
+      0x30>());
+  // clang-format on
+  TestEncode(encoder, decoder, kTrailers, bytes::Array<0xbe>());
+  TestEncode(encoder, decoder, kResponseHeaders, bytes::Array<0x88, 0xbf>());
+
+  const HpackField kOtherTrailers[] = {{"grpc-status", "5"}};
+  // grpc-status: 5, with the name from the dynamic table.
+  TestEncode(encoder,
+             decoder,
+             kOtherTrailers,
+             bytes::Array<0x7e, 0x01, 0x35>());
+}
+
+TEST(HpackTest, HpackEncoderHonorsPeerMaxTableSize) {
+  HpackEncoder encoder;
+  HpackDecoder decoder;
+  encoder.SetPeerMaxTableSize(0);
+  // clang-format off
+  TestEncode(encoder, decoder, kResponseHeaders, bytes::Array<
+      // Dynamic table size update to 0.
+      0x20,
+      0x88,
+      // content-type: application/grpc, without indexing.
+      0x0f, 0x10, 0x8b, 0x1d, 0x75, 0xd0, 0x62, 0x0d, 0x26, 0x3d, 0x4c, 0x4d,
+      0x65, 0x64>());
+  // clang-format on
+  EXPECT_EQ(encoder.table().num_fields(), 0u);
+}
+
+TEST(HpackTest, HpackEncoderSignalsSmallestMaxTableSize) {
+  HpackEncoder encoder;
+  HpackDecoder decoder;
+  const HpackField kStatus[] = {{":status", "200"}};
+  TestEncode(
+      encoder, decoder, kStatus, bytes::Array<0x3f, 0xe1, 0x01, 0x88>());
+
+  // Reducing and then increasing the size signals both sizes.
+  encoder.SetPeerMaxTableSize(64);
+  encoder.SetPeerMaxTableSize(4096);
+  TestEncode(encoder,
+             decoder,
+             kStatus,
+             bytes::Array<0x3f, 0x21, 0x3f, 0xe1, 0x01, 0x88>());
+  EXPECT_EQ(encoder.table().max_size(), 256u);
+}
+
+TEST(HpackTest, HpackEncoderBufferTooSmall) {
+  HpackEncoder encoder;
+  ByteBuffer<8> block;
+  EXPECT_EQ(encoder.Encode(kResponseHeaders, block),
+            Status::ResourceExhausted());
+}
+
 }  // namespace
 }  // namespace pw::grpc
@@ -26,6 +26,7 @@
 #include "pw_containers/dynamic_queue.h"
 #include "pw_function/function.h"
 #include "pw_grpc/default_send_queue.h"
+#include "pw_grpc/internal/hpack.h"
 #include "pw_grpc/send_queue.h"
 #include "pw_result/result.h"
 #include "pw_status/status.h"
@@ -200,6 +201,8 @@ class Connection {
   // * NOT_FOUND if stream_id does not reference an active stream, including
   //   RPCs that have already completed, or if stream_id does not refer to any
   //   prior RPC.
+  // * RESOURCE_EXHAUSTED if no send buffer could be allocated. The RPC is not
+  //   completed, so this may be retried.
   // * UNAVAILABLE if the connection is closed.
   Status SendResponseComplete(StreamId stream_id, pw::Status response_code) {
     return writer_.SendResponseComplete(stream_id, response_code);
@@ -281,6 +284,11 @@ class Connection {
     pw::sync::ThreadNotification window_notification;
     bool is_waiting_for_window = false;
 
+    // Set while a response message is waiting for send window: the order in
+    // which the stream started waiting, and the size of the message.
+    std::optional<uint32_t> window_ticket;
+    uint32_t waiting_message_size = 0;
+
     void SignalWindowAvailable() {
       if (is_waiting_for_window) {
         is_waiting_for_window = false;
@@ -299,6 +307,8 @@ class Connection {
       assembly_buffer = nullptr;
       assembly = {};
 
+      window_ticket.reset();
+      waiting_message_size = 0;
       SignalWindowAvailable();
     }
   };
@@ -333,6 +343,18 @@ class Connection {
 
     void ForAllStreams(Function<void(Stream*)>&& callback);
 
+    // Streams waiting for send window use the connection window in the order
+    // they started waiting, so that a busy stream cannot starve the others.
+    // Returns true if no stream that started waiting before `stream` is ready
+    // to send.
+    bool IsNextForConnectionWindow(const Stream& stream) const;
+    // Marks `stream` as waiting to send a `message_size` byte message.
+    void WaitForWindow(Stream& stream, size_t message_size);
+    // Ends the wait of `stream`, and wakes the other waiting streams to check
+    // whether they are next.
+    void FinishWaitForWindow(Stream& stream);
+    void SignalWindowWaiters();
+
     // Queue response buffer for sending on `id` stream. Will send right away if
     // window is available.
     Status QueueStreamResponse(StreamId id, DataFrame&& data_frame);
@@ -340,12 +362,16 @@ class Connection {
     // Write raw bytes directly to send queue.
     Status SendBytes(ConstByteSpan message);
 
-    // Construct and write header message directly to send queue.
+    // Encode and write header message directly to send queue.
     Status SendHeaders(StreamId stream_id,
-                       ConstByteSpan payload1,
-                       ConstByteSpan payload2,
+                       span<const internal::HpackField> fields,
                        bool end_stream);
 
+    // Apply the client's SETTINGS_HEADER_TABLE_SIZE to response headers.
+    void SetHeaderTableSize(uint32_t size) {
+      hpack_encoder_.SetPeerMaxTableSize(size);
+    }
+
     // Frame send functions.
     Status SendRstStream(StreamId stream_id, internal::Http2Error code);
     Status SendWindowUpdates(Stream* stream,
@@ -385,6 +411,7 @@ class Connection {
     int32_t connection_send_window_ = kDefaultInitialWindowSize;
     int32_t connection_recv_window_ = kTargetConnectionWindowSize;
     bool connection_closed_ = false;
+    uint32_t next_window_ticket_ = 0;
 
     // Allocator for fragmented grpc message reassembly
     Allocator* message_assembly_allocator_;
@@ -393,6 +420,10 @@ class Connection {
     Allocator& send_allocator_;
 
     SendQueue& send_queue_;
+
+    // Compression state for response headers. Header blocks are encoded and
+    // queued while the state is locked, so they are sent in encoded order.
+    internal::HpackEncoder hpack_encoder_;
   };
 
   class Writer {
@@ -425,6 +456,9 @@ class Connection {
     Status ProcessDataFramePayload(const internal::FrameHeader& frame,
                                    ByteSpan payload);
     Status ProcessHeadersFrame(const internal::FrameHeader&);
+    Status ReadHeaderBlock(
+        const internal::FrameHeader&,
+        Result<InlineString<kMaxMethodNameSize>>& method_name);
     Status ProcessRstStreamFrame(const internal::FrameHeader&);
     Status ProcessSettingsFrame(const internal::FrameHeader&, bool send_ack);
     Status ProcessPingFrame(const internal::FrameHeader&);
@@ -446,6 +480,9 @@ class Connection {
 
     std::array<std::byte, internal::kMaxFramePayloadSize> payload_scratch_{};
     StreamId last_stream_id_ = 0;
+
+    // Compression state for request headers.
+    internal::HpackDecoder hpack_decoder_;
   };
 
   Status HandleReadError(Status status) {
@@ -20,6 +20,7 @@
 #include "pw_containers/dynamic_deque.h"
 #include "pw_function/function.h"
 #include "pw_grpc/send_queue.h"
+#include "pw_span/span.h"
 #include "pw_status/status.h"
 #include "pw_stream/stream.h"
 #include "pw_sync/lock_annotations.h"
@@ -34,10 +35,25 @@ namespace pw::grpc {
 // send.
 class DefaultSendQueue : public SendQueue {
  public:
+  // How the send thread writes queued buffers to the socket.
+  enum class WriteMode {
+    // Each buffer is written with its own call to Write.
+    kEach,
+    // The buffers queued while the send thread is busy are written together,
+    // up to kMaxBatchSize at a time, with one call to WriteV.
+    kBatched,
+  };
+
+  // Most buffers taken from the queue while it is locked, and written with
+  // one call to WriteV, in WriteMode::kBatched.
+  static constexpr size_t kMaxBatchSize = 16;
+
   template <typename LockType>
   DefaultSendQueue(stream::ReaderWriter& socket,
-                   allocator::SynchronizedAllocator<LockType>& allocator)
-      : DefaultSendQueue(socket, static_cast<Allocator&>(allocator)) {}
+                   allocator::SynchronizedAllocator<LockType>& allocator,
+                   WriteMode write_mode = WriteMode::kEach)
+      : DefaultSendQueue(
+            socket, static_cast<Allocator&>(allocator), write_mode) {}
 
   // Thread safe. Queues buffer to be sent on send thread. Returns false if
   // there was no queue space available from allocator.
@@ -55,18 +71,33 @@ class DefaultSendQueue : public SendQueue {
       PW_LOCKS_EXCLUDED(send_mutex_);
 
  private:
-  DefaultSendQueue(stream::ReaderWriter& socket, Allocator& allocator)
+  DefaultSendQueue(stream::ReaderWriter& socket,
+                   Allocator& allocator,
+                   WriteMode write_mode)
       : socket_(socket),
+        write_mode_(write_mode),
         send_task_(pw::bind_member<&DefaultSendQueue::ProcessSendQueue>(this)),
         queue_(allocator) {}
 
   void ProcessSendQueue(async::Context& context, Status status)
       PW_LOCKS_EXCLUDED(send_mutex_);
 
+  // Write queued buffers until the queue is empty, one at a time or in
+  // batches.
+  Status SendEach() PW_LOCKS_EXCLUDED(send_mutex_);
+  Status SendBatches() PW_LOCKS_EXCLUDED(send_mutex_);
+
   UniquePtr<std::byte[]> PopNext() PW_LOCKS_EXCLUDED(send_mutex_);
+
+  // Moves up to batch.size() buffers from the queue into `batch`, and returns
+  // how many were moved.
+  size_t PopBatch(span<UniquePtr<std::byte[]>> batch)
+      PW_LOCKS_EXCLUDED(send_mutex_);
+
   void NotifyOnError(Status status) PW_LOCKS_EXCLUDED(send_mutex_);
 
   stream::ReaderWriter& socket_;
+  const WriteMode write_mode_;
   async::BasicDispatcher send_dispatcher_;
   async::Task send_task_;
   ErrorHandler on_error_;
@@ -0,0 +1,198 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "pw_bytes/byte_builder.h"
+#include "pw_bytes/span.h"
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_string/string.h"
+
+namespace pw::grpc::internal {
+
+// Maximum size of a string that can be returned by the HPACK decoder.
+inline constexpr uint32_t kHpackMaxStringSize = 127;
+
+// Size of the HPACK dynamic table used to decode request headers, which we
+// advertise with SETTINGS_HEADER_TABLE_SIZE. This is the protocol default, so
+// that requests sent before the client has seen our SETTINGS are decoded with
+// the same table size that the client used to encode them.
+inline constexpr uint32_t kHpackDecoderTableSize = 4096;
+
+// Size of the HPACK dynamic table used to encode response headers. Responses
+// use only a few distinct header fields, which fit in a small table.
+inline constexpr uint32_t kHpackEncoderTableSize = 256;
+
+// RFC 7541 §4.1: The size of an entry is the sum of its name's length in
+// octets, its value's length in octets, and 32.
+inline constexpr size_t kHpackEntryOverhead = 32;
+
+// A header field: a name-value pair.
+struct HpackField {
+  std::string_view name;
+  std::string_view value;
+};
+
+// An HPACK dynamic table (RFC 7541 §2.3.2 and §4), which is a FIFO of header
+// fields. Names and values are stored in a fixed buffer, which is compacted
+// when a new field does not fit after the newest field.
+class HpackDynamicTable {
+ public:
+  HpackDynamicTable(const HpackDynamicTable&) = delete;
+  HpackDynamicTable& operator=(const HpackDynamicTable&) = delete;
+
+  // Largest max_size() the table can be set to.
+  size_t capacity() const { return buffer_.size(); }
+
+  // RFC 7541 §4.1: The sum of the size of the table's entries.
+  size_t size() const { return size_; }
+
+  // RFC 7541 §4.2: The maximum size of the table.
+  size_t max_size() const { return max_size_; }
+
+  size_t num_fields() const { return num_fields_; }
+
+  // Returns the field at `index`, where 0 is the newest field. The field
+  // refers to the table's buffer, and is invalidated when a field is added.
+  // `index` must be less than num_fields().
+  HpackField operator[](size_t index) const;
+
+  // RFC 7541 §4.3: Sets the maximum size, evicting fields until the size of
+  // the table is within it. `max_size` must not exceed capacity().
+  void SetMaxSize(size_t max_size);
+
+  // RFC 7541 §4.4: Adds a field, evicting the oldest fields until it fits. A
+  // field larger than max_size() empties the table. `name` and `value` must
+  // not refer to the table's buffer.
+  void Add(std::string_view name, std::string_view value);
+
+  void Clear();
+
+ protected:
+  struct Entry {
+    uint16_t offset;
+    uint16_t name_size;
+    uint16_t value_size;
+  };
+
+  // Returns the most entries that a table with `capacity` can hold.
+  static constexpr size_t MaxEntries(size_t capacity) {
+    return capacity < kHpackEntryOverhead ? 1
+                                          : capacity / kHpackEntryOverhead;
+  }
+
+  HpackDynamicTable(span<char> buffer, span<Entry> entries)
+      : buffer_(buffer), entries_(entries), max_size_(buffer.size()) {}
+
+ private:
+  void EvictOldest();
+
+  span<char> buffer_;
+  span<Entry> entries_;
+
+  // Fields are in entries_[first_] through entries_[first_ + num_fields_ - 1],
+  // modulo the size of entries_, from oldest to newest. Their names and values
+  // are stored in buffer_[begin_] through buffer_[end_ - 1].
+  size_t first_ = 0;
+  size_t num_fields_ = 0;
+  size_t begin_ = 0;
+  size_t end_ = 0;
+
+  size_t size_ = 0;
+  size_t max_size_;
+};
+
+// An HpackDynamicTable with an inline buffer of `kCapacity` bytes.
+template <size_t kCapacity>
+class InlineHpackDynamicTable : public HpackDynamicTable {
+ public:
+  static_assert(kCapacity <= UINT16_MAX);
+
+  InlineHpackDynamicTable() : HpackDynamicTable(buffer_, entries_) {}
+
+ private:
+  std::array<char, kCapacity> buffer_;
+  std::array<Entry, MaxEntries(kCapacity)> entries_;
+};
+
+// Decodes the request header blocks of a connection (RFC 7541 §3), which
+// share a dynamic table.
+class HpackDecoder {
+ public:
+  HpackDecoder() = default;
+
+  // Decodes a request header block, returning the grpc method name from the
+  // :path field. Every field is decoded, to keep the dynamic table in sync
+  // with the encoder's.
+  //
+  // Returns:
+  // * NOT_FOUND if the block has no :path field.
+  // * OUT_OF_RANGE if the :path is longer than kHpackMaxStringSize.
+  // * INVALID_ARGUMENT if the block is malformed. The dynamic table may no
+  //   longer match the encoder's, which is a connection error of type
+  //   COMPRESSION_ERROR (RFC 9113 §4.3).
+  Result<InlineString<kHpackMaxStringSize>> ParseRequestHeaders(
+      ConstByteSpan block);
+
+  const HpackDynamicTable& table() const { return table_; }
+
+ private:
+  // Returns the field at a static or dynamic table index (RFC 7541 §2.3.3).
+  Result<HpackField> Lookup(uint32_t index) const;
+
+  InlineHpackDynamicTable<kHpackDecoderTableSize> table_;
+
+  // Storage for a decoded name and value. A field that does not fit would
+  // not fit in the table either.
+  std::array<char, kHpackDecoderTableSize> scratch_;
+};
+
+// Encodes the response header blocks of a connection (RFC 7541 §3), which
+// share a dynamic table. Repeated fields are indexed, so after the first
+// response most fields are encoded in a single byte.
+class HpackEncoder {
+ public:
+  HpackEncoder();
+
+  // Applies the client's SETTINGS_HEADER_TABLE_SIZE, which limits the size of
+  // the dynamic table. The change is signaled at the start of the next block.
+  void SetPeerMaxTableSize(uint32_t max_size);
+
+  // Encodes `fields` as a header block. Blocks must be sent in the order they
+  // are encoded.
+  //
+  // Returns RESOURCE_EXHAUSTED if `out` is too small, after which the
+  // dynamic table may no longer match the decoder's.
+  Status Encode(span<const HpackField> fields, ByteBuilder& out);
+
+  const HpackDynamicTable& table() const { return table_; }
+
+ private:
+  void EncodeField(const HpackField& field, ByteBuilder& out);
+
+  InlineHpackDynamicTable<kHpackEncoderTableSize> table_;
+
+  // RFC 7541 §4.2: The smallest maximum size since the last block, which must
+  // be signaled if it is smaller than the final maximum size.
+  size_t min_max_size_;
+  bool max_size_changed_ = true;
+};
+
+}  // namespace pw::grpc::internal
@@ -15,41 +15,63 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
+#include <string_view>
 
+#include "pw_bytes/byte_builder.h"
 #include "pw_bytes/span.h"
+#include "pw_grpc/internal/hpack.h"
 #include "pw_result/result.h"
+#include "pw_span/span.h"
 #include "pw_string/string.h"
 
 namespace pw::grpc {
 
-// We disable the HPACK dynamic header table.
-inline constexpr uint32_t kHpackDynamicHeaderTableSize = 0;
-
-// Maximum size of a string that can be returned by this API.
-inline constexpr uint32_t kHpackMaxStringSize = 127;
-
-// Parses a request header field block, returning the grpc method name.
-Result<InlineString<kHpackMaxStringSize>> HpackParseRequestHeaders(
-    ConstByteSpan payload);
+using internal::HpackDecoder;
+using internal::HpackDynamicTable;
+using internal::HpackEncoder;
+using internal::HpackField;
+using internal::kHpackMaxStringSize;
 
 // Decodes an HPACK unsigned integer.
 // Consumed bytes are removed from the `input` span.
 Result<uint32_t> HpackIntegerDecode(ConstByteSpan& input,
                                     uint8_t bits_in_first_byte);
 
+// Encodes an HPACK unsigned integer. The bits of `first_byte` above the
+// prefix hold the representation's pattern.
+void HpackIntegerEncode(uint32_t value,
+                        uint8_t bits_in_first_byte,
+                        uint8_t first_byte,
+                        ByteBuilder& out);
+
+// Decodes an HPACK string into `buffer`, returning a view of it.
+// Consumed bytes are removed from the `input` span, even if the string does
+// not fit in `buffer`, in which case OUT_OF_RANGE is returned.
+Result<std::string_view> HpackStringDecode(ConstByteSpan& input,
+                                           span<char> buffer);
+
 // Decodes an HPACK string.
 // Consumed bytes are removed from the `input` span.
 Result<InlineString<kHpackMaxStringSize>> HpackStringDecode(
     ConstByteSpan& input);
 
+// Encodes an HPACK string, Huffman-encoded if that is shorter.
+void HpackStringEncode(std::string_view value, ByteBuilder& out);
+
+// Decodes a Huffman-encoded string into `buffer`, returning a view of it.
+Result<std::string_view> HpackHuffmanDecode(ConstByteSpan input,
+                                            span<char> buffer);
+
 // Decodes a Huffman-encoded string.
 Result<InlineString<kHpackMaxStringSize>> HpackHuffmanDecode(
     ConstByteSpan input);
 
-// Returns a HEADERS payload to use for grpc Response-Headers.
-ConstByteSpan ResponseHeadersPayload();
+// Returns the size of the Huffman encoding of `value`, or std::nullopt if
+// `value` contains an unprintable character.
+std::optional<size_t> HpackHuffmanEncodedSize(std::string_view value);
 
-// Returns a HEADERS payload to use for grpc Trailers.
-ConstByteSpan ResponseTrailersPayload(Status response_code);
+// Huffman-encodes `value`, which must not contain unprintable characters.
+void HpackHuffmanEncode(std::string_view value, ByteBuilder& out);
 
 }  // namespace pw::grpc
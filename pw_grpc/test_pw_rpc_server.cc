@@ -19,6 +19,7 @@
 #include <type_traits>
 
 #include "pw_allocator/best_fit.h"
+#include "pw_allocator/bucket_allocator.h"
 #include "pw_allocator/libc_allocator.h"
 #include "pw_allocator/synchronized_allocator.h"
 #include "pw_async_basic/dispatcher.h"
@@ -209,7 +210,9 @@ class ConnectionThread : public pw::grpc::Connection,
                              /*read_allocator=*/read_allocator,
                              &read_dispatcher_),
         send_queue_thread_options_(send_thread_options),
-        send_queue_(stream, send_allocator) {}
+        send_queue_(stream,
+                    send_allocator,
+                    pw::grpc::DefaultSendQueue::WriteMode::kBatched) {}
 
   // Process the connection. Does not return until the connection is closed.
   void Run() override {
@@ -306,7 +309,9 @@ int main(int argc, char* argv[]) {
         raw_read_allocator);
 
     std::array<std::byte, kMaxSendQueueSize> send_allocator_data;
-    pw::allocator::BestFitAllocator<> raw_send_allocator(send_allocator_data);
+    // Response frames are allocated and freed at a high rate, and a bucket
+    // allocator reuses freed frames of the same size.
+    pw::allocator::BucketAllocator<> raw_send_allocator(send_allocator_data);
     pw::allocator::SynchronizedAllocator<pw::sync::Mutex> send_allocator(
         raw_send_allocator);
     pw::thread::test::TestThreadContext connection_thread_context;
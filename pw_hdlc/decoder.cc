@@ -101,6 +101,46 @@ Result<Frame> Decoder::Process(const byte new_byte) {
   PW_CRASH("Bad decoder state");
 }
 
+Result<Frame> Decoder::ProcessUntilFrame(ConstByteSpan& data) {
+  while (!data.empty()) {
+    if (state_ == State::kFrame) {
+      const auto run_end =
+          std::find_if(data.begin(), data.end(), [](byte b) {
+            return b == kFlag || b == kEscape;
+          });
+      const auto run_size = static_cast<size_t>(run_end - data.begin());
+
+      if (current_frame_size_ == 0u && run_end != data.end() &&
+          *run_end == kFlag) {
+        // The whole frame is in data and has no escapes, so check it where it
+        // is rather than copying it into the buffer.
+        const ConstByteSpan frame = data.first(run_size);
+        data = data.subspan(run_size + 1);
+        if (frame.empty()) {
+          continue;  // Repeated flag characters are okay.
+        }
+        if (Status status = CheckFrameInPlace(frame); !status.ok()) {
+          return status;
+        }
+        return Frame::Parse(frame);
+      }
+
+      AppendBytes(data.first(run_size));
+      data = data.subspan(run_size);
+      if (data.empty()) {
+        break;
+      }
+    }
+
+    Result<Frame> result = Process(data.front());
+    data = data.subspan(1);
+    if (!result.status().IsUnavailable()) {
+      return result;
+    }
+  }
+  return Status::Unavailable();
+}
+
 void Decoder::AppendByte(byte new_byte) {
   if (current_frame_size_ < max_size()) {
     buffer_[current_frame_size_] = new_byte;
@@ -119,6 +159,37 @@ void Decoder::AppendByte(byte new_byte) {
   current_frame_size_ += 1;
 }
 
+void Decoder::AppendBytes(ConstByteSpan data) {
+  if (data.size() < last_read_bytes_.size()) {
+    for (byte b : data) {
+      AppendByte(b);
+    }
+    return;
+  }
+
+  if (current_frame_size_ < max_size()) {
+    const size_t to_copy =
+        std::min(data.size(), max_size() - current_frame_size_);
+    std::memcpy(&buffer_[current_frame_size_], data.data(), to_copy);
+  }
+
+  // Every byte held in the ring buffer is ejected, oldest first, followed by
+  // all but the last four new bytes.
+  const size_t held = std::min(current_frame_size_, last_read_bytes_.size());
+  size_t index = (last_read_bytes_index_ + last_read_bytes_.size() - held) %
+                 last_read_bytes_.size();
+  for (size_t i = 0; i < held; ++i) {
+    fcs_.Update(last_read_bytes_[index]);
+    index = (index + 1) % last_read_bytes_.size();
+  }
+  const size_t ejected = data.size() - last_read_bytes_.size();
+  fcs_.Update(data.first(ejected));
+  std::copy(data.begin() + ejected, data.end(), last_read_bytes_.begin());
+  last_read_bytes_index_ = 0;
+
+  current_frame_size_ += data.size();
+}
+
 Status Decoder::CheckFrame() const {
   // Empty frames are not an error; repeated flag characters are okay.
   if (current_frame_size_ == 0u) {
@@ -146,6 +217,30 @@ Status Decoder::CheckFrame() const {
   return OkStatus();
 }
 
+Status Decoder::CheckFrameInPlace(ConstByteSpan frame) const {
+  if (frame.size() < Frame::kMinContentSizeBytes) {
+    PW_LOG_ERROR("Received %lu-byte frame; frame must be at least 6 bytes",
+                 static_cast<unsigned long>(frame.size()));
+    return Status::DataLoss();
+  }
+
+  const size_t fcs_offset = frame.size() - kFcsSize;
+  const uint32_t actual_fcs = bytes::ReadInOrder<uint32_t>(
+      endian::little, frame.subspan(fcs_offset).data());
+  if (actual_fcs != checksum::Crc32::Calculate(frame.first(fcs_offset))) {
+    PW_LOG_ERROR("Frame check sequence verification failed");
+    return Status::DataLoss();
+  }
+
+  // Report frames that would not have fit in the buffer consistently with
+  // frames that are decoded into it.
+  if (frame.size() > max_size()) {
+    return Status::ResourceExhausted();
+  }
+
+  return OkStatus();
+}
+
 bool Decoder::VerifyFrameCheckSequence() const {
   // De-ring the last four bytes read, which at this point contain the FCS.
   std::array<std::byte, sizeof(uint32_t)> fcs_buffer;
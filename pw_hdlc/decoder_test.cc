@@ -19,7 +19,9 @@
 
 #include "pw_bytes/array.h"
 #include "pw_fuzzer/fuzztest.h"
+#include "pw_hdlc/encoder.h"
 #include "pw_hdlc/internal/protocol.h"
+#include "pw_stream/memory_stream.h"
 #include "pw_unit_test/framework.h"
 
 namespace pw::hdlc {
@@ -154,6 +156,81 @@ TEST(Decoder, TooLargeForBuffer_DecodesNextFrame) {
   EXPECT_EQ(OkStatus(), decoder.Process(kFlag).status());
 }
 
+TEST(Decoder, ProcessUntilFrame_DecodesUnescapedFrameInPlace) {
+  DecoderBuffer<8> decoder;
+  constexpr auto kData = bytes::String("~1234\xa3\xe0\xe3\x9b~");
+
+  ConstByteSpan remaining = kData;
+  auto result = decoder.ProcessUntilFrame(remaining);
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_TRUE(remaining.empty());
+
+  // The frame refers to the input rather than the decoder's buffer.
+  EXPECT_EQ(result.value().address(), static_cast<uint64_t>('1') >> 1);
+  EXPECT_EQ(result.value().data().data(), &kData[3]);
+  EXPECT_EQ(result.value().data().size(), 2u);
+}
+
+TEST(Decoder, ProcessUntilFrame_StopsAfterEachFrame) {
+  DecoderBuffer<8> decoder;
+  constexpr auto kData =
+      bytes::String("~1234\xa3\xe0\xe3\x9b~1234\xa3\xe0\xe3\x9b~");
+
+  ConstByteSpan remaining = kData;
+  EXPECT_EQ(OkStatus(), decoder.ProcessUntilFrame(remaining).status());
+  EXPECT_EQ(remaining.size(), 9u);
+  EXPECT_EQ(OkStatus(), decoder.ProcessUntilFrame(remaining).status());
+  EXPECT_TRUE(remaining.empty());
+  EXPECT_EQ(Status::Unavailable(),
+            decoder.ProcessUntilFrame(remaining).status());
+}
+
+// Checks that decoding data in bulk yields the same frames and errors, after
+// the same bytes, as decoding it a byte at a time.
+void ProcessUntilFrameMatchesProcess(ConstByteSpan data) {
+  DecoderBuffer<64> byte_decoder;
+  DecoderBuffer<64> bulk_decoder;
+  ConstByteSpan remaining = data;
+
+  for (size_t i = 0; i < data.size(); ++i) {
+    Result<Frame> expected = byte_decoder.Process(data[i]);
+    if (expected.status().IsUnavailable()) {
+      continue;
+    }
+    Result<Frame> actual = bulk_decoder.ProcessUntilFrame(remaining);
+    ASSERT_EQ(expected.status(), actual.status());
+    ASSERT_EQ(remaining.size(), data.size() - i - 1);
+    if (expected.ok()) {
+      EXPECT_EQ(expected.value().address(), actual.value().address());
+      EXPECT_EQ(expected.value().control(), actual.value().control());
+      ASSERT_EQ(expected.value().data().size(), actual.value().data().size());
+      EXPECT_TRUE(std::equal(expected.value().data().begin(),
+                             expected.value().data().end(),
+                             actual.value().data().begin()));
+    }
+  }
+  EXPECT_EQ(Status::Unavailable(),
+            bulk_decoder.ProcessUntilFrame(remaining).status());
+  EXPECT_TRUE(remaining.empty());
+}
+
+TEST(Decoder, ProcessUntilFrame_MatchesProcess) {
+  std::array<byte, 128> encoded;
+  stream::MemoryWriter writer(encoded);
+  ASSERT_EQ(OkStatus(),
+            WriteUIFrame(123, bytes::String("unescaped payload"), writer));
+  ASSERT_EQ(OkStatus(),
+            WriteUIFrame(0x3e, bytes::Array<0x7e, 0x7d, 0x01, 0x7d>(), writer));
+  ASSERT_EQ(OkStatus(), writer.Write(bytes::String("junk~~")));
+  ASSERT_EQ(OkStatus(), WriteUIFrame(1, ConstByteSpan(), writer));
+
+  ProcessUntilFrameMatchesProcess(writer.WrittenData());
+}
+
+FUZZ_TEST(Decoder, ProcessUntilFrameMatchesProcess)
+    .WithDomains(VectorOf<1024>(ElementOf<byte>(
+        {kFlag, kEscape, byte{0x01}, byte{0x5e}, byte{0x7b}, byte{0xff}})));
+
 void ProcessNeverCrashes(ConstByteSpan data) {
   DecoderBuffer<1024> decoder;
   for (byte b : data) {
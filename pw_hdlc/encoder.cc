@@ -18,6 +18,7 @@
 #include <array>
 #include <cstddef>
 #include <cstring>
+#include <utility>
 
 #include "pw_bytes/endian.h"
 #include "pw_hdlc/encoded_size.h"
@@ -28,6 +29,63 @@ using std::byte;
 
 namespace pw::hdlc {
 
+namespace {
+
+// Collects the pieces of an HDLC frame and writes them with as few WriteV()
+// calls as possible, so that writers which support vectored writes can send a
+// frame with a single system call. The pieces are not copied, so the data
+// they refer to must remain valid until Flush() is called.
+class FrameWriter {
+ public:
+  explicit FrameWriter(stream::Writer& writer) : writer_(writer) {}
+
+  Status Add(ConstByteSpan data) {
+    if (data.empty()) {
+      return OkStatus();
+    }
+    if (count_ == pieces_.size()) {
+      if (Status status = Flush(); !status.ok()) {
+        return status;
+      }
+    }
+    pieces_[count_++] = data;
+    return OkStatus();
+  }
+
+  // Adds data to the frame, escaping flag and escape bytes.
+  Status AddEscaped(ConstByteSpan data) {
+    auto begin = data.begin();
+    while (true) {
+      auto end = std::find_if(begin, data.end(), NeedsEscaping);
+
+      if (Status status = Add(span(begin, end)); !status.ok()) {
+        return status;
+      }
+      if (end == data.end()) {
+        return OkStatus();
+      }
+      if (Status status = Add(*end == kFlag ? ConstByteSpan(kEscapedFlag)
+                                            : ConstByteSpan(kEscapedEscape));
+          !status.ok()) {
+        return status;
+      }
+      begin = end + 1;
+    }
+  }
+
+  Status Flush() {
+    const size_t count = std::exchange(count_, 0);
+    return writer_.WriteV(span(pieces_).first(count));
+  }
+
+ private:
+  stream::Writer& writer_;
+  std::array<ConstByteSpan, 16> pieces_;
+  size_t count_ = 0;
+};
+
+}  // namespace
+
 Status EscapeAndWrite(const byte b, stream::Writer& writer) {
   if (b == kFlag) {
     return writer.Write(kEscapedFlag);
@@ -90,15 +148,39 @@ Status WriteUIFrame(uint64_t address,
     return Status::ResourceExhausted();
   }
 
-  Encoder encoder(writer);
-
-  if (Status status = encoder.StartUnnumberedFrame(address); !status.ok()) {
+  std::array<std::byte, 16> metadata_buffer;
+  size_t metadata_size =
+      varint::Encode(address, metadata_buffer, kAddressFormat);
+  if (metadata_size == 0) {
+    return Status::InvalidArgument();
+  }
+  metadata_buffer[metadata_size++] =
+      UFrameControl::UnnumberedInformation().data();
+  const ConstByteSpan metadata = span(metadata_buffer).first(metadata_size);
+
+  checksum::Crc32 fcs;
+  fcs.Update(metadata);
+  fcs.Update(payload);
+  const auto fcs_bytes = bytes::CopyInOrder(endian::little, fcs.value());
+
+  // Gather the whole frame so that it reaches the writer all at once.
+  FrameWriter frame(writer);
+  if (Status status = frame.Add(span(&kFlag, 1)); !status.ok()) {
+    return status;
+  }
+  if (Status status = frame.AddEscaped(metadata); !status.ok()) {
+    return status;
+  }
+  if (Status status = frame.AddEscaped(payload); !status.ok()) {
+    return status;
+  }
+  if (Status status = frame.AddEscaped(fcs_bytes); !status.ok()) {
     return status;
   }
-  if (Status status = encoder.WriteData(payload); !status.ok()) {
+  if (Status status = frame.Add(span(&kFlag, 1)); !status.ok()) {
     return status;
   }
-  return encoder.FinishFrame();
+  return frame.Flush();
 }
 
 }  // namespace pw::hdlc
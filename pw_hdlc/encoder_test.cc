@@ -194,5 +194,42 @@ TEST(WriteUIFrame, WriterError) {
             WriteUIFrame(kAddress, bytes::Array<0x01>(), writer));
 }
 
+// Counts the calls made to the writer.
+class CountingWriter : public stream::NonSeekableWriter {
+ public:
+  size_t write_calls() const { return write_calls_; }
+  size_t write_v_calls() const { return write_v_calls_; }
+  size_t bytes_written() const { return bytes_written_; }
+
+ private:
+  Status DoWrite(ConstByteSpan data) override {
+    write_calls_ += 1;
+    bytes_written_ += data.size();
+    return OkStatus();
+  }
+
+  Status DoWriteV(span<const ConstByteSpan> data) override {
+    write_v_calls_ += 1;
+    for (ConstByteSpan buffer : data) {
+      bytes_written_ += buffer.size();
+    }
+    return OkStatus();
+  }
+
+  size_t write_calls_ = 0;
+  size_t write_v_calls_ = 0;
+  size_t bytes_written_ = 0;
+};
+
+TEST(WriteUIFrame, WritesFrameWithOneVectoredWrite) {
+  CountingWriter writer;
+  EXPECT_EQ(OkStatus(),
+            WriteUIFrame(kAddress, bytes::Array<0x7E, 0x01, 0x7D>(), writer));
+  EXPECT_EQ(writer.write_calls(), 0u);
+  EXPECT_EQ(writer.write_v_calls(), 1u);
+  // Flags, address, control, 3 payload bytes with 2 escapes, and the FCS.
+  EXPECT_EQ(writer.bytes_written(), 2u + 1u + 1u + 5u + 4u);
+}
+
 }  // namespace
 }  // namespace pw::hdlc
@@ -0,0 +1,106 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_hdlc/multibuf_encoder.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include "pw_assert/check.h"
+#include "pw_bytes/endian.h"
+#include "pw_checksum/crc32.h"
+#include "pw_span/span.h"
+#include "pw_varint/varint.h"
+
+namespace pw::hdlc {
+namespace {
+
+// Escapes data into out, which must be twice as large as data. Returns the
+// number of bytes written.
+size_t EscapeInto(ConstByteSpan data, ByteSpan out) {
+  size_t size = 0;
+  for (std::byte b : data) {
+    if (NeedsEscaping(b)) {
+      out[size++] = kEscape;
+      out[size++] = Escape(b);
+    } else {
+      out[size++] = b;
+    }
+  }
+  return size;
+}
+
+}  // namespace
+
+Status EncodeUIFrame(uint64_t address, multibuf::v2::MultiBuf& frame) {
+  std::array<std::byte, kMaxAddressSize + kControlSize> metadata_buffer;
+  size_t metadata_size =
+      varint::Encode(address, metadata_buffer, kAddressFormat);
+  if (metadata_size == 0) {
+    return Status::InvalidArgument();
+  }
+  metadata_buffer[metadata_size++] =
+      UFrameControl::UnnumberedInformation().data();
+  const ConstByteSpan metadata = span(metadata_buffer).first(metadata_size);
+
+  checksum::Crc32 fcs;
+  fcs.Update(metadata);
+  size_t num_escapes = 0;
+  for (ConstByteSpan chunk : frame.ConstChunks()) {
+    fcs.Update(chunk);
+    num_escapes += static_cast<size_t>(
+        std::count_if(chunk.begin(), chunk.end(), NeedsEscaping));
+  }
+  const auto fcs_bytes = bytes::CopyInOrder(endian::little, fcs.value());
+
+  std::array<std::byte, kMaxUIFrameHeadroom> header;
+  header[0] = kFlag;
+  const size_t header_size =
+      1 + EscapeInto(metadata, span(header).subspan(1));
+
+  std::array<std::byte, kMaxUIFrameTailroom> trailer;
+  size_t trailer_size = EscapeInto(fcs_bytes, trailer);
+  trailer[trailer_size++] = kFlag;
+
+  if (header_size > frame.Headroom() ||
+      num_escapes + trailer_size > frame.Tailroom()) {
+    return Status::ResourceExhausted();
+  }
+
+  if (num_escapes != 0) {
+    // Escape the payload back to front, so that each byte is moved before it
+    // can be overwritten. Bytes before the first escaped byte stay in place.
+    const size_t payload_size = frame.size();
+    PW_CHECK(frame.ClaimTailroom(num_escapes));
+    auto src = frame.begin() + payload_size;
+    auto dst = frame.end();
+    while (num_escapes != 0) {
+      const std::byte b = *--src;
+      if (NeedsEscaping(b)) {
+        *--dst = Escape(b);
+        *--dst = kEscape;
+        --num_escapes;
+      } else {
+        *--dst = b;
+      }
+    }
+  }
+
+  PW_CHECK(frame.PrependHeader(span(header).first(header_size)));
+  PW_CHECK(frame.AppendTrailer(span(trailer).first(trailer_size)));
+  return OkStatus();
+}
+
+}  // namespace pw::hdlc
@@ -0,0 +1,122 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_hdlc/multibuf_encoder.h"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include "pw_allocator/testing.h"
+#include "pw_bytes/array.h"
+#include "pw_hdlc/encoded_size.h"
+#include "pw_hdlc/encoder.h"
+#include "pw_multibuf/v2/headroom.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::hdlc {
+namespace {
+
+using ::pw::multibuf::v2::AllocateWithRoom;
+using ::pw::multibuf::v2::MultiBuf;
+
+constexpr uint64_t kAddress = 0x7B;
+constexpr size_t kMaxPayloadSize = 16;
+
+class EncodeUIFrameTest : public ::testing::Test {
+ protected:
+  // Encodes the payload in place and checks that the result matches the
+  // stream encoder's output.
+  void EncodeAndCompare(uint64_t address, ConstByteSpan payload) {
+    auto mb = AllocateWithRoom(allocator_,
+                               payload.size(),
+                               kMaxUIFrameHeadroom,
+                               kMaxUIFrameTailroom + payload.size());
+    ASSERT_EQ(mb.status(), OkStatus());
+    MultiBuf& frame = **mb;
+    ASSERT_EQ(frame.CopyFrom(payload), payload.size());
+
+    ASSERT_EQ(EncodeUIFrame(address, frame), OkStatus());
+    EXPECT_EQ(frame.NumFragments(), 1u);
+
+    std::array<std::byte, MaxEncodedFrameSize(kMaxPayloadSize)> expected;
+    stream::MemoryWriter writer(expected);
+    ASSERT_EQ(WriteUIFrame(address, payload, writer), OkStatus());
+
+    std::array<std::byte, MaxEncodedFrameSize(kMaxPayloadSize)> actual;
+    ASSERT_EQ(frame.size(), writer.bytes_written());
+    EXPECT_EQ(frame.CopyTo(actual), frame.size());
+    EXPECT_EQ(std::memcmp(actual.data(), expected.data(), frame.size()), 0);
+  }
+
+  allocator::test::AllocatorForTest<1024> allocator_;
+};
+
+TEST_F(EncodeUIFrameTest, EmptyPayload) {
+  EncodeAndCompare(kAddress, ConstByteSpan());
+}
+
+TEST_F(EncodeUIFrameTest, PayloadWithNoEscapes) {
+  EncodeAndCompare(kAddress, bytes::String("hello"));
+}
+
+TEST_F(EncodeUIFrameTest, PayloadWithEscapes) {
+  EncodeAndCompare(kAddress, bytes::Array<0x7e, 0x01, 0x7d, 0x02, 0x7e>());
+}
+
+TEST_F(EncodeUIFrameTest, AddressNeedsEscaping) {
+  EncodeAndCompare(0x3e, bytes::String("A"));
+}
+
+TEST_F(EncodeUIFrameTest, MultibyteAddress) {
+  EncodeAndCompare(0x3fff, bytes::String("ABC"));
+}
+
+TEST_F(EncodeUIFrameTest, SharesPayloadBuffer) {
+  constexpr auto kPayload = bytes::String("payload");
+  auto mb = AllocateWithRoom(allocator_,
+                             kPayload.size(),
+                             kMaxUIFrameHeadroom,
+                             kMaxUIFrameTailroom);
+  ASSERT_EQ(mb.status(), OkStatus());
+  MultiBuf& frame = **mb;
+  ASSERT_EQ(frame.CopyFrom(kPayload), kPayload.size());
+  const std::byte* payload = &*frame.begin();
+
+  ASSERT_EQ(EncodeUIFrame(kAddress, frame), OkStatus());
+  EXPECT_EQ(frame.NumFragments(), 1u);
+
+  // Flag, address and control field are written directly before the payload.
+  EXPECT_EQ(&*frame.begin() + 3, payload);
+}
+
+TEST_F(EncodeUIFrameTest, FailsWithoutRoom) {
+  constexpr auto kPayload = bytes::Array<0x7e, 0x7e, 0x7e, 0x7e, 0x7e>();
+  auto mb = AllocateWithRoom(allocator_,
+                             kPayload.size(),
+                             kMaxUIFrameHeadroom,
+                             kMaxUIFrameTailroom);
+  ASSERT_EQ(mb.status(), OkStatus());
+  MultiBuf& frame = **mb;
+  ASSERT_EQ(frame.CopyFrom(kPayload), kPayload.size());
+
+  // The escaped payload does not fit in the room left by the frame check
+  // sequence, so the frame is left unmodified.
+  EXPECT_EQ(EncodeUIFrame(kAddress, frame), Status::ResourceExhausted());
+  EXPECT_EQ(frame.size(), kPayload.size());
+}
+
+}  // namespace
+}  // namespace pw::hdlc
@@ -101,12 +101,31 @@ class Decoder {
                : max_frame_size - 2;
   }
 
+  /// @brief Parses an HDLC stream until a frame completes or `data` is
+  /// exhausted, advancing `data` past the bytes that were consumed.
+  ///
+  /// Runs of bytes that need no unescaping are copied and checksummed in bulk.
+  /// A frame that is entirely contained in `data` and has no escaped bytes is
+  /// verified in place, and the returned frame refers to `data` rather than to
+  /// the decoder's buffer.
+  ///
+  /// @note A subsequent call to `Process()` or `ProcessUntilFrame()` will
+  /// invalidate the frame.
+  ///
+  /// @returns @Result{the decoded frame}
+  /// * @UNAVAILABLE - All of `data` was consumed without completing a frame.
+  /// * @RESOURCE_EXHAUSTED - A frame completed, but it was too large to fit in
+  ///   the decoder's buffer.
+  /// * @DATA_LOSS - A frame completed, but it was invalid. The frame was
+  ///   incomplete or the frame check sequence verification failed.
+  Result<Frame> ProcessUntilFrame(ConstByteSpan& data);
+
   /// @brief Processes a span of data and calls the provided callback with each
   /// frame or error.
   template <typename F, typename... Args>
   void Process(ConstByteSpan data, F&& callback, Args&&... args) {
-    for (std::byte b : data) {
-      auto result = Process(b);
+    while (!data.empty()) {
+      auto result = ProcessUntilFrame(data);
       if (result.status() != Status::Unavailable()) {
         callback(std::forward<Args>(args)..., result);
       }
@@ -138,8 +157,15 @@ class Decoder {
 
   void AppendByte(std::byte new_byte);
 
+  // Appends bytes that need no unescaping to the current frame.
+  void AppendBytes(ConstByteSpan data);
+
   Status CheckFrame() const;
 
+  // Checks a complete, unescaped frame that has not been copied into the
+  // buffer.
+  Status CheckFrameInPlace(ConstByteSpan frame) const;
+
   bool VerifyFrameCheckSequence() const;
 
   ByteSpan buffer_;
@@ -0,0 +1,71 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_hdlc/internal/protocol.h"
+#include "pw_multibuf/v2/multibuf.h"
+#include "pw_status/status.h"
+
+namespace pw::hdlc {
+
+/// @module{pw_hdlc}
+
+/// Headroom that a payload needs to be encoded in place by `EncodeUIFrame`:
+/// the opening flag, and the escaped address and control field.
+inline constexpr size_t kMaxUIFrameHeadroom =
+    sizeof(kFlag) + kMaxEscapedVarintAddressSize + kMaxEscapedControlSize;
+
+/// Tailroom that a payload needs to be encoded in place by `EncodeUIFrame`,
+/// not counting one byte for each payload byte that must be escaped: the
+/// escaped frame check sequence, and the closing flag.
+inline constexpr size_t kMaxUIFrameTailroom =
+    kMaxEscapedFcsSize + sizeof(kFlag);
+
+/// @brief Encodes the contents of a MultiBuf as an HDLC unnumbered information
+/// frame (UI frame), in place.
+///
+/// The frame's flags, address, control field and frame check sequence are
+/// written into the headroom and tailroom of the MultiBuf's top layer, such as
+/// that reserved by `pw::multibuf::v2::AllocateWithRoom`, and the top layer is
+/// grown to cover them. The payload is not copied unless some of its bytes
+/// must be escaped, in which case the bytes following the first escaped byte
+/// are shifted into the tailroom.
+///
+/// @code{.cpp}
+///   auto mb = multibuf::v2::AllocateWithRoom(
+///       allocator, payload.size(), hdlc::kMaxUIFrameHeadroom,
+///       hdlc::kMaxUIFrameTailroom + kEscapeRoom);
+///   (*mb)->CopyFrom(payload);
+///   PW_TRY(hdlc::EncodeUIFrame(address, **mb));
+///   // The top layer of `mb` now holds the whole frame.
+/// @endcode
+///
+/// @param address
+///   The frame address.
+/// @param frame
+///   On input, the payload to encode. On output, the encoded frame. Any unused
+///   headroom and tailroom remain outside of the top layer.
+///
+/// @returns
+/// * @OK: The frame was encoded.
+/// * @RESOURCE_EXHAUSTED: The top layer does not have enough headroom or
+///   tailroom for the frame. `frame` is unmodified.
+/// * @INVALID_ARGUMENT: The address could not be encoded. `frame` is
+///   unmodified.
+Status EncodeUIFrame(uint64_t address, multibuf::v2::MultiBuf& frame);
+
+}  // namespace pw::hdlc
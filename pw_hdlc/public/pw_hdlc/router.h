@@ -26,6 +26,10 @@
 // change without notice. Please do not rely on it in production code, but feel
 // free to explore and share feedback with the Pigweed team!
 
+#include <array>
+#include <cstdint>
+#include <optional>
+
 #include "pw_async2/dispatcher.h"
 #include "pw_async2/poll.h"
 #include "pw_channel/channel.h"
@@ -55,7 +59,9 @@ class Router final {
   ///  to ensure that HDLC frames of size ``frame_size`` can be successfully
   ///  decoded.
   Router(pw::channel::ByteReaderWriter& io_channel, ByteSpan decode_buffer)
-      : io_channel_(io_channel), decoder_(decode_buffer) {}
+      : io_channel_(io_channel), decoder_(decode_buffer) {
+    receive_lookup_.fill(kNoChannel);
+  }
 
   // Router is not copyable or movable.
   Router(const Router&) = delete;
@@ -76,6 +82,11 @@ class Router final {
   /// router, so channels should strive to consume or discard incoming data as
   /// quickly as possible in order to prevent starvation of other channels.
   ///
+  /// Where possible, incoming frames are written to ``channel`` as views of
+  /// the buffers read from ``io_channel``, without copying. Such a view keeps
+  /// the memory of the ``io_channel`` buffer that it came from in use until
+  /// it is released.
+  ///
   /// @param[in] receive_address    Incoming HDLC messages received on the
   ///  external ``io_channel`` with an address matching ``receive_address``
   ///  will be decoded and written to ``channel``.
@@ -120,6 +131,16 @@ class Router final {
   // remove this arbitrary limit.
   constexpr static size_t kSomeNumberOfChannels = 16;
 
+  /// Number of slots in ``receive_lookup_``. Keeping the table at most half
+  /// full keeps probe sequences short.
+  constexpr static size_t kReceiveLookupSize = 2 * kSomeNumberOfChannels;
+  static_assert((kReceiveLookupSize & (kReceiveLookupSize - 1)) == 0,
+                "The lookup table size must be a power of two");
+
+  /// Marks an unused slot in ``receive_lookup_``.
+  constexpr static uint8_t kNoChannel = 0xff;
+  static_assert(kSomeNumberOfChannels < kNoChannel);
+
   /// A channel associated with an incoming and outgoing address.
   struct ChannelData {
     ChannelData(pw::channel::DatagramReaderWriter& channel_arg,
@@ -149,6 +170,20 @@ class Router final {
   /// ``receive_address`` or nullptr if no such entry is found.
   ChannelData* FindChannelForReceiveAddress(uint64_t receive_address);
 
+  /// Returns the first slot in ``receive_lookup_`` to probe for
+  /// ``receive_address``.
+  static size_t ReceiveLookupSlot(uint64_t receive_address);
+
+  /// Repopulates ``receive_lookup_`` after ``channel_datas_`` has changed.
+  void RebuildReceiveLookup();
+
+  /// Decodes the first chunk of ``incoming_data_`` until a frame completes.
+  void DecodeFrame();
+
+  /// Splits ``data`` out of ``incoming_data_`` without copying, if it lies
+  /// within the first chunk.
+  std::optional<pw::multibuf::MultiBuf> TakeIncomingView(ConstByteSpan data);
+
   /// Decodes and writes buffers from ``io_channel_`` and writes them into
   /// the corresponding channel.
   void DecodeAndWriteIncoming(pw::async2::Context& cx);
@@ -182,6 +217,10 @@ class Router final {
   /// The channels which send and receive unencoded data.
   pw::Vector<ChannelData, kSomeNumberOfChannels> channel_datas_;
 
+  /// Open-addressed hash table of indices into ``channel_datas_``, keyed by
+  /// receive address, so that incoming frames are routed in constant time.
+  std::array<uint8_t, kReceiveLookupSize> receive_lookup_;
+
   ///////////////////////////////////////////////////////////
   /// State associated with the incoming data being read. ///
   ///////////////////////////////////////////////////////////
@@ -192,16 +231,24 @@ class Router final {
   /// An HDLC decoder.
   pw::hdlc::Decoder decoder_;
 
-  /// The most recent frame returned by ``decoder_``.
+  /// The most recent frame returned by ``decoder_``. Its data refers either
+  /// to the decoder's buffer or to the front of ``incoming_data_``.
   std::optional<pw::hdlc::Frame> decoded_frame_;
 
+  /// The number of bytes at the front of ``incoming_data_`` which have been
+  /// decoded, and which are discarded once ``decoded_frame_`` is delivered.
+  size_t decoded_bytes_ = 0;
+
   ///////////////////////////////////////////////////////////
   /// State associated with the outgoing data being sent. ///
   ///////////////////////////////////////////////////////////
 
   struct OutgoingBuffer {
     pw::multibuf::MultiBuf buffer;
-    size_t hdlc_encoded_size;
+    /// Size of the write buffer to allocate. This starts as an upper bound on
+    /// the encoded size, so that the payload is only scanned once, while it is
+    /// encoded.
+    size_t write_buffer_size;
     uint64_t target_address;
   };
   /// The last buffer read from one of ``channel_datas_`` but not yet encoded
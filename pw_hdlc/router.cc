@@ -16,13 +16,15 @@
 
 #include <algorithm>
 #include <cinttypes>
+#include <cstdint>
 
+#include "pw_hdlc/encoded_size.h"
 #include "pw_hdlc/encoder.h"
 #include "pw_log/log.h"
 #include "pw_multibuf/multibuf.h"
 #include "pw_multibuf/v1/stream.h"
 #include "pw_result/result.h"
-#include "pw_stream/null_stream.h"
+#include "pw_varint/varint.h"
 
 // TODO: b/416564319 - There is an issue with the newlib configuration in one of
 // Pigweed's stm32 builds which results in it not defining the PRIu64 macro.
@@ -47,7 +49,6 @@ using ::pw::channel::ByteReaderWriter;
 using ::pw::channel::DatagramReaderWriter;
 using ::pw::multibuf::MultiBuf;
 using ::pw::multibuf::v1::Chunk;
-using ::pw::stream::CountingNullStream;
 
 namespace {
 
@@ -67,37 +68,33 @@ Status WriteMultiBufUIFrame(uint64_t address,
   return encoder.FinishFrame();
 }
 
-/// Calculates the size of ``payload`` once HDLC-encoded.
-Result<size_t> CalculateSizeOnceEncoded(uint64_t address,
-                                        const MultiBuf& payload) {
-  CountingNullStream null_stream;
-  Status encode_status = WriteMultiBufUIFrame(address, payload, null_stream);
-  if (!encode_status.ok()) {
-    return encode_status;
+/// Returns an upper bound on the size of ``payload`` once HDLC-encoded,
+/// without scanning the payload for bytes that need escaping.
+size_t MaxEncodedSize(uint64_t address, size_t payload_size) {
+  return 2 * sizeof(kFlag) +
+         std::min(varint::EncodedSize(address) * 2,
+                  kMaxEscapedVarintAddressSize) +
+         kMaxEscapedControlSize + kMaxEscapedFcsSize + 2 * payload_size;
+}
+
+/// Returns a tighter upper bound on the size of ``payload`` once
+/// HDLC-encoded, which counts the payload bytes that need escaping.
+size_t MaxEncodedSize(uint64_t address, const MultiBuf& payload) {
+  size_t size = MaxEncodedSize(address, 0);
+  for (const Chunk& chunk : payload.Chunks()) {
+    size += EscapedSize(chunk);
   }
-  return null_stream.bytes_written();
+  return size;
 }
 
-/// Attempts to decode a frame from ``data``, advancing ``data`` forwards by
-/// any bytes that are consumed.
-std::optional<Frame> DecodeFrame(Decoder& decoder, MultiBuf& data) {
-  size_t processed = 0;
-  for (std::byte byte : data) {
-    Result<Frame> frame_result = decoder.Process(byte);
-    ++processed;
-    if (frame_result.status().IsUnavailable()) {
-      // No frame is yet available.
-    } else if (frame_result.ok()) {
-      data.DiscardPrefix(processed);
-      return std::move(*frame_result);
-    } else if (frame_result.status().IsDataLoss()) {
-      PW_LOG_ERROR("Discarding invalid incoming HDLC frame.");
-    } else if (frame_result.status().IsResourceExhausted()) {
-      PW_LOG_ERROR("Discarding incoming HDLC frame: too large for buffer.");
+/// Returns the first non-empty chunk of ``data``, or an empty span.
+ConstByteSpan FirstChunk(const MultiBuf& data) {
+  for (const Chunk& chunk : data.Chunks()) {
+    if (!chunk.empty()) {
+      return chunk;
     }
   }
-  data.DiscardPrefix(processed);
-  return std::nullopt;
+  return ConstByteSpan();
 }
 
 }  // namespace
@@ -113,6 +110,7 @@ Status Router::AddChannel(DatagramReaderWriter& channel,
     }
   }
   channel_datas_.emplace_back(channel, receive_address, send_address);
+  RebuildReceiveLookup();
   return OkStatus();
 }
 
@@ -139,19 +137,66 @@ Status Router::RemoveChannel(DatagramReaderWriter& channel,
     std::swap(*channel_entry, channel_datas_.back());
     channel_datas_.pop_back();
   }
+  RebuildReceiveLookup();
   return OkStatus();
 }
 
+size_t Router::ReceiveLookupSlot(uint64_t receive_address) {
+  // Fibonacci hashing spreads both small, sequential addresses and large,
+  // sparse ones across the table.
+  constexpr uint64_t kMultiplier = 0x9E3779B97F4A7C15u;
+  return static_cast<size_t>((receive_address * kMultiplier) >> 32) &
+         (kReceiveLookupSize - 1);
+}
+
+void Router::RebuildReceiveLookup() {
+  receive_lookup_.fill(kNoChannel);
+  for (size_t i = 0; i < channel_datas_.size(); ++i) {
+    size_t slot = ReceiveLookupSlot(channel_datas_[i].receive_address);
+    while (receive_lookup_[slot] != kNoChannel) {
+      slot = (slot + 1) & (kReceiveLookupSize - 1);
+    }
+    receive_lookup_[slot] = static_cast<uint8_t>(i);
+  }
+}
+
 Router::ChannelData* Router::FindChannelForReceiveAddress(
     uint64_t receive_address) {
-  for (auto& channel : channel_datas_) {
+  // The table is never more than half full, so an empty slot always ends the
+  // probe sequence.
+  size_t slot = ReceiveLookupSlot(receive_address);
+  while (receive_lookup_[slot] != kNoChannel) {
+    ChannelData& channel = channel_datas_[receive_lookup_[slot]];
     if (channel.receive_address == receive_address) {
       return &channel;
     }
+    slot = (slot + 1) & (kReceiveLookupSize - 1);
   }
   return nullptr;
 }
 
+std::optional<MultiBuf> Router::TakeIncomingView(ConstByteSpan data) {
+  const ConstByteSpan chunk = FirstChunk(incoming_data_);
+  const auto chunk_begin = reinterpret_cast<uintptr_t>(chunk.data());
+  const auto data_begin = reinterpret_cast<uintptr_t>(data.data());
+  if (data.empty() || data_begin < chunk_begin ||
+      data_begin + data.size() > chunk_begin + chunk.size()) {
+    return std::nullopt;
+  }
+
+  // Take everything up to the end of the frame data, so that
+  // ``incoming_data_`` is unchanged if the split fails.
+  const size_t offset = data_begin - chunk_begin;
+  std::optional<MultiBuf> view =
+      incoming_data_.TakePrefix(offset + data.size());
+  if (!view.has_value()) {
+    return std::nullopt;
+  }
+  view->DiscardPrefix(offset);
+  decoded_bytes_ -= offset + data.size();
+  return view;
+}
+
 Poll<> Router::PollDeliverIncomingFrame(Context& cx, const Frame& frame) {
   ConstByteSpan data = frame.data();
   uint64_t address = frame.address();
@@ -174,21 +219,27 @@ Poll<> Router::PollDeliverIncomingFrame(Context& cx, const Frame& frame) {
                  ready_to_write->code());
     return Ready();
   }
-  PollOptional<MultiBuf> buffer =
-      channel->channel->PendAllocateWriteBuffer(cx, data.size());
-  if (buffer.IsPending()) {
-    return Pending();
-  }
-  if (!buffer->has_value()) {
-    PW_LOG_ERROR(
-        "Unable to allocate a buffer of size %zu destined for incoming "
-        "HDLC address %" PW_HDLC_ADDR_FMT() ". Packet will be discarded.",
-        data.size(),
-        PW_HDLC_ADDR_CAST(frame.address()));
-    return Ready();
+
+  // Hand the frame data over without copying if it was decoded in place.
+  std::optional<MultiBuf> payload = TakeIncomingView(data);
+  if (!payload.has_value()) {
+    PollOptional<MultiBuf> buffer =
+        channel->channel->PendAllocateWriteBuffer(cx, data.size());
+    if (buffer.IsPending()) {
+      return Pending();
+    }
+    if (!buffer->has_value()) {
+      PW_LOG_ERROR(
+          "Unable to allocate a buffer of size %zu destined for incoming "
+          "HDLC address %" PW_HDLC_ADDR_FMT() ". Packet will be discarded.",
+          data.size(),
+          PW_HDLC_ADDR_CAST(frame.address()));
+      return Ready();
+    }
+    std::copy(frame.data().begin(), frame.data().end(), (**buffer).begin());
+    payload = std::move(**buffer);
   }
-  std::copy(frame.data().begin(), frame.data().end(), (**buffer).begin());
-  Status write_status = channel->channel->StageWrite(std::move(**buffer));
+  Status write_status = channel->channel->StageWrite(std::move(*payload));
   if (!write_status.ok()) {
     PW_LOG_ERROR(
         "Failed to write a buffer of size %zu destined for incoming HDLC "
@@ -210,6 +261,13 @@ void Router::DecodeAndWriteIncoming(Context& cx) {
       decoded_frame_ = std::nullopt;
     }
 
+    // The frame may have referred to the decoded data, so it is only
+    // discarded once the frame has been delivered.
+    if (decoded_bytes_ != 0) {
+      incoming_data_.DiscardPrefix(decoded_bytes_);
+      decoded_bytes_ = 0;
+    }
+
     while (incoming_data_.empty()) {
       PollResult<MultiBuf> incoming = io_channel_.PendRead(cx);
       if (incoming.IsPending()) {
@@ -227,7 +285,23 @@ void Router::DecodeAndWriteIncoming(Context& cx) {
       incoming_data_ = std::move(**incoming);
     }
 
-    decoded_frame_ = DecodeFrame(decoder_, incoming_data_);
+    DecodeFrame();
+  }
+}
+
+void Router::DecodeFrame() {
+  // Decode a whole chunk at a time. Frames that span chunks are accumulated in
+  // the decoder's buffer.
+  const ConstByteSpan chunk = FirstChunk(incoming_data_);
+  ConstByteSpan remaining = chunk;
+  Result<Frame> frame_result = decoder_.ProcessUntilFrame(remaining);
+  decoded_bytes_ = chunk.size() - remaining.size();
+  if (frame_result.ok()) {
+    decoded_frame_ = *frame_result;
+  } else if (frame_result.status().IsDataLoss()) {
+    PW_LOG_ERROR("Discarding invalid incoming HDLC frame.");
+  } else if (frame_result.status().IsResourceExhausted()) {
+    PW_LOG_ERROR("Discarding incoming HDLC frame: too large for buffer.");
   }
 }
 
@@ -255,19 +329,10 @@ void Router::TryFillBufferToEncodeAndSend(Context& cx) {
     }
     MultiBuf& buf = **buf_result;
     uint64_t target_address = cd.send_address;
-    Result<size_t> encoded_size = CalculateSizeOnceEncoded(target_address, buf);
-    if (!encoded_size.ok()) {
-      PW_LOG_ERROR(
-          "Unable to compute size of encoded packet for outgoing buffer of "
-          "size %zu destined for outgoing HDLC address %" PW_HDLC_ADDR_FMT()
-          ". Packet will be discarded.",
-          buf.size(),
-          PW_HDLC_ADDR_CAST(target_address));
-      continue;
-    }
+    const size_t write_buffer_size = MaxEncodedSize(target_address, buf.size());
     buffer_to_encode_and_send_ =
         OutgoingBuffer{/*buffer=*/std::move(buf),
-                       /*hdlc_encoded_size=*/*encoded_size,
+                       /*write_buffer_size=*/write_buffer_size,
                        /*target_address=*/target_address};
     // We received data, so ensure that we start by reading from a different
     // index next time.
@@ -289,30 +354,39 @@ void Router::WriteOutgoingMessages(Context& cx) {
       return;
     }
     uint64_t target_address = buffer_to_encode_and_send_->target_address;
-    size_t hdlc_encoded_size = buffer_to_encode_and_send_->hdlc_encoded_size;
+    size_t write_buffer_size = buffer_to_encode_and_send_->write_buffer_size;
     PollOptional<MultiBuf> maybe_write_buffer =
-        io_channel_.PendAllocateWriteBuffer(cx, hdlc_encoded_size);
+        io_channel_.PendAllocateWriteBuffer(cx, write_buffer_size);
     if (maybe_write_buffer.IsPending()) {
       // Channel cannot write any further messages until we can allocate.
       return;
     }
     // We've gotten the allocation: discard the future.
     if (!maybe_write_buffer->has_value()) {
+      // The worst-case size may be more than the channel can ever allocate.
+      // Retry with a size that accounts for the payload's actual escapes.
+      const size_t tighter_size =
+          MaxEncodedSize(target_address, buffer_to_encode_and_send_->buffer);
+      if (tighter_size < write_buffer_size) {
+        buffer_to_encode_and_send_->write_buffer_size = tighter_size;
+        continue;
+      }
       // We can't allocate a write buffer large enough for our encoded frame.
       // Sadly, we have to throw the frame away.
       PW_LOG_ERROR(
           "Unable to allocate a buffer of size %zu destined for outgoing "
           "HDLC address %" PW_HDLC_ADDR_FMT() ". Packet will be discarded.",
-          hdlc_encoded_size,
+          write_buffer_size,
           PW_HDLC_ADDR_CAST(target_address));
       buffer_to_encode_and_send_ = std::nullopt;
       continue;
     }
+    // Encode in a single pass, then trim the buffer to the encoded size.
     MultiBuf write_buffer = std::move(**maybe_write_buffer);
-    Status encode_status =
-        WriteMultiBufUIFrame(target_address,
-                             buffer_to_encode_and_send_->buffer,
-                             pw::multibuf::v1::Stream(write_buffer));
+    pw::multibuf::v1::Stream write_stream(write_buffer);
+    Status encode_status = WriteMultiBufUIFrame(
+        target_address, buffer_to_encode_and_send_->buffer, write_stream);
+    const size_t hdlc_encoded_size = write_stream.Tell();
     buffer_to_encode_and_send_ = std::nullopt;
     if (!encode_status.ok()) {
       PW_LOG_ERROR(
@@ -322,6 +396,7 @@ void Router::WriteOutgoingMessages(Context& cx) {
           encode_status.code());
       continue;
     }
+    write_buffer.Truncate(hdlc_encoded_size);
     Status write_status = io_channel_.StageWrite(std::move(write_buffer));
     if (!write_status.ok()) {
       PW_LOG_ERROR(
@@ -377,7 +452,10 @@ void Router::RemoveClosedChannels() {
       channel_datas_.begin(), channel_datas_.end(), [](const ChannelData& cd) {
         return !cd.channel->is_read_or_write_open();
       });
-  channel_datas_.erase(first_to_remove, channel_datas_.end());
+  if (first_to_remove != channel_datas_.end()) {
+    channel_datas_.erase(first_to_remove, channel_datas_.end());
+    RebuildReceiveLookup();
+  }
 }
 
 }  // namespace pw::hdlc
@@ -0,0 +1,200 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "pw_assert/check.h"
+#include "pw_async2/basic_dispatcher.h"
+#include "pw_async2/func_task.h"
+#include "pw_channel/forwarding_channel.h"
+#include "pw_hdlc/encoded_size.h"
+#include "pw_hdlc/encoder.h"
+#include "pw_hdlc/router.h"
+#include "pw_memory/no_destructor.h"
+#include "pw_multibuf/simple_allocator_for_test.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_stream/memory_stream.h"
+
+namespace pw::hdlc {
+namespace {
+
+using async2::BasicDispatcher;
+using async2::Context;
+using async2::FuncTask;
+using async2::Pending;
+using async2::Poll;
+using async2::PollResult;
+using async2::Ready;
+using channel::ForwardingByteChannelPair;
+using channel::ForwardingDatagramChannelPair;
+using multibuf::MultiBuf;
+
+// The most channels a Router supports.
+constexpr size_t kNumChannels = 16;
+constexpr uint64_t kFirstReceiveAddress = 1;
+constexpr uint64_t kFirstSendAddress = 1000;
+constexpr size_t kPayloadSize = 64;
+constexpr size_t kMaxEncodedSize =
+    kNumChannels * MaxEncodedFrameSize(kPayloadSize);
+
+// A router with many channels, on which each iteration sends one frame to or
+// from every channel. The router task runs for the life of the program.
+class RouterBenchmark {
+ public:
+  RouterBenchmark()
+      : io_pair_(allocator_, allocator_),
+        router_(io_pair_.first(), decode_buffer_),
+        router_task_([this](Context& cx) { return router_.Pend(cx); }) {
+    std::array<std::byte, kPayloadSize> payload;
+    for (size_t i = 0; i < payload.size(); ++i) {
+      payload[i] = static_cast<std::byte>(i);
+    }
+
+    stream::MemoryWriter writer(encoded_);
+    for (size_t i = 0; i < kNumChannels; ++i) {
+      channels_[i].emplace(allocator_, allocator_);
+      PW_CHECK_OK(router_.AddChannel(channels_[i]->second(),
+                                     kFirstReceiveAddress + i,
+                                     kFirstSendAddress + i));
+      PW_CHECK_OK(WriteUIFrame(kFirstReceiveAddress + i, payload, writer));
+    }
+    encoded_size_ = writer.bytes_written();
+    dispatcher_.Post(router_task_);
+  }
+
+  // Writes a frame for every channel to the I/O channel in one buffer, and
+  // reads the decoded frames from the channels.
+  void ReceiveFrames() {
+    std::optional<MultiBuf> frames = allocator_.Allocate(encoded_size_);
+    PW_CHECK(frames.has_value());
+    std::copy(encoded_.begin(),
+              encoded_.begin() + static_cast<ptrdiff_t>(encoded_size_),
+              frames->begin());
+
+    FuncTask send_task([&](Context& cx) -> Poll<> {
+      if (io_pair_.second().PendReadyToWrite(cx).IsPending()) {
+        return Pending();
+      }
+      PW_CHECK_OK(io_pair_.second().StageWrite(std::move(*frames)));
+      return Ready();
+    });
+    std::array<bool, kNumChannels> received{};
+    FuncTask receive_task([&](Context& cx) -> Poll<> {
+      bool done = true;
+      for (size_t i = 0; i < kNumChannels; ++i) {
+        if (received[i]) {
+          continue;
+        }
+        PollResult<MultiBuf> datagram = channels_[i]->first().PendRead(cx);
+        if (datagram.IsPending()) {
+          done = false;
+          continue;
+        }
+        PW_CHECK_OK(datagram->status());
+        received[i] = true;
+      }
+      return done ? Ready() : Pending();
+    });
+
+    dispatcher_.Post(send_task);
+    dispatcher_.Post(receive_task);
+    dispatcher_.RunUntilStalled();
+    PW_CHECK(std::all_of(received.begin(), received.end(), [](bool r) {
+      return r;
+    }));
+  }
+
+  // Writes a datagram to every channel, and reads the encoded frames from the
+  // I/O channel.
+  void SendFrames() {
+    std::array<bool, kNumChannels> sent{};
+    FuncTask send_task([&](Context& cx) -> Poll<> {
+      for (size_t i = 0; i < kNumChannels; ++i) {
+        if (sent[i]) {
+          continue;
+        }
+        if (channels_[i]->first().PendReadyToWrite(cx).IsPending()) {
+          return Pending();
+        }
+        std::optional<MultiBuf> payload = allocator_.Allocate(kPayloadSize);
+        PW_CHECK(payload.has_value());
+        PW_CHECK_OK(channels_[i]->first().StageWrite(std::move(*payload)));
+        sent[i] = true;
+      }
+      return Ready();
+    });
+    // Each frame starts and ends with a flag byte.
+    size_t flags_received = 0;
+    FuncTask receive_task([&](Context& cx) -> Poll<> {
+      while (flags_received < 2 * kNumChannels) {
+        PollResult<MultiBuf> data = io_pair_.second().PendRead(cx);
+        if (data.IsPending()) {
+          return Pending();
+        }
+        PW_CHECK_OK(data->status());
+        flags_received += static_cast<size_t>(
+            std::count((*data)->begin(), (*data)->end(), kFlag));
+      }
+      return Ready();
+    });
+
+    dispatcher_.Post(send_task);
+    dispatcher_.Post(receive_task);
+    dispatcher_.RunUntilStalled();
+    PW_CHECK_INT_EQ(flags_received, 2 * kNumChannels);
+  }
+
+ private:
+  multibuf::test::SimpleAllocatorForTest<4 * kMaxEncodedSize> allocator_;
+  ForwardingByteChannelPair io_pair_;
+  std::array<std::optional<ForwardingDatagramChannelPair>, kNumChannels>
+      channels_;
+  std::array<std::byte, Decoder::RequiredBufferSizeForFrameSize(
+                            MaxEncodedFrameSize(kPayloadSize))>
+      decode_buffer_;
+  Router router_;
+  std::array<std::byte, kMaxEncodedSize> encoded_;
+  size_t encoded_size_;
+  BasicDispatcher dispatcher_;
+  FuncTask<> router_task_;
+};
+
+RouterBenchmark& Benchmark() {
+  static NoDestructor<RouterBenchmark> benchmark;
+  return *benchmark;
+}
+
+void RouteIncomingFrames(perf_test::State& state) {
+  RouterBenchmark& benchmark = Benchmark();
+  while (state.KeepRunning()) {
+    benchmark.ReceiveFrames();
+  }
+}
+
+void RouteOutgoingFrames(perf_test::State& state) {
+  RouterBenchmark& benchmark = Benchmark();
+  while (state.KeepRunning()) {
+    benchmark.SendFrames();
+  }
+}
+
+PW_PERF_TEST(HdlcRouter_Incoming, RouteIncomingFrames);
+PW_PERF_TEST(HdlcRouter_Outgoing, RouteOutgoingFrames);
+
+}  // namespace
+}  // namespace pw::hdlc
@@ -19,10 +19,12 @@
 #include "pw_async2/func_task.h"
 #include "pw_bytes/suffix.h"
 #include "pw_channel/forwarding_channel.h"
+#include "pw_hdlc/encoder.h"
 #include "pw_channel/loopback_channel.h"
 #include "pw_containers/inline_queue.h"
 #include "pw_containers/vector.h"
 #include "pw_multibuf/simple_allocator.h"
+#include "pw_stream/memory_stream.h"
 
 namespace pw::hdlc {
 namespace {
@@ -203,6 +205,130 @@ TEST(Router, SendsAndReceivesReservedBytes) {
   });
 }
 
+TEST(Router, RoutesBetweenManyChannels) {
+  static constexpr size_t kNumChannels = 8;
+  static constexpr uint64_t kFirstAddress = 100;
+  static constexpr size_t kDecodeBufferSize = 64;
+
+  SimpleAllocatorForTest alloc;
+  LoopbackByteChannel io_loopback(*alloc);
+  std::array<std::byte, kDecodeBufferSize> decode_buffer;
+  Router router(io_loopback.channel(), decode_buffer);
+
+  // Each channel sends to the address that the next channel receives from.
+  std::array<std::optional<ForwardingDatagramChannelPair>, kNumChannels> pairs;
+  for (size_t i = 0; i < kNumChannels; ++i) {
+    pairs[i].emplace(*alloc, *alloc);
+    EXPECT_EQ(router.AddChannel(pairs[i]->second(),
+                                kFirstAddress + i,
+                                kFirstAddress + (i + 1) % kNumChannels),
+              OkStatus());
+  }
+
+  std::array<bool, kNumChannels> sent{};
+  FuncTask send_task([&](Context& cx) -> Poll<> {
+    for (size_t i = 0; i < kNumChannels; ++i) {
+      if (sent[i]) {
+        continue;
+      }
+      if (pairs[i]->first().PendReadyToWrite(cx).IsPending()) {
+        return Pending();
+      }
+      std::optional<MultiBuf> buf = alloc->Allocate(1);
+      if (!buf.has_value()) {
+        ADD_FAILURE();
+        return Ready();
+      }
+      *buf->begin() = static_cast<std::byte>(i);
+      EXPECT_EQ(pairs[i]->first().StageWrite(std::move(*buf)), OkStatus());
+      sent[i] = true;
+    }
+    return Ready();
+  });
+
+  std::array<std::optional<std::byte>, kNumChannels> received;
+  FuncTask recv_task([&](Context& cx) -> Poll<> {
+    bool done = true;
+    for (size_t i = 0; i < kNumChannels; ++i) {
+      if (received[i].has_value()) {
+        continue;
+      }
+      PollResult<MultiBuf> result = pairs[i]->first().PendRead(cx);
+      if (result.IsPending()) {
+        done = false;
+        continue;
+      }
+      EXPECT_EQ(result->status(), OkStatus());
+      if (result->ok() && (*result)->size() == 1u) {
+        received[i] = *(*result)->begin();
+      }
+    }
+    return done ? Ready() : Pending();
+  });
+
+  FuncTask router_task([&router](Context& cx) { return router.Pend(cx); });
+  DispatcherForTest dispatcher;
+  dispatcher.Post(router_task);
+  dispatcher.Post(send_task);
+  dispatcher.Post(recv_task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled());
+
+  for (size_t i = 0; i < kNumChannels; ++i) {
+    ASSERT_TRUE(received[(i + 1) % kNumChannels].has_value());
+    EXPECT_EQ(*received[(i + 1) % kNumChannels], static_cast<std::byte>(i));
+  }
+}
+
+TEST(Router, DeliversUnescapedFramesWithoutCopying) {
+  static constexpr uint64_t kAddress = 27;
+  static constexpr size_t kDecodeBufferSize = 64;
+
+  SimpleAllocatorForTest alloc;
+  ForwardingByteChannelPair byte_pair(*alloc, *alloc);
+  ForwardingDatagramChannelPair datagram_pair(*alloc, *alloc);
+  std::array<std::byte, kDecodeBufferSize> decode_buffer;
+  Router router(byte_pair.first(), decode_buffer);
+  EXPECT_EQ(router.AddChannel(datagram_pair.second(),
+                              kAddress,
+                              /*arbitrary outgoing address*/ 2019),
+            OkStatus());
+
+  std::array<std::byte, 32> encoded;
+  stream::MemoryWriter writer(encoded);
+  ASSERT_EQ(WriteUIFrame(kAddress, bytes::String("payload"), writer),
+            OkStatus());
+  std::optional<MultiBuf> frame = alloc->Allocate(writer.bytes_written());
+  ASSERT_TRUE(frame.has_value());
+  std::copy(writer.WrittenData().begin(),
+            writer.WrittenData().end(),
+            frame->begin());
+  const std::byte* const frame_begin = &*frame->begin();
+  const std::byte* const frame_end = frame_begin + frame->size();
+
+  FuncTask send_task([&](Context& cx) -> Poll<> {
+    if (byte_pair.second().PendReadyToWrite(cx).IsPending()) {
+      return Pending();
+    }
+    EXPECT_EQ(byte_pair.second().StageWrite(std::move(*frame)), OkStatus());
+    return Ready();
+  });
+  ReceiveDatagramsUntilClosed recv_task(datagram_pair.first());
+  FuncTask router_task([&router](Context& cx) { return router.Pend(cx); });
+
+  DispatcherForTest dispatcher;
+  dispatcher.Post(router_task);
+  dispatcher.Post(send_task);
+  dispatcher.Post(recv_task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled());
+
+  ASSERT_EQ(recv_task.received.size(), 1u);
+  const MultiBuf& received = recv_task.received.front();
+  ExpectElementsEqual(received, bytes::String("payload"));
+  const std::byte* const received_begin = &*received.begin();
+  EXPECT_GE(received_begin, frame_begin);
+  EXPECT_LT(received_begin, frame_end);
+}
+
 TEST(Router, PendOnClosedIoChannelReturnsReady) {
   static constexpr size_t kDecodeBufferSize = 256;
 
@@ -78,6 +78,72 @@ class Nesting {
   uint16_t types_;
 };
 
+// Tracks the arrays and objects that are open in JSON written to a stream.
+// The closing ] and } are written when structures are closed, so the types of
+// all open structures are stored. Since previously written JSON cannot be
+// inspected, each open structure is assigned an ID, which is used to detect
+// references to structures that were already closed.
+class StreamNesting {
+ public:
+  // Identifies an open array or object.
+  struct Level {
+    uint16_t depth;  // Number of structures this one is nested within.
+    uint32_t id;
+  };
+
+  static constexpr uint16_t kMaxOpen = 17;
+
+  constexpr StreamNesting()
+      : ids_{}, next_id_(0), depth_(0), types_(0), non_empty_(0) {}
+
+  // Opens an array or object inside the innermost open structure.
+  constexpr Level Open(Nesting::Type type) {
+    PW_ASSERT(depth_ < kMaxOpen);  // At most 17 arrays or objects may be open
+    const Level level{depth_, next_id_++};
+    ids_[depth_] = level.id;
+    types_ = static_cast<uint32_t>(types_ & ~(1u << depth_)) |
+             (static_cast<uint32_t>(type) << depth_);
+    non_empty_ &= ~(1u << depth_);
+    depth_ += 1;
+    return level;
+  }
+
+  // True if the array or object has not been closed.
+  constexpr bool IsOpen(const Level& level) const {
+    return level.depth < depth_ && ids_[level.depth] == level.id;
+  }
+
+  constexpr Nesting::Type type(const Level& level) const {
+    return static_cast<Nesting::Type>((types_ >> level.depth) & 1u);
+  }
+
+  // Number of open arrays and objects.
+  constexpr size_t depth() const { return depth_; }
+
+  // Records that a value is being added to the structure. Returns true if it
+  // already contained a value, in which case a separator is needed.
+  constexpr bool AddValue(const Level& level) {
+    const uint32_t bit = 1u << level.depth;
+    const bool had_value = (non_empty_ & bit) != 0;
+    non_empty_ |= bit;
+    return had_value;
+  }
+
+  // Closes the innermost open structure and returns its closing character.
+  constexpr char Close() {
+    PW_ASSERT(depth_ > 0);
+    depth_ -= 1;
+    return (types_ & (1u << depth_)) == 0 ? ']' : '}';
+  }
+
+ private:
+  uint32_t ids_[kMaxOpen];
+  uint32_t next_id_;
+  uint16_t depth_;
+  uint32_t types_;      // Bit N is the Nesting::Type at depth N.
+  uint32_t non_empty_;  // Bit N is set if the structure at depth N has values.
+};
+
 // Represents a nested array or object.
 class NestedJson {
  public:
@@ -0,0 +1,366 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+/// @file pw_json/stream_builder.h
+///
+/// `pw::JsonStreamBuilder` serializes JSON incrementally to a
+/// `pw::stream::Writer`. Unlike `pw::JsonBuilder`, the size of the JSON is not
+/// limited by a buffer: characters are collected in a small staging buffer,
+/// which is written to the stream whenever it fills up. This makes it possible
+/// to serialize large documents, such as metric or snapshot dumps, without
+/// reserving memory for the largest possible output.
+///
+/// The output is identical to the output of `pw::JsonBuilder`. Since JSON that
+/// was written to the stream cannot be changed, updates cannot be reverted if
+/// they fail, and enclosing arrays and objects are closed as the JSON is
+/// written rather than kept valid after every update.
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+#include "pw_assert/assert.h"
+#include "pw_json/builder.h"
+#include "pw_json/internal/nesting.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+#include "pw_stream/stream.h"
+#include "pw_string/type_to_string.h"
+
+namespace pw {
+
+/// @submodule{pw_json,stream_builder_api}
+
+class JsonStreamBuilder;
+class JsonStreamObject;
+
+/// An array being written by a `JsonStreamBuilder`.
+///
+/// Adding to an array closes any arrays or objects that were opened inside
+/// it. A `JsonStreamArray` is invalidated when it is closed, either explicitly
+/// with `Close()` or because a value was added to an enclosing array or object.
+/// Appending to a closed array fails an assertion.
+class [[nodiscard]] JsonStreamArray {
+ public:
+  JsonStreamArray(const JsonStreamArray&) = delete;
+  JsonStreamArray& operator=(const JsonStreamArray&) = delete;
+
+  constexpr JsonStreamArray(JsonStreamArray&&) = default;
+  constexpr JsonStreamArray& operator=(JsonStreamArray&&) = default;
+
+  /// Appends a value to the array. Values may be numbers, strings, booleans,
+  /// `nullptr`, or a `JsonBuilder`, which is written as is.
+  template <typename T>
+  JsonStreamArray& Append(const T& value);
+
+  /// Appends all elements from an iterable container. Elements that were
+  /// written before an error occurred are not reverted.
+  template <typename Iterable>
+  JsonStreamArray& Extend(const Iterable& iterable);
+
+  /// Appends all elements from an array.
+  template <typename T, size_t kSize>
+  JsonStreamArray& Extend(const T (&iterable)[kSize]);
+
+  /// Opens a nested array in this array.
+  JsonStreamArray AppendNestedArray();
+
+  /// Opens a nested object in this array.
+  JsonStreamObject AppendNestedObject();
+
+  /// Closes this array and any arrays or objects opened inside it.
+  void Close();
+
+ private:
+  friend class JsonStreamBuilder;
+  friend class JsonStreamObject;
+
+  constexpr JsonStreamArray(JsonStreamBuilder& builder,
+                            json_impl::StreamNesting::Level level)
+      : builder_(&builder), level_(level) {}
+
+  JsonStreamBuilder* builder_;
+  json_impl::StreamNesting::Level level_;
+};
+
+/// An object being written by a `JsonStreamBuilder`.
+///
+/// Adding to an object closes any arrays or objects that were opened inside
+/// it. A `JsonStreamObject` is invalidated when it is closed, either
+/// explicitly with `Close()` or because a value was added to an enclosing
+/// array or object. Adding to a closed object fails an assertion.
+class [[nodiscard]] JsonStreamObject {
+ public:
+  JsonStreamObject(const JsonStreamObject&) = delete;
+  JsonStreamObject& operator=(const JsonStreamObject&) = delete;
+
+  constexpr JsonStreamObject(JsonStreamObject&&) = default;
+  constexpr JsonStreamObject& operator=(JsonStreamObject&&) = default;
+
+  /// Adds a key-value pair to the object. Values may be any type accepted by
+  /// `JsonStreamArray::Append`.
+  template <typename T>
+  JsonStreamObject& Add(std::string_view key, const T& value);
+
+  template <typename T>
+  JsonStreamObject& Add(std::nullptr_t, const T& value) = delete;
+
+  /// Opens a nested array in this object.
+  JsonStreamArray AddNestedArray(std::string_view key);
+
+  /// Opens a nested object in this object.
+  JsonStreamObject AddNestedObject(std::string_view key);
+
+  /// Closes this object and any arrays or objects opened inside it.
+  void Close();
+
+ private:
+  friend class JsonStreamArray;
+  friend class JsonStreamBuilder;
+
+  constexpr JsonStreamObject(JsonStreamBuilder& builder,
+                             json_impl::StreamNesting::Level level)
+      : builder_(&builder), level_(level) {}
+
+  JsonStreamBuilder* builder_;
+  json_impl::StreamNesting::Level level_;
+};
+
+/// `JsonStreamBuilder` serializes a single JSON value, array, or object to a
+/// `pw::stream::Writer`. Output is collected in a caller-provided staging
+/// buffer and written to the stream when the buffer fills, so the writer sees
+/// a few large writes rather than many small ones. Strings longer than the
+/// staging buffer are written to the stream directly.
+///
+/// `Finish()` MUST be called once the JSON is complete. It closes any open
+/// arrays or objects and writes the staged characters to the stream.
+class JsonStreamBuilder {
+ public:
+  /// Writes JSON to `writer`, staging it in `staging_buffer`, which must not be
+  /// empty.
+  JsonStreamBuilder(stream::Writer& writer, span<char> staging_buffer)
+      : writer_(writer),
+        staging_(staging_buffer),
+        staged_(0),
+        written_(0),
+        status_(OkStatus()) {
+    PW_ASSERT(!staging_.empty());
+  }
+
+  JsonStreamBuilder(const JsonStreamBuilder&) = delete;
+  JsonStreamBuilder& operator=(const JsonStreamBuilder&) = delete;
+
+  /// Writes a boolean, number, string, `null`, or a `JsonBuilder` as the JSON.
+  /// Returns `status()`.
+  ///
+  /// Only one of `SetValue`, `StartArray`, or `StartObject` may be called, and
+  /// only once.
+  template <typename T>
+  Status SetValue(const T& value) {
+    StartDocument();
+    WriteValue(value);
+    return status();
+  }
+
+  /// Writes the opening `[` of the top-level array.
+  JsonStreamArray StartArray() {
+    StartDocument();
+    return JsonStreamArray(*this, Open(json_impl::Nesting::kArray));
+  }
+
+  /// Writes the opening `{` of the top-level object.
+  JsonStreamObject StartObject() {
+    StartDocument();
+    return JsonStreamObject(*this, Open(json_impl::Nesting::kObject));
+  }
+
+  /// Closes all open arrays and objects and writes the staged JSON to the
+  /// stream. Invalidates all `JsonStreamArray` and `JsonStreamObject` objects.
+  /// Returns `status()`.
+  Status Finish();
+
+  /// Writes the staged JSON to the stream. The JSON may be incomplete.
+  Status Flush();
+
+  /// True if @cpp_func{status} is `pw::OkStatus()`; no errors have occurred.
+  [[nodiscard]] bool ok() const { return status_.ok(); }
+
+  /// Returns the first error that occurred while writing to the stream. Once an
+  /// error occurs, nothing else is written, so the JSON in the stream is
+  /// incomplete.
+  ///
+  /// @returns
+  /// * @OK: All writes to the stream have succeeded.
+  /// * Any error returned by the `pw::stream::Writer`.
+  Status status() const { return status_; }
+
+  /// The number of JSON characters written to the stream or to the staging
+  /// buffer.
+  size_t size() const { return written_ + staged_; }
+
+ private:
+  friend class JsonStreamArray;
+  friend class JsonStreamObject;
+
+  void StartDocument() {
+    PW_ASSERT(size() == 0 && nesting_.depth() == 0);  // Only one JSON value
+  }
+
+  // Writes the opening [ or { and tracks the new array or object.
+  json_impl::StreamNesting::Level Open(json_impl::Nesting::Type type);
+
+  // Closes structures nested in the array or object at level, if any.
+  void CloseTo(const json_impl::StreamNesting::Level& level);
+
+  // Prepares to write a value to an array or object: checks that it is open,
+  // closes nested structures, and writes the separator and key, if any.
+  void StartArrayValue(const json_impl::StreamNesting::Level& level);
+  void StartObjectValue(const json_impl::StreamNesting::Level& level,
+                        std::string_view key);
+
+  template <typename T>
+  void WriteValue(const T& value);
+
+  // Writes a number serialized to a temporary buffer.
+  void WriteSerialized(StatusWithSize result, const char* buffer);
+
+  // Writes "<value>", escaping characters as in json_impl::EscapedStringCopy.
+  void WriteQuoted(std::string_view value);
+
+  void Write(char character) {
+    if (staged_ == staging_.size()) {
+      WriteStaged();
+    }
+    staging_[staged_++] = character;
+  }
+
+  void Write(std::string_view data);
+
+  void WriteStaged();
+
+  stream::Writer& writer_;
+  span<char> staging_;
+  size_t staged_;   // Characters in the staging buffer.
+  size_t written_;  // Characters written to the stream.
+  Status status_;
+  json_impl::StreamNesting nesting_;
+};
+
+/// A `JsonStreamBuilder` with an integrated staging buffer.
+template <size_t kStagingSize>
+class JsonStreamBuffer final : public JsonStreamBuilder {
+ public:
+  static_assert(kStagingSize > 0);
+
+  explicit JsonStreamBuffer(stream::Writer& writer)
+      : JsonStreamBuilder(writer, staging_) {}
+
+ private:
+  std::array<char, kStagingSize> staging_;
+};
+
+/// @}
+
+// Definitions
+
+template <typename T>
+void JsonStreamBuilder::WriteValue(const T& value) {
+  if constexpr (json_impl::kIsJson<T>) {  // JsonBuilder, JsonArray, JsonObject
+    Write(static_cast<std::string_view>(value));
+  } else if constexpr (std::is_null_pointer_v<T>) {  // nullptr
+    Write("null");
+  } else if constexpr (std::is_same_v<T, char*> ||  // C strings
+                       std::is_same_v<T, const char*>) {
+    if (value == nullptr) {
+      Write("null");
+    } else {
+      WriteQuoted(value);
+    }
+  } else if constexpr (std::is_convertible_v<T, std::string_view>) {  // strings
+    WriteQuoted(value);
+  } else if constexpr (std::is_floating_point_v<T>) {
+    char buffer[24];
+    WriteSerialized(
+        string::FloatAsIntToString(static_cast<float>(value), buffer), buffer);
+  } else if constexpr (std::is_same_v<T, bool>) {  // boolean
+    Write(value ? "true" : "false");
+  } else if constexpr (std::is_integral_v<T>) {  // integers
+    char buffer[24];
+    WriteSerialized(string::IntToString(value, buffer), buffer);
+  } else {
+    static_assert(json_impl::InvalidJsonType<T>(),
+                  "JSON values may only be numbers, strings, JSON arrays, JSON "
+                  "objects, or null");
+  }
+}
+
+template <typename T>
+JsonStreamArray& JsonStreamArray::Append(const T& value) {
+  builder_->StartArrayValue(level_);
+  builder_->WriteValue(value);
+  return *this;
+}
+
+template <typename Iterable>
+JsonStreamArray& JsonStreamArray::Extend(const Iterable& iterable) {
+  for (const auto& value : iterable) {
+    Append(value);
+  }
+  return *this;
+}
+
+template <typename T, size_t kSize>
+JsonStreamArray& JsonStreamArray::Extend(const T (&iterable)[kSize]) {
+  for (const auto& value : iterable) {
+    Append(value);
+  }
+  return *this;
+}
+
+inline JsonStreamArray JsonStreamArray::AppendNestedArray() {
+  builder_->StartArrayValue(level_);
+  return JsonStreamArray(*builder_,
+                         builder_->Open(json_impl::Nesting::kArray));
+}
+
+inline JsonStreamObject JsonStreamArray::AppendNestedObject() {
+  builder_->StartArrayValue(level_);
+  return JsonStreamObject(*builder_,
+                          builder_->Open(json_impl::Nesting::kObject));
+}
+
+template <typename T>
+JsonStreamObject& JsonStreamObject::Add(std::string_view key, const T& value) {
+  builder_->StartObjectValue(level_, key);
+  builder_->WriteValue(value);
+  return *this;
+}
+
+inline JsonStreamArray JsonStreamObject::AddNestedArray(std::string_view key) {
+  builder_->StartObjectValue(level_, key);
+  return JsonStreamArray(*builder_,
+                         builder_->Open(json_impl::Nesting::kArray));
+}
+
+inline JsonStreamObject JsonStreamObject::AddNestedObject(
+    std::string_view key) {
+  builder_->StartObjectValue(level_, key);
+  return JsonStreamObject(*builder_,
+                          builder_->Open(json_impl::Nesting::kObject));
+}
+
+}  // namespace pw
@@ -0,0 +1,220 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_json/stream_builder.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "pw_bytes/span.h"
+
+namespace pw {
+namespace {
+
+using Word = uint64_t;
+
+constexpr Word kOnes = ~Word{0} / 0xff;  // 0x0101...01
+constexpr Word kHighBits = kOnes * 0x80;
+
+// Returns nonzero if any byte in the word is zero.
+constexpr Word HasZeroByte(Word word) {
+  return (word - kOnes) & ~word & kHighBits;
+}
+
+// Returns true if any byte in the word must be escaped in a JSON string:
+// control characters, '"', '\\', DEL, or bytes ≥128. Checking a word at a time
+// lets runs of printable ASCII be copied without examining each character.
+constexpr bool NeedsEscape(Word word) {
+  return ((word - kOnes * ' ') & ~word & kHighBits) |  // byte < ' '
+         (word & kHighBits) |                          // byte ≥ 128
+         HasZeroByte(word ^ (kOnes * '"')) |           //
+         HasZeroByte(word ^ (kOnes * '\\')) |          //
+         HasZeroByte(word ^ (kOnes * 0x7f));           // DEL
+}
+
+constexpr bool NeedsEscape(char character) {
+  return character < ' ' || character > '~' || character == '"' ||
+         character == '\\';
+}
+
+static_assert(!NeedsEscape(Word{0x2021232425262728}));
+static_assert(!NeedsEscape(Word{0x7e7d7c7b5d5b2f2e}));
+static_assert(NeedsEscape(Word{0x2020202020202022}));
+static_assert(NeedsEscape(Word{0x5c20202020202020}));
+static_assert(NeedsEscape(Word{0x20201f2020202020}));
+static_assert(NeedsEscape(Word{0x2020207f20202020}));
+static_assert(NeedsEscape(Word{0x2020202020802020}));
+static_assert(NeedsEscape(Word{0x0000000000000000}));
+
+}  // namespace
+
+Status JsonStreamBuilder::Finish() {
+  while (nesting_.depth() > 0) {
+    Write(nesting_.Close());
+  }
+  return Flush();
+}
+
+Status JsonStreamBuilder::Flush() {
+  if (staged_ > 0) {
+    WriteStaged();
+  }
+  return status();
+}
+
+json_impl::StreamNesting::Level JsonStreamBuilder::Open(
+    json_impl::Nesting::Type type) {
+  Write(type == json_impl::Nesting::kArray ? '[' : '{');
+  return nesting_.Open(type);
+}
+
+void JsonStreamBuilder::CloseTo(const json_impl::StreamNesting::Level& level) {
+  PW_ASSERT(nesting_.IsOpen(level));  // The array or object was closed.
+  while (nesting_.depth() > level.depth + 1u) {
+    Write(nesting_.Close());
+  }
+}
+
+void JsonStreamBuilder::StartArrayValue(
+    const json_impl::StreamNesting::Level& level) {
+  CloseTo(level);
+  if (nesting_.AddValue(level)) {
+    Write(", ");
+  }
+}
+
+void JsonStreamBuilder::StartObjectValue(
+    const json_impl::StreamNesting::Level& level, std::string_view key) {
+  CloseTo(level);
+  if (nesting_.AddValue(level)) {
+    Write(", ");
+  }
+  WriteQuoted(key);
+  Write(": ");
+}
+
+void JsonStreamBuilder::WriteSerialized(StatusWithSize result,
+                                        const char* buffer) {
+  PW_ASSERT(result.ok());  // The temporary buffer fits any number.
+  Write(std::string_view(buffer, result.size()));
+}
+
+void JsonStreamBuilder::WriteQuoted(std::string_view value) {
+  Write('"');
+
+  const char* const end = value.data() + value.size();
+  const char* unescaped = value.data();  // Start of characters not yet written
+  const char* position = value.data();
+
+  while (true) {
+    // Skip a word at a time while no characters need escaping.
+    while (end - position >= static_cast<ptrdiff_t>(sizeof(Word))) {
+      Word word;
+      std::memcpy(&word, position, sizeof(word));
+      if (NeedsEscape(word)) {
+        break;
+      }
+      position += sizeof(word);
+    }
+
+    // Find the character to escape in this word, or finish the string.
+    const char* const word_end =
+        position +
+        std::min(end - position, static_cast<ptrdiff_t>(sizeof(Word)));
+    while (position != word_end && !NeedsEscape(*position)) {
+      ++position;
+    }
+    if (position == end) {
+      break;
+    }
+    if (position == word_end) {
+      continue;
+    }
+
+    Write(std::string_view(unescaped,
+                           static_cast<size_t>(position - unescaped)));
+
+    // Escape the character as in json_impl::EscapedStringCopy.
+    const char character = *position;
+    char escaped[6] = {'\\'};
+    size_t escaped_size = 2;
+    if (character >= '\b' && character <= '\r' && character != '\v') {
+      constexpr char kControlChars[] = {'b', 't', 'n', '?', 'f', 'r'};
+      escaped[1] = kControlChars[character - '\b'];
+    } else if (character == '"' || character == '\\') {
+      escaped[1] = character;
+    } else {
+      escaped[1] = 'u';
+      escaped[2] = '0';
+      escaped[3] = '0';
+      escaped[4] = json_impl::NibbleToHex((character >> 4) & 0x0f);
+      escaped[5] = json_impl::NibbleToHex(character & 0x0f);
+      escaped_size = 6;
+    }
+    Write(std::string_view(escaped, escaped_size));
+    unescaped = ++position;
+  }
+
+  Write(std::string_view(unescaped, static_cast<size_t>(end - unescaped)));
+  Write('"');
+}
+
+void JsonStreamBuilder::Write(std::string_view data) {
+  // Write data that would fill the staging buffer directly to the stream.
+  if (data.size() >= staging_.size()) {
+    if (staged_ > 0) {
+      WriteStaged();
+    }
+    if (status_.ok()) {
+      status_ = writer_.Write(as_bytes(span(data.data(), data.size())));
+      if (status_.ok()) {
+        written_ += data.size();
+      }
+    }
+    return;
+  }
+
+  const size_t available = staging_.size() - staged_;
+  if (data.size() > available) {
+    std::memcpy(staging_.data() + staged_, data.data(), available);
+    staged_ = staging_.size();
+    data.remove_prefix(available);
+    WriteStaged();
+  }
+  std::memcpy(staging_.data() + staged_, data.data(), data.size());
+  staged_ += data.size();
+}
+
+void JsonStreamBuilder::WriteStaged() {
+  if (status_.ok()) {
+    status_ = writer_.Write(as_bytes(staging_.first(staged_)));
+    if (status_.ok()) {
+      written_ += staged_;
+    }
+  }
+  staged_ = 0;
+}
+
+void JsonStreamArray::Close() {
+  builder_->CloseTo(level_);
+  builder_->Write(builder_->nesting_.Close());
+}
+
+void JsonStreamObject::Close() {
+  builder_->CloseTo(level_);
+  builder_->Write(builder_->nesting_.Close());
+}
+
+}  // namespace pw
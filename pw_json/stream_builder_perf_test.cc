@@ -0,0 +1,91 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <cstdint>
+#include <string_view>
+
+#include "pw_assert/check.h"
+#include "pw_json/builder.h"
+#include "pw_json/stream_builder.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_stream/null_stream.h"
+
+namespace pw {
+namespace {
+
+constexpr std::string_view kMetricNames[] = {
+    "rx_bytes",      "tx_bytes",        "rx_packets",  "tx_packets",
+    "crc_errors",    "dropped_packets", "retransmits", "uptime_ms",
+    "heap_high_mark", "stack_high_mark",
+};
+
+// A string of printable ASCII, typical of log and snapshot text.
+constexpr std::string_view kText =
+    "The quick brown fox jumps over the lazy dog. Sphinx of black quartz, "
+    "judge my vow! 0123456789 (pack my box with five dozen liquor jugs)";
+
+// Writes 10 groups of 10 named metrics.
+template <typename Object>
+void AddMetrics(Object& object) {
+  for (uint32_t group = 0; group < 10; ++group) {
+    auto metrics = object.AddNestedObject(kMetricNames[group]);
+    for (uint32_t i = 0; i < 10; ++i) {
+      metrics.Add(kMetricNames[i], group * 100000u + i * 7919u);
+    }
+  }
+}
+
+void MetricDumpToBuffer(perf_test::State& state) {
+  static JsonBuffer<4096> json;
+  while (state.KeepRunning()) {
+    JsonObject& object = json.StartObject();
+    AddMetrics(object);
+    PW_CHECK(json.ok());
+  }
+}
+
+void MetricDumpToStream(perf_test::State& state) {
+  stream::NullStream writer;
+  while (state.KeepRunning()) {
+    JsonStreamBuffer<64> json(writer);
+    JsonStreamObject object = json.StartObject();
+    AddMetrics(object);
+    PW_CHECK_OK(json.Finish());
+  }
+}
+
+void LongStringToBuffer(perf_test::State& state) {
+  static JsonBuffer<512> json;
+  while (state.KeepRunning()) {
+    json.StartArray().Append(kText).Append(kText).Append(kText);
+    PW_CHECK(json.ok());
+  }
+}
+
+void LongStringToStream(perf_test::State& state) {
+  stream::NullStream writer;
+  while (state.KeepRunning()) {
+    JsonStreamBuffer<64> json(writer);
+    json.StartArray().Append(kText).Append(kText).Append(kText);
+    PW_CHECK_OK(json.Finish());
+  }
+}
+
+PW_PERF_TEST(JsonBuilder_MetricDump, MetricDumpToBuffer);
+PW_PERF_TEST(JsonStreamBuilder_MetricDump, MetricDumpToStream);
+PW_PERF_TEST(JsonBuilder_LongString, LongStringToBuffer);
+PW_PERF_TEST(JsonStreamBuilder_LongString, LongStringToStream);
+
+}  // namespace
+}  // namespace pw
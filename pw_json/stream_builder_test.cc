@@ -0,0 +1,272 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_json/stream_builder.h"
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "pw_json/builder.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using namespace std::string_view_literals;
+
+std::string_view Written(const pw::stream::MemoryWriter& writer) {
+  return std::string_view(
+      reinterpret_cast<const char*>(writer.WrittenData().data()),
+      writer.WrittenData().size());
+}
+
+// Counts the number of writes to an underlying writer.
+class CountingWriter final : public pw::stream::NonSeekableWriter {
+ public:
+  CountingWriter(pw::stream::Writer& writer) : writer_(writer), writes_(0) {}
+
+  size_t writes() const { return writes_; }
+
+ private:
+  pw::Status DoWrite(pw::ConstByteSpan data) override {
+    writes_ += 1;
+    return writer_.Write(data);
+  }
+
+  pw::stream::Writer& writer_;
+  size_t writes_;
+};
+
+TEST(JsonStreamBuilder, Example) {
+  pw::stream::MemoryWriterBuffer<256> writer;
+
+  // DOCSTAG: [pw-json-stream-builder-example]
+  // Stage output in a 32-byte buffer and write it to a pw::stream::Writer.
+  pw::JsonStreamBuffer<32> json(writer);
+  pw::JsonStreamObject object = json.StartObject();
+  object.Add("name", "Crag").Add("job", "hacker");
+
+  // Nested arrays and objects are written as they are filled in.
+  pw::JsonStreamArray skills = object.AddNestedArray("skills");
+  skills.Append(20).Append(1).Append(1).Append(1);
+
+  // Adding to the enclosing object closes the nested array.
+  object.Add("awesome", true);
+
+  // Finish() closes the object and writes the staged JSON to the stream.
+  PW_ASSERT(json.Finish().ok());
+  // DOCSTAG: [pw-json-stream-builder-example]
+
+  EXPECT_EQ(Written(writer),
+            R"({"name": "Crag", "job": "hacker", "skills": [20, 1, 1, 1],)"
+            R"( "awesome": true})"sv);
+  EXPECT_EQ(json.size(), Written(writer).size());
+}
+
+template <typename T>
+void ExpectValueMatchesJsonBuilder(const T& value) {
+  pw::JsonBuffer<128> expected;
+  ASSERT_EQ(pw::OkStatus(), expected.SetValue(value));
+
+  pw::stream::MemoryWriterBuffer<128> writer;
+  pw::JsonStreamBuffer<8> json(writer);
+  EXPECT_EQ(pw::OkStatus(), json.SetValue(value));
+  EXPECT_EQ(pw::OkStatus(), json.Finish());
+  EXPECT_EQ(Written(writer), std::string_view(expected));
+}
+
+TEST(JsonStreamBuilder, Values_MatchJsonBuilder) {
+  ExpectValueMatchesJsonBuilder(nullptr);
+  ExpectValueMatchesJsonBuilder(static_cast<const char*>(nullptr));
+  ExpectValueMatchesJsonBuilder(true);
+  ExpectValueMatchesJsonBuilder(false);
+  ExpectValueMatchesJsonBuilder(0);
+  ExpectValueMatchesJsonBuilder(-1234567);
+  ExpectValueMatchesJsonBuilder(INT64_MIN);
+  ExpectValueMatchesJsonBuilder(UINT64_MAX);
+  ExpectValueMatchesJsonBuilder(-4.9f);
+  ExpectValueMatchesJsonBuilder(3.5e20);
+  ExpectValueMatchesJsonBuilder("");
+  ExpectValueMatchesJsonBuilder("a string that is longer than 8 bytes");
+  ExpectValueMatchesJsonBuilder("\"quoted\"\n\t\x01\x7f\xff"sv);
+}
+
+TEST(JsonStreamBuilder, EmptyStructures) {
+  pw::stream::MemoryWriterBuffer<16> array_writer;
+  pw::JsonStreamBuffer<4> array_json(array_writer);
+  array_json.StartArray().Close();
+  EXPECT_EQ(pw::OkStatus(), array_json.Finish());
+  EXPECT_EQ(Written(array_writer), "[]"sv);
+
+  pw::stream::MemoryWriterBuffer<16> object_writer;
+  pw::JsonStreamBuffer<4> object_json(object_writer);
+  [[maybe_unused]] pw::JsonStreamObject object = object_json.StartObject();
+  EXPECT_EQ(pw::OkStatus(), object_json.Finish());
+  EXPECT_EQ(Written(object_writer), "{}"sv);
+}
+
+TEST(JsonStreamBuilder, Nesting_MatchesJsonBuilder) {
+  pw::JsonBuffer<256> expected;
+  {
+    pw::JsonObject& object = expected.StartObject();
+    object.Add("a", 1);
+    pw::NestedJsonArray array = object.AddNestedArray("b");
+    array.Append("x").AppendNestedObject().Add("y", false);
+    array.AppendNestedArray().Append(nullptr).AppendNestedArray().Append(2);
+    object.AddNestedObject("c").AddNestedObject("d").Add("e", -5);
+    object.Add("f", "end");
+  }
+
+  pw::stream::MemoryWriterBuffer<256> writer;
+  pw::JsonStreamBuffer<16> json(writer);
+  pw::JsonStreamObject object = json.StartObject();
+  object.Add("a", 1);
+  pw::JsonStreamArray array = object.AddNestedArray("b");
+  array.Append("x").AppendNestedObject().Add("y", false);
+  array.AppendNestedArray().Append(nullptr).AppendNestedArray().Append(2);
+  object.AddNestedObject("c").AddNestedObject("d").Add("e", -5);
+  object.Add("f", "end");
+  EXPECT_EQ(pw::OkStatus(), json.Finish());
+
+  EXPECT_EQ(Written(writer), std::string_view(expected));
+}
+
+TEST(JsonStreamBuilder, Close_ClosesNestedStructures) {
+  pw::stream::MemoryWriterBuffer<64> writer;
+  pw::JsonStreamBuffer<16> json(writer);
+  pw::JsonStreamArray array = json.StartArray();
+  pw::JsonStreamArray nested = array.AppendNestedArray();
+  nested.AppendNestedObject().AddNestedArray("deep").Append(1);
+  nested.Close();
+  array.Append(2);
+  EXPECT_EQ(pw::OkStatus(), json.Finish());
+
+  EXPECT_EQ(Written(writer), R"([[{"deep": [1]}], 2])"sv);
+}
+
+TEST(JsonStreamBuilder, Finish_ClosesAllStructures) {
+  pw::stream::MemoryWriterBuffer<64> writer;
+  pw::JsonStreamBuffer<16> json(writer);
+  pw::JsonStreamArray array = json.StartArray();
+  for (int i = 0; i < 15; ++i) {  // 17 arrays and objects may be open
+    array = array.AppendNestedArray();
+  }
+  [[maybe_unused]] pw::JsonStreamObject object = array.AppendNestedObject();
+  EXPECT_EQ(pw::OkStatus(), json.Finish());
+
+  EXPECT_EQ(Written(writer), "[[[[[[[[[[[[[[[[{}]]]]]]]]]]]]]]]]"sv);
+}
+
+TEST(JsonStreamBuilder, Extend) {
+  pw::stream::MemoryWriterBuffer<64> writer;
+  pw::JsonStreamBuffer<16> json(writer);
+  constexpr int kValues[] = {1, 2, 3};
+  constexpr std::array<bool, 2> kBools = {true, false};
+  json.StartArray().Extend(kValues).Extend(kBools);
+  EXPECT_EQ(pw::OkStatus(), json.Finish());
+
+  EXPECT_EQ(Written(writer), "[1, 2, 3, true, false]"sv);
+}
+
+TEST(JsonStreamBuilder, JsonBuilderValues_WrittenDirectly) {
+  pw::JsonBuffer<32> nested;
+  nested.StartArray().Append(1).Append("two");
+
+  pw::stream::MemoryWriterBuffer<64> writer;
+  pw::JsonStreamBuffer<16> json(writer);
+  json.StartObject().Add("nested", nested);
+  EXPECT_EQ(pw::OkStatus(), json.Finish());
+
+  EXPECT_EQ(Written(writer), R"({"nested": [1, "two"]})"sv);
+}
+
+// Checks every byte at every position within a word, surrounded by characters
+// that don't need escaping, against JsonBuilder.
+TEST(JsonStreamBuilder, Escaping_MatchesJsonBuilder) {
+  for (int byte = 0; byte <= 0xff; ++byte) {
+    for (size_t position = 0; position < 20; ++position) {
+      char string[20];
+      for (size_t i = 0; i < sizeof(string); ++i) {
+        string[i] = static_cast<char>('a' + i);
+      }
+      string[position] = static_cast<char>(byte);
+      const std::string_view value(string, sizeof(string));
+
+      pw::JsonBuffer<160> expected;
+      ASSERT_EQ(pw::OkStatus(), expected.SetValue(value));
+
+      pw::stream::MemoryWriterBuffer<160> writer;
+      pw::JsonStreamBuffer<16> json(writer);
+      ASSERT_EQ(pw::OkStatus(), json.SetValue(value));
+      ASSERT_EQ(pw::OkStatus(), json.Finish());
+      ASSERT_EQ(Written(writer), std::string_view(expected))
+          << "byte " << byte << " at " << position;
+    }
+  }
+}
+
+TEST(JsonStreamBuilder, StagingBufferSize_DoesNotChangeOutput) {
+  constexpr std::string_view kLong =
+      "This string is longer than most of the staging buffers\n";
+
+  pw::JsonBuffer<256> expected;
+  pw::JsonArray& expected_array = expected.StartArray();
+  expected_array.Append(kLong).Append(12345).AppendNestedObject().Add(kLong, 1);
+
+  for (size_t size = 1; size <= 64; ++size) {
+    std::array<char, 64> staging;
+    pw::stream::MemoryWriterBuffer<256> writer;
+    pw::JsonStreamBuilder json(writer, pw::span(staging).first(size));
+    json.StartArray().Append(kLong).Append(12345).AppendNestedObject().Add(
+        kLong, 1);
+    ASSERT_EQ(pw::OkStatus(), json.Finish());
+    ASSERT_EQ(Written(writer), std::string_view(expected)) << size;
+  }
+}
+
+TEST(JsonStreamBuilder, StagingBuffer_BatchesWrites) {
+  pw::stream::MemoryWriterBuffer<512> memory;
+  CountingWriter writer(memory);
+  pw::JsonStreamBuffer<64> json(writer);
+  pw::JsonStreamArray array = json.StartArray();
+  for (int i = 0; i < 50; ++i) {
+    array.Append(i);
+  }
+  EXPECT_EQ(writer.writes(), 2u);  // 64-byte chunks, written as they fill
+  EXPECT_EQ(pw::OkStatus(), json.Finish());
+
+  EXPECT_EQ(writer.writes(), 3u);
+  EXPECT_EQ(json.size(), Written(memory).size());
+  EXPECT_EQ(Written(memory).size(), 190u);
+}
+
+TEST(JsonStreamBuilder, WriterError_SetsStatusAndStopsWriting) {
+  pw::stream::MemoryWriterBuffer<20> writer;
+  pw::JsonStreamBuffer<8> json(writer);
+  pw::JsonStreamArray array = json.StartArray();
+  array.Append("0123").Append("4567");
+  EXPECT_TRUE(json.ok());
+
+  array.Append("89abcdef");
+  EXPECT_EQ(pw::Status::ResourceExhausted(), json.status());
+
+  array.Append(1);
+  EXPECT_EQ(pw::Status::ResourceExhausted(), json.Finish());
+  EXPECT_FALSE(json.ok());
+  EXPECT_EQ(Written(writer), R"(["0123", "4567", ")"sv);
+  EXPECT_EQ(json.size(), Written(writer).size());
+}
+
+}  // namespace
@@ -0,0 +1,361 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// This log implementation defers formatting and output to a background thread.
+// Each logging thread encodes its messages' arguments into its own lock-free
+// queue; the background thread merges the queues in the order the messages
+// were logged, formats them and writes them with the basic backend's output.
+
+#include "pw_log_basic/log_async.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "pw_containers/internal/per_thread_queues.h"
+#include "pw_log/levels.h"
+#include "pw_log_basic_private/config.h"
+#include "pw_log_basic_private/format.h"
+#include "pw_memory/no_destructor.h"
+#include "pw_span/span.h"
+#include "pw_string/string_builder.h"
+#include "pw_tokenizer/encode_args.h"
+#include "pw_tokenizer/internal/decode.h"
+
+namespace pw::log_basic {
+namespace {
+
+// How often the background thread writes out queued messages. Producers only
+// wake it early when their queue is half full, so that logging does not
+// usually make a system call.
+constexpr std::chrono::milliseconds kPollPeriod(10);
+constexpr size_t kWakeThreshold = PW_LOG_BASIC_ASYNC_QUEUE_SIZE_ENTRIES / 2;
+
+// How long a crash handler waits for another thread that is writing out
+// messages before giving up.
+constexpr std::chrono::milliseconds kCrashFlushTimeout(100);
+
+// A log message with its arguments encoded, waiting to be formatted.
+struct QueuedLog {
+  uint64_t sequence;
+  int level;
+  unsigned int flags;
+  int line_number;
+  const char* module_name;
+  const char* file_name;
+  const char* function_name;
+  const char* message;
+  size_t args_size;
+  std::byte args[PW_LOG_BASIC_ASYNC_ARGS_SIZE_BYTES];
+
+  span<const uint8_t> encoded_args() const {
+    return span(reinterpret_cast<const uint8_t*>(args), args_size);
+  }
+};
+
+class AsyncLogger {
+ public:
+  AsyncLogger() = default;
+
+  void Log(int level,
+           unsigned int flags,
+           const char* module_name,
+           const char* file_name,
+           int line_number,
+           const char* function_name,
+           const char* message,
+           pw_tokenizer_ArgTypes types,
+           va_list args);
+
+  // Writes out every queued message on the calling thread.
+  void Flush() {
+    std::lock_guard lock(drain_mutex_);
+    DrainLocked(Gaps::kWait);
+  }
+
+  // Writes out queued messages unless another thread holds the drain lock
+  // for longer than the timeout. Used from signal handlers, where blocking
+  // indefinitely could deadlock.
+  void TryFlush(std::chrono::milliseconds timeout) {
+    if (drain_mutex_.try_lock_for(timeout)) {
+      DrainLocked(Gaps::kSkip);
+      drain_mutex_.unlock();
+    }
+  }
+
+  size_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  using LogQueues = containers::internal::PerThreadQueues<
+      QueuedLog,
+      PW_LOG_BASIC_ASYNC_MAX_THREADS,
+      PW_LOG_BASIC_ASYNC_QUEUE_SIZE_ENTRIES>;
+
+  // What to do when the next message in sequence has not been queued yet,
+  // because another thread has taken its sequence number but is still
+  // writing it.
+  enum class Gaps {
+    kStop,  // Write it on a later drain.
+    kWait,  // Yield until it is queued. The thread is not waiting on a lock.
+    kSkip,  // Write later messages first. Used when crashing, since the
+            // thread might never finish.
+  };
+
+  void StartOnce();
+  void Run();
+  void Wake();
+
+  // Writes queued messages in the order they were logged. Requires
+  // drain_mutex_.
+  void DrainLocked(Gaps gaps);
+  void WriteLocked(const QueuedLog& log);
+  void ReportDroppedLocked();
+
+  LogQueues queues_;
+  std::atomic<uint64_t> next_sequence_ = 0;
+  std::atomic<size_t> dropped_ = 0;
+
+  std::once_flag started_;
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::atomic<bool> wake_pending_ = false;
+
+  // Guards the consumer side of the queues and the members below.
+  std::timed_mutex drain_mutex_;
+  uint64_t next_sequence_to_write_ = 0;
+  size_t reported_dropped_ = 0;
+  std::unordered_map<const char*, tokenizer::FormatString> formats_;
+};
+
+AsyncLogger& GetLogger() {
+  static NoDestructor<AsyncLogger> logger;
+  return *logger;
+}
+
+#if PW_LOG_BASIC_ASYNC_FLUSH_ON_CRASH
+
+constexpr std::array<int, 4> kCrashSignals = {
+    SIGABRT, SIGSEGV, SIGILL, SIGFPE};
+std::array<void (*)(int), kCrashSignals.size()> previous_crash_handlers;
+
+// Writes out what it can, then restores the previous handler and re-raises
+// the signal. This is best effort: formatting is not async-signal-safe, but
+// the process is terminating anyway.
+void FlushOnCrash(int signal) {
+  GetLogger().TryFlush(kCrashFlushTimeout);
+  std::fflush(nullptr);  // The output is often a buffered stdio stream.
+  for (size_t i = 0; i < kCrashSignals.size(); ++i) {
+    if (kCrashSignals[i] == signal) {
+      std::signal(signal, previous_crash_handlers[i]);
+    }
+  }
+  std::raise(signal);
+}
+
+#endif  // PW_LOG_BASIC_ASYNC_FLUSH_ON_CRASH
+
+void AsyncLogger::StartOnce() {
+  std::call_once(started_, [this] {
+    std::atexit([] { GetLogger().Flush(); });
+#if PW_LOG_BASIC_ASYNC_FLUSH_ON_CRASH
+    for (size_t i = 0; i < kCrashSignals.size(); ++i) {
+      void (*previous)(int) = std::signal(kCrashSignals[i], FlushOnCrash);
+      previous_crash_handlers[i] = previous == SIG_ERR ? SIG_DFL : previous;
+    }
+#endif  // PW_LOG_BASIC_ASYNC_FLUSH_ON_CRASH
+    std::thread([this] { Run(); }).detach();
+  });
+}
+
+void AsyncLogger::Run() {
+  while (true) {
+    {
+      std::unique_lock lock(wake_mutex_);
+      wake_.wait_for(
+          lock, kPollPeriod, [this] { return wake_pending_.load(); });
+    }
+    wake_pending_.store(false);
+    std::lock_guard lock(drain_mutex_);
+    DrainLocked(Gaps::kStop);
+  }
+}
+
+void AsyncLogger::Wake() {
+  if (!wake_pending_.load() && !wake_pending_.exchange(true)) {
+    wake_.notify_one();
+  }
+}
+
+void AsyncLogger::Log(int level,
+                      unsigned int flags,
+                      const char* module_name,
+                      const char* file_name,
+                      int line_number,
+                      const char* function_name,
+                      const char* message,
+                      pw_tokenizer_ArgTypes types,
+                      va_list args) {
+  StartOnce();
+
+  LogQueues::Queue* const queue = queues_.CurrentThreadQueue();
+
+  // Critical messages, and messages from threads beyond
+  // PW_LOG_BASIC_ASYNC_MAX_THREADS, are written immediately after everything
+  // logged before them.
+  if (level >= PW_LOG_LEVEL_CRITICAL || queue == nullptr) {
+    std::lock_guard lock(drain_mutex_);
+    DrainLocked(Gaps::kWait);
+    QueuedLog log;
+    log.args_size = tokenizer::EncodeArgs(types, args, log.args);
+    StringBuffer<PW_LOG_BASIC_ENTRY_SIZE> buffer;
+    internal::AppendPrefix(buffer,
+                           level,
+                           flags,
+                           module_name,
+                           file_name,
+                           line_number,
+                           function_name);
+    buffer << tokenizer::FormatString(message)
+                  .Format(log.encoded_args())
+                  .value_with_errors();
+    internal::WriteLog(buffer);
+    return;
+  }
+
+  QueuedLog* const log = queue->NextSlot();
+  if (log == nullptr) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  // Every sequence number that is taken is queued, so the drain can tell
+  // when a message is still being written.
+  log->sequence = next_sequence_.fetch_add(1, std::memory_order_relaxed);
+  log->level = level;
+  log->flags = flags;
+  log->line_number = line_number;
+  log->module_name = module_name;
+  log->file_name = file_name;
+  log->function_name = function_name;
+  log->message = message;
+  log->args_size = tokenizer::EncodeArgs(types, args, log->args);
+  queue->Push();
+  if (queue->size() >= kWakeThreshold) {
+    Wake();
+  }
+}
+
+void AsyncLogger::DrainLocked(Gaps gaps) {
+  // Each queue is in sequence order, so merging the queues by sequence number
+  // restores the order in which messages were logged.
+  bool at_gap = false;
+  auto write = [this, gaps, &at_gap](const QueuedLog& log) {
+    if (log.sequence > next_sequence_to_write_ && gaps != Gaps::kSkip) {
+      at_gap = true;
+      return false;
+    }
+    WriteLocked(log);
+    next_sequence_to_write_ =
+        std::max(next_sequence_to_write_, log.sequence + 1);
+    return true;
+  };
+  auto is_before = [](const QueuedLog& a, const QueuedLog& b) {
+    return a.sequence < b.sequence;
+  };
+
+  while (true) {
+    at_gap = false;
+    queues_.Drain(is_before, write);
+    if (!at_gap || gaps != Gaps::kWait) {
+      break;
+    }
+    std::this_thread::yield();
+  }
+  ReportDroppedLocked();
+}
+
+void AsyncLogger::WriteLocked(const QueuedLog& log) {
+  // Parsing the format string is the bulk of the decoding cost, so the parsed
+  // form is kept for each log statement.
+  auto format = formats_.find(log.message);
+  if (format == formats_.end()) {
+    format = formats_.emplace(log.message, tokenizer::FormatString(log.message))
+                 .first;
+  }
+
+  StringBuffer<PW_LOG_BASIC_ENTRY_SIZE> buffer;
+  internal::AppendPrefix(buffer,
+                         log.level,
+                         log.flags,
+                         log.module_name,
+                         log.file_name,
+                         log.line_number,
+                         log.function_name);
+  buffer << format->second.Format(log.encoded_args()).value_with_errors();
+  internal::WriteLog(buffer);
+}
+
+void AsyncLogger::ReportDroppedLocked() {
+  const size_t dropped = dropped_.load(std::memory_order_relaxed);
+  if (dropped == reported_dropped_) {
+    return;
+  }
+  StringBuffer<PW_LOG_BASIC_ENTRY_SIZE> buffer;
+  internal::AppendPrefix(
+      buffer, PW_LOG_LEVEL_WARN, 0, "", __FILE__, __LINE__, __func__);
+  buffer.Format("%u log messages were dropped because a queue was full",
+                static_cast<unsigned>(dropped - reported_dropped_));
+  internal::WriteLog(buffer);
+  reported_dropped_ = dropped;
+}
+
+}  // namespace
+
+extern "C" void pw_log_basic_AsyncLog(int level,
+                                      unsigned int flags,
+                                      const char* module_name,
+                                      const char* file_name,
+                                      int line_number,
+                                      const char* function_name,
+                                      const char* message,
+                                      pw_tokenizer_ArgTypes types,
+                                      ...) {
+  va_list args;
+  va_start(args, types);
+  GetLogger().Log(level,
+                  flags,
+                  module_name,
+                  file_name,
+                  line_number,
+                  function_name,
+                  message,
+                  types,
+                  args);
+  va_end(args);
+}
+
+void FlushAsyncLogs() { GetLogger().Flush(); }
+
+size_t DroppedAsyncLogs() { return GetLogger().dropped(); }
+
+}  // namespace pw::log_basic
@@ -0,0 +1,73 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures the time a log call takes on the calling thread with the basic and
+// the asynchronous backends. The messages are discarded rather than written, so
+// the basic backend's time is mostly formatting.
+
+#include <string_view>
+
+#include "pw_assert/check.h"
+#include "pw_log/levels.h"
+#include "pw_log_basic/log_async.h"
+#include "pw_log_basic/log_basic.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_sys_io/sys_io.h"
+
+namespace pw::log_basic {
+namespace {
+
+constexpr std::string_view kMessageEnd = "of benchmark";
+
+// Discards the benchmark's messages, but keeps the perf test results, which
+// are logged through the same output.
+void DiscardBenchmarkMessages(std::string_view log) {
+  if (log.size() < kMessageEnd.size() ||
+      log.substr(log.size() - kMessageEnd.size()) != kMessageEnd) {
+    sys_io::WriteLine(log).IgnoreError();
+  }
+}
+
+void BasicLog(perf_test::State& state) {
+  SetOutput(DiscardBenchmarkMessages);
+  int i = 0;
+  while (state.KeepRunning()) {
+    pw_Log(PW_LOG_LEVEL_INFO,
+           0,
+           "PERF",
+           __FILE__,
+           __LINE__,
+           __func__,
+           "Message %d of %s",
+           ++i,
+           "benchmark");
+  }
+}
+
+void AsyncLog(perf_test::State& state) {
+  SetOutput(DiscardBenchmarkMessages);
+  int i = 0;
+  while (state.KeepRunning()) {
+    PW_LOG_BASIC_ASYNC_LOG(
+        PW_LOG_LEVEL_INFO, "PERF", 0, "Message %d of %s", ++i, "benchmark");
+  }
+  FlushAsyncLogs();
+  PW_CHECK_UINT_EQ(DroppedAsyncLogs(), 0);
+}
+
+PW_PERF_TEST(LogBasic_BasicLog, BasicLog);
+PW_PERF_TEST(LogBasic_AsyncLog, AsyncLog);
+
+}  // namespace
+}  // namespace pw::log_basic
@@ -0,0 +1,130 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_log_basic/log_async.h"
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "pw_log/levels.h"
+#include "pw_log_basic/log_basic.h"
+#include "pw_sys_io/sys_io.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::log_basic {
+namespace {
+
+std::mutex output_mutex;
+std::vector<std::string> output;
+
+void CaptureOutput(std::string_view log) {
+  std::lock_guard lock(output_mutex);
+  output.emplace_back(log);
+}
+
+void WriteOutput(std::string_view log) {
+  sys_io::WriteLine(log).IgnoreError();
+}
+
+// Test results are logged through pw_log_basic as well, so output is only
+// captured between StartCapture() and StopCapture().
+void StartCapture() {
+  FlushAsyncLogs();
+  std::lock_guard lock(output_mutex);
+  output.clear();
+  SetOutput(CaptureOutput);
+}
+
+// Restores the default output and returns the captured messages without their
+// prefixes. Queued messages are not flushed.
+std::vector<std::string> StopCapture() {
+  std::lock_guard lock(output_mutex);
+  SetOutput(WriteOutput);
+  std::vector<std::string> messages;
+  for (const std::string& line : output) {
+    messages.push_back(line.substr(line.find("  ") + 2));
+  }
+  return messages;
+}
+
+TEST(AsyncLog, FormatsArguments) {
+  StartCapture();
+  PW_LOG_BASIC_ASYNC_LOG(PW_LOG_LEVEL_INFO,
+                         "TST",
+                         0,
+                         "%d apples, %s and %#x",
+                         -3,
+                         "pears",
+                         0xbeefu);
+  FlushAsyncLogs();
+
+  const std::vector<std::string> messages = StopCapture();
+  ASSERT_EQ(messages.size(), 1u);
+  EXPECT_EQ(messages[0], "-3 apples, pears and 0xbeef");
+}
+
+TEST(AsyncLog, FlushWritesMessagesInLoggedOrder) {
+  constexpr int kMessagesPerThread = 50;
+  StartCapture();
+
+  PW_LOG_BASIC_ASYNC_LOG(PW_LOG_LEVEL_INFO, "TST", 0, "first");
+  auto log_messages = [](int thread) {
+    for (int i = 0; i < kMessagesPerThread; ++i) {
+      PW_LOG_BASIC_ASYNC_LOG(
+          PW_LOG_LEVEL_INFO, "TST", 0, "thread %d message %d", thread, i);
+    }
+  };
+  std::thread thread_0(log_messages, 0);
+  std::thread thread_1(log_messages, 1);
+  thread_0.join();
+  thread_1.join();
+  PW_LOG_BASIC_ASYNC_LOG(PW_LOG_LEVEL_INFO, "TST", 0, "last");
+  FlushAsyncLogs();
+
+  const std::vector<std::string> messages = StopCapture();
+  ASSERT_EQ(messages.size(), 2u + 2u * kMessagesPerThread);
+  EXPECT_EQ(messages.front(), "first");
+  EXPECT_EQ(messages.back(), "last");
+
+  int next_message[2] = {0, 0};
+  char expected[32];
+  for (size_t i = 1; i < messages.size() - 1; ++i) {
+    const int thread = messages[i].find("thread 1") == 0 ? 1 : 0;
+    std::snprintf(expected,
+                  sizeof(expected),
+                  "thread %d message %d",
+                  thread,
+                  next_message[thread]++);
+    EXPECT_EQ(messages[i], expected);
+  }
+  EXPECT_EQ(DroppedAsyncLogs(), 0u);
+}
+
+TEST(AsyncLog, CriticalMessageIsWrittenBeforeReturning) {
+  StartCapture();
+  PW_LOG_BASIC_ASYNC_LOG(PW_LOG_LEVEL_INFO, "TST", 0, "queued %d", 1);
+  PW_LOG_BASIC_ASYNC_LOG(PW_LOG_LEVEL_CRITICAL, "TST", 0, "critical %d", 2);
+
+  const std::vector<std::string> messages = StopCapture();
+  ASSERT_EQ(messages.size(), 2u);
+  EXPECT_EQ(messages[0], "queued 1");
+  EXPECT_EQ(messages[1], "critical 2");
+}
+
+}  // namespace
+}  // namespace pw::log_basic
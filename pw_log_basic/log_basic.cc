@@ -20,6 +20,7 @@
 
 #include "pw_log/levels.h"
 #include "pw_log_basic_private/config.h"
+#include "pw_log_basic_private/format.h"
 #include "pw_string/string_builder.h"
 #include "pw_sys_io/sys_io.h"
 
@@ -123,6 +124,30 @@ extern "C" void pw_Log_HandleMessageVaList(int level,
   // Accumulate the log message in this buffer, then output it.
   pw::StringBuffer<PW_LOG_BASIC_ENTRY_SIZE> buffer;
 
+  internal::AppendPrefix(buffer,
+                         level,
+                         flags,
+                         module_name,
+                         file_name,
+                         line_number,
+                         function_name);
+
+  // Column: Message
+  buffer.FormatVaList(message, args);
+
+  // All done; flush the log.
+  write_log(buffer);
+}
+
+namespace internal {
+
+void AppendPrefix(StringBuilder& buffer,
+                  int level,
+                  unsigned int flags,
+                  const char* module_name,
+                  const char* file_name,
+                  int line_number,
+                  const char* function_name) {
   // Column: Timestamp
   // Note that this macro method defaults to a no-op.
   PW_LOG_APPEND_TIMESTAMP(buffer);
@@ -165,13 +190,11 @@ extern "C" void pw_Log_HandleMessageVaList(int level,
 
   // Column: Level
   buffer << LogLevelToLogLevelName(level) << "  ";
+}
 
-  // Column: Message
-  buffer.FormatVaList(message, args);
+void WriteLog(std::string_view log) { write_log(log); }
 
-  // All done; flush the log.
-  write_log(buffer);
-}
+}  // namespace internal
 
 void SetOutput(void (*log_output)(std::string_view log)) {
   write_log = log_output;
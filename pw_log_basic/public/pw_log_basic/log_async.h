@@ -0,0 +1,73 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// An asynchronous variant of the basic log backend. The calling thread only
+// encodes the message arguments into a per-thread queue; a background thread
+// formats and writes the messages.
+#pragma once
+
+#include "pw_preprocessor/arguments.h"
+#include "pw_preprocessor/compiler.h"
+#include "pw_preprocessor/util.h"
+#include "pw_tokenizer/tokenize.h"
+
+PW_EXTERN_C_START
+
+// Queues a message with the listed attributes. The format string and the
+// module, file and function name strings must outlive the process, which holds
+// for string literals. Arguments are encoded with pw_tokenizer.
+void pw_log_basic_AsyncLog(int level,
+                           unsigned int flags,
+                           const char* module_name,
+                           const char* file_name,
+                           int line_number,
+                           const char* function_name,
+                           const char* message,
+                           pw_tokenizer_ArgTypes types,
+                           ...) PW_PRINTF_FORMAT(7, 9);
+
+PW_EXTERN_C_END
+
+// Log a message through the asynchronous backend. This is what PW_HANDLE_LOG
+// expands to when //pw_log_basic:async is the pw_log backend.
+#define PW_LOG_BASIC_ASYNC_LOG(level, module, flags, message, ...) \
+  do {                                                             \
+    pw_log_basic_AsyncLog((level),                                 \
+                          (flags),                                 \
+                          module,                                  \
+                          __FILE__,                                \
+                          __LINE__,                                \
+                          __func__,                                \
+                          message,                                 \
+                          PW_TOKENIZER_ARG_TYPES(__VA_ARGS__)      \
+                              PW_COMMA_ARGS(__VA_ARGS__));         \
+  } while (0)
+
+#ifdef __cplusplus
+
+#include <cstddef>
+
+namespace pw::log_basic {
+
+// Formats and writes all queued messages on the calling thread. Returns once
+// every message queued before the call has been written.
+void FlushAsyncLogs();
+
+// Returns the number of messages dropped because their thread's queue was
+// full. Dropped messages are also reported in the log output.
+size_t DroppedAsyncLogs();
+
+}  // namespace pw::log_basic
+
+#endif  // __cplusplus
@@ -74,3 +74,29 @@
 #ifndef PW_LOG_BASIC_ENTRY_SIZE
 #define PW_LOG_BASIC_ENTRY_SIZE 150
 #endif  // PW_LOG_BASIC_ENTRY_SIZE
+
+// The following options only apply to the asynchronous backend,
+// //pw_log_basic:async.
+
+// Number of threads that may log concurrently through their own queue. Threads
+// beyond this limit format and write their messages synchronously.
+#ifndef PW_LOG_BASIC_ASYNC_MAX_THREADS
+#define PW_LOG_BASIC_ASYNC_MAX_THREADS 16
+#endif  // PW_LOG_BASIC_ASYNC_MAX_THREADS
+
+// Number of messages each thread can have queued before messages are dropped.
+#ifndef PW_LOG_BASIC_ASYNC_QUEUE_SIZE_ENTRIES
+#define PW_LOG_BASIC_ASYNC_QUEUE_SIZE_ENTRIES 128
+#endif  // PW_LOG_BASIC_ASYNC_QUEUE_SIZE_ENTRIES
+
+// Maximum size of the encoded arguments of a queued message. Arguments that do
+// not fit, such as long strings, are truncated.
+#ifndef PW_LOG_BASIC_ASYNC_ARGS_SIZE_BYTES
+#define PW_LOG_BASIC_ASYNC_ARGS_SIZE_BYTES 64
+#endif  // PW_LOG_BASIC_ASYNC_ARGS_SIZE_BYTES
+
+// Installs handlers for crash signals (SIGABRT, SIGSEGV, SIGILL and SIGFPE)
+// that write out queued messages before the process terminates.
+#ifndef PW_LOG_BASIC_ASYNC_FLUSH_ON_CRASH
+#define PW_LOG_BASIC_ASYNC_FLUSH_ON_CRASH 1
+#endif  // PW_LOG_BASIC_ASYNC_FLUSH_ON_CRASH
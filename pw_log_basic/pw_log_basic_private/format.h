@@ -0,0 +1,36 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <string_view>
+
+#include "pw_string/string_builder.h"
+
+// Output helpers shared by the synchronous and asynchronous backends, so both
+// produce identical log lines.
+namespace pw::log_basic::internal {
+
+// Appends the configured columns that precede the message to the buffer.
+void AppendPrefix(StringBuilder& buffer,
+                  int level,
+                  unsigned int flags,
+                  const char* module_name,
+                  const char* file_name,
+                  int line_number,
+                  const char* function_name);
+
+// Writes a completed log line to the output selected with SetOutput().
+void WriteLog(std::string_view log);
+
+}  // namespace pw::log_basic::internal
@@ -0,0 +1,262 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string_view>
+#include <type_traits>
+
+#include "pw_log_tokenized/config.h"
+#include "pw_preprocessor/apply.h"
+#include "pw_preprocessor/arguments.h"
+#include "pw_tokenizer/tokenize.h"
+
+/// @module{pw_log_tokenized}
+
+/// Names a value in a `PW_LOG_TOKENIZED_STRUCTURED` log. The key must be a
+/// string literal that is a valid C identifier.
+#define PW_LOG_TOKENIZED_KV(key, value) (key, value)
+
+/// Logs a message with named fields instead of printf-style arguments. Each
+/// field is specified with `PW_LOG_TOKENIZED_KV`. For example:
+///
+/// @code{.cpp}
+///   PW_LOG_TOKENIZED_STRUCTURED(PW_LOG_LEVEL_WARN,
+///                               PW_LOG_MODULE_NAME,
+///                               0,
+///                               "Connection lost",
+///                               PW_LOG_TOKENIZED_KV("rssi", rssi),
+///                               PW_LOG_TOKENIZED_KV("peer", peer_name));
+/// @endcode
+///
+/// The field names and types are appended to the tokenized string at compile
+/// time as a schema (e.g. `■fields♦rssi:i,peer:s`), so they do not occupy space
+/// in the binary. Each field is encoded as its varint index in the schema
+/// followed by its value. Fields that do not fit in the encoding buffer are
+/// dropped. Like `PW_LOG_TOKENIZED_TO_GLOBAL_HANDLER_WITH_METADATA`, the log is
+/// passed to `pw_log_tokenized_HandleLog()` without filtering.
+///
+/// Values may be booleans, integers, enums, floating point numbers (encoded as
+/// `float`), or strings (`const char*` or `std::string_view`). Strings longer
+/// than 127 bytes are truncated.
+///
+/// Use `pw::log_tokenized::StructuredLogDecoder` to decode these logs on the
+/// host.
+#define PW_LOG_TOKENIZED_STRUCTURED(level, module, flags, message, ...)        \
+  do {                                                                         \
+    static_assert(PW_FUNCTION_ARG_COUNT(__VA_ARGS__) > 0,                      \
+                  "Structured logs must have at least one field");             \
+    static constexpr auto _pw_log_tokenized_format =                           \
+        ::pw::log_tokenized::internal::MakeStructuredFormat<PW_APPLY(          \
+            _PW_LOG_TOKENIZED_KV_TYPE,                                         \
+            _PW_LOG_TOKENIZED_KV_COMMA,                                        \
+            _,                                                                 \
+            __VA_ARGS__)>(PW_LOG_TOKENIZED_FORMAT_STRING(module, message),     \
+                          PW_APPLY(_PW_LOG_TOKENIZED_KV_KEY,                   \
+                                   _PW_LOG_TOKENIZED_KV_COMMA,                 \
+                                   _,                                          \
+                                   __VA_ARGS__));                              \
+    static_assert(_pw_log_tokenized_format.valid_keys,                         \
+                  "Structured log keys must be valid C identifiers");          \
+    static constexpr pw_tokenizer_Token _pw_log_tokenized_token =              \
+        PW_TOKENIZER_STRING_TOKEN(_pw_log_tokenized_format.string);            \
+    PW_TOKENIZER_DEFINE_TOKEN(_pw_log_tokenized_token,                         \
+                              PW_TOKENIZER_DEFAULT_DOMAIN,                     \
+                              _pw_log_tokenized_format.string);                \
+    static constexpr uintptr_t _pw_log_tokenized_module_token =                \
+        PW_TOKENIZE_STRING_MASK("pw_log_module_names",                         \
+                                ((1u << PW_LOG_TOKENIZED_MODULE_BITS) - 1u),   \
+                                module);                                       \
+    const uintptr_t _pw_log_tokenized_level = level;                           \
+    ::pw::log_tokenized::internal::EncodeStructuredLog(                        \
+        static_cast<uint32_t>(                                                 \
+            _PW_LOG_TOKENIZED_LEVEL(_pw_log_tokenized_level) |                 \
+            _PW_LOG_TOKENIZED_MODULE(_pw_log_tokenized_module_token) |         \
+            _PW_LOG_TOKENIZED_FLAGS(flags) |                                   \
+            _PW_LOG_TOKENIZED_LINE(__LINE__)),                                 \
+        _pw_log_tokenized_token,                                               \
+        {PW_APPLY(_PW_LOG_TOKENIZED_KV_VALUE,                                  \
+                  _PW_LOG_TOKENIZED_KV_COMMA,                                  \
+                  _,                                                           \
+                  __VA_ARGS__)});                                              \
+  } while (0)
+
+/// @endmodule
+
+/// @cond
+
+#define _PW_LOG_TOKENIZED_KV_COMMA(index, unused) ,
+
+#define _PW_LOG_TOKENIZED_KV_KEY(index, unused, key_value) \
+  _PW_LOG_TOKENIZED_KV_KEY_IMPL key_value
+#define _PW_LOG_TOKENIZED_KV_KEY_IMPL(key, value) key
+
+#define _PW_LOG_TOKENIZED_KV_TYPE(index, unused, key_value) \
+  decltype(_PW_LOG_TOKENIZED_KV_VALUE_IMPL key_value)
+
+#define _PW_LOG_TOKENIZED_KV_VALUE(index, unused, key_value) \
+  ::pw::log_tokenized::internal::FieldValue(                 \
+      _PW_LOG_TOKENIZED_KV_VALUE_IMPL key_value)
+#define _PW_LOG_TOKENIZED_KV_VALUE_IMPL(key, value) (value)
+
+namespace pw::log_tokenized::internal {
+
+// Marks the start of the schema in a structured log's tokenized string.
+inline constexpr char kStructuredFieldsKey[] =
+    PW_LOG_TOKENIZED_FIELD_PREFIX "fields" PW_LOG_TOKENIZED_KEY_VALUE_SEPARATOR;
+
+// Type codes used in the schema. The encoding of each type is:
+//
+//   kSigned, kChar      ZigZag varint
+//   kUnsigned, kBool    varint
+//   kFloat              little-endian float
+//   kString             1-byte length (top bit set if truncated), then bytes
+//
+enum FieldType : char {
+  kBool = 'b',
+  kChar = 'c',
+  kSigned = 'i',
+  kUnsigned = 'u',
+  kFloat = 'f',
+  kString = 's',
+};
+
+template <typename T>
+struct UnsupportedFieldType : std::false_type {};
+
+template <typename T>
+constexpr FieldType GetFieldType() {
+  using Type = std::remove_cv_t<std::remove_reference_t<T>>;
+  if constexpr (std::is_same_v<Type, bool>) {
+    return kBool;
+  } else if constexpr (std::is_same_v<Type, char>) {
+    return kChar;
+  } else if constexpr (std::is_enum_v<Type>) {
+    return std::is_signed_v<std::underlying_type_t<Type>> ? kSigned
+                                                          : kUnsigned;
+  } else if constexpr (std::is_integral_v<Type>) {
+    return std::is_signed_v<Type> ? kSigned : kUnsigned;
+  } else if constexpr (std::is_floating_point_v<Type>) {
+    return kFloat;
+  } else if constexpr (std::is_convertible_v<Type, std::string_view>) {
+    return kString;
+  } else {
+    static_assert(UnsupportedFieldType<Type>(),
+                  "Structured log fields must be booleans, integers, enums, "
+                  "floating point numbers, or strings");
+    return kBool;
+  }
+}
+
+// A tokenized string with a schema of the fields that follow it.
+template <size_t kSize>
+struct StructuredFormat {
+  char string[kSize];
+  bool valid_keys;
+};
+
+constexpr bool IsValidKey(std::string_view key) {
+  if (key.empty() || (key[0] >= '0' && key[0] <= '9')) {
+    return false;
+  }
+  for (char c : key) {
+    if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+          (c >= '0' && c <= '9') || c == '_')) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Appends "■fields♦key:type,key:type" to the format string.
+template <typename... Types, size_t kFormatSize, size_t... kKeySizes>
+constexpr auto MakeStructuredFormat(const char (&format)[kFormatSize],
+                                    const char (&... keys)[kKeySizes]) {
+  static_assert(sizeof...(Types) == sizeof...(kKeySizes));
+
+  constexpr size_t kSize = (kFormatSize - 1) +
+                           (sizeof(kStructuredFieldsKey) - 1) +
+                           ((kKeySizes - 1 + 3) + ...);  // "key:t," and '\0'
+  StructuredFormat<kSize> result{};
+  result.valid_keys = true;
+
+  size_t size = 0;
+  auto append = [&result, &size](std::string_view text) {
+    for (char c : text) {
+      result.string[size++] = c;
+    }
+  };
+  append(std::string_view(format, kFormatSize - 1));
+  append(std::string_view(kStructuredFieldsKey,
+                          sizeof(kStructuredFieldsKey) - 1));
+
+  const std::string_view key_views[] = {std::string_view(keys)...};
+  const FieldType types[] = {GetFieldType<Types>()...};
+  for (size_t i = 0; i < sizeof...(Types); ++i) {
+    result.valid_keys = result.valid_keys && IsValidKey(key_views[i]);
+    if (i != 0) {
+      append(",");
+    }
+    append(key_views[i]);
+    append(":");
+    result.string[size++] = types[i];
+  }
+  result.string[size] = '\0';
+  return result;
+}
+
+// A structured log field value, with its type erased.
+class FieldValue {
+ public:
+  template <typename T>
+  constexpr FieldValue(const T& value)
+      : type_(GetFieldType<T>()), integer_(0), string_() {
+    if constexpr (std::is_same_v<T, char*> || std::is_same_v<T, const char*>) {
+      string_ = value == nullptr ? "NULL" : value;
+    } else if constexpr (GetFieldType<T>() == kString) {
+      string_ = value;
+    } else if constexpr (GetFieldType<T>() == kFloat) {
+      float_ = static_cast<float>(value);
+    } else if constexpr (GetFieldType<T>() == kSigned ||
+                         GetFieldType<T>() == kChar) {
+      integer_ = static_cast<uint64_t>(static_cast<int64_t>(value));
+    } else {
+      integer_ = static_cast<uint64_t>(value);
+    }
+  }
+
+  constexpr FieldType type() const { return type_; }
+  constexpr uint64_t integer() const { return integer_; }
+  constexpr float floating_point() const { return float_; }
+  constexpr std::string_view string() const { return string_; }
+
+ private:
+  FieldType type_;
+  union {
+    uint64_t integer_;
+    float float_;
+  };
+  std::string_view string_;
+};
+
+// Encodes the token and fields and passes them to pw_log_tokenized_HandleLog.
+void EncodeStructuredLog(uint32_t metadata,
+                         pw_tokenizer_Token token,
+                         std::initializer_list<FieldValue> fields);
+
+}  // namespace pw::log_tokenized::internal
+
+/// @endcond
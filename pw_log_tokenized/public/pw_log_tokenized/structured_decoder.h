@@ -0,0 +1,86 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "pw_log_tokenized/metadata.h"
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_tokenizer/detokenize.h"
+
+namespace pw::log_tokenized {
+
+/// @module{pw_log_tokenized}
+
+/// A log record decoded by `StructuredLogDecoder`.
+struct StructuredLog {
+  /// A named field from a `PW_LOG_TOKENIZED_STRUCTURED` log.
+  struct Field {
+    std::string key;
+    std::variant<bool, int64_t, uint64_t, float, std::string> value;
+  };
+
+  Metadata metadata = 0;
+  std::string message;
+  std::string module;
+  std::string file;
+
+  /// Fields in the order they were logged. Empty for logs with printf-style
+  /// arguments. Fields that did not fit in the device's encoding buffer are
+  /// missing.
+  std::vector<Field> fields;
+
+  /// Formats the log as a single line of JSON, without a trailing newline.
+  /// For example:
+  ///
+  /// @code{.json}
+  ///   {"level": 3, "line": 42, "flags": 0, "msg": "Connection lost",
+  ///    "module": "BLE", "file": "ble.cc", "fields": {"rssi": -70}}
+  /// @endcode
+  ///
+  /// `"module"` and `"file"` are omitted if empty, and `"fields"` is omitted
+  /// for logs without named fields. Non-finite floats are written as `null`.
+  std::string ToJson() const;
+};
+
+/// Decodes logs from `pw_log_tokenized`, including logs with named fields from
+/// `PW_LOG_TOKENIZED_STRUCTURED`, into `StructuredLog` records. Fields are read
+/// according to the schema in the token database, so log analysis tools can
+/// filter on them without parsing the formatted text.
+class StructuredLogDecoder {
+ public:
+  explicit StructuredLogDecoder(const tokenizer::Detokenizer& detokenizer)
+      : detokenizer_(detokenizer) {}
+
+  /// Decodes a log passed to `pw_log_tokenized_HandleLog()`.
+  ///
+  /// @returns
+  /// * @OK: The log was decoded.
+  /// * @NOT_FOUND: The token is not in the database.
+  /// * @DATA_LOSS: The encoded log is malformed or does not match the schema.
+  Result<StructuredLog> Decode(uint32_t metadata,
+                               span<const std::byte> encoded) const;
+
+ private:
+  const tokenizer::Detokenizer& detokenizer_;
+};
+
+/// @endmodule
+
+}  // namespace pw::log_tokenized
@@ -0,0 +1,94 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_log_tokenized/structured.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "pw_bytes/endian.h"
+#include "pw_bytes/span.h"
+#include "pw_log_tokenized/handler.h"
+#include "pw_varint/varint.h"
+
+namespace pw::log_tokenized::internal {
+namespace {
+
+// Encodes the value; returns the number of bytes written or 0 if it didn't fit.
+size_t EncodeValue(const FieldValue& field, ByteSpan output) {
+  switch (field.type()) {
+    case kSigned:
+    case kChar:
+      return varint::Encode(static_cast<int64_t>(field.integer()), output);
+    case kUnsigned:
+    case kBool:
+      return varint::Encode(field.integer(), output);
+    case kFloat: {
+      const float value = field.floating_point();
+      if (output.size() < sizeof(value)) {
+        return 0;
+      }
+      uint32_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      bytes::CopyInOrder(endian::little, bits, output.data());
+      return sizeof(bits);
+    }
+    case kString: {
+      if (output.empty()) {
+        return 0;
+      }
+      // Like tokenized string arguments, strings are prefixed with a one byte
+      // length. The top bit is set if the string was truncated.
+      constexpr size_t kMaxLength = 0x7f;
+      const std::string_view string = field.string();
+      const size_t length =
+          std::min({string.size(), output.size() - 1, kMaxLength});
+      output[0] = static_cast<std::byte>(
+          length | (length < string.size() ? 0x80u : 0u));
+      std::memcpy(&output[1], string.data(), length);
+      return 1 + length;
+    }
+  }
+  return 0;
+}
+
+}  // namespace
+
+void EncodeStructuredLog(uint32_t metadata,
+                         pw_tokenizer_Token token,
+                         std::initializer_list<FieldValue> fields) {
+  std::byte buffer[kEncodingBufferSizeBytes];
+  bytes::CopyInOrder(endian::little, token, buffer);
+  size_t size = sizeof(token);
+
+  uint32_t id = 0;
+  for (const FieldValue& field : fields) {
+    const size_t id_size = varint::Encode(id, span(buffer).subspan(size));
+    if (id_size == 0) {
+      break;
+    }
+    const size_t value_size =
+        EncodeValue(field, span(buffer).subspan(size + id_size));
+    if (value_size == 0) {
+      break;  // Drop fields that do not fit.
+    }
+    size += id_size + value_size;
+    id += 1;
+  }
+
+  pw_log_tokenized_HandleLog(
+      metadata, reinterpret_cast<const uint8_t*>(buffer), size);
+}
+
+}  // namespace pw::log_tokenized::internal
@@ -0,0 +1,279 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_log_tokenized/structured_decoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+
+#include "pw_bytes/endian.h"
+#include "pw_log_tokenized/fields.h"
+#include "pw_log_tokenized/structured.h"
+#include "pw_status/try.h"
+#include "pw_string/type_to_string.h"
+#include "pw_varint/varint.h"
+
+namespace pw::log_tokenized {
+namespace {
+
+using internal::FieldType;
+
+struct SchemaEntry {
+  std::string_view key;
+  FieldType type;
+};
+
+// Parses a schema in the "key:t,key:t" format written by MakeStructuredFormat.
+Status ParseSchema(std::string_view schema, std::vector<SchemaEntry>& entries) {
+  while (!schema.empty()) {
+    const size_t end = std::min(schema.find(','), schema.size());
+    const std::string_view entry = schema.substr(0, end);
+    if (entry.size() < 3 || entry[entry.size() - 2] != ':') {
+      return Status::DataLoss();
+    }
+    entries.push_back({entry.substr(0, entry.size() - 2),
+                       static_cast<FieldType>(entry.back())});
+    schema.remove_prefix(std::min(end + 1, schema.size()));
+  }
+  return OkStatus();
+}
+
+template <typename T>
+Status DecodeVarint(span<const std::byte>& data, T& value) {
+  const size_t bytes = varint::Decode(data, &value);
+  if (bytes == 0) {
+    return Status::DataLoss();
+  }
+  data = data.subspan(bytes);
+  return OkStatus();
+}
+
+Status DecodeValue(FieldType type,
+                   span<const std::byte>& data,
+                   StructuredLog::Field& field) {
+  switch (type) {
+    case internal::kSigned: {
+      int64_t value;
+      PW_TRY(DecodeVarint(data, value));
+      field.value = value;
+      return OkStatus();
+    }
+    case internal::kChar: {
+      int64_t value;
+      PW_TRY(DecodeVarint(data, value));
+      field.value = std::string(1, static_cast<char>(value));
+      return OkStatus();
+    }
+    case internal::kUnsigned: {
+      uint64_t value;
+      PW_TRY(DecodeVarint(data, value));
+      field.value = value;
+      return OkStatus();
+    }
+    case internal::kBool: {
+      uint64_t value;
+      PW_TRY(DecodeVarint(data, value));
+      field.value = value != 0;
+      return OkStatus();
+    }
+    case internal::kFloat: {
+      if (data.size() < sizeof(float)) {
+        return Status::DataLoss();
+      }
+      const uint32_t bits =
+          bytes::ReadInOrder<uint32_t>(endian::little, data.data());
+      float value;
+      std::memcpy(&value, &bits, sizeof(value));
+      field.value = value;
+      data = data.subspan(sizeof(value));
+      return OkStatus();
+    }
+    case internal::kString: {
+      if (data.empty()) {
+        return Status::DataLoss();
+      }
+      const size_t length = static_cast<size_t>(data[0]) & 0x7fu;
+      if (data.size() < 1 + length) {
+        return Status::DataLoss();
+      }
+      field.value =
+          std::string(reinterpret_cast<const char*>(&data[1]), length);
+      data = data.subspan(1 + length);
+      return OkStatus();
+    }
+  }
+  return Status::DataLoss();  // Unknown type in the schema
+}
+
+Status DecodeFields(std::string_view schema,
+                    span<const std::byte> data,
+                    std::vector<StructuredLog::Field>& fields) {
+  std::vector<SchemaEntry> entries;
+  PW_TRY(ParseSchema(schema, entries));
+
+  while (!data.empty()) {
+    uint64_t id;
+    PW_TRY(DecodeVarint(data, id));
+    if (id >= entries.size()) {
+      return Status::DataLoss();
+    }
+    StructuredLog::Field& field = fields.emplace_back();
+    field.key = entries[id].key;
+    PW_TRY(DecodeValue(entries[id].type, data, field));
+  }
+  return OkStatus();
+}
+
+// Sets the message, module, and file from the format string fields.
+void SetMessage(std::string_view text, StructuredLog& log) {
+  const StatusWithSize result =
+      ParseFields(text, [&log](std::string_view key, std::string_view value) {
+        if (key == "msg") {
+          log.message = value;
+        } else if (key == "module") {
+          log.module = value;
+        } else if (key == "file") {
+          log.file = value;
+        }
+      });
+  if (result.size() == 0) {
+    log.message = text;
+  }
+}
+
+// Appends a quoted string, escaped like pw::JsonBuilder escapes strings.
+void AppendString(std::string& json, std::string_view value) {
+  json.push_back('"');
+  for (char c : value) {
+    if (c >= '\b' && c <= '\r' && c != '\v') {
+      constexpr char kControlChars[] = {'b', 't', 'n', '?', 'f', 'r'};
+      json.push_back('\\');
+      json.push_back(kControlChars[c - '\b']);
+    } else if (c == '"' || c == '\\') {
+      json.push_back('\\');
+      json.push_back(c);
+    } else if (c >= ' ' && c <= '~') {
+      json.push_back(c);
+    } else {
+      constexpr char kHex[] = "0123456789abcdef";
+      json.append("\\u00");
+      json.push_back(kHex[(c >> 4) & 0xf]);
+      json.push_back(kHex[c & 0xf]);
+    }
+  }
+  json.push_back('"');
+}
+
+void AppendKey(std::string& json, std::string_view key) {
+  if (json.size() > 1) {
+    json.append(", ");
+  }
+  AppendString(json, key);
+  json.append(": ");
+}
+
+struct AppendValue {
+  void operator()(bool value) const { json.append(value ? "true" : "false"); }
+  void operator()(int64_t value) const { json.append(std::to_string(value)); }
+  void operator()(uint64_t value) const { json.append(std::to_string(value)); }
+  void operator()(float value) const {
+    if (!std::isfinite(value)) {
+      json.append("null");
+      return;
+    }
+    char buffer[32];
+    const StatusWithSize result = string::FloatToString(value, buffer);
+    json.append(buffer, result.size());
+  }
+  void operator()(const std::string& value) const { AppendString(json, value); }
+
+  std::string& json;
+};
+
+}  // namespace
+
+std::string StructuredLog::ToJson() const {
+  std::string json = "{";
+  AppendKey(json, "level");
+  AppendValue{json}(static_cast<uint64_t>(metadata.level()));
+  AppendKey(json, "line");
+  AppendValue{json}(static_cast<uint64_t>(metadata.line_number()));
+  AppendKey(json, "flags");
+  AppendValue{json}(static_cast<uint64_t>(metadata.flags()));
+  AppendKey(json, "msg");
+  AppendString(json, message);
+  if (!module.empty()) {
+    AppendKey(json, "module");
+    AppendString(json, module);
+  }
+  if (!file.empty()) {
+    AppendKey(json, "file");
+    AppendString(json, file);
+  }
+  if (!fields.empty()) {
+    AppendKey(json, "fields");
+    json.push_back('{');
+    for (size_t i = 0; i < fields.size(); ++i) {
+      if (i != 0) {
+        json.append(", ");
+      }
+      AppendString(json, fields[i].key);
+      json.append(": ");
+      std::visit(AppendValue{json}, fields[i].value);
+    }
+    json.push_back('}');
+  }
+  json.push_back('}');
+  return json;
+}
+
+Result<StructuredLog> StructuredLogDecoder::Decode(
+    uint32_t metadata, span<const std::byte> encoded) const {
+  if (encoded.size() < sizeof(tokenizer::Token)) {
+    return Status::DataLoss();
+  }
+  const tokenizer::Token token =
+      bytes::ReadInOrder<tokenizer::Token>(endian::little, encoded.data());
+  const span<const tokenizer::TokenizedStringEntry> entries =
+      detokenizer_.DatabaseLookup(token, PW_TOKENIZER_DEFAULT_DOMAIN);
+  if (entries.empty()) {
+    return Status::NotFound();
+  }
+
+  StructuredLog log;
+  log.metadata = metadata;
+
+  const std::string format = entries[0].first.text();
+  const size_t schema = format.rfind(internal::kStructuredFieldsKey);
+  if (schema == std::string::npos) {  // printf-style arguments
+    const tokenizer::DetokenizedString detokenized =
+        detokenizer_.Detokenize(encoded);
+    if (detokenized.matches().empty()) {
+      return Status::DataLoss();
+    }
+    SetMessage(detokenized.BestString(), log);
+    return log;
+  }
+
+  PW_TRY(DecodeFields(std::string_view(format).substr(
+                          schema + std::strlen(internal::kStructuredFieldsKey)),
+                      encoded.subspan(sizeof(token)),
+                      log.fields));
+  SetMessage(std::string_view(format).substr(0, schema), log);
+  return log;
+}
+
+}  // namespace pw::log_tokenized
@@ -0,0 +1,270 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_log_tokenized/structured.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "pw_log/levels.h"
+#include "pw_log_tokenized/handler.h"
+#include "pw_log_tokenized/metadata.h"
+#include "pw_log_tokenized/structured_decoder.h"
+#include "pw_tokenizer/detokenize.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::log_tokenized {
+namespace {
+
+using namespace std::string_view_literals;
+
+uint32_t last_metadata;
+std::vector<std::byte> last_log;
+
+}  // namespace
+
+extern "C" void pw_log_tokenized_HandleLog(uint32_t metadata,
+                                           const uint8_t encoded_message[],
+                                           size_t size_bytes) {
+  last_metadata = metadata;
+  const std::byte* data = reinterpret_cast<const std::byte*>(encoded_message);
+  last_log.assign(data, data + size_bytes);
+}
+
+namespace {
+
+#define FORMAT_STRING(message) \
+  "■msg♦" message "■module♦TEST■file♦" __FILE__ "■fields♦"
+
+enum class Mode : uint8_t { kIdle = 3 };
+
+static_assert(std::string_view(internal::MakeStructuredFormat<int>("x", "a")
+                                   .string) == "x■fields♦a:i"sv);
+static_assert(
+    std::string_view(internal::MakeStructuredFormat<bool,
+                                                     char,
+                                                     int64_t,
+                                                     unsigned,
+                                                     Mode,
+                                                     double,
+                                                     const char*,
+                                                     std::string_view>(
+                         "", "b", "c", "i", "u", "e", "f", "s", "sv")
+                         .string) ==
+    "■fields♦b:b,c:c,i:i,u:u,e:u,f:f,s:s,sv:s"sv);
+static_assert(internal::MakeStructuredFormat<int>("", "key_1").valid_keys);
+static_assert(!internal::MakeStructuredFormat<int>("", "1key").valid_keys);
+static_assert(!internal::MakeStructuredFormat<int>("", "a-b").valid_keys);
+static_assert(!internal::MakeStructuredFormat<int>("", "").valid_keys);
+
+std::vector<std::byte> Bytes(std::initializer_list<uint8_t> bytes) {
+  std::vector<std::byte> result;
+  for (uint8_t byte : bytes) {
+    result.push_back(static_cast<std::byte>(byte));
+  }
+  return result;
+}
+
+std::vector<std::byte> TokenBytes(std::string_view string) {
+  const uint32_t token = tokenizer::Hash(string);
+  return Bytes({static_cast<uint8_t>(token),
+                static_cast<uint8_t>(token >> 8),
+                static_cast<uint8_t>(token >> 16),
+                static_cast<uint8_t>(token >> 24)});
+}
+
+std::vector<std::byte> Concat(std::vector<std::byte> first,
+                              const std::vector<std::byte>& second) {
+  first.insert(first.end(), second.begin(), second.end());
+  return first;
+}
+
+TEST(StructuredLog, EncodesFieldIdsAndValues) {
+  const int rssi = -70;
+  PW_LOG_TOKENIZED_STRUCTURED(PW_LOG_LEVEL_WARN,
+                              "TEST",
+                              1,
+                              "Connection lost",
+                              PW_LOG_TOKENIZED_KV("rssi", rssi),
+                              PW_LOG_TOKENIZED_KV("peer", "abc"),
+                              PW_LOG_TOKENIZED_KV("ok", true),
+                              PW_LOG_TOKENIZED_KV("ratio", 0.5f));
+
+  const Metadata metadata(last_metadata);
+  EXPECT_EQ(metadata.level(), static_cast<uint32_t>(PW_LOG_LEVEL_WARN));
+  EXPECT_EQ(metadata.flags(), 1u);
+  EXPECT_EQ(metadata.module(),
+            PW_TOKENIZER_STRING_TOKEN("TEST") &
+                ((1u << PW_LOG_TOKENIZED_MODULE_BITS) - 1));
+
+  EXPECT_EQ(last_log,
+            Concat(TokenBytes(FORMAT_STRING("Connection lost") "rssi:i,peer:"
+                                                              "s,ok:b,ratio:f"),
+                   Bytes({0x00, 139, 0x01,  // id 0 (rssi): -70 zigzag
+                          0x01, 0x03, 'a', 'b', 'c',  // id 1 (peer): "abc"
+                          0x02, 0x01,                 // id 2 (ok): true
+                          0x03, 0x00, 0x00, 0x00, 0x3f})));  // id 3: 0.5f
+}
+
+TEST(StructuredLog, NullString) {
+  const char* name = nullptr;
+  PW_LOG_TOKENIZED_STRUCTURED(
+      PW_LOG_LEVEL_INFO, "TEST", 0, "", PW_LOG_TOKENIZED_KV("name", name));
+  EXPECT_EQ(last_log,
+            Concat(TokenBytes(FORMAT_STRING("") "name:s"),
+                   Bytes({0x00, 0x04, 'N', 'U', 'L', 'L'})));
+}
+
+TEST(StructuredLog, FieldsThatDoNotFit_AreTruncatedOrDropped) {
+  const std::string_view long_string(
+      "0123456789012345678901234567890123456789012345678901234567890123456789"
+      "0123456789012345678901234567890123456789012345678901234567890123456789");
+  PW_LOG_TOKENIZED_STRUCTURED(PW_LOG_LEVEL_INFO,
+                              "TEST",
+                              0,
+                              "",
+                              PW_LOG_TOKENIZED_KV("long", long_string),
+                              PW_LOG_TOKENIZED_KV("dropped", 1));
+
+  // The token, field ID, and length prefix take 6 bytes.
+  const size_t length = std::min<size_t>(kEncodingBufferSizeBytes - 6, 0x7f);
+  ASSERT_EQ(last_log.size(), 6 + length);
+  EXPECT_EQ(last_log[5], static_cast<std::byte>(0x80 | length));
+  EXPECT_EQ(std::memcmp(&last_log[6], long_string.data(), length), 0);
+}
+
+class StructuredLogDecoderTest : public ::testing::Test {
+ protected:
+  StructuredLogDecoderTest()
+      : detokenizer_(Database()), decoder_(detokenizer_) {}
+
+  static constexpr const char* kStrings[] = {
+      FORMAT_STRING("Connection lost") "rssi:i,peer:s,ok:b,ratio:f",
+      FORMAT_STRING("Mode changed") "mode:u,code:c",
+      "■msg♦Temperature is %d C■module♦TEST■file♦temp.cc",
+      "No fields %s",
+  };
+
+  static tokenizer::DomainTokenEntriesMap Database() {
+    tokenizer::DomainTokenEntriesMap database;
+    for (const char* string : kStrings) {
+      database[""][tokenizer::Hash(std::string_view(string))].emplace_back(
+          tokenizer::FormatString(string),
+          tokenizer::TokenDatabase::kDateRemovedNever);
+    }
+    return database;
+  }
+
+  tokenizer::Detokenizer detokenizer_;
+  StructuredLogDecoder decoder_;
+};
+
+TEST_F(StructuredLogDecoderTest, RoundTrip) {
+  const int rssi = -70;
+  PW_LOG_TOKENIZED_STRUCTURED(PW_LOG_LEVEL_WARN,
+                              "TEST",
+                              1,
+                              "Connection lost",
+                              PW_LOG_TOKENIZED_KV("rssi", rssi),
+                              PW_LOG_TOKENIZED_KV("peer", "ab\"c"),
+                              PW_LOG_TOKENIZED_KV("ok", true),
+                              PW_LOG_TOKENIZED_KV("ratio", 0.25));
+
+  Result<StructuredLog> log = decoder_.Decode(last_metadata, last_log);
+  ASSERT_EQ(OkStatus(), log.status());
+  EXPECT_EQ(log->message, "Connection lost");
+  EXPECT_EQ(log->module, "TEST");
+  EXPECT_EQ(log->file, __FILE__);
+  ASSERT_EQ(log->fields.size(), 4u);
+  EXPECT_EQ(log->fields[0].key, "rssi");
+  EXPECT_EQ(std::get<int64_t>(log->fields[0].value), -70);
+  EXPECT_EQ(log->fields[1].key, "peer");
+  EXPECT_EQ(std::get<std::string>(log->fields[1].value), "ab\"c");
+  EXPECT_EQ(log->fields[2].key, "ok");
+  EXPECT_TRUE(std::get<bool>(log->fields[2].value));
+  EXPECT_EQ(log->fields[3].key, "ratio");
+  EXPECT_EQ(std::get<float>(log->fields[3].value), 0.25f);
+
+  const std::string line =
+      "{\"level\": " + std::to_string(PW_LOG_LEVEL_WARN) +
+      ", \"line\": " + std::to_string(Metadata(last_metadata).line_number()) +
+      ", \"flags\": 1, \"msg\": \"Connection lost\", \"module\": \"TEST\", "
+      "\"file\": \"" __FILE__
+      "\", \"fields\": {\"rssi\": -70, \"peer\": \"ab\\\"c\", "
+      "\"ok\": true, \"ratio\": 0.25}}";
+  EXPECT_EQ(log->ToJson(), line);
+}
+
+TEST_F(StructuredLogDecoderTest, EnumAndChar) {
+  PW_LOG_TOKENIZED_STRUCTURED(PW_LOG_LEVEL_INFO,
+                              "TEST",
+                              0,
+                              "Mode changed",
+                              PW_LOG_TOKENIZED_KV("mode", Mode::kIdle),
+                              PW_LOG_TOKENIZED_KV("code", 'x'));
+
+  Result<StructuredLog> log = decoder_.Decode(last_metadata, last_log);
+  ASSERT_EQ(OkStatus(), log.status());
+  ASSERT_EQ(log->fields.size(), 2u);
+  EXPECT_EQ(std::get<uint64_t>(log->fields[0].value), 3u);
+  EXPECT_EQ(std::get<std::string>(log->fields[1].value), "x");
+}
+
+TEST_F(StructuredLogDecoderTest, PrintfStyleLog) {
+  const std::vector<std::byte> encoded =
+      Concat(TokenBytes(kStrings[2]), Bytes({0x2a}));  // 21 zigzag encoded
+
+  Result<StructuredLog> log = decoder_.Decode(0, encoded);
+  ASSERT_EQ(OkStatus(), log.status());
+  EXPECT_EQ(log->message, "Temperature is 21 C");
+  EXPECT_EQ(log->module, "TEST");
+  EXPECT_EQ(log->file, "temp.cc");
+  EXPECT_TRUE(log->fields.empty());
+  EXPECT_EQ(log->ToJson(),
+            "{\"level\": 0, \"line\": 0, \"flags\": 0, \"msg\": "
+            "\"Temperature is 21 C\", \"module\": \"TEST\", \"file\": "
+            "\"temp.cc\"}");
+}
+
+TEST_F(StructuredLogDecoderTest, LogWithoutMetadataFields) {
+  const std::vector<std::byte> encoded =
+      Concat(TokenBytes(kStrings[3]), Bytes({0x02, 'h', 'i'}));
+
+  Result<StructuredLog> log = decoder_.Decode(0, encoded);
+  ASSERT_EQ(OkStatus(), log.status());
+  EXPECT_EQ(log->message, "No fields hi");
+  EXPECT_TRUE(log->module.empty());
+}
+
+TEST_F(StructuredLogDecoderTest, Errors) {
+  EXPECT_EQ(Status::DataLoss(), decoder_.Decode(0, Bytes({1, 2})).status());
+  EXPECT_EQ(Status::NotFound(),
+            decoder_.Decode(0, Bytes({1, 2, 3, 4})).status());
+
+  const std::vector<std::byte> token = TokenBytes(kStrings[0]);
+  EXPECT_EQ(Status::DataLoss(),  // No field 4 in the schema
+            decoder_.Decode(0, Concat(token, Bytes({0x04, 0x00}))).status());
+  EXPECT_EQ(Status::DataLoss(),  // Truncated string
+            decoder_.Decode(0, Concat(token, Bytes({0x01, 0x03, 'a'})))
+                .status());
+  EXPECT_EQ(Status::DataLoss(),  // Truncated float
+            decoder_.Decode(0, Concat(token, Bytes({0x03, 0x00, 0x00})))
+                .status());
+}
+
+}  // namespace
+}  // namespace pw::log_tokenized
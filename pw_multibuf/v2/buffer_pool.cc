@@ -0,0 +1,271 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_multibuf/v2/buffer_pool.h"
+
+#include <algorithm>
+#include <mutex>
+#include <new>
+
+#include "pw_assert/check.h"
+#include "pw_bytes/alignment.h"
+
+namespace pw::multibuf::v2 {
+
+BufferPool::BufferPool(span<const SizeClass> size_classes)
+    : Allocator(kCapabilities), num_classes_(size_classes.size()) {
+  PW_CHECK_UINT_LE(num_classes_, kMaxSizeClasses);
+  size_t prev_size = 0;
+  for (size_t i = 0; i < num_classes_; ++i) {
+    const size_t buffer_size = AlignUp(
+        std::max(size_classes[i].buffer_size, sizeof(FreeBuffer)), kAlignment);
+    PW_CHECK_UINT_GT(buffer_size, prev_size);
+    prev_size = buffer_size;
+
+    ByteSpan region = GetAlignedSubspan(size_classes[i].region, kAlignment);
+    const size_t num_buffers = region.size() / buffer_size;
+
+    ClassState& state = classes_[i];
+    state.buffer_size = buffer_size;
+    state.start = reinterpret_cast<uintptr_t>(region.data());
+    state.end = state.start + num_buffers * buffer_size;
+
+    // Build the free list back to front so buffers are handed out in address
+    // order.
+    for (size_t j = num_buffers; j != 0; --j) {
+      std::byte* buffer = region.data() + (j - 1) * buffer_size;
+      state.free_list = new (buffer) FreeBuffer{state.free_list};
+    }
+    state.free_count = num_buffers;
+  }
+}
+
+size_t BufferPool::available(size_t size_class) const {
+  std::lock_guard lock(lock_);
+  return classes_[size_class].free_count;
+}
+
+size_t BufferPool::SizeClassFor(Layout layout) const {
+  if (layout.alignment() > kAlignment) {
+    return kNoSizeClass;
+  }
+  for (size_t i = 0; i < num_classes_; ++i) {
+    if (layout.size() <= classes_[i].buffer_size) {
+      return i;
+    }
+  }
+  return kNoSizeClass;
+}
+
+size_t BufferPool::SizeClassOf(const void* ptr) const {
+  const auto addr = reinterpret_cast<uintptr_t>(ptr);
+  for (size_t i = 0; i < num_classes_; ++i) {
+    const ClassState& state = classes_[i];
+    if (state.start <= addr && addr < state.end) {
+      return i;
+    }
+  }
+  return kNoSizeClass;
+}
+
+size_t BufferPool::TakeBatch(size_t size_class,
+                             size_t max_count,
+                             FreeBuffer*& list) {
+  std::lock_guard lock(lock_);
+  ClassState& state = classes_[size_class];
+  size_t count = 0;
+  while (count < max_count && state.free_list != nullptr) {
+    FreeBuffer* buffer = state.free_list;
+    state.free_list = buffer->next;
+    buffer->next = list;
+    list = buffer;
+    ++count;
+  }
+  state.free_count -= count;
+  return count;
+}
+
+void BufferPool::ReturnBatch(size_t size_class,
+                             FreeBuffer* head,
+                             FreeBuffer* tail,
+                             size_t count) {
+  {
+    std::lock_guard lock(lock_);
+    ClassState& state = classes_[size_class];
+    tail->next = state.free_list;
+    state.free_list = head;
+    state.free_count += count;
+  }
+  BuffersReturned(size_class);
+}
+
+void* BufferPool::DoAllocate(Layout layout) {
+  const size_t first = SizeClassFor(layout);
+  std::lock_guard lock(lock_);
+  for (size_t i = first; i < num_classes_; ++i) {
+    ClassState& state = classes_[i];
+    if (state.free_list != nullptr) {
+      FreeBuffer* buffer = state.free_list;
+      state.free_list = buffer->next;
+      --state.free_count;
+      return buffer;
+    }
+  }
+  return nullptr;
+}
+
+void BufferPool::DoDeallocate(void* ptr) {
+  const size_t size_class = SizeClassOf(ptr);
+  PW_CHECK_UINT_NE(size_class, kNoSizeClass);
+  auto* buffer = new (ptr) FreeBuffer{nullptr};
+  ReturnBatch(size_class, buffer, buffer, 1);
+}
+
+Result<allocator::Layout> BufferPool::DoGetInfo(InfoType info_type,
+                                                const void* ptr) const {
+  if (info_type == InfoType::kCapacity) {
+    size_t capacity = 0;
+    for (size_t i = 0; i < num_classes_; ++i) {
+      capacity += classes_[i].end - classes_[i].start;
+    }
+    return Layout(capacity, kAlignment);
+  }
+  const size_t size_class = SizeClassOf(ptr);
+  if (size_class == kNoSizeClass) {
+    return Status::OutOfRange();
+  }
+  const ClassState& state = classes_[size_class];
+  const auto addr = reinterpret_cast<uintptr_t>(ptr);
+  if ((addr - state.start) % state.buffer_size != 0) {
+    return Status::OutOfRange();
+  }
+  switch (info_type) {
+    case InfoType::kRequestedLayoutOf:
+    case InfoType::kUsableLayoutOf:
+    case InfoType::kAllocatedLayoutOf:
+      return Layout(state.buffer_size, kAlignment);
+    case InfoType::kRecognizes:
+      return Layout();
+    case InfoType::kCapacity:
+    default:
+      return Status::Unimplemented();
+  }
+}
+
+BufferPool::ThreadCache::ThreadCache(BufferPool& pool, size_t batch_size)
+    : Allocator(kCapabilities),
+      pool_(pool),
+      batch_size_(std::max(batch_size, size_t{1})),
+      owner_(this_thread::get_id()) {}
+
+BufferPool::ThreadCache::~ThreadCache() { Flush(); }
+
+void BufferPool::ThreadCache::Flush() {
+  for (size_t i = 0; i < pool_.num_classes_; ++i) {
+    LocalList& list = lists_[i];
+    FreeBuffer* remote = list.remote_frees.exchange(nullptr);
+    while (remote != nullptr) {
+      FreeBuffer* next = remote->next;
+      remote->next = list.head;
+      list.head = remote;
+      ++list.count;
+      remote = next;
+    }
+    Return(i, list.count);
+  }
+}
+
+bool BufferPool::ThreadCache::Refill(size_t size_class) {
+  LocalList& list = lists_[size_class];
+
+  // Prefer buffers freed by other threads, which would otherwise sit idle
+  // until this cache is flushed.
+  FreeBuffer* remote =
+      list.remote_frees.exchange(nullptr, std::memory_order_acquire);
+  if (remote != nullptr) {
+    while (remote != nullptr) {
+      FreeBuffer* next = remote->next;
+      remote->next = list.head;
+      list.head = remote;
+      ++list.count;
+      remote = next;
+    }
+    return true;
+  }
+
+  list.count += pool_.TakeBatch(size_class, batch_size_, list.head);
+  return list.head != nullptr;
+}
+
+void BufferPool::ThreadCache::Return(size_t size_class, size_t count) {
+  LocalList& list = lists_[size_class];
+  if (count == 0 || list.head == nullptr) {
+    return;
+  }
+  FreeBuffer* head = list.head;
+  FreeBuffer* tail = head;
+  size_t returned = 1;
+  while (returned < count && tail->next != nullptr) {
+    tail = tail->next;
+    ++returned;
+  }
+  list.head = tail->next;
+  list.count -= returned;
+  pool_.ReturnBatch(size_class, head, tail, returned);
+}
+
+void* BufferPool::ThreadCache::DoAllocate(Layout layout) {
+  for (size_t i = pool_.SizeClassFor(layout); i < pool_.num_classes_; ++i) {
+    LocalList& list = lists_[i];
+    if (list.head != nullptr || Refill(i)) {
+      FreeBuffer* buffer = list.head;
+      list.head = buffer->next;
+      --list.count;
+      return buffer;
+    }
+  }
+  return nullptr;
+}
+
+void BufferPool::ThreadCache::DoDeallocate(void* ptr) {
+  const size_t size_class = pool_.SizeClassOf(ptr);
+  PW_CHECK_UINT_NE(size_class, kNoSizeClass);
+  LocalList& list = lists_[size_class];
+
+  if (this_thread::get_id() != owner_) {
+    // Only the owner drains this list, so pushing cannot suffer from ABA.
+    auto* buffer = new (ptr)
+        FreeBuffer{list.remote_frees.load(std::memory_order_relaxed)};
+    while (!list.remote_frees.compare_exchange_weak(
+        buffer->next,
+        buffer,
+        std::memory_order_release,
+        std::memory_order_relaxed)) {
+    }
+    return;
+  }
+
+  list.head = new (ptr) FreeBuffer{list.head};
+  ++list.count;
+  if (list.count > 2 * batch_size_) {
+    Return(size_class, batch_size_);
+  }
+}
+
+Result<allocator::Layout> BufferPool::ThreadCache::DoGetInfo(
+    InfoType info_type, const void* ptr) const {
+  return pool_.DoGetInfo(info_type, ptr);
+}
+
+}  // namespace pw::multibuf::v2
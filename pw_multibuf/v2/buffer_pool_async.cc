@@ -0,0 +1,41 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_multibuf/v2/buffer_pool_async.h"
+
+#include <utility>
+
+namespace pw::multibuf::v2 {
+
+async2::Poll<UniquePtr<std::byte[]>> AsyncBufferPool::PendAllocate(
+    async2::Context& context, size_t size) {
+  UniquePtr<std::byte[]> buffer = MakeUnique<std::byte[]>(size);
+  if (buffer != nullptr) {
+    return async2::Ready(std::move(buffer));
+  }
+  PW_ASYNC_STORE_WAKER(context, waker_, "waiting for pool buffers");
+
+  // Buffers may have been returned by another thread after the first attempt
+  // but before the waker was stored, so try again to avoid missing the wakeup.
+  buffer = MakeUnique<std::byte[]>(size);
+  if (buffer != nullptr) {
+    waker_.Clear();
+    return async2::Ready(std::move(buffer));
+  }
+  return async2::Pending();
+}
+
+void AsyncBufferPool::BuffersReturned(size_t) { waker_.Wake(); }
+
+}  // namespace pw::multibuf::v2
@@ -0,0 +1,92 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+
+#include "pw_allocator/best_fit.h"
+#include "pw_allocator/synchronized_allocator.h"
+#include "pw_assert/check.h"
+#include "pw_multibuf/v2/buffer_pool.h"
+#include "pw_multibuf/v2/multibuf.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_sync/mutex.h"
+
+namespace pw::multibuf::v2 {
+namespace {
+
+// Size of a packet payload.
+constexpr size_t kPacketSize = 256;
+
+constexpr size_t kMetadataSize = 128;
+constexpr size_t kMaxPacketSize = 1024;
+constexpr size_t kNumBuffers = 64;
+
+alignas(BufferPool::kAlignment)
+    std::array<std::byte, kMetadataSize * kNumBuffers> metadata_region;
+alignas(BufferPool::kAlignment)
+    std::array<std::byte, kPacketSize * kNumBuffers> packet_region;
+alignas(BufferPool::kAlignment)
+    std::array<std::byte, kMaxPacketSize * kNumBuffers> large_region;
+alignas(BufferPool::kAlignment) std::array<
+    std::byte,
+    (kMetadataSize + kPacketSize + kMaxPacketSize) * kNumBuffers>
+    heap_region;
+
+constexpr std::array<std::byte, kPacketSize> kPayload{};
+
+// Models a packet path: a MultiBuf and a buffer for a packet are allocated
+// and filled, and then released.
+void AllocateFillRelease(perf_test::State& state, Allocator& allocator) {
+  while (state.KeepRunning()) {
+    MultiBuf::Instance mb(allocator);
+    UniquePtr<std::byte[]> buffer =
+        allocator.MakeUnique<std::byte[]>(kPacketSize);
+    PW_CHECK_NOTNULL(buffer.get());
+    mb->PushBack(std::move(buffer));
+    PW_CHECK_UINT_EQ(mb->CopyFrom(kPayload), kPayload.size());
+  }
+}
+
+BufferPool& Pool() {
+  static constexpr std::array<BufferPool::SizeClass, 3> kSizeClasses = {{
+      {kMetadataSize, metadata_region},
+      {kPacketSize, packet_region},
+      {kMaxPacketSize, large_region},
+  }};
+  static BufferPool pool(kSizeClasses);
+  return pool;
+}
+
+void GeneralPurposeAllocator(perf_test::State& state) {
+  static allocator::BestFitAllocator<> heap(heap_region);
+  static allocator::SynchronizedAllocator<sync::Mutex> allocator(heap);
+  AllocateFillRelease(state, allocator);
+}
+
+void PooledAllocator(perf_test::State& state) {
+  AllocateFillRelease(state, Pool());
+}
+
+void PooledAllocatorWithThreadCache(perf_test::State& state) {
+  BufferPool::ThreadCache cache(Pool());
+  AllocateFillRelease(state, cache);
+}
+
+PW_PERF_TEST(MultiBuf_GeneralPurposeAllocator, GeneralPurposeAllocator);
+PW_PERF_TEST(MultiBuf_BufferPool, PooledAllocator);
+PW_PERF_TEST(MultiBuf_BufferPoolThreadCache, PooledAllocatorWithThreadCache);
+
+}  // namespace
+}  // namespace pw::multibuf::v2
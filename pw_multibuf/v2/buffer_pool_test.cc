@@ -0,0 +1,214 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_multibuf/v2/buffer_pool.h"
+
+#include <array>
+#include <cstddef>
+
+#include "pw_async2/dispatcher_for_test.h"
+#include "pw_async2/func_task.h"
+#include "pw_bytes/array.h"
+#include "pw_multibuf/v2/buffer_pool_async.h"
+#include "pw_multibuf/v2/multibuf.h"
+#include "pw_thread/thread.h"
+#include "pw_thread_stl/options.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using ::pw::UniquePtr;
+using ::pw::allocator::Layout;
+using ::pw::multibuf::v2::AsyncBufferPool;
+using ::pw::multibuf::v2::BufferPool;
+using ::pw::multibuf::v2::MultiBuf;
+
+constexpr size_t kSmall = 64;
+constexpr size_t kLarge = 256;
+constexpr size_t kNumSmall = 16;
+constexpr size_t kNumLarge = 4;
+
+class BufferPoolTest : public ::testing::Test {
+ protected:
+  BufferPoolTest() : pool_(size_classes_) {}
+
+  alignas(BufferPool::kAlignment)
+      std::array<std::byte, kSmall * kNumSmall> small_region_;
+  alignas(BufferPool::kAlignment)
+      std::array<std::byte, kLarge * kNumLarge> large_region_;
+  const std::array<BufferPool::SizeClass, 2> size_classes_ = {{
+      {kSmall, small_region_},
+      {kLarge, large_region_},
+  }};
+  BufferPool pool_;
+};
+
+bool Contains(pw::ConstByteSpan region, const void* ptr) {
+  const auto* byte = static_cast<const std::byte*>(ptr);
+  return region.data() <= byte && byte < region.data() + region.size();
+}
+
+TEST_F(BufferPoolTest, AllocatesFromSmallestSizeClass) {
+  ASSERT_EQ(pool_.num_size_classes(), 2u);
+  EXPECT_EQ(pool_.available(0), kNumSmall);
+  EXPECT_EQ(pool_.available(1), kNumLarge);
+
+  UniquePtr<std::byte[]> small = pool_.MakeUnique<std::byte[]>(kSmall / 2);
+  ASSERT_NE(small, nullptr);
+  EXPECT_EQ(pool_.available(0), kNumSmall - 1);
+  EXPECT_TRUE(Contains(small_region_, small.get()));
+
+  UniquePtr<std::byte[]> large = pool_.MakeUnique<std::byte[]>(kSmall + 1);
+  ASSERT_NE(large, nullptr);
+  EXPECT_EQ(pool_.available(1), kNumLarge - 1);
+  EXPECT_TRUE(Contains(large_region_, large.get()));
+
+  small.Reset();
+  large.Reset();
+  EXPECT_EQ(pool_.available(0), kNumSmall);
+  EXPECT_EQ(pool_.available(1), kNumLarge);
+}
+
+TEST_F(BufferPoolTest, FailsForOversizedRequests) {
+  EXPECT_EQ(pool_.Allocate(Layout(kLarge + 1)), nullptr);
+  EXPECT_EQ(pool_.Allocate(Layout(kSmall, BufferPool::kAlignment * 2)),
+            nullptr);
+}
+
+TEST_F(BufferPoolTest, FallsBackToLargerSizeClassWhenExhausted) {
+  std::array<void*, kNumSmall + kNumLarge> ptrs;
+  for (void*& ptr : ptrs) {
+    ptr = pool_.Allocate(Layout(1));
+    ASSERT_NE(ptr, nullptr);
+  }
+  EXPECT_EQ(pool_.available(0), 0u);
+  EXPECT_EQ(pool_.available(1), 0u);
+  EXPECT_EQ(pool_.Allocate(Layout(1)), nullptr);
+
+  for (void* ptr : ptrs) {
+    pool_.Deallocate(ptr);
+  }
+  EXPECT_EQ(pool_.available(0), kNumSmall);
+  EXPECT_EQ(pool_.available(1), kNumLarge);
+}
+
+TEST_F(BufferPoolTest, ProvidesMultiBufMetadataAndBuffers) {
+  {
+    MultiBuf::Instance mb(pool_);
+    UniquePtr<std::byte[]> buffer = pool_.MakeUnique<std::byte[]>(kSmall);
+    ASSERT_NE(buffer, nullptr);
+    mb->PushBack(std::move(buffer));
+
+    constexpr auto kData = pw::bytes::Array<1, 2, 3, 4>();
+    EXPECT_EQ(mb->CopyFrom(kData), kData.size());
+    std::array<std::byte, kData.size()> out;
+    EXPECT_EQ(mb->CopyTo(out), out.size());
+    EXPECT_EQ(out, kData);
+  }
+  EXPECT_EQ(pool_.available(0), kNumSmall);
+  EXPECT_EQ(pool_.available(1), kNumLarge);
+}
+
+TEST_F(BufferPoolTest, ThreadCacheRefillsAndReturnsInBatches) {
+  constexpr size_t kBatchSize = 4;
+  BufferPool::ThreadCache cache(pool_, kBatchSize);
+
+  std::array<void*, 3 * kBatchSize> ptrs;
+  for (void*& ptr : ptrs) {
+    ptr = cache.Allocate(Layout(kSmall));
+    ASSERT_NE(ptr, nullptr);
+  }
+  EXPECT_EQ(pool_.available(0), kNumSmall - ptrs.size());
+
+  // Freed buffers stay in the cache until it holds more than two batches.
+  for (size_t i = 0; i < 2 * kBatchSize; ++i) {
+    cache.Deallocate(ptrs[i]);
+  }
+  EXPECT_EQ(pool_.available(0), kNumSmall - ptrs.size());
+  cache.Deallocate(ptrs[2 * kBatchSize]);
+  EXPECT_EQ(pool_.available(0), kNumSmall - ptrs.size() + kBatchSize);
+
+  for (size_t i = 2 * kBatchSize + 1; i < ptrs.size(); ++i) {
+    cache.Deallocate(ptrs[i]);
+  }
+  cache.Flush();
+  EXPECT_EQ(pool_.available(0), kNumSmall);
+}
+
+TEST_F(BufferPoolTest, ThreadCacheReclaimsBuffersFreedByOtherThreads) {
+  BufferPool::ThreadCache cache(pool_, kNumSmall);
+  std::array<UniquePtr<std::byte[]>, kNumSmall> buffers;
+  for (auto& buffer : buffers) {
+    buffer = cache.MakeUnique<std::byte[]>(kSmall);
+    ASSERT_NE(buffer, nullptr);
+  }
+  EXPECT_EQ(pool_.available(0), 0u);
+
+  pw::Thread consumer(pw::thread::stl::Options(), [&buffers] {
+    for (auto& buffer : buffers) {
+      buffer.Reset();
+    }
+  });
+  consumer.join();
+
+  // The buffers are reclaimed by the cache rather than returned to the pool.
+  EXPECT_EQ(pool_.available(0), 0u);
+  for (auto& buffer : buffers) {
+    buffer = cache.MakeUnique<std::byte[]>(kSmall);
+    EXPECT_NE(buffer, nullptr);
+  }
+  EXPECT_EQ(pool_.available(0), 0u);
+
+  for (auto& buffer : buffers) {
+    buffer.Reset();
+  }
+  cache.Flush();
+  EXPECT_EQ(pool_.available(0), kNumSmall);
+}
+
+TEST(AsyncBufferPoolTest, PendAllocateIsNotReadyUntilBufferReturned) {
+  constexpr size_t kNumBuffers = 4;
+  alignas(BufferPool::kAlignment) std::array<std::byte, kSmall * kNumBuffers>
+      region;
+  const std::array<BufferPool::SizeClass, 1> size_classes = {{
+      {kSmall, region},
+  }};
+  AsyncBufferPool pool(size_classes);
+
+  std::array<UniquePtr<std::byte[]>, kNumBuffers> buffers;
+  for (auto& buffer : buffers) {
+    buffer = pool.MakeUnique<std::byte[]>(kSmall);
+    ASSERT_NE(buffer, nullptr);
+  }
+
+  pw::async2::DispatcherForTest dispatcher;
+  UniquePtr<std::byte[]> async_buffer;
+  pw::async2::FuncTask task(
+      [&](pw::async2::Context& context) -> pw::async2::Poll<> {
+        auto poll = pool.PendAllocate(context, kSmall);
+        if (poll.IsPending()) {
+          return pw::async2::Pending();
+        }
+        async_buffer = std::move(*poll);
+        return pw::async2::Ready();
+      });
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled());
+
+  buffers[0].Reset();
+  dispatcher.RunToCompletion();
+  EXPECT_NE(async_buffer, nullptr);
+}
+
+}  // namespace
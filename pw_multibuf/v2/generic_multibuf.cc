@@ -371,11 +371,13 @@ bool GenericMultiBuf::AddLayer(size_t offset, size_t length) {
       ++num_fragments;
     }
 
-    // Skip over entries until we reach `offset`.
+    // Skip over entries until we reach `offset`. Skipped entries are empty
+    // views at the end of the lower layer, so that a layer which starts past
+    // the data in the first chunk still reports that data as headroom.
     Entry& entry = deque_[top_view_index(chunk)];
     if (off >= lower_len) {
       off -= lower_len;
-      entry.view.offset = 0;
+      entry.view.offset = lower_off + lower_len;
       entry.view.length = 0;
       continue;
     }
@@ -491,6 +493,83 @@ void GenericMultiBuf::PopLayer() {
   }
 }
 
+size_t GenericMultiBuf::Headroom() const {
+  if (num_layers() < 2 || num_chunks() == 0) {
+    return 0;
+  }
+  // The top layer must start in the first chunk for its headroom to be
+  // contiguous with its data.
+  if (GetLength(0) == 0 && size() != 0) {
+    return 0;
+  }
+  size_type top_offset = GetOffset(0);
+  size_type lower_offset = GetOffset(0, num_layers() - 1);
+  return top_offset > lower_offset ? top_offset - lower_offset : 0;
+}
+
+size_t GenericMultiBuf::Tailroom() const {
+  if (num_layers() < 2 || num_chunks() == 0) {
+    return 0;
+  }
+  size_type last = num_chunks() - 1;
+  if (GetLength(last) == 0 && size() != 0) {
+    return 0;
+  }
+  size_type lower_layer = num_layers() - 1;
+  size_type top_end = GetOffset(last) + GetLength(last);
+  size_type lower_end =
+      GetOffset(last, lower_layer) + GetLength(last, lower_layer);
+  return lower_end > top_end ? lower_end - top_end : 0;
+}
+
+bool GenericMultiBuf::ClaimHeadroom(size_t length) {
+  if (length > Headroom()) {
+    return false;
+  }
+  if (length == 0) {
+    return true;
+  }
+  PW_CHECK(!IsSealed(0),
+           "MultiBuf::ClaimHeadroom() was called on a sealed layer; call "
+           "UnsealTopLayer first");
+  // A layer added with no data has no boundary, so mark one.
+  bool was_empty = size() == 0;
+  auto len = static_cast<size_type>(length);
+  Entry& entry = deque_[top_view_index(0)];
+  entry.view.offset -= len;
+  entry.view.length += len;
+  if (was_empty) {
+    entry.view.boundary = true;
+  }
+  if (observer_ != nullptr) {
+    observer_->Notify(Observer::Event::kBytesAdded, length);
+  }
+  return true;
+}
+
+bool GenericMultiBuf::ClaimTailroom(size_t length) {
+  if (length > Tailroom()) {
+    return false;
+  }
+  if (length == 0) {
+    return true;
+  }
+  size_type last = num_chunks() - 1;
+  PW_CHECK(!IsSealed(last),
+           "MultiBuf::ClaimTailroom() was called on a sealed layer; call "
+           "UnsealTopLayer first");
+  bool was_empty = size() == 0;
+  Entry& entry = deque_[top_view_index(last)];
+  entry.view.length += static_cast<size_type>(length);
+  if (was_empty) {
+    entry.view.boundary = true;
+  }
+  if (observer_ != nullptr) {
+    observer_->Notify(Observer::Event::kBytesAdded, length);
+  }
+  return true;
+}
+
 // Implementation methods
 
 size_t GenericMultiBuf::CheckRange(size_t offset, size_t length, size_t size) {
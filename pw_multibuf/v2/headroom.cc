@@ -0,0 +1,46 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_multibuf/v2/headroom.h"
+
+#include <utility>
+
+#include "pw_multibuf/v2/internal/entry.h"
+
+namespace pw::multibuf::v2 {
+
+Result<MultiBuf::Instance> AllocateWithRoom(Allocator& allocator,
+                                            size_t size,
+                                            size_t headroom,
+                                            size_t tailroom) {
+  const size_t total = headroom + size + tailroom;
+  if (total > internal::Entry::kMaxSize || total < size) {
+    return Status::OutOfRange();
+  }
+  MultiBuf::Instance mb(allocator);
+  if (!mb->TryReserveLayers(2)) {
+    return Status::ResourceExhausted();
+  }
+  UniquePtr<std::byte[]> buffer = allocator.MakeUnique<std::byte[]>(total);
+  if (buffer == nullptr) {
+    return Status::ResourceExhausted();
+  }
+  mb->PushBack(std::move(buffer));
+  if (!mb->AddLayer(headroom, size)) {
+    return Status::ResourceExhausted();
+  }
+  return mb;
+}
+
+}  // namespace pw::multibuf::v2
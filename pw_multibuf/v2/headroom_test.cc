@@ -0,0 +1,154 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_multibuf/v2/headroom.h"
+
+#include <array>
+#include <cstddef>
+
+#include "pw_allocator/testing.h"
+#include "pw_bytes/array.h"
+#include "pw_multibuf/v2/multibuf.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using ::pw::allocator::test::AllocatorForTest;
+using ::pw::multibuf::v2::AllocateWithRoom;
+using ::pw::multibuf::v2::MultiBuf;
+
+constexpr auto kPayload = pw::bytes::Array<0x10, 0x11, 0x12, 0x13>();
+constexpr auto kHeader = pw::bytes::Array<0x01, 0x02>();
+constexpr auto kTrailer = pw::bytes::Array<0xf0>();
+
+class HeadroomTest : public ::testing::Test {
+ protected:
+  AllocatorForTest<1024> allocator_;
+};
+
+TEST_F(HeadroomTest, AllocateWithRoomReservesHeadroomAndTailroom) {
+  auto mb = AllocateWithRoom(allocator_, kPayload.size(), 8, 4);
+  ASSERT_EQ(mb.status(), pw::OkStatus());
+  MultiBuf& payload = **mb;
+  EXPECT_EQ(payload.NumLayers(), 2u);
+  EXPECT_EQ(payload.size(), kPayload.size());
+  EXPECT_EQ(payload.Headroom(), 8u);
+  EXPECT_EQ(payload.Tailroom(), 4u);
+}
+
+TEST_F(HeadroomTest, AllocateWithRoomFailsWhenExhausted) {
+  auto mb = AllocateWithRoom(allocator_, 2048, 8, 4);
+  EXPECT_EQ(mb.status(), pw::Status::ResourceExhausted());
+}
+
+TEST_F(HeadroomTest, PrependHeaderAndAppendTrailerShareBuffer) {
+  auto mb = AllocateWithRoom(allocator_, kPayload.size(), 8, 4);
+  ASSERT_EQ(mb.status(), pw::OkStatus());
+  MultiBuf& frame = **mb;
+  EXPECT_EQ(frame.CopyFrom(kPayload), kPayload.size());
+  const std::byte* payload = &*frame.begin();
+
+  ASSERT_TRUE(frame.PrependHeader(kHeader));
+  ASSERT_TRUE(frame.AppendTrailer(kTrailer));
+  EXPECT_EQ(frame.Headroom(), 8u - kHeader.size());
+  EXPECT_EQ(frame.Tailroom(), 4u - kTrailer.size());
+
+  // The header is written directly in front of the payload.
+  EXPECT_EQ(&*frame.begin() + kHeader.size(), payload);
+
+  std::array<std::byte, 7> out;
+  ASSERT_EQ(frame.size(), out.size());
+  EXPECT_EQ(frame.CopyTo(out), out.size());
+  constexpr auto kExpected =
+      pw::bytes::Array<0x01, 0x02, 0x10, 0x11, 0x12, 0x13, 0xf0>();
+  EXPECT_EQ(out, kExpected);
+  EXPECT_EQ(frame.NumFragments(), 1u);
+}
+
+TEST_F(HeadroomTest, ClaimFailsWithoutEnoughRoom) {
+  auto mb = AllocateWithRoom(allocator_, kPayload.size(), 1, 0);
+  ASSERT_EQ(mb.status(), pw::OkStatus());
+  MultiBuf& frame = **mb;
+  EXPECT_FALSE(frame.PrependHeader(kHeader));
+  EXPECT_FALSE(frame.AppendTrailer(kTrailer));
+  EXPECT_EQ(frame.size(), kPayload.size());
+  EXPECT_TRUE(frame.ClaimHeadroom(1));
+  EXPECT_EQ(frame.Headroom(), 0u);
+}
+
+TEST_F(HeadroomTest, NestedLayersClaimFromLayerBeneath) {
+  // Reserve room for an outer protocol's header and trailer, and within it, an
+  // inner protocol's header.
+  auto mb = AllocateWithRoom(allocator_, 2 + kPayload.size(), 3, 1);
+  ASSERT_EQ(mb.status(), pw::OkStatus());
+  MultiBuf& frame = **mb;
+  ASSERT_TRUE(frame.AddLayer(2));
+  EXPECT_EQ(frame.Headroom(), 2u);
+  EXPECT_EQ(frame.Tailroom(), 0u);
+  EXPECT_EQ(frame.CopyFrom(kPayload), kPayload.size());
+
+  // The inner protocol adds its header and removes its layer.
+  ASSERT_TRUE(frame.PrependHeader(kHeader));
+  frame.PopLayer();
+  EXPECT_EQ(frame.size(), kHeader.size() + kPayload.size());
+
+  // The outer protocol does the same, with a trailer.
+  ASSERT_TRUE(frame.PrependHeader(pw::bytes::Array<0xaa, 0xbb, 0xcc>()));
+  ASSERT_TRUE(frame.AppendTrailer(kTrailer));
+  frame.PopLayer();
+
+  std::array<std::byte, 10> out;
+  ASSERT_EQ(frame.size(), out.size());
+  EXPECT_EQ(frame.CopyTo(out), out.size());
+  constexpr auto kExpected = pw::bytes::
+      Array<0xaa, 0xbb, 0xcc, 0x01, 0x02, 0x10, 0x11, 0x12, 0x13, 0xf0>();
+  EXPECT_EQ(out, kExpected);
+}
+
+TEST_F(HeadroomTest, EmptyPayloadGainsFragmentWhenClaimed) {
+  auto mb = AllocateWithRoom(allocator_, 0, 4, 4);
+  ASSERT_EQ(mb.status(), pw::OkStatus());
+  MultiBuf& frame = **mb;
+  EXPECT_EQ(frame.NumFragments(), 0u);
+  EXPECT_EQ(frame.Headroom(), 4u);
+  EXPECT_EQ(frame.Tailroom(), 4u);
+
+  ASSERT_TRUE(frame.PrependHeader(kHeader));
+  EXPECT_EQ(frame.NumFragments(), 1u);
+  EXPECT_EQ(frame.Tailroom(), 4u);
+}
+
+TEST_F(HeadroomTest, EmptyLayerAtEndHasAllDataAsHeadroom) {
+  MultiBuf::Instance mb(allocator_);
+  mb->PushBack(allocator_.MakeUnique<std::byte[]>(8));
+  ASSERT_TRUE(mb->AddLayer(8));
+  EXPECT_EQ(mb->size(), 0u);
+  EXPECT_EQ(mb->Headroom(), 8u);
+  EXPECT_EQ(mb->Tailroom(), 0u);
+
+  ASSERT_TRUE(mb->PrependHeader(kHeader));
+  EXPECT_EQ(mb->size(), kHeader.size());
+  EXPECT_EQ(mb->Headroom(), 8u - kHeader.size());
+  EXPECT_EQ(mb->NumFragments(), 1u);
+}
+
+TEST_F(HeadroomTest, NoRoomWithSingleLayer) {
+  MultiBuf::Instance mb(allocator_);
+  mb->PushBack(allocator_.MakeUnique<std::byte[]>(8));
+  EXPECT_EQ(mb->Headroom(), 0u);
+  EXPECT_EQ(mb->Tailroom(), 0u);
+  EXPECT_FALSE(mb->ClaimHeadroom(1));
+}
+
+}  // namespace
@@ -0,0 +1,205 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/allocator.h"
+#include "pw_bytes/span.h"
+#include "pw_span/span.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
+#include "pw_thread/thread.h"
+
+namespace pw::multibuf::v2 {
+
+/// @submodule{pw_multibuf,v2}
+
+/// Allocator of fixed-size buffers for MultiBufs that are allocated and freed
+/// at high rates.
+///
+/// The pool is divided into size classes, each of which hands out buffers of a
+/// single size from its own region of memory. An allocation is served by the
+/// smallest class whose buffers are large enough, so allocating and freeing
+/// are constant-time free list operations.
+///
+/// A `BufferPool` can provide both the memory added to a MultiBuf and the
+/// MultiBuf's metadata:
+///
+/// @code{.cpp}
+///   MultiBuf::Instance mb(pool);
+///   mb->PushBack(pool.MakeUnique<std::byte[]>(kPacketSize));
+/// @endcode
+///
+/// The pool is thread safe. Threads that allocate often should do so through
+/// their own `ThreadCache`, which only takes the pool's lock to move buffers in
+/// batches.
+class BufferPool : public Allocator {
+ public:
+  /// Describes one size class: the size of its buffers, and the memory they
+  /// are carved from.
+  struct SizeClass {
+    size_t buffer_size;
+    ByteSpan region;
+  };
+
+  static constexpr Capabilities kCapabilities =
+      allocator::kImplementsGetRequestedLayout |
+      allocator::kImplementsGetUsableLayout |
+      allocator::kImplementsGetAllocatedLayout |
+      allocator::kImplementsGetCapacity | allocator::kImplementsRecognizes;
+
+  static constexpr size_t kMaxSizeClasses = 8;
+
+  /// Buffers are aligned to, and their sizes rounded up to, this alignment.
+  static constexpr size_t kAlignment = alignof(std::max_align_t);
+
+  /// Constructs a pool from up to `kMaxSizeClasses` size classes, which must be
+  /// ordered by increasing buffer size. Requests for more than the largest
+  /// buffer size, or for more than `kAlignment` alignment, fail. If the
+  /// smallest suitable size class is exhausted, buffers are taken from the next
+  /// larger one.
+  explicit BufferPool(span<const SizeClass> size_classes);
+
+  class ThreadCache;
+
+  size_t num_size_classes() const { return num_classes_; }
+
+  /// Returns the size of the buffers of the given size class.
+  size_t buffer_size(size_t size_class) const {
+    return classes_[size_class].buffer_size;
+  }
+
+  /// Returns the number of free buffers of the given size class held by the
+  /// pool itself, i.e. not including those held by thread caches.
+  size_t available(size_t size_class) const PW_LOCKS_EXCLUDED(lock_);
+
+ protected:
+  /// Called after buffers of the given size class are returned to the pool,
+  /// without the pool's lock held. Derived classes can use this to wake
+  /// waiting allocators.
+  virtual void BuffersReturned([[maybe_unused]] size_t size_class) {}
+
+ private:
+  struct FreeBuffer {
+    FreeBuffer* next;
+  };
+
+  struct ClassState {
+    size_t buffer_size = 0;
+    uintptr_t start = 0;
+    uintptr_t end = 0;
+    FreeBuffer* free_list = nullptr;
+    size_t free_count = 0;
+  };
+
+  static constexpr size_t kNoSizeClass = kMaxSizeClasses;
+
+  /// Returns the smallest size class for the layout, or kNoSizeClass.
+  size_t SizeClassFor(Layout layout) const;
+
+  /// Returns the size class that ptr was allocated from, or kNoSizeClass.
+  size_t SizeClassOf(const void* ptr) const;
+
+  /// Moves up to max_count buffers of a size class from the pool to a list.
+  /// Returns the number of buffers moved.
+  size_t TakeBatch(size_t size_class, size_t max_count, FreeBuffer*& list)
+      PW_LOCKS_EXCLUDED(lock_);
+
+  /// Returns a list of count buffers, ending with tail, to the pool.
+  void ReturnBatch(size_t size_class,
+                   FreeBuffer* head,
+                   FreeBuffer* tail,
+                   size_t count) PW_LOCKS_EXCLUDED(lock_);
+
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(Layout layout) override;
+
+  /// @copydoc Deallocator::Deallocate
+  void DoDeallocate(void* ptr) override;
+
+  /// @copydoc Deallocator::GetInfo
+  Result<Layout> DoGetInfo(InfoType info_type, const void* ptr) const override;
+
+  size_t num_classes_ = 0;
+  std::array<ClassState, kMaxSizeClasses> classes_;
+  mutable sync::Mutex lock_;
+};
+
+/// A per-thread front end to a `BufferPool`.
+///
+/// A cache keeps a private free list for each size class. Allocating from and
+/// freeing to the cache on its owning thread touch only those lists. When a
+/// list runs empty, the cache refills it with a batch of buffers from the pool,
+/// and when a list grows past two batches, it returns a batch to the pool, so
+/// the pool's lock is taken once per batch rather than once per buffer.
+///
+/// Buffers allocated from a cache are returned to it when freed. Buffers freed
+/// by other threads, e.g. a MultiBuf allocated by a producer and released by a
+/// consumer, are pushed onto a lock-free list which the owning thread reclaims
+/// the next time its private list runs empty.
+///
+/// A cache is created and used by its owning thread, and must outlive all
+/// buffers and MultiBufs allocated from it.
+class BufferPool::ThreadCache : public Allocator {
+ public:
+  static constexpr size_t kDefaultBatchSize = 8;
+
+  explicit ThreadCache(BufferPool& pool,
+                       size_t batch_size = kDefaultBatchSize);
+
+  ~ThreadCache() override;
+
+  ThreadCache(const ThreadCache&) = delete;
+  ThreadCache& operator=(const ThreadCache&) = delete;
+
+  /// Returns all buffers held by the cache to the pool.
+  void Flush();
+
+ private:
+  struct LocalList {
+    FreeBuffer* head = nullptr;
+    size_t count = 0;
+    // Buffers freed by other threads.
+    std::atomic<FreeBuffer*> remote_frees{nullptr};
+  };
+
+  /// Refills the local list of a size class. Returns false if no buffers are
+  /// available.
+  bool Refill(size_t size_class);
+
+  /// Returns up to count buffers from the head of a local list to the pool.
+  void Return(size_t size_class, size_t count);
+
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(Layout layout) override;
+
+  /// @copydoc Deallocator::Deallocate
+  void DoDeallocate(void* ptr) override;
+
+  /// @copydoc Deallocator::GetInfo
+  Result<Layout> DoGetInfo(InfoType info_type, const void* ptr) const override;
+
+  BufferPool& pool_;
+  const size_t batch_size_;
+  const Thread::id owner_;
+  std::array<LocalList, kMaxSizeClasses> lists_;
+};
+
+/// @}
+
+}  // namespace pw::multibuf::v2
@@ -0,0 +1,53 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+
+#include "pw_allocator/unique_ptr.h"
+#include "pw_async2/context.h"
+#include "pw_async2/poll.h"
+#include "pw_async2/waker.h"
+#include "pw_multibuf/v2/buffer_pool.h"
+
+namespace pw::multibuf::v2 {
+
+/// @submodule{pw_multibuf,v2}
+
+/// A `BufferPool` that allows producers to wait for buffers.
+///
+/// When no buffer of a suitable size is available, `PendAllocate` stores the
+/// task's waker and returns `Pending`. The task is woken when buffers are next
+/// returned to the pool, either individually or in a batch from a
+/// `ThreadCache`.
+///
+/// As with `pw::allocator::AsyncPool`, only one task may wait for buffers at a
+/// time.
+class AsyncBufferPool : public BufferPool {
+ public:
+  using BufferPool::BufferPool;
+
+  /// Asynchronously allocates a buffer of at least `size` bytes.
+  async2::Poll<UniquePtr<std::byte[]>> PendAllocate(async2::Context& context,
+                                                    size_t size);
+
+ private:
+  void BuffersReturned(size_t size_class) override;
+
+  async2::Waker waker_;
+};
+
+/// @}
+
+}  // namespace pw::multibuf::v2
@@ -0,0 +1,50 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+
+#include "pw_allocator/allocator.h"
+#include "pw_multibuf/v2/multibuf.h"
+#include "pw_result/result.h"
+
+namespace pw::multibuf::v2 {
+
+/// @submodule{pw_multibuf,v2}
+
+/// Allocates a MultiBuf holding a single buffer with room reserved around a
+/// payload.
+///
+/// The buffer holds `headroom + size + tailroom` bytes. The returned MultiBuf
+/// has two layers: the whole buffer, and above it a `size`-byte payload layer
+/// starting `headroom` bytes in. Lower protocol layers can then add their
+/// headers and trailers to the payload in place, using `PrependHeader` and
+/// `AppendTrailer`, rather than copying it into a new buffer.
+///
+/// @param  allocator   Allocator for the buffer and the MultiBuf metadata.
+/// @param  size        Size of the payload.
+/// @param  headroom    Bytes to reserve before the payload.
+/// @param  tailroom    Bytes to reserve after the payload.
+///
+/// @returns
+/// * @RESOURCE_EXHAUSTED: The buffer or metadata could not be allocated.
+/// * @OUT_OF_RANGE: The buffer would be too large for a MultiBuf chunk.
+Result<MultiBuf::Instance> AllocateWithRoom(Allocator& allocator,
+                                            size_t size,
+                                            size_t headroom,
+                                            size_t tailroom = 0);
+
+/// @}
+
+}  // namespace pw::multibuf::v2
@@ -1002,6 +1002,87 @@ class BasicMultiBuf {
     generic().PopLayer();
   }
 
+  /// Returns the number of bytes that precede the top layer in the layer
+  /// beneath it, within the first chunk.
+  ///
+  /// This is the room available for prepending a header to the top layer
+  /// without copying its data, e.g. when a buffer is allocated with space
+  /// reserved for the headers of lower protocol layers. Returns 0 when
+  /// `NumLayers()` < 2.
+  size_t Headroom() const {
+    static_assert(is_layerable(),
+                  "`Headroom` may only be called on layerable MultiBufs");
+    return generic().Headroom();
+  }
+
+  /// Returns the number of bytes that follow the top layer in the layer
+  /// beneath it, within the last chunk.
+  ///
+  /// This is the room available for appending a trailer, such as a checksum,
+  /// to the top layer without copying its data. Returns 0 when `NumLayers()`
+  /// < 2.
+  size_t Tailroom() const {
+    static_assert(is_layerable(),
+                  "`Tailroom` may only be called on layerable MultiBufs");
+    return generic().Tailroom();
+  }
+
+  /// Extends the top layer to include `length` bytes of its headroom.
+  ///
+  /// Returns false and leaves the object unchanged if `length` exceeds
+  /// `Headroom()`. Otherwise, returns true.
+  ///
+  /// Crashes if the top layer is sealed.
+  [[nodiscard]] bool ClaimHeadroom(size_t length) {
+    static_assert(is_layerable(),
+                  "`ClaimHeadroom` may only be called on layerable MultiBufs");
+    return generic().ClaimHeadroom(length);
+  }
+
+  /// Extends the top layer to include `length` bytes of its tailroom.
+  ///
+  /// Returns false and leaves the object unchanged if `length` exceeds
+  /// `Tailroom()`. Otherwise, returns true.
+  ///
+  /// Crashes if the top layer is sealed.
+  [[nodiscard]] bool ClaimTailroom(size_t length) {
+    static_assert(is_layerable(),
+                  "`ClaimTailroom` may only be called on layerable MultiBufs");
+    return generic().ClaimTailroom(length);
+  }
+
+  /// Writes `header` into the headroom and extends the top layer to include
+  /// it.
+  ///
+  /// Returns false and leaves the object unchanged if the header does not fit
+  /// in `Headroom()`. Otherwise, returns true.
+  [[nodiscard]] bool PrependHeader(ConstByteSpan header) {
+    static_assert(!is_const() && is_layerable(),
+                  "`PrependHeader` may only be called on mutable, layerable "
+                  "MultiBufs");
+    if (!ClaimHeadroom(header.size())) {
+      return false;
+    }
+    CopyFrom(header);
+    return true;
+  }
+
+  /// Writes `trailer` into the tailroom and extends the top layer to include
+  /// it.
+  ///
+  /// Returns false and leaves the object unchanged if the trailer does not fit
+  /// in `Tailroom()`. Otherwise, returns true.
+  [[nodiscard]] bool AppendTrailer(ConstByteSpan trailer) {
+    static_assert(!is_const() && is_layerable(),
+                  "`AppendTrailer` may only be called on mutable, layerable "
+                  "MultiBufs");
+    if (!ClaimTailroom(trailer.size())) {
+      return false;
+    }
+    CopyFrom(trailer, size() - trailer.size());
+    return true;
+  }
+
  protected:
   constexpr BasicMultiBuf() { internal::PropertiesAreValid(); }
 
@@ -1333,6 +1414,18 @@ class GenericMultiBuf final
   /// @copydoc ::BasicMultiBuf<>::PopLayer
   void PopLayer();
 
+  /// @copydoc ::BasicMultiBuf<>::Headroom
+  size_t Headroom() const;
+
+  /// @copydoc ::BasicMultiBuf<>::Tailroom
+  size_t Tailroom() const;
+
+  /// @copydoc ::BasicMultiBuf<>::ClaimHeadroom
+  [[nodiscard]] bool ClaimHeadroom(size_t length);
+
+  /// @copydoc ::BasicMultiBuf<>::ClaimTailroom
+  [[nodiscard]] bool ClaimTailroom(size_t length);
+
   // Implementation methods.
   //
   // These methods are used to implement the methods above, and should not be
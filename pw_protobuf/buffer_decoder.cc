@@ -0,0 +1,475 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_protobuf/buffer_decoder.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+
+#include "pw_assert/check.h"
+#include "pw_bytes/bit.h"
+#include "pw_containers/vector.h"
+#include "pw_protobuf/internal/codegen.h"
+#include "pw_protobuf/stream_decoder.h"
+#include "pw_protobuf/wire_format.h"
+#include "pw_status/try.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_string/string.h"
+#include "pw_varint/varint.h"
+
+namespace pw::protobuf {
+namespace {
+
+using internal::CallbackType;
+using internal::MessageField;
+using internal::VarintType;
+
+// Decodes a varint from the front of data and advances past it. Returns false
+// if the varint is truncated or overlong.
+inline bool ReadVarint(ConstByteSpan& data, uint64_t& value) {
+  // Keys, lengths, and most values in practice fit in a single byte.
+  if (!data.empty() && (static_cast<uint8_t>(data[0]) & 0x80u) == 0) {
+    value = static_cast<uint8_t>(data[0]);
+    data = data.subspan(1);
+    return true;
+  }
+  const size_t bytes_read = varint::Decode(data, &value);
+  if (bytes_read == 0) {
+    return false;
+  }
+  data = data.subspan(bytes_read);
+  return true;
+}
+
+// Stores a decoded varint into a struct member of elem_size bytes, applying the
+// same range checks as StreamDecoder.
+inline Status StoreVarint(uint64_t value,
+                          VarintType decode_type,
+                          size_t elem_size,
+                          std::byte* out) {
+  if (elem_size == sizeof(uint64_t)) {
+    if (decode_type == VarintType::kZigZag) {
+      const int64_t signed_value = varint::ZigZagDecode(value);
+      std::memcpy(out, &signed_value, sizeof(signed_value));
+    } else {
+      std::memcpy(out, &value, sizeof(value));
+    }
+    return OkStatus();
+  }
+
+  if (elem_size == sizeof(uint32_t)) {
+    if (decode_type == VarintType::kUnsigned) {
+      if (value > std::numeric_limits<uint32_t>::max()) {
+        return Status::FailedPrecondition();
+      }
+      const auto narrowed = static_cast<uint32_t>(value);
+      std::memcpy(out, &narrowed, sizeof(narrowed));
+    } else {
+      const int64_t signed_value = decode_type == VarintType::kZigZag
+                                       ? varint::ZigZagDecode(value)
+                                       : static_cast<int64_t>(value);
+      if (signed_value > std::numeric_limits<int32_t>::max() ||
+          signed_value < std::numeric_limits<int32_t>::min()) {
+        return Status::FailedPrecondition();
+      }
+      const auto narrowed = static_cast<int32_t>(signed_value);
+      std::memcpy(out, &narrowed, sizeof(narrowed));
+    }
+    return OkStatus();
+  }
+
+  PW_DCHECK(elem_size == sizeof(bool) && decode_type == VarintType::kUnsigned,
+            "Mismatched message field type and size");
+  const bool boolean = value != 0;
+  std::memcpy(out, &boolean, sizeof(boolean));
+  return OkStatus();
+}
+
+// Copies a little-endian fixed-width value into a struct member.
+inline void StoreFixed(ConstByteSpan value, std::byte* out) {
+  std::memcpy(out, value.data(), value.size());
+  if constexpr (endian::native != endian::little) {
+    std::reverse(out, out + value.size());
+  }
+}
+
+// The elements of a repeated scalar field, which are either a fixed-size
+// std::array or the backing array of a pw::Vector.
+struct RepeatedStorage {
+  std::byte* data;
+  size_t capacity;
+  size_t size;
+};
+
+// Decodes all of the varints in a packed field, appending them to storage.
+Status AppendPackedVarints(ConstByteSpan packed,
+                           VarintType decode_type,
+                           size_t elem_size,
+                           RepeatedStorage& storage) {
+  while (!packed.empty()) {
+    if (storage.size == storage.capacity) {
+      return Status::ResourceExhausted();
+    }
+    uint64_t value;
+    if (!ReadVarint(packed, value)) {
+      return Status::DataLoss();
+    }
+    PW_TRY(StoreVarint(value,
+                       decode_type,
+                       elem_size,
+                       storage.data + storage.size * elem_size));
+    ++storage.size;
+  }
+  return OkStatus();
+}
+
+// Copies all of the values in a packed fixed-width field to storage at once.
+Status AppendPackedFixed(ConstByteSpan packed,
+                         size_t elem_size,
+                         RepeatedStorage& storage) {
+  if (packed.size() % elem_size != 0) {
+    return Status::DataLoss();
+  }
+  const size_t count = packed.size() / elem_size;
+  if (count > storage.capacity - storage.size) {
+    // Like StreamDecoder, don't partially decode packed fixed fields that
+    // don't fit.
+    return Status::ResourceExhausted();
+  }
+
+  std::byte* out = storage.data + storage.size * elem_size;
+  std::memcpy(out, packed.data(), packed.size());
+  if constexpr (endian::native != endian::little) {
+    for (size_t i = 0; i < count; ++i) {
+      std::reverse(out + i * elem_size, out + (i + 1) * elem_size);
+    }
+  }
+  storage.size += count;
+  return OkStatus();
+}
+
+// Exposes the backing array of the generic pw::Vector<T> at out to decode,
+// then resizes the vector to the number of elements decoded. Used for packed
+// runs, which may append many elements at once.
+template <typename T, typename Decode>
+Status DecodeIntoVector(std::byte* out, Decode&& decode) {
+  // The struct member for this field is a vector of a type corresponding to
+  // the field element size. Cast to the correct vector type so we're not
+  // performing type aliasing (except for unsigned vs signed which is
+  // explicitly allowed).
+  auto& vector = *reinterpret_cast<pw::Vector<T>*>(out);
+  RepeatedStorage storage{nullptr, vector.capacity(), vector.size()};
+  vector.resize(vector.capacity());
+  storage.data = reinterpret_cast<std::byte*>(vector.data());
+  const Status status = decode(storage);
+  vector.resize(storage.size);
+  return status;
+}
+
+template <typename Decode>
+Status DecodeIntoRepeated(const MessageField& field,
+                          span<std::byte> out,
+                          Decode&& decode) {
+  if (field.is_fixed_size()) {
+    // Fixed-size repeated fields are std::arrays which are always decoded from
+    // the start, matching StreamDecoder::ReadPacked*Field().
+    RepeatedStorage storage{out.data(), out.size() / field.elem_size(), 0};
+    return decode(storage);
+  }
+  switch (field.elem_size()) {
+    case sizeof(uint64_t):
+      return DecodeIntoVector<uint64_t>(out.data(), decode);
+    case sizeof(uint32_t):
+      return DecodeIntoVector<uint32_t>(out.data(), decode);
+    case sizeof(bool):
+      return DecodeIntoVector<bool>(out.data(), decode);
+    default:
+      PW_CRASH("Mismatched message field type and size");
+  }
+}
+
+template <typename T>
+Status AppendToVector(std::byte* out, const std::byte* value) {
+  // As in DecodeIntoVector, cast to the vector type corresponding to the
+  // field element size.
+  auto& vector = *reinterpret_cast<pw::Vector<T>*>(out);
+  if (vector.full()) {
+    return Status::ResourceExhausted();
+  }
+  T temp;
+  std::memcpy(&temp, value, sizeof(T));
+  vector.push_back(temp);
+  return OkStatus();
+}
+
+// Appends a single non-packed element to a repeated field's vector.
+Status AppendScalar(size_t elem_size, std::byte* out, const std::byte* value) {
+  switch (elem_size) {
+    case sizeof(uint64_t):
+      return AppendToVector<uint64_t>(out, value);
+    case sizeof(uint32_t):
+      return AppendToVector<uint32_t>(out, value);
+    case sizeof(bool):
+      return AppendToVector<bool>(out, value);
+    default:
+      PW_CRASH("Mismatched message field type and size");
+  }
+}
+
+template <typename T>
+void StoreOptional(std::byte* out, const std::byte* value) {
+  // The struct member for this field is a std::optional of a type
+  // corresponding to the field element size. Assign through a temporary of
+  // that type so we're not performing type aliasing.
+  T temp;
+  std::memcpy(&temp, value, sizeof(T));
+  *reinterpret_cast<std::optional<T>*>(out) = temp;
+}
+
+void StoreOptionalScalar(size_t elem_size,
+                         std::byte* out,
+                         const std::byte* value) {
+  switch (elem_size) {
+    case sizeof(uint64_t):
+      return StoreOptional<uint64_t>(out, value);
+    case sizeof(uint32_t):
+      return StoreOptional<uint32_t>(out, value);
+    case sizeof(bool):
+      return StoreOptional<bool>(out, value);
+    default:
+      PW_CRASH("Mismatched message field type and size");
+  }
+}
+
+// Finds the table entry for field_number. Fields are usually serialized in
+// the order they are declared, so the search resumes from the previously found
+// entry before wrapping around.
+inline const MessageField* FindField(span<const MessageField> table,
+                                     uint32_t field_number,
+                                     size_t& hint) {
+  for (size_t i = hint; i < table.size(); ++i) {
+    if (table[i] == field_number) {
+      hint = i;
+      return &table[i];
+    }
+  }
+  for (size_t i = 0; i < hint; ++i) {
+    if (table[i] == field_number) {
+      hint = i;
+      return &table[i];
+    }
+  }
+  return nullptr;
+}
+
+Status DecodeScalar(const MessageField& field,
+                    WireType wire_type,
+                    uint64_t varint_value,
+                    ConstByteSpan value,
+                    span<std::byte> out) {
+  const bool is_varint = field.wire_type() == WireType::kVarint;
+  const size_t elem_size = field.elem_size();
+
+  // Repeated scalars may be packed into a length-delimited field.
+  if (field.is_repeated() && wire_type == WireType::kDelimited) {
+    return DecodeIntoRepeated(field, out, [&](RepeatedStorage& storage) {
+      return is_varint ? AppendPackedVarints(
+                             value, field.varint_type(), elem_size, storage)
+                       : AppendPackedFixed(value, elem_size, storage);
+    });
+  }
+
+  // Otherwise the wire type must match. As in StreamDecoder, a mismatch is
+  // reported as NOT_FOUND to distinguish it from other corruption.
+  if (wire_type != field.wire_type()) {
+    return Status::NotFound();
+  }
+
+  if (field.is_repeated()) {
+    if (field.is_fixed_size()) {
+      // Fixed-size repeated fields are only decoded from packed encodings.
+      return Status::NotFound();
+    }
+    std::byte temp[sizeof(uint64_t)];
+    if (is_varint) {
+      PW_TRY(StoreVarint(varint_value, field.varint_type(), elem_size, temp));
+    } else {
+      StoreFixed(value, temp);
+    }
+    return AppendScalar(elem_size, out.data(), temp);
+  }
+
+  if (field.is_optional()) {
+    std::byte temp[sizeof(uint64_t)];
+    if (is_varint) {
+      PW_TRY(StoreVarint(varint_value, field.varint_type(), elem_size, temp));
+    } else {
+      StoreFixed(value, temp);
+    }
+    StoreOptionalScalar(elem_size, out.data(), temp);
+    return OkStatus();
+  }
+
+  PW_DCHECK(out.size() == elem_size, "Mismatched message field type and size");
+  if (is_varint) {
+    return StoreVarint(varint_value, field.varint_type(), elem_size, out.data());
+  }
+  StoreFixed(value, out.data());
+  return OkStatus();
+}
+
+template <typename Container>
+Status StoreStringOrBytes(ConstByteSpan value, std::byte* raw_container) {
+  auto& container = *reinterpret_cast<Container*>(raw_container);
+  if (container.capacity() < value.size()) {
+    return Status::ResourceExhausted();
+  }
+  using Element = typename Container::value_type;
+  const auto* data = reinterpret_cast<const Element*>(value.data());
+  container.assign(data, data + value.size());
+  return OkStatus();
+}
+
+}  // namespace
+
+Status BufferDecoder::Read(span<std::byte> message,
+                           span<const MessageField> table) const {
+  return DecodeMessage(buffer_, message, table);
+}
+
+Status BufferDecoder::DecodeMessage(ConstByteSpan buffer,
+                                    span<std::byte> message,
+                                    span<const MessageField> table) {
+  size_t hint = 0;
+
+  while (!buffer.empty()) {
+    const ConstByteSpan field_start = buffer;
+
+    uint64_t key;
+    if (!ReadVarint(buffer, key) || !FieldKey::IsValidKey(key)) {
+      return Status::DataLoss();
+    }
+    const FieldKey field_key(static_cast<uint32_t>(key));
+
+    // Find the extent of the value before looking up the field so unknown
+    // fields are skipped without any further work.
+    uint64_t varint_value = 0;
+    ConstByteSpan value;
+    switch (field_key.wire_type()) {
+      case WireType::kVarint:
+        if (!ReadVarint(buffer, varint_value)) {
+          return Status::DataLoss();
+        }
+        break;
+      case WireType::kFixed32:
+      case WireType::kFixed64: {
+        const size_t size = field_key.wire_type() == WireType::kFixed32
+                                ? sizeof(uint32_t)
+                                : sizeof(uint64_t);
+        if (buffer.size() < size) {
+          return Status::DataLoss();
+        }
+        value = buffer.first(size);
+        buffer = buffer.subspan(size);
+        break;
+      }
+      case WireType::kDelimited: {
+        uint64_t size;
+        if (!ReadVarint(buffer, size) || size > buffer.size()) {
+          return Status::DataLoss();
+        }
+        value = buffer.first(static_cast<size_t>(size));
+        buffer = buffer.subspan(static_cast<size_t>(size));
+        break;
+      }
+    }
+
+    const MessageField* field =
+        FindField(table, field_key.field_number(), hint);
+    if (field == nullptr) {
+      // TODO: b/234873295 - Provide a way to allow the caller to inspect
+      // unknown fields, and serialize them back out later.
+      continue;
+    }
+
+    // Calculate the span of bytes corresponding to the structure field to
+    // output into.
+    const auto out =
+        message.subspan(field->field_offset(), field->field_size());
+
+    if (field->callback_type() != CallbackType::kNone) {
+      PW_TRY(DecodeCallbackField(
+          *field, field_start.first(field_start.size() - buffer.size()), out));
+      continue;
+    }
+
+    // Switch on the expected wire type of the field, not the actual, to ensure
+    // the remote encoder doesn't influence our decoding unexpectedly.
+    switch (field->wire_type()) {
+      case WireType::kVarint:
+      case WireType::kFixed32:
+      case WireType::kFixed64:
+        PW_TRY(DecodeScalar(
+            *field, field_key.wire_type(), varint_value, value, out));
+        break;
+      case WireType::kDelimited:
+        if (field_key.wire_type() != WireType::kDelimited) {
+          return Status::NotFound();
+        }
+        PW_CHECK(!field->is_repeated(),
+                 "Repeated delimited messages always require a callback");
+        if (field->nested_message_fields() != nullptr) {
+          PW_TRY(DecodeMessage(value, out, *field->nested_message_fields()));
+        } else if (field->is_fixed_size()) {
+          // Fixed-length bytes field. Struct member is a std::array<std::byte>.
+          if (out.size() < value.size()) {
+            return Status::ResourceExhausted();
+          }
+          std::memcpy(out.data(), value.data(), value.size());
+        } else if (field->is_string()) {
+          PW_TRY(StoreStringOrBytes<pw::InlineString<>>(value, out.data()));
+        } else {
+          PW_TRY(StoreStringOrBytes<pw::Vector<std::byte>>(value, out.data()));
+        }
+        break;
+    }
+  }
+
+  return OkStatus();
+}
+
+Status BufferDecoder::DecodeCallbackField(const MessageField& field,
+                                          ConstByteSpan encoded_field,
+                                          span<std::byte> out) {
+  stream::MemoryReader reader(encoded_field);
+  StreamDecoder decoder(reader);
+  PW_TRY(decoder.Next());
+
+  if (field.callback_type() == CallbackType::kSingleField) {
+    const auto* callback =
+        reinterpret_cast<const Callback<StreamEncoder, StreamDecoder>*>(
+            out.data());
+    return callback->Decode(decoder);
+  }
+
+  const auto* callback =
+      reinterpret_cast<const OneOf<StreamEncoder, StreamDecoder>*>(out.data());
+  return callback->Decode(static_cast<NullFields>(field.field_number()),
+                          decoder);
+}
+
+}  // namespace pw::protobuf
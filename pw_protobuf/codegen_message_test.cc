@@ -34,6 +34,7 @@
 #include "pw_protobuf_test_protos/full_test.pwpb.h"
 #include "pw_protobuf_test_protos/importer.pwpb.h"
 #include "pw_protobuf_test_protos/optional.pwpb.h"
+#include "pw_protobuf_test_protos/perf_test.pwpb.h"
 #include "pw_protobuf_test_protos/repeated.pwpb.h"
 
 namespace pw::protobuf {
@@ -2271,5 +2272,513 @@ TEST(CodegenMessage, OneOf_Decode_UnsetDecoderIsIgnored) {
   EXPECT_EQ(stream_decoder.Read(message), OkStatus());
 }
 
+TEST(CodegenMessage, BufferDecoderRead) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // pigweed.magic_number
+    0x08, 0x49,
+    // pigweed.ziggy
+    0x10, 0xdd, 0x01,
+    // pigweed.cycles
+    0x19, 0xde, 0xad, 0xca, 0xfe, 0x10, 0x20, 0x30, 0x40,
+    // pigweed.ratio
+    0x25, 0x8f, 0xc2, 0xb5, 0xbf,
+    // pigweed.error_message
+    0x2a, 0x10, 'n', 'o', 't', ' ', 'a', ' ',
+    't', 'y', 'p', 'e', 'w', 'r', 'i', 't', 'e', 'r',
+    // pigweed.bin
+    0x40, 0x01,
+    // pigweed.bungle
+    0x70, 0x91, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01,
+  };
+  // clang-format on
+
+  Pigweed::BufferDecoder pigweed(as_bytes(span(proto_data)));
+
+  Pigweed::Message message{};
+  const auto status = pigweed.Read(message);
+  ASSERT_EQ(status, OkStatus());
+
+  constexpr std::string_view kExpectedErrorMessage{"not a typewriter"};
+
+  EXPECT_EQ(message.magic_number, 0x49u);
+  EXPECT_EQ(message.ziggy, -111);
+  EXPECT_EQ(message.cycles, 0x40302010fecaaddeu);
+  EXPECT_EQ(message.ratio, -1.42f);
+  EXPECT_EQ(message.error_message.size(), kExpectedErrorMessage.size());
+  EXPECT_EQ(std::memcmp(message.error_message.data(),
+                        kExpectedErrorMessage.data(),
+                        kExpectedErrorMessage.size()),
+            0);
+  EXPECT_EQ(message.bin, Pigweed::Protobuf::Binary::ZERO);
+  EXPECT_EQ(message.bungle, -111);
+}
+
+TEST(CodegenMessage, BufferDecoderMatchesStreamDecoder) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // pigweed.magic_number
+    0x08, 0x49,
+    // pigweed.unknown_field (field 1000), skipped
+    0xc0, 0x3e, 0x05,
+    // pigweed.pigweed
+    0x3a, 0x02,
+    // pigweed.pigweed.status
+    0x08, 0x02,
+    // pigweed.data
+    0x5a, 0x04, 0x01, 0x02, 0x03, 0x04,
+    // pigweed.ziggy
+    0x10, 0xdd, 0x01,
+  };
+  // clang-format on
+
+  stream::MemoryReader reader(as_bytes(span(proto_data)));
+  Pigweed::StreamDecoder stream_decoder(reader);
+  Pigweed::Message stream_message{};
+  ASSERT_EQ(stream_decoder.Read(stream_message), OkStatus());
+
+  Pigweed::BufferDecoder buffer_decoder(as_bytes(span(proto_data)));
+  Pigweed::Message buffer_message{};
+  ASSERT_EQ(buffer_decoder.Read(buffer_message), OkStatus());
+
+  EXPECT_EQ(buffer_message, stream_message);
+  EXPECT_EQ(buffer_message.pigweed.status, Bool::FILE_NOT_FOUND);
+  EXPECT_EQ(buffer_message.data[3], std::byte{0x04});
+}
+
+TEST(CodegenMessage, BufferDecoderReadPackedScalarRepeated) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // uint32s[], v={0, 16, 32, 48}
+    0x0a, 0x04,
+    0x00,
+    0x10,
+    0x20,
+    0x30,
+    // uint32s[], v={64}
+    0x08, 0x40,
+    // uint32s[], v={80, 96, 112}
+    0x0a, 0x03,
+    0x50,
+    0x60,
+    0x70,
+    // fixed32s[]. v={0, 16, 32, 48}
+    0x32, 0x10,
+    0x00, 0x00, 0x00, 0x00,
+    0x10, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x00, 0x00,
+    0x30, 0x00, 0x00, 0x00,
+    // fixed32s[]. v={64, 80, 96, 112}
+    0x32, 0x10,
+    0x40, 0x00, 0x00, 0x00,
+    0x50, 0x00, 0x00, 0x00,
+    0x60, 0x00, 0x00, 0x00,
+    0x70, 0x00, 0x00, 0x00,
+    // doubles[], v={3.14159, 2.71828}
+    0x22, 0x10,
+    0x6e, 0x86, 0x1b, 0xf0, 0xf9, 0x21, 0x09, 0x40,
+    0x90, 0xf7, 0xaa, 0x95, 0x09, 0xbf, 0x05, 0x40,
+  };
+  // clang-format on
+
+  RepeatedTest::BufferDecoder repeated_test(as_bytes(span(proto_data)));
+
+  RepeatedTest::Message message{};
+  const auto status = repeated_test.Read(message);
+  ASSERT_EQ(status, OkStatus());
+
+  ASSERT_EQ(message.uint32s.size(), 8u);
+  for (unsigned short i = 0; i < 8; ++i) {
+    EXPECT_EQ(message.uint32s[i], i * 16u);
+  }
+
+  ASSERT_EQ(message.fixed32s.size(), 8u);
+  for (unsigned short i = 0; i < 8; ++i) {
+    EXPECT_EQ(message.fixed32s[i], i * 16u);
+  }
+
+  EXPECT_EQ(message.doubles[0], 3.14159);
+  EXPECT_EQ(message.doubles[1], 2.71828);
+}
+
+TEST(CodegenMessage, BufferDecoderReadPackedScalarExhausted) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // uint32s[], v={0, 16, 32, 48, 64, 80, 96, 112, 128}
+    0x0a, 0x09,
+    0x00,
+    0x10,
+    0x20,
+    0x30,
+    0x40,
+    0x50,
+    0x60,
+    0x70,
+    0x80,
+  };
+  // clang-format on
+
+  RepeatedTest::BufferDecoder repeated_test(as_bytes(span(proto_data)));
+
+  // uint32s has max_size=8, so this will exhaust the vector.
+  RepeatedTest::Message message{};
+  const auto status = repeated_test.Read(message);
+  ASSERT_EQ(status, Status::ResourceExhausted());
+}
+
+TEST(CodegenMessage, BufferDecoderReadScalarRepeatedExhausted) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // uint32s[], v={0, 16, 32, 48, 64, 80, 96, 112, 128}, not packed
+    0x08, 0x00,
+    0x08, 0x10,
+    0x08, 0x20,
+    0x08, 0x30,
+    0x08, 0x40,
+    0x08, 0x50,
+    0x08, 0x60,
+    0x08, 0x70,
+    0x08, 0x80, 0x01,
+  };
+  // clang-format on
+
+  RepeatedTest::BufferDecoder repeated_test(as_bytes(span(proto_data)));
+
+  // uint32s has max_size=8, so the last element does not fit. The elements
+  // already decoded are kept.
+  RepeatedTest::Message message{};
+  const auto status = repeated_test.Read(message);
+  ASSERT_EQ(status, Status::ResourceExhausted());
+  ASSERT_EQ(message.uint32s.size(), 8u);
+  for (unsigned short i = 0; i < 8; ++i) {
+    EXPECT_EQ(message.uint32s[i], i * 16u);
+  }
+}
+
+TEST(CodegenMessage, BufferDecoderReadTruncated) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // pigweed.error_message, declared longer than the remaining data
+    0x2a, 0x10, 'n', 'o', 't', ' ', 'a', ' ',
+  };
+  // clang-format on
+
+  Pigweed::BufferDecoder pigweed(as_bytes(span(proto_data)));
+
+  Pigweed::Message message{};
+  EXPECT_EQ(pigweed.Read(message), Status::DataLoss());
+}
+
+TEST(CodegenMessage, BufferDecoderReadStringExhausted) {
+  std::array<std::byte, 67> proto_data{};
+  // pigweed.error_message, which has max_size=64
+  proto_data[0] = std::byte{0x2a};
+  proto_data[1] = std::byte{65};
+
+  Pigweed::BufferDecoder pigweed(proto_data);
+
+  Pigweed::Message message{};
+  EXPECT_EQ(pigweed.Read(message), Status::ResourceExhausted());
+}
+
+TEST(CodegenMessage, BufferDecoderReadNestedRepeatedCallback) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // repeated.structs
+    0x2a, 0x04,
+    // repeated.structs.one v=16
+    0x08, 0x10,
+    // repeated.structs.two v=32
+    0x10, 0x20,
+    // repeated.uint32s[], v={1}
+    0x08, 0x01,
+    // repeated.structs
+    0x2a, 0x04,
+    // repeated.structs.one v=48
+    0x08, 0x30,
+    // repeated.structs.two v=64
+    0x10, 0x40,
+  };
+  // clang-format on
+
+  RepeatedTest::BufferDecoder repeated_test(as_bytes(span(proto_data)));
+
+  // Callbacks are handed a StreamDecoder positioned on the field.
+  RepeatedTest::Message message{};
+  unsigned i = 0;
+  message.structs.SetDecoder([&i](RepeatedTest::StreamDecoder& decoder) {
+    EXPECT_EQ(decoder.Field().value(), RepeatedTest::Fields::kStructs);
+
+    Struct::Message structs_message{};
+    auto structs_decoder = decoder.GetStructsDecoder();
+    const auto status = structs_decoder.Read(structs_message);
+    EXPECT_EQ(status, OkStatus());
+
+    EXPECT_LT(i, 2u);
+    EXPECT_EQ(structs_message.one, i * 32 + 16u);
+    EXPECT_EQ(structs_message.two, i * 32 + 32u);
+    ++i;
+
+    return status;
+  });
+
+  const auto status = repeated_test.Read(message);
+  ASSERT_EQ(status, OkStatus());
+  EXPECT_EQ(i, 2u);
+  ASSERT_EQ(message.uint32s.size(), 1u);
+  EXPECT_EQ(message.uint32s[0], 1u);
+}
+
+TEST(CodegenMessage, BufferDecoderReadOptionalPresent) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // optional.sometimes_present_fixed
+    0x0d, 0x2a, 0x00, 0x00, 0x00,
+    // optional.sometimes_present_varint
+    0x10, 0x2a,
+    // optional.explicitly_present_fixed
+    0x1d, 0x45, 0x00, 0x00, 0x00,
+    // optional.explicitly_present_varint
+    0x20, 0x45,
+    // optional.sometimes_empty_fixed
+    0x2a, 0x04, 0x63, 0x00, 0x00, 0x00,
+    // optional.sometimes_empty_varint
+    0x32, 0x01, 0x63,
+  };
+  // clang-format on
+
+  OptionalTest::BufferDecoder optional_test(as_bytes(span(proto_data)));
+
+  OptionalTest::Message message{};
+  const auto status = optional_test.Read(message);
+  ASSERT_EQ(status, OkStatus());
+
+  EXPECT_EQ(message.sometimes_present_fixed, 0x2a);
+  EXPECT_EQ(message.sometimes_present_varint, 0x2a);
+  EXPECT_TRUE(message.explicitly_present_fixed);
+  EXPECT_EQ(*message.explicitly_present_fixed, 0x45);
+  EXPECT_TRUE(message.explicitly_present_varint);
+  EXPECT_EQ(*message.explicitly_present_varint, 0x45);
+  EXPECT_EQ(message.sometimes_empty_fixed.size(), 1u);
+  EXPECT_EQ(message.sometimes_empty_fixed[0], 0x63);
+  EXPECT_EQ(message.sometimes_empty_varint.size(), 1u);
+  EXPECT_EQ(message.sometimes_empty_varint[0], 0x63);
+}
+
+TEST(CodegenMessage, BufferDecoderOneOf) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // type.a_message
+    0x1a, 0x02, 0x08, 0x01,
+  };
+  // clang-format on
+
+  OneOfTest::BufferDecoder buffer_decoder(as_bytes(span(proto_data)));
+
+  struct {
+    OneOfTest::Fields field;
+    OneOfTest::AMessage::Message submessage;
+    int invocations = 0;
+  } result;
+
+  OneOfTest::Message message;
+  message.type.SetDecoder(
+      [&result](OneOfTest::Fields field, OneOfTest::StreamDecoder& decoder) {
+        result.field = field;
+        result.invocations++;
+        if (field == OneOfTest::Fields::kAMessage) {
+          return decoder.GetAMessageDecoder().Read(result.submessage);
+        }
+        return Status::InvalidArgument();
+      });
+
+  EXPECT_EQ(buffer_decoder.Read(message), OkStatus());
+  EXPECT_EQ(result.field, OneOfTest::Fields::kAMessage);
+  EXPECT_EQ(result.invocations, 1);
+  EXPECT_EQ(result.submessage.a_bool, true);
+}
+
+TEST(CodegenMessage, WritePresized) {
+  constexpr uint8_t pigweed_data[] = {
+      0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80};
+
+  Pigweed::Message message{};
+  message.magic_number = 0x49u;
+  message.ziggy = -111;
+  message.cycles = 0x40302010fecaaddeu;
+  message.ratio = -1.42f;
+  message.error_message = "not a typewriter";
+  message.pigweed.status = Bool::FILE_NOT_FOUND;
+  message.bin = Pigweed::Protobuf::Binary::ZERO;
+  message.bungle = -111;
+  message.proto.bin = Proto::Binary::OFF;
+  message.proto.pigweed_pigweed_bin = Pigweed::Pigweed::Binary::ZERO;
+  message.proto.pigweed_protobuf_bin = Pigweed::Protobuf::Binary::ZERO;
+  message.proto.meta.file_name = "/etc/passwd";
+  message.proto.meta.status = Pigweed::Protobuf::Compiler::Status::FUBAR;
+  message.proto.meta.protobuf_bin = Pigweed::Protobuf::Binary::ONE;
+  message.proto.meta.pigweed_bin = Pigweed::Pigweed::Binary::ONE;
+  std::memcpy(message.data.data(), pigweed_data, sizeof(pigweed_data));
+
+  std::byte encode_buffer[Pigweed::kMaxEncodedSizeBytesWithoutValues];
+  std::byte temp_buffer[Pigweed::kScratchBufferSizeBytes];
+
+  stream::MemoryWriter writer(encode_buffer);
+  Pigweed::StreamEncoder pigweed(writer, temp_buffer);
+  ASSERT_EQ(pigweed.Write(message), OkStatus());
+
+  // Nested messages are written directly to the stream, so no scratch buffer
+  // is required.
+  std::byte presized_buffer[Pigweed::kMaxEncodedSizeBytesWithoutValues];
+  stream::MemoryWriter presized_writer(presized_buffer);
+  Pigweed::StreamEncoder presized(presized_writer, ByteSpan());
+  ASSERT_EQ(presized.WritePresized(message), OkStatus());
+
+  ConstByteSpan expected = writer.WrittenData();
+  ConstByteSpan result = presized_writer.WrittenData();
+  EXPECT_EQ(result.size(), expected.size());
+  EXPECT_EQ(std::memcmp(result.data(), expected.data(), expected.size()), 0);
+}
+
+TEST(CodegenMessage, WritePresizedMatchesWrite) {
+  PerfSnapshot::Message message{};
+  message.metadata.reason = {std::byte{'o'}, std::byte{'o'}, std::byte{'m'}};
+  message.metadata.fatal = true;
+  message.metadata.timestamp = 1'700'000'000'123;
+  message.metadata.crash_log.line_level = (1234 << 3) | 2;
+  message.metadata.crash_log.timestamp = -1;
+  message.metadata.boot_count = 0;
+  message.metadata.temperature = -40;
+  message.metadata.registers = {0, -1, 0x7fffffff, 12};
+  message.cpu.token_path = {0x1b2c3d4e, 0x5f6a7b8c};
+  message.cpu.as_float = 0.75f;
+  message.cpu.as_int = 87;
+  message.memory.samples = {0, 1, 300, 0xffffffff};
+  message.logs.first_entry_sequence_id = 7;
+
+  std::array<std::byte, PerfSnapshot::kMaxEncodedSizeBytesWithoutValues>
+      buffer;
+  PerfSnapshot::MemoryEncoder snapshot(buffer);
+  ASSERT_EQ(snapshot.Write(message), OkStatus());
+
+  std::array<std::byte, PerfSnapshot::kMaxEncodedSizeBytesWithoutValues>
+      presized_buffer;
+  PerfSnapshot::MemoryEncoder presized(presized_buffer);
+  ASSERT_EQ(presized.WritePresized(message), OkStatus());
+
+  EXPECT_EQ(presized.size(), snapshot.size());
+  EXPECT_EQ(std::memcmp(presized.data(), snapshot.data(), snapshot.size()), 0);
+}
+
+TEST(CodegenMessage, WritePresizedDefaults) {
+  PerfSnapshot::Message message{};
+
+  std::byte encode_buffer[PerfSnapshot::kMaxEncodedSizeBytesWithoutValues];
+  stream::MemoryWriter writer(encode_buffer);
+  PerfSnapshot::StreamEncoder snapshot(writer, ByteSpan());
+
+  // Empty nested messages are not written.
+  ASSERT_EQ(snapshot.WritePresized(message), OkStatus());
+  EXPECT_EQ(writer.bytes_written(), 0u);
+}
+
+TEST(CodegenMessage, WritePresizedNestedCallback) {
+  int invocations = 0;
+  PerfSnapshot::Message message{};
+  message.metadata.fatal = true;
+  message.metadata.timestamp = 1'700'000'000'123;
+  message.metadata.crash_log.line_level = (1234 << 3) | 2;
+  message.cpu.as_int = 48213;
+  message.cpu.token_path = {0x1b2c3d4e, 0x5f6a7b8c};
+  message.logs.first_entry_sequence_id = 7;
+  message.logs.entries.SetEncoder(
+      [&invocations](PerfLogEntries::StreamEncoder& encoder) {
+        invocations++;
+        PerfLogEntry::Message entry{};
+        entry.line_level = (56 << 3) | 3;
+        entry.timestamp = 12345;
+        PW_TRY(encoder.GetEntriesEncoder().Write(entry));
+        entry.flags = 1;
+        return encoder.GetEntriesEncoder().Write(entry);
+      });
+
+  std::array<std::byte, 128> buffer;
+  PerfSnapshot::MemoryEncoder snapshot(buffer);
+  ASSERT_EQ(snapshot.Write(message), OkStatus());
+  EXPECT_EQ(invocations, 1);
+
+  // Callbacks within nested messages are invoked once to size the message and
+  // again to write it.
+  std::array<std::byte, 128> presized_buffer;
+  PerfSnapshot::MemoryEncoder presized(presized_buffer);
+  ASSERT_EQ(presized.WritePresized(message), OkStatus());
+  EXPECT_EQ(invocations, 3);
+
+  EXPECT_EQ(presized.size(), snapshot.size());
+  EXPECT_EQ(std::memcmp(presized.data(), snapshot.data(), snapshot.size()), 0);
+}
+
+TEST(CodegenMessage, WritePresizedTopLevelCallback) {
+  int invocations = 0;
+  Pigweed::Message message{};
+  message.magic_number = 0x49u;
+  message.device_info.SetEncoder(
+      [&invocations](Pigweed::StreamEncoder& encoder) {
+        invocations++;
+        DeviceInfo::Message device_info{};
+        device_info.device_name = "pixel";
+        return encoder.GetDeviceInfoEncoder().Write(device_info);
+      });
+
+  std::array<std::byte, 64> buffer;
+  Pigweed::MemoryEncoder pigweed(buffer);
+
+  // Top-level callbacks don't need to be sized, so are only invoked once.
+  ASSERT_EQ(pigweed.WritePresized(message), OkStatus());
+  EXPECT_EQ(invocations, 1);
+
+  // clang-format off
+  constexpr uint8_t expected_proto[] = {
+    // pigweed.magic_number
+    0x08, 0x49,
+    // pigweed.device_info
+    0x32, 0x07,
+    // pigweed.device_info.device_name
+    0x0a, 0x05, 'p', 'i', 'x', 'e', 'l',
+  };
+  // clang-format on
+
+  EXPECT_EQ(pigweed.size(), sizeof(expected_proto));
+  EXPECT_EQ(std::memcmp(pigweed.data(), expected_proto, sizeof(expected_proto)),
+            0);
+}
+
+TEST(CodegenMessage, WritePresizedCallbackSizeMismatch) {
+  uint32_t line_level = 0x4000;
+  PerfSnapshot::Message message{};
+  message.logs.entries.SetEncoder(
+      [&line_level](PerfLogEntries::StreamEncoder& encoder) {
+        // Writes a smaller value on each invocation.
+        PerfLogEntry::Message entry{};
+        entry.line_level = line_level;
+        line_level >>= 8;
+        return encoder.GetEntriesEncoder().Write(entry);
+      });
+
+  std::array<std::byte, 64> buffer;
+  PerfSnapshot::MemoryEncoder snapshot(buffer);
+  EXPECT_EQ(snapshot.WritePresized(message), Status::OutOfRange());
+}
+
+TEST(CodegenMessage, WritePresizedExhausted) {
+  PerfSnapshot::Message message{};
+  message.metadata.timestamp = 1'700'000'000'123;
+  message.cpu.as_int = 48213;
+
+  std::array<std::byte, 8> buffer;
+  PerfSnapshot::MemoryEncoder snapshot(buffer);
+  EXPECT_EQ(snapshot.WritePresized(message), Status::ResourceExhausted());
+}
+
 }  // namespace
 }  // namespace pw::protobuf
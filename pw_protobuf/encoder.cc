@@ -15,8 +15,10 @@
 #include "pw_protobuf/encoder.h"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstring>
+#include <limits>
 #include <optional>
 
 #include "pw_assert/check.h"
@@ -26,6 +28,7 @@
 #include "pw_protobuf/serialized_size.h"
 #include "pw_protobuf/stream_decoder.h"
 #include "pw_protobuf/wire_format.h"
+#include "pw_result/result.h"
 #include "pw_span/span.h"
 #include "pw_status/status.h"
 #include "pw_status/try.h"
@@ -40,6 +43,121 @@ namespace pw::protobuf {
 
 using internal::VarintType;
 
+namespace {
+
+// Largest encoded key and length prefix of a length-delimited field.
+constexpr size_t kMaxFieldHeaderSize =
+    varint::kMaxVarint32SizeBytes + varint::kMaxVarint64SizeBytes;
+
+// Returns the elements of the pw::Vector of integers that holds a repeated
+// scalar field, as written by StreamEncoder::Write().
+ConstByteSpan RepeatedFieldBytes(const internal::MessageField& field,
+                                 ConstByteSpan values) {
+  if (field.elem_size() == sizeof(uint64_t)) {
+    const auto* vector =
+        reinterpret_cast<const pw::Vector<const uint64_t>*>(values.data());
+    return as_bytes(span(vector->data(), vector->size()));
+  }
+  if (field.elem_size() == sizeof(uint32_t)) {
+    const auto* vector =
+        reinterpret_cast<const pw::Vector<const uint32_t>*>(values.data());
+    return as_bytes(span(vector->data(), vector->size()));
+  }
+  const auto* vector =
+      reinterpret_cast<const pw::Vector<const uint8_t>*>(values.data());
+  return as_bytes(span(vector->data(), vector->size()));
+}
+
+// Returns the encoded size of the packed varints in elements. Like
+// StreamEncoder::WritePackedVarints(), the elements are encoded as unsigned
+// values of their element size.
+template <typename T>
+size_t SizeOfPackedVarintPayload(ConstByteSpan elements) {
+  size_t payload_size = 0;
+  for (size_t i = 0; i < elements.size(); i += sizeof(T)) {
+    T element;
+    std::memcpy(&element, elements.data() + i, sizeof(T));
+    payload_size += varint::EncodedSize(element);
+  }
+  return payload_size;
+}
+
+size_t SizeOfPackedVarints(const internal::MessageField& field,
+                           ConstByteSpan elements) {
+  size_t payload_size = 0;
+  if (field.elem_size() == sizeof(uint64_t)) {
+    payload_size = SizeOfPackedVarintPayload<uint64_t>(elements);
+  } else if (field.elem_size() == sizeof(uint32_t)) {
+    payload_size = SizeOfPackedVarintPayload<uint32_t>(elements);
+  } else {
+    payload_size = SizeOfPackedVarintPayload<uint8_t>(elements);
+  }
+  return SizeOfField(field.field_number(), WireType::kDelimited, payload_size);
+}
+
+// Returns the value StreamEncoder::Write() encodes for a singular or optional
+// varint field, or std::nullopt if the field is not written.
+template <typename Unsigned, typename Signed>
+std::optional<uint64_t> VarintFieldValue(const internal::MessageField& field,
+                                         ConstByteSpan values) {
+  if (field.is_optional()) {
+    if (field.varint_type() == VarintType::kUnsigned) {
+      const auto* optional =
+          reinterpret_cast<const std::optional<Unsigned>*>(values.data());
+      if (!optional->has_value()) {
+        return std::nullopt;
+      }
+      return static_cast<uint64_t>(optional->value());
+    }
+    const auto* optional =
+        reinterpret_cast<const std::optional<Signed>*>(values.data());
+    if (!optional->has_value()) {
+      return std::nullopt;
+    }
+    return field.varint_type() == VarintType::kZigZag
+               ? varint::ZigZagEncode(optional->value())
+               : static_cast<uint64_t>(optional->value());
+  }
+
+  uint64_t value = 0;
+  if (field.varint_type() == VarintType::kUnsigned) {
+    value = *reinterpret_cast<const Unsigned*>(values.data());
+  } else {
+    const Signed signed_value = *reinterpret_cast<const Signed*>(values.data());
+    value = field.varint_type() == VarintType::kZigZag
+                ? varint::ZigZagEncode(signed_value)
+                : static_cast<uint64_t>(signed_value);
+  }
+  if (value == 0) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+std::optional<uint64_t> VarintFieldValue(const internal::MessageField& field,
+                                         ConstByteSpan values) {
+  if (field.elem_size() == sizeof(uint64_t)) {
+    return VarintFieldValue<uint64_t, int64_t>(field, values);
+  }
+  if (field.elem_size() == sizeof(uint32_t)) {
+    return VarintFieldValue<uint32_t, int32_t>(field, values);
+  }
+  if (field.is_optional()) {
+    const auto* optional =
+        reinterpret_cast<const std::optional<bool>*>(values.data());
+    if (!optional->has_value()) {
+      return std::nullopt;
+    }
+    return static_cast<uint64_t>(optional->value());
+  }
+  if (!*reinterpret_cast<const bool*>(values.data())) {
+    return std::nullopt;
+  }
+  return 1;
+}
+
+}  // namespace
+
 Status StreamEncoder::WriteNestedMessage(
     uint32_t field_number,
     FunctionRef<Status(StreamEncoder&)> write_message,
@@ -237,13 +355,13 @@ Status StreamEncoder::WriteVarintField(uint32_t field_number, uint64_t value) {
 Status StreamEncoder::WriteLengthDelimitedField(uint32_t field_number,
                                                 ConstByteSpan data) {
   PW_TRY(UpdateStatusForWrite(field_number, WireType::kDelimited, data.size()));
-  status_.Update(WriteLengthDelimitedKeyAndLengthPrefix(
-      field_number, data.size(), *writer_));
-  PW_TRY(status_);
-  if (Status status = writer_->Write(data); !status.ok()) {
-    status_ = status;
-  }
-  return status_;
+
+  std::array<std::byte, kMaxFieldHeaderSize> header;
+  size_t header_size = varint::EncodeLittleEndianBase128(
+      FieldKey(field_number, WireType::kDelimited), header);
+  header_size += varint::EncodeLittleEndianBase128(
+      data.size(), span(header).subspan(header_size));
+  return WriteFieldHeaderAndData(span(header).first(header_size), data);
 }
 
 Status StreamEncoder::WriteLengthDelimitedFieldFromCallback(
@@ -306,9 +424,18 @@ Status StreamEncoder::WriteFixed(uint32_t field_number, ConstByteSpan data) {
 
   PW_TRY(UpdateStatusForWrite(field_number, type, data.size()));
 
-  WriteVarint(FieldKey(field_number, type))
-      .IgnoreError();  // TODO: b/242598609 - Handle Status properly
-  if (Status status = writer_->Write(data); !status.ok()) {
+  std::array<std::byte, varint::kMaxVarint32SizeBytes> header;
+  const size_t header_size =
+      varint::EncodeLittleEndianBase128(FieldKey(field_number, type), header);
+  return WriteFieldHeaderAndData(span(header).first(header_size), data);
+}
+
+Status StreamEncoder::WriteFieldHeaderAndData(ConstByteSpan header,
+                                              ConstByteSpan data) {
+  // Write the header and data together so that writers which support vectored
+  // writes can emit the whole field at once.
+  const std::array<ConstByteSpan, 2> field = {header, data};
+  if (Status status = writer_->WriteV(field); !status.ok()) {
     status_ = status;
   }
   return status_;
@@ -375,6 +502,242 @@ Status StreamEncoder::Write(span<const std::byte> message,
   PW_CHECK(!nested_encoder_open());
   PW_TRY(status_);
 
+  return WriteFields(message, table, /*nested_sizes=*/nullptr,
+                     /*in_nested_message=*/false);
+}
+
+Status StreamEncoder::WritePresized(span<const std::byte> message,
+                                    span<const internal::MessageField> table,
+                                    span<uint32_t> nested_sizes) {
+  PW_CHECK(!nested_encoder_open());
+  PW_TRY(status_);
+
+  // First pass: compute the size of each nested message, recording them for
+  // the second pass. The top-level fields of the message don't need to be
+  // sized.
+  NestedSizes sizes{nested_sizes, /*next=*/0};
+  const Result<size_t> size =
+      SizeFields(message, table, sizes, /*in_nested_message=*/false);
+  status_.Update(size.status());
+  PW_TRY(status_);
+
+  // Second pass: with every length prefix known, write the fields of nested
+  // messages straight to the stream.
+  sizes.next = 0;
+  return WriteFields(message, table, &sizes, /*in_nested_message=*/false);
+}
+
+Result<size_t> StreamEncoder::SizeFields(
+    span<const std::byte> message,
+    span<const internal::MessageField> table,
+    NestedSizes& nested_sizes,
+    bool in_nested_message) {
+  size_t size = 0;
+
+  for (const auto& field : table) {
+    if (!in_nested_message && field.nested_message_fields() == nullptr) {
+      continue;
+    }
+
+    ConstByteSpan values =
+        message.subspan(field.field_offset(), field.field_size());
+    PW_CHECK(values.begin() >= message.begin() &&
+             values.end() <= message.end());
+
+    if (field.callback_type() != internal::CallbackType::kNone) {
+      // The size of a callback field can only be found by invoking it.
+      if (nested_sizes.next >= nested_sizes.sizes.size()) {
+        return Status::ResourceExhausted();
+      }
+      const size_t index = nested_sizes.next++;
+
+      stream::CountingNullStream count_stream;
+      StreamEncoder count_encoder(count_stream);
+      PW_TRY(count_encoder.EncodeCallbackField(field, values));
+      PW_TRY(count_encoder.status());
+      const size_t num_bytes = count_stream.bytes_written();
+      if (num_bytes > std::numeric_limits<uint32_t>::max()) {
+        return Status::OutOfRange();
+      }
+      nested_sizes.sizes[index] = static_cast<uint32_t>(num_bytes);
+      size += num_bytes;
+      continue;
+    }
+
+    switch (field.wire_type()) {
+      case WireType::kFixed64:
+      case WireType::kFixed32: {
+        if (field.is_fixed_size()) {
+          if (static_cast<size_t>(
+                  std::count(values.begin(), values.end(), std::byte{0})) <
+              values.size()) {
+            size += SizeOfField(
+                field.field_number(), WireType::kDelimited, values.size());
+          }
+        } else if (field.is_repeated()) {
+          const ConstByteSpan elements = RepeatedFieldBytes(field, values);
+          if (!elements.empty()) {
+            size += SizeOfField(
+                field.field_number(), WireType::kDelimited, elements.size());
+          }
+        } else if (field.is_optional()) {
+          bool has_value = false;
+          if (field.elem_size() == sizeof(uint64_t)) {
+            has_value = reinterpret_cast<const std::optional<uint64_t>*>(
+                            values.data())
+                            ->has_value();
+          } else if (field.elem_size() == sizeof(uint32_t)) {
+            has_value = reinterpret_cast<const std::optional<uint32_t>*>(
+                            values.data())
+                            ->has_value();
+          }
+          if (has_value) {
+            size += SizeOfField(
+                field.field_number(), field.wire_type(), field.elem_size());
+          }
+        } else if (static_cast<size_t>(std::count(
+                       values.begin(), values.end(), std::byte{0})) <
+                   values.size()) {
+          size += SizeOfField(
+              field.field_number(), field.wire_type(), values.size());
+        }
+        break;
+      }
+      case WireType::kVarint: {
+        if (field.is_fixed_size()) {
+          if (static_cast<size_t>(
+                  std::count(values.begin(), values.end(), std::byte{0})) <
+              values.size()) {
+            size += SizeOfPackedVarints(field, values);
+          }
+        } else if (field.is_repeated()) {
+          const ConstByteSpan elements = RepeatedFieldBytes(field, values);
+          if (!elements.empty()) {
+            size += SizeOfPackedVarints(field, elements);
+          }
+        } else {
+          const std::optional<uint64_t> value = VarintFieldValue(field, values);
+          if (value.has_value()) {
+            size += SizeOfVarintField(field.field_number(), *value);
+          }
+        }
+        break;
+      }
+      case WireType::kDelimited: {
+        if (field.nested_message_fields()) {
+          if (nested_sizes.next >= nested_sizes.sizes.size()) {
+            return Status::ResourceExhausted();
+          }
+          const size_t index = nested_sizes.next++;
+
+          PW_TRY_ASSIGN(const size_t num_bytes,
+                        SizeFields(values,
+                                   *field.nested_message_fields(),
+                                   nested_sizes,
+                                   /*in_nested_message=*/true));
+          if (num_bytes == 0) {
+            // Empty nested messages are not written, so the second pass skips
+            // this message entirely. Discard any sizes recorded within it.
+            nested_sizes.next = index + 1;
+            nested_sizes.sizes[index] = 0;
+            continue;
+          }
+          if (num_bytes > std::numeric_limits<uint32_t>::max()) {
+            return Status::OutOfRange();
+          }
+          nested_sizes.sizes[index] = static_cast<uint32_t>(num_bytes);
+          size += SizeOfField(
+              field.field_number(), WireType::kDelimited, num_bytes);
+        } else if (field.is_fixed_size()) {
+          if (static_cast<size_t>(
+                  std::count(values.begin(), values.end(), std::byte{0})) <
+              values.size()) {
+            size += SizeOfField(
+                field.field_number(), WireType::kDelimited, values.size());
+          }
+        } else {
+          const size_t length =
+              field.is_string()
+                  ? reinterpret_cast<const InlineString<>*>(values.data())
+                        ->size()
+                  : reinterpret_cast<const Vector<const std::byte>*>(
+                        values.data())
+                        ->size();
+          if (length > 0) {
+            size += SizeOfField(
+                field.field_number(), WireType::kDelimited, length);
+          }
+        }
+        break;
+      }
+    }
+  }
+
+  ResetOneOfCallbacks(message, table);
+
+  return size;
+}
+
+Status StreamEncoder::WritePresizedNestedMessage(
+    uint32_t field_number,
+    span<const std::byte> message,
+    span<const internal::MessageField> table,
+    NestedSizes& nested_sizes) {
+  PW_CHECK_UINT_LT(nested_sizes.next, nested_sizes.sizes.size());
+  const uint32_t num_bytes = nested_sizes.sizes[nested_sizes.next++];
+  if (num_bytes == 0) {
+    return OkStatus();
+  }
+
+  PW_TRY(UpdateStatusForWrite(field_number, WireType::kDelimited, num_bytes));
+  WriteVarint(FieldKey(field_number, WireType::kDelimited)).IgnoreError();
+  PW_TRY(WriteVarint(num_bytes));
+  return WriteFields(
+      message, table, &nested_sizes, /*in_nested_message=*/true);
+}
+
+Status StreamEncoder::EncodeCallbackField(const internal::MessageField& field,
+                                          span<const std::byte> values) {
+  if (field.callback_type() == internal::CallbackType::kSingleField) {
+    const Callback<StreamEncoder, StreamDecoder>* callback =
+        reinterpret_cast<const Callback<StreamEncoder, StreamDecoder>*>(
+            values.data());
+    return callback->Encode(*this);
+  }
+  const OneOf<StreamEncoder, StreamDecoder>* callback =
+      reinterpret_cast<const OneOf<StreamEncoder, StreamDecoder>*>(
+          values.data());
+  return callback->Encode(*this);
+}
+
+Status StreamEncoder::EncodePresizedCallbackField(
+    const internal::MessageField& field,
+    span<const std::byte> values,
+    NestedSizes& nested_sizes) {
+  PW_CHECK_UINT_LT(nested_sizes.next, nested_sizes.sizes.size());
+  const uint32_t num_bytes = nested_sizes.sizes[nested_sizes.next++];
+
+  // The enclosing length prefix has already been written, so ensure the
+  // callback writes exactly as many bytes as it did in the first pass. The
+  // stream is not limited to that size, since nested encoders opened by the
+  // callback reserve space for their length prefix beyond what they write.
+  stream::LimitedStreamWriter write_stream(*writer_);
+  stream::Writer* const writer = writer_;
+  writer_ = &write_stream;
+  const Status status = EncodeCallbackField(field, values);
+  writer_ = writer;
+  PW_TRY(status);
+
+  if (write_stream.bytes_written() != num_bytes) {
+    status_ = Status::OutOfRange();
+  }
+  return status_;
+}
+
+Status StreamEncoder::WriteFields(span<const std::byte> message,
+                                  span<const internal::MessageField> table,
+                                  NestedSizes* nested_sizes,
+                                  bool in_nested_message) {
   for (const auto& field : table) {
     // Calculate the span of bytes corresponding to the structure field to
     // read from.
@@ -385,17 +748,12 @@ Status StreamEncoder::Write(span<const std::byte> message,
 
     // If the field is using callbacks, interpret the input field accordingly
     // and allow the caller to provide custom handling.
-    if (field.callback_type() == internal::CallbackType::kSingleField) {
-      const Callback<StreamEncoder, StreamDecoder>* callback =
-          reinterpret_cast<const Callback<StreamEncoder, StreamDecoder>*>(
-              values.data());
-      PW_TRY(callback->Encode(*this));
-      continue;
-    } else if (field.callback_type() == internal::CallbackType::kOneOfGroup) {
-      const OneOf<StreamEncoder, StreamDecoder>* callback =
-          reinterpret_cast<const OneOf<StreamEncoder, StreamDecoder>*>(
-              values.data());
-      PW_TRY(callback->Encode(*this));
+    if (field.callback_type() != internal::CallbackType::kNone) {
+      if (nested_sizes != nullptr && in_nested_message) {
+        PW_TRY(EncodePresizedCallbackField(field, values, *nested_sizes));
+      } else {
+        PW_TRY(EncodeCallbackField(field, values));
+      }
       continue;
     }
 
@@ -656,7 +1014,14 @@ Status StreamEncoder::Write(span<const std::byte> message,
         // size (we always need a type).
         PW_CHECK(!field.is_repeated(),
                  "Repeated delimited messages always require a callback");
-        if (field.nested_message_fields()) {
+        if (field.nested_message_fields() && nested_sizes != nullptr) {
+          // Nested Message written by WritePresized(). Its size is known, so
+          // its fields are written directly to this encoder's stream.
+          PW_TRY(WritePresizedNestedMessage(field.field_number(),
+                                            values,
+                                            *field.nested_message_fields(),
+                                            *nested_sizes));
+        } else if (field.nested_message_fields()) {
           // Nested Message. Struct member is an embedded struct for the
           // nested field. Obtain a nested encoder and recursively call Write()
           // using the fields table pointer from this field.
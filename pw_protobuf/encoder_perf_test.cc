@@ -16,9 +16,12 @@
 
 #include "pw_bytes/span.h"
 #include "pw_perf_test/perf_test.h"
+#include "pw_protobuf/buffer_decoder.h"
 #include "pw_protobuf/buffer_encoder.h"
 #include "pw_protobuf/encoder.h"
+#include "pw_protobuf/stream_decoder.h"
 #include "pw_protobuf_test_protos/full_test.pwpb.h"
+#include "pw_protobuf_test_protos/perf_test.pwpb.h"
 #include "pw_span/span.h"
 #include "pw_status/status.h"
 #include "pw_stream/memory_stream.h"
@@ -27,6 +30,9 @@ namespace pw::protobuf {
 namespace {
 
 namespace Pigweed = test::pwpb::Pigweed;
+namespace PerfLogEntry = test::pwpb::PerfLogEntry;
+namespace PerfMetric = test::pwpb::PerfMetric;
+namespace PerfSnapshot = test::pwpb::PerfSnapshot;
 
 template <typename T>
 inline void DoNotOptimize(const T& value) {
@@ -197,5 +203,177 @@ void BufferEncodeNestedUncheckedLarge(pw::perf_test::State& state) {
 PW_PERF_TEST(BufferEncodeNestedMessageUncheckedLarge,
              BufferEncodeNestedUncheckedLarge);
 
+// Decode benchmarks for messages shaped like typical log entries and metrics.
+// Each message is encoded once up front, then repeatedly decoded into its
+// struct with both StreamDecoder::Read() and BufferDecoder::Read().
+
+template <typename Container>
+void AssignBytes(Container& container, std::string_view value) {
+  const ConstByteSpan bytes = as_bytes(span(value));
+  container.assign(bytes.begin(), bytes.end());
+}
+
+ConstByteSpan EncodeLogEntry(ByteSpan buffer) {
+  PerfLogEntry::Message entry{};
+  AssignBytes(entry.message, "Battery voltage is 3.7V; charging");
+  entry.line_level = (1234 << 3) | 2;
+  entry.flags = 1;
+  entry.timestamp = 1'700'000'000'123;
+  AssignBytes(entry.module, "PWR");
+  AssignBytes(entry.file, "pw_system/battery.cc");
+  AssignBytes(entry.thread, "power");
+
+  PerfLogEntry::MemoryEncoder encoder(buffer);
+  encoder.Write(entry).IgnoreError();
+  return encoder;
+}
+
+ConstByteSpan EncodeMetric(ByteSpan buffer) {
+  PerfMetric::Message metric{};
+  metric.token_path = {0x1b2c3d4e, 0x5f6a7b8c, 0x9dae0f10};
+  metric.as_int = 48213;
+  for (uint32_t i = 0; i < metric.samples.max_size(); ++i) {
+    metric.samples.push_back(i * 997);
+  }
+
+  PerfMetric::MemoryEncoder encoder(buffer);
+  encoder.Write(metric).IgnoreError();
+  return encoder;
+}
+
+void StreamDecodeLogEntry(pw::perf_test::State& state) {
+  std::byte encode_buffer[PerfLogEntry::kMaxEncodedSizeBytes];
+  const ConstByteSpan encoded = EncodeLogEntry(encode_buffer);
+
+  while (state.KeepRunning()) {
+    stream::MemoryReader reader(encoded);
+    PerfLogEntry::StreamDecoder decoder(reader);
+    PerfLogEntry::Message entry{};
+    decoder.Read(entry).IgnoreError();
+    DoNotOptimize(entry);
+  }
+}
+PW_PERF_TEST(StreamDecodeLogEntry, StreamDecodeLogEntry);
+
+void BufferDecodeLogEntry(pw::perf_test::State& state) {
+  std::byte encode_buffer[PerfLogEntry::kMaxEncodedSizeBytes];
+  const ConstByteSpan encoded = EncodeLogEntry(encode_buffer);
+
+  while (state.KeepRunning()) {
+    PerfLogEntry::BufferDecoder decoder(encoded);
+    PerfLogEntry::Message entry{};
+    decoder.Read(entry).IgnoreError();
+    DoNotOptimize(entry);
+  }
+}
+PW_PERF_TEST(BufferDecodeLogEntry, BufferDecodeLogEntry);
+
+void StreamDecodeMetric(pw::perf_test::State& state) {
+  std::byte encode_buffer[PerfMetric::kMaxEncodedSizeBytes];
+  const ConstByteSpan encoded = EncodeMetric(encode_buffer);
+
+  while (state.KeepRunning()) {
+    stream::MemoryReader reader(encoded);
+    PerfMetric::StreamDecoder decoder(reader);
+    PerfMetric::Message metric{};
+    decoder.Read(metric).IgnoreError();
+    DoNotOptimize(metric);
+  }
+}
+PW_PERF_TEST(StreamDecodeMetric, StreamDecodeMetric);
+
+void BufferDecodeMetric(pw::perf_test::State& state) {
+  std::byte encode_buffer[PerfMetric::kMaxEncodedSizeBytes];
+  const ConstByteSpan encoded = EncodeMetric(encode_buffer);
+
+  while (state.KeepRunning()) {
+    PerfMetric::BufferDecoder decoder(encoded);
+    PerfMetric::Message metric{};
+    decoder.Read(metric).IgnoreError();
+    DoNotOptimize(metric);
+  }
+}
+PW_PERF_TEST(BufferDecodeMetric, BufferDecodeMetric);
+
+// Struct encode benchmarks for a message with several levels of nesting,
+// comparing Write(), which stages nested messages in scratch buffers, with
+// WritePresized(), which sizes them up front and writes them in place.
+
+void FillSnapshot(PerfSnapshot::Message& snapshot) {
+  AssignBytes(snapshot.metadata.reason, "Watchdog timeout in main loop");
+  snapshot.metadata.fatal = true;
+  snapshot.metadata.timestamp = 1'700'000'000'123;
+  AssignBytes(snapshot.metadata.crash_log.message,
+              "Main loop stalled for 5000 ms waiting on the sensor bus mutex");
+  snapshot.metadata.crash_log.line_level = (1234 << 3) | 2;
+  snapshot.metadata.crash_log.timestamp = 1'700'000'000'100;
+  AssignBytes(snapshot.metadata.crash_log.module, "SYS");
+  AssignBytes(snapshot.metadata.crash_log.file, "pw_system/work_queue.cc");
+  snapshot.cpu.token_path = {0x1b2c3d4e, 0x5f6a7b8c};
+  snapshot.cpu.as_int = 87;
+  snapshot.memory.token_path = {0x9dae0f10};
+  snapshot.memory.as_int = 48213;
+  for (uint32_t i = 0; i < 32; ++i) {
+    snapshot.cpu.samples.push_back(i * 7);
+    snapshot.memory.samples.push_back(i * 997);
+  }
+  snapshot.logs.first_entry_sequence_id = 7;
+}
+
+void MemoryEncodeSnapshot(pw::perf_test::State& state) {
+  PerfSnapshot::Message snapshot{};
+  FillSnapshot(snapshot);
+  std::byte encode_buffer[512];
+
+  while (state.KeepRunning()) {
+    PerfSnapshot::MemoryEncoder encoder(encode_buffer);
+    encoder.Write(snapshot).IgnoreError();
+    DoNotOptimize(encode_buffer);
+  }
+}
+PW_PERF_TEST(MemoryEncodeSnapshot, MemoryEncodeSnapshot);
+
+void MemoryEncodeSnapshotPresized(pw::perf_test::State& state) {
+  PerfSnapshot::Message snapshot{};
+  FillSnapshot(snapshot);
+  std::byte encode_buffer[512];
+
+  while (state.KeepRunning()) {
+    PerfSnapshot::MemoryEncoder encoder(encode_buffer);
+    encoder.WritePresized(snapshot).IgnoreError();
+    DoNotOptimize(encode_buffer);
+  }
+}
+PW_PERF_TEST(MemoryEncodeSnapshotPresized, MemoryEncodeSnapshotPresized);
+
+void StreamEncodeSnapshot(pw::perf_test::State& state) {
+  PerfSnapshot::Message snapshot{};
+  FillSnapshot(snapshot);
+  std::byte encode_buffer[512];
+  std::byte scratch_buffer[PerfSnapshot::kScratchBufferSizeBytes];
+
+  while (state.KeepRunning()) {
+    stream::MemoryWriter writer(encode_buffer);
+    PerfSnapshot::StreamEncoder encoder(writer, scratch_buffer);
+    encoder.Write(snapshot).IgnoreError();
+    DoNotOptimize(encode_buffer);
+  }
+}
+PW_PERF_TEST(StreamEncodeSnapshot, StreamEncodeSnapshot);
+
+void StreamEncodeSnapshotPresized(pw::perf_test::State& state) {
+  PerfSnapshot::Message snapshot{};
+  FillSnapshot(snapshot);
+  std::byte encode_buffer[512];
+
+  while (state.KeepRunning()) {
+    stream::MemoryWriter writer(encode_buffer);
+    PerfSnapshot::StreamEncoder encoder(writer, ByteSpan());
+    encoder.WritePresized(snapshot).IgnoreError();
+    DoNotOptimize(encode_buffer);
+  }
+}
+PW_PERF_TEST(StreamEncodeSnapshotPresized, StreamEncodeSnapshotPresized);
+
 }  // namespace
 }  // namespace pw::protobuf
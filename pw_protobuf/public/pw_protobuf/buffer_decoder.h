@@ -0,0 +1,79 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+
+#include "pw_bytes/span.h"
+#include "pw_protobuf/internal/codegen.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+
+namespace pw::protobuf {
+
+/// @module{pw_protobuf}
+
+/// Decodes a protobuf message held entirely in memory into its generated
+/// message struct.
+///
+/// `BufferDecoder` is the in-memory counterpart of `StreamDecoder::Read()`. It
+/// walks the same generated `MessageField` tables, but reads fields directly
+/// out of the buffer rather than pulling them through a `stream::Reader`,
+/// avoiding a virtual call and a status check for every key, length, and
+/// value. Packed repeated fields are decoded in bulk, and nested messages are
+/// decoded recursively from the same buffer.
+///
+/// Fields that use callbacks are decoded lazily: a `StreamDecoder` over the
+/// bytes of the field is only constructed when a callback field is present in
+/// the encoded message, and it is passed to the callback positioned on that
+/// field, exactly as it would be by `StreamDecoder::Read()`.
+///
+/// This class is not used directly. Instead, use the `BufferDecoder` generated
+/// for each message:
+///
+/// @code{.cpp}
+///   Customer::Message customer{};
+///   Customer::BufferDecoder decoder(encoded_customer);
+///   PW_TRY(decoder.Read(customer));
+/// @endcode
+class BufferDecoder {
+ public:
+  /// Creates a decoder for the serialized message in `buffer`.
+  constexpr explicit BufferDecoder(ConstByteSpan buffer) : buffer_(buffer) {}
+
+ protected:
+  // Decodes the buffer into the structure contained within message according
+  // to the description of fields in table.
+  //
+  // This is called by codegen subclass Read() functions that accept a typed
+  // struct Message reference, using the appropriate codegen MessageField table
+  // corresponding to that type.
+  Status Read(span<std::byte> message,
+              span<const internal::MessageField> table) const;
+
+ private:
+  static Status DecodeMessage(ConstByteSpan buffer,
+                              span<std::byte> message,
+                              span<const internal::MessageField> table);
+
+  // Invokes the decode callback stored in out with a StreamDecoder positioned
+  // on encoded_field, which holds the field's complete key and value.
+  static Status DecodeCallbackField(const internal::MessageField& field,
+                                    ConstByteSpan encoded_field,
+                                    span<std::byte> out);
+
+  ConstByteSpan buffer_;
+};
+
+}  // namespace pw::protobuf
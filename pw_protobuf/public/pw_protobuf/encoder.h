@@ -30,6 +30,7 @@
 #include "pw_protobuf/config.h"
 #include "pw_protobuf/internal/codegen.h"
 #include "pw_protobuf/wire_format.h"
+#include "pw_result/result.h"
 #include "pw_span/span.h"
 #include "pw_status/status.h"
 #include "pw_status/status_with_size.h"
@@ -775,6 +776,38 @@ class StreamEncoder {
   Status Write(span<const std::byte> message,
                span<const internal::MessageField> table);
 
+  // Writes proto values to the stream from the structure contained within
+  // message without staging nested messages in the scratch buffer.
+  //
+  // A first pass computes the encoded size of every nested message in the
+  // structure, storing them in nested_sizes in the order the table is walked.
+  // A second pass then writes each nested message's key and length prefix
+  // followed directly by its fields. nested_sizes must have room for at least
+  // NestedSizeCount(table) entries.
+  //
+  // This is called by codegen subclass WritePresized() functions.
+  Status WritePresized(span<const std::byte> message,
+                       span<const internal::MessageField> table,
+                       span<uint32_t> nested_sizes);
+
+  // Returns the number of sizes recorded by WritePresized() for the message
+  // described by table: one for each nested message, and one for each callback
+  // field within a nested message.
+  static constexpr size_t NestedSizeCount(
+      span<const internal::MessageField> table,
+      bool in_nested_message = false) {
+    size_t count = 0;
+    for (const internal::MessageField& field : table) {
+      if (field.callback_type() != internal::CallbackType::kNone) {
+        count += in_nested_message ? 1 : 0;
+      } else if (field.nested_message_fields() != nullptr) {
+        count += 1 + NestedSizeCount(*field.nested_message_fields(),
+                                     /*in_nested_message=*/true);
+      }
+    }
+    return count;
+  }
+
   // Protected method to create a nested encoder, specifying whether the field
   // should be written when no fields were added to the nested encoder. Exposed
   // using an enum in the public API, for better readability.
@@ -785,6 +818,13 @@ class StreamEncoder {
 
   struct NestedCountingEncoderTag {};
 
+  // The nested message and callback sizes recorded by the first pass of
+  // WritePresized(), which the second pass consumes in the same order.
+  struct NestedSizes {
+    span<uint32_t> sizes;
+    size_t next;
+  };
+
   constexpr StreamEncoder(StreamEncoder& parent,
                           ByteSpan scratch_buffer,
                           bool write_when_empty = true)
@@ -839,12 +879,48 @@ class StreamEncoder {
 
   ByteSpan GetNestedScratchBuffer(uint32_t field_number);
 
+  // Implementation of Write() and WritePresized(). When nested_sizes is set,
+  // nested messages are written directly using the sizes it holds rather than
+  // staged through nested encoders.
+  Status WriteFields(span<const std::byte> message,
+                     span<const internal::MessageField> table,
+                     NestedSizes* nested_sizes,
+                     bool in_nested_message);
+
+  // Computes the encoded size of the fields of a nested message, recording
+  // the sizes of the nested messages and callback fields within it. At the
+  // top level, only nested messages are sized.
+  Result<size_t> SizeFields(span<const std::byte> message,
+                            span<const internal::MessageField> table,
+                            NestedSizes& nested_sizes,
+                            bool in_nested_message);
+
+  // Writes a nested message field for WritePresized().
+  Status WritePresizedNestedMessage(uint32_t field_number,
+                                    span<const std::byte> message,
+                                    span<const internal::MessageField> table,
+                                    NestedSizes& nested_sizes);
+
+  // Invokes the Callback or OneOf encode callback stored in values.
+  Status EncodeCallbackField(const internal::MessageField& field,
+                             span<const std::byte> values);
+
+  // Writes a callback field within a nested message for WritePresized(),
+  // verifying the callback writes the same number of bytes in both passes.
+  Status EncodePresizedCallbackField(const internal::MessageField& field,
+                                     span<const std::byte> values,
+                                     NestedSizes& nested_sizes);
+
   // Implementation for encoding all varint field types.
   Status WriteVarintField(uint32_t field_number, uint64_t value);
 
   // Implementation for encoding all length-delimited field types.
   Status WriteLengthDelimitedField(uint32_t field_number, ConstByteSpan data);
 
+  // Writes an encoded field key and optional length prefix followed by the
+  // field's data, updating the encoder's status.
+  Status WriteFieldHeaderAndData(ConstByteSpan header, ConstByteSpan data);
+
   Status WriteLengthDelimitedFieldFromCallback(
       uint32_t field_number,
       size_t num_bytes,
@@ -188,6 +188,7 @@ constexpr std::false_type kInvalidMessageStruct{};
 
 }  // namespace internal
 
+class BufferDecoder;
 class StreamEncoder;
 class StreamDecoder;
 
@@ -240,6 +241,7 @@ union Callback {
  private:
   friend StreamDecoder;
   friend StreamEncoder;
+  friend ::pw::protobuf::BufferDecoder;
 
   // Called by StreamEncoder to encode the structure member.
   // Returns OkStatus() if this has not been set by the caller, the default
@@ -321,6 +323,7 @@ struct OneOf {
  private:
   friend StreamDecoder;
   friend StreamEncoder;
+  friend ::pw::protobuf::BufferDecoder;
 
   constexpr void ResetForNewWrite() const { invoked_ = false; }
 
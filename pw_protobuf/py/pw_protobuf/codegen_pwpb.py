@@ -86,7 +86,7 @@ class ClassType(enum.Enum):
 
     MEMORY_ENCODER = 1
     STREAMING_ENCODER = 2
-    # MEMORY_DECODER = 3
+    BUFFER_DECODER = 3
     STREAMING_DECODER = 4
     BUFFER_ENCODER = 5
 
@@ -100,6 +100,7 @@ class ClassType(enum.Enum):
             ClassType.MEMORY_ENCODER,
             ClassType.BUFFER_ENCODER,
             ClassType.STREAMING_DECODER,
+            ClassType.BUFFER_DECODER,
         )
 
     def base_class_name(self) -> str:
@@ -109,6 +110,7 @@ class ClassType(enum.Enum):
             ClassType.MEMORY_ENCODER: 'MemoryEncoder',
             ClassType.STREAMING_DECODER: 'StreamDecoder',
             ClassType.BUFFER_ENCODER: 'BufferEncoderView',
+            ClassType.BUFFER_DECODER: 'BufferDecoder',
         }[self]
 
     def codegen_class_name(self) -> str:
@@ -118,6 +120,7 @@ class ClassType(enum.Enum):
             ClassType.MEMORY_ENCODER: 'MemoryEncoder',
             ClassType.STREAMING_DECODER: 'StreamDecoder',
             ClassType.BUFFER_ENCODER: 'BufferEncoder',
+            ClassType.BUFFER_DECODER: 'BufferDecoder',
         }[self]
 
     def is_encoder(self) -> bool:
@@ -127,6 +130,7 @@ class ClassType(enum.Enum):
             ClassType.MEMORY_ENCODER: True,
             ClassType.STREAMING_DECODER: False,
             ClassType.BUFFER_ENCODER: True,
+            ClassType.BUFFER_DECODER: False,
         }[self]
 
     def is_decoder(self) -> bool:
@@ -3141,6 +3145,10 @@ def proto_field_methods(class_type: ClassType, field_type: int) -> list:
     if class_type == ClassType.BUFFER_ENCODER:
         return PROTO_FIELD_BUFFER_WRITE_METHODS[field_type]
 
+    # BufferDecoder only decodes whole message structs with Read().
+    if class_type == ClassType.BUFFER_DECODER:
+        return []
+
     return (
         PROTO_FIELD_WRITE_METHODS[field_type]
         if class_type.is_encoder()
@@ -3274,6 +3282,22 @@ def generate_class_for_message(
                 )
             output.write_line('}')
 
+            output.write_line()
+            output.write_line(
+                '::pw::Status WritePresized(const Message& message) {'
+            )
+            with output.indent():
+                output.write_line(
+                    'std::array<uint32_t, NestedSizeCount(kMessageFields)> '
+                    'nested_sizes;'
+                )
+                output.write_line(
+                    f'return {base_class}::WritePresized('
+                    'pw::as_bytes(pw::span(&message, 1)), kMessageFields, '
+                    'nested_sizes);'
+                )
+            output.write_line('}')
+
         # Generate methods for each of the message's fields.
         for field in message.fields():
             for method_class in proto_field_methods(class_type, field.type()):
@@ -3552,6 +3576,7 @@ def forward_declare(
     # Declare the message's decoder classes.
     output.write_line()
     output.write_line('class StreamDecoder;')
+    output.write_line('class BufferDecoder;')
 
     # Declare the message's enums.
     for child in message.children():
@@ -3909,6 +3934,7 @@ def generate_code_for_package(
     output.write_line('#include "pw_containers/vector.h"')
     output.write_line('#include "pw_preprocessor/compiler.h"')
     output.write_line('#include "pw_protobuf/encoder.h"')
+    output.write_line('#include "pw_protobuf/buffer_decoder.h"')
     output.write_line('#include "pw_protobuf/buffer_encoder.h"')
     output.write_line('#include "pw_protobuf/find.h"')
     output.write_line('#include "pw_protobuf/internal/codegen.h"')
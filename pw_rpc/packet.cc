@@ -16,6 +16,9 @@
 
 #include "pw_log/log.h"
 #include "pw_protobuf/decoder.h"
+#include "pw_protobuf/wire_format.h"
+#include "pw_status/try.h"
+#include "pw_varint/varint.h"
 
 namespace pw::rpc::internal {
 
@@ -91,6 +94,43 @@ Result<ConstByteSpan> Packet::Encode(ByteSpan buffer) const {
     rpc_packet.WritePayload(payload_).IgnoreError();
   }
 
+  EncodeFieldsExceptPayload(rpc_packet);
+
+  if (rpc_packet.status().ok()) {
+    return ConstByteSpan(rpc_packet);
+  }
+  return rpc_packet.status();
+}
+
+Result<ConstByteSpan> Packet::EncodeHeader(ByteSpan buffer,
+                                           size_t payload_size) const {
+  RpcPacket::MemoryEncoder rpc_packet(buffer);
+  EncodeFieldsExceptPayload(rpc_packet);
+  PW_TRY(rpc_packet.status());
+  size_t size = ConstByteSpan(rpc_packet).size();
+
+  // An empty payload is omitted, as in Encode().
+  if (payload_size == 0) {
+    return buffer.first(size);
+  }
+
+  // Write the payload's key and length, but not the payload itself, which
+  // follows the header.
+  const uint32_t key = protobuf::FieldKey(
+      static_cast<uint32_t>(RpcPacket::Fields::kPayload),
+      protobuf::WireType::kDelimited);
+  for (uint64_t value : {uint64_t{key}, uint64_t{payload_size}}) {
+    const size_t written = varint::Encode(value, buffer.subspan(size));
+    if (written == 0) {
+      return Status::ResourceExhausted();
+    }
+    size += written;
+  }
+  return buffer.first(size);
+}
+
+void Packet::EncodeFieldsExceptPayload(
+    RpcPacket::MemoryEncoder& rpc_packet) const {
   rpc_packet.WriteType(type_).IgnoreError();
   rpc_packet.WriteChannelId(channel_id_).IgnoreError();
   rpc_packet.WriteServiceId(service_id_).IgnoreError();
@@ -105,11 +145,6 @@ Result<ConstByteSpan> Packet::Encode(ByteSpan buffer) const {
   if (call_id_ != 0) {
     rpc_packet.WriteCallId(call_id_).IgnoreError();
   }
-
-  if (rpc_packet.status().ok()) {
-    return ConstByteSpan(rpc_packet);
-  }
-  return rpc_packet.status();
 }
 
 size_t Packet::MinEncodedSizeBytes() const {
@@ -97,6 +97,56 @@ TEST(Packet, Encode_BufferTooSmall) {
   EXPECT_EQ(Status::ResourceExhausted(), result.status());
 }
 
+TEST(Packet, EncodeHeader_PayloadFollowsHeader) {
+  byte buffer[64];
+
+  Packet packet(PacketType::RESPONSE, 1, 42, 100, 7);
+
+  auto header = packet.EncodeHeader(buffer, kPayload.size());
+  ASSERT_EQ(OkStatus(), header.status());
+  EXPECT_LE(header->size(), Packet::kMinEncodedSizeWithoutPayload);
+  std::memcpy(buffer + header->size(), kPayload.data(), kPayload.size());
+
+  auto result = Packet::FromBuffer(
+      span(buffer, header->size() + kPayload.size()));
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(PacketType::RESPONSE, result->type());
+  EXPECT_EQ(1u, result->channel_id());
+  EXPECT_EQ(42u, result->service_id());
+  EXPECT_EQ(100u, result->method_id());
+  EXPECT_EQ(7u, result->call_id());
+  ASSERT_EQ(kPayload.size(), result->payload().size());
+  EXPECT_EQ(0,
+            std::memcmp(
+                result->payload().data(), kPayload.data(), kPayload.size()));
+}
+
+TEST(Packet, EncodeHeader_EmptyPayloadMatchesEncode) {
+  byte header_buffer[64];
+  byte buffer[64];
+
+  Packet packet(PacketType::SERVER_ERROR, 1, 42, 100, 7);
+  packet.set_status(Status::NotFound());
+
+  auto header = packet.EncodeHeader(header_buffer, 0);
+  ASSERT_EQ(OkStatus(), header.status());
+  auto encoded = packet.Encode(buffer);
+  ASSERT_EQ(OkStatus(), encoded.status());
+  ASSERT_EQ(encoded->size(), header->size());
+  EXPECT_EQ(0, std::memcmp(buffer, header_buffer, header->size()));
+}
+
+TEST(Packet, EncodeHeader_BufferTooSmall) {
+  Packet packet(PacketType::RESPONSE, 1, 42, 100, 7);
+
+  byte buffer[16];
+  EXPECT_EQ(Status::ResourceExhausted(),
+            packet.EncodeHeader(span(buffer).first(2), 4).status());
+  // Room for every field except the payload's key and length.
+  EXPECT_EQ(Status::ResourceExhausted(),
+            packet.EncodeHeader(span(buffer).first(16), 4).status());
+}
+
 TEST(Packet, Decode_ValidPacket) {
   auto result = Packet::FromBuffer(kEncoded);
   ASSERT_TRUE(result.ok());
@@ -110,6 +110,16 @@ class Packet {
   // Encodes the packet into its wire format. Returns the encoded size.
   Result<ConstByteSpan> Encode(ByteSpan buffer) const;
 
+  // Encodes all of the packet's fields except for the payload's contents, and
+  // ends with the payload's key and the given length, so that the payload can
+  // directly follow the header in memory. The packet's own payload is ignored.
+  // This allows a header to be written into reserved space in front of a
+  // payload, such as the headroom of a MultiBuf, without copying the payload.
+  //
+  // At most kMinEncodedSizeWithoutPayload bytes are written.
+  Result<ConstByteSpan> EncodeHeader(ByteSpan buffer,
+                                     size_t payload_size) const;
+
   // Determines the space required to encode the packet proto fields for a
   // response, excluding the payload. This may be used to split the buffer into
   // reserved space and available space for the payload.
@@ -148,6 +158,8 @@ class Packet {
   void DebugLog() const;
 
  private:
+  void EncodeFieldsExceptPayload(pwpb::RpcPacket::MemoryEncoder& encoder) const;
+
   pwpb::PacketType type_;
   uint32_t channel_id_;
   uint32_t service_id_;
@@ -0,0 +1,133 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc_transport/frame_batcher.h"
+
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <utility>
+
+namespace pw::rpc {
+
+FrameBatcher::FrameBatcher(stream::Writer& writer,
+                           sync::Mutex& write_mutex,
+                           ByteSpan buffer,
+                           FrameBatcherTracker* tracker)
+    : writer_(writer),
+      write_mutex_(write_mutex),
+      tracker_(tracker),
+      max_batch_size_(buffer.size() / 2),
+      writing_(buffer.first(max_batch_size_)),
+      pending_(buffer.subspan(max_batch_size_, max_batch_size_)) {}
+
+Status FrameBatcher::Send(RpcFrame frame) {
+  const size_t frame_size = frame.header.size() + frame.payload.size();
+  bool release_writer = false;
+  {
+    std::lock_guard lock(batch_mutex_);
+    if (writer_active_) {
+      if (TryAppend(frame)) {
+        if (tracker_ != nullptr) {
+          tracker_->FrameQueued(frame_size);
+        }
+        return OkStatus();
+      }
+    } else {
+      // No other thread is writing, so this thread writes its own frame and
+      // then any frames queued meanwhile.
+      writer_active_ = true;
+      release_writer = true;
+    }
+  }
+
+  std::lock_guard lock(write_mutex_);
+  // Frames already queued were sent first, so write them before this one.
+  Status status = WritePending(/*release_writer=*/false);
+
+  const std::array<ConstByteSpan, 2> frame_data = {frame.header,
+                                                   frame.payload};
+  const Status frame_status = writer_.WriteV(frame_data);
+  if (tracker_ != nullptr) {
+    if (frame_status.ok()) {
+      tracker_->FrameWritten(frame_size);
+    } else {
+      tracker_->WriteError(frame_status);
+    }
+  }
+  status.Update(frame_status);
+
+  if (release_writer) {
+    status.Update(WritePending(/*release_writer=*/true));
+  }
+  return status;
+}
+
+Status FrameBatcher::Flush() {
+  std::lock_guard lock(write_mutex_);
+  return WritePending(/*release_writer=*/false);
+}
+
+bool FrameBatcher::TryAppend(const RpcFrame& frame) {
+  const size_t frame_size = frame.header.size() + frame.payload.size();
+  if (frame_size > pending_.size() - pending_size_) {
+    return false;
+  }
+  std::byte* const end = pending_.data() + pending_size_;
+  if (!frame.header.empty()) {
+    std::memcpy(end, frame.header.data(), frame.header.size());
+  }
+  if (!frame.payload.empty()) {
+    std::memcpy(end + frame.header.size(),
+                frame.payload.data(),
+                frame.payload.size());
+  }
+  pending_size_ += frame_size;
+  pending_frames_ += 1;
+  return true;
+}
+
+Status FrameBatcher::WritePending(bool release_writer) {
+  Status status;
+  while (true) {
+    size_t batch_size;
+    size_t frame_count;
+    {
+      std::lock_guard lock(batch_mutex_);
+      if (pending_size_ == 0) {
+        if (release_writer) {
+          writer_active_ = false;
+        }
+        return status;
+      }
+      // Swap the halves of the buffer so that other threads can queue frames
+      // while this batch is written.
+      std::swap(writing_, pending_);
+      batch_size = std::exchange(pending_size_, 0);
+      frame_count = std::exchange(pending_frames_, 0);
+    }
+
+    const Status write_status = writer_.Write(writing_.first(batch_size));
+    if (tracker_ != nullptr) {
+      if (write_status.ok()) {
+        tracker_->BatchWritten(frame_count, batch_size);
+      } else {
+        tracker_->WriteError(write_status);
+      }
+    }
+    status.Update(write_status);
+  }
+}
+
+}  // namespace pw::rpc
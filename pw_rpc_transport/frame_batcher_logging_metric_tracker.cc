@@ -0,0 +1,46 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#define PW_LOG_MODULE_NAME "PW_RPC"
+
+#include "pw_rpc_transport/frame_batcher_logging_metric_tracker.h"
+
+#include "pw_log/log.h"
+
+namespace pw::rpc {
+
+void FrameBatcherLoggingMetricTracker::FrameQueued(size_t) {
+  frames_queued_.Increment();
+}
+
+void FrameBatcherLoggingMetricTracker::BatchWritten(size_t frame_count,
+                                                    size_t batch_size) {
+  batches_written_.Increment();
+  batched_frames_.Increment(static_cast<uint32_t>(frame_count));
+  batched_bytes_.Increment(static_cast<uint32_t>(batch_size));
+  if (batch_size > largest_batch_.value()) {
+    largest_batch_.Set(static_cast<uint32_t>(batch_size));
+  }
+}
+
+void FrameBatcherLoggingMetricTracker::FrameWritten(size_t) {
+  frames_written_.Increment();
+}
+
+void FrameBatcherLoggingMetricTracker::WriteError(Status status) {
+  write_error_.Increment();
+  PW_LOG_ERROR("FrameBatcher: write error=%d", status.code());
+}
+
+}  // namespace pw::rpc
@@ -0,0 +1,223 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc_transport/frame_batcher.h"
+
+#include <array>
+#include <vector>
+
+#include "pw_bytes/array.h"
+#include "pw_rpc_transport/frame_batcher_logging_metric_tracker.h"
+#include "pw_rpc_transport/stream_rpc_frame_sender.h"
+#include "pw_status/status.h"
+#include "pw_stream/stream.h"
+#include "pw_sync/mutex.h"
+#include "pw_sync/thread_notification.h"
+#include "pw_thread/thread.h"
+#include "pw_thread_stl/options.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::rpc {
+namespace {
+
+// Records each call to the writer. Can block the next write until released,
+// to hold a write in progress while other frames are sent.
+class RecordingWriter : public stream::NonSeekableWriter {
+ public:
+  void BlockNextWrite() { block_next_write_ = true; }
+  void WaitUntilBlocked() { blocked_.acquire(); }
+  void Unblock() { unblock_.release(); }
+
+  void set_status(Status status) { status_ = status; }
+
+  const std::vector<std::vector<std::byte>>& writes() const { return writes_; }
+
+ private:
+  Status DoWrite(ConstByteSpan data) override {
+    return Record(span<const ConstByteSpan>(&data, 1));
+  }
+
+  Status DoWriteV(span<const ConstByteSpan> data) override {
+    return Record(data);
+  }
+
+  Status Record(span<const ConstByteSpan> data) {
+    if (block_next_write_) {
+      block_next_write_ = false;
+      blocked_.release();
+      unblock_.acquire();
+    }
+    std::vector<std::byte>& write = writes_.emplace_back();
+    for (ConstByteSpan buffer : data) {
+      write.insert(write.end(), buffer.begin(), buffer.end());
+    }
+    return status_;
+  }
+
+  bool block_next_write_ = false;
+  sync::ThreadNotification blocked_;
+  sync::ThreadNotification unblock_;
+  Status status_;
+  std::vector<std::vector<std::byte>> writes_;
+};
+
+constexpr auto kHeader1 = bytes::Array<0x01, 0x02>();
+constexpr auto kPayload1 = bytes::Array<0x03, 0x04, 0x05>();
+constexpr auto kHeader2 = bytes::Array<0x06>();
+constexpr auto kPayload2 = bytes::Array<0x07, 0x08>();
+constexpr auto kHeader3 = bytes::Array<0x09, 0x0a>();
+constexpr auto kLargePayload = bytes::Initialized<40>(0xaa);
+
+constexpr RpcFrame kFrame1{.header = kHeader1, .payload = kPayload1};
+constexpr RpcFrame kFrame2{.header = kHeader2, .payload = kPayload2};
+constexpr RpcFrame kFrame3{.header = kHeader3, .payload = {}};
+constexpr RpcFrame kLargeFrame{.header = kHeader1, .payload = kLargePayload};
+
+std::vector<std::byte> Concat(std::initializer_list<RpcFrame> frames) {
+  std::vector<std::byte> bytes;
+  for (const RpcFrame& frame : frames) {
+    bytes.insert(bytes.end(), frame.header.begin(), frame.header.end());
+    bytes.insert(bytes.end(), frame.payload.begin(), frame.payload.end());
+  }
+  return bytes;
+}
+
+// Sends a frame from another thread.
+class SenderThread {
+ public:
+  SenderThread(FrameBatcher& batcher, RpcFrame frame)
+      : batcher_(batcher),
+        frame_(frame),
+        thread_(thread::stl::Options(),
+                [this] { status_ = batcher_.Send(frame_); }) {}
+
+  Status Join() {
+    thread_.join();
+    return status_;
+  }
+
+ private:
+  FrameBatcher& batcher_;
+  RpcFrame frame_;
+  Status status_;
+  thread::Thread thread_;
+};
+
+class FrameBatcherTest : public ::testing::Test {
+ protected:
+  FrameBatcherTest() : batcher_(writer_, write_mutex_, buffer_, &tracker_) {}
+
+  RecordingWriter writer_;
+  sync::Mutex write_mutex_;
+  std::array<std::byte, 32> buffer_{};
+  FrameBatcherLoggingMetricTracker tracker_;
+  FrameBatcher batcher_;
+};
+
+TEST_F(FrameBatcherTest, WritesFramesImmediatelyWhenIdle) {
+  EXPECT_EQ(batcher_.Send(kFrame1), OkStatus());
+  EXPECT_EQ(batcher_.Send(kFrame2), OkStatus());
+
+  ASSERT_EQ(writer_.writes().size(), 2u);
+  EXPECT_EQ(writer_.writes()[0], Concat({kFrame1}));
+  EXPECT_EQ(writer_.writes()[1], Concat({kFrame2}));
+  EXPECT_EQ(tracker_.frames_written(), 2u);
+  EXPECT_EQ(tracker_.batches_written(), 0u);
+}
+
+TEST_F(FrameBatcherTest, BatchesFramesSentDuringWrite) {
+  writer_.BlockNextWrite();
+  SenderThread sender(batcher_, kFrame1);
+  writer_.WaitUntilBlocked();
+
+  // These frames are queued while the first frame is being written.
+  EXPECT_EQ(batcher_.Send(kFrame2), OkStatus());
+  EXPECT_EQ(batcher_.Send(kFrame3), OkStatus());
+  EXPECT_EQ(writer_.writes().size(), 0u);
+
+  writer_.Unblock();
+  EXPECT_EQ(sender.Join(), OkStatus());
+
+  ASSERT_EQ(writer_.writes().size(), 2u);
+  EXPECT_EQ(writer_.writes()[0], Concat({kFrame1}));
+  EXPECT_EQ(writer_.writes()[1], Concat({kFrame2, kFrame3}));
+
+  EXPECT_EQ(tracker_.frames_queued(), 2u);
+  EXPECT_EQ(tracker_.batches_written(), 1u);
+  EXPECT_EQ(tracker_.batched_frames(), 2u);
+  EXPECT_EQ(tracker_.batched_bytes(), Concat({kFrame2, kFrame3}).size());
+  EXPECT_EQ(tracker_.frames_written(), 1u);
+}
+
+TEST_F(FrameBatcherTest, WritesLargeFrameAfterPendingBatch) {
+  writer_.BlockNextWrite();
+  SenderThread sender(batcher_, kFrame1);
+  writer_.WaitUntilBlocked();
+
+  EXPECT_EQ(batcher_.Send(kFrame2), OkStatus());
+  // The large frame does not fit in the batch, so it waits for the write in
+  // progress and is written after the queued frame.
+  SenderThread large_sender(batcher_, kLargeFrame);
+
+  writer_.Unblock();
+  EXPECT_EQ(sender.Join(), OkStatus());
+  EXPECT_EQ(large_sender.Join(), OkStatus());
+
+  ASSERT_EQ(writer_.writes().size(), 3u);
+  EXPECT_EQ(writer_.writes()[0], Concat({kFrame1}));
+  EXPECT_EQ(writer_.writes()[1], Concat({kFrame2}));
+  EXPECT_EQ(writer_.writes()[2], Concat({kLargeFrame}));
+}
+
+TEST_F(FrameBatcherTest, ReportsWriteErrors) {
+  writer_.set_status(Status::Unavailable());
+  EXPECT_EQ(batcher_.Send(kFrame1), Status::Unavailable());
+  EXPECT_EQ(tracker_.write_errors(), 1u);
+}
+
+TEST(FrameBatcher, WritesEveryFrameWithoutBuffer) {
+  RecordingWriter writer;
+  sync::Mutex write_mutex;
+  FrameBatcher batcher(writer, write_mutex, ByteSpan());
+  EXPECT_EQ(batcher.max_batch_size(), 0u);
+
+  EXPECT_EQ(batcher.Send(kFrame1), OkStatus());
+  EXPECT_EQ(batcher.Send(kFrame2), OkStatus());
+  EXPECT_EQ(batcher.Flush(), OkStatus());
+  EXPECT_EQ(writer.writes().size(), 2u);
+}
+
+// Without batching, the sender holds only the writer, as it did before
+// batching was added.
+static_assert(sizeof(StreamRpcFrameSender<128>) ==
+              sizeof(RpcFrameSender) + sizeof(stream::Writer*));
+
+TEST(StreamRpcFrameSender, SendsFramesWithBatcher) {
+  RecordingWriter writer;
+  FrameBatcherLoggingMetricTracker tracker;
+  StreamRpcFrameSender<128, 64> sender(writer, tracker);
+
+  EXPECT_EQ(sender.Send(kFrame1), OkStatus());
+  EXPECT_EQ(sender.Send(kFrame2), OkStatus());
+  EXPECT_EQ(sender.Flush(), OkStatus());
+
+  // With a single thread, each frame is written as it is sent.
+  ASSERT_EQ(writer.writes().size(), 2u);
+  EXPECT_EQ(writer.writes()[0], Concat({kFrame1}));
+  EXPECT_EQ(writer.writes()[1], Concat({kFrame2}));
+  EXPECT_EQ(tracker.frames_written(), 2u);
+}
+
+}  // namespace
+}  // namespace pw::rpc
@@ -0,0 +1,148 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "pw_bytes/span.h"
+#include "pw_rpc_transport/rpc_transport.h"
+#include "pw_status/status.h"
+#include "pw_stream/stream.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
+
+namespace pw::rpc {
+
+// Receives notifications about the batches written by a FrameBatcher. The
+// methods are called with the batcher's locks held.
+class FrameBatcherTracker {
+ public:
+  virtual ~FrameBatcherTracker() = default;
+  // A frame was added to the batch while another thread was writing.
+  virtual void FrameQueued([[maybe_unused]] size_t frame_size) {}
+  // A batch holding one or more frames was written with a single write.
+  virtual void BatchWritten([[maybe_unused]] size_t frame_count,
+                            [[maybe_unused]] size_t batch_size) {}
+  // A frame was written on its own, without being copied into a batch.
+  virtual void FrameWritten([[maybe_unused]] size_t frame_size) {}
+  virtual void WriteError([[maybe_unused]] Status status) {}
+};
+
+// Coalesces RpcFrames sent concurrently by several threads into fewer writes
+// to a stream::Writer.
+//
+// A frame sent while no write is in progress is written immediately, so an
+// idle sender sees no added latency. Frames sent while another thread is
+// writing are copied into a pending batch and return immediately. When the
+// write in progress finishes, the writing thread writes the whole pending batch
+// with a single call before returning. A queued frame is therefore delayed by
+// at most the write in progress.
+//
+// The buffer is split into two halves, one being written and one collecting
+// the next batch, so its size is twice the maximum batch size. Frames larger
+// than the free space in the batch are written directly, after the pending
+// batch. With an empty buffer, every frame is written directly.
+//
+// Since queued frames return before they are written, an error writing a batch
+// is only returned to the thread that wrote it, and reported to the tracker.
+class FrameBatcher {
+ public:
+  // write_mutex is held during every write to writer, and may be shared with
+  // the owner of the writer to serialize other accesses to it.
+  FrameBatcher(stream::Writer& writer,
+               sync::Mutex& write_mutex,
+               ByteSpan buffer,
+               FrameBatcherTracker* tracker = nullptr);
+
+  FrameBatcher(const FrameBatcher&) = delete;
+  FrameBatcher& operator=(const FrameBatcher&) = delete;
+
+  // The largest number of bytes written in one batch.
+  size_t max_batch_size() const { return max_batch_size_; }
+
+  // Must be set before any frames are sent.
+  void set_tracker(FrameBatcherTracker& tracker) { tracker_ = &tracker; }
+
+  // Writes the frame, or adds it to the pending batch if another thread is
+  // writing.
+  Status Send(RpcFrame frame) PW_LOCKS_EXCLUDED(write_mutex_, batch_mutex_);
+
+  // Writes any pending frames. Returns once they are written, including frames
+  // which another thread was about to write.
+  Status Flush() PW_LOCKS_EXCLUDED(write_mutex_, batch_mutex_);
+
+ private:
+  // Appends the frame to the pending batch if it fits.
+  bool TryAppend(const RpcFrame& frame)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(batch_mutex_);
+
+  // Writes pending batches until none are left. If release_writer is set,
+  // also clears writer_active_ once the pending batch is empty, so that the
+  // next frame is written immediately.
+  Status WritePending(bool release_writer)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(write_mutex_)
+          PW_LOCKS_EXCLUDED(batch_mutex_);
+
+  stream::Writer& writer_;
+  sync::Mutex& write_mutex_;
+  FrameBatcherTracker* tracker_;
+  const size_t max_batch_size_;
+
+  // The half of the buffer being written. Only accessed with write_mutex_
+  // held.
+  ByteSpan writing_ PW_GUARDED_BY(write_mutex_);
+
+  sync::Mutex batch_mutex_;
+  ByteSpan pending_ PW_GUARDED_BY(batch_mutex_);
+  size_t pending_size_ PW_GUARDED_BY(batch_mutex_) = 0;
+  size_t pending_frames_ PW_GUARDED_BY(batch_mutex_) = 0;
+  // Set while a thread has committed to writing the pending batch.
+  bool writer_active_ PW_GUARDED_BY(batch_mutex_) = false;
+};
+
+namespace internal {
+
+// A FrameBatcher and its buffer, for a SocketRpcTransport with a nonzero
+// kBatchBufferSize. The write mutex is shared with the transport.
+template <size_t kBatchBufferSize>
+class FrameBatcherStorage {
+ public:
+  FrameBatcherStorage(stream::Writer& writer, sync::Mutex& write_mutex)
+      : batcher_(writer, write_mutex, buffer_) {}
+
+  FrameBatcher& batcher() { return batcher_; }
+
+ private:
+  std::array<std::byte, kBatchBufferSize> buffer_{};
+  FrameBatcher batcher_;
+};
+
+// A FrameBatcher with its buffer and write mutex, for a StreamRpcFrameSender
+// with a nonzero kBatchBufferSize.
+template <size_t kBatchBufferSize>
+class StreamFrameBatcherStorage {
+ public:
+  explicit StreamFrameBatcherStorage(stream::Writer& writer)
+      : storage_(writer, write_mutex_) {}
+
+  FrameBatcher& batcher() { return storage_.batcher(); }
+
+ private:
+  sync::Mutex write_mutex_;
+  FrameBatcherStorage<kBatchBufferSize> storage_;
+};
+
+}  // namespace internal
+}  // namespace pw::rpc
@@ -0,0 +1,52 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+
+#include "pw_metric/metric.h"
+#include "pw_rpc_transport/frame_batcher.h"
+
+namespace pw::rpc {
+
+class FrameBatcherLoggingMetricTracker final : public FrameBatcherTracker {
+ public:
+  void FrameQueued(size_t frame_size) override;
+  void BatchWritten(size_t frame_count, size_t batch_size) override;
+  void FrameWritten(size_t frame_size) override;
+  void WriteError(Status status) override;
+
+  pw::metric::Group& metrics() { return metrics_; }
+  const pw::metric::Group& metrics() const { return metrics_; }
+
+  uint32_t frames_queued() const { return frames_queued_.value(); }
+  uint32_t batches_written() const { return batches_written_.value(); }
+  uint32_t batched_frames() const { return batched_frames_.value(); }
+  uint32_t batched_bytes() const { return batched_bytes_.value(); }
+  uint32_t largest_batch() const { return largest_batch_.value(); }
+  uint32_t frames_written() const { return frames_written_.value(); }
+  uint32_t write_errors() const { return write_error_.value(); }
+
+ private:
+  PW_METRIC_GROUP(metrics_, "frame_batcher");
+  PW_METRIC(metrics_, frames_queued_, "frames_queued", 0);
+  PW_METRIC(metrics_, batches_written_, "batches_written", 0);
+  PW_METRIC(metrics_, batched_frames_, "batched_frames", 0);
+  PW_METRIC(metrics_, batched_bytes_, "batched_bytes", 0);
+  PW_METRIC(metrics_, largest_batch_, "largest_batch", 0);
+  PW_METRIC(metrics_, frames_written_, "frames_written", 0);
+  PW_METRIC(metrics_, write_error_, "write_error", 0);
+};
+
+}  // namespace pw::rpc
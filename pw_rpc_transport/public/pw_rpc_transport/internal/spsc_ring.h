@@ -0,0 +1,108 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_status/status.h"
+
+namespace pw::rpc::internal {
+
+// A lock-free single-producer, single-consumer byte ring which may be placed
+// in memory shared between processes.
+//
+// The ring's control block and data live in caller-provided memory, which
+// both endpoints map. The producer and consumer each construct an SpscRing
+// over the same memory. Only one thread may act as the producer and one as
+// the consumer at a time.
+//
+// Neither endpoint makes a system call while the other is active. An endpoint
+// which waits for data or space sleeps on a futex, and is only woken by the
+// other endpoint if it announced that it is sleeping.
+class SpscRing {
+ public:
+  static constexpr size_t kCacheLineSize = 64;
+
+  // Shared state of a ring. Must be initialized with Initialize() before any
+  // SpscRing uses it.
+  struct Control {
+    // Written by the producer.
+    alignas(kCacheLineSize) std::atomic<uint32_t> head;
+    std::atomic<uint32_t> consumer_waiting;
+    std::atomic<uint32_t> data_doorbell;
+
+    // Written by the consumer.
+    alignas(kCacheLineSize) std::atomic<uint32_t> tail;
+    std::atomic<uint32_t> producer_waiting;
+    std::atomic<uint32_t> space_doorbell;
+
+    // Written by either endpoint.
+    alignas(kCacheLineSize) std::atomic<uint32_t> closed;
+  };
+
+  static_assert(std::atomic<uint32_t>::is_always_lock_free,
+                "Rings shared between processes require lock-free atomics");
+
+  // Resets the control block to describe an empty, open ring.
+  static void Initialize(Control& control);
+
+  // Constructs an endpoint for the ring described by control, which stores its
+  // data in data. The size of data must be a power of two, no larger than
+  // 2^31 bytes.
+  SpscRing(Control& control, ByteSpan data);
+
+  size_t capacity() const { return data_.size(); }
+
+  // Producer: Copies as much of data into the ring as fits, and returns the
+  // number of bytes written. Wakes the consumer if it is waiting for data.
+  // Writes nothing if the ring has been closed.
+  size_t Write(ConstByteSpan data);
+
+  // Producer: Blocks until the ring has free space.
+  //
+  // Returns FAILED_PRECONDITION if the ring has been closed.
+  Status WaitForSpace();
+
+  // Consumer: Returns the longest contiguous span of unread data, which may be
+  // empty. The data remains in the ring until it is consumed.
+  ConstByteSpan Peek() const;
+
+  // Consumer: Releases the first size bytes of unread data. Wakes the producer
+  // if it is waiting for space.
+  void Consume(size_t size);
+
+  // Consumer: Blocks until the ring holds unread data.
+  //
+  // Returns FAILED_PRECONDITION if the ring has been closed and is empty.
+  Status WaitForData();
+
+  // Closes the ring and wakes both endpoints. Data already in the ring can
+  // still be read.
+  void Close();
+
+  bool closed() const {
+    return control_.closed.load(std::memory_order_acquire) != 0;
+  }
+
+ private:
+  size_t Readable() const;
+
+  Control& control_;
+  ByteSpan data_;
+};
+
+}  // namespace pw::rpc::internal
@@ -0,0 +1,159 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_result/result.h"
+#include "pw_rpc_transport/internal/spsc_ring.h"
+#include "pw_rpc_transport/rpc_transport.h"
+#include "pw_status/status.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
+#include "pw_thread/thread_core.h"
+
+namespace pw::rpc {
+
+// A block of memory shared by two processes on the same host, holding one ring
+// for each direction of a SharedMemoryRpcTransport.
+//
+// One process creates the region, either as a named POSIX shared memory object
+// or as an anonymous memfd whose file descriptor is passed to the other
+// process. The other process then opens or maps the same region.
+class SharedMemoryRegion {
+ public:
+  // Creates and maps a new named shared memory object holding two rings of
+  // ring_size bytes each. ring_size must be a power of two.
+  //
+  // Returns ALREADY_EXISTS if an object with that name exists.
+  static Result<SharedMemoryRegion> Create(const char* name, size_t ring_size);
+
+  // Maps an existing named shared memory object created by Create().
+  //
+  // Returns NOT_FOUND if the object does not exist, and UNAVAILABLE if its
+  // creator has not finished initializing it yet.
+  static Result<SharedMemoryRegion> Open(const char* name);
+
+  // Creates and maps a new anonymous region. The peer maps the region with
+  // FromFd() after receiving fd(), e.g. by inheriting it or over a Unix domain
+  // socket.
+  static Result<SharedMemoryRegion> CreateAnonymous(size_t ring_size);
+
+  // Maps a region created by Create() or CreateAnonymous() from a file
+  // descriptor. The descriptor is duplicated, so the caller keeps ownership of
+  // fd.
+  static Result<SharedMemoryRegion> FromFd(int fd);
+
+  // Removes a named shared memory object. Processes which have mapped it keep
+  // their mappings.
+  static Status Unlink(const char* name);
+
+  SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+  SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+
+  SharedMemoryRegion(SharedMemoryRegion&& other) { MoveFrom(other); }
+  SharedMemoryRegion& operator=(SharedMemoryRegion&& other) {
+    Release();
+    MoveFrom(other);
+    return *this;
+  }
+
+  ~SharedMemoryRegion() { Release(); }
+
+  // The file descriptor backing the region.
+  int fd() const { return fd_; }
+
+  // The capacity of each of the region's rings, in bytes.
+  size_t ring_size() const;
+
+ private:
+  friend class SharedMemoryRpcTransport;
+
+  static constexpr int kInvalidFd = -1;
+
+  SharedMemoryRegion(int fd, void* mapping, size_t mapping_size)
+      : fd_(fd), mapping_(mapping), mapping_size_(mapping_size) {}
+
+  static Result<SharedMemoryRegion> Initialize(int fd, size_t ring_size);
+  static Result<SharedMemoryRegion> Map(int fd);
+
+  // Returns an endpoint for one of the region's two rings.
+  internal::SpscRing ring(size_t index);
+
+  void MoveFrom(SharedMemoryRegion& other);
+  void Release();
+
+  int fd_ = kInvalidFd;
+  void* mapping_ = nullptr;
+  size_t mapping_size_ = 0;
+};
+
+// An RPC transport between two processes on the same host, which exchanges
+// data through a pair of single-producer, single-consumer rings in a
+// SharedMemoryRegion.
+//
+// Sending a frame copies it into the outgoing ring, and only makes a system
+// call when the receiving thread is asleep. The receiving thread passes data
+// to the ingress handler directly from the shared memory.
+//
+// Like SocketRpcTransport, the transport sends a stream of bytes, so it should
+// be combined with a framing protocol such as simple framing or HDLC.
+class SharedMemoryRpcTransport : public RpcFrameSender,
+                                 public thread::ThreadCore {
+ public:
+  // Selects which ring of the region each side sends on. The two processes
+  // sharing a region must use different sides.
+  enum class Side {
+    kCreator,
+    kPeer,
+  };
+
+  SharedMemoryRpcTransport(SharedMemoryRegion& region, Side side);
+
+  SharedMemoryRpcTransport(SharedMemoryRegion& region,
+                           Side side,
+                           RpcIngressHandler& ingress)
+      : SharedMemoryRpcTransport(region, side) {
+    ingress_ = &ingress;
+  }
+
+  size_t MaximumTransmissionUnit() const override { return tx_.capacity(); }
+  void set_ingress(RpcIngressHandler& ingress) { ingress_ = &ingress; }
+
+  // Copies the frame into the outgoing ring, blocking while the ring is full.
+  //
+  // Returns FAILED_PRECONDITION if the transport has been stopped by either
+  // side.
+  Status Send(RpcFrame frame) override;
+
+  // Receives data until the transport is stopped by either side.
+  void Start();
+
+  // Closes both rings, stopping this transport and its peer.
+  void Stop();
+
+ private:
+  void Run() override { Start(); }
+
+  Status Write(ConstByteSpan data) PW_EXCLUSIVE_LOCKS_REQUIRED(write_mutex_);
+
+  sync::Mutex write_mutex_;
+  internal::SpscRing tx_;  // Only written to while holding write_mutex_.
+  internal::SpscRing rx_;
+  RpcIngressHandler* ingress_ = nullptr;
+};
+
+}  // namespace pw::rpc
@@ -15,11 +15,13 @@
 
 #include <signal.h>
 
+#include <array>
 #include <atomic>
 #include <mutex>
 
 #include "pw_assert/assert.h"
 #include "pw_chrono/system_clock.h"
+#include "pw_preprocessor/compiler.h"
 #include "pw_rpc_transport/rpc_transport.h"
 #include "pw_status/status.h"
 #include "pw_status/try.h"
@@ -33,8 +35,22 @@
 
 namespace pw::rpc {
 
+class FrameBatcherTracker;
+
 namespace internal {
 
+// The FrameBatcher and buffer of a SocketRpcTransport with a nonzero
+// kBatchBufferSize. Defined in pw_rpc_transport/frame_batcher.h, so transports
+// without batching hold nothing and do not depend on FrameBatcher.
+template <size_t kBatchBufferSize>
+class FrameBatcherStorage;
+
+template <>
+class FrameBatcherStorage<0> {
+ public:
+  constexpr FrameBatcherStorage(stream::Writer&, sync::Mutex&) {}
+};
+
 void LogSocketListenError(Status);
 void LogSocketAcceptError(Status);
 void LogSocketConnectError(Status);
@@ -43,7 +59,11 @@ void LogSocketIngressHandlerError(Status);
 
 }  // namespace internal
 
-template <size_t kReadBufferSize>
+// If kBatchBufferSize is nonzero, frames sent by several threads at once are
+// coalesced into batches of up to kBatchBufferSize / 2 bytes, each written with
+// a single socket write. See FrameBatcher. Transports that batch must also
+// include pw_rpc_transport/frame_batcher.h.
+template <size_t kReadBufferSize, size_t kBatchBufferSize = 0>
 class SocketRpcTransport : public RpcFrameSender, public thread::ThreadCore {
  public:
   struct AsServer {};
@@ -74,13 +94,28 @@ class SocketRpcTransport : public RpcFrameSender, public thread::ThreadCore {
   uint16_t port() const { return port_; }
   void set_ingress(RpcIngressHandler& ingress) { ingress_ = &ingress; }
 
+  // Must be called before any frames are sent. Only available if
+  // kBatchBufferSize is nonzero.
+  void set_batch_tracker(FrameBatcherTracker& tracker) {
+    batcher_.batcher().set_tracker(tracker);
+  }
+
   Status Send(RpcFrame frame) override {
-    std::lock_guard lock(write_mutex_);
-    PW_TRY(socket_stream_.Write(frame.header));
-    PW_TRY(socket_stream_.Write(frame.payload));
-    return OkStatus();
+    if constexpr (kBatchBufferSize > 0) {
+      return batcher_.batcher().Send(frame);
+    } else {
+      // Send the header and payload with a single system call.
+      const std::array<ConstByteSpan, 2> frame_data = {frame.header,
+                                                       frame.payload};
+      std::lock_guard lock(write_mutex_);
+      return socket_stream_.WriteV(frame_data);
+    }
   }
 
+  // Writes any frames waiting in a batch. Only available if kBatchBufferSize
+  // is nonzero.
+  Status Flush() { return batcher_.batcher().Flush(); }
+
   // Returns once the transport is connected to its peer.
   void WaitUntilConnected() {
     std::unique_lock lock(connected_mutex_);
@@ -227,6 +262,8 @@ class SocketRpcTransport : public RpcFrameSender, public thread::ThreadCore {
   sync::Mutex write_mutex_;
   stream::SocketStream socket_stream_;
   stream::ServerSocket server_socket_;
+  PW_NO_UNIQUE_ADDRESS internal::FrameBatcherStorage<kBatchBufferSize>
+      batcher_{socket_stream_, write_mutex_};
 
   sync::Mutex ready_mutex_;
   sync::ConditionVariable ready_cv_;
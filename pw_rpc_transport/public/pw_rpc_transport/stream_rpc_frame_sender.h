@@ -13,30 +13,75 @@
 // the License.
 #pragma once
 
+#include <array>
+#include <cstddef>
+
+#include "pw_bytes/span.h"
+#include "pw_preprocessor/compiler.h"
 #include "pw_rpc_transport/rpc_transport.h"
 #include "pw_status/status.h"
-#include "pw_status/try.h"
 #include "pw_stream/stream.h"
 
 namespace pw::rpc {
 
+class FrameBatcherTracker;
+
+namespace internal {
+
+// The FrameBatcher, buffer and write mutex of a StreamRpcFrameSender with a
+// nonzero kBatchBufferSize. Defined in pw_rpc_transport/frame_batcher.h, so
+// senders without batching hold nothing and do not depend on FrameBatcher.
+template <size_t kBatchBufferSize>
+class StreamFrameBatcherStorage;
+
+template <>
+class StreamFrameBatcherStorage<0> {
+ public:
+  constexpr explicit StreamFrameBatcherStorage(stream::Writer&) {}
+};
+
+}  // namespace internal
+
 // RpcFrameSender that wraps a stream::Writer.
-template <size_t kMtu>
+//
+// If kBatchBufferSize is nonzero, frames sent by several threads at once are
+// coalesced into batches of up to kBatchBufferSize / 2 bytes, each written with
+// a single call to the writer. See FrameBatcher. Senders that batch must also
+// include pw_rpc_transport/frame_batcher.h.
+template <size_t kMtu, size_t kBatchBufferSize = 0>
 class StreamRpcFrameSender : public RpcFrameSender {
  public:
-  StreamRpcFrameSender(stream::Writer& writer) : writer_(writer) {}
+  StreamRpcFrameSender(stream::Writer& writer)
+      : writer_(writer), batcher_(writer) {}
+
+  // Only available if kBatchBufferSize is nonzero.
+  StreamRpcFrameSender(stream::Writer& writer, FrameBatcherTracker& tracker)
+      : StreamRpcFrameSender(writer) {
+    batcher_.batcher().set_tracker(tracker);
+  }
 
   size_t MaximumTransmissionUnit() const override { return kMtu; }
 
   Status Send(RpcFrame frame) override {
-    if (!frame.header.empty()) {
-      PW_TRY(writer_.Write(frame.header));
+    if constexpr (kBatchBufferSize > 0) {
+      return batcher_.batcher().Send(frame);
+    } else {
+      // Hand the header and payload to the writer together, so that writers
+      // which support vectored writes can send the frame all at once.
+      const std::array<ConstByteSpan, 2> frame_data = {frame.header,
+                                                       frame.payload};
+      return writer_.WriteV(frame_data);
     }
-    return writer_.Write(frame.payload);
   }
 
+  // Writes any frames waiting in a batch. Only available if kBatchBufferSize
+  // is nonzero.
+  Status Flush() { return batcher_.batcher().Flush(); }
+
  private:
   stream::Writer& writer_;
+  PW_NO_UNIQUE_ADDRESS internal::StreamFrameBatcherStorage<kBatchBufferSize>
+      batcher_;
 };
 
 }  // namespace pw::rpc
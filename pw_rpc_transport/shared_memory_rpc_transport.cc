@@ -0,0 +1,268 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#define PW_LOG_MODULE_NAME "PW_RPC"
+
+#include "pw_rpc_transport/shared_memory_rpc_transport.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <mutex>
+#include <new>
+
+#include "pw_assert/assert.h"
+#include "pw_log/log.h"
+#include "pw_status/try.h"
+
+namespace pw::rpc {
+namespace {
+
+constexpr uint32_t kMagic = 0x70775352;  // "pwSR"
+constexpr size_t kMaxRingSize = size_t{1} << 30;
+
+// Start of a shared memory region. The data for both rings follows.
+struct Header {
+  std::atomic<uint32_t> magic;
+  uint32_t ring_size;
+  internal::SpscRing::Control rings[2];
+};
+
+static_assert(sizeof(Header) % internal::SpscRing::kCacheLineSize == 0);
+
+Status StatusFromErrno() {
+  switch (errno) {
+    case EEXIST:
+      return Status::AlreadyExists();
+    case ENOENT:
+      return Status::NotFound();
+    case EACCES:
+    case EPERM:
+      return Status::PermissionDenied();
+    case EINVAL:
+      return Status::InvalidArgument();
+    case EMFILE:
+    case ENFILE:
+    case ENOMEM:
+    case ENOSPC:
+      return Status::ResourceExhausted();
+    default:
+      return Status::Internal();
+  }
+}
+
+bool IsValidRingSize(size_t ring_size) {
+  return ring_size != 0 && ring_size <= kMaxRingSize &&
+         (ring_size & (ring_size - 1)) == 0;
+}
+
+size_t MappingSize(size_t ring_size) { return sizeof(Header) + 2 * ring_size; }
+
+Header& HeaderOf(void* mapping) { return *static_cast<Header*>(mapping); }
+
+}  // namespace
+
+Result<SharedMemoryRegion> SharedMemoryRegion::Create(const char* name,
+                                                      size_t ring_size) {
+  if (!IsValidRingSize(ring_size)) {
+    return Status::InvalidArgument();
+  }
+  const int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+  if (fd < 0) {
+    return StatusFromErrno();
+  }
+  Result<SharedMemoryRegion> region = Initialize(fd, ring_size);
+  if (!region.ok()) {
+    shm_unlink(name);
+  }
+  return region;
+}
+
+Result<SharedMemoryRegion> SharedMemoryRegion::Open(const char* name) {
+  const int fd = shm_open(name, O_RDWR | O_CLOEXEC, 0);
+  if (fd < 0) {
+    return StatusFromErrno();
+  }
+  return Map(fd);
+}
+
+Result<SharedMemoryRegion> SharedMemoryRegion::CreateAnonymous(
+    size_t ring_size) {
+  if (!IsValidRingSize(ring_size)) {
+    return Status::InvalidArgument();
+  }
+  const int fd = memfd_create("pw_rpc_transport", MFD_CLOEXEC);
+  if (fd < 0) {
+    return StatusFromErrno();
+  }
+  return Initialize(fd, ring_size);
+}
+
+Result<SharedMemoryRegion> SharedMemoryRegion::FromFd(int fd) {
+  const int own_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  if (own_fd < 0) {
+    return StatusFromErrno();
+  }
+  return Map(own_fd);
+}
+
+Status SharedMemoryRegion::Unlink(const char* name) {
+  if (shm_unlink(name) != 0) {
+    return StatusFromErrno();
+  }
+  return OkStatus();
+}
+
+Result<SharedMemoryRegion> SharedMemoryRegion::Initialize(int fd,
+                                                          size_t ring_size) {
+  const size_t mapping_size = MappingSize(ring_size);
+  if (ftruncate(fd, static_cast<off_t>(mapping_size)) != 0) {
+    const Status status = StatusFromErrno();
+    close(fd);
+    return status;
+  }
+  void* mapping =
+      mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (mapping == MAP_FAILED) {
+    const Status status = StatusFromErrno();
+    close(fd);
+    return status;
+  }
+
+  // The memory is zero-filled, so the magic number stays unset until the
+  // header is complete.
+  Header& header = *new (mapping) Header;
+  header.ring_size = static_cast<uint32_t>(ring_size);
+  internal::SpscRing::Initialize(header.rings[0]);
+  internal::SpscRing::Initialize(header.rings[1]);
+  header.magic.store(kMagic, std::memory_order_release);
+
+  return SharedMemoryRegion(fd, mapping, mapping_size);
+}
+
+Result<SharedMemoryRegion> SharedMemoryRegion::Map(int fd) {
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    const Status status = StatusFromErrno();
+    close(fd);
+    return status;
+  }
+  const size_t file_size = static_cast<size_t>(info.st_size);
+  if (file_size < sizeof(Header)) {
+    close(fd);
+    return Status::Unavailable();
+  }
+
+  void* mapping =
+      mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (mapping == MAP_FAILED) {
+    const Status status = StatusFromErrno();
+    close(fd);
+    return status;
+  }
+  SharedMemoryRegion region(fd, mapping, file_size);
+
+  const Header& header = HeaderOf(mapping);
+  if (header.magic.load(std::memory_order_acquire) != kMagic) {
+    return Status::Unavailable();
+  }
+  if (!IsValidRingSize(header.ring_size) ||
+      MappingSize(header.ring_size) != file_size) {
+    return Status::DataLoss();
+  }
+  return region;
+}
+
+size_t SharedMemoryRegion::ring_size() const {
+  return HeaderOf(mapping_).ring_size;
+}
+
+internal::SpscRing SharedMemoryRegion::ring(size_t index) {
+  std::byte* data = static_cast<std::byte*>(mapping_) + sizeof(Header);
+  return internal::SpscRing(HeaderOf(mapping_).rings[index],
+                            ByteSpan(data + index * ring_size(), ring_size()));
+}
+
+void SharedMemoryRegion::MoveFrom(SharedMemoryRegion& other) {
+  fd_ = other.fd_;
+  mapping_ = other.mapping_;
+  mapping_size_ = other.mapping_size_;
+  other.fd_ = kInvalidFd;
+  other.mapping_ = nullptr;
+  other.mapping_size_ = 0;
+}
+
+void SharedMemoryRegion::Release() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+    mapping_ = nullptr;
+  }
+  if (fd_ != kInvalidFd) {
+    close(fd_);
+    fd_ = kInvalidFd;
+  }
+}
+
+SharedMemoryRpcTransport::SharedMemoryRpcTransport(SharedMemoryRegion& region,
+                                                   Side side)
+    : tx_(region.ring(side == Side::kCreator ? 0 : 1)),
+      rx_(region.ring(side == Side::kCreator ? 1 : 0)) {}
+
+Status SharedMemoryRpcTransport::Send(RpcFrame frame) {
+  std::lock_guard lock(write_mutex_);
+  PW_TRY(Write(frame.header));
+  return Write(frame.payload);
+}
+
+Status SharedMemoryRpcTransport::Write(ConstByteSpan data) {
+  while (!data.empty()) {
+    const size_t written = tx_.Write(data);
+    if (written == 0) {
+      PW_TRY(tx_.WaitForSpace());
+    }
+    data = data.subspan(written);
+  }
+  return OkStatus();
+}
+
+void SharedMemoryRpcTransport::Start() {
+  PW_DASSERT(ingress_ != nullptr);
+  while (true) {
+    const ConstByteSpan data = rx_.Peek();
+    if (data.empty()) {
+      if (!rx_.WaitForData().ok()) {
+        return;  // The transport was stopped and all data has been received.
+      }
+      continue;
+    }
+
+    const Status ingress_status = ingress_->ProcessIncomingData(data);
+    if (!ingress_status.ok()) {
+      PW_LOG_ERROR(
+          "SharedMemoryRpcTransport: ingress handler error. Status %d",
+          ingress_status.code());
+    }
+    rx_.Consume(data.size());
+  }
+}
+
+void SharedMemoryRpcTransport::Stop() {
+  tx_.Close();
+  rx_.Close();
+}
+
+}  // namespace pw::rpc
@@ -0,0 +1,269 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc_transport/shared_memory_rpc_transport.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "pw_bytes/span.h"
+#include "pw_rpc_transport/internal/spsc_ring.h"
+#include "pw_status/status.h"
+#include "pw_sync/thread_notification.h"
+#include "pw_thread/thread.h"
+#include "pw_thread_stl/options.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::rpc {
+namespace {
+
+using internal::SpscRing;
+
+constexpr size_t kRingSize = 256;
+
+class TestIngress : public RpcIngressHandler {
+ public:
+  explicit TestIngress(size_t num_bytes_expected)
+      : num_bytes_expected_(num_bytes_expected) {}
+
+  Status ProcessIncomingData(ConstByteSpan buffer) override {
+    if (num_bytes_expected_ > 0) {
+      received_.insert(received_.end(), buffer.begin(), buffer.end());
+      num_bytes_expected_ -= std::min(num_bytes_expected_, buffer.size());
+      if (num_bytes_expected_ == 0) {
+        done_.release();
+      }
+    }
+    return OkStatus();
+  }
+
+  const std::vector<std::byte>& received() const { return received_; }
+  void Wait() { done_.acquire(); }
+
+ private:
+  size_t num_bytes_expected_;
+  sync::ThreadNotification done_;
+  std::vector<std::byte> received_;
+};
+
+// Sends frames of varying sizes, which together hold num_bytes of a repeating
+// pattern.
+class FrameSender : public thread::ThreadCore {
+ public:
+  FrameSender(RpcFrameSender& transport, size_t num_bytes, uint8_t seed)
+      : transport_(transport) {
+    for (size_t i = 0; i < num_bytes; ++i) {
+      data_.push_back(static_cast<std::byte>(i * 7 + seed));
+    }
+  }
+
+  const std::vector<std::byte>& data() const { return data_; }
+
+ private:
+  void Run() override {
+    ConstByteSpan remaining(data_);
+    for (size_t size = 1; !remaining.empty(); size = size % 300 + 1) {
+      const size_t header_size = std::min<size_t>(remaining.size(), 4);
+      const size_t payload_size =
+          std::min(remaining.size() - header_size, size);
+      const RpcFrame frame{
+          .header = remaining.first(header_size),
+          .payload = remaining.subspan(header_size, payload_size)};
+      ASSERT_EQ(transport_.Send(frame), OkStatus());
+      remaining = remaining.subspan(header_size + payload_size);
+    }
+  }
+
+  RpcFrameSender& transport_;
+  std::vector<std::byte> data_;
+};
+
+TEST(SpscRing, WriteAndReadAcrossWraparound) {
+  SpscRing::Control control;
+  SpscRing::Initialize(control);
+  std::array<std::byte, 8> buffer{};
+  SpscRing ring(control, buffer);
+
+  const std::array<std::byte, 6> first = {std::byte{1},
+                                          std::byte{2},
+                                          std::byte{3},
+                                          std::byte{4},
+                                          std::byte{5},
+                                          std::byte{6}};
+  EXPECT_EQ(ring.Write(first), 6u);
+  EXPECT_EQ(ring.Peek().size(), 6u);
+  ring.Consume(5);
+
+  const std::array<std::byte, 5> second = {std::byte{7},
+                                           std::byte{8},
+                                           std::byte{9},
+                                           std::byte{10},
+                                           std::byte{11}};
+  EXPECT_EQ(ring.Write(second), 5u);
+
+  // The unread data wraps around the end of the buffer, so it is read in two
+  // contiguous pieces.
+  ConstByteSpan chunk = ring.Peek();
+  ASSERT_EQ(chunk.size(), 3u);
+  EXPECT_EQ(chunk[0], std::byte{6});
+  EXPECT_EQ(chunk[2], std::byte{8});
+  ring.Consume(chunk.size());
+
+  chunk = ring.Peek();
+  ASSERT_EQ(chunk.size(), 3u);
+  EXPECT_EQ(chunk[0], std::byte{9});
+  EXPECT_EQ(chunk[2], std::byte{11});
+  ring.Consume(chunk.size());
+  EXPECT_TRUE(ring.Peek().empty());
+}
+
+TEST(SpscRing, WriteStopsWhenFull) {
+  SpscRing::Control control;
+  SpscRing::Initialize(control);
+  std::array<std::byte, 4> buffer{};
+  SpscRing ring(control, buffer);
+
+  const std::array<std::byte, 6> data{};
+  EXPECT_EQ(ring.Write(data), 4u);
+  EXPECT_EQ(ring.Write(data), 0u);
+  ring.Consume(1);
+  EXPECT_EQ(ring.WaitForSpace(), OkStatus());
+  EXPECT_EQ(ring.Write(data), 1u);
+}
+
+TEST(SpscRing, CloseWakesWaitingConsumer) {
+  SpscRing::Control control;
+  SpscRing::Initialize(control);
+  std::array<std::byte, 4> buffer{};
+  SpscRing ring(control, buffer);
+
+  struct {
+    SpscRing& ring;
+    Status status;
+  } waiter{ring, OkStatus()};
+  thread::Thread consumer(thread::stl::Options(), [&waiter] {
+    waiter.status = waiter.ring.WaitForData();
+  });
+  ring.Close();
+  consumer.join();
+
+  EXPECT_EQ(waiter.status, Status::FailedPrecondition());
+  EXPECT_EQ(ring.Write(buffer), 0u);
+}
+
+TEST(SharedMemoryRegion, RejectsInvalidRingSize) {
+  EXPECT_EQ(SharedMemoryRegion::CreateAnonymous(0).status(),
+            Status::InvalidArgument());
+  EXPECT_EQ(SharedMemoryRegion::CreateAnonymous(100).status(),
+            Status::InvalidArgument());
+}
+
+TEST(SharedMemoryRegion, MapsFromFd) {
+  auto region = SharedMemoryRegion::CreateAnonymous(kRingSize);
+  ASSERT_EQ(region.status(), OkStatus());
+  auto peer = SharedMemoryRegion::FromFd(region->fd());
+  ASSERT_EQ(peer.status(), OkStatus());
+  EXPECT_EQ(peer->ring_size(), kRingSize);
+  EXPECT_NE(peer->fd(), region->fd());
+}
+
+TEST(SharedMemoryRegion, OpensNamedRegion) {
+  constexpr const char* kName = "/pw_rpc_transport_shared_memory_test";
+  SharedMemoryRegion::Unlink(kName).IgnoreError();
+
+  auto region = SharedMemoryRegion::Create(kName, kRingSize);
+  ASSERT_EQ(region.status(), OkStatus());
+  EXPECT_EQ(SharedMemoryRegion::Create(kName, kRingSize).status(),
+            Status::AlreadyExists());
+
+  auto peer = SharedMemoryRegion::Open(kName);
+  ASSERT_EQ(peer.status(), OkStatus());
+  EXPECT_EQ(peer->ring_size(), kRingSize);
+
+  EXPECT_EQ(SharedMemoryRegion::Unlink(kName), OkStatus());
+  EXPECT_EQ(SharedMemoryRegion::Open(kName).status(), Status::NotFound());
+}
+
+TEST(SharedMemoryRpcTransport, SendsFramesInBothDirections) {
+  constexpr size_t kBytesPerDirection = 64 * 1024;
+
+  // The two regions are separate mappings of the same memory, as they would be
+  // in two processes.
+  auto region = SharedMemoryRegion::CreateAnonymous(kRingSize);
+  ASSERT_EQ(region.status(), OkStatus());
+  auto peer_region = SharedMemoryRegion::FromFd(region->fd());
+  ASSERT_EQ(peer_region.status(), OkStatus());
+
+  TestIngress creator_ingress(kBytesPerDirection);
+  TestIngress peer_ingress(kBytesPerDirection);
+  SharedMemoryRpcTransport creator(
+      *region, SharedMemoryRpcTransport::Side::kCreator, creator_ingress);
+  SharedMemoryRpcTransport peer(
+      *peer_region, SharedMemoryRpcTransport::Side::kPeer, peer_ingress);
+  EXPECT_EQ(creator.MaximumTransmissionUnit(), kRingSize);
+
+  thread::Thread creator_thread(thread::stl::Options(), creator);
+  thread::Thread peer_thread(thread::stl::Options(), peer);
+
+  FrameSender creator_sender(creator, kBytesPerDirection, 1);
+  FrameSender peer_sender(peer, kBytesPerDirection, 2);
+  thread::Thread creator_sender_thread(thread::stl::Options(), creator_sender);
+  thread::Thread peer_sender_thread(thread::stl::Options(), peer_sender);
+
+  creator_ingress.Wait();
+  peer_ingress.Wait();
+  creator_sender_thread.join();
+  peer_sender_thread.join();
+
+  creator.Stop();
+  creator_thread.join();
+  peer_thread.join();
+
+  EXPECT_EQ(peer_ingress.received(), creator_sender.data());
+  EXPECT_EQ(creator_ingress.received(), peer_sender.data());
+}
+
+TEST(SharedMemoryRpcTransport, StopUnblocksPeerSender) {
+  auto region = SharedMemoryRegion::CreateAnonymous(kRingSize);
+  ASSERT_EQ(region.status(), OkStatus());
+  auto peer_region = SharedMemoryRegion::FromFd(region->fd());
+  ASSERT_EQ(peer_region.status(), OkStatus());
+
+  SharedMemoryRpcTransport creator(*region,
+                                   SharedMemoryRpcTransport::Side::kCreator);
+  SharedMemoryRpcTransport peer(*peer_region,
+                                SharedMemoryRpcTransport::Side::kPeer);
+
+  // Nothing receives on the creator side, so the peer blocks once its ring is
+  // full.
+  struct {
+    SharedMemoryRpcTransport& transport;
+    std::array<std::byte, kRingSize * 2> payload;
+    Status status;
+  } sender{peer, {}, OkStatus()};
+  thread::Thread sender_thread(thread::stl::Options(), [&sender] {
+    sender.status = sender.transport.Send(
+        RpcFrame{.header = {}, .payload = sender.payload});
+  });
+
+  creator.Stop();
+  sender_thread.join();
+  EXPECT_EQ(sender.status, Status::FailedPrecondition());
+  EXPECT_EQ(peer.Send(RpcFrame{.header = {}, .payload = sender.payload}),
+            Status::FailedPrecondition());
+}
+
+}  // namespace
+}  // namespace pw::rpc
@@ -0,0 +1,170 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc_transport/internal/spsc_ring.h"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "pw_assert/check.h"
+
+namespace pw::rpc::internal {
+namespace {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+
+// The futexes are not private, since the rings are shared between processes.
+void FutexWait(std::atomic<uint32_t>& word, uint32_t expected) {
+  syscall(SYS_futex,
+          reinterpret_cast<uint32_t*>(&word),
+          FUTEX_WAIT,
+          expected,
+          nullptr,
+          nullptr,
+          0);
+}
+
+void FutexWakeAll(std::atomic<uint32_t>& word) {
+  syscall(SYS_futex,
+          reinterpret_cast<uint32_t*>(&word),
+          FUTEX_WAKE,
+          INT32_MAX,
+          nullptr,
+          nullptr,
+          0);
+}
+
+// Rings the doorbell, waking the thread sleeping on it.
+void Ring(std::atomic<uint32_t>& doorbell) {
+  doorbell.fetch_add(1);
+  FutexWakeAll(doorbell);
+}
+
+// Sleeps on a doorbell until it is rung, unless ready() becomes true first.
+//
+// The waiter reads the doorbell before announcing itself as waiting and
+// checking ready(). The other endpoint makes the ring ready before checking
+// whether anyone is waiting. With sequentially consistent operations on both
+// sides, either the waiter sees that the ring is ready, or the other endpoint
+// sees the waiter and rings the doorbell, which changes its value and prevents
+// or ends the sleep.
+template <typename Ready>
+void SleepUntil(std::atomic<uint32_t>& doorbell,
+                std::atomic<uint32_t>& waiting,
+                Ready&& ready) {
+  const uint32_t ring_count = doorbell.load();
+  waiting.store(1);
+  if (!ready()) {
+    FutexWait(doorbell, ring_count);
+  }
+  waiting.store(0);
+}
+
+}  // namespace
+
+void SpscRing::Initialize(Control& control) {
+  control.head.store(0, std::memory_order_relaxed);
+  control.consumer_waiting.store(0, std::memory_order_relaxed);
+  control.data_doorbell.store(0, std::memory_order_relaxed);
+  control.tail.store(0, std::memory_order_relaxed);
+  control.producer_waiting.store(0, std::memory_order_relaxed);
+  control.space_doorbell.store(0, std::memory_order_relaxed);
+  control.closed.store(0);
+}
+
+SpscRing::SpscRing(Control& control, ByteSpan data)
+    : control_(control), data_(data) {
+  PW_CHECK(!data.empty() && (data.size() & (data.size() - 1)) == 0,
+           "SpscRing capacity must be a power of two");
+  PW_CHECK_UINT_LE(data.size(), uint32_t{1} << 31);
+}
+
+size_t SpscRing::Readable() const {
+  return control_.head.load() - control_.tail.load(std::memory_order_relaxed);
+}
+
+size_t SpscRing::Write(ConstByteSpan data) {
+  if (closed()) {
+    return 0;
+  }
+
+  const uint32_t head = control_.head.load(std::memory_order_relaxed);
+  const uint32_t tail = control_.tail.load(std::memory_order_acquire);
+  const size_t size = std::min(data.size(), capacity() - (head - tail));
+  if (size == 0) {
+    return 0;
+  }
+
+  // Copy the data in up to two pieces, wrapping around the end of the ring.
+  const size_t offset = head & (capacity() - 1);
+  const size_t first = std::min(size, capacity() - offset);
+  std::memcpy(&data_[offset], data.data(), first);
+  std::memcpy(data_.data(), data.data() + first, size - first);
+
+  control_.head.store(head + static_cast<uint32_t>(size));
+  if (control_.consumer_waiting.load() != 0) {
+    Ring(control_.data_doorbell);
+  }
+  return size;
+}
+
+Status SpscRing::WaitForSpace() {
+  auto has_space = [this] {
+    return closed() ||
+           control_.head.load(std::memory_order_relaxed) -
+                   control_.tail.load() <
+               capacity();
+  };
+  while (!has_space()) {
+    SleepUntil(control_.space_doorbell, control_.producer_waiting, has_space);
+  }
+  return closed() ? Status::FailedPrecondition() : OkStatus();
+}
+
+ConstByteSpan SpscRing::Peek() const {
+  const uint32_t tail = control_.tail.load(std::memory_order_relaxed);
+  const size_t readable = control_.head.load(std::memory_order_acquire) - tail;
+  const size_t offset = tail & (capacity() - 1);
+  return ConstByteSpan(data_).subspan(offset,
+                                      std::min(readable, capacity() - offset));
+}
+
+void SpscRing::Consume(size_t size) {
+  PW_DCHECK_UINT_LE(size, Readable());
+  control_.tail.store(control_.tail.load(std::memory_order_relaxed) +
+                      static_cast<uint32_t>(size));
+  if (control_.producer_waiting.load() != 0) {
+    Ring(control_.space_doorbell);
+  }
+}
+
+Status SpscRing::WaitForData() {
+  auto has_data = [this] { return Readable() != 0 || closed(); };
+  while (!has_data()) {
+    SleepUntil(control_.data_doorbell, control_.consumer_waiting, has_data);
+  }
+  return Readable() != 0 ? OkStatus() : Status::FailedPrecondition();
+}
+
+void SpscRing::Close() {
+  control_.closed.store(1);
+  Ring(control_.data_doorbell);
+  Ring(control_.space_doorbell);
+}
+
+}  // namespace pw::rpc::internal
@@ -182,6 +182,36 @@ class Stream {
   /// @overload
   Status Write(const std::byte b) { return Write(&b, 1); }
 
+  /// Writes a sequence of buffers to this stream as if they had been
+  /// concatenated and passed to a single Write() call (gather write). Streams
+  /// which support it, such as `SocketStream`, write all of the buffers with a
+  /// single system call.
+  ///
+  /// Derived classes should NOT try to override WriteV(). Instead, provide an
+  /// implementation by overriding DoWriteV(). The default implementation
+  /// writes each buffer with DoWrite() and stops at the first error, so data
+  /// from earlier buffers may have been written when an error is returned.
+  ///
+  /// @returns
+  /// * @OK: All of the data was successfully accepted by the stream.
+  /// * Other errors are as documented on Write().
+  Status WriteV(span<const ConstByteSpan> data) { return DoWriteV(data); }
+
+  /// Reads data from this stream into a sequence of buffers (scatter read).
+  /// Buffers are filled in order, and data is only read into a buffer once
+  /// all of the buffers before it are full. As with Read(), fewer bytes than
+  /// requested may be read.
+  ///
+  /// Derived classes should NOT try to override ReadV(). Instead, provide an
+  /// implementation by overriding DoReadV(). The default implementation calls
+  /// DoRead() once, for the first non-empty buffer.
+  ///
+  /// @returns
+  /// * @OK: Between 1 and the combined size of the buffers was read. The size
+  ///   is the number of bytes read.
+  /// * Other errors are as documented on Read().
+  StatusWithSize ReadV(span<const ByteSpan> dest) { return DoReadV(dest); }
+
   /// Changes the current position in the stream for both reading and writing,
   /// if supported.
   ///
@@ -281,6 +311,31 @@ class Stream {
   /// Virtual Write() function implemented by derived classes.
   virtual Status DoWrite(ConstByteSpan data) = 0;
 
+  /// Virtual WriteV() function optionally implemented by derived classes.
+  /// The default implementation calls DoWrite() for each non-empty buffer.
+  virtual Status DoWriteV(span<const ConstByteSpan> data) {
+    for (ConstByteSpan buffer : data) {
+      if (buffer.empty()) {
+        continue;
+      }
+      if (Status status = DoWrite(buffer); !status.ok()) {
+        return status;
+      }
+    }
+    return OkStatus();
+  }
+
+  /// Virtual ReadV() function optionally implemented by derived classes.
+  /// The default implementation reads into the first non-empty buffer.
+  virtual StatusWithSize DoReadV(span<const ByteSpan> dest) {
+    for (ByteSpan buffer : dest) {
+      if (!buffer.empty()) {
+        return DoRead(buffer);
+      }
+    }
+    return StatusWithSize(0);
+  }
+
   /// Virtual Seek() function implemented by derived classes.
   virtual Status DoSeek(ptrdiff_t offset, Whence origin) = 0;
 
@@ -332,8 +387,12 @@ class Reader : public Stream {
       : Stream(true, false, seekability) {}
 
   using Stream::Write;
+  using Stream::WriteV;
 
   Status DoWrite(ConstByteSpan) final { return Status::Unimplemented(); }
+  Status DoWriteV(span<const ConstByteSpan>) final {
+    return Status::Unimplemented();
+  }
 };
 
 /// A Reader that supports at least relative seeking within some range of the
@@ -421,10 +480,14 @@ class Writer : public Stream {
       : Stream(false, true, seekability) {}
 
   using Stream::Read;
+  using Stream::ReadV;
 
   StatusWithSize DoRead(ByteSpan) final {
     return StatusWithSize::Unimplemented();
   }
+  StatusWithSize DoReadV(span<const ByteSpan>) final {
+    return StatusWithSize::Unimplemented();
+  }
 };
 
 /// A Writer that supports at least relative seeking within some range of the
@@ -27,9 +27,16 @@
 #include <poll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #endif  // defined(_WIN32) && _WIN32
 
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#endif  // defined(__linux__)
+
+#include <algorithm>
+#include <array>
 #include <cerrno>
 #include <cstring>
 
@@ -42,8 +49,21 @@ namespace pw::stream {
 namespace {
 
 constexpr uint32_t kServerBacklogLength = 1;
+constexpr int kInvalidFd = -1;
 constexpr const char* kLocalhostAddress = "localhost";
 
+#if defined(__linux__)
+// Use MSG_NOSIGNAL to avoid getting a SIGPIPE signal when the remote peer drops
+// the connection. This is supported on Linux only.
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif  // defined(__linux__)
+
+// Maximum number of buffers passed to a single vectored send or receive. POSIX
+// guarantees that IOV_MAX is at least 16.
+constexpr size_t kMaxIoVecs = 16;
+
 // Set necessary options on a socket file descriptor.
 void ConfigureSocket([[maybe_unused]] int socket) {
 #if defined(__APPLE__)
@@ -95,6 +115,92 @@ class WinsockInitializer {
 
 #endif  // defined(_WIN32) && _WIN32
 
+// Opens the file descriptors used to wake up threads blocked on a socket when
+// it is torn down. On Linux, this is a single eventfd, which serves as both
+// the read and the write end. Elsewhere, it is a pipe.
+bool OpenTearDownNotification(int& read_fd, int& write_fd) {
+#if defined(__linux__)
+  const int event_fd = eventfd(0, EFD_CLOEXEC);
+  if (event_fd < 0) {
+    return false;
+  }
+  read_fd = event_fd;
+  write_fd = event_fd;
+#else
+  int fd_list[2];
+  if (pipe(fd_list) < 0) {
+    return false;
+  }
+  read_fd = fd_list[0];
+  write_fd = fd_list[1];
+#endif  // defined(__linux__)
+  return true;
+}
+
+void SendTearDownNotification(int write_fd) {
+#if defined(__linux__)
+  const uint64_t value = 1;
+  write(write_fd, &value, sizeof(value));
+#else
+  write(write_fd, "T", 1);
+#endif  // defined(__linux__)
+}
+
+// Closes the file descriptors opened by OpenTearDownNotification().
+void CloseTearDownNotification(int& read_fd, int& write_fd) {
+  if (write_fd != kInvalidFd && write_fd != read_fd) {
+    close(write_fd);
+  }
+  write_fd = kInvalidFd;
+  if (read_fd != kInvalidFd) {
+    close(read_fd);
+    read_fd = kInvalidFd;
+  }
+}
+
+// Waits for data to read on the connection, or a tear down notification.
+// Returns true if there is data to read.
+bool WaitUntilReadable(int fd, int pipe_r_fd) {
+  pollfd fds_to_poll[2];
+  fds_to_poll[0].fd = fd;
+  fds_to_poll[0].events = POLLIN | POLLERR | POLLHUP;
+  fds_to_poll[1].fd = pipe_r_fd;
+  fds_to_poll[1].events = POLLIN;
+  poll(fds_to_poll, 2, -1);
+  return (fds_to_poll[0].revents & POLLIN) != 0;
+}
+
+Status SendResult(ssize_t bytes_sent, size_t size_bytes) {
+  if (bytes_sent < 0 || static_cast<size_t>(bytes_sent) != size_bytes) {
+    if (errno == EPIPE) {
+      // An EPIPE indicates that the connection is closed.  Return an OutOfRange
+      // error.
+      return Status::OutOfRange();
+    }
+
+    return Status::Unknown();
+  }
+  return OkStatus();
+}
+
+// Converts the result of a receive call to a StatusWithSize. Returns
+// OUT_OF_RANGE if the remote peer has closed the connection.
+StatusWithSize ReceiveResult(ssize_t bytes_rcvd) {
+  if (bytes_rcvd == 0) {
+    return StatusWithSize::OutOfRange();
+  } else if (bytes_rcvd < 0) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      // Socket timed out when trying to read.
+      // This should only occur if SO_RCVTIMEO was configured to be nonzero, or
+      // if the socket was opened with the O_NONBLOCK flag to prevent any
+      // blocking when performing reads or writes.
+      return StatusWithSize::ResourceExhausted();
+    }
+    return StatusWithSize::Unknown();
+  }
+  return StatusWithSize(bytes_rcvd);
+}
+
 }  // namespace
 
 Status SocketStream::SocketStream::Connect(const char* host, uint16_t port) {
@@ -179,7 +285,7 @@ void SocketStream::Close() {
         shutdown(connection_fd_, SHUT_RDWR);
       }
       if (connection_pipe_w_fd_ != kInvalidFd) {
-        write(connection_pipe_w_fd_, "T", 1);
+        SendTearDownNotification(connection_pipe_w_fd_);
       }
 
       // Release ownership of the connection by this object and mark as no
@@ -191,13 +297,6 @@ void SocketStream::Close() {
 }
 
 Status SocketStream::DoWrite(span<const std::byte> data) {
-  int send_flags = 0;
-#if defined(__linux__)
-  // Use MSG_NOSIGNAL to avoid getting a SIGPIPE signal when the remote
-  // peer drops the connection. This is supported on Linux only.
-  send_flags |= MSG_NOSIGNAL;
-#endif  // defined(__linux__)
-
   ssize_t bytes_sent;
   {
     ConnectionOwnership ownership(this);
@@ -207,57 +306,163 @@ Status SocketStream::DoWrite(span<const std::byte> data) {
     bytes_sent = send(ownership.fd(),
                       reinterpret_cast<const char*>(data.data()),
                       data.size_bytes(),
-                      send_flags);
+                      kSendFlags);
   }
 
-  if (bytes_sent < 0 || static_cast<size_t>(bytes_sent) != data.size()) {
-    if (errno == EPIPE) {
-      // An EPIPE indicates that the connection is closed.  Return an OutOfRange
-      // error.
-      return Status::OutOfRange();
-    }
+  return SendResult(bytes_sent, data.size_bytes());
+}
 
+Status SocketStream::DoWriteV(span<const ConstByteSpan> data) {
+#if defined(_WIN32) && _WIN32
+  for (ConstByteSpan buffer : data) {
+    if (Status status = DoWrite(buffer); !status.ok()) {
+      return status;
+    }
+  }
+  return OkStatus();
+#else
+  ConnectionOwnership ownership(this);
+  if (ownership.fd() == kInvalidFd) {
     return Status::Unknown();
   }
+
+  while (!data.empty()) {
+    const size_t iov_count = std::min(data.size(), kMaxIoVecs);
+    iovec iov[kMaxIoVecs];
+    size_t size_bytes = 0;
+    for (size_t i = 0; i < iov_count; ++i) {
+      iov[i].iov_base = const_cast<std::byte*>(data[i].data());
+      iov[i].iov_len = data[i].size_bytes();
+      size_bytes += data[i].size_bytes();
+    }
+
+    msghdr message = {};
+    message.msg_iov = iov;
+    message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(iov_count);
+    const ssize_t bytes_sent = sendmsg(ownership.fd(), &message, kSendFlags);
+    if (Status status = SendResult(bytes_sent, size_bytes); !status.ok()) {
+      return status;
+    }
+    data = data.subspan(iov_count);
+  }
   return OkStatus();
+#endif  // defined(_WIN32) && _WIN32
 }
 
 StatusWithSize SocketStream::DoRead(ByteSpan dest) {
+  return DoReadV(span(&dest, 1));
+}
+
+StatusWithSize SocketStream::DoReadV(span<const ByteSpan> dest) {
+  size_t dest_size = 0;
+  for (ByteSpan buffer : dest) {
+    dest_size += buffer.size_bytes();
+  }
+  if (dest_size == 0) {
+    return StatusWithSize(0);
+  }
+
+  if (receive_begin_ != receive_end_) {
+    return StatusWithSize(ReadFromReceiveBuffer(dest));
+  }
+  if (receive_buffer_.empty()) {
+    return Receive(dest);
+  }
+
+  // Receive directly into the destination buffers, and keep any additional
+  // data that is already available in the receive buffer for later reads.
+  std::array<ByteSpan, kMaxIoVecs> buffers;
+  const size_t count = std::min(dest.size(), kMaxIoVecs - 1);
+  dest_size = 0;
+  for (size_t i = 0; i < count; ++i) {
+    buffers[i] = dest[i];
+    dest_size += dest[i].size_bytes();
+  }
+  buffers[count] = receive_buffer_;
+
+  StatusWithSize result = Receive(span(buffers).first(count + 1));
+  if (!result.ok() || result.size() <= dest_size) {
+    return result;
+  }
+  receive_begin_ = 0;
+  receive_end_ = result.size() - dest_size;
+  return StatusWithSize(dest_size);
+}
+
+void SocketStream::SetReceiveBuffer(ByteSpan buffer) {
+  PW_CHECK_UINT_EQ(receive_begin_,
+                   receive_end_,
+                   "The receive buffer cannot be replaced while it holds "
+                   "unread data");
+  receive_buffer_ = buffer;
+  receive_begin_ = 0;
+  receive_end_ = 0;
+}
+
+size_t SocketStream::ReadFromReceiveBuffer(span<const ByteSpan> dest) {
+  size_t bytes_read = 0;
+  for (ByteSpan buffer : dest) {
+    const size_t size =
+        std::min(buffer.size_bytes(), receive_end_ - receive_begin_);
+    std::memcpy(buffer.data(), &receive_buffer_[receive_begin_], size);
+    receive_begin_ += size;
+    bytes_read += size;
+    if (receive_begin_ == receive_end_) {
+      break;
+    }
+  }
+  return bytes_read;
+}
+
+StatusWithSize SocketStream::Receive(span<const ByteSpan> buffers) {
   ConnectionOwnership ownership(this);
   if (ownership.fd() == kInvalidFd) {
     return StatusWithSize::Unknown();
   }
 
-  // Wait for data to read or a tear down notification.
-  pollfd fds_to_poll[2];
-  fds_to_poll[0].fd = ownership.fd();
-  fds_to_poll[0].events = POLLIN | POLLERR | POLLHUP;
-  fds_to_poll[1].fd = ownership.pipe_r_fd();
-  fds_to_poll[1].events = POLLIN;
-  poll(fds_to_poll, 2, -1);
-  if (!(fds_to_poll[0].revents & POLLIN)) {
+#if defined(_WIN32) && _WIN32
+  ByteSpan dest;
+  for (ByteSpan buffer : buffers) {
+    if (!buffer.empty()) {
+      dest = buffer;
+      break;
+    }
+  }
+  if (!WaitUntilReadable(ownership.fd(), ownership.pipe_r_fd())) {
     return StatusWithSize::Unknown();
   }
-
   ssize_t bytes_rcvd = recv(ownership.fd(),
                             reinterpret_cast<char*>(dest.data()),
                             dest.size_bytes(),
                             0);
-  if (bytes_rcvd == 0) {
+#else
+  const size_t iov_count = std::min(buffers.size(), kMaxIoVecs);
+  iovec iov[kMaxIoVecs];
+  for (size_t i = 0; i < iov_count; ++i) {
+    iov[i].iov_base = buffers[i].data();
+    iov[i].iov_len = buffers[i].size_bytes();
+  }
+  msghdr message = {};
+  message.msg_iov = iov;
+  message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(iov_count);
+
+  // Try to receive without blocking first. If data is already available, this
+  // avoids polling the socket and the tear down notification.
+  ssize_t bytes_rcvd = recvmsg(ownership.fd(), &message, MSG_DONTWAIT);
+  if (bytes_rcvd < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+    if (!WaitUntilReadable(ownership.fd(), ownership.pipe_r_fd())) {
+      return StatusWithSize::Unknown();
+    }
+    bytes_rcvd = recvmsg(ownership.fd(), &message, 0);
+  }
+#endif  // defined(_WIN32) && _WIN32
+
+  StatusWithSize result = ReceiveResult(bytes_rcvd);
+  if (result.IsOutOfRange()) {
     // Remote peer has closed the connection.
     Close();
-    return StatusWithSize::OutOfRange();
-  } else if (bytes_rcvd < 0) {
-    if (errno == EAGAIN || errno == EWOULDBLOCK) {
-      // Socket timed out when trying to read.
-      // This should only occur if SO_RCVTIMEO was configured to be nonzero, or
-      // if the socket was opened with the O_NONBLOCK flag to prevent any
-      // blocking when performing reads or writes.
-      return StatusWithSize::ResourceExhausted();
-    }
-    return StatusWithSize::Unknown();
   }
-  return StatusWithSize(bytes_rcvd);
+  return result;
 }
 
 int SocketStream::TakeConnection() {
@@ -270,11 +475,7 @@ int SocketStream::TakeConnectionWithLockHeld() {
 
   if (ready_ && (connection_fd_ != kInvalidFd) &&
       (connection_pipe_r_fd_ == kInvalidFd)) {
-    int fd_list[2];
-    if (pipe(fd_list) >= 0) {
-      connection_pipe_r_fd_ = fd_list[0];
-      connection_pipe_w_fd_ = fd_list[1];
-    }
+    OpenTearDownNotification(connection_pipe_r_fd_, connection_pipe_w_fd_);
   }
 
   if (!ready_ || (connection_pipe_r_fd_ == kInvalidFd) ||
@@ -298,14 +499,7 @@ void SocketStream::ReleaseConnectionWithLockHeld() {
       close(connection_fd_);
       connection_fd_ = kInvalidFd;
     }
-    if (connection_pipe_r_fd_ != kInvalidFd) {
-      close(connection_pipe_r_fd_);
-      connection_pipe_r_fd_ = kInvalidFd;
-    }
-    if (connection_pipe_w_fd_ != kInvalidFd) {
-      close(connection_pipe_w_fd_);
-      connection_pipe_w_fd_ = kInvalidFd;
-    }
+    CloseTearDownNotification(connection_pipe_r_fd_, connection_pipe_w_fd_);
   }
 }
 
@@ -410,7 +604,7 @@ void ServerSocket::Close() {
         shutdown(socket_fd_, SHUT_RDWR);
       }
       if (socket_pipe_w_fd_ != kInvalidFd) {
-        write(socket_pipe_w_fd_, "T", 1);
+        SendTearDownNotification(socket_pipe_w_fd_);
       }
 
       // Release ownership of the socket by this object and mark as no longer
@@ -431,11 +625,7 @@ int ServerSocket::TakeSocketWithLockHeld() {
 
   if (ready_ && (socket_fd_ != kInvalidFd) &&
       (socket_pipe_r_fd_ == kInvalidFd)) {
-    int fd_list[2];
-    if (pipe(fd_list) >= 0) {
-      socket_pipe_r_fd_ = fd_list[0];
-      socket_pipe_w_fd_ = fd_list[1];
-    }
+    OpenTearDownNotification(socket_pipe_r_fd_, socket_pipe_w_fd_);
   }
 
   if (!ready_ || (socket_pipe_r_fd_ == kInvalidFd) ||
@@ -459,14 +649,7 @@ void ServerSocket::ReleaseSocketWithLockHeld() {
       close(socket_fd_);
       socket_fd_ = kInvalidFd;
     }
-    if (socket_pipe_r_fd_ != kInvalidFd) {
-      close(socket_pipe_r_fd_);
-      socket_pipe_r_fd_ = kInvalidFd;
-    }
-    if (socket_pipe_w_fd_ != kInvalidFd) {
-      close(socket_pipe_w_fd_);
-      socket_pipe_w_fd_ = kInvalidFd;
-    }
+    CloseTearDownNotification(socket_pipe_r_fd_, socket_pipe_w_fd_);
   }
 }
 
@@ -0,0 +1,83 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <thread>
+
+#include "pw_assert/check.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_result/result.h"
+#include "pw_stream/socket_stream.h"
+
+namespace pw::stream {
+namespace {
+
+// Size of an RPC packet, framed for the wire.
+constexpr size_t kFrameSize = 64;
+
+// Number of frames which are sent before they are read back.
+constexpr size_t kFramesPerBatch = 16;
+
+// Models RPC traffic over a loopback socket: the client sends a batch of
+// frames, which the server reads back in small pieces, as a frame decoder
+// would.
+void SmallReads(perf_test::State& state,
+                size_t read_size,
+                size_t receive_buffer_size) {
+  ServerSocket server;
+  PW_CHECK_OK(server.Listen());
+
+  Result<SocketStream> server_stream = Status::Unavailable();
+  std::thread accept_thread([&]() { server_stream = server.Accept(); });
+  SocketStream client;
+  PW_CHECK_OK(client.Connect("localhost", server.port()));
+  accept_thread.join();
+  PW_CHECK_OK(server_stream.status());
+
+  std::array<std::byte, 1024> receive_buffer;
+  PW_CHECK_UINT_LE(receive_buffer_size, receive_buffer.size());
+  server_stream->SetReceiveBuffer(
+      span(receive_buffer).first(receive_buffer_size));
+
+  std::array<std::byte, kFrameSize * kFramesPerBatch> frames{};
+  std::array<std::byte, kFrameSize> read_buffer;
+
+  while (state.KeepRunning()) {
+    PW_CHECK_OK(client.Write(frames));
+
+    for (size_t remaining = frames.size(); remaining > 0;) {
+      const size_t size = std::min(read_size, remaining);
+      Result<ByteSpan> result =
+          server_stream->Read(span(read_buffer).first(size));
+      PW_CHECK_OK(result.status());
+      remaining -= result->size();
+    }
+  }
+
+  client.Close();
+  server_stream->Close();
+  server.Close();
+}
+
+PW_PERF_TEST(SocketStream_Unbuffered_1ByteReads, SmallReads, 1, 0);
+PW_PERF_TEST(SocketStream_Buffered_1ByteReads, SmallReads, 1, 1024);
+PW_PERF_TEST(SocketStream_Unbuffered_16ByteReads, SmallReads, 16, 0);
+PW_PERF_TEST(SocketStream_Buffered_16ByteReads, SmallReads, 16, 1024);
+PW_PERF_TEST(SocketStream_Unbuffered_FrameReads, SmallReads, kFrameSize, 0);
+PW_PERF_TEST(SocketStream_Buffered_FrameReads, SmallReads, kFrameSize, 1024);
+
+}  // namespace
+}  // namespace pw::stream
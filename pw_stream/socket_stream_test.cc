@@ -14,6 +14,9 @@
 
 #include "pw_stream/socket_stream.h"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <thread>
 
 #include "pw_result/result.h"
@@ -196,5 +199,138 @@ TEST(SocketStreamTest, ReuseAutomaticServerPort) {
   EXPECT_EQ(server2.Listen(server_port), OkStatus());
 }
 
+TEST(SocketStreamTest, WriteVReadV) {
+  ServerSocket server;
+  EXPECT_EQ(server.Listen(), OkStatus());
+
+  Result<SocketStream> server_stream = Status::Unavailable();
+  auto accept_thread = std::thread{[&]() { server_stream = server.Accept(); }};
+
+  SocketStream client;
+  EXPECT_EQ(client.Connect("localhost", server.port()), OkStatus());
+
+  accept_thread.join();
+  ASSERT_EQ(server_stream.status(), OkStatus());
+
+  // Write more buffers than are sent with a single system call.
+  std::array<std::byte, 60> payload;
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<std::byte>(i);
+  }
+  std::array<ConstByteSpan, 20> write_buffers;
+  for (size_t i = 0; i < write_buffers.size(); ++i) {
+    write_buffers[i] = span(payload).subspan(i * 3, 3);
+  }
+  EXPECT_EQ(client.WriteV(write_buffers), OkStatus());
+
+  std::array<std::byte, 7> header{};
+  std::array<std::byte, 100> body{};
+  std::array<std::byte, payload.size()> received{};
+  size_t received_size = 0;
+  while (received_size < payload.size()) {
+    const std::array<ByteSpan, 2> read_buffers = {ByteSpan(header),
+                                                  ByteSpan(body)};
+    StatusWithSize result = server_stream->ReadV(read_buffers);
+    ASSERT_EQ(result.status(), OkStatus());
+    ASSERT_LE(received_size + result.size(), received.size());
+
+    const size_t from_header = std::min(result.size(), header.size());
+    std::copy_n(header.begin(), from_header, &received[received_size]);
+    std::copy_n(body.begin(),
+                result.size() - from_header,
+                &received[received_size + from_header]);
+    received_size += result.size();
+  }
+  EXPECT_TRUE(received == payload);
+
+  // Close the client and attempt to read from the server.
+  client.Close();
+  const std::array<ByteSpan, 1> read_buffers = {ByteSpan(body)};
+  EXPECT_EQ(server_stream->ReadV(read_buffers).status(), Status::OutOfRange());
+
+  server_stream->Close();
+  server.Close();
+}
+
+TEST(SocketStreamTest, BufferedSmallReads) {
+  ServerSocket server;
+  EXPECT_EQ(server.Listen(), OkStatus());
+
+  Result<SocketStream> server_stream = Status::Unavailable();
+  auto accept_thread = std::thread{[&]() { server_stream = server.Accept(); }};
+
+  SocketStream client;
+  EXPECT_EQ(client.Connect("localhost", server.port()), OkStatus());
+
+  accept_thread.join();
+  ASSERT_EQ(server_stream.status(), OkStatus());
+
+  std::array<std::byte, 16> receive_buffer;
+  server_stream->SetReceiveBuffer(receive_buffer);
+
+  // Send more data than fits in the receive buffer.
+  std::array<std::byte, 40> payload;
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<std::byte>(i);
+  }
+  EXPECT_EQ(client.Write(payload), OkStatus());
+
+  std::array<std::byte, payload.size()> received{};
+  size_t received_size = 0;
+  while (received_size < payload.size()) {
+    const size_t read_size =
+        std::min<size_t>(3, payload.size() - received_size);
+    Result<ByteSpan> result =
+        server_stream->Read(span(received).subspan(received_size, read_size));
+    ASSERT_EQ(result.status(), OkStatus());
+    received_size += result->size();
+  }
+  EXPECT_TRUE(received == payload);
+
+  // Buffered data is drained before the closed connection is reported.
+  EXPECT_EQ(client.Write(span(payload).first(5)), OkStatus());
+  client.Close();
+  std::array<std::byte, 2> small;
+  size_t tail_size = 0;
+  Result<ByteSpan> result = server_stream->Read(small);
+  while (result.ok()) {
+    tail_size += result->size();
+    result = server_stream->Read(small);
+  }
+  EXPECT_EQ(tail_size, 5u);
+  EXPECT_EQ(result.status(), Status::OutOfRange());
+
+  server_stream->Close();
+  server.Close();
+}
+
+TEST(SocketStreamTest, CloseUnblocksRead) {
+  ServerSocket server;
+  EXPECT_EQ(server.Listen(), OkStatus());
+
+  Result<SocketStream> server_stream = Status::Unavailable();
+  auto accept_thread = std::thread{[&]() { server_stream = server.Accept(); }};
+
+  SocketStream client;
+  EXPECT_EQ(client.Connect("localhost", server.port()), OkStatus());
+
+  accept_thread.join();
+  ASSERT_EQ(server_stream.status(), OkStatus());
+
+  std::array<std::byte, 8> read_buffer;
+  Result<ByteSpan> read_result = ByteSpan();
+  auto read_thread =
+      std::thread{[&]() { read_result = client.Read(read_buffer); }};
+
+  // Closing the stream wakes up the blocked reader.
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  client.Close();
+  read_thread.join();
+  EXPECT_FALSE(read_result.ok());
+
+  server_stream->Close();
+  server.Close();
+}
+
 }  // namespace
 }  // namespace pw::stream
@@ -101,6 +101,26 @@ Status StdFileWriter::DoWrite(ConstByteSpan data) {
   return Status::Unknown();
 }
 
+Status StdFileWriter::DoWriteV(span<const ConstByteSpan> data) {
+  if (stream_.eof()) {
+    return Status::OutOfRange();
+  }
+
+  // std::ofstream does not expose its file descriptor, so writev() cannot be
+  // used. Instead, the buffers are all copied into the stream's buffer, which
+  // reaches the file in as few writes as the stream can manage.
+  std::filebuf& buffer = *stream_.rdbuf();
+  for (ConstByteSpan chunk : data) {
+    const auto size = static_cast<std::streamsize>(chunk.size());
+    if (buffer.sputn(reinterpret_cast<const char*>(chunk.data()), size) !=
+        size) {
+      stream_.setstate(std::ios::badbit);
+      return Status::Unknown();
+    }
+  }
+  return OkStatus();
+}
+
 Status StdFileWriter::DoSeek(ptrdiff_t offset, Whence origin) {
   if (!stream_.seekp(offset, WhenceToSeekDir(origin))) {
     return Status::Unknown();
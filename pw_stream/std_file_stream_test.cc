@@ -178,5 +178,23 @@ TEST_F(StdFileStreamTest, SeekAtEnd) {
   reader.Close();
 }
 
+TEST_F(StdFileStreamTest, WriteV) {
+  const std::string_view kTestData = kSmallTestData;
+  const ConstByteSpan data = as_bytes(span(kTestData));
+  const std::array<ConstByteSpan, 3> buffers = {
+      data.first(10), ConstByteSpan(), data.subspan(10)};
+
+  StdFileWriter writer(TempFilename());
+  ASSERT_EQ(writer.WriteV(buffers), OkStatus());
+  writer.Close();
+
+  StdFileReader reader(TempFilename());
+  std::array<std::byte, kSmallTestData.size()> read_buffer;
+  Result<ByteSpan> result = reader.ReadExact(read_buffer);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_TRUE(pw::containers::Equal(result.value(), data));
+  reader.Close();
+}
+
 }  // namespace
 }  // namespace pw::stream
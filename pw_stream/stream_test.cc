@@ -270,5 +270,90 @@ TEST(Stream, ReadExact_HandlesError) {
   EXPECT_EQ(result.status(), Status::Internal());
 }
 
+// Records each DoWrite() call and fails once a write limit is reached.
+class TestRecordingWriter : public NonSeekableWriter {
+ public:
+  explicit TestRecordingWriter(size_t max_writes = 8)
+      : max_writes_(max_writes) {}
+
+  ConstByteSpan written() const { return span(buffer_).first(size_); }
+  size_t write_calls() const { return write_calls_; }
+
+ private:
+  Status DoWrite(ConstByteSpan data) override {
+    if (write_calls_ == max_writes_) {
+      return Status::ResourceExhausted();
+    }
+    write_calls_ += 1;
+    PW_CHECK_UINT_LE(size_ + data.size(), buffer_.size());
+    std::copy(data.begin(), data.end(), buffer_.begin() + size_);
+    size_ += data.size();
+    return OkStatus();
+  }
+
+  size_t max_writes_;
+  size_t write_calls_ = 0;
+  std::array<std::byte, 32> buffer_;
+  size_t size_ = 0;
+};
+
+TEST(Stream, WriteV_DefaultWritesEachBuffer) {
+  constexpr auto kFirst = bytes::Array<0x00, 0x01, 0x02>();
+  constexpr auto kSecond = bytes::Array<0x03, 0x04>();
+  constexpr auto kAll = bytes::Array<0x00, 0x01, 0x02, 0x03, 0x04>();
+  const std::array<ConstByteSpan, 3> buffers = {
+      ConstByteSpan(kFirst), ConstByteSpan(), ConstByteSpan(kSecond)};
+
+  TestRecordingWriter writer;
+  EXPECT_EQ(writer.WriteV(buffers), OkStatus());
+
+  EXPECT_EQ(writer.write_calls(), 2u);  // The empty buffer is skipped.
+  EXPECT_TRUE(std::equal(writer.written().begin(),
+                         writer.written().end(),
+                         kAll.begin(),
+                         kAll.end()));
+}
+
+TEST(Stream, WriteV_DefaultStopsAtFirstError) {
+  constexpr auto kData = bytes::Array<0x00, 0x01>();
+  const std::array<ConstByteSpan, 3> buffers = {
+      ConstByteSpan(kData), ConstByteSpan(kData), ConstByteSpan(kData)};
+
+  TestRecordingWriter writer(/*max_writes=*/1);
+  EXPECT_EQ(writer.WriteV(buffers), Status::ResourceExhausted());
+  EXPECT_EQ(writer.write_calls(), 1u);
+  EXPECT_EQ(writer.written().size(), kData.size());
+}
+
+TEST(Stream, ReadV_DefaultReadsIntoFirstNonEmptyBuffer) {
+  constexpr auto kData = bytes::Array<0x00, 0x01, 0x02, 0x03, 0x04>();
+  auto frags = containers::to_array<StatusWithSize>({StatusWithSize(2)});
+  TestFragmentedReader reader(kData, frags);
+
+  std::array<std::byte, 4> second;
+  std::array<std::byte, 4> third;
+  const std::array<ByteSpan, 3> buffers = {
+      ByteSpan(), ByteSpan(second), ByteSpan(third)};
+
+  StatusWithSize result = reader.ReadV(buffers);
+  PW_TEST_ASSERT_OK(result);
+  EXPECT_EQ(result.size(), 2u);
+  EXPECT_EQ(second[0], std::byte{0x00});
+  EXPECT_EQ(second[1], std::byte{0x01});
+}
+
+TEST(Stream, ReadV_WriteV_UnimplementedOnOneWayStreams) {
+  std::array<std::byte, 4> buffer{};
+  const std::array<ByteSpan, 1> read_buffers = {ByteSpan(buffer)};
+  const std::array<ConstByteSpan, 1> write_buffers = {ConstByteSpan(buffer)};
+
+  TestNonSeekableReader reader;
+  TestNonSeekableWriter writer;
+  EXPECT_EQ(static_cast<Stream&>(reader).WriteV(write_buffers),
+            Status::Unimplemented());
+  EXPECT_EQ(static_cast<Stream&>(writer).ReadV(read_buffers).status(),
+            Status::Unimplemented());
+}
+
 }  // namespace
 }  // namespace pw::stream
@@ -0,0 +1,159 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_string/compiled_format.h"
+
+#include <array>
+
+#include "pw_span/span.h"
+
+namespace pw::string::internal {
+namespace {
+
+// Appends a prefix (a sign or 0x), leading zeros and the converted value,
+// padded to the field width.
+void AppendField(StringBuilder& builder,
+                 const FormatSpec& spec,
+                 bool zero_pad,
+                 std::string_view prefix,
+                 size_t zeros,
+                 std::string_view body) {
+  const size_t length = prefix.size() + zeros + body.size();
+  const size_t width = static_cast<size_t>(spec.width);
+  const size_t padding = width > length ? width - length : 0;
+
+  if (spec.left_justify) {
+    builder << prefix;
+    builder.append(zeros, '0');
+    builder << body;
+    builder.append(padding, ' ');
+  } else if (zero_pad) {
+    builder << prefix;
+    builder.append(padding + zeros, '0');
+    builder << body;
+  } else {
+    builder.append(padding, ' ');
+    builder << prefix;
+    builder.append(zeros, '0');
+    builder << body;
+  }
+}
+
+std::string_view OctalToString(uint64_t value, span<char> buffer) {
+  size_t start = buffer.size();
+  do {
+    buffer[--start] = static_cast<char>('0' + (value & 7u));
+    value >>= 3;
+  } while (value != 0u);
+  return std::string_view(buffer.data() + start, buffer.size() - start);
+}
+
+}  // namespace
+
+void AppendInteger(StringBuilder& builder,
+                   const FormatSpec& spec,
+                   bool negative,
+                   uint64_t magnitude) {
+  // Large enough for 2^64 - 1 in octal, plus a null terminator.
+  std::array<char, 24> digits;
+  std::string_view body;
+
+  switch (spec.conversion) {
+    case 'o':
+      body = OctalToString(magnitude, digits);
+      break;
+    case 'x':
+    case 'X': {
+      const size_t size = IntToHexString(magnitude, digits).size();
+      if (spec.conversion == 'X') {
+        for (size_t i = 0; i < size; ++i) {
+          if (digits[i] >= 'a') {
+            digits[i] = static_cast<char>(digits[i] - 'a' + 'A');
+          }
+        }
+      }
+      body = std::string_view(digits.data(), size);
+      break;
+    }
+    default:
+      body = std::string_view(digits.data(),
+                              IntToString(magnitude, digits).size());
+      break;
+  }
+
+  // A zero precision with a zero value produces no digits.
+  if (spec.precision == 0 && magnitude == 0u) {
+    body = std::string_view();
+  }
+
+  const size_t precision =
+      spec.precision < 0 ? 0 : static_cast<size_t>(spec.precision);
+  size_t zeros = precision > body.size() ? precision - body.size() : 0;
+
+  std::string_view prefix;
+  if (spec.conversion == 'd' || spec.conversion == 'i') {
+    if (negative) {
+      prefix = "-";
+    } else if (spec.force_sign) {
+      prefix = "+";
+    } else if (spec.space_sign) {
+      prefix = " ";
+    }
+  } else if (spec.alternate) {
+    if (spec.conversion == 'o') {
+      // The alternate form of %o always starts with 0.
+      if (zeros == 0u && (body.empty() || body.front() != '0')) {
+        zeros = 1;
+      }
+    } else if (spec.conversion != 'u' && magnitude != 0u) {
+      prefix = spec.conversion == 'X' ? "0X" : "0x";
+    }
+  }
+
+  AppendField(builder,
+              spec,
+              spec.leading_zeros && spec.precision < 0,
+              prefix,
+              zeros,
+              body);
+}
+
+void AppendString(StringBuilder& builder,
+                  const FormatSpec& spec,
+                  std::string_view value) {
+  if (spec.precision >= 0) {
+    value = value.substr(0, static_cast<size_t>(spec.precision));
+  }
+  AppendField(builder, spec, false, {}, 0, value);
+}
+
+void AppendPointer(StringBuilder& builder,
+                   const FormatSpec& spec,
+                   const void* value) {
+  if (value == nullptr) {
+    AppendField(builder, spec, false, {}, 0, kNullPointerString);
+    return;
+  }
+  std::array<char, 17> digits;
+  const size_t size =
+      IntToHexString(reinterpret_cast<uintptr_t>(value), digits).size();
+  AppendField(builder,
+              spec,
+              false,
+              "0x",
+              0,
+              std::string_view(digits.data(), size));
+}
+
+}  // namespace pw::string::internal
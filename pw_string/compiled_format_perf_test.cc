@@ -0,0 +1,119 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <cstdint>
+
+#include "pw_perf_test/perf_test.h"
+#include "pw_string/compiled_format.h"
+#include "pw_string/string_builder.h"
+
+namespace pw::string {
+namespace {
+
+constexpr const char* kFile = "pw_string/compiled_format_perf_test.cc";
+
+// "Read %u bytes from %s"
+void ReadBytes_Format(perf_test::State& state, unsigned bytes) {
+  StringBuffer<64> sb;
+  while (state.KeepRunning()) {
+    sb.clear();
+    sb.Format("Read %u bytes from %s", bytes, "uart0");
+  }
+}
+
+void ReadBytes_Compiled(perf_test::State& state, unsigned bytes) {
+  StringBuffer<64> sb;
+  while (state.KeepRunning()) {
+    sb.clear();
+    PW_STRING_COMPILED_FORMAT(sb, "Read %u bytes from %s", bytes, "uart0");
+  }
+}
+
+// "%s:%d %s"
+void FileLine_Format(perf_test::State& state, int line) {
+  StringBuffer<96> sb;
+  while (state.KeepRunning()) {
+    sb.clear();
+    sb.Format("%s:%d %s", kFile, line, "Transfer complete");
+  }
+}
+
+void FileLine_Compiled(perf_test::State& state, int line) {
+  StringBuffer<96> sb;
+  while (state.KeepRunning()) {
+    sb.clear();
+    PW_STRING_COMPILED_FORMAT(
+        sb, "%s:%d %s", kFile, line, "Transfer complete");
+  }
+}
+
+// "addr=0x%08x value=%d"
+void Register_Format(perf_test::State& state, uint32_t addr, int value) {
+  StringBuffer<64> sb;
+  while (state.KeepRunning()) {
+    sb.clear();
+    sb.Format("addr=0x%08x value=%d", static_cast<unsigned>(addr), value);
+  }
+}
+
+void Register_Compiled(perf_test::State& state, uint32_t addr, int value) {
+  StringBuffer<64> sb;
+  while (state.KeepRunning()) {
+    sb.clear();
+    PW_STRING_COMPILED_FORMAT(sb, "addr=0x%08x value=%d", addr, value);
+  }
+}
+
+// A log line with padding and several argument types.
+void Mixed_Format(perf_test::State& state, int64_t offset) {
+  StringBuffer<96> sb;
+  while (state.KeepRunning()) {
+    sb.clear();
+    sb.Format("[%-6s] %c chunk %5lld/%-5u crc=%#x",
+              "xfer",
+              'W',
+              static_cast<long long>(offset),
+              4096u,
+              0xc0ffeeu);
+  }
+}
+
+void Mixed_Compiled(perf_test::State& state, int64_t offset) {
+  StringBuffer<96> sb;
+  while (state.KeepRunning()) {
+    sb.clear();
+    PW_STRING_COMPILED_FORMAT(sb,
+                              "[%-6s] %c chunk %5lld/%-5u crc=%#x",
+                              "xfer",
+                              'W',
+                              offset,
+                              4096u,
+                              0xc0ffeeu);
+  }
+}
+
+PW_PERF_TEST(StringBuilder_Format_ReadBytes, ReadBytes_Format, 1500u);
+PW_PERF_TEST(CompiledFormat_ReadBytes, ReadBytes_Compiled, 1500u);
+PW_PERF_TEST(StringBuilder_Format_FileLine, FileLine_Format, 127);
+PW_PERF_TEST(CompiledFormat_FileLine, FileLine_Compiled, 127);
+PW_PERF_TEST(StringBuilder_Format_Register,
+             Register_Format,
+             0x4000'1000u,
+             -12);
+PW_PERF_TEST(CompiledFormat_Register, Register_Compiled, 0x4000'1000u, -12);
+PW_PERF_TEST(StringBuilder_Format_Mixed, Mixed_Format, 123456);
+PW_PERF_TEST(CompiledFormat_Mixed, Mixed_Compiled, 123456);
+
+}  // namespace
+}  // namespace pw::string
@@ -0,0 +1,188 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_string/compiled_format.h"
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#include "pw_compilation_testing/negative_compilation.h"
+#include "pw_string/string_builder.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw {
+namespace {
+
+using namespace std::string_view_literals;
+
+// Checks that PW_STRING_COMPILED_FORMAT produces the same output as
+// StringBuilder::Format.
+#define EXPECT_SAME_AS_FORMAT(format, ...)                  \
+  do {                                                      \
+    StringBuffer<64> expected;                              \
+    expected.Format(format PW_COMMA_ARGS(__VA_ARGS__));     \
+    StringBuffer<64> actual;                                \
+    PW_STRING_COMPILED_FORMAT(actual, format, __VA_ARGS__); \
+    EXPECT_EQ(actual.view(), expected.view());              \
+    EXPECT_EQ(actual.status(), expected.status());          \
+  } while (0)
+
+TEST(CompiledFormat, Literals) {
+  EXPECT_SAME_AS_FORMAT("Hello, world!");
+  EXPECT_SAME_AS_FORMAT("100%%");
+  EXPECT_SAME_AS_FORMAT("%%%%a%%b%%");
+}
+
+TEST(CompiledFormat, SignedIntegers) {
+  EXPECT_SAME_AS_FORMAT("%d", 0);
+  EXPECT_SAME_AS_FORMAT("%d", -123);
+  EXPECT_SAME_AS_FORMAT("%i", 456);
+  EXPECT_SAME_AS_FORMAT("%lld", std::numeric_limits<long long>::min());
+  EXPECT_SAME_AS_FORMAT("%lld", std::numeric_limits<long long>::max());
+  EXPECT_SAME_AS_FORMAT("%hhd", static_cast<signed char>(-5));
+  EXPECT_SAME_AS_FORMAT("[%5d]", -42);
+  EXPECT_SAME_AS_FORMAT("[%-5d]", 42);
+  EXPECT_SAME_AS_FORMAT("[%05d]", -42);
+  EXPECT_SAME_AS_FORMAT("[%+d %+d]", 7, -7);
+  EXPECT_SAME_AS_FORMAT("[% d % d]", 7, -7);
+  EXPECT_SAME_AS_FORMAT("[%.4d]", -42);
+  EXPECT_SAME_AS_FORMAT("[%8.4d]", 42);
+  EXPECT_SAME_AS_FORMAT("[%.0d]", 0);
+  EXPECT_SAME_AS_FORMAT("[%-+6d]", 3);
+}
+
+TEST(CompiledFormat, UnsignedIntegers) {
+  EXPECT_SAME_AS_FORMAT("%u", 0u);
+  EXPECT_SAME_AS_FORMAT("%u", -1);
+  EXPECT_SAME_AS_FORMAT("%llu", std::numeric_limits<unsigned long long>::max());
+  EXPECT_SAME_AS_FORMAT("%zu", sizeof(int));
+  EXPECT_SAME_AS_FORMAT("[%6u]", 123u);
+  EXPECT_SAME_AS_FORMAT("%o %#o %#o", 8u, 8u, 0u);
+  EXPECT_SAME_AS_FORMAT("%x %X", 0xbeefu, 0xbeefu);
+  EXPECT_SAME_AS_FORMAT("%#x %#X %#x", 0x1au, 0x1au, 0u);
+  EXPECT_SAME_AS_FORMAT("0x%08x", 0xabcu);
+  EXPECT_SAME_AS_FORMAT("[%#10x]", 0xabcu);
+  EXPECT_SAME_AS_FORMAT("[%#010x]", 0xabcu);
+  EXPECT_SAME_AS_FORMAT("[%-#10.6x]", 0xabcu);
+  EXPECT_SAME_AS_FORMAT("%x", -1);
+  EXPECT_SAME_AS_FORMAT("%hhx", static_cast<unsigned char>(0xff));
+}
+
+TEST(CompiledFormat, Characters) {
+  EXPECT_SAME_AS_FORMAT("%c%c", 'h', 'i');
+  EXPECT_SAME_AS_FORMAT("[%3c|%-3c]", 'a', 'b');
+}
+
+TEST(CompiledFormat, Strings) {
+  const char* const c_string = "C string";
+  EXPECT_SAME_AS_FORMAT("%s", "literal");
+  EXPECT_SAME_AS_FORMAT("%s", c_string);
+  EXPECT_SAME_AS_FORMAT("[%12s]", c_string);
+  EXPECT_SAME_AS_FORMAT("[%-12s]", c_string);
+  EXPECT_SAME_AS_FORMAT("[%.3s]", c_string);
+  EXPECT_SAME_AS_FORMAT("[%5.1s]", c_string);
+  EXPECT_SAME_AS_FORMAT("%s and %s", "this", "that");
+}
+
+TEST(CompiledFormat, StringViewsAndNull) {
+  StringBuffer<32> sb;
+  const char* const null_string = nullptr;
+  PW_STRING_COMPILED_FORMAT(sb, "%s|%s", "view"sv, null_string);
+  EXPECT_EQ(sb.view(), "view|(null)"sv);
+}
+
+TEST(CompiledFormat, FloatingPoint) {
+  EXPECT_SAME_AS_FORMAT("%f", 1.5);
+  EXPECT_SAME_AS_FORMAT("%.2f", 3.14159f);
+  EXPECT_SAME_AS_FORMAT("[%-10.3e]", 12345.678);
+  EXPECT_SAME_AS_FORMAT("%+E", -0.001);
+  EXPECT_SAME_AS_FORMAT("%lf", 2.25);
+}
+
+TEST(CompiledFormat, Pointers) {
+  int value = 0;
+  EXPECT_SAME_AS_FORMAT("%p", static_cast<void*>(&value));
+
+  StringBuffer<32> sb;
+  PW_STRING_COMPILED_FORMAT(sb, "%p", nullptr);
+  EXPECT_EQ(sb.view(), "(null)"sv);
+}
+
+enum class Color : uint8_t { kRed = 1, kBlue = 200 };
+
+TEST(CompiledFormat, Enums) {
+  StringBuffer<32> sb;
+  PW_STRING_COMPILED_FORMAT(sb, "%d,%x", Color::kRed, Color::kBlue);
+  EXPECT_EQ(sb.view(), "1,c8"sv);
+}
+
+TEST(CompiledFormat, ToStringConversion) {
+  StringBuffer<32> sb;
+  PW_STRING_COMPILED_FORMAT(sb, "%v %v %v", true, -3, OkStatus());
+  EXPECT_EQ(sb.view(), "true -3 OK"sv);
+}
+
+TEST(CompiledFormat, LogStyleMessage) {
+  EXPECT_SAME_AS_FORMAT("[%s] %-8s %5u bytes from 0x%08x: %s",
+                        "INF",
+                        "Transfer",
+                        1024u,
+                        0x2000'0000u,
+                        "done");
+}
+
+TEST(CompiledFormat, AppendsToExistingContents) {
+  StringBuffer<32> sb;
+  sb << "x=";
+  PW_STRING_COMPILED_FORMAT(sb, "%d", 1) << ", y=";
+  PW_STRING_COMPILED_FORMAT(sb, "%d", 2);
+  EXPECT_EQ(sb.view(), "x=1, y=2"sv);
+}
+
+TEST(CompiledFormat, OutputTooLong_ResourceExhausted) {
+  StringBuffer<8> sb;
+  PW_STRING_COMPILED_FORMAT(sb, "%s %d", "abcdef", 12345);
+  EXPECT_EQ(sb.status(), Status::ResourceExhausted());
+  EXPECT_EQ(sb.view(), "abcdef "sv);
+}
+
+TEST(CompiledFormat, InvalidFormats_FailToCompile) {
+  [[maybe_unused]] StringBuffer<32> sb;
+#if PW_NC_TEST(TooFewArguments)
+  PW_NC_EXPECT("number of arguments does not match");
+  PW_STRING_COMPILED_FORMAT(sb, "%d %d", 1);
+#elif PW_NC_TEST(TooManyArguments)
+  PW_NC_EXPECT("number of arguments does not match");
+  PW_STRING_COMPILED_FORMAT(sb, "%d", 1, 2);
+#elif PW_NC_TEST(StringForInteger)
+  PW_NC_EXPECT("%d and %i require an integer");
+  PW_STRING_COMPILED_FORMAT(sb, "%d", "1");
+#elif PW_NC_TEST(IntegerForString)
+  PW_NC_EXPECT("%s requires a string");
+  PW_STRING_COMPILED_FORMAT(sb, "%s", 1);
+#elif PW_NC_TEST(UnsupportedConversion)
+  PW_NC_EXPECT("unsupported conversion");
+  PW_STRING_COMPILED_FORMAT(sb, "%g", 1.0);
+#elif PW_NC_TEST(VariableWidth)
+  PW_NC_EXPECT("\* widths and precisions are not supported");
+  PW_STRING_COMPILED_FORMAT(sb, "%*d", 3, 1);
+#elif PW_NC_TEST(IncompleteConversion)
+  PW_NC_EXPECT("incomplete conversion");
+  PW_STRING_COMPILED_FORMAT(sb, "100%");
+#endif  // PW_NC_TEST
+}
+
+}  // namespace
+}  // namespace pw
@@ -15,6 +15,8 @@
 #include "pw_string/hex.h"
 
 #include <cstdarg>
+#include <cstddef>
+#include <cstdint>
 
 namespace pw::string {
 
@@ -84,4 +86,24 @@ static_assert(IsHexDigit('e'));
 static_assert(IsHexDigit('f'));
 static_assert(!IsHexDigit('!'));
 
+static_assert(NibblesToHex(0x01234567u) == 0x3031323334353637u);
+static_assert(NibblesToHex(0x89abcdefu) == 0x3839616263646566u);
+static_assert(NibblesToHex(0u) == 0x3030303030303030u);
+static_assert(NibblesToHex(0xffffffffu) == 0x6666666666666666u);
+
+constexpr bool HexDigitsAre(uint64_t value, const char (&expected)[17]) {
+  char digits[16] = {};
+  WriteHexDigits(value, digits);
+  for (size_t i = 0; i < sizeof(digits); ++i) {
+    if (digits[i] != expected[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(HexDigitsAre(0x0123456789abcdefu, "0123456789abcdef"));
+static_assert(HexDigitsAre(0xfedcba9876543210u, "fedcba9876543210"));
+static_assert(HexDigitsAre(0x9u, "0000000000000009"));
+
 }  // namespace pw::string
@@ -0,0 +1,479 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+/// @file pw_string/compiled_format.h
+///
+/// `PW_STRING_COMPILED_FORMAT` is a type-safe alternative to
+/// `pw::StringBuilder::Format`. The format string is parsed and checked
+/// against the arguments at compile time, and the call is lowered to a fixed
+/// sequence of appends and `pw::ToString` calls, without `std::vsnprintf`.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "pw_preprocessor/arguments.h"
+#include "pw_preprocessor/compiler.h"
+#include "pw_string/string_builder.h"
+#include "pw_string/type_to_string.h"
+
+/// @submodule{pw_string,builder}
+
+/// Appends printf-style formatted output to a `pw::StringBuilder`, like
+/// `pw::StringBuilder::Format`. Evaluates to the `pw::StringBuilder&`.
+///
+/// The format string must be a string literal or other constant expression.
+/// It is parsed at compile time with the `printf` grammar that `pw_format`
+/// accepts:
+///
+/// - Flags: `-`, `+`, space, `#` and `0`.
+/// - A field width and precision. `*` is not supported.
+/// - Length modifiers `hh`, `h`, `l`, `ll`, `j`, `z`, `t` and `L`. These are
+///   checked but otherwise ignored, since the argument's type is known.
+/// - Conversions `d`, `i`, `o`, `u`, `x`, `X`, `f`, `e`, `E`, `c`, `s`, `p`,
+///   and `v`, which appends the argument with `pw::ToString`.
+///
+/// Mismatches between the format string and the arguments, such as a missing
+/// argument or a string passed for `%d`, are compile errors.
+///
+/// @code{.cpp}
+///   pw::StringBuffer<64> sb;
+///   PW_STRING_COMPILED_FORMAT(sb, "%s: read %u bytes", name, count);
+/// @endcode
+#define PW_STRING_COMPILED_FORMAT(builder, format, ...)                    \
+  [&]() -> ::pw::StringBuilder& {                                          \
+    struct PwStringCompiledFormatString {                                  \
+      static constexpr ::std::string_view value() { return format; }       \
+    };                                                                     \
+    return ::pw::string::internal::CompiledFormat<                         \
+        PwStringCompiledFormatString>(builder PW_COMMA_ARGS(__VA_ARGS__)); \
+  }()
+
+/// @}
+
+namespace pw::string::internal {
+
+// A printf conversion specification, parsed at compile time.
+struct FormatSpec {
+  bool left_justify = false;
+  bool force_sign = false;
+  bool space_sign = false;
+  bool alternate = false;
+  bool leading_zeros = false;
+  int width = 0;
+  int precision = -1;  // -1 if not specified
+  char conversion = '\0';  // '\0' for literal text
+
+  // True if the conversion has no flags, width or precision.
+  constexpr bool is_plain() const {
+    return !left_justify && !force_sign && !space_sign && !alternate &&
+           !leading_zeros && width == 0 && precision < 0;
+  }
+};
+
+// Literal text or a conversion, referring to the format string by position.
+struct FormatSegment {
+  size_t begin = 0;
+  size_t end = 0;
+  size_t argument = 0;
+  FormatSpec spec;
+};
+
+enum class FormatError : uint8_t {
+  kNone,
+  kIncompleteConversion,
+  kUnsupportedConversion,
+  kVariableWidthOrPrecision,
+  kInvalidLengthModifier,
+};
+
+template <size_t kMaxSegments>
+struct ParsedFormat {
+  std::array<FormatSegment, kMaxSegments> segments{};
+  size_t segment_count = 0;
+  size_t argument_count = 0;
+  FormatError error = FormatError::kNone;
+};
+
+// Every conversion may split a literal, so a format string has at most two
+// segments per '%' plus one.
+constexpr size_t MaxFormatSegments(std::string_view format) {
+  size_t count = 1;
+  for (char c : format) {
+    if (c == '%') {
+      count += 2;
+    }
+  }
+  return count;
+}
+
+constexpr bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+template <size_t kMaxSegments>
+constexpr ParsedFormat<kMaxSegments> ParseFormat(std::string_view format) {
+  ParsedFormat<kMaxSegments> parsed;
+  size_t i = 0;
+
+  while (i < format.size()) {
+    FormatSegment segment;
+    segment.begin = i;
+
+    if (format[i] != '%') {
+      while (i < format.size() && format[i] != '%') {
+        i += 1;
+      }
+      segment.end = i;
+      parsed.segments[parsed.segment_count++] = segment;
+      continue;
+    }
+
+    i += 1;
+    if (i < format.size() && format[i] == '%') {  // %% is a literal %.
+      segment.begin = i;
+      segment.end = i + 1;
+      parsed.segments[parsed.segment_count++] = segment;
+      i += 1;
+      continue;
+    }
+
+    FormatSpec& spec = segment.spec;
+    for (; i < format.size(); ++i) {
+      const char flag = format[i];
+      if (flag == '-') {
+        spec.left_justify = true;
+      } else if (flag == '+') {
+        spec.force_sign = true;
+      } else if (flag == ' ') {
+        spec.space_sign = true;
+      } else if (flag == '#') {
+        spec.alternate = true;
+      } else if (flag == '0') {
+        spec.leading_zeros = true;
+      } else {
+        break;
+      }
+    }
+
+    for (; i < format.size() && IsDigit(format[i]); ++i) {
+      spec.width = spec.width * 10 + (format[i] - '0');
+    }
+    if (i < format.size() && format[i] == '.') {
+      spec.precision = 0;
+      for (i += 1; i < format.size() && IsDigit(format[i]); ++i) {
+        spec.precision = spec.precision * 10 + (format[i] - '0');
+      }
+    }
+    if (i < format.size() && format[i] == '*') {
+      parsed.error = FormatError::kVariableWidthOrPrecision;
+      return parsed;
+    }
+
+    // Length modifiers: hh, h, ll, l, j, z, t and L.
+    char length = '\0';
+    if (i < format.size()) {
+      switch (format[i]) {
+        case 'h':
+        case 'l':
+          length = format[i];
+          i += 1;
+          if (i < format.size() && format[i] == length) {
+            i += 1;
+          }
+          break;
+        case 'j':
+        case 'z':
+        case 't':
+        case 'L':
+          length = format[i];
+          i += 1;
+          break;
+        default:
+          break;
+      }
+    }
+
+    if (i == format.size()) {
+      parsed.error = FormatError::kIncompleteConversion;
+      return parsed;
+    }
+
+    spec.conversion = format[i];
+    i += 1;
+    switch (spec.conversion) {
+      case 'd':
+      case 'i':
+      case 'o':
+      case 'u':
+      case 'x':
+      case 'X':
+        if (length == 'L') {
+          parsed.error = FormatError::kInvalidLengthModifier;
+          return parsed;
+        }
+        break;
+      case 'f':
+      case 'e':
+      case 'E':
+        if (length != '\0' && length != 'l' && length != 'L') {
+          parsed.error = FormatError::kInvalidLengthModifier;
+          return parsed;
+        }
+        break;
+      case 'c':
+      case 's':
+      case 'p':
+      case 'v':
+        if (length != '\0') {
+          parsed.error = FormatError::kInvalidLengthModifier;
+          return parsed;
+        }
+        break;
+      default:
+        parsed.error = FormatError::kUnsupportedConversion;
+        return parsed;
+    }
+
+    segment.end = i;
+    segment.argument = parsed.argument_count++;
+    parsed.segments[parsed.segment_count++] = segment;
+  }
+  return parsed;
+}
+
+template <typename Format>
+struct CompiledFormatString {
+  static constexpr std::string_view kString = Format::value();
+  static constexpr auto kParsed =
+      ParseFormat<MaxFormatSegments(kString)>(kString);
+};
+
+// Formats a conversion specification for std::snprintf, without the length
+// modifier. Used for floating point conversions.
+template <typename Format, size_t kSegment>
+constexpr std::array<char, 32> PrintfSpec() {
+  constexpr FormatSpec kSpec =
+      CompiledFormatString<Format>::kParsed.segments[kSegment].spec;
+  std::array<char, 32> result{};
+  size_t i = 0;
+  auto append_int = [&result, &i](int value) {
+    char digits[10]{};
+    size_t count = 0;
+    do {
+      digits[count++] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while (value != 0);
+    while (count > 0) {
+      result[i++] = digits[--count];
+    }
+  };
+
+  result[i++] = '%';
+  if (kSpec.left_justify) {
+    result[i++] = '-';
+  }
+  if (kSpec.force_sign) {
+    result[i++] = '+';
+  }
+  if (kSpec.space_sign) {
+    result[i++] = ' ';
+  }
+  if (kSpec.alternate) {
+    result[i++] = '#';
+  }
+  if (kSpec.leading_zeros) {
+    result[i++] = '0';
+  }
+  if (kSpec.width != 0) {
+    append_int(kSpec.width);
+  }
+  if (kSpec.precision >= 0) {
+    result[i++] = '.';
+    append_int(kSpec.precision);
+  }
+  result[i++] = kSpec.conversion;
+  return result;
+}
+
+template <typename T>
+constexpr bool kIsFormatInteger = std::is_integral_v<T> || std::is_enum_v<T>;
+
+template <typename T>
+constexpr bool kIsFormatString =
+    std::is_convertible_v<const T&, std::string_view>;
+
+template <typename T>
+constexpr bool kIsFormatPointer =
+    std::is_pointer_v<T> || std::is_null_pointer_v<T>;
+
+// Converts an integer or enum to a 64-bit integer of the same signedness.
+template <typename T>
+constexpr auto WidenInteger(T value) {
+  if constexpr (std::is_enum_v<T>) {
+    return WidenInteger(static_cast<std::underlying_type_t<T>>(value));
+  } else if constexpr (std::is_signed_v<T>) {
+    return static_cast<int64_t>(value);
+  } else {
+    return static_cast<uint64_t>(value);
+  }
+}
+
+// Converts an integer or enum to unsigned as printf does for %o, %u and %x.
+template <typename T>
+constexpr uint64_t ToUnsigned(T value) {
+  if constexpr (std::is_enum_v<T>) {
+    return ToUnsigned(static_cast<std::underlying_type_t<T>>(value));
+  } else if constexpr (std::is_signed_v<T>) {
+    return static_cast<std::make_unsigned_t<T>>(value);
+  } else {
+    return value;
+  }
+}
+
+// Out-of-line implementations of conversions with flags, width or precision.
+void AppendInteger(StringBuilder& builder,
+                   const FormatSpec& spec,
+                   bool negative,
+                   uint64_t magnitude);
+void AppendString(StringBuilder& builder,
+                  const FormatSpec& spec,
+                  std::string_view value);
+void AppendPointer(StringBuilder& builder,
+                   const FormatSpec& spec,
+                   const void* value);
+
+template <typename Format, size_t kSegment, typename T>
+void AppendArgument(StringBuilder& builder, const T& value) {
+  constexpr FormatSpec kSpec =
+      CompiledFormatString<Format>::kParsed.segments[kSegment].spec;
+  constexpr char kConversion = kSpec.conversion;
+
+  if constexpr (kConversion == 'd' || kConversion == 'i') {
+    static_assert(kIsFormatInteger<T>,
+                  "%d and %i require an integer or enum argument");
+    const auto widened = WidenInteger(value);
+    if constexpr (kSpec.is_plain()) {
+      builder << widened;
+    } else if constexpr (std::is_signed_v<decltype(widened)>) {
+      AppendInteger(builder,
+                    kSpec,
+                    widened < 0,
+                    widened < 0 ? -static_cast<uint64_t>(widened)
+                                : static_cast<uint64_t>(widened));
+    } else {
+      AppendInteger(builder, kSpec, false, widened);
+    }
+  } else if constexpr (kConversion == 'o' || kConversion == 'u' ||
+                       kConversion == 'x' || kConversion == 'X') {
+    static_assert(kIsFormatInteger<T>,
+                  "%o, %u, %x and %X require an integer or enum argument");
+    if constexpr (kConversion == 'u' && kSpec.is_plain()) {
+      builder << ToUnsigned(value);
+    } else {
+      AppendInteger(builder, kSpec, false, ToUnsigned(value));
+    }
+  } else if constexpr (kConversion == 'c') {
+    static_assert(kIsFormatInteger<T>, "%c requires a character argument");
+    const char character = static_cast<char>(value);
+    if constexpr (kSpec.is_plain()) {
+      builder.push_back(character);
+    } else {
+      AppendString(builder, kSpec, std::string_view(&character, 1));
+    }
+  } else if constexpr (kConversion == 's') {
+    static_assert(kIsFormatString<T>, "%s requires a string argument");
+    std::string_view string;
+    if constexpr (std::is_pointer_v<T>) {
+      string = value == nullptr ? kNullPointerString : std::string_view(value);
+    } else {
+      string = value;
+    }
+    if constexpr (kSpec.is_plain()) {
+      builder.append(string);
+    } else {
+      AppendString(builder, kSpec, string);
+    }
+  } else if constexpr (kConversion == 'p') {
+    static_assert(kIsFormatPointer<T>, "%p requires a pointer argument");
+    AppendPointer(builder, kSpec, static_cast<const void*>(value));
+  } else if constexpr (kConversion == 'v') {
+    static_assert(kSpec.is_plain(),
+                  "%v does not support flags, a width or a precision");
+    builder << value;
+  } else {  // f, e or E
+    static_assert(std::is_floating_point_v<T>,
+                  "%f, %e and %E require a floating point argument");
+    // Floating point conversions are delegated to std::vsnprintf.
+    static constexpr std::array<char, 32> kPrintfSpec =
+        PrintfSpec<Format, kSegment>();
+    PW_MODIFY_DIAGNOSTICS_PUSH();
+    PW_MODIFY_DIAGNOSTIC(ignored, "-Wformat-nonliteral");
+    builder.Format(kPrintfSpec.data(), static_cast<double>(value));
+    PW_MODIFY_DIAGNOSTICS_POP();
+  }
+}
+
+template <typename Format, size_t kSegment, typename Tuple>
+void AppendSegment(StringBuilder& builder, const Tuple& args) {
+  using String = CompiledFormatString<Format>;
+  constexpr FormatSegment kSegmentInfo = String::kParsed.segments[kSegment];
+
+  if constexpr (kSegmentInfo.spec.conversion == '\0') {
+    builder.append(String::kString.data() + kSegmentInfo.begin,
+                   kSegmentInfo.end - kSegmentInfo.begin);
+  } else {
+    AppendArgument<Format, kSegment>(builder,
+                                     std::get<kSegmentInfo.argument>(args));
+  }
+}
+
+template <typename Format, typename Tuple, size_t... kSegments>
+void AppendSegments(StringBuilder& builder,
+                    const Tuple& args,
+                    std::index_sequence<kSegments...>) {
+  static_cast<void>(args);
+  (AppendSegment<Format, kSegments>(builder, args), ...);
+}
+
+template <typename Format, typename... Args>
+StringBuilder& CompiledFormat(StringBuilder& builder, const Args&... args) {
+  constexpr auto& kParsed = CompiledFormatString<Format>::kParsed;
+
+  static_assert(kParsed.error != FormatError::kIncompleteConversion,
+                "The format string ends with an incomplete conversion");
+  static_assert(kParsed.error != FormatError::kUnsupportedConversion,
+                "The format string has an unsupported conversion; see "
+                "pw_string/compiled_format.h for the supported conversions");
+  static_assert(kParsed.error != FormatError::kVariableWidthOrPrecision,
+                "* widths and precisions are not supported");
+  static_assert(kParsed.error != FormatError::kInvalidLengthModifier,
+                "The length modifier is not valid for the conversion");
+  static_assert(kParsed.error != FormatError::kNone ||
+                    kParsed.argument_count == sizeof...(Args),
+                "The number of arguments does not match the format string");
+
+  if constexpr (kParsed.error == FormatError::kNone &&
+                kParsed.argument_count == sizeof...(Args)) {
+    AppendSegments<Format>(builder,
+                           std::forward_as_tuple(args...),
+                           std::make_index_sequence<kParsed.segment_count>());
+  }
+  return builder;
+}
+
+}  // namespace pw::string::internal
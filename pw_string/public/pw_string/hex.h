@@ -46,6 +46,34 @@ constexpr char NibbleToHex(uint8_t value) {
   return '?';
 }
 
+// Converts the eight nibbles of a 32-bit value to lowercase hexadecimal digits
+// at once, without a loop or lookup table. Returns the characters packed into a
+// 64-bit integer, with the most significant digit in the most significant byte.
+constexpr uint64_t NibblesToHex(uint32_t value) {
+  // Spread the nibbles out so that each byte holds one nibble.
+  uint64_t x = value;
+  x = ((x & 0xffff0000u) << 16) | (x & 0x0000ffffu);
+  x = ((x & 0x0000ff000000ff00u) << 8) | (x & 0x000000ff000000ffu);
+  x = ((x & 0x00f000f000f000f0u) << 4) | (x & 0x000f000f000f000fu);
+
+  // Adding 6 carries into bit 4 of each byte that holds 10 or more. Offset
+  // those bytes from '0' to 'a' and add '0' to every byte.
+  const uint64_t letters =
+      ((x + 0x0606060606060606u) >> 4) & 0x0101010101010101u;
+  return x + 0x3030303030303030u + letters * ('a' - '0' - 10);
+}
+
+// Writes the sixteen lowercase hexadecimal digits of a 64-bit value, including
+// leading zeros, to out. Does not null terminate.
+constexpr void WriteHexDigits(uint64_t value, char* out) {
+  const uint64_t high = NibblesToHex(static_cast<uint32_t>(value >> 32));
+  const uint64_t low = NibblesToHex(static_cast<uint32_t>(value));
+  for (int i = 0; i < 8; ++i) {
+    out[i] = static_cast<char>(high >> (56 - 8 * i));
+    out[i + 8] = static_cast<char>(low >> (56 - 8 * i));
+  }
+}
+
 // Check if a character is a valid hex digit
 constexpr bool IsHexDigit(char value) {
   return ('a' <= value && value <= 'f') || ('A' <= value && value <= 'F') ||
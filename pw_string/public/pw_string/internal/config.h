@@ -27,6 +27,17 @@
 #define PW_STRING_ENABLE_DECIMAL_FLOAT_EXPANSION 0
 #endif
 
+// PW_STRING_ENABLE_SHORTEST_FLOAT_EXPANSION makes the ToString function print
+// floating point values with the fewest digits that convert back to the same
+// value, e.g. "0.1" or "1.5e-07". This uses pw::string::FloatToString and
+// pw::string::DoubleToString, which do not rely on snprintf. Takes precedence
+// over PW_STRING_ENABLE_DECIMAL_FLOAT_EXPANSION.
+//
+// Printing doubles this way adds about 10 KB of tables to the binary.
+#ifndef PW_STRING_ENABLE_SHORTEST_FLOAT_EXPANSION
+#define PW_STRING_ENABLE_SHORTEST_FLOAT_EXPANSION 0
+#endif
+
 /// @}
 
 namespace pw::string::internal::config {
@@ -34,6 +45,10 @@ namespace pw::string::internal::config {
 inline constexpr bool kEnableDecimalFloatExpansion =
     PW_STRING_ENABLE_DECIMAL_FLOAT_EXPANSION;
 
+inline constexpr bool kEnableShortestFloatExpansion =
+    PW_STRING_ENABLE_SHORTEST_FLOAT_EXPANSION;
+
 }
 
 #undef PW_STRING_ENABLE_DECIMAL_FLOAT_EXPANSION
+#undef PW_STRING_ENABLE_SHORTEST_FLOAT_EXPANSION
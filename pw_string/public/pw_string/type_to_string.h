@@ -19,6 +19,7 @@
 
 #include <array>
 #include <cstdint>
+#include <limits>
 #include <string_view>
 #include <type_traits>
 
@@ -95,6 +96,25 @@ StatusWithSize IntToHexString(uint64_t value,
 //
 StatusWithSize FloatAsIntToString(float value, span<char> buffer);
 
+// Writes the shortest decimal representation of a floating point number that
+// converts back to exactly the same value, like std::to_chars with no format
+// or precision. Fixed notation is used unless scientific notation is shorter.
+// Infinity and NaN are written as "inf" and "NaN", like FloatAsIntToString.
+// Semantics otherwise match IntToString.
+//
+// The digits are computed with the Ryu algorithm, without snprintf. Converting
+// a double uses about 10 KB of tables; converting a float uses less than 1 KB.
+//
+// Examples:
+//
+//   FloatToString(0.1f, buffer)     -> writes "0.1" to the buffer
+//   FloatToString(-1.5e-7f, buffer) -> writes "-1.5e-07" to the buffer
+//   DoubleToString(1e22, buffer)    -> writes "1e+22" to the buffer
+//   DoubleToString(123456, buffer)  -> writes "123456" to the buffer
+//
+StatusWithSize FloatToString(float value, span<char> buffer);
+StatusWithSize DoubleToString(double value, span<char> buffer);
+
 // Writes a bool as "true" or "false". Semantics match CopyEntireString.
 StatusWithSize BoolToString(bool value, span<char> buffer);
 
@@ -184,6 +204,56 @@ inline constexpr std::array<uint64_t, 20> kPowersOf10{
     10000000000000000000ull,  // 10^19
 };
 
+// The two-digit decimal strings "00" to "99", concatenated. Converting two
+// digits per division halves the number of divisions in IntToString.
+inline constexpr char kDigitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Writes the two decimal digits of a value less than 100.
+constexpr void WriteDigitPair(uint32_t value, char* out) {
+  out[0] = kDigitPairs[2 * value];
+  out[1] = kDigitPairs[2 * value + 1];
+}
+
+// Writes the decimal digits of value so that the last digit is at end[-1].
+// The caller must have room for DecimalDigitCount(value) characters.
+constexpr void WriteDecimalDigits(uint64_t value, char* end) {
+  constexpr uint32_t kMaxUint32Base100Power = 100'000'000;
+
+  // 64-bit division is slow on 32-bit platforms, so print large numbers in
+  // 8-digit chunks to minimize the number of 64-bit divisions.
+  while (value > std::numeric_limits<uint32_t>::max()) {
+    uint32_t chunk = static_cast<uint32_t>(value % kMaxUint32Base100Power);
+    value /= kMaxUint32Base100Power;
+    for (int i = 0; i < 4; ++i) {
+      end -= 2;
+      WriteDigitPair(chunk % 100, end);
+      chunk /= 100;
+    }
+  }
+
+  uint32_t lower_digits = static_cast<uint32_t>(value);
+  while (lower_digits >= 100) {
+    end -= 2;
+    WriteDigitPair(lower_digits % 100, end);
+    lower_digits /= 100;
+  }
+  if (lower_digits >= 10) {
+    WriteDigitPair(lower_digits, end - 2);
+  } else {
+    end[-1] = static_cast<char>('0' + lower_digits);
+  }
+}
+
 constexpr StatusWithSize HandleExhaustedBuffer(span<char> buffer) {
   if (!buffer.empty()) {
     buffer[0] = '\0';
@@ -213,10 +283,6 @@ constexpr uint_fast8_t DecimalDigitCount(uint64_t integer) {
 // think std::to_chars will be faster, so I kept this implementation for now.
 template <>
 constexpr StatusWithSize IntToString(uint64_t value, span<char> buffer) {
-  constexpr uint32_t base = 10;
-  constexpr uint32_t max_uint32_base_power = 1'000'000'000;
-  constexpr uint_fast8_t max_uint32_base_power_exponent = 9;
-
   const uint_fast8_t total_digits = DecimalDigitCount(value);
 
   if (total_digits >= buffer.size()) {
@@ -224,29 +290,7 @@ constexpr StatusWithSize IntToString(uint64_t value, span<char> buffer) {
   }
 
   buffer[total_digits] = '\0';
-
-  uint_fast8_t remaining = total_digits;
-  while (remaining > 0u) {
-    uint32_t lower_digits = 0;     // the value of the lower digits to write
-    uint_fast8_t digit_count = 0;  // the number of lower digits to write
-
-    // 64-bit division is slow on 32-bit platforms, so print large numbers in
-    // 32-bit chunks to minimize the number of 64-bit divisions.
-    if (value <= std::numeric_limits<uint32_t>::max()) {
-      lower_digits = static_cast<uint32_t>(value);
-      digit_count = remaining;
-    } else {
-      lower_digits = static_cast<uint32_t>(value % max_uint32_base_power);
-      digit_count = max_uint32_base_power_exponent;
-      value /= max_uint32_base_power;
-    }
-
-    // Write the specified number of digits, with leading 0s.
-    for (uint_fast8_t i = 0; i < digit_count; ++i) {
-      buffer[--remaining] = static_cast<char>(lower_digits % base + '0');
-      lower_digits /= base;
-    }
-  }
+  internal::WriteDecimalDigits(value, buffer.data() + total_digits);
   return StatusWithSize(total_digits);
 }
 
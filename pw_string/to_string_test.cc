@@ -134,7 +134,14 @@ void TestFloatingPointType() {
   EXPECT_EQ(4u, ToString(kNegativeInf, buffer).size());
   EXPECT_STREQ("-inf", buffer);
 
-  if (string::internal::config::kEnableDecimalFloatExpansion) {
+  if (string::internal::config::kEnableShortestFloatExpansion) {
+    EXPECT_EQ(1u, ToString(kZero, buffer).size());
+    EXPECT_STREQ("0", buffer);
+    EXPECT_EQ(6u, ToString(kValue, buffer).size());
+    EXPECT_STREQ("33.444", buffer);
+    EXPECT_EQ(3u, ToString(kNan, buffer).size());
+    EXPECT_STREQ("NaN", buffer);
+  } else if (string::internal::config::kEnableDecimalFloatExpansion) {
     EXPECT_EQ(5u, ToString(kZero, buffer).size());
     EXPECT_STREQ("0.000", buffer);
     EXPECT_EQ(6u, ToString(kValue, buffer).size());
@@ -14,6 +14,7 @@
 
 #include "pw_string/type_to_string.h"
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
@@ -21,8 +22,436 @@
 #include <limits>
 
 #include "lib/stdcompat/bit.h"
+#include "pw_string/hex.h"
+#include "pw_string_private/float_to_string_tables.h"
 
 namespace pw::string {
+namespace {
+
+// Writes "inf", "-inf", "NaN", or "-NaN", if it fits.
+template <typename Float>
+StatusWithSize NonFiniteToString(Float value, span<char> buffer) {
+  if (const size_t written = 3 + std::signbit(value); written < buffer.size()) {
+    char* out = buffer.data();
+    if (std::signbit(value)) {
+      *out++ = '-';
+    }
+    std::memcpy(out, std::isnan(value) ? "NaN" : "inf", sizeof("NaN"));
+    return StatusWithSize(written);
+  }
+
+  return internal::HandleExhaustedBuffer(buffer);
+}
+
+// The Ryu algorithm finds the shortest decimal digits that are within the
+// rounding interval of a floating point value. See Ulf Adams, "Ryu: fast
+// float-to-string conversion", PLDI 2018. The value is digits * 10^exponent.
+struct Decimal {
+  uint64_t digits;
+  int32_t exponent;
+};
+
+// Returns ceil(log2(5^e)), for 0 <= e <= 3528.
+constexpr int32_t Pow5Bits(int32_t e) {
+  return static_cast<int32_t>((static_cast<uint32_t>(e) * 1217359) >> 19) + 1;
+}
+
+// Returns floor(log10(2^e)), for 0 <= e <= 1650.
+constexpr uint32_t Log10Pow2(int32_t e) {
+  return (static_cast<uint32_t>(e) * 78913) >> 18;
+}
+
+// Returns floor(log10(5^e)), for 0 <= e <= 2620.
+constexpr uint32_t Log10Pow5(int32_t e) {
+  return (static_cast<uint32_t>(e) * 732923) >> 20;
+}
+
+constexpr bool MultipleOfPowerOf5(uint64_t value, uint32_t p) {
+  uint32_t count = 0;
+  while (value % 5 == 0) {
+    value /= 5;
+    ++count;
+  }
+  return count >= p;
+}
+
+constexpr bool MultipleOfPowerOf2(uint64_t value, uint32_t p) {
+  return (value & ((uint64_t{1} << p) - 1)) == 0;
+}
+
+// Returns (m * factor) >> shift, for shift > 32.
+constexpr uint32_t MulShift32(uint32_t m, uint64_t factor, int32_t shift) {
+  const uint64_t low = uint64_t{m} * static_cast<uint32_t>(factor);
+  const uint64_t high = uint64_t{m} * static_cast<uint32_t>(factor >> 32);
+  return static_cast<uint32_t>(((low >> 32) + high) >> (shift - 32));
+}
+
+// Returns (m * factor) >> shift, where factor is a 128-bit {low, high} pair,
+// for 64 < shift < 128.
+uint64_t MulShift64(uint64_t m, const uint64_t (&factor)[2], int32_t shift) {
+#if defined(__SIZEOF_INT128__)
+  using Uint128 = unsigned __int128;
+  const Uint128 low = static_cast<Uint128>(m) * factor[0];
+  const Uint128 high = static_cast<Uint128>(m) * factor[1];
+  return static_cast<uint64_t>(((low >> 64) + high) >> (shift - 64));
+#else
+  // Returns the low 64 bits of a * b and stores the high 64 bits in high.
+  constexpr auto multiply = [](uint64_t a, uint64_t b, uint64_t& high) {
+    const uint64_t a_lo = static_cast<uint32_t>(a);
+    const uint64_t a_hi = a >> 32;
+    const uint64_t b_lo = static_cast<uint32_t>(b);
+    const uint64_t b_hi = b >> 32;
+    const uint64_t lo_lo = a_lo * b_lo;
+    const uint64_t mid1 = a_hi * b_lo + (lo_lo >> 32);
+    const uint64_t mid2 = a_lo * b_hi + static_cast<uint32_t>(mid1);
+    high = a_hi * b_hi + (mid1 >> 32) + (mid2 >> 32);
+    return (mid2 << 32) | static_cast<uint32_t>(lo_lo);
+  };
+
+  uint64_t high1 = 0;
+  const uint64_t low1 = multiply(m, factor[1], high1);
+  uint64_t high0 = 0;
+  multiply(m, factor[0], high0);
+  const uint64_t sum = high0 + low1;
+  if (sum < high0) {
+    ++high1;
+  }
+  const int32_t distance = shift - 64;
+  return (high1 << (64 - distance)) | (sum >> distance);
+#endif  // defined(__SIZEOF_INT128__)
+}
+
+// Removes digits from the interval [vm, vp] until the shortest representation
+// remains, rounding vr to nearest with ties to even.
+template <typename T>
+Decimal Shorten(T vr,
+                T vp,
+                T vm,
+                int32_t exponent,
+                bool accept_bounds,
+                bool vm_is_trailing_zeros,
+                bool vr_is_trailing_zeros,
+                uint32_t last_removed_digit) {
+  if (vm_is_trailing_zeros || vr_is_trailing_zeros) {
+    // Rare: the interval bounds or the value may be exact.
+    while (vp / 10 > vm / 10) {
+      vm_is_trailing_zeros &= vm % 10 == 0;
+      vr_is_trailing_zeros &= last_removed_digit == 0;
+      last_removed_digit = static_cast<uint32_t>(vr % 10);
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+      ++exponent;
+    }
+    if (vm_is_trailing_zeros) {
+      while (vm % 10 == 0) {
+        vr_is_trailing_zeros &= last_removed_digit == 0;
+        last_removed_digit = static_cast<uint32_t>(vr % 10);
+        vr /= 10;
+        vp /= 10;
+        vm /= 10;
+        ++exponent;
+      }
+    }
+    if (vr_is_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0) {
+      last_removed_digit = 4;  // Exactly halfway; round to even.
+    }
+    const bool round_up =
+        (vr == vm && (!accept_bounds || !vm_is_trailing_zeros)) ||
+        last_removed_digit >= 5;
+    return {static_cast<uint64_t>(vr) + round_up, exponent};
+  }
+
+  // Common case: no exact bounds, so only the last removed digit matters.
+  while (vp / 10 > vm / 10) {
+    last_removed_digit = static_cast<uint32_t>(vr % 10);
+    vr /= 10;
+    vp /= 10;
+    vm /= 10;
+    ++exponent;
+  }
+  const bool round_up = vr == vm || last_removed_digit >= 5;
+  return {static_cast<uint64_t>(vr) + round_up, exponent};
+}
+
+Decimal FloatToDecimal(uint32_t ieee_mantissa, uint32_t ieee_exponent) {
+  using internal::ryu::kFloatPow5Bits;
+  using internal::ryu::kFloatPow5InvBits;
+  using internal::ryu::kFloatPow5InvSplit;
+  using internal::ryu::kFloatPow5Split;
+
+  constexpr int32_t kMantissaBits = 23;
+  constexpr int32_t kBias = 127;
+
+  // Subtract 2 so that the bounds are integers: [4 * m2 - 1, 4 * m2 + 2].
+  int32_t e2 = 0;
+  uint32_t m2 = 0;
+  if (ieee_exponent == 0) {
+    e2 = 1 - kBias - kMantissaBits - 2;
+    m2 = ieee_mantissa;
+  } else {
+    e2 = static_cast<int32_t>(ieee_exponent) - kBias - kMantissaBits - 2;
+    m2 = (uint32_t{1} << kMantissaBits) | ieee_mantissa;
+  }
+  const bool accept_bounds = (m2 & 1) == 0;
+
+  const uint32_t mv = 4 * m2;
+  const uint32_t mp = 4 * m2 + 2;
+  // The lower bound is closer at the boundary between exponents.
+  const uint32_t mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+  const uint32_t mm = 4 * m2 - 1 - mm_shift;
+
+  uint32_t vr = 0;
+  uint32_t vp = 0;
+  uint32_t vm = 0;
+  int32_t e10 = 0;
+  bool vm_is_trailing_zeros = false;
+  bool vr_is_trailing_zeros = false;
+  uint32_t last_removed_digit = 0;
+
+  if (e2 >= 0) {
+    const uint32_t q = Log10Pow2(e2);
+    e10 = static_cast<int32_t>(q);
+    const int32_t k = static_cast<int32_t>(kFloatPow5InvBits) +
+                      Pow5Bits(static_cast<int32_t>(q)) - 1;
+    const int32_t i = -e2 + static_cast<int32_t>(q) + k;
+    vr = MulShift32(mv, kFloatPow5InvSplit[q], i);
+    vp = MulShift32(mp, kFloatPow5InvSplit[q], i);
+    vm = MulShift32(mm, kFloatPow5InvSplit[q], i);
+    if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+      // The shortest representation has all but one digit removed, so the
+      // last removed digit must be computed from one more digit of vr.
+      const int32_t l = static_cast<int32_t>(kFloatPow5InvBits) +
+                        Pow5Bits(static_cast<int32_t>(q - 1)) - 1;
+      last_removed_digit =
+          MulShift32(mv,
+                     kFloatPow5InvSplit[q - 1],
+                     -e2 + static_cast<int32_t>(q) - 1 + l) %
+          10;
+    }
+    if (q <= 9) {
+      // Only one of mp, mv, and mm can be a multiple of 5, if any.
+      if (mv % 5 == 0) {
+        vr_is_trailing_zeros = MultipleOfPowerOf5(mv, q);
+      } else if (accept_bounds) {
+        vm_is_trailing_zeros = MultipleOfPowerOf5(mm, q);
+      } else {
+        vp -= MultipleOfPowerOf5(mp, q);
+      }
+    }
+  } else {
+    const uint32_t q = Log10Pow5(-e2);
+    e10 = static_cast<int32_t>(q) + e2;
+    const int32_t i = -e2 - static_cast<int32_t>(q);
+    const int32_t k = Pow5Bits(i) - static_cast<int32_t>(kFloatPow5Bits);
+    int32_t j = static_cast<int32_t>(q) - k;
+    vr = MulShift32(mv, kFloatPow5Split[i], j);
+    vp = MulShift32(mp, kFloatPow5Split[i], j);
+    vm = MulShift32(mm, kFloatPow5Split[i], j);
+    if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+      j = static_cast<int32_t>(q) - 1 -
+          (Pow5Bits(i + 1) - static_cast<int32_t>(kFloatPow5Bits));
+      last_removed_digit = MulShift32(mv, kFloatPow5Split[i + 1], j) % 10;
+    }
+    if (q <= 1) {
+      // mv has at least q trailing 0 bits, since it is a multiple of 4.
+      vr_is_trailing_zeros = true;
+      if (accept_bounds) {
+        vm_is_trailing_zeros = mm_shift == 1;
+      } else {
+        --vp;
+      }
+    } else if (q < 31) {
+      vr_is_trailing_zeros = MultipleOfPowerOf2(mv, q - 1);
+    }
+  }
+
+  return Shorten(vr,
+                 vp,
+                 vm,
+                 e10,
+                 accept_bounds,
+                 vm_is_trailing_zeros,
+                 vr_is_trailing_zeros,
+                 last_removed_digit);
+}
+
+Decimal DoubleToDecimal(uint64_t ieee_mantissa, uint32_t ieee_exponent) {
+  using internal::ryu::kDoublePow5Bits;
+  using internal::ryu::kDoublePow5InvBits;
+  using internal::ryu::kDoublePow5InvSplit;
+  using internal::ryu::kDoublePow5Split;
+
+  constexpr int32_t kMantissaBits = 52;
+  constexpr int32_t kBias = 1023;
+
+  int32_t e2 = 0;
+  uint64_t m2 = 0;
+  if (ieee_exponent == 0) {
+    e2 = 1 - kBias - kMantissaBits - 2;
+    m2 = ieee_mantissa;
+  } else {
+    e2 = static_cast<int32_t>(ieee_exponent) - kBias - kMantissaBits - 2;
+    m2 = (uint64_t{1} << kMantissaBits) | ieee_mantissa;
+
+    // Integers below 2^53 are exact, so skip the search for the shortest
+    // digits and only strip trailing zeros.
+    const int32_t fraction_bits = -e2 - 2;
+    if (0 <= fraction_bits && fraction_bits <= kMantissaBits &&
+        (m2 & ((uint64_t{1} << fraction_bits) - 1)) == 0) {
+      Decimal decimal{m2 >> fraction_bits, 0};
+      while (decimal.digits % 10 == 0) {
+        decimal.digits /= 10;
+        ++decimal.exponent;
+      }
+      return decimal;
+    }
+  }
+  const bool accept_bounds = (m2 & 1) == 0;
+
+  const uint64_t mv = 4 * m2;
+  const uint32_t mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+
+  uint64_t vr = 0;
+  uint64_t vp = 0;
+  uint64_t vm = 0;
+  int32_t e10 = 0;
+  bool vm_is_trailing_zeros = false;
+  bool vr_is_trailing_zeros = false;
+
+  if (e2 >= 0) {
+    const uint32_t q = Log10Pow2(e2) - (e2 > 3);
+    e10 = static_cast<int32_t>(q);
+    const int32_t k = static_cast<int32_t>(kDoublePow5InvBits) +
+                      Pow5Bits(static_cast<int32_t>(q)) - 1;
+    const int32_t i = -e2 + static_cast<int32_t>(q) + k;
+    vr = MulShift64(mv, kDoublePow5InvSplit[q], i);
+    vp = MulShift64(mv + 2, kDoublePow5InvSplit[q], i);
+    vm = MulShift64(mv - 1 - mm_shift, kDoublePow5InvSplit[q], i);
+    if (q <= 21) {
+      // Only one of mp, mv, and mm can be a multiple of 5, if any.
+      if (mv % 5 == 0) {
+        vr_is_trailing_zeros = MultipleOfPowerOf5(mv, q);
+      } else if (accept_bounds) {
+        vm_is_trailing_zeros = MultipleOfPowerOf5(mv - 1 - mm_shift, q);
+      } else {
+        vp -= MultipleOfPowerOf5(mv + 2, q);
+      }
+    }
+  } else {
+    const uint32_t q = Log10Pow5(-e2) - (-e2 > 1);
+    e10 = static_cast<int32_t>(q) + e2;
+    const int32_t i = -e2 - static_cast<int32_t>(q);
+    const int32_t k = Pow5Bits(i) - static_cast<int32_t>(kDoublePow5Bits);
+    const int32_t j = static_cast<int32_t>(q) - k;
+    vr = MulShift64(mv, kDoublePow5Split[i], j);
+    vp = MulShift64(mv + 2, kDoublePow5Split[i], j);
+    vm = MulShift64(mv - 1 - mm_shift, kDoublePow5Split[i], j);
+    if (q <= 1) {
+      // mv has at least q trailing 0 bits, since it is a multiple of 4.
+      vr_is_trailing_zeros = true;
+      if (accept_bounds) {
+        vm_is_trailing_zeros = mm_shift == 1;
+      } else {
+        --vp;
+      }
+    } else if (q < 63) {
+      vr_is_trailing_zeros = MultipleOfPowerOf2(mv, q);
+    }
+  }
+
+  return Shorten(vr,
+                 vp,
+                 vm,
+                 e10,
+                 accept_bounds,
+                 vm_is_trailing_zeros,
+                 vr_is_trailing_zeros,
+                 0);
+}
+
+// Writes digits * 10^exponent in fixed or scientific notation, whichever is
+// shorter, preferring fixed notation.
+StatusWithSize DecimalToString(bool negative,
+                               const Decimal& decimal,
+                               span<char> buffer) {
+  const int32_t length = DecimalDigitCount(decimal.digits);
+  const int32_t exponent = decimal.exponent;
+
+  const int32_t scientific_exponent = exponent + length - 1;
+  const int32_t abs_scientific_exponent =
+      scientific_exponent < 0 ? -scientific_exponent : scientific_exponent;
+  const int32_t scientific_size = length + (length > 1 ? 1 : 0) + 2 +
+                                  (abs_scientific_exponent >= 100 ? 3 : 2);
+
+  int32_t fixed_size = 0;
+  if (exponent >= 0) {
+    fixed_size = length + exponent;  // digits and trailing zeros
+  } else if (length > -exponent) {
+    fixed_size = length + 1;  // digits with a decimal point
+  } else {
+    fixed_size = 2 - exponent;  // "0." then leading zeros and digits
+  }
+
+  const bool fixed = fixed_size <= scientific_size;
+  const size_t size =
+      static_cast<size_t>((fixed ? fixed_size : scientific_size) + negative);
+  if (size >= buffer.size()) {
+    return internal::HandleExhaustedBuffer(buffer);
+  }
+
+  std::array<char, 20> digits{};
+  internal::WriteDecimalDigits(decimal.digits, digits.data() + length);
+
+  char* out = buffer.data();
+  if (negative) {
+    *out++ = '-';
+  }
+
+  if (!fixed) {
+    *out++ = digits[0];
+    if (length > 1) {
+      *out++ = '.';
+      std::memcpy(out, &digits[1], static_cast<size_t>(length - 1));
+      out += length - 1;
+    }
+    *out++ = 'e';
+    *out++ = scientific_exponent < 0 ? '-' : '+';
+    uint32_t exponent_digits = static_cast<uint32_t>(abs_scientific_exponent);
+    if (exponent_digits >= 100) {
+      *out++ = static_cast<char>('0' + exponent_digits / 100);
+      exponent_digits %= 100;
+    }
+    internal::WriteDigitPair(exponent_digits, out);
+    out += 2;
+  } else if (exponent >= 0) {
+    std::memcpy(out, digits.data(), static_cast<size_t>(length));
+    out += length;
+    std::memset(out, '0', static_cast<size_t>(exponent));
+    out += exponent;
+  } else if (length > -exponent) {
+    const int32_t integer_digits = length + exponent;
+    std::memcpy(out, digits.data(), static_cast<size_t>(integer_digits));
+    out += integer_digits;
+    *out++ = '.';
+    std::memcpy(out,
+                &digits[static_cast<size_t>(integer_digits)],
+                static_cast<size_t>(-exponent));
+    out += -exponent;
+  } else {
+    *out++ = '0';
+    *out++ = '.';
+    std::memset(out, '0', static_cast<size_t>(-exponent - length));
+    out += -exponent - length;
+    std::memcpy(out, digits.data(), static_cast<size_t>(length));
+    out += length;
+  }
+
+  *out = '\0';
+  return StatusWithSize(size);
+}
+
+}  // namespace
 
 StatusWithSize IntToHexString(uint64_t value,
                               span<char> buffer,
@@ -33,9 +462,29 @@ StatusWithSize IntToHexString(uint64_t value,
     return internal::HandleExhaustedBuffer(buffer);
   }
 
-  for (int i = static_cast<int>(digits) - 1; i >= 0; --i) {
-    buffer[static_cast<size_t>(i)] = "0123456789abcdef"[value & 0xF];
-    value >>= 4;
+  // Convert eight nibbles at a time, and write the digits from the end. The
+  // lower eight digits are written with a single 8-byte copy.
+  char* const begin = buffer.data();
+  char* out = begin + digits;
+
+  // min_width may exceed the 16 digits of a 64-bit value.
+  char* const first_digit = digits > 16 ? out - 16 : begin;
+  std::fill(begin, first_digit, '0');
+
+  uint64_t hex = NibblesToHex(static_cast<uint32_t>(value));
+  if (out - first_digit >= 8) {
+    out -= 8;
+    if constexpr (cpp20::endian::native == cpp20::endian::little) {
+      const uint64_t big_endian = cpp23::byteswap(hex);
+      std::memcpy(out, &big_endian, sizeof(big_endian));
+    } else {
+      std::memcpy(out, &hex, sizeof(hex));
+    }
+    hex = NibblesToHex(static_cast<uint32_t>(value >> 32));
+  }
+  while (out != first_digit) {
+    *--out = static_cast<char>(hex);
+    hex >>= 8;
   }
 
   buffer[digits] = '\0';
@@ -52,16 +501,35 @@ StatusWithSize FloatAsIntToString(float value, span<char> buffer) {
   }
 
   // Otherwise, print inf or NaN, if they fit.
-  if (const size_t written = 3 + std::signbit(value); written < buffer.size()) {
-    char* out = buffer.data();
-    if (std::signbit(value)) {
-      *out++ = '-';
-    }
-    std::memcpy(out, std::isnan(value) ? "NaN" : "inf", sizeof("NaN"));
-    return StatusWithSize(written);
+  return NonFiniteToString(value, buffer);
+}
+
+StatusWithSize FloatToString(float value, span<char> buffer) {
+  if (!std::isfinite(value)) {
+    return NonFiniteToString(value, buffer);
+  }
+  const uint32_t bits = cpp20::bit_cast<uint32_t>(value);
+  const uint32_t mantissa = bits & ((uint32_t{1} << 23) - 1);
+  const uint32_t exponent = (bits >> 23) & 0xff;
+  if (mantissa == 0 && exponent == 0) {
+    return DecimalToString(std::signbit(value), Decimal{0, 0}, buffer);
   }
+  return DecimalToString(
+      std::signbit(value), FloatToDecimal(mantissa, exponent), buffer);
+}
 
-  return internal::HandleExhaustedBuffer(buffer);
+StatusWithSize DoubleToString(double value, span<char> buffer) {
+  if (!std::isfinite(value)) {
+    return NonFiniteToString(value, buffer);
+  }
+  const uint64_t bits = cpp20::bit_cast<uint64_t>(value);
+  const uint64_t mantissa = bits & ((uint64_t{1} << 52) - 1);
+  const uint32_t exponent = static_cast<uint32_t>(bits >> 52) & 0x7ff;
+  if (mantissa == 0 && exponent == 0) {
+    return DecimalToString(std::signbit(value), Decimal{0, 0}, buffer);
+  }
+  return DecimalToString(
+      std::signbit(value), DoubleToDecimal(mantissa, exponent), buffer);
 }
 
 StatusWithSize BoolToString(bool value, span<char> buffer) {
@@ -0,0 +1,121 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <cstdint>
+
+#include "pw_perf_test/perf_test.h"
+#include "pw_string/format.h"
+#include "pw_string/type_to_string.h"
+
+namespace pw::string {
+namespace {
+
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__clang__) || defined(__GNUC__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static_cast<void>(value);
+#endif
+}
+
+// Each benchmark converts a value with a pw_string function and, for
+// comparison, with the equivalent snprintf conversion.
+
+void Uint32ToString(perf_test::State& state, uint32_t value) {
+  char buffer[32];
+  while (state.KeepRunning()) {
+    DoNotOptimize(IntToString(value, buffer));
+  }
+}
+
+void Uint32Format(perf_test::State& state, uint32_t value) {
+  char buffer[32];
+  while (state.KeepRunning()) {
+    DoNotOptimize(Format(buffer, "%u", static_cast<unsigned>(value)));
+  }
+}
+
+void Int64ToString(perf_test::State& state, int64_t value) {
+  char buffer[32];
+  while (state.KeepRunning()) {
+    DoNotOptimize(IntToString(value, buffer));
+  }
+}
+
+void Int64Format(perf_test::State& state, int64_t value) {
+  char buffer[32];
+  while (state.KeepRunning()) {
+    DoNotOptimize(Format(buffer, "%lld", static_cast<long long>(value)));
+  }
+}
+
+void Uint64ToHexString(perf_test::State& state, uint64_t value) {
+  char buffer[32];
+  while (state.KeepRunning()) {
+    DoNotOptimize(IntToHexString(value, buffer));
+  }
+}
+
+void Uint64FormatHex(perf_test::State& state, uint64_t value) {
+  char buffer[32];
+  while (state.KeepRunning()) {
+    DoNotOptimize(
+        Format(buffer, "%llx", static_cast<unsigned long long>(value)));
+  }
+}
+
+void FloatToStringShortest(perf_test::State& state, float value) {
+  char buffer[32];
+  while (state.KeepRunning()) {
+    DoNotOptimize(FloatToString(value, buffer));
+  }
+}
+
+void FloatFormat(perf_test::State& state, float value) {
+  char buffer[32];
+  while (state.KeepRunning()) {
+    DoNotOptimize(Format(buffer, "%.9g", static_cast<double>(value)));
+  }
+}
+
+void DoubleToStringShortest(perf_test::State& state, double value) {
+  char buffer[32];
+  while (state.KeepRunning()) {
+    DoNotOptimize(DoubleToString(value, buffer));
+  }
+}
+
+void DoubleFormat(perf_test::State& state, double value) {
+  char buffer[32];
+  while (state.KeepRunning()) {
+    DoNotOptimize(Format(buffer, "%.17g", value));
+  }
+}
+
+PW_PERF_TEST(IntToString_Uint32, Uint32ToString, 3'141'592'653u);
+PW_PERF_TEST(Format_Uint32, Uint32Format, 3'141'592'653u);
+PW_PERF_TEST(IntToString_Int64, Int64ToString, -271'828'182'845'904'523);
+PW_PERF_TEST(Format_Int64, Int64Format, -271'828'182'845'904'523);
+PW_PERF_TEST(IntToHexString_Uint64,
+             Uint64ToHexString,
+             0x0123'4567'89ab'cdefu);
+PW_PERF_TEST(Format_Hex64, Uint64FormatHex, 0x0123'4567'89ab'cdefu);
+PW_PERF_TEST(FloatToString_Float, FloatToStringShortest, 0.15625f);
+PW_PERF_TEST(Format_Float, FloatFormat, 0.15625f);
+PW_PERF_TEST(DoubleToString_Double, DoubleToStringShortest, 1.0 / 3.0);
+PW_PERF_TEST(Format_Double, DoubleFormat, 1.0 / 3.0);
+
+}  // namespace
+}  // namespace pw::string
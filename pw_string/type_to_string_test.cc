@@ -15,6 +15,8 @@
 #include "pw_string/type_to_string.h"
 
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <limits>
 #include <string_view>
@@ -335,6 +337,135 @@ TEST_F(IntToHexStringTest, TooSmall_Truncates) {
   EXPECT_STREQ("", buffer_);
 }
 
+TEST_F(IntToHexStringTest, MinWidthWiderThan64Bits) {
+  char buffer[24] = {};
+  EXPECT_EQ(20u, IntToHexString(0xbeef, buffer, 20).size());
+  EXPECT_STREQ("0000000000000000beef", buffer);
+}
+
+TEST(FloatToString, Zero) {
+  char buffer[32] = {};
+  EXPECT_EQ(1u, FloatToString(0.0f, buffer).size());
+  EXPECT_STREQ("0", buffer);
+  EXPECT_EQ(2u, FloatToString(-0.0f, buffer).size());
+  EXPECT_STREQ("-0", buffer);
+}
+
+TEST(FloatToString, NonFinite) {
+  char buffer[32] = {};
+  EXPECT_EQ(3u, FloatToString(INFINITY, buffer).size());
+  EXPECT_STREQ("inf", buffer);
+  EXPECT_EQ(4u, FloatToString(-INFINITY, buffer).size());
+  EXPECT_STREQ("-inf", buffer);
+  EXPECT_EQ(3u, FloatToString(NAN, buffer).size());
+  EXPECT_STREQ("NaN", buffer);
+}
+
+TEST(FloatToString, ShortestDigits) {
+  char buffer[32] = {};
+  EXPECT_EQ(3u, FloatToString(0.1f, buffer).size());
+  EXPECT_STREQ("0.1", buffer);
+  EXPECT_EQ(6u, FloatToString(33.444f, buffer).size());
+  EXPECT_STREQ("33.444", buffer);
+  EXPECT_EQ(5u, FloatToString(-1.25f, buffer).size());
+  EXPECT_STREQ("-1.25", buffer);
+  EXPECT_EQ(10u, FloatToString(1.0f / 3.0f, buffer).size());
+  EXPECT_STREQ("0.33333334", buffer);
+  EXPECT_EQ(8u, FloatToString(16777216.0f, buffer).size());
+  EXPECT_STREQ("16777216", buffer);
+}
+
+TEST(FloatToString, ScientificWhenShorter) {
+  char buffer[32] = {};
+  EXPECT_EQ(8u, FloatToString(-1.5e-7f, buffer).size());
+  EXPECT_STREQ("-1.5e-07", buffer);
+  EXPECT_EQ(5u, FloatToString(1e10f, buffer).size());
+  EXPECT_STREQ("1e+10", buffer);
+  EXPECT_EQ(5u, FloatToString(1e-4f, buffer).size());
+  EXPECT_STREQ("1e-04", buffer);
+  EXPECT_EQ(5u, FloatToString(0.001f, buffer).size());
+  EXPECT_STREQ("0.001", buffer);
+}
+
+TEST(FloatToString, Limits) {
+  char buffer[32] = {};
+  EXPECT_TRUE(FloatToString(std::numeric_limits<float>::max(), buffer).ok());
+  EXPECT_STREQ("3.4028235e+38", buffer);
+  EXPECT_TRUE(
+      FloatToString(std::numeric_limits<float>::denorm_min(), buffer).ok());
+  EXPECT_STREQ("1e-45", buffer);
+}
+
+TEST(FloatToString, TooSmall_NullTerminates) {
+  char buffer[4] = {'?', '?', '?', '?'};
+  auto result = FloatToString(1.25f, buffer);
+  EXPECT_EQ(0u, result.size());
+  EXPECT_FALSE(result.ok());
+  EXPECT_STREQ("", buffer);
+}
+
+TEST(FloatToString, RoundTrips) {
+  char buffer[32] = {};
+  uint32_t bits = 1;
+  for (int i = 0; i < 10000; ++i) {
+    bits = bits * 1664525u + 1013904223u;
+    float value = 0;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (!std::isfinite(value)) {
+      continue;
+    }
+    ASSERT_TRUE(FloatToString(value, buffer).ok());
+    EXPECT_EQ(std::strtof(buffer, nullptr), value) << buffer;
+  }
+}
+
+TEST(DoubleToString, ShortestDigits) {
+  char buffer[32] = {};
+  EXPECT_EQ(3u, DoubleToString(0.1, buffer).size());
+  EXPECT_STREQ("0.1", buffer);
+  EXPECT_EQ(19u, DoubleToString(0.1 + 0.2, buffer).size());
+  EXPECT_STREQ("0.30000000000000004", buffer);
+  EXPECT_EQ(6u, DoubleToString(123456.0, buffer).size());
+  EXPECT_STREQ("123456", buffer);
+  EXPECT_EQ(8u, DoubleToString(-1200000.0, buffer).size());
+  EXPECT_STREQ("-1200000", buffer);
+  EXPECT_EQ(17u, DoubleToString(3.141592653589793, buffer).size());
+  EXPECT_STREQ("3.141592653589793", buffer);
+}
+
+TEST(DoubleToString, ScientificWhenShorter) {
+  char buffer[32] = {};
+  EXPECT_EQ(5u, DoubleToString(1e22, buffer).size());
+  EXPECT_STREQ("1e+22", buffer);
+  EXPECT_EQ(6u, DoubleToString(5e-324, buffer).size());
+  EXPECT_STREQ("5e-324", buffer);
+  EXPECT_TRUE(DoubleToString(std::numeric_limits<double>::max(), buffer).ok());
+  EXPECT_STREQ("1.7976931348623157e+308", buffer);
+}
+
+TEST(DoubleToString, NonFinite) {
+  char buffer[32] = {};
+  EXPECT_EQ(4u, DoubleToString(-INFINITY, buffer).size());
+  EXPECT_STREQ("-inf", buffer);
+  EXPECT_EQ(4u, DoubleToString(-NAN, buffer).size());
+  EXPECT_STREQ("-NaN", buffer);
+}
+
+TEST(DoubleToString, RoundTrips) {
+  char buffer[32] = {};
+  uint64_t bits = 1;
+  for (int i = 0; i < 10000; ++i) {
+    bits = bits * 6364136223846793005u + 1442695040888963407u;
+    double value = 0;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (!std::isfinite(value)) {
+      continue;
+    }
+    ASSERT_TRUE(DoubleToString(value, buffer).ok());
+    EXPECT_EQ(std::strtod(buffer, nullptr), value) << buffer;
+  }
+}
+
 class FloatAsIntToStringTest : public TestWithBuffer {};
 
 TEST_F(FloatAsIntToStringTest, PositiveInfinity) {
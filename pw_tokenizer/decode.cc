@@ -403,6 +403,7 @@ size_t DecodedFormatString::decoding_errors() const {
 }
 
 FormatString::FormatString(const char* format) {
+  std::vector<StringSegment> segments;
   const char* text_start = format;
 
   while (format[0] != '\0') {
@@ -410,7 +411,7 @@ FormatString::FormatString(const char* format) {
         !spec.empty()) {
       // Add the text segment seen so far (if any).
       if (text_start < format) {
-        segments_.emplace_back(std::string_view(
+        segments.emplace_back(std::string_view(
             text_start, static_cast<size_t>(format - text_start)));
       }
 
@@ -419,23 +420,26 @@ FormatString::FormatString(const char* format) {
       text_start = format;
 
       // Add the format specifier that was just found.
-      segments_.push_back(std::move(spec));
+      segments.push_back(std::move(spec));
     } else {
       format += 1;
     }
   }
 
   if (text_start < format) {
-    segments_.emplace_back(
+    segments.emplace_back(
         std::string_view(text_start, static_cast<size_t>(format - text_start)));
   }
+
+  segments_ =
+      std::make_shared<const std::vector<StringSegment>>(std::move(segments));
 }
 
 DecodedFormatString FormatString::Format(span<const uint8_t> arguments) const {
   std::vector<DecodedArg> results;
   bool skip = false;
 
-  for (const auto& segment : segments_) {
+  for (const auto& segment : *segments_) {
     if (skip) {
       results.push_back(segment.Skip());
     } else {
@@ -454,7 +458,7 @@ DecodedFormatString FormatString::Format(span<const uint8_t> arguments) const {
 
 std::string FormatString::text() const {
   std::string full_string;
-  for (const StringSegment& seg : segments_) {
+  for (const StringSegment& seg : *segments_) {
     full_string.append(seg.text());
   }
   return full_string;
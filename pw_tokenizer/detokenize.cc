@@ -18,10 +18,13 @@
 #include <cctype>
 #include <charconv>
 #include <cstring>
+#include <iterator>
+#include <memory>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include "pw_assert/assert.h"
 #include "pw_base64/base64.h"
 #include "pw_bytes/bit.h"
 #include "pw_bytes/endian.h"
@@ -48,10 +51,26 @@ constexpr bool IsValidBase16(char ch) {
          ('a' <= ch && ch <= 'f');
 }
 
+}  // namespace
+
+namespace internal {
+
+// Detokenize if there is an unambiguous match, or if there is only one match
+// that failed to decode because no argument data was provided.
+bool ShouldReplaceNestedMessage(const DetokenizedString& result,
+                                span<const std::byte> bytes) {
+  return result.ok() ||
+         (result.matches().size() == 1u && bytes.size() == sizeof(uint32_t));
+}
+
 class NestedMessageDetokenizer {
  public:
-  NestedMessageDetokenizer(const Detokenizer& detokenizer)
+  // If a CachingDetokenizer is provided, Base64 messages are detokenized with
+  // its cache.
+  NestedMessageDetokenizer(const Detokenizer& detokenizer,
+                           CachingDetokenizer* cache = nullptr)
       : detokenizer_(detokenizer),
+        cache_(cache),
         message_start_(0),
         domain_size_(0),
         data_start_(0) {}
@@ -146,10 +165,17 @@ class NestedMessageDetokenizer {
   }
 
   std::string Flush() {
+    std::string output;
+    Flush(output);
+    return output;
+  }
+
+  // Swaps the output into the provided string. The string's previous buffer is
+  // reused for the next output.
+  void Flush(std::string& output) {
     HandleEndOfMessage();
-    std::string output(std::move(output_));
+    output.swap(output_);
     output_.clear();
-    return output;
   }
 
  private:
@@ -277,9 +303,9 @@ class NestedMessageDetokenizer {
   void HandleEndOfMessageValidBase64() {
     std::string_view data(output_.data() + data_start_,
                           output_.size() - data_start_);
-    std::vector<std::byte> bytes(base64::DecodedSize(data));
-    base64::Decode(data, bytes.data());
-    DetokenizeOnceBase64(bytes);
+    decoded_.resize(base64::DecodedSize(data));
+    base64::Decode(data, decoded_.data());
+    DetokenizeOnceBase64(decoded_);
   }
 
   void DetokenizeOnce(uint32_t token) {
@@ -310,11 +336,15 @@ class NestedMessageDetokenizer {
   }
 
   void DetokenizeOnceBase64(span<const std::byte> bytes) {
-    // Detokenize if there is an unambiguous match, or if there is only one
-    // match that failed to decode because no argument data was provided.
-    if (auto result = detokenizer_.Detokenize(bytes, domain());
-        result.ok() ||
-        (result.matches().size() == 1u && bytes.size() == sizeof(uint32_t))) {
+    if (cache_ != nullptr) {
+      const std::string* replacement =
+          cache_->DetokenizeNested(bytes, domain());
+      if (replacement != nullptr) {
+        output_.replace(message_start_, output_.size(), *replacement);
+        output_changed_ = true;
+      }
+    } else if (auto result = detokenizer_.Detokenize(bytes, domain());
+               ShouldReplaceNestedMessage(result, bytes)) {
       output_.replace(message_start_, output_.size(), result.BestString());
       output_changed_ = true;
     }
@@ -329,7 +359,9 @@ class NestedMessageDetokenizer {
   }
 
   const Detokenizer& detokenizer_;
+  CachingDetokenizer* cache_;
   std::string output_;
+  std::vector<std::byte> decoded_;
   size_t message_start_;  // Index of the message prefix ($)
   size_t domain_size_;
   size_t data_start_;  // Index of the token data
@@ -350,6 +382,28 @@ class NestedMessageDetokenizer {
   bool output_changed_ = false;
 };
 
+// Runs the nested message detokenizer until the output stops changing.
+void DetokenizeNestedMessages(NestedMessageDetokenizer& detokenizer,
+                              std::string_view text,
+                              unsigned max_passes,
+                              std::string& result) {
+  detokenizer.Detokenize(text);
+  unsigned pass = 1;
+
+  while (true) {
+    detokenizer.Flush(result);
+    if (pass >= max_passes || !detokenizer.OutputChangedSinceLastCheck()) {
+      break;
+    }
+    detokenizer.Detokenize(result);
+    pass += 1;
+  }
+}
+
+}  // namespace internal
+
+namespace {
+
 std::string UnknownTokenMessage(uint32_t value) {
   std::string output(PW_TOKENIZER_ARG_DECODING_ERROR_PREFIX "unknown token ");
 
@@ -428,6 +482,20 @@ void AddEntryIfUnique(std::vector<TokenizedStringEntry>& entries,
   entries.emplace_back(std::move(format_string), date_removed);
 }
 
+void AddEntryIfUnique(std::vector<TokenizedStringEntry>& entries,
+                      const TokenizedStringEntry& new_entry) {
+  for (TokenizedStringEntry& entry : entries) {
+    if (new_entry.first == entry.first) {
+      if (new_entry.second > entry.second) {
+        entry.second = new_entry.second;
+      }
+      return;
+    }
+  }
+
+  entries.push_back(new_entry);  // Shares the FormatString's segments.
+}
+
 }  // namespace
 
 DetokenizedString::DetokenizedString(
@@ -625,6 +693,40 @@ Result<Detokenizer> Detokenizer::FromCsv(std::string_view csv) {
   return Detokenizer(std::move(database));
 }
 
+void Detokenizer::Merge(const Detokenizer& other) {
+  // Entries are added to database_, so the flattened layers are out of date.
+  if (!layers_.empty()) {
+    flattened_ = std::make_shared<Flattened>();
+  }
+
+  for (const auto& layer : other.layers_) {
+    Merge(*layer);
+  }
+
+  for (const auto& [domain, tokens] : other.database_) {
+    auto& domain_entries = database_[domain];
+    for (const auto& [token, entries] : tokens) {
+      auto [it, inserted] = domain_entries.try_emplace(token);
+      std::vector<TokenizedStringEntry>& token_entries = it->second;
+      if (inserted) {
+        // Start from the layers' entries, so this token's entries here are
+        // complete and hide the older ones.
+        for (auto layer = layers_.rbegin(); layer != layers_.rend(); ++layer) {
+          const span<const TokenizedStringEntry> older =
+              (*layer)->Find(token, domain);
+          if (!older.empty()) {
+            token_entries.assign(older.begin(), older.end());
+            break;
+          }
+        }
+      }
+      for (const TokenizedStringEntry& entry : entries) {
+        AddEntryIfUnique(token_entries, entry);
+      }
+    }
+  }
+}
+
 DetokenizedString Detokenizer::Detokenize(const span<const std::byte>& encoded,
                                           std::string_view domain,
                                           bool recursion) const {
@@ -654,6 +756,31 @@ DetokenizedString Detokenizer::DetokenizeBase64Message(
   return Detokenize(buffer);
 }
 
+const DomainTokenEntriesMap& Detokenizer::database() const {
+  if (layers_.empty()) {
+    return database_;
+  }
+
+  std::call_once(flattened_->once, [this] {
+    // Newer layers hold all of the entries for their tokens, so each layer's
+    // tokens replace those of the older layers.
+    DomainTokenEntriesMap& flattened = flattened_->database;
+    const auto add = [&flattened](const DomainTokenEntriesMap& database) {
+      for (const auto& [domain, tokens] : database) {
+        auto& domain_entries = flattened[domain];
+        for (const auto& [token, entries] : tokens) {
+          domain_entries[token] = entries;
+        }
+      }
+    };
+    for (const auto& layer : layers_) {
+      add(layer->database());
+    }
+    add(database_);
+  });
+  return flattened_->database;
+}
+
 span<const TokenizedStringEntry> Detokenizer::DatabaseLookup(
     uint32_t token, std::string_view domain) const {
   std::string canonical_domain;
@@ -663,34 +790,34 @@ span<const TokenizedStringEntry> Detokenizer::DatabaseLookup(
     }
   }
 
-  auto domain_it = database_.find(canonical_domain);
-  if (domain_it == database_.end()) {
-    return span<TokenizedStringEntry>();
-  }
-  auto token_it = domain_it->second.find(token);
-  if (token_it == domain_it->second.end()) {
-    return span<TokenizedStringEntry>();
+  return Find(token, canonical_domain);
+}
+
+span<const TokenizedStringEntry> Detokenizer::Find(
+    Token token, const std::string& domain) const {
+  auto domain_it = database_.find(domain);
+  if (domain_it != database_.end()) {
+    auto token_it = domain_it->second.find(token);
+    if (token_it != domain_it->second.end()) {
+      return span(token_it->second);
+    }
   }
 
-  return span(token_it->second);
+  for (auto layer = layers_.rbegin(); layer != layers_.rend(); ++layer) {
+    const span<const TokenizedStringEntry> entries =
+        (*layer)->Find(token, domain);
+    if (!entries.empty()) {
+      return entries;
+    }
+  }
+  return span<TokenizedStringEntry>();
 }
 
 std::string Detokenizer::DetokenizeTextRecursive(std::string_view text,
                                                  unsigned max_passes) const {
-  NestedMessageDetokenizer detokenizer(*this);
-  detokenizer.Detokenize(text);
-
+  internal::NestedMessageDetokenizer detokenizer(*this);
   std::string result;
-  unsigned pass = 1;
-
-  while (true) {
-    result = detokenizer.Flush();
-    if (pass >= max_passes || !detokenizer.OutputChangedSinceLastCheck()) {
-      break;
-    }
-    detokenizer.Detokenize(result);
-    pass += 1;
-  }
+  internal::DetokenizeNestedMessages(detokenizer, text, max_passes, result);
   return result;
 }
 
@@ -742,4 +869,132 @@ std::string Detokenizer::DecodeOptionallyTokenizedData(
   return std::string{base64_encoding_buffer.data(), encoded_length};
 }
 
+void ReloadableDetokenizer::Replace(Detokenizer&& detokenizer) {
+  auto updated = std::make_shared<const Detokenizer>(std::move(detokenizer));
+
+  std::lock_guard update_lock(update_lock_);
+  std::lock_guard lock(current_lock_);
+  current_.swap(updated);
+  // The old Detokenizer is released outside of current_lock_ when updated
+  // goes out of scope, unless a reader still holds it.
+}
+
+void ReloadableDetokenizer::Merge(const Detokenizer& other) {
+  std::lock_guard update_lock(update_lock_);
+
+  const std::shared_ptr<const Detokenizer> current = snapshot();
+  std::vector<std::shared_ptr<const Detokenizer>> layers;
+  if (current->database_.empty() && !current->layers_.empty()) {
+    layers = current->layers_;
+  } else {
+    layers.push_back(current);
+  }
+
+  // Merging into a Detokenizer that reads the existing layers copies only the
+  // entries for the tokens in other. Their strings are shared, not copied.
+  Detokenizer added{std::vector(layers)};
+  added.Merge(other);
+  layers.push_back(
+      std::make_shared<const Detokenizer>(std::move(added.database_)));
+
+  std::shared_ptr<const Detokenizer> published;
+  if (layers.size() > kMaxLayers) {
+    auto compacted = std::make_shared<Detokenizer>(DomainTokenEntriesMap());
+    for (const auto& layer : layers) {
+      compacted->Merge(*layer);
+    }
+    published = std::move(compacted);
+  } else {
+    // The constructor is private, so std::make_shared cannot call it.
+    published.reset(new Detokenizer(std::move(layers)));
+  }
+
+  std::lock_guard lock(current_lock_);
+  current_.swap(published);
+}
+
+CachingDetokenizer::CachingDetokenizer(const Detokenizer& detokenizer,
+                                       size_t capacity)
+    : detokenizer_(detokenizer),
+      capacity_(capacity),
+      nested_(std::make_unique<internal::NestedMessageDetokenizer>(detokenizer,
+                                                                    this)) {
+  PW_ASSERT(capacity > 0u);
+  index_.reserve(capacity);
+}
+
+CachingDetokenizer::~CachingDetokenizer() = default;
+
+std::string_view CachingDetokenizer::Detokenize(span<const std::byte> encoded,
+                                                std::string_view domain) {
+  bool found;
+  Entry& entry = FindOrInsert(kMessage, encoded, domain, found);
+  if (!found) {
+    entry.value =
+        detokenizer_.RecursiveDetokenize(encoded, domain).BestString();
+    entry.detokenized = true;
+  }
+  return entry.value;
+}
+
+std::string_view CachingDetokenizer::DetokenizeText(std::string_view text) {
+  internal::DetokenizeNestedMessages(
+      *nested_, text, Detokenizer::kMaxDecodePasses, text_);
+  return text_;
+}
+
+void CachingDetokenizer::Clear() {
+  index_.clear();
+  entries_.clear();
+}
+
+const std::string* CachingDetokenizer::DetokenizeNested(
+    span<const std::byte> encoded, std::string_view domain) {
+  bool found;
+  Entry& entry = FindOrInsert(kNestedMessage, encoded, domain, found);
+  if (!found) {
+    DetokenizedString result = detokenizer_.Detokenize(encoded, domain);
+    entry.detokenized = internal::ShouldReplaceNestedMessage(result, encoded);
+    entry.value = result.BestString();
+  }
+  return entry.detokenized ? &entry.value : nullptr;
+}
+
+CachingDetokenizer::Entry& CachingDetokenizer::FindOrInsert(
+    KeyType type,
+    span<const std::byte> encoded,
+    std::string_view domain,
+    bool& found) {
+  // The key is the type, the domain, and the encoded data. The domain cannot
+  // contain a null character, so it is used as a separator.
+  key_.clear();
+  key_.push_back(type);
+  key_.append(domain);
+  key_.push_back('\0');
+  key_.append(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+
+  if (auto it = index_.find(key_); it != index_.end()) {
+    entries_.splice(entries_.begin(), entries_, it->second);
+    hits_ += 1;
+    found = true;
+    return entries_.front();
+  }
+
+  misses_ += 1;
+  found = false;
+
+  if (entries_.size() < capacity_) {
+    entries_.emplace_front();
+  } else {
+    // Reuse the least recently used entry, including its string buffers.
+    index_.erase(entries_.back().key);
+    entries_.splice(entries_.begin(), entries_, std::prev(entries_.end()));
+  }
+
+  Entry& entry = entries_.front();
+  entry.key.assign(key_);
+  index_.emplace(entry.key, entries_.begin());
+  return entry;
+}
+
 }  // namespace pw::tokenizer
@@ -121,5 +121,60 @@ PW_PERF_TEST(DetokenizeText_TwoMessages,
              "What the $qqqqqvwB, $Dg8AAQQEdGhlbQ==",
              "What the ~!, Now there are 2 of them!");
 
+void CachingDetokenize(perf_test::State& state,
+                       span<const std::byte> data,
+                       std::string_view expected) {
+  Detokenizer detokenizer(kDatabase);
+  CachingDetokenizer cache(detokenizer, 16);
+
+  std::string_view result = cache.Detokenize(data);
+
+  while (state.KeepRunning()) {
+    result = cache.Detokenize(data);
+  }
+
+  PW_CHECK(result == expected);
+}
+
+PW_PERF_TEST(CachingDetokenize_OneArg,
+             CachingDetokenize,
+             bytes::String("\xAA\xAA\xAA\xAA\xfc\x01"),
+             "~!");
+
+PW_PERF_TEST(CachingDetokenize_TwoArgs1,
+             CachingDetokenize,
+             bytes::String("\x0E\x0F\x00\x01\x04\x04them"),
+             "Now there are 2 of them!");
+
+void CachingDetokenizeText(perf_test::State& state,
+                           std::string_view text,
+                           std::string_view expected) {
+  Detokenizer detokenizer(kDatabase);
+  CachingDetokenizer cache(detokenizer, 16);
+
+  std::string_view result = cache.DetokenizeText(text);
+
+  while (state.KeepRunning()) {
+    result = cache.DetokenizeText(text);
+  }
+
+  PW_CHECK(result == expected);
+}
+
+PW_PERF_TEST(CachingDetokenizeText_NoMessage,
+             CachingDetokenizeText,
+             "Nothing!!",
+             "Nothing!!");
+
+PW_PERF_TEST(CachingDetokenizeText_OneArg,
+             CachingDetokenizeText,
+             "$qqqqqvwB",
+             "~!");
+
+PW_PERF_TEST(CachingDetokenizeText_TwoMessages,
+             CachingDetokenizeText,
+             "What the $qqqqqvwB, $Dg8AAQQEdGhlbQ==",
+             "What the ~!, Now there are 2 of them!");
+
 }  // namespace
 }  // namespace pw::tokenizer
@@ -173,6 +173,154 @@ TEST(DetokenizeFromCsv, DuplicateEntriesUsesNewestRemovalDate) {
   EXPECT_EQ((date & 0x000000FF) >> 0, 1u);
 }
 
+constexpr const char kCsvVersion1[] =
+    "1,,,Hello World!\n"
+    "2,,domain,Old\n";
+
+constexpr const char kCsvVersion2[] =
+    "1,2002-01-01,,Hello World!\n"
+    "2,,domain,New\n"
+    "3,,,Goodbye!\n";
+
+TEST(DetokenizerMerge, AddsNewEntriesAndDomains) {
+  pw::Result<Detokenizer> detok = Detokenizer::FromCsv(kCsvDefaultDomain);
+  PW_TEST_ASSERT_OK(detok);
+  pw::Result<Detokenizer> other = Detokenizer::FromCsv(kCsvVersion2);
+  PW_TEST_ASSERT_OK(other);
+
+  detok->Merge(*other);
+
+  EXPECT_EQ(detok->Detokenize("\1\0\0\0"sv).BestString(), "Hello World!");
+  EXPECT_EQ(detok->database().at("").at(3).size(), 2u);
+  EXPECT_EQ(detok->Detokenize("\2\0\0\0"sv, "domain").BestString(), "New");
+}
+
+TEST(DetokenizerMerge, DuplicatesAreShared) {
+  pw::Result<Detokenizer> detok = Detokenizer::FromCsv(kCsvVersion1);
+  PW_TEST_ASSERT_OK(detok);
+  pw::Result<Detokenizer> other = Detokenizer::FromCsv(kCsvVersion2);
+  PW_TEST_ASSERT_OK(other);
+
+  const StringSegment* original =
+      detok->database().at("").at(1).front().first.segments().data();
+  detok->Merge(*other);
+
+  const auto& entries = detok->database().at("").at(1);
+  ASSERT_EQ(entries.size(), 1u);
+  EXPECT_EQ(entries.front().first.segments().data(), original);
+  EXPECT_EQ(entries.front().second, TokenDatabase::kDateRemovedNever)
+      << "Uses the newest removal date";
+
+  const auto& collisions = detok->database().at("domain").at(2);
+  const auto& added = other->database().at("domain").at(2);
+  ASSERT_EQ(collisions.size(), 2u);
+  EXPECT_EQ(collisions[1].first.segments().data(),
+            added.front().first.segments().data())
+      << "New entries share strings with the merged database";
+}
+
+TEST(ReloadableDetokenizer, SnapshotsAreNotAffectedByUpdates) {
+  pw::Result<Detokenizer> version_1 = Detokenizer::FromCsv(kCsvVersion1);
+  PW_TEST_ASSERT_OK(version_1);
+  ReloadableDetokenizer detok(std::move(*version_1));
+
+  std::shared_ptr<const Detokenizer> before = detok.snapshot();
+
+  pw::Result<Detokenizer> version_2 = Detokenizer::FromCsv(kCsvVersion2);
+  PW_TEST_ASSERT_OK(version_2);
+  detok.Merge(*version_2);
+
+  std::shared_ptr<const Detokenizer> merged = detok.snapshot();
+  EXPECT_NE(before, merged);
+  EXPECT_TRUE(before->Detokenize("\3\0\0\0"sv).BestString().empty());
+  EXPECT_EQ(merged->Detokenize("\3\0\0\0"sv).BestString(), "Goodbye!");
+  EXPECT_EQ(merged->DatabaseLookup(1, "").front().first.segments().data(),
+            before->DatabaseLookup(1, "").front().first.segments().data())
+      << "Snapshots share strings";
+
+  detok.Replace(Detokenizer(TokenDatabase::Create<kTestDatabase>()));
+  EXPECT_TRUE(detok.snapshot()->Detokenize("\3\0\0\0"sv).BestString().empty());
+  EXPECT_EQ(merged->Detokenize("\3\0\0\0"sv).BestString(), "Goodbye!");
+}
+
+TEST(ReloadableDetokenizer, LayersMatchDetokenizerMerge) {
+  pw::Result<Detokenizer> version_1 = Detokenizer::FromCsv(kCsvVersion1);
+  PW_TEST_ASSERT_OK(version_1);
+  pw::Result<Detokenizer> version_2 = Detokenizer::FromCsv(kCsvVersion2);
+  PW_TEST_ASSERT_OK(version_2);
+
+  Detokenizer expected = *version_1;
+  ReloadableDetokenizer detok(std::move(*version_1));
+
+  // Merge enough times to compact the layers, checking each snapshot.
+  for (size_t i = 0; i < ReloadableDetokenizer::kMaxLayers + 2; ++i) {
+    const std::string csv = std::to_string(100 + i) + ",,,Version " +
+                            std::to_string(i) + "\n" + "2,,domain,Collision " +
+                            std::to_string(i) + "\n";
+    pw::Result<Detokenizer> version = Detokenizer::FromCsv(csv);
+    PW_TEST_ASSERT_OK(version);
+
+    detok.Merge(i == 0 ? *version_2 : *version);
+    expected.Merge(i == 0 ? *version_2 : *version);
+
+    std::shared_ptr<const Detokenizer> snapshot = detok.snapshot();
+    for (Token token : {1u, 3u, 100u, 100u + static_cast<uint32_t>(i)}) {
+      EXPECT_EQ(snapshot->DatabaseLookup(token, "").size(),
+                expected.DatabaseLookup(token, "").size());
+    }
+    const auto collisions = snapshot->DatabaseLookup(2, "domain");
+    const auto expected_collisions = expected.DatabaseLookup(2, "domain");
+    ASSERT_EQ(collisions.size(), expected_collisions.size());
+    for (size_t j = 0; j < collisions.size(); ++j) {
+      EXPECT_EQ(collisions[j].first, expected_collisions[j].first);
+    }
+  }
+
+  EXPECT_EQ(detok.snapshot()->DatabaseLookup(1, "").front().second,
+            TokenDatabase::kDateRemovedNever)
+      << "Uses the newest removal date";
+  EXPECT_EQ(detok.snapshot()->Detokenize("\3\0\0\0"sv).BestString(),
+            "Goodbye!");
+}
+
+TEST(ReloadableDetokenizer, DatabaseFlattensLayers) {
+  pw::Result<Detokenizer> version_1 = Detokenizer::FromCsv(kCsvVersion1);
+  PW_TEST_ASSERT_OK(version_1);
+  pw::Result<Detokenizer> version_2 = Detokenizer::FromCsv(kCsvVersion2);
+  PW_TEST_ASSERT_OK(version_2);
+  pw::Result<Detokenizer> version_3 =
+      Detokenizer::FromCsv("4,,,Added\n2,,domain,Newest\n");
+  PW_TEST_ASSERT_OK(version_3);
+
+  Detokenizer expected = *version_1;
+  ReloadableDetokenizer detok(std::move(*version_1));
+  detok.Merge(*version_2);
+  detok.Merge(*version_3);
+  expected.Merge(*version_2);
+  expected.Merge(*version_3);
+
+  std::shared_ptr<const Detokenizer> snapshot = detok.snapshot();
+  const DomainTokenEntriesMap& database = snapshot->database();
+  EXPECT_EQ(&database, &snapshot->database()) << "Flattened once";
+
+  ASSERT_EQ(database.size(), expected.database().size());
+  size_t entry_count = 0;
+  for (const auto& [domain, tokens] : database) {
+    const auto& expected_tokens = expected.database().at(domain);
+    ASSERT_EQ(tokens.size(), expected_tokens.size());
+    for (const auto& [token, entries] : tokens) {
+      const auto& expected_entries = expected_tokens.at(token);
+      ASSERT_EQ(entries.size(), expected_entries.size());
+      for (size_t i = 0; i < entries.size(); ++i) {
+        EXPECT_EQ(entries[i].first, expected_entries[i].first);
+        EXPECT_EQ(entries[i].second, expected_entries[i].second);
+      }
+      entry_count += entries.size();
+    }
+  }
+  EXPECT_EQ(entry_count, 6u);
+}
+
 class Detokenize : public ::testing::Test {
  protected:
   Detokenize() : detok_(TokenDatabase::Create<kTestDatabase>()) {}
@@ -454,6 +602,99 @@ TEST_F(Detokenize, DetokenizeText_InvalidLengthTokens) {
   EXPECT_EQ(detok_csv->DetokenizeText("$10#0000010010"), "$10#0000010010");
 }
 
+span<const std::byte> AsBytes(std::string_view data) {
+  return as_bytes(span(data));
+}
+
+class CachingDetokenize : public DetokenizeWithArgs {
+ protected:
+  CachingDetokenize() : cache_(detok_, 2) {}
+
+  CachingDetokenizer cache_;
+};
+
+TEST_F(CachingDetokenize, Detokenize_MatchesDetokenizer) {
+  EXPECT_EQ(cache_.Detokenize(AsBytes("\x0E\x0F\x00\x01\x04\x04them"sv)),
+            "Now there are 2 of them!");
+  EXPECT_EQ(cache_.Detokenize(AsBytes("\x23\xab\xc9\x87"sv)), "");
+  EXPECT_EQ(cache_.Detokenize(AsBytes("\x0A\x0B\x0C\x0D\5force"sv)),
+            "Use the force, %s.");
+  EXPECT_EQ(cache_.hits(), 0u);
+  EXPECT_EQ(cache_.misses(), 3u);
+}
+
+TEST_F(CachingDetokenize, Detokenize_RepeatedMessagesAreCached) {
+  const auto message = AsBytes("\x0E\x0F\x00\x01\x04\x04them"sv);
+  EXPECT_EQ(cache_.Detokenize(message), "Now there are 2 of them!");
+  EXPECT_EQ(cache_.Detokenize(message), "Now there are 2 of them!");
+  EXPECT_EQ(cache_.Detokenize(AsBytes("\x0E\x0F\x00\x01\x06\x04them"sv)),
+            "Now there are 3 of them!");
+  EXPECT_EQ(cache_.hits(), 1u);
+  EXPECT_EQ(cache_.misses(), 2u);
+  EXPECT_EQ(cache_.size(), 2u);
+}
+
+TEST_F(CachingDetokenize, Detokenize_DomainIsPartOfKey) {
+  const auto message = AsBytes("\xAA\xAA\xAA\xAA\xfc\x01"sv);
+  EXPECT_EQ(cache_.Detokenize(message), "~!");
+  EXPECT_EQ(cache_.Detokenize(message, "other"), "");
+  EXPECT_EQ(cache_.misses(), 2u);
+}
+
+TEST_F(CachingDetokenize, Detokenize_EvictsLeastRecentlyUsed) {
+  const auto first = AsBytes("\xAA\xAA\xAA\xAA\xfc\x01"sv);
+  const auto second = AsBytes("\xBB\xBB\xBB\xBB\x04"sv);
+  const auto third = AsBytes("\xCC\xCC\xCC\xCC\x08"sv);
+
+  EXPECT_EQ(cache_.Detokenize(first), "~!");
+  EXPECT_EQ(cache_.Detokenize(second), "2!");
+  EXPECT_EQ(cache_.Detokenize(first), "~!");   // first is most recently used
+  EXPECT_EQ(cache_.Detokenize(third), "4!");   // evicts second
+  EXPECT_EQ(cache_.Detokenize(first), "~!");   // hit
+  EXPECT_EQ(cache_.Detokenize(second), "2!");  // miss
+  EXPECT_EQ(cache_.hits(), 2u);
+  EXPECT_EQ(cache_.misses(), 4u);
+  EXPECT_EQ(cache_.size(), 2u);
+}
+
+TEST_F(CachingDetokenize, DetokenizeText_NestedMessagesAreCached) {
+  EXPECT_EQ(cache_.DetokenizeText("What the $qqqqqvwB, $Dg8AAQQEdGhlbQ=="),
+            "What the ~!, Now there are 2 of them!");
+  EXPECT_EQ(cache_.misses(), 2u);
+
+  EXPECT_EQ(cache_.DetokenizeText("12:00 $Dg8AAQQEdGhlbQ=="),
+            "12:00 Now there are 2 of them!");
+  EXPECT_EQ(cache_.hits(), 1u);
+
+  // The unknown message is cached too. It evicts $qqqqqvwB, which is then
+  // detokenized again.
+  EXPECT_EQ(cache_.DetokenizeText("Unknown $AAAAAQ== $qqqqqvwB"),
+            "Unknown $AAAAAQ== ~!");
+  EXPECT_EQ(cache_.DetokenizeText("No messages"), "No messages");
+  EXPECT_EQ(cache_.hits(), 2u);  // $AAAAAQ== on the second pass
+  EXPECT_EQ(cache_.misses(), 4u);
+}
+
+TEST_F(CachingDetokenize, DetokenizeText_Recursive) {
+  pw::Result<Detokenizer> detok_csv = Detokenizer::FromCsv(kCsvNestedBase64Arg);
+  PW_TEST_ASSERT_OK(detok_csv);
+  CachingDetokenizer cache(*detok_csv, 4);
+
+  EXPECT_EQ(cache.DetokenizeText("> $AgAAAA=="), "> This is a base64 argument");
+  EXPECT_EQ(cache.DetokenizeText("> $AgAAAA=="), "> This is a base64 argument");
+  EXPECT_EQ(cache.misses(), 2u);
+  EXPECT_EQ(cache.hits(), 2u);
+}
+
+TEST_F(CachingDetokenize, Clear) {
+  const auto message = AsBytes("\xAA\xAA\xAA\xAA\xfc\x01"sv);
+  EXPECT_EQ(cache_.Detokenize(message), "~!");
+  cache_.Clear();
+  EXPECT_EQ(cache_.size(), 0u);
+  EXPECT_EQ(cache_.Detokenize(message), "~!");
+  EXPECT_EQ(cache_.misses(), 2u);
+}
+
 TEST_F(DetokenizeWithArgs, ExtraDataError) {
   auto error = detok_.Detokenize("\x00\x00\x00\x00MORE data"sv);
   EXPECT_FALSE(error.ok());
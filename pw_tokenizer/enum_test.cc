@@ -14,6 +14,10 @@
 
 #include "pw_tokenizer/enum.h"
 
+#include <optional>
+#include <string_view>
+#include <tuple>
+
 #include "pw_compilation_testing/negative_compilation.h"
 #include "pw_unit_test/framework.h"
 
@@ -94,6 +98,130 @@ TEST(TokenizeEnums, BadEnumValue) {
                PwEnumToString(static_cast<Thing>(-100)));
 }
 
+// Sparse values, including negative values, cannot be looked up by indexing.
+enum class SparseThing : int32_t {
+  kTango = -7,
+  kUniform = 0,
+  kVictor = 1000,
+  kWhiskey = 0x7fffffff,
+};
+
+PW_TOKENIZE_ENUM(::this_is_a_test::SparseThing,
+                 kTango,
+                 kUniform,
+                 kVictor,
+                 kWhiskey);
+
+enum class BigThing : uint16_t {
+  k00 = 3, k01 = 17, k02 = 60, k03 = 61, k04 = 255, k05 = 256, k06 = 1024,
+  k07 = 2048, k08 = 9999, k09 = 12345, k10 = 40000, k11 = 65535
+};
+
+PW_TOKENIZE_ENUM(::this_is_a_test::BigThing,
+                 k00,
+                 k01,
+                 k02,
+                 k03,
+                 k04,
+                 k05,
+                 k06,
+                 k07,
+                 k08,
+                 k09,
+                 k10,
+                 k11);
+
+TEST(TokenizeEnums, EnumFromToken) {
+  constexpr std::optional<Thing> value =
+      pw::tokenizer::EnumFromToken<Thing>(1);
+  static_assert(value == kBravo);
+
+  EXPECT_EQ(pw::tokenizer::EnumFromToken<ScopedThing>(2), ScopedThing::kMike);
+  EXPECT_EQ(pw::tokenizer::EnumFromToken<OneThing>(0), kGolf);
+  EXPECT_EQ(pw::tokenizer::EnumFromToken<Thing>(3), std::nullopt);
+  EXPECT_EQ(pw::tokenizer::EnumFromToken<OneThing>(1), std::nullopt);
+}
+
+TEST(TokenizeEnums, EnumFromToken_Sparse) {
+  for (SparseThing value : {SparseThing::kTango,
+                            SparseThing::kUniform,
+                            SparseThing::kVictor,
+                            SparseThing::kWhiskey}) {
+    EXPECT_EQ(pw::tokenizer::EnumFromToken<SparseThing>(
+                  pw::tokenizer::EnumToToken(value)),
+              value);
+  }
+  EXPECT_EQ(pw::tokenizer::EnumFromToken<SparseThing>(7), std::nullopt);
+  EXPECT_EQ(pw::tokenizer::EnumFromToken<SparseThing>(999), std::nullopt);
+}
+
+TEST(TokenizeEnums, EnumFromToken_ManyValues) {
+  size_t found = 0;
+  for (uint32_t token = 0; token <= 0x10000; ++token) {
+    const std::optional<BigThing> value =
+        pw::tokenizer::EnumFromToken<BigThing>(token);
+    if (value.has_value()) {
+      EXPECT_EQ(pw::tokenizer::EnumToToken(*value), token);
+      found += 1;
+    }
+  }
+  EXPECT_EQ(found, 12u);
+}
+
+TEST(TokenizeEnums, EnumTokenToString) {
+  static_assert(pw::tokenizer::EnumTokenToString<Thing>(2) ==
+                std::string_view("kCharlie"));
+  EXPECT_STREQ(pw::tokenizer::EnumTokenToString<Thing2>(1), "ECHO");
+  EXPECT_STREQ(pw::tokenizer::EnumTokenToString<SparseThing>(
+                   pw::tokenizer::EnumToToken(SparseThing::kTango)),
+               "kTango");
+  EXPECT_STREQ(pw::tokenizer::EnumTokenToString<BigThing>(12345), "k09");
+  EXPECT_EQ(pw::tokenizer::EnumTokenToString<Thing>(100), nullptr);
+}
+
+TEST(TokenizeEnums, EnumFromString) {
+  static_assert(pw::tokenizer::EnumFromString<Thing>("kAlpha") == kAlpha);
+  EXPECT_EQ(pw::tokenizer::EnumFromString<ScopedThing>("kLima"),
+            ScopedThing::kLima);
+  EXPECT_EQ(pw::tokenizer::EnumFromString<SparseThing>("kWhiskey"),
+            SparseThing::kWhiskey);
+  EXPECT_EQ(pw::tokenizer::EnumFromString<BigThing>("k11"), BigThing::k11);
+  EXPECT_EQ(pw::tokenizer::EnumFromString<Thing>("kDelta"), std::nullopt);
+  EXPECT_EQ(pw::tokenizer::EnumFromString<Thing>(""), std::nullopt);
+  EXPECT_EQ(pw::tokenizer::EnumFromString<Thing>("kAlph"), std::nullopt);
+}
+
+TEST(TokenizeEnums, EnumFromString_Custom) {
+  EXPECT_EQ(pw::tokenizer::EnumFromString<Thing2>("FOXTROT"), kFoxtrot);
+  EXPECT_EQ(pw::tokenizer::EnumFromString<ScopedThing2>("KILO"),
+            ScopedThing2::kKilo);
+  EXPECT_EQ(pw::tokenizer::EnumFromString<ScopedThing2>("kKilo"),
+            std::nullopt);
+}
+
+enum class DuplicateStringThing { kXray, kYankee, kZulu };
+
+PW_TOKENIZE_ENUM_CUSTOM(::this_is_a_test::DuplicateStringThing,
+                        (kXray, "X"),
+                        (kYankee, "X"),
+                        (kZulu, "Z"));
+
+[[maybe_unused]] void LookUpEnumWithDuplicateStrings() {
+#if PW_NC_TEST(LookUpEnumWithDuplicateStrings)
+  PW_NC_EXPECT("Enumerator values and strings must be unique");
+
+  std::ignore = pw::tokenizer::EnumFromString<DuplicateStringThing>("Z");
+#endif  // PW_NC_TEST
+}
+
+[[maybe_unused]] void LookUpNonTokenizedEnum() {
+#if PW_NC_TEST(LookUpNonTokenizedEnum)
+  PW_NC_EXPECT("PwEnumEntries");
+
+  std::ignore = pw::tokenizer::EnumFromToken<NonTokenizedThing>(1);
+#endif  // PW_NC_TEST
+}
+
 }  // namespace
 
 [[maybe_unused]] void TokenizeInDifferentNamespace() {
@@ -26,7 +26,11 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -43,6 +47,13 @@ namespace pw::tokenizer {
 /// @submodule{pw_tokenizer,detokenize}
 
 class Detokenizer;
+class CachingDetokenizer;
+
+namespace internal {
+
+class NestedMessageDetokenizer;
+
+}  // namespace internal
 
 /// Token database entry.
 using TokenizedStringEntry = std::pair<FormatString, uint32_t /*date removed*/>;
@@ -207,12 +218,44 @@ class Detokenizer {
   std::string DecodeOptionallyTokenizedData(
       span<const std::byte> optionally_tokenized_data) const;
 
-  const DomainTokenEntriesMap& database() const { return database_; }
+  /// Adds the entries from another detokenizer's database to this one, such as
+  /// the database for a new firmware version. Only the entries in `other` are
+  /// visited; the existing database is not rebuilt.
+  ///
+  /// Strings that are already present for a token are not added again; their
+  /// removal date is updated to the later of the two dates. New entries share
+  /// their string data with `other`, so merging does not copy strings.
+  void Merge(const Detokenizer& other);
+
+  /// All of the `Detokenizer`'s entries. A snapshot from a
+  /// `ReloadableDetokenizer` may hold its entries in shared layers; these are
+  /// flattened into one map the first time `database()` is called, which is
+  /// kept for the lifetime of the snapshot. `DatabaseLookup` searches the
+  /// layers without flattening them.
+  const DomainTokenEntriesMap& database() const;
 
   span<const TokenizedStringEntry> DatabaseLookup(
       Token token, std::string_view domain) const;
 
  private:
+  friend class CachingDetokenizer;
+  friend class ReloadableDetokenizer;
+
+  // Combined entries of the layers and database_, built on first use.
+  struct Flattened {
+    std::once_flag once;
+    DomainTokenEntriesMap database;
+  };
+
+  explicit Detokenizer(std::vector<std::shared_ptr<const Detokenizer>>&& layers)
+      : layers_(std::move(layers)),
+        flattened_(std::make_shared<Flattened>()) {}
+
+  // Searches database_, then the layers from newest to oldest. The domain must
+  // already be canonical.
+  span<const TokenizedStringEntry> Find(Token token,
+                                        const std::string& domain) const;
+
   // 4 passes supports detokenizing two layers of nested messages with tokenized
   // domains (e.g. ${${bar}#ab12cd34}#00000012), without allowing a hypothetical
   // detokenization cycle to continue for too long.
@@ -228,6 +271,174 @@ class Detokenizer {
                                bool recursion) const;
 
   DomainTokenEntriesMap database_;
+
+  // Immutable databases shared with other snapshots, oldest first. A layer
+  // holds every entry for each of its tokens, including entries from older
+  // layers, so the newest layer with a token is the only one that is read.
+  std::vector<std::shared_ptr<const Detokenizer>> layers_;
+
+  // Set if there are layers. Copies share it until they are modified.
+  std::shared_ptr<Flattened> flattened_;
+};
+
+/// Detokenizes with a `Detokenizer` and memoizes the results in a bounded,
+/// least-recently-used (LRU) cache. Results are cached by domain and encoded
+/// data (token and arguments), so repeated messages are rendered once and then
+/// looked up. Firmware logs are often highly repetitive, so this makes most
+/// detokenizations a hash lookup.
+///
+/// Results are returned as `std::string_view`s that are valid until the next
+/// call to a non-`const` member function. When the cache is full, the least
+/// recently used entry is reused, including its string buffers, so a warm cache
+/// does not allocate.
+///
+/// `CachingDetokenizer` is not thread safe; use one per thread. The cache is
+/// not invalidated if the `Detokenizer`'s database changes; call `Clear()`
+/// after modifying it.
+class CachingDetokenizer {
+ public:
+  /// Creates a `CachingDetokenizer` that holds up to `capacity` results, which
+  /// must be at least 1. The `Detokenizer` must outlive the
+  /// `CachingDetokenizer`.
+  CachingDetokenizer(const Detokenizer& detokenizer, size_t capacity);
+
+  CachingDetokenizer(const CachingDetokenizer&) = delete;
+  CachingDetokenizer& operator=(const CachingDetokenizer&) = delete;
+
+  ~CachingDetokenizer();
+
+  /// Equivalent to `Detokenizer::RecursiveDetokenize(encoded, domain)
+  /// .BestString()`, but cached.
+  std::string_view Detokenize(span<const std::byte> encoded,
+                              std::string_view domain = kDefaultDomain);
+
+  /// Overload of `Detokenize` for `span<const uint8_t>`.
+  std::string_view Detokenize(span<const uint8_t> encoded,
+                              std::string_view domain = kDefaultDomain) {
+    return Detokenize(as_bytes(encoded), domain);
+  }
+
+  /// Equivalent to `Detokenizer::DetokenizeText`. Each nested Base64 message
+  /// in the text is detokenized through the cache, so messages that repeat
+  /// within different text are still only rendered once.
+  ///
+  /// The text must not refer to a result previously returned by this
+  /// `CachingDetokenizer`, since its buffer may be reused while detokenizing.
+  std::string_view DetokenizeText(std::string_view text);
+
+  /// Removes all cached results.
+  void Clear();
+
+  /// The number of cached results.
+  size_t size() const { return index_.size(); }
+
+  size_t capacity() const { return capacity_; }
+
+  /// The number of lookups that were found in the cache.
+  size_t hits() const { return hits_; }
+
+  /// The number of lookups that had to be detokenized.
+  size_t misses() const { return misses_; }
+
+ private:
+  friend class internal::NestedMessageDetokenizer;
+
+  enum KeyType : char {
+    kMessage = 'm',
+    kNestedMessage = 'n',
+  };
+
+  struct Entry {
+    std::string key;
+    std::string value;
+    bool detokenized = false;  // False if a nested message is left as-is.
+  };
+
+  // Returns the replacement for a nested message, or nullptr if the message
+  // should be left as-is.
+  const std::string* DetokenizeNested(span<const std::byte> encoded,
+                                      std::string_view domain);
+
+  // Finds the entry and marks it as most recently used. If it is not found,
+  // inserts an entry with the key, evicting the least recently used entry if
+  // the cache is full.
+  Entry& FindOrInsert(KeyType type,
+                      span<const std::byte> encoded,
+                      std::string_view domain,
+                      bool& found);
+
+  const Detokenizer& detokenizer_;
+  const size_t capacity_;
+
+  std::list<Entry> entries_;  // Most recently used first.
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> index_;
+
+  std::string key_;   // Reused buffer for building keys.
+  std::string text_;  // Reused buffer for DetokenizeText output.
+  std::unique_ptr<internal::NestedMessageDetokenizer> nested_;
+
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+};
+
+/// Holds a `Detokenizer` whose database can be replaced or extended while
+/// other threads are detokenizing with it.
+///
+/// Updates use read-copy-update: readers take a snapshot of the current
+/// `Detokenizer` with `snapshot()` and use it for as long as they like. An
+/// update builds a new `Detokenizer` off to the side and then publishes it, so
+/// readers never wait for a database to be loaded or merged. Old snapshots
+/// are freed when the last reader releases them.
+///
+/// A snapshot is a list of immutable database layers. `Merge` publishes a new
+/// list with one more layer, which holds only the merged entries, so the cost
+/// of a merge does not depend on the size of the current database. Once there
+/// are more than `kMaxLayers` layers, they are compacted into one.
+///
+/// @code{.cpp}
+///   ReloadableDetokenizer detokenizer(Detokenizer::FromCsv(v1_csv).value());
+///
+///   // Log ingestion threads
+///   std::shared_ptr<const Detokenizer> snapshot = detokenizer.snapshot();
+///   std::cout << snapshot->Detokenize(message).BestString() << '\n';
+///
+///   // When a new firmware version is seen
+///   detokenizer.Merge(Detokenizer::FromCsv(v2_csv).value());
+/// @endcode
+class ReloadableDetokenizer {
+ public:
+  /// Lookups search each layer, so merges that exceed this many layers compact
+  /// them into one.
+  static constexpr size_t kMaxLayers = 8;
+
+  explicit ReloadableDetokenizer(Detokenizer&& detokenizer)
+      : current_(std::make_shared<const Detokenizer>(std::move(detokenizer))) {}
+
+  ReloadableDetokenizer(const ReloadableDetokenizer&) = delete;
+  ReloadableDetokenizer& operator=(const ReloadableDetokenizer&) = delete;
+
+  /// Returns the current `Detokenizer`. The snapshot is not affected by later
+  /// updates.
+  std::shared_ptr<const Detokenizer> snapshot() const {
+    std::lock_guard lock(current_lock_);
+    return current_;
+  }
+
+  /// Replaces the database. Readers holding a snapshot keep using the old one.
+  void Replace(Detokenizer&& detokenizer);
+
+  /// Publishes the current database with `other` merged into it, added as a
+  /// new layer. Lookups return the same entries as `Detokenizer::Merge`.
+  void Merge(const Detokenizer& other);
+
+ private:
+  // Serializes updates so concurrent merges are not lost.
+  std::mutex update_lock_;
+
+  // Only held to copy or swap the pointer, never while detokenizing or
+  // building a database.
+  mutable std::mutex current_lock_;
+  std::shared_ptr<const Detokenizer> current_;
 };
 
 /// @}
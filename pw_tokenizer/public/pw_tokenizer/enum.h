@@ -13,11 +13,15 @@
 // the License.
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <optional>
+#include <string_view>
 #include <type_traits>
 
 #include "pw_preprocessor/apply.h"
 #include "pw_tokenizer/internal/enum.h"
+#include "pw_tokenizer/internal/enum_table.h"
 #include "pw_tokenizer/nested_tokenization.h"
 #include "pw_tokenizer/tokenize.h"
 
@@ -44,6 +48,54 @@ constexpr const char* EnumToString(T value) {
   return PwEnumToString(value);
 }
 
+/// @brief Returns the enumerator of a tokenized enum for a token, or
+/// `std::nullopt` if the token is not one of the enum's tokenized values.
+///
+/// The lookup uses a perfect hash table that is generated at compile time from
+/// the `PW_TOKENIZE_ENUM` or `PW_TOKENIZE_ENUM_CUSTOM` declaration, so it runs
+/// in constant time regardless of how sparse the enumerator values are.
+template <typename T>
+constexpr std::optional<T> EnumFromToken(Token token) {
+  static_assert(std::is_enum_v<T>, "Must be an enum");
+  static_assert(internal::kEnumTable<T>.ok(),
+                "Enumerator values and strings must be unique");
+  const auto* entry = internal::kEnumTable<T>.FindToken(token);
+  if (entry == nullptr) {
+    return std::nullopt;
+  }
+  return entry->value;
+}
+
+/// @brief Returns the string for a tokenized enum's token, or `nullptr` if the
+/// token is not one of the enum's tokenized values. This is the string that
+/// the token maps to in the token database.
+template <typename T>
+constexpr const char* EnumTokenToString(Token token) {
+  static_assert(std::is_enum_v<T>, "Must be an enum");
+  static_assert(internal::kEnumTable<T>.ok(),
+                "Enumerator values and strings must be unique");
+  const auto* entry = internal::kEnumTable<T>.FindToken(token);
+  return entry == nullptr ? nullptr : entry->string;
+}
+
+/// @brief Returns the enumerator of a tokenized enum with the given string, or
+/// `std::nullopt` if no enumerator has that string.
+///
+/// The string is the enumerator's name for `PW_TOKENIZE_ENUM` and its custom
+/// string for `PW_TOKENIZE_ENUM_CUSTOM`. The string is hashed once and looked
+/// up in a perfect hash table that is generated at compile time.
+template <typename T>
+constexpr std::optional<T> EnumFromString(std::string_view string) {
+  static_assert(std::is_enum_v<T>, "Must be an enum");
+  static_assert(internal::kEnumTable<T>.ok(),
+                "Enumerator values and strings must be unique");
+  const auto* entry = internal::kEnumTable<T>.FindString(string);
+  if (entry == nullptr) {
+    return std::nullopt;
+  }
+  return entry->value;
+}
+
 // Primary template for PwEnumDomainToken, specialized by generated code.
 template <typename T>
 constexpr uint32_t PwEnumDomainToken() {
@@ -92,7 +144,9 @@ constexpr uint32_t EnumDomainToken() {
 /// enumerator must be present to compile and have the enumerator be tokenized
 /// successfully.
 /// This macro should be in the same namespace as the enum declaration to use
-/// the `pw::EnumToString` function and avoid compilation errors.
+/// the `pw::EnumToString` function and avoid compilation errors. It also
+/// enables the constant-time lookups in `pw::tokenizer::EnumFromToken`,
+/// `pw::tokenizer::EnumTokenToString`, and `pw::tokenizer::EnumFromString`.
 #define PW_TOKENIZE_ENUM(fully_qualified_name, ...)      \
   PW_APPLY(_PW_TOKENIZE_ENUMERATOR,                      \
            _PW_SEMICOLON,                                \
@@ -108,6 +162,13 @@ constexpr uint32_t EnumDomainToken() {
     }                                                    \
     return "Unknown " #fully_qualified_name " value";    \
   }                                                      \
+  [[maybe_unused]] constexpr auto PwEnumEntries(         \
+      fully_qualified_name) {                            \
+    return std::array{PW_APPLY(_PW_TOKENIZE_ENUM_ENTRY,  \
+                               _PW_COMMA,                \
+                               fully_qualified_name,     \
+                               __VA_ARGS__)};            \
+  }                                                      \
   static_assert(true)
 
 /// Tokenizes a custom string for each given values within an enumerator. All
@@ -116,7 +177,8 @@ constexpr uint32_t EnumDomainToken() {
 /// custom string) must be present to compile and have the custom strings be
 /// tokenized successfully.
 /// This macro should be in the same namespace as the enum declaration to use
-/// the `pw::EnumToString` function and avoid compilation errors.
+/// the `pw::EnumToString` function and avoid compilation errors. Lookups with
+/// `pw::tokenizer::EnumFromString` use the custom strings.
 #define PW_TOKENIZE_ENUM_CUSTOM(fully_qualified_name, ...) \
   PW_APPLY(_PW_TOKENIZE_ENUMERATOR_CUSTOM,                 \
            _PW_SEMICOLON,                                  \
@@ -132,6 +194,14 @@ constexpr uint32_t EnumDomainToken() {
     }                                                      \
     return "Unknown " #fully_qualified_name " value";      \
   }                                                        \
+  [[maybe_unused]] constexpr auto PwEnumEntries(           \
+      fully_qualified_name) {                              \
+    return std::array{                                     \
+        PW_APPLY(_PW_TOKENIZE_ENUM_ENTRY_CUSTOM,           \
+                 _PW_COMMA,                                \
+                 fully_qualified_name,                     \
+                 __VA_ARGS__)};                            \
+  }                                                        \
   static_assert(true)
 
 /// @}
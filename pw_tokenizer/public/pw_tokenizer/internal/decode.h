@@ -20,6 +20,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -261,7 +262,8 @@ class DecodedFormatString {
 };
 
 // Represents a printf-style format string. The string is stored as a vector of
-// StringSegments.
+// StringSegments. The segments are immutable and shared between copies, so
+// copying a FormatString is cheap.
 class FormatString {
  public:
   // Constructs a FormatString from a null-terminated format string.
@@ -279,10 +281,10 @@ class FormatString {
   // Returns the raw, unformatted version of this string.
   std::string text() const;
 
-  span<const StringSegment> segments() const { return segments_; }
+  span<const StringSegment> segments() const { return *segments_; }
 
   friend bool operator==(const FormatString& lhs, const FormatString& rhs) {
-    return lhs.segments_ == rhs.segments_;
+    return lhs.segments_ == rhs.segments_ || *lhs.segments_ == *rhs.segments_;
   }
 
   friend bool operator!=(const FormatString& lhs, const FormatString& rhs) {
@@ -290,7 +292,7 @@ class FormatString {
   }
 
  private:
-  std::vector<StringSegment> segments_;
+  std::shared_ptr<const std::vector<StringSegment>> segments_;
 };
 
 PW_MODIFY_DIAGNOSTICS_PUSH();
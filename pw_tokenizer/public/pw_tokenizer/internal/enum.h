@@ -18,6 +18,7 @@
 
 #include "pw_preprocessor/compiler.h"
 #include "pw_tokenizer/hash.h"
+#include "pw_tokenizer/internal/enum_table.h"
 #include "pw_tokenizer/tokenize.h"
 
 namespace pw::tokenizer {
@@ -32,6 +33,14 @@ constexpr bool ValidEnumerator(T) {
 }  // namespace pw::tokenizer
 
 #define _PW_SEMICOLON(...) ;
+#define _PW_COMMA(...) ,
+
+// Declares an entry in the array returned by PwEnumEntries.
+#define _PW_TOKENIZE_ENUM_ENTRY_IMPL(index, name, enumerator, str) \
+  ::pw::tokenizer::internal::EnumEntry<name> { name::enumerator, str }
+
+#define _PW_TOKENIZE_ENUM_ENTRY(index, name, enumerator) \
+  _PW_TOKENIZE_ENUM_ENTRY_IMPL(index, name, enumerator, #enumerator)
 
 // Core value tokenization macro (takes explicit domain)
 #define _PW_ENUM_TOKENIZE_VALUE_IMPL(index, name, domain, enumerator, str) \
@@ -68,6 +77,11 @@ constexpr bool ValidEnumerator(T) {
 #define _PW_TOKENIZE_TO_STRING_CASE_CUSTOM_EXPAND(index, name, ...) \
   _PW_TOKENIZE_TO_STRING_CASE_IMPL(index, name, __VA_ARGS__)
 
+#define _PW_TOKENIZE_ENUM_ENTRY_CUSTOM(index, name, arg) \
+  _PW_TOKENIZE_ENUM_ENTRY_CUSTOM_EXPAND(index, name, _PW_CUSTOM_ENUMERATOR arg)
+#define _PW_TOKENIZE_ENUM_ENTRY_CUSTOM_EXPAND(index, name, ...) \
+  _PW_TOKENIZE_ENUM_ENTRY_IMPL(index, name, __VA_ARGS__)
+
 // Declares a tokenized custom string for an individual enum value.
 #define _PW_TOKENIZE_ENUMERATOR_CUSTOM(index, name, arg) \
   _PW_TOKENIZE_ENUMERATOR_CUSTOM_EXPAND(index, name, _PW_CUSTOM_ENUMERATOR arg)
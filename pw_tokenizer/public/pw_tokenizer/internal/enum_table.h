@@ -0,0 +1,265 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "pw_preprocessor/compiler.h"
+#include "pw_tokenizer/hash.h"
+#include "pw_tokenizer/tokenize.h"
+
+namespace pw::tokenizer::internal {
+
+// An enumerator and its string, as listed in PW_TOKENIZE_ENUM or
+// PW_TOKENIZE_ENUM_CUSTOM.
+template <typename T>
+struct EnumEntry {
+  T value;
+  const char* string;
+};
+
+constexpr size_t RoundUpToPowerOfTwo(size_t value) {
+  size_t result = 1;
+  while (result < value) {
+    result *= 2;
+  }
+  return result;
+}
+
+// Mixes a 32-bit key with a seed. Seed 0 selects a key's bucket; the seeds
+// stored per bucket select its slot.
+constexpr uint32_t PerfectHashMix(uint32_t key, uint32_t seed)
+    PW_NO_SANITIZE("unsigned-integer-overflow") {
+  uint32_t hash = key ^ (seed * 0x9e3779b9u);
+  hash ^= hash >> 16;
+  hash *= 0x7feb352du;
+  hash ^= hash >> 15;
+  hash *= 0x846ca68bu;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+// Perfect hash from kKeys distinct 32-bit keys to their indices, built with
+// the hash-and-displace algorithm. Keys are hashed into buckets; each bucket is
+// assigned the first seed that places all of its keys into unused slots.
+// Lookups hash twice and read one slot, regardless of the key values.
+//
+// The constructor runs in constant evaluation. Duplicate keys cannot be
+// placed, so they are detected before searching for seeds and reported by ok()
+// returning false.
+template <size_t kKeys>
+class PerfectHash {
+ public:
+  static_assert(kKeys < 0xffff, "Too many keys for a 16-bit index");
+
+  // Returned by Find for keys that are not in the table.
+  static constexpr size_t kNotFound = kKeys;
+
+  constexpr explicit PerfectHash(const std::array<uint32_t, kKeys>& keys) {
+    // std::array::fill is not constexpr in C++17.
+    for (uint16_t& slot : slots_) {
+      slot = kEmpty;
+    }
+
+    std::array<size_t, kBuckets> bucket_sizes{};
+    size_t largest_bucket = 0;
+    for (uint32_t key : keys) {
+      size_t& size = bucket_sizes[Bucket(key)];
+      size += 1;
+      largest_bucket = size > largest_bucket ? size : largest_bucket;
+    }
+
+    // No seed can separate equal keys, so check for them before searching.
+    if (HasDuplicates(keys, bucket_sizes)) {
+      ok_ = false;
+      return;
+    }
+
+    // Place the largest buckets first, while most slots are still free.
+    for (size_t size = largest_bucket; size > 0; --size) {
+      for (size_t bucket = 0; bucket < kBuckets; ++bucket) {
+        if (bucket_sizes[bucket] == size && !PlaceBucket(keys, bucket)) {
+          ok_ = false;
+          return;
+        }
+      }
+    }
+  }
+
+  // False if there are duplicate keys, or if the keys could not be placed.
+  constexpr bool ok() const { return ok_; }
+
+  // Returns the index of a candidate key. The caller must check that the key
+  // at that index matches, since keys that are not in the table may map to any
+  // slot.
+  constexpr size_t Find(uint32_t key) const {
+    const uint16_t index = slots_[Slot(key, seeds_[Bucket(key)])];
+    return index == kEmpty ? kNotFound : index;
+  }
+
+ private:
+  static constexpr size_t kBuckets = RoundUpToPowerOfTwo(kKeys);
+
+  // Keep the load factor at or below 1/2 so seeds are found in a few tries.
+  static constexpr size_t kSlots = 2 * kBuckets;
+
+  static constexpr uint16_t kEmpty = 0xffff;
+  static constexpr uint32_t kMaxSeed = 0xffff;
+
+  static constexpr size_t Bucket(uint32_t key) {
+    return PerfectHashMix(key, 0) & (kBuckets - 1);
+  }
+
+  static constexpr size_t Slot(uint32_t key, uint16_t seed) {
+    return PerfectHashMix(key, seed) & (kSlots - 1);
+  }
+
+  // Equal keys are always in the same bucket, so the keys are grouped by bucket
+  // and only compared within their group.
+  static constexpr bool HasDuplicates(
+      const std::array<uint32_t, kKeys>& keys,
+      const std::array<size_t, kBuckets>& bucket_sizes) {
+    std::array<size_t, kBuckets + 1> starts{};
+    for (size_t bucket = 0; bucket < kBuckets; ++bucket) {
+      starts[bucket + 1] = starts[bucket] + bucket_sizes[bucket];
+    }
+
+    std::array<size_t, kBuckets + 1> next = starts;
+    std::array<uint32_t, kKeys> grouped{};
+    for (uint32_t key : keys) {
+      grouped[next[Bucket(key)]++] = key;
+    }
+
+    for (size_t bucket = 0; bucket < kBuckets; ++bucket) {
+      for (size_t i = starts[bucket]; i < starts[bucket + 1]; ++i) {
+        for (size_t j = i + 1; j < starts[bucket + 1]; ++j) {
+          if (grouped[i] == grouped[j]) {
+            return true;
+          }
+        }
+      }
+    }
+    return false;
+  }
+
+  constexpr bool PlaceBucket(const std::array<uint32_t, kKeys>& keys,
+                             size_t bucket) {
+    std::array<uint16_t, kKeys> members{};
+    size_t count = 0;
+    for (size_t i = 0; i < kKeys; ++i) {
+      if (Bucket(keys[i]) == bucket) {
+        members[count++] = static_cast<uint16_t>(i);
+      }
+    }
+
+    for (uint32_t seed = 1; seed <= kMaxSeed; ++seed) {
+      if (TryPlace(keys, members, count, static_cast<uint16_t>(seed))) {
+        seeds_[bucket] = static_cast<uint16_t>(seed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  constexpr bool TryPlace(const std::array<uint32_t, kKeys>& keys,
+                          const std::array<uint16_t, kKeys>& members,
+                          size_t count,
+                          uint16_t seed) {
+    for (size_t i = 0; i < count; ++i) {
+      const size_t slot = Slot(keys[members[i]], seed);
+      if (slots_[slot] != kEmpty) {
+        // Undo this attempt's placements before trying the next seed.
+        for (size_t j = 0; j < i; ++j) {
+          slots_[Slot(keys[members[j]], seed)] = kEmpty;
+        }
+        return false;
+      }
+      slots_[slot] = members[i];
+    }
+    return true;
+  }
+
+  std::array<uint16_t, kBuckets> seeds_{};
+  std::array<uint16_t, kSlots> slots_{};
+  bool ok_ = true;
+};
+
+// Lookup tables for a tokenized enum, generated from its PwEnumEntries
+// function at compile time.
+template <typename T, size_t kSize>
+class EnumTable {
+ public:
+  constexpr explicit EnumTable(const std::array<EnumEntry<T>, kSize>& entries)
+      : entries_(entries),
+        by_token_(Tokens(entries)),
+        by_string_(StringHashes(entries)) {}
+
+  // True if the enumerators and their strings are all unique.
+  constexpr bool ok() const { return by_token_.ok() && by_string_.ok(); }
+
+  constexpr const EnumEntry<T>* FindToken(Token token) const {
+    const size_t index = by_token_.Find(token);
+    if (index == kNotFound ||
+        static_cast<Token>(entries_[index].value) != token) {
+      return nullptr;
+    }
+    return &entries_[index];
+  }
+
+  constexpr const EnumEntry<T>* FindString(std::string_view string) const {
+    const size_t index = by_string_.Find(Hash(string));
+    if (index == kNotFound || string != entries_[index].string) {
+      return nullptr;
+    }
+    return &entries_[index];
+  }
+
+ private:
+  static constexpr size_t kNotFound = PerfectHash<kSize>::kNotFound;
+
+  static constexpr std::array<uint32_t, kSize> Tokens(
+      const std::array<EnumEntry<T>, kSize>& entries) {
+    std::array<uint32_t, kSize> tokens{};
+    for (size_t i = 0; i < kSize; ++i) {
+      tokens[i] = static_cast<Token>(entries[i].value);
+    }
+    return tokens;
+  }
+
+  static constexpr std::array<uint32_t, kSize> StringHashes(
+      const std::array<EnumEntry<T>, kSize>& entries) {
+    std::array<uint32_t, kSize> hashes{};
+    for (size_t i = 0; i < kSize; ++i) {
+      hashes[i] = Hash(entries[i].string);
+    }
+    return hashes;
+  }
+
+  std::array<EnumEntry<T>, kSize> entries_;
+  PerfectHash<kSize> by_token_;
+  PerfectHash<kSize> by_string_;
+};
+
+template <typename T, size_t kSize>
+EnumTable(const std::array<EnumEntry<T>, kSize>&) -> EnumTable<T, kSize>;
+
+// The table for each tokenized enum is a constant, so no code runs to build
+// it. PwEnumEntries is found through ADL, like PwEnumToString.
+template <typename T>
+inline constexpr EnumTable kEnumTable(PwEnumEntries(T()));
+
+}  // namespace pw::tokenizer::internal
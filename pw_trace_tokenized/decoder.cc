@@ -16,8 +16,10 @@
 
 #include <limits>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <type_traits>
+#include <utility>
 
 #include "lib/stdcompat/utility.h"
 #include "pw_bytes/endian.h"
@@ -128,53 +130,111 @@ Result<std::string_view> GetUniqueString(
 
 Result<DecodedEvent> TokenizedDecoder::ReadSizePrefixed(
     stream::Reader& reader) {
+  DecodedEvent event;
+  PW_TRY(ReadSizePrefixed(reader, event));
+  return event;
+}
+
+Status TokenizedDecoder::ReadSizePrefixed(stream::Reader& reader,
+                                          DecodedEvent& event) {
   // Trace entry as returned via pw_trace_tokenized:transfer_handler.
   PW_TRY_ASSIGN(uint8_t entry_size, ReadInt<uint8_t>(reader));
 
   std::array<std::byte, std::numeric_limits<uint8_t>::max()> buffer;
   const ByteSpan entry_buf = span(buffer).first(entry_size);
 
-  PW_TRY(reader.Read(entry_buf));
-  return Decode(entry_buf);
+  // Only an end of stream at the size prefix is a clean end. One within the
+  // entry means the entry was truncated.
+  if (Status status = reader.ReadExact(entry_buf).status(); !status.ok()) {
+    return status.IsOutOfRange() ? Status::DataLoss() : status;
+  }
+  return Decode(entry_buf, event);
 }
 
 Result<DecodedEvent> TokenizedDecoder::Decode(ConstByteSpan data) {
-  stream::MemoryReader reader(data);
+  DecodedEvent event;
+  PW_TRY(Decode(data, event));
+  return event;
+}
 
-  // Read token
-  PW_TRY_ASSIGN(uint32_t token, ReadInt<uint32_t>(reader));
+const TokenizedDecoder::TokenFields& TokenizedDecoder::GetTokenFields(
+    uint32_t token) {
+  auto [it, inserted] = token_fields_.try_emplace(token);
+  TokenFields& fields = it->second;
+  if (!inserted) {
+    return fields;
+  }
 
   // Detokenize
   tokenizer::DetokenizedString detok_result =
       detokenizer_.Detokenize(ObjectAsBytes(token), kDomain);
-  PW_TRY_ASSIGN(std::string_view token_string,
-                GetUniqueString(detok_result, token));
+  Result<std::string_view> token_string = GetUniqueString(detok_result, token);
+  if (!token_string.ok()) {
+    fields.status = token_string.status();
+    return fields;
+  }
 
   // Split token string:
   // "event_type|flag|module|group|label|<optional DATA_FMT>"
-  std::vector<std::string_view> token_string_values = Split(token_string, '|');
+  std::vector<std::string_view> token_string_values = Split(*token_string, '|');
   if (token_string_values.size() < 5) {
     PW_LOG_WARN("Too few token values: %zu", token_string_values.size());
-    return Status::DataLoss();
+    fields.status = Status::DataLoss();
+    return fields;
   }
-  DecodedEvent event{};
-  event.type =
+  fields.type =
       ParseEventType(token_string_values[to_underlying(TokenIdx::kEventType)]);
-  event.module = token_string_values[to_underlying(TokenIdx::kModule)];
-  event.group = token_string_values[to_underlying(TokenIdx::kGroup)];
-  event.label = token_string_values[to_underlying(TokenIdx::kLabel)];
+  fields.module = token_string_values[to_underlying(TokenIdx::kModule)];
+  fields.group = token_string_values[to_underlying(TokenIdx::kGroup)];
+  fields.label = token_string_values[to_underlying(TokenIdx::kLabel)];
 
   // TODO: https://pwbug.dev/448489618 - The 'flag' field in the token is
   // ostensibly a decimal integer string, but could actually be any arbitrary C
   // expression that evaluates to an integer. Rather than try to parse it and
   // risk failing, simply return it as a string for now.
-  event.flags_str = token_string_values[to_underlying(TokenIdx::kFlag)];
+  fields.flags_str = token_string_values[to_underlying(TokenIdx::kFlag)];
 
-  const bool has_data =
+  fields.has_data =
       (token_string_values.size() > to_underlying(TokenIdx::kDataFmt));
-  if (has_data) {
-    event.data_fmt = token_string_values[to_underlying(TokenIdx::kDataFmt)];
+  if (fields.has_data) {
+    fields.data_fmt = token_string_values[to_underlying(TokenIdx::kDataFmt)];
   }
+  return fields;
+}
+
+Result<std::string_view> TokenizedDecoder::GetTokenLabel(
+    uint32_t label_token) {
+  auto it = token_labels_.find(label_token);
+  if (it == token_labels_.end()) {
+    tokenizer::DetokenizedString detok_label =
+        detokenizer_.Detokenize(ObjectAsBytes(label_token), kDomain);
+    Result<std::string_view> label = GetUniqueString(detok_label, label_token);
+    Result<std::string> cached_label =
+        label.ok() ? Result<std::string>(std::string(*label))
+                   : Result<std::string>(label.status());
+    it = token_labels_.emplace(label_token, std::move(cached_label)).first;
+  }
+  PW_TRY(it->second.status());
+  return std::string_view(*it->second);
+}
+
+Status TokenizedDecoder::Decode(ConstByteSpan data, DecodedEvent& event) {
+  stream::MemoryReader reader(data);
+
+  // Read token
+  PW_TRY_ASSIGN(uint32_t token, ReadInt<uint32_t>(reader));
+  const TokenFields& fields = GetTokenFields(token);
+  PW_TRY(fields.status);
+
+  // Assigning to the existing strings reuses their storage.
+  event.type = fields.type;
+  event.flags_str = fields.flags_str;
+  event.module = fields.module;
+  event.group = fields.group;
+  event.label = fields.label;
+  event.data_fmt = fields.data_fmt;
+  event.trace_id.reset();
+  event.data.clear();
 
   // Read time
   uint64_t time_delta;
@@ -192,7 +252,7 @@ Result<DecodedEvent> TokenizedDecoder::Decode(ConstByteSpan data) {
   }
 
   // Data
-  if (has_data) {
+  if (fields.has_data) {
     if (event.data_fmt == kTokenLabelDataFmt) {
       if (reader.ConservativeReadLimit() != 4) {
         PW_LOG_WARN("Mismatched data size for %s: expected 4, got %zu",
@@ -201,10 +261,7 @@ Result<DecodedEvent> TokenizedDecoder::Decode(ConstByteSpan data) {
         return Status::DataLoss();
       }
       PW_TRY_ASSIGN(uint32_t label_token, ReadInt<uint32_t>(reader));
-      tokenizer::DetokenizedString detok_label =
-          detokenizer_.Detokenize(ObjectAsBytes(label_token), kDomain);
-      PW_TRY_ASSIGN(std::string_view label_string,
-                    GetUniqueString(detok_label, label_token));
+      PW_TRY_ASSIGN(std::string_view label_string, GetTokenLabel(label_token));
       event.label = label_string;
       event.data_fmt.clear();
     } else {
@@ -214,7 +271,7 @@ Result<DecodedEvent> TokenizedDecoder::Decode(ConstByteSpan data) {
     }
   }
 
-  return event;
+  return OkStatus();
 }
 
 }  // namespace pw::trace
@@ -217,6 +217,99 @@ TEST(TokenizedDecoder, MainTokenCollision) {
   EXPECT_EQ(result.status(), Status::DataLoss());
 }
 
+TEST(TokenizedDecoder, DecodeReusesEvent) {
+  static constexpr char kTokenDbCsv[] =
+      "11223344,,trace,"
+      "PW_TRACE_EVENT_TYPE_ASYNC_START|0|MyModule|MyGroup|MyLabel|"
+      "MyDataFmt\n"
+      "55667788,,trace,"
+      "PW_TRACE_EVENT_TYPE_INSTANT|0|OtherModule|OtherGroup|OtherLabel\n";
+
+  pw::Result<Detokenizer> detok = Detokenizer::FromCsv(kTokenDbCsv);
+  PW_CHECK_OK(detok);
+
+  constexpr auto kAsync =
+      bytes::Concat(bytes::Array<0x44, 0x33, 0x22, 0x11>(),  // string token
+                    bytes::Array<0x0a>(),                    // ticks = 10
+                    bytes::Array<0x07>(),                    // trace_id = 7
+                    bytes::Array<0x41, 0x42>());             // data
+  constexpr auto kInstant =
+      bytes::Concat(bytes::Array<0x88, 0x77, 0x66, 0x55>(),  // string token
+                    bytes::Array<0x05>());                   // ticks = 5
+  constexpr auto kInput = bytes::Concat(std::byte{kAsync.size()},
+                                        kAsync,
+                                        std::byte{kInstant.size()},
+                                        kInstant,
+                                        std::byte{kAsync.size()},
+                                        kAsync);
+
+  TokenizedDecoder decoder(*detok, kTicksPerSec);
+  stream::MemoryReader reader(kInput);
+  DecodedEvent event;
+
+  ASSERT_EQ(decoder.ReadSizePrefixed(reader, event), OkStatus());
+  EXPECT_EQ(event.type, EventType::PW_TRACE_EVENT_TYPE_ASYNC_START);
+  EXPECT_EQ(event.trace_id, 7u);
+  EXPECT_EQ(event.data.size(), 2u);
+
+  // Fields which the next event does not have are cleared.
+  ASSERT_EQ(decoder.ReadSizePrefixed(reader, event), OkStatus());
+  EXPECT_EQ(event.type, EventType::PW_TRACE_EVENT_TYPE_INSTANT);
+  EXPECT_STREQ(event.module.c_str(), "OtherModule");
+  EXPECT_STREQ(event.label.c_str(), "OtherLabel");
+  EXPECT_FALSE(event.trace_id.has_value());
+  EXPECT_TRUE(event.data_fmt.empty());
+  EXPECT_TRUE(event.data.empty());
+  EXPECT_EQ(event.timestamp_usec, 15u * 1000);
+
+  // The first token is decoded again from the cache.
+  ASSERT_EQ(decoder.ReadSizePrefixed(reader, event), OkStatus());
+  EXPECT_STREQ(event.module.c_str(), "MyModule");
+  EXPECT_STREQ(event.data_fmt.c_str(), "MyDataFmt");
+  EXPECT_EQ(event.timestamp_usec, 25u * 1000);
+
+  EXPECT_EQ(decoder.ReadSizePrefixed(reader, event), Status::OutOfRange());
+}
+
+TEST(TokenizedDecoder, SkipsUndecodableEvent) {
+  static constexpr char kTokenDbCsv[] =
+      "11223344,,trace,"
+      "PW_TRACE_EVENT_TYPE_INSTANT|0|MyModule|MyGroup|MyLabel\n";
+
+  pw::Result<Detokenizer> detok = Detokenizer::FromCsv(kTokenDbCsv);
+  PW_CHECK_OK(detok);
+
+  constexpr auto kInput = bytes::Concat(
+      bytes::Array<0x05, 0x99, 0x99, 0x99, 0x99, 0x01>(),   // unknown token
+      bytes::Array<0x05, 0x44, 0x33, 0x22, 0x11, 0x01>());  // instant
+
+  TokenizedDecoder decoder(*detok, kTicksPerSec);
+  stream::MemoryReader reader(kInput);
+  DecodedEvent event;
+
+  EXPECT_EQ(decoder.ReadSizePrefixed(reader, event), Status::DataLoss());
+  ASSERT_EQ(decoder.ReadSizePrefixed(reader, event), OkStatus());
+  EXPECT_STREQ(event.label.c_str(), "MyLabel");
+}
+
+TEST(TokenizedDecoder, ReportsTruncatedEvent) {
+  static constexpr char kTokenDbCsv[] =
+      "11223344,,trace,"
+      "PW_TRACE_EVENT_TYPE_INSTANT|0|MyModule|MyGroup|MyLabel\n";
+
+  pw::Result<Detokenizer> detok = Detokenizer::FromCsv(kTokenDbCsv);
+  PW_CHECK_OK(detok);
+
+  constexpr auto kInput = bytes::Array<0x05, 0x44, 0x33, 0x22>();
+
+  TokenizedDecoder decoder(*detok, kTicksPerSec);
+  stream::MemoryReader reader(kInput);
+  DecodedEvent event;
+
+  EXPECT_EQ(decoder.ReadSizePrefixed(reader, event), Status::DataLoss());
+  EXPECT_EQ(decoder.ReadSizePrefixed(reader, event), Status::OutOfRange());
+}
+
 TEST(TokenizedDecoder, HighFrequencyTimestampCalculation) {
   // Set up detokenizer
   static constexpr char kTokenDbCsv[] =
@@ -0,0 +1,203 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Tests the tokenized tracer with PW_TRACE_PER_THREAD_QUEUES enabled. This test
+// is built with its own copy of the tracer, so it does not depend on the
+// pw_trace backend.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "pw_sync/binary_semaphore.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_trace_tokenized/trace_callback.h"
+#include "pw_trace_tokenized/trace_tokenized.h"
+#include "pw_unit_test/framework.h"
+
+static_assert(PW_TRACE_PER_THREAD_QUEUES,
+              "This test requires PW_TRACE_PER_THREAD_QUEUES");
+
+namespace pw::trace {
+namespace {
+
+constexpr size_t kThreadsPerRound = 4;
+static_assert(kThreadsPerRound <= PW_TRACE_PER_THREAD_MAX_THREADS);
+
+// More threads run than there are queues, so the queues of exited threads must
+// be reused.
+constexpr size_t kRounds = 3;
+constexpr size_t kThreads = kRounds * kThreadsPerRound;
+static_assert(kThreads > PW_TRACE_PER_THREAD_MAX_THREADS);
+
+// Each thread fills its queue once, so no events are dropped even if another
+// thread is draining when the queue is half full.
+constexpr uint32_t kEventsPerThread = PW_TRACE_PER_THREAD_QUEUE_SIZE_EVENTS;
+
+// Records the token and data of each event sent to the sink. Each thread's
+// token is its index, and each event's data is its index within the thread.
+struct Capture {
+  std::array<std::byte, PW_TRACE_BUFFER_MAX_BLOCK_SIZE_BYTES> block;
+  size_t block_size = 0;
+
+  std::array<uint32_t, kThreads> count{};
+  bool in_order = true;
+  bool valid = true;
+
+  // If set, the first event sent releases `draining`, then waits for `resume`
+  // while the tracer's lock is held.
+  sync::BinarySemaphore* draining = nullptr;
+  sync::BinarySemaphore* resume = nullptr;
+};
+
+void StartBlock(void* user_data, size_t) {
+  static_cast<Capture*>(user_data)->block_size = 0;
+}
+
+void AddBytes(void* user_data, const void* bytes, size_t size) {
+  Capture& capture = *static_cast<Capture*>(user_data);
+  if (capture.block_size + size > capture.block.size()) {
+    capture.valid = false;
+    return;
+  }
+  std::memcpy(&capture.block[capture.block_size], bytes, size);
+  capture.block_size += size;
+}
+
+void EndBlock(void* user_data) {
+  Capture& capture = *static_cast<Capture*>(user_data);
+  if (capture.draining != nullptr) {
+    std::exchange(capture.draining, nullptr)->release();
+    capture.resume->acquire();
+  }
+  uint32_t token;
+  uint32_t index;
+  if (capture.block_size < sizeof(token) + sizeof(index)) {
+    capture.valid = false;
+    return;
+  }
+  std::memcpy(&token, capture.block.data(), sizeof(token));
+  std::memcpy(&index,
+              &capture.block[capture.block_size - sizeof(index)],
+              sizeof(index));
+  if (token >= kThreads) {
+    capture.valid = false;
+    return;
+  }
+  capture.in_order = capture.in_order && index == capture.count[token];
+  ++capture.count[token];
+}
+
+struct Emitter {
+  TokenizedTracer* tracer;
+  uint32_t token;
+  uint32_t events = kEventsPerThread;
+};
+
+void EmitEvents(const Emitter& emitter) {
+  for (uint32_t i = 0; i < emitter.events; ++i) {
+    emitter.tracer->HandleTraceEvent(emitter.token,
+                                     PW_TRACE_EVENT_TYPE_INSTANT,
+                                     "TST",
+                                     0,
+                                     0,
+                                     &i,
+                                     sizeof(i));
+  }
+}
+
+TEST(PerThreadTrace, SendsEventsFromManyThreads) {
+  Callbacks callbacks{};  // Zero the callback tables.
+  Capture capture;
+  ASSERT_TRUE(
+      callbacks.RegisterSink(StartBlock, AddBytes, EndBlock, &capture).ok());
+  TokenizedTracer tracer(callbacks);
+  tracer.Enable(true);
+
+  std::array<Emitter, kThreads> emitters;
+  for (uint32_t token = 0; token < kThreads; ++token) {
+    emitters[token] = {&tracer, token};
+  }
+
+  for (size_t round = 0; round < kRounds; ++round) {
+    std::array<thread::test::TestThreadContext, kThreadsPerRound> contexts;
+    std::array<Thread, kThreadsPerRound> threads;
+    for (size_t i = 0; i < kThreadsPerRound; ++i) {
+      const Emitter* emitter = &emitters[round * kThreadsPerRound + i];
+      threads[i] = Thread(contexts[i].options(),
+                          [emitter] { EmitEvents(*emitter); });
+    }
+    for (Thread& thread : threads) {
+      thread.join();
+    }
+
+    // Send the events left in the exited threads' queues, so that the queues
+    // can be reused.
+    tracer.Flush();
+  }
+
+  EXPECT_TRUE(capture.valid);
+  EXPECT_TRUE(capture.in_order);
+  for (uint32_t count : capture.count) {
+    EXPECT_EQ(count, kEventsPerThread);
+  }
+  EXPECT_EQ(tracer.events_dropped(), 0u);
+}
+
+TEST(PerThreadTrace, CountsEventsDroppedWhenQueueIsFull) {
+  sync::BinarySemaphore draining;
+  sync::BinarySemaphore resume;
+  Callbacks callbacks{};  // Zero the callback tables.
+  Capture capture;
+  capture.draining = &draining;
+  capture.resume = &resume;
+  ASSERT_TRUE(
+      callbacks.RegisterSink(StartBlock, AddBytes, EndBlock, &capture).ok());
+  TokenizedTracer tracer(callbacks);
+  tracer.Enable(true);
+
+  // The first thread fills half of its queue, so it drains the queues and
+  // blocks in the sink.
+  constexpr uint32_t kDrainingEvents = (kEventsPerThread + 1) / 2;
+  const Emitter drainer{&tracer, 0, kDrainingEvents};
+  thread::test::TestThreadContext drainer_context;
+  Thread drainer_thread(drainer_context.options(),
+                        [&drainer] { EmitEvents(drainer); });
+  draining.acquire();
+
+  // The second thread cannot drain while the first holds the lock, so it fills
+  // its queue and the rest of its events are dropped.
+  const Emitter overflower{&tracer, 1, 2 * kEventsPerThread};
+  thread::test::TestThreadContext overflower_context;
+  Thread overflower_thread(overflower_context.options(),
+                           [&overflower] { EmitEvents(overflower); });
+  overflower_thread.join();
+  EXPECT_EQ(tracer.events_dropped(), kEventsPerThread);
+
+  resume.release();
+  drainer_thread.join();
+  tracer.Flush();
+
+  EXPECT_TRUE(capture.valid);
+  EXPECT_TRUE(capture.in_order);
+  EXPECT_EQ(capture.count[0], kDrainingEvents);
+  EXPECT_EQ(capture.count[1], kEventsPerThread);
+  EXPECT_EQ(tracer.events_dropped(), kEventsPerThread);
+}
+
+}  // namespace
+}  // namespace pw::trace
@@ -0,0 +1,355 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_trace_tokenized/perfetto_exporter.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "lib/stdcompat/utility.h"
+#include "pw_bytes/span.h"
+#include "pw_status/try.h"
+
+namespace pw::trace {
+namespace {
+
+using cpp23::to_underlying;
+
+// Field numbers and enum values from Perfetto's
+// protos/perfetto/trace/perfetto_trace.proto.
+constexpr uint32_t kTracePacketField = 1;
+
+namespace trace_packet {
+constexpr uint32_t kTimestamp = 8;
+constexpr uint32_t kTrustedPacketSequenceId = 10;
+constexpr uint32_t kTrackEvent = 11;
+constexpr uint32_t kSequenceFlags = 13;
+constexpr uint32_t kPreviousPacketDropped = 42;
+constexpr uint32_t kTrackDescriptor = 60;
+constexpr uint32_t kFirstPacketOnSequence = 87;
+
+constexpr uint32_t kSeqIncrementalStateCleared = 1;
+}  // namespace trace_packet
+
+namespace track_descriptor {
+constexpr uint32_t kUuid = 1;
+constexpr uint32_t kName = 2;
+constexpr uint32_t kProcess = 3;
+constexpr uint32_t kParentUuid = 5;
+constexpr uint32_t kCounter = 8;
+}  // namespace track_descriptor
+
+namespace process_descriptor {
+constexpr uint32_t kPid = 1;
+constexpr uint32_t kProcessName = 6;
+}  // namespace process_descriptor
+
+namespace track_event {
+constexpr uint32_t kDebugAnnotations = 4;
+constexpr uint32_t kType = 9;
+constexpr uint32_t kTrackUuid = 11;
+constexpr uint32_t kName = 23;
+constexpr uint32_t kCounterValue = 30;
+
+constexpr uint32_t kTypeSliceBegin = 1;
+constexpr uint32_t kTypeSliceEnd = 2;
+constexpr uint32_t kTypeInstant = 3;
+constexpr uint32_t kTypeCounter = 4;
+}  // namespace track_event
+
+namespace debug_annotation {
+constexpr uint32_t kUintValue = 3;
+constexpr uint32_t kStringValue = 6;
+constexpr uint32_t kName = 10;
+}  // namespace debug_annotation
+
+// All packets are written on a single sequence.
+constexpr uint32_t kSequenceId = 1;
+
+// Data formats handled by the Python trace tools.
+constexpr std::string_view kArgLabelDataFmt = "@pw_arg_label";
+constexpr std::string_view kArgGroupDataFmt = "@pw_arg_group";
+constexpr std::string_view kArgCounterDataFmt = "@pw_arg_counter";
+
+// 64-bit FNV-1a, used to derive track UUIDs from track names.
+constexpr uint64_t kFnvOffsetBasis = 0xcbf29ce484222325;
+constexpr uint64_t kFnvPrime = 0x100000001b3;
+
+constexpr uint64_t Fnv1a(uint64_t hash, std::string_view value) {
+  for (char c : value) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * kFnvPrime;
+  }
+  // Terminate each string so that ("ab", "c") and ("a", "bc") differ.
+  return (hash ^ 0xff) * kFnvPrime;
+}
+
+constexpr uint64_t Fnv1a(uint64_t hash, uint64_t value) {
+  for (size_t i = 0; i < sizeof(value); ++i) {
+    hash = (hash ^ ((value >> (8 * i)) & 0xff)) * kFnvPrime;
+  }
+  return hash;
+}
+
+std::string_view AsString(ConstByteSpan data) {
+  return std::string_view(reinterpret_cast<const char*>(data.data()),
+                          data.size());
+}
+
+// Reads counter data as a little-endian unsigned integer, as the Python
+// trace tools do.
+int64_t ReadCounterValue(ConstByteSpan data) {
+  uint64_t value = 0;
+  const size_t size = std::min(data.size(), sizeof(value));
+  for (size_t i = 0; i < size; ++i) {
+    value |= static_cast<uint64_t>(data[i]) << (8 * i);
+  }
+  return static_cast<int64_t>(value);
+}
+
+void AppendHex(ConstByteSpan data, std::string& out) {
+  constexpr std::string_view kHexDigits = "0123456789abcdef";
+  out.clear();
+  for (std::byte b : data) {
+    const auto value = static_cast<uint8_t>(b);
+    out.push_back(kHexDigits[value >> 4]);
+    out.push_back(kHexDigits[value & 0xf]);
+  }
+}
+
+}  // namespace
+
+Status PerfettoExporter::AddEvent(const DecodedEvent& event) {
+  TrackKind kind = TrackKind::kNamed;
+  uint32_t type = track_event::kTypeInstant;
+  std::string_view name = event.label;
+  std::string_view track_name;
+  uint64_t trace_id = 0;
+
+  switch (event.type) {
+    case EventType::PW_TRACE_EVENT_TYPE_DURATION_START:
+      type = track_event::kTypeSliceBegin;
+      track_name = event.label;
+      break;
+    case EventType::PW_TRACE_EVENT_TYPE_DURATION_END:
+      type = track_event::kTypeSliceEnd;
+      track_name = event.label;
+      break;
+    case EventType::PW_TRACE_EVENT_TYPE_DURATION_GROUP_START:
+      type = track_event::kTypeSliceBegin;
+      track_name = event.group;
+      break;
+    case EventType::PW_TRACE_EVENT_TYPE_DURATION_GROUP_END:
+      type = track_event::kTypeSliceEnd;
+      track_name = event.group;
+      break;
+    case EventType::PW_TRACE_EVENT_TYPE_INSTANT:
+      break;
+    case EventType::PW_TRACE_EVENT_TYPE_INSTANT_GROUP:
+      track_name = event.group;
+      break;
+    case EventType::PW_TRACE_EVENT_TYPE_ASYNC_START:
+      type = track_event::kTypeSliceBegin;
+      kind = TrackKind::kAsync;
+      break;
+    case EventType::PW_TRACE_EVENT_TYPE_ASYNC_STEP:
+      kind = TrackKind::kAsync;
+      break;
+    case EventType::PW_TRACE_EVENT_TYPE_ASYNC_END:
+      type = track_event::kTypeSliceEnd;
+      kind = TrackKind::kAsync;
+      break;
+    case EventType::PW_TRACE_EVENT_TYPE_INVALID:
+      return Status::InvalidArgument();
+  }
+  if (kind == TrackKind::kAsync) {
+    track_name = event.group.empty() ? event.label : event.group;
+    trace_id = event.trace_id.value_or(0);
+  }
+
+  bool has_data_annotation = false;
+  if (event.data_fmt == kArgLabelDataFmt) {
+    name = AsString(event.data);
+  } else if (event.data_fmt == kArgGroupDataFmt) {
+    track_name = AsString(event.data);
+  } else if (event.data_fmt == kArgCounterDataFmt) {
+    kind = TrackKind::kCounter;
+    type = track_event::kTypeCounter;
+    track_name = name;
+  } else if (!event.data_fmt.empty()) {
+    has_data_annotation = true;
+    AppendHex(event.data, data_hex_);
+  }
+  if (kind == TrackKind::kNamed && track_name.empty()) {
+    kind = TrackKind::kProcess;
+  }
+
+  PW_TRY_ASSIGN(const uint64_t track_uuid,
+                GetTrack(kind, event.module, track_name, trace_id));
+
+  protobuf::MemoryEncoder packet(scratch_buffer_);
+  packet.WriteUint64(trace_packet::kTimestamp, event.timestamp_usec * 1000)
+      .IgnoreError();  // Errors are latched and checked by WritePacket().
+  WritePacketHeader(packet);
+  {
+    protobuf::StreamEncoder track_event =
+        packet.GetNestedEncoder(trace_packet::kTrackEvent);
+    track_event.WriteUint64(track_event::kTrackUuid, track_uuid).IgnoreError();
+    track_event.WriteUint32(track_event::kType, type).IgnoreError();
+    if (type == track_event::kTypeCounter) {
+      track_event
+          .WriteInt64(track_event::kCounterValue, ReadCounterValue(event.data))
+          .IgnoreError();
+    } else if (type != track_event::kTypeSliceEnd) {
+      track_event.WriteString(track_event::kName, name).IgnoreError();
+    }
+    if (kind == TrackKind::kAsync) {
+      protobuf::StreamEncoder annotation =
+          track_event.GetNestedEncoder(track_event::kDebugAnnotations);
+      annotation.WriteString(debug_annotation::kName, "id").IgnoreError();
+      annotation.WriteUint64(debug_annotation::kUintValue, trace_id)
+          .IgnoreError();
+    }
+    if (has_data_annotation) {
+      protobuf::StreamEncoder annotation =
+          track_event.GetNestedEncoder(track_event::kDebugAnnotations);
+      annotation.WriteString(debug_annotation::kName, "data").IgnoreError();
+      annotation.WriteString(debug_annotation::kStringValue, data_hex_)
+          .IgnoreError();
+    }
+  }
+  PW_TRY(WritePacket(packet));
+  ++events_written_;
+
+  // The slice on an async track has ended, so the track may be forgotten. It
+  // is described again if the trace ID is reused.
+  if (kind == TrackKind::kAsync && type == track_event::kTypeSliceEnd) {
+    described_tracks_.erase(track_uuid);
+  }
+  return OkStatus();
+}
+
+Status PerfettoExporter::ExportSizePrefixed(TokenizedDecoder& decoder,
+                                            stream::Reader& reader) {
+  DecodedEvent event;
+  while (true) {
+    Status status = decoder.ReadSizePrefixed(reader, event);
+    // The decoder reports OUT_OF_RANGE only at an entry's size prefix, so the
+    // capture ended cleanly. A truncated entry is DATA_LOSS.
+    if (status.IsOutOfRange()) {
+      return OkStatus();
+    }
+    if (status.IsDataLoss()) {
+      ++events_dropped_;
+      continue;
+    }
+    PW_TRY(status);
+
+    if (!AddEvent(event).ok()) {
+      PW_TRY(write_status_);
+      ++events_dropped_;
+    }
+  }
+}
+
+Result<uint64_t> PerfettoExporter::GetTrack(TrackKind kind,
+                                            std::string_view module,
+                                            std::string_view name,
+                                            uint64_t trace_id) {
+  const uint64_t process_uuid =
+      Fnv1a(Fnv1a(kFnvOffsetBasis, to_underlying(TrackKind::kProcess)),
+            module);
+  if (described_tracks_.count(process_uuid) == 0) {
+    PW_TRY(WriteTrackDescriptor(process_uuid, TrackKind::kProcess, 0, module));
+    described_tracks_.insert(process_uuid);
+  }
+  if (kind == TrackKind::kProcess) {
+    return process_uuid;
+  }
+
+  const uint64_t uuid =
+      Fnv1a(Fnv1a(Fnv1a(Fnv1a(kFnvOffsetBasis, to_underlying(kind)), module),
+                  name),
+            trace_id);
+  if (described_tracks_.count(uuid) == 0) {
+    PW_TRY(WriteTrackDescriptor(uuid, kind, process_uuid, name));
+    described_tracks_.insert(uuid);
+  }
+  return uuid;
+}
+
+Status PerfettoExporter::WriteTrackDescriptor(uint64_t uuid,
+                                              TrackKind kind,
+                                              uint64_t parent_uuid,
+                                              std::string_view name) {
+  protobuf::MemoryEncoder packet(scratch_buffer_);
+  WritePacketHeader(packet);
+  {
+    protobuf::StreamEncoder descriptor =
+        packet.GetNestedEncoder(trace_packet::kTrackDescriptor);
+    descriptor.WriteUint64(track_descriptor::kUuid, uuid).IgnoreError();
+    if (kind == TrackKind::kProcess) {
+      protobuf::StreamEncoder process =
+          descriptor.GetNestedEncoder(track_descriptor::kProcess);
+      process.WriteInt32(process_descriptor::kPid, next_pid_).IgnoreError();
+      process.WriteString(process_descriptor::kProcessName, name)
+          .IgnoreError();
+    } else {
+      descriptor.WriteUint64(track_descriptor::kParentUuid, parent_uuid)
+          .IgnoreError();
+      descriptor.WriteString(track_descriptor::kName, name).IgnoreError();
+      if (kind == TrackKind::kCounter) {
+        // An empty CounterDescriptor marks this as a counter track.
+        descriptor.GetNestedEncoder(track_descriptor::kCounter);
+      }
+    }
+  }
+  PW_TRY(WritePacket(packet));
+  if (kind == TrackKind::kProcess) {
+    ++next_pid_;
+  }
+  return OkStatus();
+}
+
+void PerfettoExporter::WritePacketHeader(protobuf::StreamEncoder& packet) {
+  packet.WriteUint32(trace_packet::kTrustedPacketSequenceId, kSequenceId)
+      .IgnoreError();
+  if (first_packet_) {
+    packet
+        .WriteUint32(trace_packet::kSequenceFlags,
+                     trace_packet::kSeqIncrementalStateCleared)
+        .IgnoreError();
+    packet.WriteUint32(trace_packet::kPreviousPacketDropped, 1).IgnoreError();
+    packet.WriteBool(trace_packet::kFirstPacketOnSequence, true)
+        .IgnoreError();
+  }
+}
+
+Status PerfettoExporter::WritePacket(const protobuf::MemoryEncoder& packet) {
+  if (!packet.status().ok()) {
+    return Status::ResourceExhausted();
+  }
+  // A TracePacket is written as a length-delimited field of Trace, so the
+  // output can be streamed without knowing its total length.
+  protobuf::StreamEncoder trace(writer_, ByteSpan());
+  write_status_ =
+      trace.WriteBytes(kTracePacketField, ConstByteSpan(packet.data(),
+                                                         packet.size()));
+  PW_TRY(write_status_);
+  first_packet_ = false;
+  return OkStatus();
+}
+
+}  // namespace pw::trace
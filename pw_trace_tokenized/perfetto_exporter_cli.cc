@@ -0,0 +1,97 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Converts a tokenized trace to a Perfetto trace file.
+//
+// Usage: pw_trace_tokenized_perfetto_cli TOKEN_DB_CSV TICKS_PER_SEC INPUT OUTPUT
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "pw_result/result.h"
+#include "pw_status/status.h"
+#include "pw_stream/std_file_stream.h"
+#include "pw_tokenizer/detokenize.h"
+#include "pw_trace_tokenized/decoder.h"
+#include "pw_trace_tokenized/perfetto_exporter.h"
+
+namespace pw::trace {
+namespace {
+
+void Usage() {
+  std::cerr << "Usage: pw_trace_tokenized_perfetto_cli TOKEN_DB_CSV "
+               "TICKS_PER_SEC INPUT OUTPUT"
+            << std::endl;
+  std::cerr << "  TOKEN_DB_CSV   Token database of the traced firmware, in CSV "
+               "format"
+            << std::endl;
+  std::cerr << "  TICKS_PER_SEC  Rate of the trace clock" << std::endl;
+  std::cerr << "  INPUT          Size-prefixed trace events, as read from the "
+               "transfer handler"
+            << std::endl;
+  std::cerr << "  OUTPUT         Perfetto trace file to write" << std::endl;
+}
+
+int MainInNamespace(int argc, char* argv[]) {
+  if (argc != 5) {
+    Usage();
+    return 1;
+  }
+
+  std::ifstream token_db_file(argv[1]);
+  if (!token_db_file) {
+    std::cerr << "Failed to open " << argv[1] << std::endl;
+    return 1;
+  }
+  std::stringstream token_db;
+  token_db << token_db_file.rdbuf();
+  Result<tokenizer::Detokenizer> detokenizer =
+      tokenizer::Detokenizer::FromCsv(token_db.str());
+  if (!detokenizer.ok()) {
+    std::cerr << "Failed to parse token database: "
+              << detokenizer.status().str() << std::endl;
+    return 1;
+  }
+
+  const uint64_t ticks_per_sec = std::strtoull(argv[2], nullptr, 0);
+  if (ticks_per_sec == 0) {
+    std::cerr << "Invalid TICKS_PER_SEC: " << argv[2] << std::endl;
+    return 1;
+  }
+
+  stream::StdFileReader input(argv[3]);
+  stream::StdFileWriter output(argv[4]);
+  TokenizedDecoder decoder(*detokenizer, ticks_per_sec);
+  PerfettoExporter exporter(output);
+  const Status status = exporter.ExportSizePrefixed(decoder, input);
+  output.Close();
+
+  std::cerr << "Wrote " << exporter.events_written() << " events, dropped "
+            << exporter.events_dropped() << std::endl;
+  if (!status.ok()) {
+    std::cerr << "Export failed: " << status.str() << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace pw::trace
+
+int main(int argc, char* argv[]) {
+  return pw::trace::MainInNamespace(argc, argv);
+}
@@ -0,0 +1,100 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <cstddef>
+#include <vector>
+
+#include "pw_assert/check.h"
+#include "pw_bytes/array.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_stream/null_stream.h"
+#include "pw_tokenizer/detokenize.h"
+#include "pw_trace_tokenized/decoder.h"
+#include "pw_trace_tokenized/perfetto_exporter.h"
+
+namespace pw::trace {
+namespace {
+
+// Token string: "event_type|flag|module|group|label|<optional DATA_FMT>"
+constexpr char kTokenDbCsv[] =
+    "00000001,,trace,"
+    "PW_TRACE_EVENT_TYPE_DURATION_START|0|Module||Work\n"
+    "00000002,,trace,"
+    "PW_TRACE_EVENT_TYPE_DURATION_END|0|Module||Work\n"
+    "00000003,,trace,"
+    "PW_TRACE_EVENT_TYPE_ASYNC_START|0|Module|Group|Op\n"
+    "00000004,,trace,"
+    "PW_TRACE_EVENT_TYPE_ASYNC_END|0|Module|Group|Op\n"
+    "00000005,,trace,"
+    "PW_TRACE_EVENT_TYPE_INSTANT|0|Module||Depth|@pw_arg_counter\n";
+
+// Size-prefixed events, as returned by the transfer handler.
+constexpr auto kEvents = bytes::Concat(
+    bytes::Array<0x05, 0x01, 0x00, 0x00, 0x00, 0x01>(),
+    bytes::Array<0x06, 0x03, 0x00, 0x00, 0x00, 0x01, 0x2a>(),
+    bytes::Array<0x09, 0x05, 0x00, 0x00, 0x00, 0x01, 0x07, 0x00, 0x00, 0x00>(),
+    bytes::Array<0x06, 0x04, 0x00, 0x00, 0x00, 0x01, 0x2a>(),
+    bytes::Array<0x05, 0x02, 0x00, 0x00, 0x00, 0x01>());
+constexpr size_t kEventsPerCopy = 5;
+constexpr size_t kCopies = 200;
+
+// A capture of kEventsPerCopy * kCopies events.
+const std::vector<std::byte>& Capture() {
+  static const std::vector<std::byte> capture = [] {
+    std::vector<std::byte> bytes;
+    for (size_t i = 0; i < kCopies; ++i) {
+      bytes.insert(bytes.end(), kEvents.begin(), kEvents.end());
+    }
+    return bytes;
+  }();
+  return capture;
+}
+
+tokenizer::Detokenizer& GetDetokenizer() {
+  static tokenizer::Detokenizer detokenizer =
+      tokenizer::Detokenizer::FromCsv(kTokenDbCsv).value();
+  return detokenizer;
+}
+
+void DecodeCapture(perf_test::State& state) {
+  TokenizedDecoder decoder(GetDetokenizer(), 1000);
+  DecodedEvent event;
+  while (state.KeepRunning()) {
+    stream::MemoryReader reader(Capture());
+    size_t events = 0;
+    while (decoder.ReadSizePrefixed(reader, event).ok()) {
+      ++events;
+    }
+    PW_CHECK_UINT_EQ(events, kEventsPerCopy * kCopies);
+  }
+}
+
+void ExportCapture(perf_test::State& state) {
+  TokenizedDecoder decoder(GetDetokenizer(), 1000);
+  stream::NullStream output;
+  PerfettoExporter exporter(output);
+  while (state.KeepRunning()) {
+    stream::MemoryReader reader(Capture());
+    PW_CHECK_OK(exporter.ExportSizePrefixed(decoder, reader));
+  }
+  PW_CHECK_UINT_EQ(exporter.events_dropped(), 0);
+}
+
+// Each iteration converts 1000 events.
+PW_PERF_TEST(TraceTokenized_DecodeCapture, DecodeCapture);
+PW_PERF_TEST(TraceTokenized_ExportCapture, ExportCapture);
+
+}  // namespace
+}  // namespace pw::trace
@@ -0,0 +1,464 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_trace_tokenized/perfetto_exporter.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pw_assert/check.h"
+#include "pw_bytes/array.h"
+#include "pw_protobuf/decoder.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_tokenizer/detokenize.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::trace {
+namespace {
+
+// The fields of a TracePacket that the exporter writes.
+struct Packet {
+  uint64_t timestamp = 0;
+  uint32_t sequence_id = 0;
+  bool first_on_sequence = false;
+
+  // TrackDescriptor
+  bool is_descriptor = false;
+  uint64_t uuid = 0;
+  uint64_t parent_uuid = 0;
+  std::string track_name;
+  int32_t pid = 0;
+  std::string process_name;
+  bool is_counter_track = false;
+
+  // TrackEvent
+  bool is_event = false;
+  uint64_t track_uuid = 0;
+  uint32_t type = 0;
+  std::string name;
+  int64_t counter_value = 0;
+  std::vector<std::string> annotation_names;
+  std::vector<std::string> annotation_values;
+};
+
+std::string ToString(std::string_view value) { return std::string(value); }
+
+void ParseProcess(ConstByteSpan bytes, Packet& packet) {
+  protobuf::Decoder decoder(bytes);
+  while (decoder.Next().ok()) {
+    std::string_view value;
+    switch (decoder.FieldNumber()) {
+      case 1:
+        PW_CHECK_OK(decoder.ReadInt32(&packet.pid));
+        break;
+      case 6:
+        PW_CHECK_OK(decoder.ReadString(&value));
+        packet.process_name = ToString(value);
+        break;
+    }
+  }
+}
+
+void ParseDescriptor(ConstByteSpan bytes, Packet& packet) {
+  packet.is_descriptor = true;
+  protobuf::Decoder decoder(bytes);
+  while (decoder.Next().ok()) {
+    std::string_view value;
+    ConstByteSpan nested;
+    switch (decoder.FieldNumber()) {
+      case 1:
+        PW_CHECK_OK(decoder.ReadUint64(&packet.uuid));
+        break;
+      case 2:
+        PW_CHECK_OK(decoder.ReadString(&value));
+        packet.track_name = ToString(value);
+        break;
+      case 3:
+        PW_CHECK_OK(decoder.ReadBytes(&nested));
+        ParseProcess(nested, packet);
+        break;
+      case 5:
+        PW_CHECK_OK(decoder.ReadUint64(&packet.parent_uuid));
+        break;
+      case 8:
+        packet.is_counter_track = true;
+        break;
+    }
+  }
+}
+
+void ParseAnnotation(ConstByteSpan bytes, Packet& packet) {
+  protobuf::Decoder decoder(bytes);
+  while (decoder.Next().ok()) {
+    std::string_view value;
+    uint64_t uint_value;
+    switch (decoder.FieldNumber()) {
+      case 3:
+        PW_CHECK_OK(decoder.ReadUint64(&uint_value));
+        packet.annotation_values.push_back(std::to_string(uint_value));
+        break;
+      case 6:
+        PW_CHECK_OK(decoder.ReadString(&value));
+        packet.annotation_values.push_back(ToString(value));
+        break;
+      case 10:
+        PW_CHECK_OK(decoder.ReadString(&value));
+        packet.annotation_names.push_back(ToString(value));
+        break;
+    }
+  }
+}
+
+void ParseEvent(ConstByteSpan bytes, Packet& packet) {
+  packet.is_event = true;
+  protobuf::Decoder decoder(bytes);
+  while (decoder.Next().ok()) {
+    std::string_view value;
+    ConstByteSpan nested;
+    switch (decoder.FieldNumber()) {
+      case 4:
+        PW_CHECK_OK(decoder.ReadBytes(&nested));
+        ParseAnnotation(nested, packet);
+        break;
+      case 9:
+        PW_CHECK_OK(decoder.ReadUint32(&packet.type));
+        break;
+      case 11:
+        PW_CHECK_OK(decoder.ReadUint64(&packet.track_uuid));
+        break;
+      case 23:
+        PW_CHECK_OK(decoder.ReadString(&value));
+        packet.name = ToString(value);
+        break;
+      case 30:
+        PW_CHECK_OK(decoder.ReadInt64(&packet.counter_value));
+        break;
+    }
+  }
+}
+
+std::vector<Packet> ParseTrace(ConstByteSpan trace) {
+  std::vector<Packet> packets;
+  protobuf::Decoder trace_decoder(trace);
+  while (trace_decoder.Next().ok()) {
+    PW_CHECK_UINT_EQ(trace_decoder.FieldNumber(), 1u);
+    ConstByteSpan packet_bytes;
+    PW_CHECK_OK(trace_decoder.ReadBytes(&packet_bytes));
+
+    Packet& packet = packets.emplace_back();
+    protobuf::Decoder decoder(packet_bytes);
+    while (decoder.Next().ok()) {
+      ConstByteSpan nested;
+      switch (decoder.FieldNumber()) {
+        case 8:
+          PW_CHECK_OK(decoder.ReadUint64(&packet.timestamp));
+          break;
+        case 10:
+          PW_CHECK_OK(decoder.ReadUint32(&packet.sequence_id));
+          break;
+        case 11:
+          PW_CHECK_OK(decoder.ReadBytes(&nested));
+          ParseEvent(nested, packet);
+          break;
+        case 60:
+          PW_CHECK_OK(decoder.ReadBytes(&nested));
+          ParseDescriptor(nested, packet);
+          break;
+        case 87:
+          PW_CHECK_OK(decoder.ReadBool(&packet.first_on_sequence));
+          break;
+      }
+    }
+  }
+  return packets;
+}
+
+constexpr uint32_t kSliceBegin = 1;
+constexpr uint32_t kSliceEnd = 2;
+constexpr uint32_t kInstant = 3;
+constexpr uint32_t kCounter = 4;
+
+DecodedEvent MakeEvent(EventType type,
+                       std::string_view label,
+                       uint64_t timestamp_usec,
+                       std::string_view group = "") {
+  DecodedEvent event;
+  event.type = type;
+  event.module = "Module";
+  event.group = group;
+  event.label = label;
+  event.timestamp_usec = timestamp_usec;
+  return event;
+}
+
+class PerfettoExporterTest : public ::testing::Test {
+ protected:
+  PerfettoExporterTest() : writer_(buffer_), exporter_(writer_) {}
+
+  std::vector<Packet> Packets() { return ParseTrace(writer_.WrittenData()); }
+
+  std::array<std::byte, 4096> buffer_{};
+  stream::MemoryWriter writer_;
+  PerfettoExporter exporter_;
+};
+
+TEST_F(PerfettoExporterTest, DurationEvents) {
+  ASSERT_EQ(exporter_.AddEvent(MakeEvent(
+                EventType::PW_TRACE_EVENT_TYPE_DURATION_START, "Work", 10)),
+            OkStatus());
+  ASSERT_EQ(exporter_.AddEvent(MakeEvent(
+                EventType::PW_TRACE_EVENT_TYPE_DURATION_END, "Work", 25)),
+            OkStatus());
+  EXPECT_EQ(exporter_.events_written(), 2u);
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 4u);
+
+  const Packet& process = packets[0];
+  EXPECT_TRUE(process.is_descriptor);
+  EXPECT_TRUE(process.first_on_sequence);
+  EXPECT_EQ(process.sequence_id, 1u);
+  EXPECT_EQ(process.process_name, "Module");
+  EXPECT_EQ(process.pid, 1);
+
+  const Packet& track = packets[1];
+  EXPECT_TRUE(track.is_descriptor);
+  EXPECT_FALSE(track.first_on_sequence);
+  EXPECT_EQ(track.parent_uuid, process.uuid);
+  EXPECT_EQ(track.track_name, "Work");
+  EXPECT_NE(track.uuid, process.uuid);
+
+  const Packet& begin = packets[2];
+  EXPECT_TRUE(begin.is_event);
+  EXPECT_EQ(begin.sequence_id, 1u);
+  EXPECT_EQ(begin.timestamp, 10'000u);
+  EXPECT_EQ(begin.track_uuid, track.uuid);
+  EXPECT_EQ(begin.type, kSliceBegin);
+  EXPECT_EQ(begin.name, "Work");
+
+  const Packet& end = packets[3];
+  EXPECT_EQ(end.timestamp, 25'000u);
+  EXPECT_EQ(end.track_uuid, track.uuid);
+  EXPECT_EQ(end.type, kSliceEnd);
+}
+
+TEST_F(PerfettoExporterTest, InstantEvents) {
+  ASSERT_EQ(exporter_.AddEvent(MakeEvent(
+                EventType::PW_TRACE_EVENT_TYPE_INSTANT, "Ping", 1)),
+            OkStatus());
+  ASSERT_EQ(
+      exporter_.AddEvent(MakeEvent(
+          EventType::PW_TRACE_EVENT_TYPE_INSTANT_GROUP, "Pong", 2, "Group")),
+      OkStatus());
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 4u);
+  const Packet& process = packets[0];
+
+  // Instants without a group are on the module's track.
+  EXPECT_EQ(packets[1].track_uuid, process.uuid);
+  EXPECT_EQ(packets[1].type, kInstant);
+  EXPECT_EQ(packets[1].name, "Ping");
+
+  EXPECT_EQ(packets[2].track_name, "Group");
+  EXPECT_EQ(packets[2].parent_uuid, process.uuid);
+  EXPECT_EQ(packets[3].track_uuid, packets[2].uuid);
+  EXPECT_EQ(packets[3].name, "Pong");
+}
+
+TEST_F(PerfettoExporterTest, AsyncTrackIsDescribedAgainAfterEnd) {
+  DecodedEvent start = MakeEvent(
+      EventType::PW_TRACE_EVENT_TYPE_ASYNC_START, "Op", 1, "Group");
+  start.trace_id = 7;
+  DecodedEvent end = start;
+  end.type = EventType::PW_TRACE_EVENT_TYPE_ASYNC_END;
+
+  ASSERT_EQ(exporter_.AddEvent(start), OkStatus());
+  ASSERT_EQ(exporter_.AddEvent(end), OkStatus());
+  ASSERT_EQ(exporter_.AddEvent(start), OkStatus());
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 6u);
+  const Packet& track = packets[1];
+  EXPECT_EQ(track.track_name, "Group");
+  EXPECT_EQ(packets[2].track_uuid, track.uuid);
+  EXPECT_EQ(packets[2].type, kSliceBegin);
+  ASSERT_EQ(packets[2].annotation_names.size(), 1u);
+  EXPECT_EQ(packets[2].annotation_names[0], "id");
+  EXPECT_EQ(packets[2].annotation_values[0], "7");
+  EXPECT_EQ(packets[3].type, kSliceEnd);
+
+  EXPECT_TRUE(packets[4].is_descriptor);
+  EXPECT_EQ(packets[4].uuid, track.uuid);
+  EXPECT_EQ(packets[5].track_uuid, track.uuid);
+}
+
+TEST_F(PerfettoExporterTest, AsyncTraceIdsHaveSeparateTracks) {
+  DecodedEvent first = MakeEvent(
+      EventType::PW_TRACE_EVENT_TYPE_ASYNC_START, "Op", 1, "Group");
+  first.trace_id = 1;
+  DecodedEvent second = first;
+  second.trace_id = 2;
+
+  ASSERT_EQ(exporter_.AddEvent(first), OkStatus());
+  ASSERT_EQ(exporter_.AddEvent(second), OkStatus());
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 5u);
+  EXPECT_NE(packets[2].track_uuid, packets[4].track_uuid);
+}
+
+TEST_F(PerfettoExporterTest, DataFormats) {
+  DecodedEvent counter =
+      MakeEvent(EventType::PW_TRACE_EVENT_TYPE_INSTANT, "Queue", 1);
+  counter.data_fmt = "@pw_arg_counter";
+  constexpr auto kCount = bytes::Array<0x2a, 0x01, 0x00, 0x00>();
+  counter.data.assign(kCount.begin(), kCount.end());
+
+  DecodedEvent label =
+      MakeEvent(EventType::PW_TRACE_EVENT_TYPE_INSTANT, "Label", 2);
+  label.data_fmt = "@pw_arg_label";
+  constexpr auto kName = bytes::String("Named");
+  label.data.assign(kName.begin(), kName.end());
+
+  DecodedEvent group =
+      MakeEvent(EventType::PW_TRACE_EVENT_TYPE_INSTANT, "Grouped", 3);
+  group.data_fmt = "@pw_arg_group";
+  constexpr auto kGroup = bytes::String("Thread");
+  group.data.assign(kGroup.begin(), kGroup.end());
+
+  DecodedEvent other =
+      MakeEvent(EventType::PW_TRACE_EVENT_TYPE_INSTANT, "Other", 4);
+  other.data_fmt = "@pw_py_struct_fmt:H";
+  constexpr auto kOther = bytes::Array<0xab, 0x01>();
+  other.data.assign(kOther.begin(), kOther.end());
+
+  ASSERT_EQ(exporter_.AddEvent(counter), OkStatus());
+  ASSERT_EQ(exporter_.AddEvent(label), OkStatus());
+  ASSERT_EQ(exporter_.AddEvent(group), OkStatus());
+  ASSERT_EQ(exporter_.AddEvent(other), OkStatus());
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 7u);
+
+  EXPECT_TRUE(packets[1].is_counter_track);
+  EXPECT_EQ(packets[1].track_name, "Queue");
+  EXPECT_EQ(packets[2].track_uuid, packets[1].uuid);
+  EXPECT_EQ(packets[2].type, kCounter);
+  EXPECT_EQ(packets[2].counter_value, 298);
+
+  EXPECT_EQ(packets[3].name, "Named");
+  EXPECT_EQ(packets[3].track_uuid, packets[0].uuid);
+
+  EXPECT_EQ(packets[4].track_name, "Thread");
+  EXPECT_EQ(packets[5].track_uuid, packets[4].uuid);
+  EXPECT_EQ(packets[5].name, "Grouped");
+
+  ASSERT_EQ(packets[6].annotation_names.size(), 1u);
+  EXPECT_EQ(packets[6].annotation_names[0], "data");
+  EXPECT_EQ(packets[6].annotation_values[0], "ab01");
+}
+
+TEST_F(PerfettoExporterTest, DropsInvalidAndOversizedEvents) {
+  EXPECT_EQ(exporter_.AddEvent(MakeEvent(
+                EventType::PW_TRACE_EVENT_TYPE_INVALID, "Invalid", 1)),
+            Status::InvalidArgument());
+
+  DecodedEvent large =
+      MakeEvent(EventType::PW_TRACE_EVENT_TYPE_INSTANT, "Large", 2);
+  large.data_fmt = "Bytes";
+  large.data.resize(PerfettoExporter::kMaxPacketSizeBytes);
+  EXPECT_EQ(exporter_.AddEvent(large), Status::ResourceExhausted());
+  EXPECT_EQ(exporter_.events_written(), 0u);
+
+  // Only the module's descriptor was written.
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 1u);
+  EXPECT_TRUE(packets[0].is_descriptor);
+}
+
+TEST_F(PerfettoExporterTest, ExportSizePrefixed) {
+  // Token string: "event_type|flag|module|group|label|<optional DATA_FMT>"
+  static constexpr char kTokenDbCsv[] =
+      "11223344,,trace,PW_TRACE_EVENT_TYPE_INSTANT|0|Module||Tick\n";
+  Result<tokenizer::Detokenizer> detokenizer =
+      tokenizer::Detokenizer::FromCsv(kTokenDbCsv);
+  PW_CHECK_OK(detokenizer);
+  TokenizedDecoder decoder(*detokenizer, 1000);
+
+  constexpr auto kInput = bytes::Concat(
+      // Instant event at 5 ms.
+      bytes::Array<0x05, 0x44, 0x33, 0x22, 0x11, 0x05>(),
+      // An event with an unknown token.
+      bytes::Array<0x05, 0x01, 0x02, 0x03, 0x04, 0x05>(),
+      // Instant event at 7 ms.
+      bytes::Array<0x05, 0x44, 0x33, 0x22, 0x11, 0x02>());
+  stream::MemoryReader reader(kInput);
+
+  EXPECT_EQ(exporter_.ExportSizePrefixed(decoder, reader), OkStatus());
+  EXPECT_EQ(exporter_.events_written(), 2u);
+  EXPECT_EQ(exporter_.events_dropped(), 1u);
+
+  const std::vector<Packet> packets = Packets();
+  ASSERT_EQ(packets.size(), 3u);
+  EXPECT_EQ(packets[1].name, "Tick");
+  EXPECT_EQ(packets[1].timestamp, 5'000'000u);
+  EXPECT_EQ(packets[2].timestamp, 7'000'000u);
+}
+
+TEST_F(PerfettoExporterTest, ExportDropsTruncatedEntry) {
+  static constexpr char kTokenDbCsv[] =
+      "11223344,,trace,PW_TRACE_EVENT_TYPE_INSTANT|0|Module||Tick\n";
+  Result<tokenizer::Detokenizer> detokenizer =
+      tokenizer::Detokenizer::FromCsv(kTokenDbCsv);
+  PW_CHECK_OK(detokenizer);
+  TokenizedDecoder decoder(*detokenizer, 1000);
+
+  constexpr auto kInput = bytes::Concat(
+      bytes::Array<0x05, 0x44, 0x33, 0x22, 0x11, 0x05>(),
+      // The capture ends two bytes into a five-byte entry.
+      bytes::Array<0x05, 0x44, 0x33>());
+  stream::MemoryReader reader(kInput);
+
+  EXPECT_EQ(exporter_.ExportSizePrefixed(decoder, reader), OkStatus());
+  EXPECT_EQ(exporter_.events_written(), 1u);
+  EXPECT_EQ(exporter_.events_dropped(), 1u);
+}
+
+TEST_F(PerfettoExporterTest, ExportStopsOnWriteError) {
+  static constexpr char kTokenDbCsv[] =
+      "11223344,,trace,PW_TRACE_EVENT_TYPE_INSTANT|0|Module||Tick\n";
+  Result<tokenizer::Detokenizer> detokenizer =
+      tokenizer::Detokenizer::FromCsv(kTokenDbCsv);
+  PW_CHECK_OK(detokenizer);
+  TokenizedDecoder decoder(*detokenizer, 1000);
+
+  constexpr auto kInput =
+      bytes::Array<0x05, 0x44, 0x33, 0x22, 0x11, 0x05>();
+  stream::MemoryReader reader(kInput);
+
+  std::array<std::byte, 4> small_buffer;
+  stream::MemoryWriter small_writer(small_buffer);
+  PerfettoExporter exporter(small_writer);
+  EXPECT_EQ(exporter.ExportSizePrefixed(decoder, reader),
+            Status::ResourceExhausted());
+  EXPECT_EQ(exporter.events_dropped(), 0u);
+}
+
+}  // namespace
+}  // namespace pw::trace
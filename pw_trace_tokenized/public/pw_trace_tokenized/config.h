@@ -38,6 +38,26 @@
 #define PW_TRACE_QUEUE_SIZE_EVENTS 5
 #endif  // PW_TRACE_QUEUE_SIZE_EVENTS
 
+/// When enabled, each thread queues its trace events in its own lock-free
+/// queue, instead of all threads sharing one locked queue. Events are merged
+/// in time order when they are flushed to the sinks. Requires `thread_local`
+/// support, and must not be used if trace events are emitted from interrupts.
+#ifndef PW_TRACE_PER_THREAD_QUEUES
+#define PW_TRACE_PER_THREAD_QUEUES 0
+#endif  // PW_TRACE_PER_THREAD_QUEUES
+
+/// The most threads which can have a per-thread queue at a time. Events from
+/// other threads are dropped.
+#ifndef PW_TRACE_PER_THREAD_MAX_THREADS
+#define PW_TRACE_PER_THREAD_MAX_THREADS 8
+#endif  // PW_TRACE_PER_THREAD_MAX_THREADS
+
+/// The number of events which can be queued by each thread. A thread flushes
+/// the queues when its queue is half full, if no other thread is flushing.
+#ifndef PW_TRACE_PER_THREAD_QUEUE_SIZE_EVENTS
+#define PW_TRACE_PER_THREAD_QUEUE_SIZE_EVENTS 32
+#endif  // PW_TRACE_PER_THREAD_QUEUE_SIZE_EVENTS
+
 // --- Config options for time source ----
 
 /// The type for trace time.
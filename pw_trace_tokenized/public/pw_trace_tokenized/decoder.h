@@ -16,9 +16,12 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "pw_result/result.h"
+#include "pw_status/status.h"
 #include "pw_stream/stream.h"
 #include "pw_tokenizer/detokenize.h"
 #include "pw_trace_tokenized/trace_tokenized.h"
@@ -71,9 +74,20 @@ class TokenizedDecoder {
   ///            decoded.
   /// @returns @Result{a decoded event}
   /// * @OUT_OF_RANGE: The stream hit EOF before reading an event.
-  /// * @DATA_LOSS: The event could not be decoded.
+  /// * @DATA_LOSS: The event was truncated or could not be decoded.
   Result<DecodedEvent> ReadSizePrefixed(stream::Reader& reader);
 
+  /// Reads a size-prefixed event into `event`, reusing its storage. Prefer
+  /// this overload when decoding many events.
+  ///
+  /// @returns @Status
+  /// * @OK: `event` holds the decoded event.
+  /// * @OUT_OF_RANGE: The stream hit EOF before reading an event.
+  /// * @DATA_LOSS: The stream ended partway through the event, or the event
+  ///   could not be decoded. The event's bytes were consumed, so the next
+  ///   event can still be read.
+  Status ReadSizePrefixed(stream::Reader& reader, DecodedEvent& event);
+
   /// Decodes a DecodedEvent from a span of data.
   ///
   /// @param[in] data The byte span which a DecodedEvent is decoded.
@@ -85,10 +99,37 @@ class TokenizedDecoder {
   /// * @DATA_LOSS: The event could not be decoded.
   Result<DecodedEvent> Decode(ConstByteSpan data);
 
+  /// Decodes an event into `event`, reusing its storage. On error, the
+  /// contents of `event` are unspecified.
+  ///
+  /// @returns @Status
+  /// * @OK: `event` holds the decoded event.
+  /// * @OUT_OF_RANGE: The data was truncated.
+  /// * @DATA_LOSS: The event could not be decoded.
+  Status Decode(ConstByteSpan data, DecodedEvent& event);
+
  private:
+  // The fields of an event token's string. Each token is detokenized and
+  // parsed once, and the result, including any failure, is cached.
+  struct TokenFields {
+    Status status;
+    EventType type = EventType::PW_TRACE_EVENT_TYPE_INVALID;
+    bool has_data = false;
+    std::string flags_str;
+    std::string module;
+    std::string group;
+    std::string label;
+    std::string data_fmt;
+  };
+
+  const TokenFields& GetTokenFields(uint32_t token);
+  Result<std::string_view> GetTokenLabel(uint32_t label_token);
+
   tokenizer::Detokenizer& detokenizer_;
   const uint64_t ticks_per_sec_;
   uint64_t last_timestamp_us_ = 0;
+  std::unordered_map<uint32_t, TokenFields> token_fields_;
+  std::unordered_map<uint32_t, Result<std::string>> token_labels_;
 
   uint64_t usec_per_tick() const { return 1'000'000 / ticks_per_sec_; }
 };
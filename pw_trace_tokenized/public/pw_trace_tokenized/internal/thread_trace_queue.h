@@ -0,0 +1,99 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "pw_containers/internal/per_thread_queues.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_trace_tokenized/config.h"
+#include "pw_trace_tokenized/internal/trace_tokenized_internal.h"
+
+namespace pw::trace::internal {
+
+// Returns true if trace time `a` is earlier than trace time `b`. Unsigned
+// times are compared as if they wrapped at most once between `a` and `b`.
+inline bool TraceTimeIsBefore(PW_TRACE_TIME_TYPE a, PW_TRACE_TIME_TYPE b) {
+  const PW_TRACE_TIME_TYPE delta = PW_TRACE_GET_TIME_DELTA(a, b);
+  if constexpr (std::is_signed_v<PW_TRACE_TIME_TYPE>) {
+    return delta > 0;
+  } else {
+    return delta != 0 &&
+           delta <= std::numeric_limits<PW_TRACE_TIME_TYPE>::max() / 2;
+  }
+}
+
+// A trace event, with the time at which it occurred, waiting to be encoded.
+struct ThreadTraceEvent {
+  PW_TRACE_TIME_TYPE trace_time;
+  uint32_t trace_token;
+  uint32_t trace_id;
+  pw_trace_EventType event_type;
+  size_t data_size;
+  std::byte data_buffer[PW_TRACE_BUFFER_MAX_DATA_SIZE_BYTES];
+
+  span<const std::byte> data() const {
+    return span<const std::byte>(data_buffer, data_size);
+  }
+};
+
+// Returns true if `a` occurred before `b`.
+inline bool TraceEventIsBefore(const ThreadTraceEvent& a,
+                               const ThreadTraceEvent& b) {
+  return TraceTimeIsBefore(a.trace_time, b.trace_time);
+}
+
+// One queue per tracing thread. Events are pushed in the order they occur, so
+// each queue is in time order and the set drains them with
+// `TraceEventIsBefore`.
+template <size_t kMaxThreads, size_t kEventsPerThread>
+using ThreadTraceQueues = containers::internal::
+    PerThreadQueues<ThreadTraceEvent, kMaxThreads, kEventsPerThread>;
+
+// Adds an event to a thread's queue. Returns RESOURCE_EXHAUSTED if the queue is
+// full, or INVALID_ARGUMENT if the data is too large.
+template <size_t kSize>
+Status TryPushTraceEvent(
+    containers::internal::PerThreadQueue<ThreadTraceEvent, kSize>& queue,
+    PW_TRACE_TIME_TYPE trace_time,
+    uint32_t trace_token,
+    pw_trace_EventType event_type,
+    uint32_t trace_id,
+    const void* data_buffer,
+    size_t data_size) {
+  if (data_size > PW_TRACE_BUFFER_MAX_DATA_SIZE_BYTES) {
+    return Status::InvalidArgument();
+  }
+  ThreadTraceEvent* const event = queue.NextSlot();
+  if (event == nullptr) {
+    return Status::ResourceExhausted();
+  }
+  event->trace_time = trace_time;
+  event->trace_token = trace_token;
+  event->trace_id = trace_id;
+  event->event_type = event_type;
+  event->data_size = data_size;
+  if (data_size != 0) {
+    std::memcpy(event->data_buffer, data_buffer, data_size);
+  }
+  queue.Push();
+  return OkStatus();
+}
+
+}  // namespace pw::trace::internal
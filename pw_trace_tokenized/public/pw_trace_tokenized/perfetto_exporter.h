@@ -0,0 +1,133 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+#include "pw_protobuf/encoder.h"
+#include "pw_result/result.h"
+#include "pw_status/status.h"
+#include "pw_stream/stream.h"
+#include "pw_trace_tokenized/decoder.h"
+
+namespace pw::trace {
+
+/// @module{pw_trace_tokenized}
+
+/// Converts decoded trace events to a Perfetto trace, which can be opened in
+/// the Perfetto UI (https://ui.perfetto.dev).
+///
+/// The output is a `perfetto.protos.Trace` message. Each event is encoded as
+/// a `TracePacket` and written to the output stream as soon as it is added,
+/// so memory use does not grow with the length of the trace. Only the set of
+/// tracks that have been described is kept.
+///
+/// Events are mapped to tracks in the same way as the Python trace tools map
+/// them to JSON:
+///
+/// - Each module is a process.
+/// - Duration events are slices on a track named after their label, or their
+///   group for group events.
+/// - Instant events are instants on the module's track, or on a track named
+///   after their group for group events.
+/// - Async events are slices on a track for each group and trace ID.
+/// - Events with `@pw_arg_counter` data are values on a counter track named
+///   after their label.
+/// - `@pw_arg_label` and `@pw_arg_group` data replace the event's name or
+///   track name. Other data is attached to the event as a hex string.
+class PerfettoExporter {
+ public:
+  /// The largest encoded `TracePacket`, including the event's strings and
+  /// data. Events that do not fit are dropped.
+  static constexpr size_t kMaxPacketSizeBytes = 1024;
+
+  /// @param[in] writer The stream to which the `Trace` message is written.
+  explicit PerfettoExporter(stream::Writer& writer) : writer_(writer) {}
+
+  PerfettoExporter(const PerfettoExporter&) = delete;
+  PerfettoExporter& operator=(const PerfettoExporter&) = delete;
+
+  /// Writes an event, preceded by descriptors for any tracks it is the first
+  /// event to use.
+  ///
+  /// @returns @Status
+  /// * @OK: The event was written.
+  /// * @INVALID_ARGUMENT: The event's type is invalid. Nothing was written.
+  /// * @RESOURCE_EXHAUSTED: The event is larger than `kMaxPacketSizeBytes`.
+  ///   The event was dropped.
+  /// * Any error from writing to the stream.
+  Status AddEvent(const DecodedEvent& event);
+
+  /// Decodes size-prefixed events, as returned by
+  /// pw_trace_tokenized:transfer_handler, from `reader` until it is
+  /// exhausted, and writes them. Events that are truncated, or cannot be
+  /// decoded or encoded, are dropped and counted in `events_dropped()`.
+  ///
+  /// @returns @Status
+  /// * @OK: All of the events in the stream were read.
+  /// * Any error from reading or writing the streams.
+  Status ExportSizePrefixed(TokenizedDecoder& decoder, stream::Reader& reader);
+
+  /// The number of events written.
+  size_t events_written() const { return events_written_; }
+
+  /// The number of events dropped by `ExportSizePrefixed`.
+  size_t events_dropped() const { return events_dropped_; }
+
+ private:
+  enum class TrackKind : uint8_t { kProcess, kNamed, kAsync, kCounter };
+
+  // Returns the UUID of the track, writing its descriptor, and the module's
+  // if it is new.
+  Result<uint64_t> GetTrack(TrackKind kind,
+                            std::string_view module,
+                            std::string_view name,
+                            uint64_t trace_id);
+
+  Status WriteTrackDescriptor(uint64_t uuid,
+                              TrackKind kind,
+                              uint64_t parent_uuid,
+                              std::string_view name);
+
+  // Writes the fields that start every packet.
+  void WritePacketHeader(protobuf::StreamEncoder& packet);
+
+  // Writes an encoded packet to the output stream. Returns RESOURCE_EXHAUSTED
+  // if the packet did not fit in the scratch buffer.
+  Status WritePacket(const protobuf::MemoryEncoder& packet);
+
+  stream::Writer& writer_;
+  Status write_status_;
+  std::array<std::byte, kMaxPacketSizeBytes> scratch_buffer_;
+  std::string data_hex_;
+
+  // Tracks whose descriptors have been written. Async tracks are removed when
+  // their slice ends, so that this does not grow with the number of trace
+  // IDs.
+  std::unordered_set<uint64_t> described_tracks_;
+  int32_t next_pid_ = 1;
+  bool first_packet_ = true;
+  size_t events_written_ = 0;
+  size_t events_dropped_ = 0;
+};
+
+/// @}
+
+}  // namespace pw::trace
@@ -91,7 +91,9 @@ class TraceBuffer {
 /// Resets the trace buffer. All data currently stored in the buffer is lost.
 void ClearBuffer();
 
-/// Gets the ring buffer which contains the data.
+/// Gets the ring buffer which contains the data. If
+/// `PW_TRACE_PER_THREAD_QUEUES` is enabled, queued events are flushed to the
+/// buffer first.
 TraceBuffer* GetBuffer();
 
 /// Makes all entries contiguous (i.e. "dering") and then provides a raw view
@@ -22,6 +22,10 @@
 #include <stdint.h>
 #include <string.h>
 
+#ifdef __cplusplus
+#include <atomic>
+#endif  // __cplusplus
+
 #ifndef PW_TRACE_GET_TIME_DELTA
 #ifdef __cplusplus
 #include <type_traits>
@@ -33,6 +37,10 @@
 #include "pw_trace_tokenized/config.h"
 #include "pw_trace_tokenized/internal/trace_tokenized_internal.h"
 
+#if defined(__cplusplus) && PW_TRACE_PER_THREAD_QUEUES
+#include "pw_trace_tokenized/internal/thread_trace_queue.h"
+#endif  // defined(__cplusplus) && PW_TRACE_PER_THREAD_QUEUES
+
 #ifdef __cplusplus
 namespace pw {
 namespace trace {
@@ -120,14 +128,16 @@ class TraceQueue {
 
 /// C++ API interfact to the tokenized tracer
 /// Example: pw::trace::GetTokenizedTracer().Enable(true);
+///
+/// With `PW_TRACE_PER_THREAD_QUEUES`, only one `TokenizedTracer` may exist at
+/// a time, since each thread finds its queue through a `thread_local`.
 class Callbacks;
 class TokenizedTracer {
  public:
   TokenizedTracer(Callbacks& callbacks) : callbacks_(callbacks) {}
   void Enable(bool enable) {
     if (enable != enabled_ && enable) {
-      event_queue_.Clear();
-      last_trace_time_ = 0;
+      ClearQueue();
     }
     enabled_ = enable;
   }
@@ -141,15 +151,50 @@ class TokenizedTracer {
                         const void* data_buffer,
                         size_t data_size);
 
+  /// Sends the events in the per-thread queues to the sinks, in time order.
+  /// The trace buffer flushes before it is read, so this only needs to be
+  /// called to deliver events to other sinks promptly. Does nothing unless
+  /// `PW_TRACE_PER_THREAD_QUEUES` is enabled.
+  void Flush();
+
+  /// The number of events dropped since tracing was last enabled because they
+  /// could not be queued, for example because their queue was full.
+  size_t events_dropped() const {
+    return events_dropped_.load(std::memory_order_relaxed);
+  }
+
  private:
-  using TraceQueue = internal::TraceQueue<PW_TRACE_QUEUE_SIZE_EVENTS>;
   PW_TRACE_TIME_TYPE last_trace_time_ = 0;
   bool enabled_ = false;
+  std::atomic<size_t> events_dropped_ = 0;
+#if PW_TRACE_PER_THREAD_QUEUES
+  using ThreadQueues =
+      internal::ThreadTraceQueues<PW_TRACE_PER_THREAD_MAX_THREADS,
+                                  PW_TRACE_PER_THREAD_QUEUE_SIZE_EVENTS>;
+  ThreadQueues thread_queues_;
+#else
+  using TraceQueue = internal::TraceQueue<PW_TRACE_QUEUE_SIZE_EVENTS>;
   TraceQueue event_queue_;
+#endif  // PW_TRACE_PER_THREAD_QUEUES
   Callbacks& callbacks_;
 
+  void ClearQueue();
+
+#if PW_TRACE_PER_THREAD_QUEUES
+  // Sends queued events to the sinks. trace_lock must be held.
+  void DrainThreadQueues();
+#else
   void HandleNextItemInQueue(
       const volatile TraceQueue::QueueEventBlock* event_block);
+#endif  // PW_TRACE_PER_THREAD_QUEUES
+
+  // Encodes an event that occurred at `trace_time` and sends it to the sinks.
+  void SendToSinks(uint32_t trace_token,
+                   EventType event_type,
+                   uint32_t trace_id,
+                   PW_TRACE_TIME_TYPE trace_time,
+                   const void* data_buffer,
+                   size_t data_size);
 };
 
 /// @returns A reference of the global tokenized tracer
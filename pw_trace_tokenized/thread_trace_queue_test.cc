@@ -0,0 +1,211 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_trace_tokenized/internal/thread_trace_queue.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "pw_assert/assert.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::trace::internal {
+namespace {
+
+constexpr size_t kQueueSize = 4;
+using Queues = ThreadTraceQueues<3, kQueueSize>;
+using Queue = Queues::Queue;
+
+Status Push(Queue& queue, PW_TRACE_TIME_TYPE time, uint32_t token) {
+  return TryPushTraceEvent(
+      queue, time, token, PW_TRACE_EVENT_TYPE_INSTANT, 0, nullptr, 0);
+}
+
+// Drains `queues`, returning the tokens of the events in the order they were
+// passed to the handler.
+template <size_t kMaxEvents>
+size_t DrainTokens(Queues& queues, std::array<uint32_t, kMaxEvents>& tokens) {
+  size_t count = 0;
+  queues.Drain(TraceEventIsBefore, [&](const ThreadTraceEvent& event) {
+    if (count < tokens.size()) {
+      tokens[count] = event.trace_token;
+    }
+    ++count;
+    return true;
+  });
+  return count;
+}
+
+TEST(ThreadTraceQueue, PushAndPopInOrder) {
+  Queue queue;
+  constexpr std::array<std::byte, 3> kData = {
+      std::byte{1}, std::byte{2}, std::byte{3}};
+  EXPECT_EQ(TryPushTraceEvent(queue,
+                              10,
+                              1,
+                              PW_TRACE_EVENT_TYPE_ASYNC_START,
+                              7,
+                              kData.data(),
+                              kData.size()),
+            OkStatus());
+  EXPECT_EQ(Push(queue, 20, 2), OkStatus());
+  EXPECT_EQ(queue.size(), 2u);
+
+  const ThreadTraceEvent* event = queue.PeekFront();
+  ASSERT_NE(event, nullptr);
+  EXPECT_EQ(event->trace_time, 10u);
+  EXPECT_EQ(event->trace_token, 1u);
+  EXPECT_EQ(event->event_type, PW_TRACE_EVENT_TYPE_ASYNC_START);
+  EXPECT_EQ(event->trace_id, 7u);
+  ASSERT_EQ(event->data().size(), kData.size());
+  EXPECT_EQ(event->data()[2], std::byte{3});
+  queue.PopFront();
+
+  event = queue.PeekFront();
+  ASSERT_NE(event, nullptr);
+  EXPECT_EQ(event->trace_token, 2u);
+  EXPECT_TRUE(event->data().empty());
+  queue.PopFront();
+  EXPECT_EQ(queue.PeekFront(), nullptr);
+}
+
+TEST(ThreadTraceQueue, DropsEventsWhenFull) {
+  Queue queue;
+  for (uint32_t i = 0; i < kQueueSize; ++i) {
+    EXPECT_EQ(Push(queue, i + 1, i), OkStatus());
+  }
+  EXPECT_EQ(Push(queue, 100, 100), Status::ResourceExhausted());
+
+  // Space is freed as events are popped, including across the wrap.
+  queue.PopFront();
+  EXPECT_EQ(Push(queue, 101, 101), OkStatus());
+  EXPECT_EQ(queue.size(), kQueueSize);
+}
+
+TEST(ThreadTraceQueue, RejectsLargeData) {
+  Queue queue;
+  std::array<std::byte, PW_TRACE_BUFFER_MAX_DATA_SIZE_BYTES + 1> data{};
+  EXPECT_EQ(TryPushTraceEvent(queue,
+                              1,
+                              1,
+                              PW_TRACE_EVENT_TYPE_INSTANT,
+                              0,
+                              data.data(),
+                              data.size()),
+            Status::InvalidArgument());
+  EXPECT_EQ(queue.PeekFront(), nullptr);
+}
+
+TEST(ThreadTraceQueue, ComparesWrappedTimes) {
+  constexpr PW_TRACE_TIME_TYPE kMax =
+      std::numeric_limits<PW_TRACE_TIME_TYPE>::max();
+  EXPECT_TRUE(TraceTimeIsBefore(1, 2));
+  EXPECT_FALSE(TraceTimeIsBefore(2, 1));
+  EXPECT_FALSE(TraceTimeIsBefore(2, 2));
+  EXPECT_TRUE(TraceTimeIsBefore(kMax - 1, 3));
+  EXPECT_FALSE(TraceTimeIsBefore(3, kMax - 1));
+}
+
+TEST(ThreadTraceQueues, DrainsInTimeOrder) {
+  Queues queues;
+  Queue* first = queues.Claim();
+  Queue* second = queues.Claim();
+  Queue* third = queues.Claim();
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  ASSERT_NE(third, nullptr);
+  EXPECT_EQ(queues.Claim(), nullptr);
+
+  // Times wrap between the second and third events.
+  constexpr PW_TRACE_TIME_TYPE kMax =
+      std::numeric_limits<PW_TRACE_TIME_TYPE>::max();
+  ASSERT_EQ(Push(*first, kMax - 30, 1), OkStatus());
+  ASSERT_EQ(Push(*first, 40, 4), OkStatus());
+  ASSERT_EQ(Push(*second, kMax - 20, 2), OkStatus());
+  ASSERT_EQ(Push(*second, 50, 5), OkStatus());
+  ASSERT_EQ(Push(*third, 30, 3), OkStatus());
+  ASSERT_EQ(Push(*third, 60, 6), OkStatus());
+
+  std::array<uint32_t, 6> tokens{};
+  ASSERT_EQ(DrainTokens(queues, tokens), 6u);
+  constexpr std::array<uint32_t, 6> kExpected = {1, 2, 3, 4, 5, 6};
+  EXPECT_EQ(tokens, kExpected);
+  EXPECT_EQ(DrainTokens(queues, tokens), 0u);
+}
+
+// Each producer thread pushes kEventsPerThread events with increasing times
+// and its own token, while the test thread drains.
+constexpr uint32_t kEventsPerThread = 1000;
+
+struct Producer {
+  Queues& queues;
+  uint32_t token;
+};
+
+void Produce(const Producer& producer) {
+  Queue* queue = producer.queues.Claim();
+  PW_ASSERT(queue != nullptr);
+  for (uint32_t i = 1; i <= kEventsPerThread; ++i) {
+    // Retry until the test thread drains the queue.
+    while (!Push(*queue, i, producer.token).ok()) {
+    }
+  }
+  queue->Release();
+}
+
+TEST(ThreadTraceQueues, DrainsWhileThreadsPush) {
+  Queues queues;
+  const Producer first{queues, 1};
+  const Producer second{queues, 2};
+
+  thread::test::TestThreadContext first_context;
+  thread::test::TestThreadContext second_context;
+  Thread first_thread(first_context.options(), [&first] { Produce(first); });
+  Thread second_thread(second_context.options(),
+                       [&second] { Produce(second); });
+
+  // Each thread's events must be drained in the order they were pushed.
+  std::array<PW_TRACE_TIME_TYPE, 3> last_time{};
+  std::array<uint32_t, 3> count{};
+  bool in_order = true;
+  auto check = [&](const ThreadTraceEvent& event) {
+    in_order =
+        in_order && event.trace_time == last_time[event.trace_token] + 1;
+    last_time[event.trace_token] = event.trace_time;
+    ++count[event.trace_token];
+    return true;
+  };
+  while (count[1] + count[2] < 2 * kEventsPerThread) {
+    queues.Drain(TraceEventIsBefore, check);
+  }
+  first_thread.join();
+  second_thread.join();
+  queues.Drain(TraceEventIsBefore, check);
+
+  EXPECT_TRUE(in_order);
+  EXPECT_EQ(count[1], kEventsPerThread);
+  EXPECT_EQ(count[2], kEventsPerThread);
+
+  // Both queues were released and drained, so they can be claimed again.
+  EXPECT_NE(queues.Claim(), nullptr);
+  EXPECT_NE(queues.Claim(), nullptr);
+  EXPECT_NE(queues.Claim(), nullptr);
+}
+
+}  // namespace
+}  // namespace pw::trace::internal
@@ -28,7 +28,9 @@ namespace pw::trace {
 namespace {
 
 internal::Lock trace_lock;
+#if !PW_TRACE_PER_THREAD_QUEUES
 internal::Lock trace_queue_lock;
+#endif  // !PW_TRACE_PER_THREAD_QUEUES
 
 }  // namespace
 
@@ -85,6 +87,34 @@ void TokenizedTracer::HandleTraceEvent(uint32_t trace_token,
     return;
   }
 
+#if PW_TRACE_PER_THREAD_QUEUES
+  // The time is taken now rather than when the event is encoded, so that
+  // events from different threads can be merged in the order they occurred.
+  // If no queue is available or the queue is full, the event is dropped and
+  // counted in events_dropped().
+  ThreadQueues::Queue* queue = thread_queues_.CurrentThreadQueue();
+  if (queue == nullptr) {
+    events_dropped_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    if (!internal::TryPushTraceEvent(*queue,
+                                     pw_trace_GetTraceTime(),
+                                     event.trace_token,
+                                     event.event_type,
+                                     event.trace_id,
+                                     event.data_buffer,
+                                     event.data_size)
+             .ok()) {
+      events_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Flush once the queue is half full, unless another thread is flushing.
+    if (2 * queue->size() >= PW_TRACE_PER_THREAD_QUEUE_SIZE_EVENTS &&
+        trace_lock.try_lock()) {
+      DrainThreadQueues();
+      trace_lock.unlock();
+    }
+  }
+#else
   {
     std::lock_guard lock(trace_queue_lock);
     // Create trace event
@@ -98,6 +128,7 @@ void TokenizedTracer::HandleTraceEvent(uint32_t trace_token,
                           event.data_size)
              .ok()) {
       // Queue full dropping sample
+      events_dropped_.fetch_add(1, std::memory_order_relaxed);
       // TODO(rgoliver): Allow other strategies, for example: drop oldest, try
       // empty queue, or block.
     }
@@ -112,6 +143,7 @@ void TokenizedTracer::HandleTraceEvent(uint32_t trace_token,
     }
     trace_lock.unlock();
   }
+#endif  // PW_TRACE_PER_THREAD_QUEUES
 
   // Disable after processing if an event callback had set the flag.
   if (PW_TRACE_EVENT_RETURN_FLAGS_DISABLE_AFTER_PROCESSING & ret_flags) {
@@ -119,16 +151,69 @@ void TokenizedTracer::HandleTraceEvent(uint32_t trace_token,
   }
 }
 
+void TokenizedTracer::Flush() {
+#if PW_TRACE_PER_THREAD_QUEUES
+  std::lock_guard lock(trace_lock);
+  DrainThreadQueues();
+#endif  // PW_TRACE_PER_THREAD_QUEUES
+}
+
+void TokenizedTracer::ClearQueue() {
+#if PW_TRACE_PER_THREAD_QUEUES
+  std::lock_guard lock(trace_lock);
+  thread_queues_.Clear();
+#else
+  event_queue_.Clear();
+#endif  // PW_TRACE_PER_THREAD_QUEUES
+  last_trace_time_ = 0;
+  events_dropped_.store(0, std::memory_order_relaxed);
+}
+
+#if PW_TRACE_PER_THREAD_QUEUES
+
+void TokenizedTracer::DrainThreadQueues() {
+  thread_queues_.Drain(
+      internal::TraceEventIsBefore,
+      [this](const internal::ThreadTraceEvent& event) {
+        // An event may be queued after later events from other threads were
+        // already sent. Time deltas cannot be negative, so it is sent with the
+        // time of the last event.
+        PW_TRACE_TIME_TYPE trace_time = event.trace_time;
+        if (last_trace_time_ != 0 &&
+            internal::TraceTimeIsBefore(trace_time, last_trace_time_)) {
+          trace_time = last_trace_time_;
+        }
+        SendToSinks(event.trace_token,
+                    event.event_type,
+                    event.trace_id,
+                    trace_time,
+                    event.data_buffer,
+                    event.data_size);
+        return true;
+      });
+}
+
+#else
+
 void TokenizedTracer::HandleNextItemInQueue(
     const volatile TraceQueue::QueueEventBlock* event_block) {
   // Get next item in queue
-  uint32_t trace_token = event_block->trace_token;
-  EventType event_type = event_block->event_type;
-  uint32_t trace_id = event_block->trace_id;
-  const std::byte* data_buffer =
-      const_cast<const std::byte*>(event_block->data_buffer);
-  size_t data_size = event_block->data_size;
+  SendToSinks(event_block->trace_token,
+              event_block->event_type,
+              event_block->trace_id,
+              pw_trace_GetTraceTime(),
+              const_cast<const std::byte*>(event_block->data_buffer),
+              event_block->data_size);
+}
+
+#endif  // PW_TRACE_PER_THREAD_QUEUES
 
+void TokenizedTracer::SendToSinks(uint32_t trace_token,
+                                  EventType event_type,
+                                  uint32_t trace_id,
+                                  PW_TRACE_TIME_TYPE trace_time,
+                                  const void* data_buffer,
+                                  size_t data_size) {
   // Create header to store trace info
   static constexpr size_t kMaxHeaderSize =
       sizeof(trace_token) + pw::varint::kMaxVarint64SizeBytes +  // time
@@ -138,7 +223,6 @@ void TokenizedTracer::HandleNextItemInQueue(
   size_t header_size = sizeof(trace_token);
 
   // Compute delta of time elapsed since last trace entry.
-  PW_TRACE_TIME_TYPE trace_time = pw_trace_GetTraceTime();
   PW_TRACE_TIME_TYPE delta =
       (last_trace_time_ == 0)
           ? trace_time
@@ -82,6 +82,10 @@ TraceBufferImpl trace_buffer_instance(GetCallbacks());
 void ClearBuffer() { GetBuffer()->Clear(); }
 
 TraceBuffer* GetBuffer() {
+#if PW_TRACE_PER_THREAD_QUEUES
+  // Events in the per-thread queues have not been sent to the buffer yet.
+  GetTokenizedTracer().Flush();
+#endif  // PW_TRACE_PER_THREAD_QUEUES
   return &internal::trace_buffer_instance.GetBuffer();
 }
 
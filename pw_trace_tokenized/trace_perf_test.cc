@@ -0,0 +1,105 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// clang-format off
+#define PW_TRACE_MODULE_NAME "PERF"
+
+#include "pw_trace/trace.h"
+#include "pw_trace_tokenized/trace_tokenized.h"
+// clang-format on
+
+#include <array>
+#include <cstdint>
+
+#include "pw_assert/check.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_trace_tokenized/internal/thread_trace_queue.h"
+
+namespace pw::trace {
+namespace {
+
+// The cost of tracing an event with the tracer as configured, which uses
+// per-thread queues if PW_TRACE_PER_THREAD_QUEUES is enabled, and includes
+// each event's share of encoding it for the sinks.
+void TraceInstant(perf_test::State& state) {
+  PW_TRACE_SET_ENABLED(true);
+  while (state.KeepRunning()) {
+    PW_TRACE_INSTANT("Instant");
+  }
+  GetTokenizedTracer().Flush();
+  PW_TRACE_SET_ENABLED(false);
+}
+
+void TraceInstantData(perf_test::State& state) {
+  PW_TRACE_SET_ENABLED(true);
+  uint32_t value = 0;
+  while (state.KeepRunning()) {
+    PW_TRACE_INSTANT_DATA("InstantData", "@pw_arg_counter", &value, 4);
+    ++value;
+  }
+  GetTokenizedTracer().Flush();
+  PW_TRACE_SET_ENABLED(false);
+}
+
+// The cost of queueing an event in a per-thread queue, and of merging it with
+// the events of other threads.
+constexpr size_t kThreads = PW_TRACE_PER_THREAD_MAX_THREADS;
+constexpr size_t kEventsPerThread = PW_TRACE_PER_THREAD_QUEUE_SIZE_EVENTS;
+using ThreadQueues = internal::ThreadTraceQueues<kThreads, kEventsPerThread>;
+
+ThreadQueues& Queues() {
+  static ThreadQueues queues;
+  return queues;
+}
+
+void ThreadQueuePushAndDrain(perf_test::State& state) {
+  ThreadQueues& queues = Queues();
+  std::array<ThreadQueues::Queue*, kThreads> thread_queues;
+  for (ThreadQueues::Queue*& queue : thread_queues) {
+    queue = queues.Claim();
+    PW_CHECK_NOTNULL(queue);
+  }
+
+  uint32_t sum = 0;
+  auto handler = [&sum](const internal::ThreadTraceEvent& event) {
+    sum += event.trace_token;
+  };
+
+  // Events are pushed to each queue in turn, as if from different threads,
+  // and drained when the queues are half full.
+  PW_TRACE_TIME_TYPE time = 1;
+  size_t next_queue = 0;
+  while (state.KeepRunning()) {
+    PW_CHECK_OK(thread_queues[next_queue]->TryPushBack(
+        time, time, PW_TRACE_EVENT_TYPE_INSTANT, 0, nullptr, 0));
+    ++time;
+    next_queue = (next_queue + 1) % kThreads;
+    if (2 * thread_queues[next_queue]->size() >= kEventsPerThread) {
+      queues.Drain(handler);
+    }
+  }
+  queues.Drain(handler);
+  for (ThreadQueues::Queue* queue : thread_queues) {
+    queue->Release();
+  }
+  queues.Drain(handler);
+  PW_CHECK_UINT_NE(sum, 0);
+}
+
+PW_PERF_TEST(TraceTokenized_Instant, TraceInstant);
+PW_PERF_TEST(TraceTokenized_InstantData, TraceInstantData);
+PW_PERF_TEST(TraceTokenized_ThreadQueue, ThreadQueuePushAndDrain);
+
+}  // namespace
+}  // namespace pw::trace
@@ -31,4 +31,8 @@ Status ClientContext::SeekReader(uint32_t offset) {
   return reader().Seek(offset - initial_offset_);
 }
 
+Status ClientContext::SeekWriter(uint32_t offset) {
+  return writer().Seek(offset - initial_offset_);
+}
+
 }  // namespace pw::transfer::internal
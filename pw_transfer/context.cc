@@ -17,6 +17,7 @@
 
 #include "pw_transfer/internal/context.h"
 
+#include <algorithm>
 #include <chrono>
 #include <limits>
 
@@ -208,52 +209,41 @@ void Context::UpdateTransferParameters(TransmitAction action) {
         std::min(max_parameters_->max_window_size_bytes(),
                  static_cast<uint32_t>(writer().ConservativeWriteLimit()));
   } else {
+    window_controller_.SetLimits(max_chunk_size_bytes_,
+                                 max_parameters_->max_window_size_bytes());
+
     // Adjust the window size based on the latest event in the transfer.
     switch (action) {
       case TransmitAction::kBegin:
       case TransmitAction::kFirstParameters:
+      case TransmitAction::kResume:
         // A transfer always begins with a window size of one chunk, set during
         // initialization. No further handling is required.
         break;
 
       case TransmitAction::kExtend:
-        // Window was received successfully without packet loss and should grow.
-        // Double the window size during slow start, or increase it by a single
-        // chunk in congestion avoidance.
-        if (transmit_phase_ == TransmitPhase::kCongestionAvoidance) {
-          window_size_multiplier_ += 1;
-        } else {
-          window_size_multiplier_ *= 2;
-        }
-
-        // The window size can never exceed the user-specified maximum bytes. If
-        // it does, reduce the multiplier to the largest size that fits.
-        if (window_size_multiplier_ * max_chunk_size_bytes_ >
-            max_parameters_->max_window_size_bytes()) {
-          window_size_multiplier_ =
-              max_parameters_->max_window_size_bytes() / max_chunk_size_bytes_;
-        }
+        // Window was received successfully without packet loss and should
+        // grow.
+        window_controller_.OnWindowExtended();
         break;
 
       case TransmitAction::kRetransmit:
-        // A packet was lost: shrink the window size. Additionally, after the
-        // first packet loss, transition from the slow start to the congestion
-        // avoidance phase of the transfer.
-        if (transmit_phase_ == TransmitPhase::kSlowStart) {
-          transmit_phase_ = TransmitPhase::kCongestionAvoidance;
-        }
-        window_size_multiplier_ =
-            std::max(window_size_multiplier_ / static_cast<uint32_t>(2),
-                     static_cast<uint32_t>(1));
+        // A packet was lost: shrink the window size.
+        window_controller_.OnLoss();
         break;
     }
 
     window_size =
-        std::min({window_size_multiplier_ * max_chunk_size_bytes_,
-                  max_parameters_->max_window_size_bytes(),
-                  static_cast<uint32_t>(writer().ConservativeWriteLimit())});
+        std::min(window_controller_.window_size_bytes(),
+                 static_cast<uint32_t>(writer().ConservativeWriteLimit()));
   }
 
+  // Data beyond the current window end can only be sent in response to an
+  // extension, while a retransmission restarts from the current offset.
+  window_controller_.OnParametersSent(
+      action == TransmitAction::kExtend ? window_end_offset_ : offset_,
+      chrono::SystemClock::now());
+
   window_size_ = window_size;
   window_end_offset_ = offset_ + window_size;
 }
@@ -261,7 +251,8 @@ void Context::UpdateTransferParameters(TransmitAction action) {
 void Context::SetTransferParameters(Chunk& parameters) {
   parameters.set_window_end_offset(window_end_offset_)
       .set_max_chunk_size_bytes(max_chunk_size_bytes_)
-      .set_min_delay_microseconds(kDefaultChunkDelayMicroseconds)
+      .set_min_delay_microseconds(window_controller_.chunk_delay_microseconds(
+          kDefaultChunkDelayMicroseconds))
       .set_offset(offset_);
 }
 
@@ -280,6 +271,7 @@ void Context::SendTransferParameters(TransmitAction action) {
       break;
     case TransmitAction::kFirstParameters:
     case TransmitAction::kRetransmit:
+    case TransmitAction::kResume:
       type = Chunk::Type::kParametersRetransmit;
       break;
     case TransmitAction::kExtend:
@@ -336,7 +328,7 @@ void Context::EncodeAndSendChunk(const Chunk& chunk) {
   }
 #endif
 
-  Result<ConstByteSpan> data = chunk.Encode(thread_->encode_buffer());
+  Result<ConstByteSpan> data = chunk.Encode(thread_->encode_buffer(*this));
   if (!data.ok()) {
     PW_LOG_ERROR("Failed to encode chunk for transfer %u: %d",
                  static_cast<unsigned>(chunk.session_id()),
@@ -396,10 +388,11 @@ void Context::Initialize(const NewTransferEvent& new_transfer) {
   window_end_offset_ = 0;
   max_chunk_size_bytes_ = new_transfer.max_parameters->max_chunk_size_bytes();
 
-  window_size_multiplier_ = 1;
-  transmit_phase_ = TransmitPhase::kSlowStart;
+  ClearOutOfOrderData();
 
   max_parameters_ = new_transfer.max_parameters;
+  window_controller_.Reset(max_parameters_->window_mode(),
+                           chrono::SystemClock::now());
   thread_ = new_transfer.transfer_thread;
 
   last_chunk_sent_ = Chunk::Type::kStart;
@@ -715,7 +708,7 @@ void Context::TransmitNextChunk(bool retransmit_requested) {
         pwpb::Chunk::Fields::kRemainingBytes, total_size);
   }
 
-  ByteSpan buffer = thread_->encode_buffer();
+  ByteSpan buffer = thread_->encode_buffer(*this);
   Result<ByteSpan> data;
 
   if (offset_ < total_size) {
@@ -893,6 +886,11 @@ void Context::HandleReceiveChunk(const Chunk& chunk) {
 
 void Context::HandleReceivedData(const Chunk& chunk) {
   if (chunk.offset() != offset_) {
+    if (chunk.offset() > offset_ && HandleOutOfOrderData(chunk)) {
+      SetTimeout(chunk_timeout_);
+      return;
+    }
+
     if (chunk.offset() + chunk.payload().size() <= offset_ &&
         chunk.type() != Chunk::Type::kStartAckConfirmation) {
       // If the chunk's data has already been received, don't go through a full
@@ -919,6 +917,7 @@ void Context::HandleReceivedData(const Chunk& chunk) {
           static_cast<unsigned>(offset_),
           static_cast<unsigned>(chunk.offset()));
 
+      ClearOutOfOrderData();
       set_transfer_state(TransferState::kRecovery);
       UpdateAndSendTransferParameters(TransmitAction::kRetransmit);
     }
@@ -940,6 +939,7 @@ void Context::HandleReceivedData(const Chunk& chunk) {
     // attempts to the lifetime retry count.
     lifetime_retries_++;
     if (lifetime_retries_ <= max_lifetime_retries_) {
+      ClearOutOfOrderData();
       set_transfer_state(TransferState::kRecovery);
       SetTimeout(chunk_timeout_);
 
@@ -967,6 +967,8 @@ void Context::HandleReceivedData(const Chunk& chunk) {
     }
 
     transfer_rate_.Update(chunk.payload().size());
+    window_controller_.OnDataReceived(
+        offset_, chunk.payload().size(), chrono::SystemClock::now());
   }
 
   // Update the transfer state.
@@ -1015,6 +1017,35 @@ void Context::HandleReceivedData(const Chunk& chunk) {
     return;
   }
 
+  if (out_of_order_end_ != 0 && offset_ >= out_of_order_start_) {
+    // The gap before the data received out of order has been filled. Skip
+    // over the stored data and have the transmitter continue after it.
+    const uint32_t resume_offset = std::max(offset_, out_of_order_end_);
+    ClearOutOfOrderData();
+
+    if (Status status = SeekWriter(resume_offset); !status.ok()) {
+      PW_LOG_ERROR("Transfer %u seek to %u failed with status %u",
+                   id_for_log(),
+                   static_cast<unsigned>(resume_offset),
+                   status.code());
+      TerminateTransfer(Status::DataLoss());
+      return;
+    }
+
+    PW_LOG_DEBUG("Transfer %u filled gap; resuming from offset %u",
+                 id_for_log(),
+                 static_cast<unsigned>(resume_offset));
+    offset_ = resume_offset;
+    UpdateAndSendTransferParameters(TransmitAction::kResume);
+    return;
+  }
+
+  if (out_of_order_end_ != 0) {
+    // Still waiting for the rest of the gap. The window is extended once the
+    // gap has been filled.
+    return;
+  }
+
   if (offset_ == window_end_offset_) {
     // Received all pending data. Advance the transfer parameters.
     UpdateAndSendTransferParameters(TransmitAction::kExtend);
@@ -1032,6 +1063,101 @@ void Context::HandleReceivedData(const Chunk& chunk) {
   }
 }
 
+bool Context::SelectiveRetransmitEnabled() {
+  return window_controller_.mode() == WindowMode::kAdaptive &&
+         writer().seekable(stream::Stream::kBeginning);
+}
+
+bool Context::HandleOutOfOrderData(const Chunk& chunk) {
+  if (!SelectiveRetransmitEnabled() ||
+      chunk.type() == Chunk::Type::kStartAckConfirmation) {
+    return false;
+  }
+
+  const uint32_t chunk_end =
+      chunk.offset() + static_cast<uint32_t>(chunk.payload().size());
+
+  if (out_of_order_end_ == 0) {
+    // Only start tracking a gap if the chunk can be stored as-is. Otherwise,
+    // fall back to rewinding the transmitter.
+    if (!chunk.has_payload() || chunk.IsFinalTransmitChunk() ||
+        chunk_end > window_end_offset_) {
+      return false;
+    }
+  } else if (chunk.offset() != out_of_order_end_ ||
+             chunk.IsFinalTransmitChunk() || chunk_end > window_end_offset_) {
+    if (chunk.offset() < out_of_order_start_ &&
+        chunk_end >= out_of_order_start_) {
+      // The end of the retransmitted gap arrived, but some of the data before
+      // it was lost again. Request the gap once more.
+      window_controller_.OnLoss();
+      SendSelectiveRetransmit();
+    }
+
+    // Otherwise, this data follows a second gap or was already received. Drop
+    // it; it is requested again once the first gap has been filled.
+    PW_LOG_DEBUG("Transfer %u dropping chunk at offset %u during selective "
+                 "retransmission",
+                 id_for_log(),
+                 static_cast<unsigned>(chunk.offset()));
+    return true;
+  }
+
+  // Store the data at its offset, then return the writer to offset_ so that
+  // in-order data continues to be written directly.
+  Status status = SeekWriter(chunk.offset());
+  if (status.ok()) {
+    status = writer().Write(chunk.payload());
+  }
+  if (status.ok()) {
+    status = SeekWriter(offset_);
+  }
+  if (!status.ok()) {
+    PW_LOG_ERROR(
+        "Transfer %u out of order write of %u B at offset %u failed with "
+        "status %u; aborting with DATA_LOSS",
+        id_for_log(),
+        static_cast<unsigned>(chunk.payload().size()),
+        static_cast<unsigned>(chunk.offset()),
+        status.code());
+    TerminateTransfer(Status::DataLoss());
+    return true;
+  }
+
+  transfer_rate_.Update(chunk.payload().size());
+
+  if (out_of_order_end_ != 0) {
+    out_of_order_end_ = chunk_end;
+    return true;
+  }
+
+  PW_LOG_DEBUG(
+      "Transfer %u expected offset %u, received %u; requesting only the "
+      "missing data",
+      id_for_log(),
+      static_cast<unsigned>(offset_),
+      static_cast<unsigned>(chunk.offset()));
+
+  out_of_order_start_ = chunk.offset();
+  out_of_order_end_ = chunk_end;
+  window_controller_.OnLoss();
+  SendSelectiveRetransmit();
+  return true;
+}
+
+void Context::SendSelectiveRetransmit() {
+  // The transmitter only resends the gap, but data which was already in flight
+  // beyond it is still accepted, so window_end_offset_ is left unchanged.
+  Chunk parameters(configured_protocol_version_,
+                   Chunk::Type::kParametersRetransmit);
+  parameters.set_session_id(session_id_);
+  SetTransferParameters(parameters);
+  parameters.set_window_end_offset(out_of_order_start_);
+
+  window_controller_.OnParametersSent(offset_, chrono::SystemClock::now());
+  EncodeAndSendChunk(parameters);
+}
+
 void Context::HandleTerminatingChunk(const Chunk& chunk) {
   switch (chunk.type()) {
     case Chunk::Type::kCompletion:
@@ -1225,6 +1351,7 @@ void Context::Retry() {
         "Receive transfer %u timed out waiting for chunk; resending parameters",
         static_cast<unsigned>(session_id_));
 
+    ClearOutOfOrderData();
     UpdateAndSendTransferParameters(TransmitAction::kRetransmit);
     return;
   }
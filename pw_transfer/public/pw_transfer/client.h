@@ -175,6 +175,12 @@ class Client {
     return OkStatus();
   }
 
+  // Selects how the window of data requested from the server is sized in read
+  // transfers. See pw::transfer::WindowMode.
+  constexpr void set_window_mode(WindowMode window_mode) {
+    max_parameters_.set_window_mode(window_mode);
+  }
+
   constexpr Status set_max_retries(uint32_t max_retries) {
     if (max_retries < 1 || max_retries > max_lifetime_retries_) {
       return Status::InvalidArgument();
@@ -47,6 +47,10 @@ class ClientContext final : public Context {
   // needs to be shifted back for the initial offset.
   Status SeekReader(uint32_t offset) override;
 
+  // Seeks the writer to the offset, taking into account the client side writer
+  // needs to be shifted back for the initial offset.
+  Status SeekWriter(uint32_t offset) override;
+
   // Transfer clients assign a unique handle_id to all active transfer sessions.
   // Unlike session or transfer IDs, this value is local to the client, not
   // requiring any coordination with the transfer server, allowing users of the
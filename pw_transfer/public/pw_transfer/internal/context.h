@@ -27,6 +27,7 @@
 #include "pw_transfer/internal/config.h"
 #include "pw_transfer/internal/event.h"
 #include "pw_transfer/internal/protocol.h"
+#include "pw_transfer/internal/window_controller.h"
 #include "pw_transfer/rate_estimate.h"
 
 namespace pw::transfer::internal {
@@ -40,7 +41,8 @@ class TransferParameters {
                                uint32_t extend_window_divisor)
       : max_window_size_bytes_(max_window_size_bytes),
         max_chunk_size_bytes_(max_chunk_size_bytes),
-        extend_window_divisor_(extend_window_divisor) {
+        extend_window_divisor_(extend_window_divisor),
+        window_mode_(WindowMode::kLegacy) {
     PW_ASSERT(max_window_size_bytes > 0);
     PW_ASSERT(max_chunk_size_bytes > 0);
     PW_ASSERT(extend_window_divisor > 1);
@@ -68,10 +70,16 @@ class TransferParameters {
     extend_window_divisor_ = extend_window_divisor;
   }
 
+  constexpr WindowMode window_mode() const { return window_mode_; }
+  constexpr void set_window_mode(WindowMode window_mode) {
+    window_mode_ = window_mode;
+  }
+
  private:
   uint32_t max_window_size_bytes_;
   uint32_t max_chunk_size_bytes_;
   uint32_t extend_window_divisor_;
+  WindowMode window_mode_;
 };
 
 // Information about a single transfer.
@@ -145,8 +153,8 @@ class Context {
         window_size_(0),
         window_end_offset_(0),
         max_chunk_size_bytes_(std::numeric_limits<uint32_t>::max()),
-        window_size_multiplier_(1),
-        transmit_phase_(TransmitPhase::kSlowStart),
+        out_of_order_start_(0),
+        out_of_order_end_(0),
         max_parameters_(nullptr),
         thread_(nullptr),
         last_chunk_sent_(Chunk::Type::kData),
@@ -167,6 +175,11 @@ class Context {
     return static_cast<stream::Reader&>(*stream_);
   }
 
+  stream::Writer& writer() {
+    PW_DASSERT(active() && type() == TransferType::kReceive);
+    return static_cast<stream::Writer&>(*stream_);
+  }
+
   void NotifyServerCompletion();
 
   uint32_t initial_offset_;
@@ -219,12 +232,11 @@ class Context {
     kExtend,
     // Retransmit from a specified offset.
     kRetransmit,
+    // Continue from a new offset after a selectively retransmitted gap was
+    // filled, without adjusting the window size.
+    kResume,
   };
 
-  // Slow start and congestion avoidance are analogues to the equally named
-  // phases in TCP congestion control.
-  enum class TransmitPhase : bool { kSlowStart, kCongestionAvoidance };
-
   void set_transfer_state(TransferState state) { transfer_state_ = state; }
 
   // The session ID as unsigned instead of uint32_t so it can be used with %u.
@@ -233,11 +245,6 @@ class Context {
     return static_cast<unsigned>(session_id_);
   }
 
-  stream::Writer& writer() {
-    PW_DASSERT(active() && type() == TransferType::kReceive);
-    return static_cast<stream::Writer&>(*stream_);
-  }
-
   bool DataTransferComplete() const {
     return transfer_state_ == TransferState::kTerminating ||
            transfer_state_ == TransferState::kCompleted;
@@ -297,6 +304,10 @@ class Context {
   // seek method.
   virtual Status SeekReader(uint32_t offset) = 0;
 
+  // Seeks the writer destination, applying the same offset adjustment as
+  // SeekReader().
+  virtual Status SeekWriter(uint32_t offset) = 0;
+
   // Processes a chunk in either a transfer or receive transfer.
   void HandleChunkEvent(const ChunkEvent& event);
 
@@ -320,6 +331,26 @@ class Context {
   // Processes a data chunk in a received while in the kWaiting state.
   void HandleReceivedData(const Chunk& chunk);
 
+  // Returns true if data received after a gap in a receive transfer can be
+  // stored so that only the missing data has to be retransmitted.
+  bool SelectiveRetransmitEnabled();
+
+  // Processes a data chunk received beyond the expected offset when selective
+  // retransmission is enabled. Returns false if the chunk could not be stored
+  // and the transfer should rewind to the expected offset instead.
+  bool HandleOutOfOrderData(const Chunk& chunk);
+
+  // Asks the transmitter to resend the data between offset_ and the start of
+  // the data received out of order.
+  void SendSelectiveRetransmit();
+
+  // Discards data received out of order. The writer is always positioned at
+  // offset_, so this only forgets the tracked range.
+  void ClearOutOfOrderData() {
+    out_of_order_start_ = 0;
+    out_of_order_end_ = 0;
+  }
+
   // Sends the first chunk in a legacy transmit transfer.
   void SendInitialLegacyTransmitChunk();
 
@@ -425,8 +456,12 @@ class Context {
   uint32_t window_end_offset_;
   uint32_t max_chunk_size_bytes_;
 
-  uint32_t window_size_multiplier_;
-  TransmitPhase transmit_phase_;
+  // Data received beyond a gap at offset_ in a receive transfer using
+  // selective retransmission. Empty if out_of_order_end_ is 0.
+  uint32_t out_of_order_start_;
+  uint32_t out_of_order_end_;
+
+  WindowController window_controller_;
 
   const TransferParameters* max_parameters_;
   TransferThread* thread_;
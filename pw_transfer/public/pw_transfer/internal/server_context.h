@@ -52,6 +52,10 @@ class ServerContext final : public Context {
   // offset
   Status SeekReader(uint32_t offset) override;
 
+  // Seeks the writer to the given offset. Does not incorporate any initial
+  // offset
+  Status SeekWriter(uint32_t offset) override;
+
   Handler* handler_;
 };
 
@@ -0,0 +1,84 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_span/span.h"
+
+namespace pw::transfer::internal {
+
+class Context;
+
+// Maps session IDs to the transfer contexts running them, so that incoming
+// chunks can be routed to their transfer without scanning every context.
+//
+// The index is an open-addressed hash table with linear probing, stored in a
+// caller-provided buffer. Each context is indexed at most once, under the
+// session ID it was inserted with. The buffer must be sized with
+// CapacityFor() to guarantee that it never fills up.
+//
+// SessionIndex is not synchronized.
+class SessionIndex {
+ public:
+  struct Entry {
+    uint32_t session_id;
+    Context* context;  // nullptr if the entry is unused.
+  };
+
+  // Returns the number of entries needed to index context_count contexts: the
+  // smallest power of two which is at least twice the number of contexts.
+  static constexpr size_t CapacityFor(size_t context_count) {
+    size_t capacity = 1;
+    while (capacity < context_count * 2) {
+      capacity *= 2;
+    }
+    return capacity;
+  }
+
+  // An index without storage. Find() always returns nullptr; nothing may be
+  // inserted.
+  constexpr SessionIndex() = default;
+
+  // Indexes contexts using the provided entries, whose size must be a power of
+  // two. The entries must be value-initialized.
+  constexpr explicit SessionIndex(span<Entry> entries) : entries_(entries) {}
+
+  // True if the index has storage.
+  constexpr bool enabled() const { return !entries_.empty(); }
+
+  // Returns the context indexed under session_id. If several contexts share
+  // the session ID, returns the one at the lowest address, matching the order
+  // of a scan through a span of contexts.
+  Context* Find(uint32_t session_id) const;
+
+  // Indexes context under session_id.
+  //
+  // Precondition: The context is not already indexed.
+  void Insert(uint32_t session_id, Context& context);
+
+  // Removes the entry for context, which was inserted under session_id. Does
+  // nothing if there is no such entry.
+  void Erase(uint32_t session_id, const Context& context);
+
+ private:
+  size_t HomeSlot(uint32_t session_id) const;
+
+  size_t Next(size_t slot) const { return (slot + 1) & (entries_.size() - 1); }
+
+  span<Entry> entries_;
+};
+
+}  // namespace pw::transfer::internal
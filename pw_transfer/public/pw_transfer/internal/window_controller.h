@@ -0,0 +1,191 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_chrono/system_clock.h"
+
+namespace pw::transfer {
+
+/// Selects how the receiver of a transfer sizes the window of data it requests
+/// from the transmitter.
+enum class WindowMode : uint8_t {
+  /// The window starts at one chunk and doubles every time it is extended
+  /// until a chunk is lost. From then on, it grows by one chunk per extension
+  /// and halves on every loss. Lost data is recovered by rewinding the
+  /// transmitter to the first missing offset.
+  kLegacy,
+
+  /// The window is sized from the measured round-trip time and delivery rate
+  /// of the transfer. After a loss, the window is reduced by 30% and regrows
+  /// along a cubic curve back towards its previous size, so high-latency links
+  /// recover their throughput within a few round trips. The receiver also
+  /// paces the transmitter according to the measured delivery rate.
+  ///
+  /// If the receiver's stream is seekable, data which arrives after a gap is
+  /// kept and only the missing range is requested again.
+  kAdaptive,
+};
+
+namespace internal {
+
+// Computes the window size and chunk pacing of a receive transfer from events
+// observed over the course of the transfer.
+//
+// All times are passed in explicitly so that the controller can be driven by a
+// simulated clock.
+class WindowController {
+ public:
+  using Clock = chrono::SystemClock;
+
+  constexpr WindowController()
+      : mode_(WindowMode::kLegacy),
+        phase_(Phase::kSlowStart),
+        loss_in_round_(false),
+        rtt_sample_pending_(false),
+        max_chunk_size_bytes_(1),
+        max_window_size_bytes_(1),
+        window_size_multiplier_(1),
+        window_size_bytes_(0),
+        rtt_sample_offset_(0),
+        rtt_sample_start_(),
+        min_rtt_(kUnknownRtt),
+        round_start_(),
+        round_bytes_(0),
+        bandwidth_samples_{},
+        next_bandwidth_sample_(0),
+        max_bandwidth_(0),
+        full_bandwidth_(0),
+        full_bandwidth_rounds_(0),
+        last_max_window_bytes_(0),
+        rounds_since_reduction_(0),
+        cubic_k_rounds_(0) {}
+
+  // Resets the controller for a new transfer starting at time now.
+  void Reset(WindowMode mode, Clock::time_point now);
+
+  // Sets the chunk and window size limits within which the window is sized.
+  void SetLimits(uint32_t max_chunk_size_bytes, uint32_t max_window_size_bytes);
+
+  WindowMode mode() const { return mode_; }
+
+  // Returns the current window size, in bytes.
+  uint32_t window_size_bytes() const;
+
+  // Returns the inter-chunk delay to request from the transmitter. In legacy
+  // mode, or before the delivery rate has been measured, this is the provided
+  // default.
+  uint32_t chunk_delay_microseconds(uint32_t default_delay_us) const;
+
+  // Smallest round-trip time observed in the transfer, or kUnknownRtt.
+  Clock::duration min_rtt() const { return min_rtt_; }
+
+  // Highest recent delivery rate, or 0 if it has not yet been measured.
+  uint32_t bandwidth_bytes_per_second() const { return max_bandwidth_; }
+
+  // Called when transfer parameters are sent to the transmitter.
+  // response_offset is the lowest offset of data which the transmitter can
+  // only send after processing the parameters. Arrival of that data completes
+  // a round-trip time measurement.
+  void OnParametersSent(uint32_t response_offset, Clock::time_point now);
+
+  // Called for every chunk of data received in order.
+  void OnDataReceived(uint32_t offset,
+                      size_t size_bytes,
+                      Clock::time_point now);
+
+  // Called when the window is extended after data was received without loss.
+  void OnWindowExtended();
+
+  // Called when data is lost or the transfer times out.
+  void OnLoss();
+
+  static constexpr Clock::duration kUnknownRtt = Clock::duration::max();
+
+ private:
+  // Slow start and congestion avoidance are analogues to the equally named
+  // phases in TCP congestion control. In adaptive mode, slow start ends once
+  // the delivery rate stops growing.
+  enum class Phase : bool { kSlowStart, kCongestionAvoidance };
+
+  // Number of round trips over which the maximum delivery rate is tracked.
+  static constexpr size_t kBandwidthFilterRounds = 8;
+
+  // Adaptive slow start ends after the delivery rate has failed to grow by at
+  // least 25% for this many consecutive round trips.
+  static constexpr uint32_t kFullBandwidthRounds = 3;
+
+  // Ends a round trip, updating the delivery rate and sizing the window.
+  void EndRound(Clock::time_point now);
+
+  // Bandwidth-delay product of the link as currently measured, in bytes.
+  uint32_t BandwidthDelayProduct() const;
+
+  // Window size on the cubic growth curve for the current round, in bytes.
+  uint32_t CubicWindowSize() const;
+
+  // Starts a new cubic growth epoch which returns to last_max_window_bytes_.
+  void StartCubicEpoch();
+
+  // Limits a window size to a multiple of the bandwidth-delay product, then
+  // clamps it.
+  uint32_t CapWindow(uint64_t window_size_bytes) const;
+
+  // Limits a window size to between one chunk and the maximum window size.
+  uint32_t ClampWindow(uint64_t window_size_bytes) const;
+
+  WindowMode mode_;
+  Phase phase_;
+  bool loss_in_round_;
+  bool rtt_sample_pending_;
+
+  uint32_t max_chunk_size_bytes_;
+  uint32_t max_window_size_bytes_;
+
+  // Window size in chunks, used in legacy mode.
+  uint32_t window_size_multiplier_;
+
+  // Window size in bytes, used in adaptive mode. 0 represents a single chunk.
+  uint32_t window_size_bytes_;
+
+  // Round-trip time measurement in progress, if rtt_sample_pending_ is set.
+  uint32_t rtt_sample_offset_;
+  Clock::time_point rtt_sample_start_;
+  Clock::duration min_rtt_;
+
+  // Delivery rate measurement. A round trip ends each time an RTT sample
+  // completes.
+  Clock::time_point round_start_;
+  uint32_t round_bytes_;
+  std::array<uint32_t, kBandwidthFilterRounds> bandwidth_samples_;
+  uint8_t next_bandwidth_sample_;
+  uint32_t max_bandwidth_;
+
+  // Adaptive slow start exit detection.
+  uint32_t full_bandwidth_;
+  uint32_t full_bandwidth_rounds_;
+
+  // Cubic window growth: the window size before the last reduction, the
+  // number of round trips since then, and the number of round trips it takes
+  // for the curve to return to its previous size.
+  uint32_t last_max_window_bytes_;
+  uint32_t rounds_since_reduction_;
+  uint32_t cubic_k_rounds_;
+};
+
+}  // namespace internal
+}  // namespace pw::transfer
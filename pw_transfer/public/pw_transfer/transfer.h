@@ -137,6 +137,12 @@ class TransferService : public pw_rpc::raw::Transfer::Service<TransferService> {
     return OkStatus();
   }
 
+  // Selects how the window of data requested from clients is sized in write
+  // transfers. See pw::transfer::WindowMode.
+  constexpr void set_window_mode(WindowMode window_mode) {
+    max_parameters_.set_window_mode(window_mode);
+  }
+
  private:
   // Initializes a TransferService that can be registered with an RPC server.
   //
@@ -13,7 +13,10 @@
 // the License.
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <mutex>
 
 #include "pw_assert/assert.h"
 #include "pw_bytes/span.h"
@@ -23,6 +26,9 @@
 #include "pw_rpc/raw/server_reader_writer.h"
 #include "pw_span/span.h"
 #include "pw_sync/binary_semaphore.h"
+#include "pw_sync/counting_semaphore.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
 #include "pw_sync/timed_thread_notification.h"
 #include "pw_thread/thread_core.h"
 #include "pw_transfer/handler.h"
@@ -31,6 +37,7 @@
 #include "pw_transfer/internal/context.h"
 #include "pw_transfer/internal/event.h"
 #include "pw_transfer/internal/server_context.h"
+#include "pw_transfer/internal/session_index.h"
 
 namespace pw::transfer {
 
@@ -38,6 +45,61 @@ class Client;
 
 namespace internal {
 
+class TransferThread;
+
+// Runs a share of a TransferThread's server transfers on a thread of its own.
+//
+// A worker receives events for its transfers from the TransferThread through
+// a bounded queue, and handles its transfers' timeouts. It has its own chunk
+// and encode buffers, so workers read from and write to their transfers'
+// handlers while other workers are encoding and sending chunks.
+class TransferWorker final : public thread::ThreadCore {
+ public:
+  // An event waiting for the worker, with its own copy of any chunk data.
+  struct QueuedEvent {
+    Event event{};
+
+    // The context the event is for. Broadcast events, which apply to all of
+    // the worker's transfers, have no context.
+    ServerContext* context = nullptr;
+
+    ByteSpan chunk_buffer;
+  };
+
+  TransferWorker() = default;
+
+  TransferWorker(const TransferWorker&) = delete;
+  TransferWorker& operator=(const TransferWorker&) = delete;
+
+ private:
+  friend class TransferThread;
+
+  void Run() final;
+
+  // Blocks until every queued event has been processed. Only one thread may
+  // wait at a time.
+  void WaitUntilEventIsProcessed() {
+    for (size_t i = 0; i < queue_.size(); ++i) {
+      free_slots_.acquire();
+    }
+    free_slots_.release(static_cast<ptrdiff_t>(queue_.size()));
+  }
+
+  TransferThread* thread_ = nullptr;
+  size_t index_ = 0;
+
+  // Ring of events, filled by the transfer thread and emptied by the worker.
+  // free_slots_ counts the slots the transfer thread may fill, and
+  // queued_events_ the events the worker has yet to process.
+  span<QueuedEvent> queue_;
+  size_t next_to_queue_ = 0;    // Only used by the transfer thread.
+  size_t next_to_process_ = 0;  // Only used by the worker.
+  sync::CountingSemaphore free_slots_;
+  sync::CountingSemaphore queued_events_;
+
+  ByteSpan encode_buffer_;
+};
+
 class TransferThread : public thread::ThreadCore {
  public:
   TransferThread(span<ClientContext> client_transfers,
@@ -50,10 +112,38 @@ class TransferThread : public thread::ThreadCore {
         chunk_buffer_(chunk_buffer),
         encode_buffer_(encode_buffer) {}
 
+  // Creates a transfer thread which runs its server transfers on workers
+  // rather than on the transfer thread itself, and looks up transfers by
+  // session ID through indexes stored in the provided entries. Each index must
+  // have SessionIndex::CapacityFor() entries for its contexts, and
+  // server_context_in_use one element per server context.
+  TransferThread(span<ClientContext> client_transfers,
+                 span<ServerContext> server_transfers,
+                 ByteSpan chunk_buffer,
+                 ByteSpan encode_buffer,
+                 span<SessionIndex::Entry> client_index,
+                 span<SessionIndex::Entry> server_index,
+                 span<TransferWorker> workers,
+                 span<bool> server_context_in_use)
+      : client_transfers_(client_transfers),
+        server_transfers_(server_transfers),
+        client_index_(client_index),
+        server_index_(server_index),
+        workers_(workers),
+        server_context_in_use_(server_context_in_use),
+        next_session_id_(1),
+        chunk_buffer_(chunk_buffer),
+        encode_buffer_(encode_buffer) {
+    PW_ASSERT(!workers.empty() &&
+              server_index.size() >=
+                  SessionIndex::CapacityFor(server_transfers.size()) &&
+              server_context_in_use.size() == server_transfers.size());
+  }
+
   /// Set callback to be invoked when a server-side transfer completes or fails.
   ///
-  /// @warning This callback is invoked from the transfer thread, so the
-  /// callback:
+  /// @warning This callback is invoked from the transfer thread, or from a
+  /// worker thread if server transfers run on workers, so the callback:
   /// 1. Must not attempt to interact with the transfer thread, as doing so can
   ///    cause deadlock or internal state corruption.
   /// 2. Must return quickly to avoid stalling the transfer thread or the
@@ -247,9 +337,13 @@ class TransferThread : public thread::ThreadCore {
   void Terminate();
 
   // For testing only: blocks until the next event can be acquired, which means
-  // a previously enqueued event has been processed.
+  // a previously enqueued event has been processed, including by any worker
+  // it was passed on to.
   void WaitUntilEventIsProcessed() {
     next_event_ownership_.acquire();
+    for (TransferWorker& worker : workers_) {
+      worker.WaitUntilEventIsProcessed();
+    }
     next_event_ownership_.release();
   }
 
@@ -266,9 +360,34 @@ class TransferThread : public thread::ThreadCore {
   void EnqueueResourceEvent(uint32_t resource_id,
                             ResourceStatusCallback&& callback);
 
+ protected:
+  // Sets up a worker with its event queue and buffers. chunk_buffers is split
+  // evenly between the queued events. Must be called for every worker before
+  // the transfer thread or any worker runs.
+  void InitializeWorker(size_t index,
+                        span<TransferWorker::QueuedEvent> queue,
+                        ByteSpan chunk_buffers,
+                        ByteSpan encode_buffer) {
+    PW_ASSERT(!queue.empty());
+    const size_t chunk_buffer_size = chunk_buffers.size() / queue.size();
+    PW_ASSERT(chunk_buffer_size >= chunk_buffer_.size());
+
+    TransferWorker& worker = workers_[index];
+    worker.thread_ = this;
+    worker.index_ = index;
+    worker.queue_ = queue;
+    for (size_t i = 0; i < queue.size(); ++i) {
+      queue[i].chunk_buffer =
+          chunk_buffers.subspan(i * chunk_buffer_size, chunk_buffer_size);
+    }
+    worker.free_slots_.release(static_cast<ptrdiff_t>(queue.size()));
+    worker.encode_buffer_ = encode_buffer;
+  }
+
  private:
   friend class transfer::Client;
   friend class Context;
+  friend class TransferWorker;
 
   Function<void(uint32_t, Status)> on_server_completion_;
 
@@ -277,7 +396,11 @@ class TransferThread : public thread::ThreadCore {
   // Finds an active server or client transfer, matching against its legacy ID.
   template <typename T>
   static Context* FindActiveTransferByLegacyId(const span<T>& transfers,
+                                               const SessionIndex& index,
                                                uint32_t session_id) {
+    if (index.enabled()) {
+      return index.Find(session_id);
+    }
     auto transfer =
         std::find_if(transfers.begin(), transfers.end(), [session_id](auto& c) {
           return c.initialized() && c.session_id() == session_id;
@@ -330,11 +453,98 @@ class TransferThread : public thread::ThreadCore {
     return new_transfer;
   }
 
-  const ByteSpan& encode_buffer() const { return encode_buffer_; }
+  // Returns the buffer into which the context encodes its chunks.
+  ByteSpan encode_buffer(const Context& context) const {
+    TransferWorker* worker = WorkerFor(context);
+    return worker != nullptr ? worker->encode_buffer_ : encode_buffer_;
+  }
 
   void Run() final;
 
-  void HandleTimeouts();
+  // True if server transfers run on workers rather than on this thread.
+  bool has_workers() const { return !workers_.empty(); }
+
+  // Returns the worker which runs a context, or nullptr if it runs on the
+  // transfer thread.
+  TransferWorker* WorkerFor(const Context& context) const;
+
+  // Returns the index of a server context within server_transfers_.
+  size_t ServerContextIndex(const Context& context) const {
+    return static_cast<size_t>(static_cast<const ServerContext*>(&context) -
+                               server_transfers_.data());
+  }
+
+  // Passes an event for a server transfer on to the worker running it.
+  void RouteServerEvent(const Event& event);
+
+  // Queues an event for a worker, copying any chunk data into the queue.
+  // Returns false without waiting if the worker's queue is full. Events for
+  // the same transfer are always sent to the same worker, so they remain in
+  // order.
+  bool TryPostToWorker(TransferWorker& worker,
+                       const Event& event,
+                       ServerContext* context);
+
+  // Queues an event in a slot of the worker's queue which the caller has
+  // acquired from free_slots_.
+  void QueueForWorker(TransferWorker& worker,
+                      const Event& event,
+                      ServerContext* context);
+
+  // Sends an event which applies to all server transfers to every worker, and
+  // waits for them to process it.
+  void BroadcastToWorkers(const Event& event);
+
+  // Finds a server context for a new transfer running on a worker, and
+  // indexes it under the transfer's session ID. Sets newly_reserved unless the
+  // transfer was already running in the context.
+  ServerContext* ReserveServerContext(uint32_t session_id,
+                                      bool* newly_reserved);
+
+  // Releases a context reserved for a transfer which was never started.
+  void UnreserveServerContext(ServerContext& context, uint32_t session_id);
+
+  // Runs on a worker thread.
+  void RunWorker(TransferWorker& worker);
+  void HandleWorkerEvent(TransferWorker& worker,
+                         const TransferWorker::QueuedEvent& queued);
+
+  // Returns true if the context is one of server_transfers_.
+  bool IsServerContext(const Context& context) const;
+
+  // True for events which are handled by a server transfer context.
+  static bool IsServerTransferEvent(EventType type);
+
+  // Checks whether a server transfer event routed to a worker still applies
+  // to the context it was routed to.
+  static bool EventMatchesContext(const Event& event, const Context& context);
+
+  // Ends the server transfers run by a worker, or all server transfers if
+  // worker is null, for which should_end returns true, with ABORTED.
+  template <typename Predicate>
+  void EndServerTransfers(const TransferWorker* worker, Predicate&& should_end);
+
+  // Ends the active client transfers of a type.
+  void TerminateClientTransfers(TransferType type,
+                                Status status,
+                                bool skip_initiating = false);
+
+  // Ends the active server transfers which use a server stream.
+  void TerminateServerTransfers(TransferStream stream);
+
+  // Handles an event for a context and updates the session index to match the
+  // context's state afterwards.
+  void HandleContextEvent(Context& context, const Event& event);
+  void HandleContextEvent(Context& context,
+                          const Event& event,
+                          bool was_indexed,
+                          uint32_t indexed_session_id);
+
+  // Updates the index entry of a context which was indexed under
+  // indexed_session_id if was_indexed is set.
+  void UpdateIndex(Context& context,
+                   bool was_indexed,
+                   uint32_t indexed_session_id);
 
   rpc::Writer& stream_for(TransferStream stream);
 
@@ -346,8 +556,26 @@ class TransferThread : public thread::ThreadCore {
     return next_event_ownership_.try_acquire_for(cfg::kEventProcessingTimeout);
   }
 
-  // Returns the earliest timeout among all active transfers, if any.
-  std::optional<chrono::SystemClock::time_point> GetNextTransferTimeout() const;
+  // Returns the earliest timeout among the active transfers run by a worker,
+  // or by the transfer thread itself if worker is null.
+  std::optional<chrono::SystemClock::time_point> GetNextTransferTimeout(
+      const TransferWorker* worker) const;
+
+  // Runs the handlers of any transfers run by the worker, or by the transfer
+  // thread itself if worker is null, which have timed out.
+  void HandleTimeouts(const TransferWorker* worker);
+
+  // Calls a function on each server context run by a worker, or on all of them
+  // if worker is null.
+  template <typename Function>
+  void ForEachServerContext(const TransferWorker* worker, Function&& function) {
+    const size_t step = worker != nullptr ? workers_.size() : 1;
+    for (size_t i = worker != nullptr ? worker->index_ : 0;
+         i < server_transfers_.size();
+         i += step) {
+      function(server_transfers_[i]);
+    }
+  }
 
   uint32_t AssignSessionId();
 
@@ -385,7 +613,13 @@ class TransferThread : public thread::ThreadCore {
   bool TransferHandlerEvent(EventType type, Handler& handler);
 
   void HandleEvent(const Event& event);
-  Context* FindContextForEvent(const Event& event) const;
+
+  // Server events only reach this without workers, when no other thread uses
+  // the server index, so it is not locked.
+  Context* FindContextForEvent(const Event& event) PW_NO_LOCK_SAFETY_ANALYSIS;
+
+  // Reports that no context is available for an event.
+  void HandleMissingContext(const Event& event);
 
   void SendStatusChunk(const SendStatusChunkEvent& event);
 
@@ -417,6 +651,22 @@ class TransferThread : public thread::ThreadCore {
   span<ClientContext> client_transfers_;
   span<ServerContext> server_transfers_;
 
+  // Index of the client transfers. Only used on the transfer thread.
+  SessionIndex client_index_;
+
+  // Index of the server transfers. Contexts are indexed by the transfer thread
+  // when a new transfer is passed to a worker, and removed by the worker once
+  // the transfer has ended. Only used with workers.
+  sync::Mutex server_index_lock_;
+  SessionIndex server_index_ PW_GUARDED_BY(server_index_lock_);
+
+  span<TransferWorker> workers_;
+
+  // Whether each server context is running or has been reserved for a
+  // transfer. Only used with workers.
+  span<bool> server_context_in_use_ PW_GUARDED_BY(server_index_lock_);
+  size_t next_server_context_ PW_GUARDED_BY(server_index_lock_) = 0;
+
   // Identifier to use for the next started transfer, unique over the RPC
   // channel between the transfer client and server.
   //
@@ -431,7 +681,7 @@ class TransferThread : public thread::ThreadCore {
   ByteSpan chunk_buffer_;
 
   // Buffer into which responses are encoded. Only ever used from within the
-  // transfer thread, so no locking is required.
+  // transfer thread, so no locking is required. Workers have their own.
   ByteSpan encode_buffer_;
 
   ResourceStatusCallback resource_status_callback_ = nullptr;
@@ -456,4 +706,75 @@ class Thread final : public internal::TransferThread {
       server_contexts_;
 };
 
+/// A transfer thread which runs its server transfers on a pool of worker
+/// threads, so that concurrent server transfers are processed in parallel.
+///
+/// Server transfers are spread across the workers. Each worker handles the
+/// chunks and timeouts of its transfers, reading from and writing to their
+/// handlers and encoding their chunks in its own buffers. The transfer thread
+/// itself routes incoming chunks to the workers, manages the RPC streams and
+/// handlers, and runs client transfers.
+///
+/// The ``ShardedThread`` must run on its own thread, and each of its workers,
+/// obtained through ``worker()``, on another. Each worker has an encode buffer
+/// and, for each of the ``kWorkerQueueDepth`` events it can queue, a chunk
+/// buffer of ``kWorkerBufferSizeBytes`` bytes, which must be at least as large
+/// as the ``chunk_buffer`` of the ``ShardedThread``. Chunks for a worker whose
+/// queue is full are dropped rather than stalling the ``ShardedThread``.
+template <size_t kMaxConcurrentClientTransfers,
+          size_t kMaxConcurrentServerTransfers,
+          size_t kWorkerCount,
+          size_t kWorkerBufferSizeBytes,
+          size_t kWorkerQueueDepth = 4>
+class ShardedThread final : public internal::TransferThread {
+ public:
+  static_assert(kWorkerCount > 0, "A ShardedThread requires workers");
+  static_assert(kWorkerQueueDepth > 0, "Workers must be able to queue events");
+
+  ShardedThread(ByteSpan chunk_buffer, ByteSpan encode_buffer)
+      : internal::TransferThread(client_contexts_,
+                                 server_contexts_,
+                                 chunk_buffer,
+                                 encode_buffer,
+                                 client_index_,
+                                 server_index_,
+                                 workers_,
+                                 server_context_in_use_) {
+    for (size_t i = 0; i < kWorkerCount; ++i) {
+      InitializeWorker(i,
+                       worker_buffers_[i].queue,
+                       worker_buffers_[i].chunk_buffers,
+                       worker_buffers_[i].encode_buffer);
+    }
+  }
+
+  /// Returns the thread core of one of the workers, each of which must be run
+  /// on its own thread.
+  thread::ThreadCore& worker(size_t index) { return workers_[index]; }
+
+  static constexpr size_t worker_count() { return kWorkerCount; }
+
+ private:
+  struct WorkerBuffers {
+    std::array<internal::TransferWorker::QueuedEvent, kWorkerQueueDepth> queue;
+    std::array<std::byte, kWorkerQueueDepth * kWorkerBufferSizeBytes>
+        chunk_buffers;
+    std::array<std::byte, kWorkerBufferSizeBytes> encode_buffer;
+  };
+
+  std::array<internal::ClientContext, kMaxConcurrentClientTransfers>
+      client_contexts_;
+  std::array<internal::ServerContext, kMaxConcurrentServerTransfers>
+      server_contexts_;
+  std::array<internal::SessionIndex::Entry,
+             internal::SessionIndex::CapacityFor(kMaxConcurrentClientTransfers)>
+      client_index_{};
+  std::array<internal::SessionIndex::Entry,
+             internal::SessionIndex::CapacityFor(kMaxConcurrentServerTransfers)>
+      server_index_{};
+  std::array<bool, kMaxConcurrentServerTransfers> server_context_in_use_{};
+  std::array<internal::TransferWorker, kWorkerCount> workers_;
+  std::array<WorkerBuffers, kWorkerCount> worker_buffers_;
+};
+
 }  // namespace pw::transfer
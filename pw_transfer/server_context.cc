@@ -59,6 +59,10 @@ Status ServerContext::SeekReader(uint32_t offset) {
   return reader().Seek(offset);
 }
 
+Status ServerContext::SeekWriter(uint32_t offset) {
+  return writer().Seek(offset);
+}
+
 void ServerContext::SetInactive() {
   bool was_active = initialized();
 
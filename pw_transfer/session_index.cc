@@ -0,0 +1,91 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_transfer/internal/session_index.h"
+
+#include <functional>
+
+#include "pw_assert/check.h"
+
+namespace pw::transfer::internal {
+
+size_t SessionIndex::HomeSlot(uint32_t session_id) const {
+  // Session IDs are frequently sequential, so mix the bits before masking to
+  // spread neighbouring IDs across the table.
+  uint32_t hash = session_id;
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3bu;
+  hash ^= hash >> 16;
+  return hash & (entries_.size() - 1);
+}
+
+Context* SessionIndex::Find(uint32_t session_id) const {
+  if (!enabled()) {
+    return nullptr;
+  }
+
+  Context* found = nullptr;
+  for (size_t slot = HomeSlot(session_id); entries_[slot].context != nullptr;
+       slot = Next(slot)) {
+    const Entry& entry = entries_[slot];
+    if (entry.session_id == session_id &&
+        (found == nullptr || std::less<>()(entry.context, found))) {
+      found = entry.context;
+    }
+  }
+  return found;
+}
+
+void SessionIndex::Insert(uint32_t session_id, Context& context) {
+  PW_DCHECK(enabled());
+
+  size_t slot = HomeSlot(session_id);
+  for (size_t probes = 0; entries_[slot].context != nullptr; ++probes) {
+    PW_CHECK_UINT_LT(probes, entries_.size(), "Transfer session index is full");
+    slot = Next(slot);
+  }
+  entries_[slot] = {session_id, &context};
+}
+
+void SessionIndex::Erase(uint32_t session_id, const Context& context) {
+  if (!enabled()) {
+    return;
+  }
+
+  size_t hole = HomeSlot(session_id);
+  while (entries_[hole].context != &context ||
+         entries_[hole].session_id != session_id) {
+    if (entries_[hole].context == nullptr) {
+      return;
+    }
+    hole = Next(hole);
+  }
+  entries_[hole] = {};
+
+  // Shift back any following entries which can no longer be reached from their
+  // home slot across the hole, so that lookups never need tombstones.
+  for (size_t slot = Next(hole); entries_[slot].context != nullptr;
+       slot = Next(slot)) {
+    const size_t home = HomeSlot(entries_[slot].session_id);
+    const bool reachable = hole <= slot ? (hole < home && home <= slot)
+                                        : (hole < home || home <= slot);
+    if (!reachable) {
+      entries_[hole] = entries_[slot];
+      entries_[slot] = {};
+      hole = slot;
+    }
+  }
+}
+
+}  // namespace pw::transfer::internal
@@ -17,6 +17,9 @@
 
 #include "pw_transfer/transfer_thread.h"
 
+#include <cstring>
+#include <functional>
+
 #include "pw_assert/check.h"
 #include "pw_log/log.h"
 #include "pw_transfer/client.h"
@@ -48,13 +51,15 @@ void TransferThread::SimulateTimeout(EventType type, uint32_t session_id) {
   WaitUntilEventIsProcessed();
 }
 
+void TransferWorker::Run() { thread_->RunWorker(*this); }
+
 void TransferThread::Run() {
   // Next event starts freed.
   next_event_ownership_.release();
 
   while (true) {
     std::optional<chrono::SystemClock::time_point> timeout =
-        GetNextTransferTimeout();
+        GetNextTransferTimeout(/*worker=*/nullptr);
     bool has_event = false;
 
     if (timeout.has_value()) {
@@ -81,38 +86,92 @@ void TransferThread::Run() {
 
     // Regardless of whether an event was received or not, check for any
     // transfers which have timed out and process them if so.
-    for (Context& context : client_transfers_) {
-      if (context.timed_out()) {
-        context.HandleEvent({.type = EventType::kClientTimeout});
+    HandleTimeouts(/*worker=*/nullptr);
+  }
+}
+
+void TransferThread::RunWorker(TransferWorker& worker) {
+  while (true) {
+    std::optional<chrono::SystemClock::time_point> timeout =
+        GetNextTransferTimeout(&worker);
+    bool has_event = false;
+
+    if (timeout.has_value()) {
+      has_event = worker.queued_events_.try_acquire_until(timeout.value());
+    } else {
+      worker.queued_events_.acquire();
+      has_event = true;
+    }
+
+    if (has_event) {
+      const TransferWorker::QueuedEvent& queued =
+          worker.queue_[worker.next_to_process_];
+      worker.next_to_process_ =
+          (worker.next_to_process_ + 1) % worker.queue_.size();
+
+      HandleWorkerEvent(worker, queued);
+
+      // Sample the event type before the transfer thread may reuse the slot.
+      bool is_terminating = queued.event.type == EventType::kTerminate;
+      worker.free_slots_.release();
+
+      if (is_terminating) {
+        return;
       }
     }
-    for (Context& context : server_transfers_) {
+
+    HandleTimeouts(&worker);
+  }
+}
+
+void TransferThread::HandleTimeouts(const TransferWorker* worker) {
+  if (worker == nullptr) {
+    for (Context& context : client_transfers_) {
       if (context.timed_out()) {
-        context.HandleEvent({.type = EventType::kServerTimeout});
+        HandleContextEvent(context, {.type = EventType::kClientTimeout});
       }
     }
+
+    if (has_workers()) {
+      return;  // Server transfers time out on their workers.
+    }
   }
+
+  ForEachServerContext(worker, [this](ServerContext& context) {
+    if (context.timed_out()) {
+      HandleContextEvent(context, {.type = EventType::kServerTimeout});
+    }
+  });
 }
 
 std::optional<chrono::SystemClock::time_point>
-TransferThread::GetNextTransferTimeout() const {
+TransferThread::GetNextTransferTimeout(const TransferWorker* worker) const {
   std::optional<chrono::SystemClock::time_point> timeout = std::nullopt;
 
-  for (Context& context : client_transfers_) {
+  auto update_timeout = [&timeout](const Context& context) {
     auto ctx_timeout = context.timeout();
     if (ctx_timeout.has_value() &&
         (!timeout.has_value() || ctx_timeout.value() < timeout.value())) {
       timeout = ctx_timeout.value();
     }
-  }
-  for (Context& context : server_transfers_) {
-    auto ctx_timeout = context.timeout();
-    if (ctx_timeout.has_value() &&
-        (!timeout.has_value() || ctx_timeout.value() < timeout.value())) {
-      timeout = ctx_timeout.value();
+  };
+
+  if (worker == nullptr) {
+    for (const Context& context : client_transfers_) {
+      update_timeout(context);
+    }
+    if (has_workers()) {
+      return timeout;
     }
   }
 
+  const size_t step = worker != nullptr ? workers_.size() : 1;
+  for (size_t i = worker != nullptr ? worker->index_ : 0;
+       i < server_transfers_.size();
+       i += step) {
+    update_timeout(server_transfers_[i]);
+  }
+
   return timeout;
 }
 
@@ -426,26 +485,41 @@ bool TransferThread::TransferHandlerEvent(EventType type, Handler& handler) {
   return true;
 }
 
+template <typename Predicate>
+void TransferThread::EndServerTransfers(const TransferWorker* worker,
+                                        Predicate&& should_end) {
+  ForEachServerContext(worker, [&](ServerContext& context) {
+    if (!should_end(context)) {
+      return;
+    }
+    HandleContextEvent(context,
+                       Event{
+                           .type = EventType::kServerEndTransfer,
+                           .end_transfer =
+                               EndTransferEvent{
+                                   .id_type = IdentifierType::Session,
+                                   .id = context.session_id(),
+                                   .status = Status::Aborted().code(),
+                                   .send_status_chunk = false,
+                               },
+                       });
+  });
+}
+
 void TransferThread::HandleEvent(const internal::Event& event) {
   switch (event.type) {
     case EventType::kTerminate:
-      // Terminate server contexts.
-      for (ServerContext& server_context : server_transfers_) {
-        server_context.HandleEvent(Event{
-            .type = EventType::kServerEndTransfer,
-            .end_transfer =
-                EndTransferEvent{
-                    .id_type = IdentifierType::Session,
-                    .id = server_context.session_id(),
-                    .status = Status::Aborted().code(),
-                    .send_status_chunk = false,
-                },
-        });
+      // Terminate server contexts. Workers also exit once they have done so.
+      if (has_workers()) {
+        BroadcastToWorkers(event);
+      } else {
+        EndServerTransfers(
+            /*worker=*/nullptr, [](ServerContext&) { return true; });
       }
 
       // Terminate client contexts.
       for (ClientContext& client_context : client_transfers_) {
-        client_context.HandleEvent(Event{
+        HandleContextEvent(client_context, Event{
             .type = EventType::kClientEndTransfer,
             .end_transfer =
                 EndTransferEvent{
@@ -473,19 +547,14 @@ void TransferThread::HandleEvent(const internal::Event& event) {
       return;
 
     case EventType::kRemoveTransferHandler:
-      for (ServerContext& server_context : server_transfers_) {
-        if (server_context.handler() == event.remove_transfer_handler) {
-          server_context.HandleEvent(Event{
-              .type = EventType::kServerEndTransfer,
-              .end_transfer =
-                  EndTransferEvent{
-                      .id_type = IdentifierType::Session,
-                      .id = server_context.session_id(),
-                      .status = Status::Aborted().code(),
-                      .send_status_chunk = false,
-                  },
-          });
-        }
+      if (has_workers()) {
+        BroadcastToWorkers(event);
+      } else {
+        EndServerTransfers(/*worker=*/nullptr,
+                           [&event](ServerContext& server_context) {
+                             return server_context.handler() ==
+                                    event.remove_transfer_handler;
+                           });
       }
       handlers_.remove(*event.remove_transfer_handler);
       return;
@@ -512,23 +581,14 @@ void TransferThread::HandleEvent(const internal::Event& event) {
       break;
   }
 
+  if (has_workers() && IsServerTransferEvent(event.type)) {
+    RouteServerEvent(event);
+    return;
+  }
+
   Context* ctx = FindContextForEvent(event);
   if (ctx == nullptr) {
-    // No context was found. For new transfer events, report a
-    // RESOURCE_EXHAUSTED error with starting the transfer.
-    if (event.type == EventType::kNewClientTransfer) {
-      // On the client, invoke the completion callback directly.
-      staged_on_completion_(Status::ResourceExhausted());
-    } else if (event.type == EventType::kNewServerTransfer) {
-      // On the server, send a status chunk back to the client.
-      SendStatusChunk(
-          {.session_id = event.new_transfer.session_id,
-           .protocol_version = event.new_transfer.protocol_version,
-           .status = Status::ResourceExhausted().code(),
-           .stream = event.new_transfer.type == TransferType::kTransmit
-                         ? TransferStream::kServerRead
-                         : TransferStream::kServerWrite});
-    }
+    HandleMissingContext(event);
     return;
   }
 
@@ -545,11 +605,30 @@ void TransferThread::HandleEvent(const internal::Event& event) {
     return;
   }
 
-  ctx->HandleEvent(event);
+  HandleContextEvent(*ctx, event);
 }
 
-Context* TransferThread::FindContextForEvent(
-    const internal::Event& event) const {
+void TransferThread::HandleMissingContext(const internal::Event& event) {
+  // No context was found. For new transfer events, report a
+  // RESOURCE_EXHAUSTED error with starting the transfer.
+  if (event.type == EventType::kNewClientTransfer) {
+    // On the client, invoke the completion callback directly.
+    staged_on_completion_(Status::ResourceExhausted());
+  } else if (event.type == EventType::kNewServerTransfer) {
+    // On the server, send a status chunk back to the client.
+    SendStatusChunk(
+        {.session_id = event.new_transfer.session_id,
+         .protocol_version = event.new_transfer.protocol_version,
+         .status = Status::ResourceExhausted().code(),
+         .stream = event.new_transfer.type == TransferType::kTransmit
+                       ? TransferStream::kServerRead
+                       : TransferStream::kServerWrite});
+  }
+}
+
+Context* TransferThread::FindContextForEvent(const internal::Event& event) {
+  PW_DCHECK(!has_workers() || !IsServerTransferEvent(event.type));
+
   switch (event.type) {
     case EventType::kNewClientTransfer:
       return FindNewTransfer(client_transfers_, event.new_transfer.session_id);
@@ -562,6 +641,7 @@ Context* TransferThread::FindContextForEvent(
                                               event.chunk.context_identifier);
       }
       return FindActiveTransferByLegacyId(client_transfers_,
+                                          client_index_,
                                           event.chunk.context_identifier);
 
     case EventType::kServerChunk:
@@ -570,13 +650,16 @@ Context* TransferThread::FindContextForEvent(
                                               event.chunk.context_identifier);
       }
       return FindActiveTransferByLegacyId(server_transfers_,
+                                          server_index_,
                                           event.chunk.context_identifier);
 
     case EventType::kClientTimeout:  // Manually triggered client timeout
       return FindActiveTransferByLegacyId(client_transfers_,
+                                          client_index_,
                                           event.chunk.context_identifier);
     case EventType::kServerTimeout:  // Manually triggered server timeout
       return FindActiveTransferByLegacyId(server_transfers_,
+                                          server_index_,
                                           event.chunk.context_identifier);
 
     case EventType::kClientEndTransfer:
@@ -584,10 +667,12 @@ Context* TransferThread::FindContextForEvent(
         return FindClientTransferByHandleId(event.end_transfer.id);
       }
       return FindActiveTransferByLegacyId(client_transfers_,
+                                          client_index_,
                                           event.end_transfer.id);
     case EventType::kServerEndTransfer:
       PW_DCHECK(event.end_transfer.id_type != IdentifierType::Handle);
       return FindActiveTransferByLegacyId(server_transfers_,
+                                          server_index_,
                                           event.end_transfer.id);
 
     case EventType::kUpdateClientTransfer:
@@ -634,15 +719,12 @@ uint32_t TransferThread::AssignSessionId() {
   return session_id;
 }
 
-template <typename T>
-void TerminateTransfers(span<T> contexts,
-                        TransferType type,
-                        EventType event_type,
-                        Status status,
-                        bool skip_initiating = false) {
+void TransferThread::TerminateClientTransfers(TransferType type,
+                                              Status status,
+                                              bool skip_initiating) {
   Event event;
-  event.type = event_type;
-  for (Context& context : contexts) {
+  event.type = EventType::kClientEndTransfer;
+  for (Context& context : client_transfers_) {
     if (context.active() && context.type() == type) {
       if (skip_initiating && context.is_initiating()) {
         continue;
@@ -654,11 +736,29 @@ void TerminateTransfers(span<T> contexts,
           .send_status_chunk = false,
       };
 
-      context.HandleEvent(event);
+      HandleContextEvent(context, event);
     }
   }
 }
 
+void TransferThread::TerminateServerTransfers(TransferStream stream) {
+  if (has_workers()) {
+    BroadcastToWorkers({
+        .type = EventType::kSetStream,
+        .set_stream = {.stream = stream,
+                       .behavior = internal::SetStreamBehavior::kNewClient},
+    });
+    return;
+  }
+
+  const TransferType type = stream == TransferStream::kServerRead
+                                ? TransferType::kTransmit
+                                : TransferType::kReceive;
+  EndServerTransfers(/*worker=*/nullptr, [type](ServerContext& context) {
+    return context.active() && context.type() == type;
+  });
+}
+
 void TransferThread::CancelExistingStream(OwnedClientStream& stream,
                                           TransferType type) {
   if (stream.stream.active()) {
@@ -677,10 +777,7 @@ void TransferThread::HandleSetStreamEvent(
       if (behavior == internal::SetStreamBehavior::kCloseStream) {
         if (client_read_stream_.client == staged_client_stream_.client) {
           CancelExistingStream(client_read_stream_, TransferType::kReceive);
-          TerminateTransfers(client_transfers_,
-                             TransferType::kReceive,
-                             EventType::kClientEndTransfer,
-                             Status::Aborted());
+          TerminateClientTransfers(TransferType::kReceive, Status::Aborted());
           client_read_stream_.client = nullptr;
           client_read_stream_.stream = rpc::RawClientReaderWriter();
         }
@@ -690,11 +787,8 @@ void TransferThread::HandleSetStreamEvent(
       CancelExistingStream(client_read_stream_, TransferType::kReceive);
 
       bool skip_initiating = behavior == internal::SetStreamBehavior::kReopen;
-      TerminateTransfers(client_transfers_,
-                         TransferType::kReceive,
-                         EventType::kClientEndTransfer,
-                         Status::Aborted(),
-                         skip_initiating);
+      TerminateClientTransfers(
+          TransferType::kReceive, Status::Aborted(), skip_initiating);
 
       client_read_stream_ = std::move(staged_client_stream_);
       client_read_stream_.stream.set_on_next(std::move(staged_client_on_next_));
@@ -716,10 +810,8 @@ void TransferThread::HandleSetStreamEvent(
       if (behavior == internal::SetStreamBehavior::kCloseStream) {
         if (client_write_stream_.client == staged_client_stream_.client) {
           CancelExistingStream(client_write_stream_, TransferType::kTransmit);
-          TerminateTransfers(client_transfers_,
-                             TransferType::kTransmit,
-                             EventType::kClientEndTransfer,
-                             Status::Aborted());
+          TerminateClientTransfers(TransferType::kTransmit,
+                                   Status::Aborted());
           client_write_stream_.client = nullptr;
           client_write_stream_.stream = rpc::RawClientReaderWriter();
         }
@@ -729,11 +821,8 @@ void TransferThread::HandleSetStreamEvent(
       CancelExistingStream(client_write_stream_, TransferType::kTransmit);
 
       bool skip_initiating = behavior == internal::SetStreamBehavior::kReopen;
-      TerminateTransfers(client_transfers_,
-                         TransferType::kTransmit,
-                         EventType::kClientEndTransfer,
-                         Status::Aborted(),
-                         skip_initiating);
+      TerminateClientTransfers(
+          TransferType::kTransmit, Status::Aborted(), skip_initiating);
 
       client_write_stream_ = std::move(staged_client_stream_);
       client_write_stream_.stream.set_on_next(
@@ -753,10 +842,7 @@ void TransferThread::HandleSetStreamEvent(
     }
 
     case TransferStream::kServerRead: {
-      TerminateTransfers(server_transfers_,
-                         TransferType::kTransmit,
-                         EventType::kServerEndTransfer,
-                         Status::Aborted());
+      TerminateServerTransfers(TransferStream::kServerRead);
       server_read_stream_ = std::move(staged_server_stream_);
       server_read_stream_.set_on_next(std::move(staged_server_on_next_));
       server_read_stream_.set_on_error([](Status status) {
@@ -766,10 +852,7 @@ void TransferThread::HandleSetStreamEvent(
     }
 
     case TransferStream::kServerWrite: {
-      TerminateTransfers(server_transfers_,
-                         TransferType::kReceive,
-                         EventType::kServerEndTransfer,
-                         Status::Aborted());
+      TerminateServerTransfers(TransferStream::kServerWrite);
       server_write_stream_ = std::move(staged_server_stream_);
       server_write_stream_.set_on_next(std::move(staged_server_on_next_));
       server_write_stream_.set_on_error([](Status status) {
@@ -825,6 +908,276 @@ void TransferThread::GetResourceState(uint32_t resource_id) {
   resource_status_callback_ = nullptr;
 }
 
+bool TransferThread::IsServerContext(const Context& context) const {
+  const std::less<const Context*> less;
+  return !server_transfers_.empty() &&
+         !less(&context, &server_transfers_.front()) &&
+         !less(&server_transfers_.back(), &context);
+}
+
+TransferWorker* TransferThread::WorkerFor(const Context& context) const {
+  if (!has_workers() || !IsServerContext(context)) {
+    return nullptr;
+  }
+  return &workers_[ServerContextIndex(context) % workers_.size()];
+}
+
+void TransferThread::HandleContextEvent(Context& context, const Event& event) {
+  HandleContextEvent(
+      context, event, context.initialized(), context.session_id());
+}
+
+void TransferThread::HandleContextEvent(Context& context,
+                                        const Event& event,
+                                        bool was_indexed,
+                                        uint32_t indexed_session_id) {
+  context.HandleEvent(event);
+  UpdateIndex(context, was_indexed, indexed_session_id);
+}
+
+void TransferThread::UpdateIndex(Context& context,
+                                 bool was_indexed,
+                                 uint32_t indexed_session_id) {
+  // Contexts are indexed under their session ID for as long as they are
+  // initialized, which includes waiting for a completion acknowledgement.
+  const bool indexed = context.initialized();
+  if (indexed == was_indexed &&
+      (!indexed || indexed_session_id == context.session_id())) {
+    return;
+  }
+
+  if (!IsServerContext(context)) {
+    if (was_indexed) {
+      client_index_.Erase(indexed_session_id, context);
+    }
+    if (indexed && client_index_.enabled()) {
+      client_index_.Insert(context.session_id(), context);
+    }
+    return;
+  }
+
+  // Server contexts are only indexed when they run on workers.
+  if (!has_workers()) {
+    return;
+  }
+
+  std::lock_guard lock(server_index_lock_);
+  if (was_indexed) {
+    server_index_.Erase(indexed_session_id, context);
+  }
+  if (indexed) {
+    server_index_.Insert(context.session_id(), context);
+  } else {
+    // The transfer has ended, so the transfer thread may reuse its context.
+    server_context_in_use_[ServerContextIndex(context)] = false;
+  }
+}
+
+bool TransferThread::IsServerTransferEvent(EventType type) {
+  return type == EventType::kNewServerTransfer ||
+         type == EventType::kServerChunk ||
+         type == EventType::kServerTimeout ||
+         type == EventType::kServerEndTransfer;
+}
+
+ServerContext* TransferThread::ReserveServerContext(uint32_t session_id,
+                                                    bool* newly_reserved) {
+  std::lock_guard lock(server_index_lock_);
+
+  // If the session is already running, restart it in its existing context.
+  if (Context* context = server_index_.Find(session_id); context != nullptr) {
+    *newly_reserved = false;
+    return static_cast<ServerContext*>(context);
+  }
+
+  // Otherwise, take the next free context in turn, which spreads transfers
+  // across the workers. Unlike transfers run on the transfer thread, contexts
+  // waiting for a completion acknowledgement are not reused.
+  for (size_t i = 0; i < server_transfers_.size(); ++i) {
+    const size_t index = (next_server_context_ + i) % server_transfers_.size();
+    if (!server_context_in_use_[index]) {
+      server_context_in_use_[index] = true;
+      server_index_.Insert(session_id, server_transfers_[index]);
+      next_server_context_ = index + 1;
+      *newly_reserved = true;
+      return &server_transfers_[index];
+    }
+  }
+  return nullptr;
+}
+
+void TransferThread::UnreserveServerContext(ServerContext& context,
+                                            uint32_t session_id) {
+  std::lock_guard lock(server_index_lock_);
+  server_index_.Erase(session_id, context);
+  server_context_in_use_[ServerContextIndex(context)] = false;
+}
+
+void TransferThread::RouteServerEvent(const Event& event) {
+  if (event.type == EventType::kNewServerTransfer) {
+    const uint32_t session_id = event.new_transfer.session_id;
+    bool newly_reserved = false;
+    ServerContext* context = ReserveServerContext(session_id, &newly_reserved);
+    if (context == nullptr) {
+      HandleMissingContext(event);
+      return;
+    }
+    if (!TryPostToWorker(*WorkerFor(*context), event, context)) {
+      PW_LOG_WARN("Transfer worker busy; not starting transfer %u",
+                  static_cast<unsigned>(session_id));
+      // A restarted transfer keeps running; the client retries its request.
+      if (newly_reserved) {
+        UnreserveServerContext(*context, session_id);
+        HandleMissingContext(event);
+      }
+    }
+    return;
+  }
+
+  uint32_t id;
+  if (event.type == EventType::kServerEndTransfer) {
+    id = event.end_transfer.id;
+  } else {
+    id = event.chunk.context_identifier;
+  }
+
+  Context* context;
+  {
+    std::lock_guard lock(server_index_lock_);
+    context = server_index_.Find(id);
+  }
+
+  // The worker checks that the transfer is still running when it receives the
+  // event, as its state may change in the meantime. If the worker is busy, the
+  // event is dropped like a lost chunk, and the transfer recovers through its
+  // usual retries.
+  if (context != nullptr &&
+      !TryPostToWorker(*WorkerFor(*context),
+                       event,
+                       static_cast<ServerContext*>(context))) {
+    PW_LOG_WARN("Transfer worker busy; dropped event for transfer %u",
+                static_cast<unsigned>(id));
+  }
+}
+
+bool TransferThread::TryPostToWorker(TransferWorker& worker,
+                                     const Event& event,
+                                     ServerContext* context) {
+  if (!worker.free_slots_.try_acquire()) {
+    return false;
+  }
+  QueueForWorker(worker, event, context);
+  return true;
+}
+
+void TransferThread::QueueForWorker(TransferWorker& worker,
+                                    const Event& event,
+                                    ServerContext* context) {
+  TransferWorker::QueuedEvent& queued = worker.queue_[worker.next_to_queue_];
+  worker.next_to_queue_ = (worker.next_to_queue_ + 1) % worker.queue_.size();
+
+  queued.event = event;
+  queued.context = context;
+
+  // Chunk data is staged in the transfer thread's chunk buffer, which is reused
+  // for the next event, so copy it into the queue.
+  if (event.type == EventType::kServerChunk) {
+    std::memcpy(
+        queued.chunk_buffer.data(), event.chunk.data, event.chunk.size);
+    queued.event.chunk.data = queued.chunk_buffer.data();
+  } else if (event.type == EventType::kNewServerTransfer &&
+             event.new_transfer.raw_chunk_size != 0) {
+    std::memcpy(queued.chunk_buffer.data(),
+                event.new_transfer.raw_chunk_data,
+                event.new_transfer.raw_chunk_size);
+    queued.event.new_transfer.raw_chunk_data = queued.chunk_buffer.data();
+  }
+
+  worker.queued_events_.release();
+}
+
+void TransferThread::BroadcastToWorkers(const Event& event) {
+  // Broadcast events must reach every worker, so wait for space in the queues.
+  for (TransferWorker& worker : workers_) {
+    worker.free_slots_.acquire();
+    QueueForWorker(worker, event, /*context=*/nullptr);
+  }
+  for (TransferWorker& worker : workers_) {
+    worker.WaitUntilEventIsProcessed();
+  }
+}
+
+void TransferThread::HandleWorkerEvent(
+    TransferWorker& worker, const TransferWorker::QueuedEvent& queued) {
+  const Event& event = queued.event;
+  ServerContext* context = queued.context;
+
+  switch (event.type) {
+    case EventType::kTerminate:
+      EndServerTransfers(&worker, [](ServerContext&) { return true; });
+      return;
+
+    case EventType::kRemoveTransferHandler:
+      EndServerTransfers(&worker, [&event](ServerContext& server_context) {
+        return server_context.handler() == event.remove_transfer_handler;
+      });
+      return;
+
+    case EventType::kSetStream: {
+      const TransferType type =
+          event.set_stream.stream == TransferStream::kServerRead
+              ? TransferType::kTransmit
+              : TransferType::kReceive;
+      EndServerTransfers(&worker, [type](ServerContext& server_context) {
+        return server_context.active() && server_context.type() == type;
+      });
+      return;
+    }
+
+    case EventType::kNewServerTransfer:
+      // The transfer thread indexed the context under the new session when it
+      // reserved it.
+      HandleContextEvent(*context,
+                         event,
+                         /*was_indexed=*/true,
+                         event.new_transfer.session_id);
+      return;
+
+    case EventType::kServerChunk:
+    case EventType::kServerTimeout:
+    case EventType::kServerEndTransfer:
+      if (EventMatchesContext(event, *context)) {
+        HandleContextEvent(*context, event);
+      }
+      return;
+
+    case EventType::kNewClientTransfer:
+    case EventType::kClientChunk:
+    case EventType::kClientTimeout:
+    case EventType::kClientEndTransfer:
+    case EventType::kSendStatusChunk:
+    case EventType::kUpdateClientTransfer:
+    case EventType::kAddTransferHandler:
+    case EventType::kGetResourceStatus:
+    default:
+      PW_CRASH("Unexpected event type for a transfer worker");
+  }
+}
+
+bool TransferThread::EventMatchesContext(const Event& event,
+                                         const Context& context) {
+  if (!context.initialized()) {
+    return false;
+  }
+  if (event.type == EventType::kServerEndTransfer) {
+    return context.session_id() == event.end_transfer.id;
+  }
+  if (event.type == EventType::kServerChunk && event.chunk.match_resource_id) {
+    return context.resource_id() == event.chunk.context_identifier;
+  }
+  return context.session_id() == event.chunk.context_identifier;
+}
+
 rpc::Writer& TransferThread::stream_for(TransferStream stream) {
   switch (stream) {
     case TransferStream::kClientRead:
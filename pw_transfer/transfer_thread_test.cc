@@ -509,5 +509,241 @@ TEST_F(TransferThreadTest,
   transfer_thread_.WaitUntilEventIsProcessed();
 }
 
+class ShardedTransferThreadTest : public ::testing::Test {
+ public:
+  ShardedTransferThreadTest()
+      : max_parameters_(chunk_buffer_.size(),
+                        chunk_buffer_.size(),
+                        cfg::kDefaultExtendWindowDivisor),
+        transfer_thread_(chunk_buffer_, encode_buffer_),
+        system_thread_(TransferThreadOptions(), transfer_thread_),
+        worker_threads_{
+            pw::Thread(TransferThreadOptions(), transfer_thread_.worker(0)),
+            pw::Thread(TransferThreadOptions(), transfer_thread_.worker(1)),
+        },
+        ctx_(transfer_thread_, 512) {}
+
+  ~ShardedTransferThreadTest() override {
+    transfer_thread_.Terminate();
+    system_thread_.join();
+    for (pw::Thread& thread : worker_threads_) {
+      thread.join();
+    }
+  }
+
+ protected:
+  void StartRead(uint32_t session_id) {
+    transfer_thread_.StartServerTransfer(
+        internal::TransferType::kTransmit,
+        ProtocolVersion::kLegacy,
+        session_id,
+        session_id,
+        EncodeChunk(
+            Chunk(ProtocolVersion::kLegacy, Chunk::Type::kParametersRetransmit)
+                .set_session_id(session_id)
+                .set_window_end_offset(8)
+                .set_max_chunk_size_bytes(8)
+                .set_offset(0)),
+        max_parameters_,
+        kNeverTimeout,
+        3,
+        10);
+  }
+
+  std::array<std::byte, 64> chunk_buffer_;
+  std::array<std::byte, 64> encode_buffer_;
+
+  internal::TransferParameters max_parameters_;
+
+  transfer::ShardedThread<1, 2, 2, 64> transfer_thread_;
+  pw::Thread system_thread_;
+  std::array<pw::Thread, 2> worker_threads_;
+  PW_RAW_TEST_METHOD_CONTEXT(TransferService, Read) ctx_;
+};
+
+TEST_F(ShardedTransferThreadTest, BlockedHandler_DoesNotStallOtherTransfers) {
+  auto reader_writer = ctx_.reader_writer();
+  transfer_thread_.SetServerReadStream(reader_writer, [](ConstByteSpan) {});
+
+  LongRunningHandler blocked_handler(3, kData);
+  SimpleReadTransfer handler(4, kData);
+  transfer_thread_.AddTransferHandler(blocked_handler);
+  transfer_thread_.AddTransferHandler(handler);
+
+  // The first transfer blocks its worker in PrepareRead(). The second transfer
+  // runs on the other worker and completes its window regardless.
+  rpc::test::WaitForPackets(ctx_.output(), 1, [this] {
+    StartRead(3);
+    StartRead(4);
+  });
+
+  EXPECT_TRUE(handler.prepare_read_called);
+  ASSERT_EQ(ctx_.total_responses(), 1u);
+  auto chunk = DecodeChunk(ctx_.responses()[0]);
+  EXPECT_EQ(chunk.session_id(), 4u);
+  EXPECT_EQ(chunk.payload().size(), 8u);
+
+  rpc::test::WaitForPackets(
+      ctx_.output(), 1, [&] { blocked_handler.notification.release(); });
+
+  ASSERT_EQ(ctx_.total_responses(), 2u);
+  chunk = DecodeChunk(ctx_.responses()[1]);
+  EXPECT_EQ(chunk.session_id(), 3u);
+  EXPECT_EQ(chunk.payload().size(), 8u);
+
+  transfer_thread_.RemoveTransferHandler(blocked_handler);
+  transfer_thread_.RemoveTransferHandler(handler);
+}
+
+TEST_F(ShardedTransferThreadTest, BusyWorker_DropsEventsWithoutBlocking) {
+  auto reader_writer = ctx_.reader_writer();
+  transfer_thread_.SetServerReadStream(reader_writer, [](ConstByteSpan) {});
+
+  LongRunningHandler blocked_handler(3, kData);
+  SimpleReadTransfer handler(4, kData);
+  transfer_thread_.AddTransferHandler(blocked_handler);
+  transfer_thread_.AddTransferHandler(handler);
+
+  // While the first transfer's worker is blocked, send it more chunks than its
+  // queue holds. The excess chunks are dropped, so the transfer thread still
+  // starts the second transfer on the other worker.
+  rpc::test::WaitForPackets(ctx_.output(), 1, [this] {
+    StartRead(3);
+    for (int i = 0; i < 8; ++i) {
+      transfer_thread_.ProcessServerChunk(EncodeChunk(
+          Chunk(ProtocolVersion::kLegacy, Chunk::Type::kParametersRetransmit)
+              .set_session_id(3)
+              .set_window_end_offset(8)
+              .set_max_chunk_size_bytes(8)
+              .set_offset(0)));
+    }
+    StartRead(4);
+  });
+
+  ASSERT_EQ(ctx_.total_responses(), 1u);
+  EXPECT_EQ(DecodeChunk(ctx_.responses()[0]).session_id(), 4u);
+
+  blocked_handler.notification.release();
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  bool blocked_transfer_sent = false;
+  for (ConstByteSpan response : ctx_.responses()) {
+    if (DecodeChunk(response).session_id() == 3u) {
+      blocked_transfer_sent = true;
+    }
+  }
+  EXPECT_TRUE(blocked_transfer_sent);
+
+  transfer_thread_.RemoveTransferHandler(blocked_handler);
+  transfer_thread_.RemoveTransferHandler(handler);
+}
+
+TEST_F(ShardedTransferThreadTest, ProcessChunk_RoutedToTransferWorker) {
+  auto reader_writer = ctx_.reader_writer();
+  transfer_thread_.SetServerReadStream(reader_writer, [](ConstByteSpan) {});
+
+  SimpleReadTransfer handler3(3, kData);
+  SimpleReadTransfer handler4(4, kData);
+  transfer_thread_.AddTransferHandler(handler3);
+  transfer_thread_.AddTransferHandler(handler4);
+
+  StartRead(3);
+  StartRead(4);
+  transfer_thread_.WaitUntilEventIsProcessed();
+  ASSERT_EQ(ctx_.total_responses(), 2u);
+
+  transfer_thread_.ProcessServerChunk(EncodeChunk(
+      Chunk(ProtocolVersion::kLegacy, Chunk::Type::kParametersContinue)
+          .set_session_id(4)
+          .set_window_end_offset(16)
+          .set_max_chunk_size_bytes(8)
+          .set_offset(8)));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ASSERT_EQ(ctx_.total_responses(), 3u);
+  auto chunk = DecodeChunk(ctx_.responses()[2]);
+  EXPECT_EQ(chunk.session_id(), 4u);
+  EXPECT_EQ(chunk.offset(), 8u);
+  EXPECT_EQ(
+      std::memcmp(
+          chunk.payload().data(), kData.data() + 8, chunk.payload().size()),
+      0);
+
+  transfer_thread_.RemoveTransferHandler(handler3);
+  transfer_thread_.RemoveTransferHandler(handler4);
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  EXPECT_TRUE(handler3.finalize_read_called);
+  EXPECT_EQ(handler3.finalize_read_status, Status::Aborted());
+  EXPECT_TRUE(handler4.finalize_read_called);
+  EXPECT_EQ(handler4.finalize_read_status, Status::Aborted());
+}
+
+TEST_F(ShardedTransferThreadTest, StartTransferExhausted) {
+  auto reader_writer = ctx_.reader_writer();
+  transfer_thread_.SetServerReadStream(reader_writer, [](ConstByteSpan) {});
+
+  SimpleReadTransfer handler3(3, kData);
+  SimpleReadTransfer handler4(4, kData);
+  SimpleReadTransfer handler5(5, kData);
+  transfer_thread_.AddTransferHandler(handler3);
+  transfer_thread_.AddTransferHandler(handler4);
+  transfer_thread_.AddTransferHandler(handler5);
+
+  StartRead(3);
+  StartRead(4);
+  StartRead(5);
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  EXPECT_TRUE(handler3.prepare_read_called);
+  EXPECT_TRUE(handler4.prepare_read_called);
+  EXPECT_FALSE(handler5.prepare_read_called);
+
+  ASSERT_EQ(ctx_.total_responses(), 3u);
+  bool exhausted_sent = false;
+  for (ConstByteSpan response : ctx_.responses()) {
+    Chunk chunk = DecodeChunk(response);
+    if (chunk.session_id() == 5u) {
+      ASSERT_TRUE(chunk.status().has_value());
+      EXPECT_EQ(chunk.status().value(), Status::ResourceExhausted());
+      exhausted_sent = true;
+    }
+  }
+  EXPECT_TRUE(exhausted_sent);
+
+  transfer_thread_.RemoveTransferHandler(handler3);
+  transfer_thread_.RemoveTransferHandler(handler4);
+  transfer_thread_.RemoveTransferHandler(handler5);
+}
+
+TEST_F(ShardedTransferThreadTest, SetStream_TerminatesTransfersOnAllWorkers) {
+  auto reader_writer = ctx_.reader_writer();
+  transfer_thread_.SetServerReadStream(reader_writer, [](ConstByteSpan) {});
+
+  SimpleReadTransfer handler3(3, kData);
+  SimpleReadTransfer handler4(4, kData);
+  transfer_thread_.AddTransferHandler(handler3);
+  transfer_thread_.AddTransferHandler(handler4);
+
+  StartRead(3);
+  StartRead(4);
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  EXPECT_FALSE(handler3.finalize_read_called);
+  EXPECT_FALSE(handler4.finalize_read_called);
+
+  auto new_reader_writer = ctx_.reader_writer();
+  transfer_thread_.SetServerReadStream(new_reader_writer, [](ConstByteSpan) {});
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  EXPECT_TRUE(handler3.finalize_read_called);
+  EXPECT_EQ(handler3.finalize_read_status, Status::Aborted());
+  EXPECT_TRUE(handler4.finalize_read_called);
+  EXPECT_EQ(handler4.finalize_read_status, Status::Aborted());
+
+  transfer_thread_.RemoveTransferHandler(handler3);
+  transfer_thread_.RemoveTransferHandler(handler4);
+}
+
 }  // namespace
 }  // namespace pw::transfer::test
@@ -0,0 +1,312 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_transfer/internal/window_controller.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace pw::transfer::internal {
+namespace {
+
+constexpr uint64_t kMicrosecondsPerSecond = 1'000'000;
+
+// Cubic growth constant, in chunks per round trip cubed: C = 0.4.
+constexpr int64_t kCubicScaleNumerator = 2;
+constexpr int64_t kCubicScaleDenominator = 5;
+
+// Multiplicative decrease applied to the window on loss: beta = 0.7.
+constexpr uint64_t kLossReductionNumerator = 7;
+constexpr uint64_t kLossReductionDenominator = 10;
+
+// Maximum window size, as a multiple of the bandwidth-delay product.
+constexpr uint64_t kBdpWindowGain = 4;
+
+// Bounds the distance from the cubic curve's inflection point so that the
+// cube cannot overflow. The curve has long since reached any window limit.
+constexpr int64_t kMaxCubicRounds = 1024;
+
+uint32_t IntegerCubeRoot(uint32_t value) {
+  uint32_t low = 0;
+  uint32_t high = 1625;  // cbrt(2^32) < 1626
+  while (low < high) {
+    const uint64_t mid = (low + high + 1) / 2;
+    if (mid * mid * mid <= value) {
+      low = static_cast<uint32_t>(mid);
+    } else {
+      high = static_cast<uint32_t>(mid - 1);
+    }
+  }
+  return low;
+}
+
+uint64_t ToMicroseconds(chrono::SystemClock::duration duration) {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+}  // namespace
+
+void WindowController::Reset(WindowMode mode, Clock::time_point now) {
+  mode_ = mode;
+  phase_ = Phase::kSlowStart;
+  loss_in_round_ = false;
+  rtt_sample_pending_ = false;
+  window_size_multiplier_ = 1;
+  window_size_bytes_ = 0;
+  min_rtt_ = kUnknownRtt;
+  round_start_ = now;
+  round_bytes_ = 0;
+  bandwidth_samples_.fill(0);
+  next_bandwidth_sample_ = 0;
+  max_bandwidth_ = 0;
+  full_bandwidth_ = 0;
+  full_bandwidth_rounds_ = 0;
+  last_max_window_bytes_ = 0;
+  rounds_since_reduction_ = 0;
+  cubic_k_rounds_ = 0;
+}
+
+void WindowController::SetLimits(uint32_t max_chunk_size_bytes,
+                                 uint32_t max_window_size_bytes) {
+  max_chunk_size_bytes_ = std::max(max_chunk_size_bytes, uint32_t{1});
+  max_window_size_bytes_ = std::max(max_window_size_bytes, uint32_t{1});
+}
+
+uint32_t WindowController::window_size_bytes() const {
+  if (mode_ == WindowMode::kLegacy) {
+    return static_cast<uint32_t>(
+        std::min(static_cast<uint64_t>(window_size_multiplier_) *
+                     max_chunk_size_bytes_,
+                 static_cast<uint64_t>(max_window_size_bytes_)));
+  }
+  return ClampWindow(window_size_bytes_);
+}
+
+uint32_t WindowController::chunk_delay_microseconds(
+    uint32_t default_delay_us) const {
+  if (mode_ == WindowMode::kLegacy || max_bandwidth_ == 0) {
+    return default_delay_us;
+  }
+
+  // Pace chunks slightly faster than the measured delivery rate so that any
+  // additional capacity on the link shows up in the next measurement, without
+  // bursting a window into the link faster than it can drain. During slow
+  // start, probe at twice the measured rate.
+  const uint64_t pacing_rate =
+      phase_ == Phase::kSlowStart
+          ? uint64_t{max_bandwidth_} * 2
+          : uint64_t{max_bandwidth_} + uint64_t{max_bandwidth_} / 4;
+  const uint64_t delay_us =
+      uint64_t{max_chunk_size_bytes_} * kMicrosecondsPerSecond / pacing_rate;
+
+  // Never wait longer than a round trip between chunks.
+  return static_cast<uint32_t>(std::min(
+      {delay_us,
+       ToMicroseconds(min_rtt_),
+       uint64_t{std::numeric_limits<uint32_t>::max()}}));
+}
+
+void WindowController::OnParametersSent(uint32_t response_offset,
+                                        Clock::time_point now) {
+  if (mode_ == WindowMode::kLegacy || rtt_sample_pending_) {
+    return;
+  }
+
+  rtt_sample_pending_ = true;
+  rtt_sample_offset_ = response_offset;
+  rtt_sample_start_ = now;
+}
+
+void WindowController::OnDataReceived(uint32_t offset,
+                                      size_t size_bytes,
+                                      Clock::time_point now) {
+  if (mode_ == WindowMode::kLegacy) {
+    return;
+  }
+
+  round_bytes_ += static_cast<uint32_t>(size_bytes);
+
+  if (!rtt_sample_pending_ || offset < rtt_sample_offset_) {
+    return;
+  }
+
+  rtt_sample_pending_ = false;
+  min_rtt_ = std::min(min_rtt_, now - rtt_sample_start_);
+  EndRound(now);
+}
+
+void WindowController::OnWindowExtended() {
+  if (mode_ != WindowMode::kLegacy) {
+    // Adaptive windows are resized once per round trip in EndRound().
+    return;
+  }
+
+  // Window was received successfully without packet loss and should grow.
+  // Double the window size during slow start, or increase it by a single
+  // chunk in congestion avoidance.
+  if (phase_ == Phase::kCongestionAvoidance) {
+    window_size_multiplier_ += 1;
+  } else {
+    window_size_multiplier_ *= 2;
+  }
+
+  // The window size can never exceed the user-specified maximum bytes. If it
+  // does, reduce the multiplier to the largest size that fits.
+  if (static_cast<uint64_t>(window_size_multiplier_) * max_chunk_size_bytes_ >
+      max_window_size_bytes_) {
+    window_size_multiplier_ =
+        std::max(max_window_size_bytes_ / max_chunk_size_bytes_, uint32_t{1});
+  }
+}
+
+void WindowController::OnLoss() {
+  // After the first packet loss, transition from the slow start to the
+  // congestion avoidance phase of the transfer.
+  phase_ = Phase::kCongestionAvoidance;
+
+  if (mode_ == WindowMode::kLegacy) {
+    window_size_multiplier_ =
+        std::max(window_size_multiplier_ / 2, uint32_t{1});
+    return;
+  }
+
+  // A single loss event often results in several retransmission requests.
+  // Only reduce the window once per round trip.
+  if (loss_in_round_) {
+    return;
+  }
+  loss_in_round_ = true;
+
+  // The round trip in which data was lost cannot be measured reliably.
+  rtt_sample_pending_ = false;
+
+  // Never shrink below the measured bandwidth-delay product, as data in flight
+  // up to that amount is being delivered.
+  const uint32_t window = window_size_bytes();
+  const uint32_t reduced = static_cast<uint32_t>(
+      uint64_t{window} * kLossReductionNumerator / kLossReductionDenominator);
+  last_max_window_bytes_ = window;
+  window_size_bytes_ =
+      std::min(window, std::max(reduced, BandwidthDelayProduct()));
+  StartCubicEpoch();
+}
+
+void WindowController::EndRound(Clock::time_point now) {
+  const uint64_t elapsed_us = ToMicroseconds(now - round_start_);
+  if (elapsed_us > 0) {
+    const uint64_t rate =
+        uint64_t{round_bytes_} * kMicrosecondsPerSecond / elapsed_us;
+    bandwidth_samples_[next_bandwidth_sample_] = static_cast<uint32_t>(
+        std::min(rate, uint64_t{std::numeric_limits<uint32_t>::max()}));
+    next_bandwidth_sample_ = static_cast<uint8_t>((next_bandwidth_sample_ + 1) %
+                                                  kBandwidthFilterRounds);
+    max_bandwidth_ = *std::max_element(bandwidth_samples_.begin(),
+                                       bandwidth_samples_.end());
+  }
+
+  round_start_ = now;
+  round_bytes_ = 0;
+  loss_in_round_ = false;
+
+  if (phase_ == Phase::kSlowStart) {
+    if (uint64_t{max_bandwidth_} * 4 >= uint64_t{full_bandwidth_} * 5) {
+      full_bandwidth_ = max_bandwidth_;
+      full_bandwidth_rounds_ = 0;
+    } else {
+      full_bandwidth_rounds_ += 1;
+    }
+
+    if (full_bandwidth_rounds_ < kFullBandwidthRounds) {
+      window_size_bytes_ = CapWindow(uint64_t{window_size_bytes()} * 2);
+      return;
+    }
+
+    // The delivery rate has stopped growing, so the link is full. Drain any
+    // queue built up during slow start by falling back to twice the
+    // bandwidth-delay product, then continue on the plateau of the cubic
+    // curve.
+    phase_ = Phase::kCongestionAvoidance;
+    window_size_bytes_ =
+        ClampWindow(std::min(uint64_t{BandwidthDelayProduct()} * 2,
+                             uint64_t{window_size_bytes()}));
+    last_max_window_bytes_ = window_size_bytes_;
+    StartCubicEpoch();
+    rounds_since_reduction_ = cubic_k_rounds_;
+    return;
+  }
+
+  rounds_since_reduction_ += 1;
+  window_size_bytes_ =
+      CapWindow(std::max(CubicWindowSize(), BandwidthDelayProduct()));
+}
+
+uint32_t WindowController::BandwidthDelayProduct() const {
+  if (min_rtt_ == kUnknownRtt) {
+    return 0;
+  }
+  const uint64_t bdp = uint64_t{max_bandwidth_} * ToMicroseconds(min_rtt_) /
+                       kMicrosecondsPerSecond;
+  return static_cast<uint32_t>(
+      std::min(bdp, uint64_t{std::numeric_limits<uint32_t>::max()}));
+}
+
+uint32_t WindowController::CubicWindowSize() const {
+  const int64_t t =
+      std::clamp(static_cast<int64_t>(rounds_since_reduction_) -
+                     static_cast<int64_t>(cubic_k_rounds_),
+                 -kMaxCubicRounds,
+                 kMaxCubicRounds);
+  const int64_t window = int64_t{last_max_window_bytes_} +
+                         int64_t{max_chunk_size_bytes_} * kCubicScaleNumerator *
+                             t * t * t / kCubicScaleDenominator;
+  return ClampWindow(static_cast<uint64_t>(std::max(window, int64_t{0})));
+}
+
+void WindowController::StartCubicEpoch() {
+  // K = cbrt(W_max * (1 - beta) / C), in chunks and round trips.
+  const uint64_t max_window_chunks =
+      last_max_window_bytes_ / max_chunk_size_bytes_;
+  constexpr uint64_t kReduction =
+      kLossReductionDenominator - kLossReductionNumerator;
+  cubic_k_rounds_ = IntegerCubeRoot(static_cast<uint32_t>(
+      max_window_chunks * kReduction * kCubicScaleDenominator /
+      (kLossReductionDenominator * kCubicScaleNumerator)));
+  rounds_since_reduction_ = 0;
+}
+
+uint32_t WindowController::CapWindow(uint64_t window_size_bytes) const {
+  // Data in flight beyond the bandwidth-delay product only queues up in the
+  // link. Since receivers only extend the window once part of it has arrived,
+  // typically half of the window is in flight. Allow the window to reach four
+  // times the bandwidth-delay product so that the in-flight data can exceed it
+  // and growth in the delivery rate can still be measured.
+  const uint32_t bdp = BandwidthDelayProduct();
+  if (bdp != 0) {
+    window_size_bytes =
+        std::min(window_size_bytes, uint64_t{bdp} * kBdpWindowGain);
+  }
+  return ClampWindow(window_size_bytes);
+}
+
+uint32_t WindowController::ClampWindow(uint64_t window_size_bytes) const {
+  return static_cast<uint32_t>(
+      std::clamp(window_size_bytes,
+                 uint64_t{std::min(max_chunk_size_bytes_,
+                                   max_window_size_bytes_)},
+                 uint64_t{max_window_size_bytes_}));
+}
+
+}  // namespace pw::transfer::internal
@@ -0,0 +1,619 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_transfer/internal/window_controller.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "pw_assert/assert.h"
+#include "pw_containers/inline_queue.h"
+#include "pw_log/log.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::transfer::internal {
+namespace {
+
+using Clock = chrono::SystemClock;
+
+Clock::time_point AtMicroseconds(uint64_t us) {
+  return Clock::time_point(Clock::duration(0)) +
+         Clock::for_at_least(std::chrono::microseconds(us));
+}
+
+Clock::time_point AtMilliseconds(uint64_t ms) {
+  return AtMicroseconds(ms * 1000);
+}
+
+constexpr uint32_t kChunkSize = 100;
+constexpr uint32_t kMaxWindowSize = 100'000;
+constexpr uint32_t kDefaultDelayUs = 2000;
+
+class WindowControllerTest : public ::testing::Test {
+ protected:
+  void Start(WindowMode mode) {
+    controller_.Reset(mode, AtMilliseconds(0));
+    controller_.SetLimits(kChunkSize, kMaxWindowSize);
+  }
+
+  // Simulates a round trip in which the transmitter sends a full window at
+  // bytes_per_second, starting at offset_.
+  void RunRound(uint32_t rtt_ms, uint32_t bytes_per_second) {
+    const uint32_t window = controller_.window_size_bytes();
+    controller_.OnParametersSent(offset_, AtMilliseconds(now_ms_));
+    now_ms_ += rtt_ms;
+
+    const uint64_t send_ms =
+        static_cast<uint64_t>(window) * 1000 / bytes_per_second;
+    for (uint32_t sent = 0; sent < window; sent += kChunkSize) {
+      const uint64_t at = now_ms_ + send_ms * sent / window;
+      controller_.OnDataReceived(offset_, kChunkSize, AtMilliseconds(at));
+      offset_ += kChunkSize;
+    }
+    now_ms_ += send_ms;
+  }
+
+  WindowController controller_;
+  uint64_t now_ms_ = 0;
+  uint32_t offset_ = 0;
+};
+
+TEST_F(WindowControllerTest, Legacy_SlowStartThenCongestionAvoidance) {
+  Start(WindowMode::kLegacy);
+  EXPECT_EQ(controller_.window_size_bytes(), kChunkSize);
+
+  controller_.SetLimits(kChunkSize, 1000);
+  controller_.OnWindowExtended();
+  EXPECT_EQ(controller_.window_size_bytes(), 200u);
+  controller_.OnWindowExtended();
+  EXPECT_EQ(controller_.window_size_bytes(), 400u);
+  controller_.OnWindowExtended();
+  EXPECT_EQ(controller_.window_size_bytes(), 800u);
+  controller_.OnWindowExtended();
+  EXPECT_EQ(controller_.window_size_bytes(), 1000u);
+
+  controller_.OnLoss();
+  EXPECT_EQ(controller_.window_size_bytes(), 500u);
+  controller_.OnLoss();
+  EXPECT_EQ(controller_.window_size_bytes(), 200u);
+
+  controller_.OnWindowExtended();
+  EXPECT_EQ(controller_.window_size_bytes(), 300u);
+  controller_.OnWindowExtended();
+  EXPECT_EQ(controller_.window_size_bytes(), 400u);
+}
+
+TEST_F(WindowControllerTest, Legacy_IgnoresTimingAndUsesDefaultDelay) {
+  Start(WindowMode::kLegacy);
+  RunRound(100, 1000);
+  RunRound(100, 1000);
+
+  EXPECT_EQ(controller_.min_rtt(), WindowController::kUnknownRtt);
+  EXPECT_EQ(controller_.bandwidth_bytes_per_second(), 0u);
+  EXPECT_EQ(controller_.window_size_bytes(), kChunkSize);
+  EXPECT_EQ(controller_.chunk_delay_microseconds(kDefaultDelayUs),
+            kDefaultDelayUs);
+}
+
+TEST_F(WindowControllerTest, Adaptive_MeasuresRoundTripTime) {
+  Start(WindowMode::kAdaptive);
+
+  controller_.OnParametersSent(0, AtMilliseconds(10));
+  // A second parameters chunk does not restart the measurement.
+  controller_.OnParametersSent(50, AtMilliseconds(20));
+  controller_.OnDataReceived(0, 50, AtMilliseconds(60));
+
+  EXPECT_GE(controller_.min_rtt(),
+            Clock::for_at_least(std::chrono::milliseconds(50)));
+  EXPECT_LT(controller_.min_rtt(),
+            Clock::for_at_least(std::chrono::milliseconds(51)));
+
+  // 50 bytes delivered 60 ms after the transfer started.
+  EXPECT_EQ(controller_.bandwidth_bytes_per_second(), 833u);
+}
+
+TEST_F(WindowControllerTest, Adaptive_MeasurementCompletesAtResponseOffset) {
+  Start(WindowMode::kAdaptive);
+
+  controller_.OnParametersSent(300, AtMilliseconds(0));
+  controller_.OnDataReceived(100, 100, AtMilliseconds(10));
+  controller_.OnDataReceived(200, 100, AtMilliseconds(20));
+  EXPECT_EQ(controller_.min_rtt(), WindowController::kUnknownRtt);
+
+  controller_.OnDataReceived(300, 100, AtMilliseconds(100));
+  EXPECT_GE(controller_.min_rtt(),
+            Clock::for_at_least(std::chrono::milliseconds(100)));
+  EXPECT_EQ(controller_.bandwidth_bytes_per_second(), 3000u);
+}
+
+TEST_F(WindowControllerTest, Adaptive_SlowStartDoublesEachRoundTrip) {
+  Start(WindowMode::kAdaptive);
+
+  // Extensions within a round trip do not grow the window.
+  controller_.OnWindowExtended();
+  controller_.OnWindowExtended();
+  EXPECT_EQ(controller_.window_size_bytes(), kChunkSize);
+
+  // The delivery rate keeps growing with the window, so the transfer remains
+  // in slow start.
+  RunRound(100, 1'000'000'000);
+  EXPECT_EQ(controller_.window_size_bytes(), 2 * kChunkSize);
+  RunRound(100, 1'000'000'000);
+  EXPECT_EQ(controller_.window_size_bytes(), 4 * kChunkSize);
+  RunRound(100, 1'000'000'000);
+  EXPECT_EQ(controller_.window_size_bytes(), 8 * kChunkSize);
+}
+
+TEST_F(WindowControllerTest, Adaptive_LeavesSlowStartWhenLinkIsFull) {
+  Start(WindowMode::kAdaptive);
+
+  // A 10 kB/s link with a 100 ms round trip has a bandwidth-delay product of
+  // 1000 bytes. Once the window exceeds it, the delivery rate stops growing.
+  for (int i = 0; i < 12; ++i) {
+    RunRound(100, 10'000);
+  }
+
+  const uint32_t bdp = controller_.bandwidth_bytes_per_second() / 10;
+  EXPECT_GE(controller_.window_size_bytes(), bdp);
+  EXPECT_LE(controller_.window_size_bytes(), 3 * bdp);
+  EXPECT_LT(controller_.window_size_bytes(), kMaxWindowSize);
+}
+
+TEST_F(WindowControllerTest, Adaptive_LossReducesWindowOncePerRoundTrip) {
+  Start(WindowMode::kAdaptive);
+  for (int i = 0; i < 5; ++i) {
+    RunRound(100, 1'000'000);
+  }
+  const uint32_t window = controller_.window_size_bytes();
+  ASSERT_EQ(window, 32 * kChunkSize);
+
+  controller_.OnLoss();
+  EXPECT_EQ(controller_.window_size_bytes(), window * 7 / 10);
+  controller_.OnLoss();
+  EXPECT_EQ(controller_.window_size_bytes(), window * 7 / 10);
+}
+
+TEST_F(WindowControllerTest, Adaptive_RegrowsAlongCubicCurve) {
+  controller_.Reset(WindowMode::kAdaptive, AtMilliseconds(0));
+  controller_.SetLimits(kChunkSize, 64 * kChunkSize);
+  // At 50 kB/s, large windows take longer to send than the round trip, so the
+  // bandwidth-delay product stays below 32 chunks while the window exceeds it.
+  for (int i = 0; i < 8; ++i) {
+    RunRound(100, 50'000);
+  }
+  ASSERT_GT(controller_.window_size_bytes(), 32 * kChunkSize);
+  ASSERT_LT(controller_.bandwidth_bytes_per_second() / 10, 32 * kChunkSize);
+
+  // Drop the window to 32 chunks, then lose data again to start a cubic epoch
+  // that returns to 32 chunks.
+  controller_.SetLimits(kChunkSize, 32 * kChunkSize);
+  controller_.OnLoss();
+  RunRound(100, 1'000'000'000);
+  const uint32_t reduced = controller_.window_size_bytes();
+  EXPECT_LT(reduced, 32 * kChunkSize);
+
+  // The window grows quickly at first, then flattens out as it approaches its
+  // size before the loss, never dropping in between.
+  uint32_t previous = reduced;
+  for (int i = 0; i < 4; ++i) {
+    RunRound(100, 1'000'000'000);
+    EXPECT_GE(controller_.window_size_bytes(), previous);
+    previous = controller_.window_size_bytes();
+  }
+  EXPECT_EQ(controller_.window_size_bytes(), 32 * kChunkSize);
+}
+
+TEST_F(WindowControllerTest, Adaptive_PacingFollowsDeliveryRate) {
+  Start(WindowMode::kAdaptive);
+  EXPECT_EQ(controller_.chunk_delay_microseconds(kDefaultDelayUs),
+            kDefaultDelayUs);
+
+  // Slow start probes at twice the delivery rate: 100 bytes at 20 kB/s.
+  RunRound(10, 100'000);
+  ASSERT_EQ(controller_.bandwidth_bytes_per_second(), 10'000u);
+  EXPECT_EQ(controller_.chunk_delay_microseconds(kDefaultDelayUs), 5000u);
+
+  // Congestion avoidance paces at 125% of the delivery rate.
+  controller_.OnLoss();
+  EXPECT_EQ(controller_.chunk_delay_microseconds(kDefaultDelayUs), 8000u);
+}
+
+// Simulates a transfer over a link with a fixed latency, limited bandwidth
+// and buffering, and random loss, reporting the achieved throughput.
+//
+// The transmitter follows the pw_transfer transmit logic: it sends chunks from
+// its offset up to the end of the window, paced by the requested delay. The
+// receiver follows the pw_transfer receive logic, using a WindowController to
+// size its window. Time is simulated, so transfers which would take minutes
+// over a real link complete instantly.
+class LinkSimulation {
+ public:
+  struct Config {
+    WindowMode mode;
+    uint32_t transfer_size_bytes;
+    uint32_t one_way_delay_ms;
+    uint32_t bandwidth_bytes_per_second;
+    uint32_t queue_limit_bytes;
+    uint32_t loss_per_thousand;
+  };
+
+  struct Result {
+    bool completed;
+    uint32_t throughput_bytes_per_second;
+    uint32_t bytes_sent;
+  };
+
+  explicit LinkSimulation(const Config& config) : config_(config) {}
+
+  Result Run();
+
+ private:
+  static constexpr uint32_t kSimChunkSize = 512;
+  static constexpr uint32_t kSimMaxWindow = 32 * 1024;
+  static constexpr uint32_t kExtendWindowDivisor = 2;
+  static constexpr uint64_t kChunkTimeoutUs = 2'000'000;
+  static constexpr uint64_t kMaxSimulatedTimeUs = 3'600'000'000;
+  static constexpr uint64_t kNever = ~uint64_t{0};
+
+  struct Data {
+    uint64_t arrival_us;
+    uint32_t offset;
+    uint32_t size;
+    bool final;
+  };
+
+  struct Parameters {
+    uint64_t arrival_us;
+    bool retransmit;
+    uint32_t offset;
+    uint32_t window_end_offset;
+    uint32_t delay_us;
+  };
+
+  enum class Action { kFirst, kExtend, kRetransmit, kResume };
+
+  bool Lost() {
+    rng_state_ = rng_state_ * 1664525u + 1013904223u;
+    return (rng_state_ >> 8) % 1000 < config_.loss_per_thousand;
+  }
+
+  uint64_t OneWayDelayUs() const {
+    return uint64_t{config_.one_way_delay_ms} * 1000;
+  }
+
+  // Transmitter.
+  void TransmitterHandleParameters(const Parameters& parameters);
+  void TransmitNextChunk();
+
+  // Receiver.
+  void ReceiverHandleData(const Data& data);
+  bool ReceiverHandleOutOfOrderData(const Data& data);
+  void SendSelectiveRetransmit();
+  void ReceiverTimeout();
+  void UpdateWindow(Action action);
+  void SendParameters(bool retransmit, uint32_t window_end_offset);
+  void UpdateAndSendParameters(Action action) {
+    UpdateWindow(action);
+    SendParameters(action != Action::kExtend, rx_window_end_);
+  }
+
+  const Config config_;
+  uint64_t now_us_ = 0;
+  uint32_t rng_state_ = 1;
+
+  InlineQueue<Data, 256> data_link_;
+  InlineQueue<Parameters, 256> parameters_link_;
+  uint64_t link_busy_until_us_ = 0;
+
+  uint32_t tx_offset_ = 0;
+  uint32_t tx_window_end_ = 0;
+  uint32_t tx_delay_us_ = 0;
+  uint64_t tx_next_send_us_ = kNever;
+  uint32_t bytes_sent_ = 0;
+
+  WindowController window_;
+  bool rx_recovery_ = false;
+  bool rx_done_ = false;
+  uint32_t rx_offset_ = 0;
+  uint32_t rx_window_size_ = 0;
+  uint32_t rx_window_end_ = 0;
+  uint32_t rx_last_chunk_offset_ = 0;
+  uint32_t rx_out_of_order_start_ = 0;
+  uint32_t rx_out_of_order_end_ = 0;
+  uint64_t rx_timeout_us_ = kNever;
+};
+
+LinkSimulation::Result LinkSimulation::Run() {
+  window_.Reset(config_.mode, AtMicroseconds(0));
+  UpdateAndSendParameters(Action::kFirst);
+  rx_timeout_us_ = kChunkTimeoutUs;
+
+  while (!rx_done_ && now_us_ < kMaxSimulatedTimeUs) {
+    const uint64_t next_data =
+        data_link_.empty() ? kNever : data_link_.front().arrival_us;
+    const uint64_t next_parameters =
+        parameters_link_.empty() ? kNever : parameters_link_.front().arrival_us;
+    now_us_ = std::min(
+        {next_data, next_parameters, tx_next_send_us_, rx_timeout_us_});
+
+    if (now_us_ == next_parameters) {
+      const Parameters parameters = parameters_link_.front();
+      parameters_link_.pop();
+      TransmitterHandleParameters(parameters);
+    } else if (now_us_ == next_data) {
+      const Data data = data_link_.front();
+      data_link_.pop();
+      ReceiverHandleData(data);
+    } else if (now_us_ == tx_next_send_us_) {
+      TransmitNextChunk();
+    } else {
+      ReceiverTimeout();
+    }
+  }
+
+  return Result{
+      .completed = rx_done_,
+      .throughput_bytes_per_second = static_cast<uint32_t>(
+          uint64_t{config_.transfer_size_bytes} * 1'000'000 / now_us_),
+      .bytes_sent = bytes_sent_,
+  };
+}
+
+void LinkSimulation::TransmitterHandleParameters(const Parameters& parameters) {
+  if (parameters.retransmit) {
+    tx_offset_ = parameters.offset;
+  } else if (parameters.window_end_offset <= tx_offset_) {
+    return;  // Old rolling window chunk.
+  }
+
+  tx_window_end_ = parameters.window_end_offset;
+  tx_delay_us_ = parameters.delay_us;
+  tx_next_send_us_ = now_us_;
+}
+
+void LinkSimulation::TransmitNextChunk() {
+  const uint32_t size = std::min({kSimChunkSize,
+                                  tx_window_end_ - tx_offset_,
+                                  config_.transfer_size_bytes - tx_offset_});
+  if (size == 0) {
+    tx_next_send_us_ = kNever;
+    return;
+  }
+
+  // Chunks which arrive while the link's queue is full are dropped. Chunks
+  // that fit are serialized onto the link at its bandwidth.
+  const uint64_t queued_us =
+      link_busy_until_us_ > now_us_ ? link_busy_until_us_ - now_us_ : 0;
+  const uint64_t queue_limit_us = uint64_t{config_.queue_limit_bytes} *
+                                  1'000'000 /
+                                  config_.bandwidth_bytes_per_second;
+  if (queued_us <= queue_limit_us) {
+    link_busy_until_us_ = std::max(link_busy_until_us_, now_us_) +
+                          uint64_t{size} * 1'000'000 /
+                              config_.bandwidth_bytes_per_second;
+    if (!Lost()) {
+      PW_ASSERT(!data_link_.full());
+      data_link_.push(Data{
+          .arrival_us = link_busy_until_us_ + OneWayDelayUs(),
+          .offset = tx_offset_,
+          .size = size,
+          .final = tx_offset_ + size == config_.transfer_size_bytes,
+      });
+    }
+  }
+
+  bytes_sent_ += size;
+  tx_offset_ += size;
+
+  if (tx_offset_ == tx_window_end_ ||
+      tx_offset_ == config_.transfer_size_bytes) {
+    tx_next_send_us_ = kNever;
+  } else {
+    tx_next_send_us_ = now_us_ + tx_delay_us_;
+  }
+}
+
+void LinkSimulation::ReceiverHandleData(const Data& data) {
+  rx_timeout_us_ = now_us_ + kChunkTimeoutUs;
+
+  if (rx_recovery_) {
+    if (data.offset != rx_offset_) {
+      if (rx_last_chunk_offset_ == data.offset) {
+        UpdateAndSendParameters(Action::kRetransmit);
+      }
+      rx_last_chunk_offset_ = data.offset;
+      return;
+    }
+    rx_recovery_ = false;
+  }
+
+  if (data.offset != rx_offset_) {
+    if (data.offset > rx_offset_ && ReceiverHandleOutOfOrderData(data)) {
+      return;
+    }
+
+    if (data.offset + data.size <= rx_offset_) {
+      UpdateWindow(Action::kRetransmit);
+      SendParameters(/*retransmit=*/false, rx_window_end_);
+    } else {
+      rx_out_of_order_end_ = 0;
+      rx_recovery_ = true;
+      UpdateAndSendParameters(Action::kRetransmit);
+    }
+    return;
+  }
+
+  if (data.offset + data.size > rx_window_end_) {
+    rx_out_of_order_end_ = 0;
+    rx_recovery_ = true;
+    UpdateAndSendParameters(Action::kRetransmit);
+    return;
+  }
+
+  rx_last_chunk_offset_ = data.offset;
+  window_.OnDataReceived(rx_offset_, data.size, AtMicroseconds(now_us_));
+  rx_offset_ += data.size;
+
+  if (data.final) {
+    rx_done_ = true;
+    return;
+  }
+
+  if (rx_out_of_order_end_ != 0 && rx_offset_ >= rx_out_of_order_start_) {
+    rx_offset_ = std::max(rx_offset_, rx_out_of_order_end_);
+    rx_out_of_order_end_ = 0;
+    UpdateAndSendParameters(Action::kResume);
+    return;
+  }
+
+  if (rx_out_of_order_end_ != 0) {
+    return;
+  }
+
+  if (rx_offset_ == rx_window_end_ ||
+      rx_window_end_ - rx_offset_ <= rx_window_size_ / kExtendWindowDivisor) {
+    UpdateAndSendParameters(Action::kExtend);
+  }
+}
+
+bool LinkSimulation::ReceiverHandleOutOfOrderData(const Data& data) {
+  if (window_.mode() != WindowMode::kAdaptive) {
+    return false;
+  }
+
+  const uint32_t end = data.offset + data.size;
+
+  if (rx_out_of_order_end_ == 0) {
+    if (data.final || end > rx_window_end_) {
+      return false;
+    }
+    rx_out_of_order_start_ = data.offset;
+    rx_out_of_order_end_ = end;
+    SendSelectiveRetransmit();
+    return true;
+  }
+
+  if (data.offset != rx_out_of_order_end_ || data.final ||
+      end > rx_window_end_) {
+    if (data.offset < rx_out_of_order_start_ &&
+        end >= rx_out_of_order_start_) {
+      SendSelectiveRetransmit();
+    }
+    return true;
+  }
+
+  rx_out_of_order_end_ = end;
+  return true;
+}
+
+void LinkSimulation::SendSelectiveRetransmit() {
+  window_.OnLoss();
+  window_.OnParametersSent(rx_offset_, AtMicroseconds(now_us_));
+  SendParameters(/*retransmit=*/true, rx_out_of_order_start_);
+}
+
+void LinkSimulation::ReceiverTimeout() {
+  rx_timeout_us_ = now_us_ + kChunkTimeoutUs;
+  rx_out_of_order_end_ = 0;
+  UpdateAndSendParameters(Action::kRetransmit);
+}
+
+void LinkSimulation::UpdateWindow(Action action) {
+  window_.SetLimits(kSimChunkSize, kSimMaxWindow);
+  if (action == Action::kExtend) {
+    window_.OnWindowExtended();
+  } else if (action == Action::kRetransmit) {
+    window_.OnLoss();
+  }
+
+  window_.OnParametersSent(
+      action == Action::kExtend ? rx_window_end_ : rx_offset_,
+      AtMicroseconds(now_us_));
+  rx_window_size_ = window_.window_size_bytes();
+  rx_window_end_ = rx_offset_ + rx_window_size_;
+}
+
+void LinkSimulation::SendParameters(bool retransmit,
+                                    uint32_t window_end_offset) {
+  PW_ASSERT(!parameters_link_.full());
+  parameters_link_.push(Parameters{
+      .arrival_us = now_us_ + OneWayDelayUs(),
+      .retransmit = retransmit,
+      .offset = rx_offset_,
+      .window_end_offset = window_end_offset,
+      .delay_us = window_.chunk_delay_microseconds(kDefaultDelayUs),
+  });
+}
+
+struct SimulatedThroughput {
+  LinkSimulation::Result legacy;
+  LinkSimulation::Result adaptive;
+};
+
+// Runs a 256 kB transfer over a 100 kB/s link with an 8 kB queue in both
+// window modes.
+SimulatedThroughput Simulate(uint32_t one_way_delay_ms,
+                             uint32_t loss_per_thousand) {
+  LinkSimulation::Config config{
+      .mode = WindowMode::kLegacy,
+      .transfer_size_bytes = 256'000,
+      .one_way_delay_ms = one_way_delay_ms,
+      .bandwidth_bytes_per_second = 100'000,
+      .queue_limit_bytes = 8192,
+      .loss_per_thousand = loss_per_thousand,
+  };
+  const LinkSimulation::Result legacy = LinkSimulation(config).Run();
+  config.mode = WindowMode::kAdaptive;
+  const LinkSimulation::Result adaptive = LinkSimulation(config).Run();
+
+  PW_LOG_INFO(
+      "%u ms latency, %u.%u%% loss: legacy %u B/s (%u B sent), adaptive %u "
+      "B/s (%u B sent)",
+      static_cast<unsigned>(one_way_delay_ms),
+      static_cast<unsigned>(loss_per_thousand / 10),
+      static_cast<unsigned>(loss_per_thousand % 10),
+      static_cast<unsigned>(legacy.throughput_bytes_per_second),
+      static_cast<unsigned>(legacy.bytes_sent),
+      static_cast<unsigned>(adaptive.throughput_bytes_per_second),
+      static_cast<unsigned>(adaptive.bytes_sent));
+  return {legacy, adaptive};
+}
+
+TEST(WindowControllerSimulation, LowLatencyLink) {
+  const SimulatedThroughput result = Simulate(5, 0);
+  ASSERT_TRUE(result.legacy.completed);
+  ASSERT_TRUE(result.adaptive.completed);
+  EXPECT_GE(result.adaptive.throughput_bytes_per_second,
+            result.legacy.throughput_bytes_per_second * 9 / 10);
+}
+
+TEST(WindowControllerSimulation, HighLatencyLink) {
+  const SimulatedThroughput result = Simulate(250, 0);
+  ASSERT_TRUE(result.legacy.completed);
+  ASSERT_TRUE(result.adaptive.completed);
+  EXPECT_GE(result.adaptive.throughput_bytes_per_second,
+            result.legacy.throughput_bytes_per_second);
+}
+
+TEST(WindowControllerSimulation, HighLatencyLossyLink) {
+  const SimulatedThroughput result = Simulate(250, 20);
+  ASSERT_TRUE(result.legacy.completed);
+  ASSERT_TRUE(result.adaptive.completed);
+  EXPECT_GT(result.adaptive.throughput_bytes_per_second,
+            result.legacy.throughput_bytes_per_second);
+  EXPECT_LT(result.adaptive.bytes_sent, result.legacy.bytes_sent);
+}
+
+}  // namespace
+}  // namespace pw::transfer::internal